@@ -29,6 +29,7 @@ from .image_info import *
 from .layout import *
 from .rec_map import *
 from .style import *
+from .tile_cache import *
 
 try:
     Block.register(gtlib)
@@ -41,8 +42,10 @@ try:
     GraphicsCairo.register(gtlib)
     ImageInfo.register(gtlib)
     Layout.register(gtlib)
+    LayoutContext.register(gtlib)
     RecMap.register(gtlib)
     Style.register(gtlib)
+    TileCache.register(gtlib)
 except AttributeError:
     # fail gracefully when AnnotationSketch symbols are not present
     pass
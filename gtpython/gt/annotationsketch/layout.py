@@ -29,12 +29,54 @@ from ctypes import c_ulong, c_void_p, c_int, c_char_p, CFUNCTYPE, byref, \
 TrackOrderingFunc = CFUNCTYPE(c_int, c_char_p, c_char_p, c_void_p)
 
 
+class LayoutContext:
+
+    def __init__(self, style):
+        err = Error()
+        self.context = gtlib.gt_layout_context_new(style._as_parameter_,
+                                                   err._as_parameter_)
+        if not self.context:
+            gterror(err)
+        self._as_parameter_ = self.context
+
+    def __del__(self):
+        try:
+            gtlib.gt_layout_context_delete(self.context)
+        except AttributeError:
+            pass
+
+    def from_param(cls, obj):
+        if not isinstance(obj, LayoutContext):
+            raise TypeError("argument must be a LayoutContext")
+        return obj._as_parameter_
+
+    from_param = classmethod(from_param)
+
+    def reset(self):
+        gtlib.gt_layout_context_reset(self.context)
+
+    def register(cls, gtlib):
+        gtlib.gt_layout_context_new.restype = c_void_p
+        gtlib.gt_layout_context_new.argtypes = [c_void_p, c_void_p]
+        gtlib.gt_layout_context_reset.restype = None
+        gtlib.gt_layout_context_reset.argtypes = [c_void_p]
+        gtlib.gt_layout_context_delete.restype = None
+        gtlib.gt_layout_context_delete.argtypes = [c_void_p]
+
+    register = classmethod(register)
+
+
 class Layout:
 
-    def __init__(self, diagram, width, style):
+    def __init__(self, diagram, width, style, context=None):
         err = Error()
-        self.layout = gtlib.gt_layout_new(diagram._as_parameter_, width,
-                                          style._as_parameter_, err._as_parameter_)
+        if context:
+            self.layout = gtlib.gt_layout_new_with_context(
+                diagram._as_parameter_, width, context._as_parameter_,
+                err._as_parameter_)
+        else:
+            self.layout = gtlib.gt_layout_new(diagram._as_parameter_, width,
+                                              style._as_parameter_, err._as_parameter_)
         if err.is_set():
             gterror(err)
         self._as_parameter_ = self.layout
@@ -90,6 +132,9 @@ class Layout:
         gtlib.gt_layout_delete.argtypes = [c_void_p]
         gtlib.gt_layout_new.restype = c_void_p
         gtlib.gt_layout_new.argtypes = [c_void_p, c_uint, c_void_p, c_void_p]
+        gtlib.gt_layout_new_with_context.restype = c_void_p
+        gtlib.gt_layout_new_with_context.argtypes = [c_void_p, c_uint,
+                                                     c_void_p, c_void_p]
         gtlib.gt_layout_sketch.restype = c_int
         gtlib.gt_layout_sketch.argtypes = [c_void_p, c_void_p, c_void_p]
         gtlib.gt_layout_set_track_ordering_func.argtypes = [c_void_p,
@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2016 Genome Research Ltd.
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+from gt.dlload import gtlib
+from gt.annotationsketch.style import Style
+from gt.core.error import Error, gterror
+from gt.core.gtrange import Range
+from gt.core.gtstr import Str
+from gt.extended.feature_index import FeatureIndex
+from ctypes import c_ulong, c_void_p, c_int, c_char_p, c_uint, string_at
+
+
+class TileCache:
+
+    def __init__(self, feature_index, style, tile_length, tile_width,
+                 max_tiles=1024):
+        FeatureIndex.from_param(feature_index)
+        Style.from_param(style)
+        if tile_length < 1 or max_tiles < 1:
+            gterror("tile length and maximal number of tiles must be > 0")
+        err = Error()
+        self.tc = gtlib.gt_tile_cache_new(feature_index._as_parameter_,
+                                          style._as_parameter_, tile_length,
+                                          tile_width, max_tiles,
+                                          err._as_parameter_)
+        if self.tc == None:
+            gterror(err)
+        self._as_parameter_ = self.tc
+
+    def __del__(self):
+        try:
+            gtlib.gt_tile_cache_delete(self.tc)
+        except AttributeError:
+            pass
+
+    def from_param(cls, obj):
+        if not isinstance(obj, TileCache):
+            raise TypeError("argument must be a TileCache")
+        return obj._as_parameter_
+
+    from_param = classmethod(from_param)
+
+    def get_tile_range(self, zoom, tile):
+        return gtlib.gt_tile_cache_get_tile_range(self.tc, zoom, tile)
+
+    def render(self, seqid, zoom, first, last):
+        err = Error()
+        rval = gtlib.gt_tile_cache_render(self.tc,
+                                          str(seqid).encode('UTF-8'), zoom,
+                                          first, last, err._as_parameter_)
+        if rval != 0:
+            gterror(err)
+
+    def to_stream(self, seqid, zoom, tile):
+        err = Error()
+        s = Str(None)
+        rval = gtlib.gt_tile_cache_tile_to_stream(self.tc,
+                                                  str(seqid).encode('UTF-8'),
+                                                  zoom, tile, s._as_parameter_,
+                                                  err._as_parameter_)
+        if rval != 0:
+            gterror(err)
+        return string_at(s.get_mem(), s.length())
+
+    def to_file(self, seqid, zoom, tile, filename):
+        err = Error()
+        rval = gtlib.gt_tile_cache_tile_to_file(self.tc,
+                                                str(seqid).encode('UTF-8'),
+                                                zoom, tile,
+                                                str(filename).encode('UTF-8'),
+                                                err._as_parameter_)
+        if rval != 0:
+            gterror(err)
+
+    def clear(self):
+        gtlib.gt_tile_cache_clear(self.tc)
+
+    def register(cls, gtlib):
+        gtlib.gt_tile_cache_new.restype = c_void_p
+        gtlib.gt_tile_cache_new.argtypes = [c_void_p, c_void_p, c_ulong,
+                                            c_uint, c_ulong, c_void_p]
+        gtlib.gt_tile_cache_get_tile_range.restype = Range
+        gtlib.gt_tile_cache_get_tile_range.argtypes = [c_void_p, c_uint,
+                                                       c_ulong]
+        gtlib.gt_tile_cache_render.restype = c_int
+        gtlib.gt_tile_cache_render.argtypes = [c_void_p, c_char_p, c_uint,
+                                               c_ulong, c_ulong, c_void_p]
+        gtlib.gt_tile_cache_tile_to_stream.restype = c_int
+        gtlib.gt_tile_cache_tile_to_stream.argtypes = [c_void_p, c_char_p,
+                                                       c_uint, c_ulong,
+                                                       c_void_p, c_void_p]
+        gtlib.gt_tile_cache_tile_to_file.restype = c_int
+        gtlib.gt_tile_cache_tile_to_file.argtypes = [c_void_p, c_char_p,
+                                                     c_uint, c_ulong,
+                                                     c_char_p, c_void_p]
+        gtlib.gt_tile_cache_clear.restype = None
+        gtlib.gt_tile_cache_clear.argtypes = [c_void_p]
+        gtlib.gt_tile_cache_delete.restype = None
+        gtlib.gt_tile_cache_delete.argtypes = [c_void_p]
+
+    register = classmethod(register)
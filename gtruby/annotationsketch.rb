@@ -25,6 +25,7 @@ begin
   require 'annotationsketch/image_info'
   require 'annotationsketch/layout'
   require 'annotationsketch/rec_map'
+  require 'annotationsketch/tile_cache'
 rescue RuntimeError
   # fail gracefully when AnnotationSketch symbols are not present
   raise unless $!.to_s.match(/can't find the symbol/)
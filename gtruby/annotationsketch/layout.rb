@@ -23,6 +23,11 @@ module GT
   gtdlload "libgenometools"
   extern "GtLayout* gt_layout_new(GtDiagram*, unsigned int, GtStyle*, " + \
                                  "GtError*)"
+  extern "GtLayout* gt_layout_new_with_context(GtDiagram*, unsigned int, " + \
+                                              "GtLayoutContext*, GtError*)"
+  extern "GtLayoutContext* gt_layout_context_new(GtStyle*, GtError*)"
+  extern "void      gt_layout_context_reset(GtLayoutContext*)"
+  extern "void      gt_layout_context_delete(GtLayoutContext*)"
   extern "int       gt_layout_get_height(GtLayout*, unsigned long*, " + \
                                         "GtError*)"
   extern "int       gt_layout_sketch(GtLayout*, GtCanvas*, GtError*)"
@@ -30,15 +35,38 @@ module GT
                                                       "void*, void*)"
   extern "void      gt_layout_delete(GtCanvas*)"
 
+  class LayoutContext
+    def initialize(style)
+      err = GT::Error.new()
+      @context = GT.gt_layout_context_new(style, err)
+      if @context.nil? then
+        GT::gterror(err)
+      end
+      @context.free = GT::symbol("gt_layout_context_delete", "0P")
+    end
+
+    def reset
+      GT.gt_layout_context_reset(@context)
+    end
+
+    def to_ptr
+      @context
+    end
+  end
+
   class Layout
 
     UlongParam = GT.struct [
       "GtUlong val"
     ]
     
-    def initialize(diagram, width, style)
+    def initialize(diagram, width, style, context = nil)
       err = GT::Error.new()
-      @layout = GT.gt_layout_new(diagram, width, style, err)
+      if context.nil? then
+        @layout = GT.gt_layout_new(diagram, width, style, err)
+      else
+        @layout = GT.gt_layout_new_with_context(diagram, width, context, err)
+      end
       if @layout.nil? then
         GT::gterror(err)
       end
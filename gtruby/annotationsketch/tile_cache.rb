@@ -0,0 +1,96 @@
+#
+# Copyright (c) 2016 Genome Research Ltd.
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+require 'dl/import'
+require 'gthelper'
+require 'core/str'
+
+module GT
+  extend DL::Importable
+  gtdlload "libgenometools"
+  extern "GtTileCache* gt_tile_cache_new(GtFeatureIndex*, GtStyle*, " + \
+                                        "unsigned long, unsigned int, " + \
+                                        "unsigned long, GtError*)"
+  extern "int  gt_tile_cache_render(GtTileCache*, const char*, " + \
+                                   "unsigned int, unsigned long, " + \
+                                   "unsigned long, GtError*)"
+  extern "int  gt_tile_cache_tile_to_stream(GtTileCache*, const char*, " + \
+                                           "unsigned int, unsigned long, " + \
+                                           "GtStr*, GtError*)"
+  extern "int  gt_tile_cache_tile_to_file(GtTileCache*, const char*, " + \
+                                         "unsigned int, unsigned long, " + \
+                                         "const char*, GtError*)"
+  extern "void gt_tile_cache_clear(GtTileCache*)"
+  extern "void gt_tile_cache_delete(GtTileCache*)"
+
+  class TileCache
+    def initialize(feature_index, style, tile_length, tile_width,
+                   max_tiles = 1024)
+      if !style.is_a?(GT::Style) then
+        GT.gterror("'style' parameter must be a Style object!")
+      end
+      if tile_length < 1 or max_tiles < 1 then
+        GT.gterror("tile length and maximal number of tiles must be > 0")
+      end
+      err = GT::Error.new()
+      @tile_length = tile_length
+      @tc = GT.gt_tile_cache_new(feature_index, style, tile_length,
+                                 tile_width, max_tiles, err)
+      if @tc.nil? then
+        GT::gterror(err)
+      end
+      @tc.free = GT::symbol("gt_tile_cache_delete", "0P")
+    end
+
+    def get_tile_range(zoom, tile)
+      length = @tile_length << zoom
+      (tile * length + 1)..((tile + 1) * length)
+    end
+
+    def render(seqid, zoom, first, last)
+      err = GT::Error.new()
+      if GT.gt_tile_cache_render(@tc, seqid, zoom, first, last, err) != 0 then
+        GT::gterror(err)
+      end
+    end
+
+    def to_stream(seqid, zoom, tile)
+      err = GT::Error.new()
+      str = GT::Str.new(nil)
+      if GT.gt_tile_cache_tile_to_stream(@tc, seqid, zoom, tile, str.to_ptr,
+                                         err) != 0 then
+        GT::gterror(err)
+      end
+      str.get_mem.to_s(str.length)
+    end
+
+    def to_file(seqid, zoom, tile, filename)
+      err = GT::Error.new()
+      if GT.gt_tile_cache_tile_to_file(@tc, seqid, zoom, tile, filename,
+                                       err) != 0 then
+        GT::gterror(err)
+      end
+    end
+
+    def clear
+      GT.gt_tile_cache_clear(@tc)
+    end
+
+    def to_ptr
+      @tc
+    end
+  end
+end
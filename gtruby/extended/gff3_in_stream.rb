@@ -30,6 +30,7 @@ module GT
   extern "GtStrArray* gt_gff3_in_stream_get_used_types(GtNodeStream*)"
   extern "void gt_gff3_in_stream_enable_strict_mode(GtGFF3InStream*)"
   extern "void gt_gff3_in_stream_enable_tidy_mode(GtGFF3InStream*)"
+  extern "void gt_gff3_in_stream_enable_node_arena(GtGFF3InStream*)"
   extern "void gt_gff3_in_stream_set_type_checker(GtNodeStream*,
                                                   GtTypeChecker*)"
 
@@ -60,6 +61,10 @@ module GT
       GT.gt_gff3_in_stream_enable_tidy_mode(@genome_stream)
     end
 
+    def enable_node_arena
+      GT.gt_gff3_in_stream_enable_node_arena(@genome_stream)
+    end
+
     def set_type_checker(checker)
       if !checker.is_a?(GT::TypeChecker) then
         GT.gterror("'checker' parameter must be a TypeChecker object!")
@@ -32,6 +32,7 @@
 #include "core/warning_api.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/bed_in_stream.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
@@ -104,6 +105,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
     "gff",
     "bed",
     "gtf",
+    "mapped",
     NULL
   };
   gt_assert(arguments);
@@ -177,7 +179,10 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
-                                       "choose from gff|bed|gtf",
+                                       "choose from gff|bed|gtf|mapped\n"
+                                       "(mapped: a feature index file written "
+                                       "by\n'gt mkfeatureindex -backend "
+                                       "mapped')",
                              arguments->input, inputs[0], inputs);
   gt_option_parser_add_option(op, option);
 
@@ -289,7 +294,17 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   file = argv[parsed_args];
-  if (!had_err) {
+  if (!had_err && strcmp(gt_str_get(arguments->input), "mapped") == 0) {
+    if (argc - parsed_args != 2) {
+      gt_error_set(err, "option -input mapped requires exactly one feature "
+                        "index file");
+      had_err = -1;
+    }
+    else if (!(features = gt_feature_index_mapped_new(argv[parsed_args + 1],
+                                                      err)))
+      had_err = -1;
+  }
+  else if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
     parsed_args++;
@@ -21,6 +21,7 @@
 #include "annotationsketch/default_formats.h"
 #include "annotationsketch/diagram.h"
 #include "annotationsketch/layout.h"
+#include "annotationsketch/layout_context.h"
 #include "annotationsketch/line_breaker_captions.h"
 #include "annotationsketch/style.h"
 #include "annotationsketch/text_width_calculator_cairo.h"
@@ -59,6 +60,7 @@ typedef struct {
 struct GtLayout {
   GtStyle *style;
   GtTextWidthCalculator *twc;
+  GtLayoutContext *context;
   bool own_twc,
        layout_done;
   GtArray *custom_tracks;
@@ -99,7 +101,8 @@ static int layout_tracks(void *key, void *value, void *data,
                          GtError *err)
 {
   GtUword i,
-                max = 50;
+          *lines = NULL,
+          max = 50;
   GtTrack *track = NULL;
   GtLayoutTraverseInfo *lti = (GtLayoutTraverseInfo*) data;
   GtArray *list = (GtArray*) value;
@@ -157,10 +160,32 @@ static int layout_tracks(void *key, void *value, void *data,
                                                       lti->layout->width,
                                                       lti->layout->style));
     lti->layout->nof_tracks++;
+    if (lti->layout->context)
+      lines = gt_malloc(sizeof *lines * gt_array_size(list));
     for (i = 0; !had_err && i < gt_array_size(list); i++) {
       block = *(GtBlock**) gt_array_get(list, i);
-      had_err = gt_track_insert_block(track, block, err);
+      if (lti->layout->context) {
+        /* keep the block in its previous line if possible */
+        lines[i] = gt_layout_context_get_line(lti->layout->context,
+                                              (char*) key, block);
+        had_err = gt_track_insert_block_with_preference(track, block,
+                                                        lines[i], lines + i,
+                                                        err);
+      }
+      else
+        had_err = gt_track_insert_block(track, block, err);
+    }
+    /* lines kept free for blocks which have left the view may be empty now,
+       close the gaps and remember the resulting lines for the next layout */
+    if (!had_err && lti->layout->context) {
+      gt_track_remove_empty_lines(track, lines, gt_array_size(list));
+      for (i = 0; i < gt_array_size(list); i++) {
+        gt_layout_context_set_line(lti->layout->context, (char*) key,
+                                   *(GtBlock**) gt_array_get(list, i),
+                                   lines[i]);
+      }
     }
+    gt_free(lines);
   }
   if (!had_err) {
     gt_hashmap_add(lti->layout->tracks, gt_cstr_dup(gt_str_get(gt_track_key)),
@@ -185,7 +210,13 @@ static int layout_all_tracks(GtLayout *layout, GtError *err)
   if (!layout->layout_done) {
     lti.layout = layout;
     lti.twc = layout->twc;
+    if (layout->context) {
+      gt_layout_context_begin(layout->context, layout->viewrange,
+                              layout->width);
+    }
     had_err = gt_hashmap_foreach(layout->blocks, layout_tracks, &lti, err);
+    if (layout->context)
+      gt_layout_context_end(layout->context);
     layout->layout_done = true;
   }
   return had_err;
@@ -298,12 +329,28 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
   return layout;
 }
 
+GtLayout* gt_layout_new_with_context(GtDiagram *diagram,
+                                     unsigned int width,
+                                     GtLayoutContext *context,
+                                     GtError *err)
+{
+  GtLayout *layout;
+  gt_assert(diagram && width > 0 && context && err);
+  layout = gt_layout_new_with_twc(diagram, width,
+                                  gt_layout_context_get_style(context),
+                                  gt_layout_context_get_twc(context), err);
+  if (layout)
+    layout->context = gt_layout_context_ref(context);
+  return layout;
+}
+
 void gt_layout_delete(GtLayout *layout)
 {
   if (!layout) return;
   gt_rwlock_wrlock(layout->lock);
   if (layout->twc && layout->own_twc)
     gt_text_width_calculator_delete(layout->twc);
+  gt_layout_context_delete(layout->context);
   gt_hashmap_delete(layout->tracks);
   gt_array_delete(layout->custom_tracks);
   if (layout->blocks)
@@ -20,6 +20,7 @@
 
 #include "annotationsketch/canvas_api.h"
 #include "annotationsketch/diagram_api.h"
+#include "annotationsketch/layout_context_api.h"
 #include "annotationsketch/style_api.h"
 #include "annotationsketch/text_width_calculator_api.h"
 #include "core/range_api.h"
@@ -53,6 +54,13 @@ GtLayout*     gt_layout_new_with_twc(GtDiagram*,
                                      GtStyle*,
                                      GtTextWidthCalculator*,
                                      GtError*);
+/* Like <gt_layout_new()>, but uses the style and the cached text widths of
+   <context>. Blocks which were already laid out by the previous layout created
+   with <context> at the same scale are kept in their lines if possible. */
+GtLayout*     gt_layout_new_with_context(GtDiagram *diagram,
+                                         unsigned int width,
+                                         GtLayoutContext *context,
+                                         GtError *err);
 /* Sets the <GtTrackOrderingFunc> comparator function <func> which defines an
    order on the tracks contained in <layout>. This determines the order in
    which the tracks are drawn vertically.
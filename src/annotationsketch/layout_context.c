@@ -0,0 +1,380 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include "annotationsketch/diagram.h"
+#include "annotationsketch/layout.h"
+#include "annotationsketch/layout_context.h"
+#include "annotationsketch/style.h"
+#include "annotationsketch/text_width_calculator_cached.h"
+#include "annotationsketch/text_width_calculator_cairo.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/str.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_type.h"
+#include "extended/gff3_defines.h"
+
+struct GtLayoutContext {
+  GtStyle *style;
+  GtTextWidthCalculator *twc;
+  /* track key -> (block key -> line number), for the current and the
+     previous layout */
+  GtHashmap *lines,
+            *prev_lines;
+  GtRange viewrange;
+  unsigned int width,
+               reference_count;
+  GtStr *key;
+};
+
+GtLayoutContext* gt_layout_context_new_with_twc(GtStyle *style,
+                                                GtTextWidthCalculator *twc)
+{
+  GtLayoutContext *context;
+  gt_assert(style && twc);
+  context = gt_calloc(1, sizeof *context);
+  context->style = gt_style_ref(style);
+  context->twc = gt_text_width_calculator_cached_new(twc);
+  context->lines = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                  (GtFree) gt_hashmap_delete);
+  context->key = gt_str_new();
+  return context;
+}
+
+GtLayoutContext* gt_layout_context_new(GtStyle *style, GtError *err)
+{
+  GtLayoutContext *context;
+  GtTextWidthCalculator *twc;
+  gt_assert(style);
+  gt_error_check(err);
+  if (!(twc = gt_text_width_calculator_cairo_new(NULL, style, err)))
+    return NULL;
+  context = gt_layout_context_new_with_twc(style, twc);
+  gt_text_width_calculator_delete(twc);
+  return context;
+}
+
+GtLayoutContext* gt_layout_context_ref(GtLayoutContext *context)
+{
+  gt_assert(context);
+  context->reference_count++;
+  return context;
+}
+
+GtStyle* gt_layout_context_get_style(const GtLayoutContext *context)
+{
+  gt_assert(context);
+  return context->style;
+}
+
+GtTextWidthCalculator* gt_layout_context_get_twc(const GtLayoutContext
+                                                 *context)
+{
+  gt_assert(context);
+  return context->twc;
+}
+
+void gt_layout_context_begin(GtLayoutContext *context, GtRange viewrange,
+                             unsigned int width)
+{
+  gt_assert(context && !context->prev_lines);
+  /* line assignments are only reused if the number of bases per pixel is the
+     same, otherwise the blocks and captions need different space */
+  if (context->width == width
+        && gt_range_length(&context->viewrange)
+             == gt_range_length(&viewrange)) {
+    context->prev_lines = context->lines;
+    context->lines = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                    (GtFree) gt_hashmap_delete);
+  }
+  else
+    gt_hashmap_reset(context->lines);
+  context->viewrange = viewrange;
+  context->width = width;
+}
+
+/* blocks are identified by sequence region, range, type and the ID of their
+   top level feature, which do not depend on the shown range or on the
+   feature nodes being the same objects (they may have been recreated from a
+   feature index in between) */
+static const char* layout_context_block_key(GtLayoutContext *context,
+                                            GtBlock *block)
+{
+  GtFeatureNode *fn;
+  GtRange range = gt_block_get_range(block);
+  const char *id = NULL;
+  char buf[BUFSIZ];
+  gt_str_reset(context->key);
+  if ((fn = gt_block_get_top_level_feature(block))) {
+    gt_str_append_str(context->key,
+                      gt_genome_node_get_seqid((GtGenomeNode*) fn));
+    id = gt_feature_node_get_attribute(fn, GT_GFF_ID);
+  }
+  else if (gt_block_get_caption(block))
+    id = gt_str_get(gt_block_get_caption(block));
+  (void) snprintf(buf, BUFSIZ, "|" GT_WU "|" GT_WU "|", range.start,
+                  range.end);
+  gt_str_append_cstr(context->key, buf);
+  gt_str_append_cstr(context->key, gt_block_get_type(block));
+  gt_str_append_char(context->key, '|');
+  if (id)
+    gt_str_append_cstr(context->key, id);
+  return gt_str_get(context->key);
+}
+
+GtUword gt_layout_context_get_line(GtLayoutContext *context,
+                                   const char *track_key, GtBlock *block)
+{
+  GtHashmap *blocks;
+  GtUword *line;
+  gt_assert(context && track_key && block);
+  if (!context->prev_lines
+        || !(blocks = gt_hashmap_get(context->prev_lines, track_key))
+        || !(line = gt_hashmap_get(blocks,
+                                   layout_context_block_key(context, block)))) {
+    return GT_UNDEF_UWORD;
+  }
+  return *line;
+}
+
+void gt_layout_context_set_line(GtLayoutContext *context,
+                                const char *track_key, GtBlock *block,
+                                GtUword line)
+{
+  GtHashmap *blocks;
+  GtUword *value;
+  gt_assert(context && track_key && block);
+  if (!(blocks = gt_hashmap_get(context->lines, track_key))) {
+    blocks = gt_hashmap_new(GT_HASH_STRING, gt_free_func, gt_free_func);
+    gt_hashmap_add(context->lines, gt_cstr_dup(track_key), blocks);
+  }
+  value = gt_malloc(sizeof *value);
+  *value = line;
+  gt_hashmap_add(blocks,
+                 gt_cstr_dup(layout_context_block_key(context, block)), value);
+}
+
+void gt_layout_context_end(GtLayoutContext *context)
+{
+  gt_assert(context);
+  gt_hashmap_delete(context->prev_lines);
+  context->prev_lines = NULL;
+}
+
+void gt_layout_context_reset(GtLayoutContext *context)
+{
+  gt_assert(context && !context->prev_lines);
+  gt_hashmap_reset(context->lines);
+  context->width = 0;
+}
+
+void gt_layout_context_delete(GtLayoutContext *context)
+{
+  if (!context) return;
+  if (context->reference_count) {
+    context->reference_count--;
+    return;
+  }
+  gt_hashmap_delete(context->prev_lines);
+  gt_hashmap_delete(context->lines);
+  gt_text_width_calculator_delete(context->twc);
+  gt_style_delete(context->style);
+  gt_str_delete(context->key);
+  gt_free(context);
+}
+
+typedef struct {
+  const char *track_key;
+  GtUword start;
+  GtBlock *block;
+} GtLayoutContextTestInfo;
+
+static int layout_context_test_get_block(void *key, void *value, void *data,
+                                         GT_UNUSED GtError *err)
+{
+  GtLayoutContextTestInfo *info = data;
+  GtArray *blocks = value;
+  GtUword i;
+  for (i = 0; i < gt_array_size(blocks); i++) {
+    GtBlock *block = *(GtBlock**) gt_array_get(blocks, i);
+    if (gt_block_get_range(block).start == info->start) {
+      info->track_key = key;
+      info->block = block;
+    }
+  }
+  return 0;
+}
+
+/* returns the line of the block starting at <start> in the last layout of
+   <diagram> done with <context> */
+static GtUword layout_context_test_line(GtLayoutContext *context,
+                                        GtDiagram *diagram, GtUword start,
+                                        GtError *err)
+{
+  GtLayoutContextTestInfo info;
+  GtHashmap *blocks;
+  GtUword *line;
+  info.track_key = NULL;
+  info.start = start;
+  info.block = NULL;
+  if (!(blocks = gt_diagram_get_blocks(diagram, err))
+        || gt_hashmap_foreach(blocks, layout_context_test_get_block, &info,
+                              err) != 0
+        || !info.block
+        || !(blocks = gt_hashmap_get(context->lines, info.track_key))
+        || !(line = gt_hashmap_get(blocks,
+                                   layout_context_block_key(context,
+                                                            info.block)))) {
+    return GT_UNDEF_UWORD;
+  }
+  return *line;
+}
+
+static int layout_context_test_layout(GtLayoutContext *context,
+                                      GtDiagram *diagram, unsigned int width,
+                                      GtError *err)
+{
+  GtLayout *layout;
+  GtUword height;
+  int had_err = 0;
+  if (!(layout = gt_layout_new_with_context(diagram, width, context, err)))
+    return -1;
+  had_err = gt_layout_get_height(layout, &height, err);
+  gt_layout_delete(layout);
+  return had_err;
+}
+
+/* creates genes A (100-400), B (300-600) and C (650-900), the latter is left
+   out if <with_c> is false */
+static GtArray* layout_context_test_genes(GtStr *seqid, bool with_c)
+{
+  GtArray *features;
+  GtRange r[3] = {{100, 400}, {300, 600}, {650, 900}};
+  const char *names[3] = {"A", "B", "C"};
+  GtGenomeNode *gn;
+  GtUword i;
+  features = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; i < (with_c ? 3UL : 2UL); i++) {
+    gn = gt_feature_node_new(seqid, gt_ft_gene, r[i].start, r[i].end,
+                             GT_STRAND_FORWARD);
+    gt_feature_node_add_attribute((GtFeatureNode*) gn, GT_GFF_ID, names[i]);
+    gt_feature_node_add_attribute((GtFeatureNode*) gn, GT_GFF_NAME, names[i]);
+    gt_array_add(features, gn);
+  }
+  return features;
+}
+
+static void layout_context_test_genes_delete(GtArray *features)
+{
+  GtUword i;
+  if (!features) return;
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+  gt_array_delete(features);
+}
+
+int gt_layout_context_unit_test(GtError *err)
+{
+  GtLayoutContext *context = NULL;
+  GtDiagram *d1 = NULL, *d2 = NULL, *d3 = NULL;
+  GtArray *features1, *features2, *features3;
+  GtStyle *style;
+  GtStr *seqid;
+  GtRange r1 = {1, 1000}, r2 = {401, 1400};
+  GtUword num_of_texts = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  seqid = gt_str_new_cstr("ctg");
+  features1 = layout_context_test_genes(seqid, true);
+  /* the same genes recreated, as if loaded again from a feature index */
+  features2 = layout_context_test_genes(seqid, true);
+  /* gene C has been deleted */
+  features3 = layout_context_test_genes(seqid, false);
+
+  if (!(style = gt_style_new(err)))
+    had_err = -1;
+  if (!had_err && !(context = gt_layout_context_new(style, err)))
+    had_err = -1;
+  if (!had_err) {
+    d1 = gt_diagram_new_from_array(features1, &r1, style);
+    d2 = gt_diagram_new_from_array(features2, &r2, style);
+    d3 = gt_diagram_new_from_array(features3, &r2, style);
+  }
+
+  /* all genes are in view, B overlaps A and is placed below it, C fits
+     behind A */
+  if (!had_err)
+    had_err = layout_context_test_layout(context, d1, 800, err);
+  if (!had_err) {
+    gt_ensure(layout_context_test_line(context, d1, 100, err) == 0);
+    gt_ensure(layout_context_test_line(context, d1, 300, err) == 1UL);
+    gt_ensure(layout_context_test_line(context, d1, 650, err) == 0);
+    num_of_texts = gt_text_width_calculator_cached_size(context->twc);
+    gt_ensure(num_of_texts > 0);
+  }
+
+  /* A leaves the view, B and C keep their lines although C would fit into
+     line 0 after B, no caption is measured again */
+  if (!had_err)
+    had_err = layout_context_test_layout(context, d2, 800, err);
+  if (!had_err) {
+    gt_ensure(layout_context_test_line(context, d2, 300, err) == 1UL);
+    gt_ensure(layout_context_test_line(context, d2, 650, err) == 0);
+    gt_ensure(gt_text_width_calculator_cached_size(context->twc)
+                == num_of_texts);
+  }
+
+  /* C is gone, B moves up as no empty line is kept */
+  if (!had_err)
+    had_err = layout_context_test_layout(context, d3, 800, err);
+  if (!had_err)
+    gt_ensure(layout_context_test_line(context, d3, 300, err) == 0);
+
+  /* other scale, the layout is done from scratch */
+  if (!had_err)
+    had_err = layout_context_test_layout(context, d2, 1000, err);
+  if (!had_err) {
+    gt_ensure(layout_context_test_line(context, d2, 300, err) == 0);
+    gt_ensure(layout_context_test_line(context, d2, 650, err) == 0);
+  }
+
+  /* same scale after a reset */
+  if (!had_err) {
+    gt_layout_context_reset(context);
+    had_err = layout_context_test_layout(context, d1, 1000, err);
+  }
+  if (!had_err)
+    had_err = layout_context_test_layout(context, d2, 1000, err);
+  if (!had_err)
+    gt_ensure(layout_context_test_line(context, d2, 300, err) == 1UL);
+
+  gt_diagram_delete(d1);
+  gt_diagram_delete(d2);
+  gt_diagram_delete(d3);
+  gt_layout_context_delete(context);
+  gt_style_delete(style);
+  layout_context_test_genes_delete(features1);
+  layout_context_test_genes_delete(features2);
+  layout_context_test_genes_delete(features3);
+  gt_str_delete(seqid);
+  return had_err;
+}
@@ -0,0 +1,53 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LAYOUT_CONTEXT_H
+#define LAYOUT_CONTEXT_H
+
+#include "annotationsketch/block.h"
+#include "annotationsketch/layout_context_api.h"
+#include "core/range_api.h"
+
+GtLayoutContext*       gt_layout_context_ref(GtLayoutContext *context);
+GtStyle*               gt_layout_context_get_style(const GtLayoutContext
+                                                   *context);
+/* Returns the caching text width calculator of <context>. */
+GtTextWidthCalculator* gt_layout_context_get_twc(const GtLayoutContext
+                                                 *context);
+/* Starts a new layout of <viewrange> with <width> pixels. The line
+   assignments of the previous layout are kept for
+   <gt_layout_context_get_line()> if the scale did not change. */
+void                   gt_layout_context_begin(GtLayoutContext *context,
+                                               GtRange viewrange,
+                                               unsigned int width);
+/* Returns the line <block> was assigned to in track <track_key> by the
+   previous layout, or GT_UNDEF_UWORD if there is none. */
+GtUword                gt_layout_context_get_line(GtLayoutContext *context,
+                                                  const char *track_key,
+                                                  GtBlock *block);
+/* Records that <block> has been assigned to <line> in track <track_key> by
+   the current layout. */
+void                   gt_layout_context_set_line(GtLayoutContext *context,
+                                                  const char *track_key,
+                                                  GtBlock *block,
+                                                  GtUword line);
+/* Finishes the current layout, the line assignments of the previous layout
+   are dropped. */
+void                   gt_layout_context_end(GtLayoutContext *context);
+
+int                    gt_layout_context_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LAYOUT_CONTEXT_API_H
+#define LAYOUT_CONTEXT_API_H
+
+#include "annotationsketch/style_api.h"
+#include "annotationsketch/text_width_calculator_api.h"
+
+/* The <GtLayoutContext> class keeps the state of consecutive <GtLayout>s of
+   the same data, as produced by zooming and panning in an interactive viewer.
+   The text widths of block captions are measured only once per caption string
+   and cached for all layouts created with the context; font metrics are not
+   cached. As long as the scale (the number of bases per pixel) stays the
+   same, the blocks remaining in view keep the lines they were assigned to in
+   the previous layout, if they still fit there, and the blocks entering the
+   view are placed into the first free line. Lines left empty by blocks
+   leaving the view are removed. Note that this is not an incremental
+   relayout: every layout still collects and line-breaks all blocks in view,
+   only the line choice is reused.
+   Blocks are recognized by sequence region, range, type and the ID of their
+   top level feature, so the features may be loaded anew for each layout.
+   A <GtLayoutContext> must not be used by several threads at once. */
+typedef struct GtLayoutContext GtLayoutContext;
+
+/* Creates a new <GtLayoutContext> for layouts using <style>, measuring text
+   widths with Cairo. Returns NULL and sets <err> on error. */
+GtLayoutContext* gt_layout_context_new(GtStyle *style, GtError *err);
+/* Like <gt_layout_context_new()>, but measures text widths with <twc>. */
+GtLayoutContext* gt_layout_context_new_with_twc(GtStyle *style,
+                                                GtTextWidthCalculator *twc);
+/* Forgets the line assignments of the previous layout done with <context>,
+   the cached text widths are kept. */
+void             gt_layout_context_reset(GtLayoutContext *context);
+/* Deletes <context>. */
+void             gt_layout_context_delete(GtLayoutContext *context);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "annotationsketch/text_width_calculator_cached.h"
+#include "annotationsketch/text_width_calculator_rep.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
+
+struct GtTextWidthCalculatorCached {
+  const GtTextWidthCalculator parent_instance;
+  GtTextWidthCalculator *backend;
+  GtHashmap *widths;              /* text -> double */
+  GtUword num_of_texts;
+  GtMutex *mutex;
+};
+
+#define gt_text_width_calculator_cached_cast(TWC)\
+        gt_text_width_calculator_cast(gt_text_width_calculator_cached_class(),\
+                                      TWC)
+
+static double gt_text_width_calculator_cached_get_text_width(
+                                                     GtTextWidthCalculator *twc,
+                                                     const char *text,
+                                                     GtError *err)
+{
+  GtTextWidthCalculatorCached *twcc;
+  double *width, result;
+  gt_assert(twc && text);
+  twcc = gt_text_width_calculator_cached_cast(twc);
+
+  /* the text width calculator is only read locked, serialize the accesses to
+     the cache and to the backend */
+  gt_mutex_lock(twcc->mutex);
+  if ((width = gt_hashmap_get(twcc->widths, text)))
+    result = *width;
+  else {
+    result = gt_text_width_calculator_get_text_width(twcc->backend, text, err);
+    if (!(result < 0)) {
+      width = gt_malloc(sizeof *width);
+      *width = result;
+      gt_hashmap_add(twcc->widths, gt_cstr_dup(text), width);
+      twcc->num_of_texts++;
+    }
+  }
+  gt_mutex_unlock(twcc->mutex);
+  return result;
+}
+
+static void gt_text_width_calculator_cached_delete(GtTextWidthCalculator *twc)
+{
+  GtTextWidthCalculatorCached *twcc;
+  if (!twc) return;
+  twcc = gt_text_width_calculator_cached_cast(twc);
+  gt_hashmap_delete(twcc->widths);
+  gt_mutex_delete(twcc->mutex);
+  gt_text_width_calculator_delete(twcc->backend);
+}
+
+const GtTextWidthCalculatorClass* gt_text_width_calculator_cached_class(void)
+{
+  static const GtTextWidthCalculatorClass *twcc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!twcc)
+  {
+    twcc = gt_text_width_calculator_class_new(
+                                 sizeof (GtTextWidthCalculatorCached),
+                                 gt_text_width_calculator_cached_get_text_width,
+                                 gt_text_width_calculator_cached_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return twcc;
+}
+
+GtTextWidthCalculator* gt_text_width_calculator_cached_new(
+                                                 GtTextWidthCalculator *backend)
+{
+  GtTextWidthCalculatorCached *twcc;
+  GtTextWidthCalculator *twc;
+  gt_assert(backend);
+  twc = gt_text_width_calculator_create(
+                                      gt_text_width_calculator_cached_class());
+  twcc = gt_text_width_calculator_cached_cast(twc);
+  twcc->backend = gt_text_width_calculator_ref(backend);
+  twcc->widths = gt_hashmap_new(GT_HASH_STRING, gt_free_func, gt_free_func);
+  twcc->mutex = gt_mutex_new();
+  return twc;
+}
+
+GtUword gt_text_width_calculator_cached_size(GtTextWidthCalculator *twc)
+{
+  GtTextWidthCalculatorCached *twcc;
+  GtUword size;
+  gt_assert(twc);
+  twcc = gt_text_width_calculator_cached_cast(twc);
+  gt_mutex_lock(twcc->mutex);
+  size = twcc->num_of_texts;
+  gt_mutex_unlock(twcc->mutex);
+  return size;
+}
@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TEXT_WIDTH_CALCULATOR_CACHED_H
+#define TEXT_WIDTH_CALCULATOR_CACHED_H
+
+#include "annotationsketch/text_width_calculator.h"
+#include "core/types_api.h"
+
+/* Implements the <GtTextWidthCalculator> interface by caching the text widths
+   determined by another <GtTextWidthCalculator>. Each distinct text is
+   measured only once, which avoids the expensive font backend calls when
+   the same captions are laid out repeatedly. */
+typedef struct GtTextWidthCalculatorCached GtTextWidthCalculatorCached;
+
+const GtTextWidthCalculatorClass* gt_text_width_calculator_cached_class(void);
+/* Returns a new caching <GtTextWidthCalculator> on top of <backend>. */
+GtTextWidthCalculator*            gt_text_width_calculator_cached_new(
+                                             GtTextWidthCalculator *backend);
+/* Returns the number of texts whose widths are cached in <twc>. */
+GtUword                           gt_text_width_calculator_cached_size(
+                                             GtTextWidthCalculator *twc);
+
+#endif
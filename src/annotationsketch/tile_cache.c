@@ -0,0 +1,538 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <string.h>
+#include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/default_formats.h"
+#include "annotationsketch/diagram.h"
+#include "annotationsketch/layout.h"
+#include "annotationsketch/style.h"
+#include "annotationsketch/tile_cache.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/file_api.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/md5_encoder_api.h"
+#include "core/minmax.h"
+#include "core/str.h"
+#include "core/thread_api.h"
+#include "extended/feature_index.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node.h"
+
+#define GT_TILE_CACHE_HASHLEN  32
+
+typedef struct GtTileCacheEntry GtTileCacheEntry;
+
+struct GtTileCacheEntry {
+  char *key;
+  GtDiagram *diagram;
+  GtLayout *layout;
+  GtStr *image;                   /* NULL until the tile has been rendered */
+  GtTileCacheEntry *prev, *next;  /* most recently used entries first */
+};
+
+struct GtTileCache {
+  GtFeatureIndex *feature_index;
+  GtStyle *style;
+  GtHashmap *entries;             /* key -> GtTileCacheEntry* */
+  GtTileCacheEntry *first, *last;
+  GtUword tile_length,
+          max_tiles,
+          num_of_tiles;
+  unsigned int tile_width;
+};
+
+typedef struct {
+  GtTileCacheEntry *entry;
+  GtError *err;
+  int had_err;
+} GtTileCacheJob;
+
+typedef struct {
+  GtTileCacheJob *jobs;
+  GtUword num_of_jobs,
+          *nextjob;
+  GtMutex *mutex;
+  GtStyle *style;
+  unsigned int tile_width;
+} GtTileCacheThreadInfo;
+
+GtTileCache* gt_tile_cache_new(GtFeatureIndex *feature_index, GtStyle *style,
+                               GtUword tile_length, unsigned int tile_width,
+                               GtUword max_tiles, GtError *err)
+{
+  GtTileCache *tc;
+  double margins = MARGINS_DEFAULT;
+  gt_assert(feature_index && style && tile_length > 0 && max_tiles > 0);
+  gt_error_check(err);
+
+  if (gt_style_get_num(style, "format", "margins", &margins, NULL,
+                       err) == GT_STYLE_QUERY_ERROR) {
+    return NULL;
+  }
+  if ((double) tile_width <= 2 * margins) {
+    gt_error_set(err, "tile width must be larger than twice the x-margin "
+                      "size (2*%.1f=%.1f) but was %u", margins, 2 * margins,
+                 tile_width);
+    return NULL;
+  }
+  tc = gt_calloc(1, sizeof *tc);
+  tc->feature_index = gt_feature_index_ref(feature_index);
+  tc->style = gt_style_ref(style);
+  tc->entries = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  tc->tile_length = tile_length;
+  tc->tile_width = tile_width;
+  tc->max_tiles = max_tiles;
+  return tc;
+}
+
+GtRange gt_tile_cache_get_tile_range(const GtTileCache *tc, unsigned int zoom,
+                                     GtUword tile)
+{
+  GtRange range;
+  GtUword length;
+  gt_assert(tc && zoom < sizeof (GtUword) * CHAR_BIT);
+  length = tc->tile_length << zoom;
+  range.start = tile * length + 1;
+  range.end = range.start + length - 1;
+  return range;
+}
+
+static void tile_cache_entry_delete(GtTileCacheEntry *entry)
+{
+  if (!entry) return;
+  gt_layout_delete(entry->layout);
+  gt_diagram_delete(entry->diagram);
+  gt_str_delete(entry->image);
+  gt_free(entry->key);
+  gt_free(entry);
+}
+
+static void tile_cache_unlink(GtTileCache *tc, GtTileCacheEntry *entry)
+{
+  if (entry->prev)
+    entry->prev->next = entry->next;
+  else
+    tc->first = entry->next;
+  if (entry->next)
+    entry->next->prev = entry->prev;
+  else
+    tc->last = entry->prev;
+  entry->prev = entry->next = NULL;
+}
+
+static void tile_cache_link_first(GtTileCache *tc, GtTileCacheEntry *entry)
+{
+  entry->prev = NULL;
+  entry->next = tc->first;
+  if (tc->first)
+    tc->first->prev = entry;
+  else
+    tc->last = entry;
+  tc->first = entry;
+}
+
+static void tile_cache_remove(GtTileCache *tc, GtTileCacheEntry *entry)
+{
+  tile_cache_unlink(tc, entry);
+  gt_hashmap_remove(tc->entries, entry->key);
+  tc->num_of_tiles--;
+  tile_cache_entry_delete(entry);
+}
+
+/* computes the MD5 hash of the serialized <style>, so that changes to the
+   style result in new cache keys */
+static int tile_cache_style_hash(GtStyle *style, char *hash, GtError *err)
+{
+  GtMD5Encoder *enc;
+  GtStr *str;
+  unsigned char output[16];
+  GtUword i;
+  int had_err;
+
+  str = gt_str_new();
+  had_err = gt_style_to_str(style, str, err);
+  if (!had_err) {
+    enc = gt_md5_encoder_new();
+    for (i = 0; i < gt_str_length(str); i += 64) {
+      gt_md5_encoder_add_block(enc, gt_str_get(str) + i,
+                               MIN(64, gt_str_length(str) - i));
+    }
+    gt_md5_encoder_finish(enc, output, hash);
+    gt_md5_encoder_delete(enc);
+  }
+  gt_str_delete(str);
+  return had_err;
+}
+
+static int tile_cache_check_tiles(GtTileCache *tc, const char *seqid,
+                                  unsigned int zoom, GtUword from, GtUword to,
+                                  GtError *err)
+{
+  bool has_seqid = false;
+  int had_err;
+
+  had_err = gt_feature_index_has_seqid(tc->feature_index, &has_seqid, seqid,
+                                       err);
+  if (!had_err && !has_seqid) {
+    gt_error_set(err, "feature index does not contain sequence region '%s'",
+                 seqid);
+    had_err = -1;
+  }
+  if (!had_err && (zoom >= sizeof (GtUword) * CHAR_BIT
+                     || (tc->tile_length << zoom) >> zoom != tc->tile_length
+                     || to >= GT_UWORD_MAX / (tc->tile_length << zoom))) {
+    gt_error_set(err, "tile " GT_WU " at zoom level %u exceeds the range of "
+                      "sequence positions", to, zoom);
+    had_err = -1;
+  }
+  if (!had_err && from > to) {
+    gt_error_set(err, "first tile (" GT_WU ") must not be larger than last "
+                      "tile (" GT_WU ")", from, to);
+    had_err = -1;
+  }
+  return had_err;
+}
+
+/* returns the cache entry for the given tile, which becomes the most recently
+   used one; the diagram and layout of a new entry are built here, as they
+   reference the features of the index and must not be built concurrently */
+static GtTileCacheEntry* tile_cache_get_entry(GtTileCache *tc,
+                                              const char *seqid,
+                                              unsigned int zoom, GtUword tile,
+                                              const char *style_hash,
+                                              GtError *err)
+{
+  GtTileCacheEntry *entry;
+  GtRange range;
+  GtStr *key;
+
+  key = gt_str_new_cstr(seqid);
+  gt_str_append_char(key, '|');
+  gt_str_append_uint(key, zoom);
+  gt_str_append_char(key, '|');
+  gt_str_append_uword(key, tile);
+  gt_str_append_char(key, '|');
+  gt_str_append_cstr(key, style_hash);
+
+  if ((entry = gt_hashmap_get(tc->entries, gt_str_get(key))))
+    tile_cache_unlink(tc, entry);
+  else {
+    entry = gt_calloc(1, sizeof *entry);
+    range = gt_tile_cache_get_tile_range(tc, zoom, tile);
+    entry->diagram = gt_diagram_new(tc->feature_index, seqid, &range,
+                                    tc->style, err);
+    if (entry->diagram) {
+      entry->layout = gt_layout_new(entry->diagram, tc->tile_width, tc->style,
+                                    err);
+    }
+    if (!entry->layout) {
+      tile_cache_entry_delete(entry);
+      entry = NULL;
+    }
+    else {
+      entry->key = gt_cstr_dup(gt_str_get(key));
+      gt_hashmap_add(tc->entries, entry->key, entry);
+      tc->num_of_tiles++;
+    }
+  }
+  if (entry)
+    tile_cache_link_first(tc, entry);
+  gt_str_delete(key);
+  return entry;
+}
+
+static int tile_cache_sketch(GtTileCacheEntry *entry, GtStyle *style,
+                             unsigned int tile_width, GtError *err)
+{
+  GtCanvas *canvas = NULL;
+  GtUword height;
+  int had_err;
+
+  had_err = gt_layout_get_height(entry->layout, &height, err);
+  if (!had_err) {
+    canvas = gt_canvas_cairo_file_new(style, GT_GRAPHICS_PNG, tile_width,
+                                      height, NULL, err);
+    if (!canvas)
+      had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_layout_sketch(entry->layout, canvas, err);
+  if (!had_err) {
+    entry->image = gt_str_new();
+    had_err = gt_canvas_cairo_file_to_stream((GtCanvasCairoFile*) canvas,
+                                             entry->image);
+  }
+  gt_canvas_delete(canvas);
+  return had_err;
+}
+
+static void* tile_cache_sketch_thread(void *data)
+{
+  GtTileCacheThreadInfo *ti = data;
+  GtTileCacheJob *job;
+  GtUword jobnum;
+
+  for (;;) {
+    gt_mutex_lock(ti->mutex);
+    jobnum = (*ti->nextjob)++;
+    gt_mutex_unlock(ti->mutex);
+    if (jobnum >= ti->num_of_jobs)
+      break;
+    job = ti->jobs + jobnum;
+    job->had_err = tile_cache_sketch(job->entry, ti->style, ti->tile_width,
+                                     job->err);
+  }
+  return NULL;
+}
+
+/* lays out and renders the given entries, each tile into its own canvas;
+   the tiles are distributed dynamically, as their costs vary strongly */
+static void tile_cache_sketch_parallel(GtTileCache *tc, GtTileCacheJob *jobs,
+                                       GtUword num_of_jobs)
+{
+  GtTileCacheThreadInfo ti;
+  GtThread **threads;
+  GtUword nextjob = 0;
+  GtError *err;
+  unsigned int t, num_of_threads = gt_jobs;
+
+  if ((GtUword) num_of_threads > num_of_jobs)
+    num_of_threads = (unsigned int) num_of_jobs;
+  ti.jobs = jobs;
+  ti.num_of_jobs = num_of_jobs;
+  ti.nextjob = &nextjob;
+  ti.mutex = gt_mutex_new();
+  ti.style = tc->style;
+  ti.tile_width = tc->tile_width;
+  threads = gt_calloc(num_of_threads, sizeof *threads);
+  err = gt_error_new();
+  /* the current thread renders tiles as well; if a thread cannot be created,
+     the remaining threads take over its share */
+  for (t = 1; t < num_of_threads; t++) {
+    threads[t] = gt_thread_new(tile_cache_sketch_thread, &ti, err);
+    if (!threads[t])
+      gt_error_unset(err);
+  }
+  tile_cache_sketch_thread(&ti);
+  for (t = 1; t < num_of_threads; t++) {
+    if (threads[t]) {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threads[t]);
+#endif
+      gt_thread_delete(threads[t]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(threads);
+  gt_mutex_delete(ti.mutex);
+}
+
+int gt_tile_cache_render(GtTileCache *tc, const char *seqid, unsigned int zoom,
+                         GtUword from, GtUword to, GtError *err)
+{
+  char style_hash[GT_TILE_CACHE_HASHLEN + 1];
+  GtTileCacheEntry *entry;
+  GtTileCacheJob *jobs = NULL;
+  GtUword tile, i, num_of_jobs = 0;
+  int had_err;
+  gt_assert(tc && seqid);
+  gt_error_check(err);
+
+  had_err = tile_cache_check_tiles(tc, seqid, zoom, from, to, err);
+  if (!had_err)
+    had_err = tile_cache_style_hash(tc->style, style_hash, err);
+  if (!had_err)
+    jobs = gt_calloc(to - from + 1, sizeof *jobs);
+  for (tile = from; !had_err && tile <= to; tile++) {
+    if (!(entry = tile_cache_get_entry(tc, seqid, zoom, tile, style_hash,
+                                       err))) {
+      had_err = -1;
+    }
+    else if (!entry->image) {
+      jobs[num_of_jobs].entry = entry;
+      jobs[num_of_jobs++].err = gt_error_new();
+    }
+  }
+  if (!had_err && num_of_jobs > 0)
+    tile_cache_sketch_parallel(tc, jobs, num_of_jobs);
+  for (i = 0; i < num_of_jobs; i++) {
+    if (jobs[i].had_err) {
+      if (!had_err) {
+        gt_error_set(err, "%s", gt_error_get(jobs[i].err));
+        had_err = -1;
+      }
+      tile_cache_remove(tc, jobs[i].entry);
+    }
+    gt_error_delete(jobs[i].err);
+  }
+  gt_free(jobs);
+  /* drop the least recently used tiles, the tiles requested last are kept
+     unless they exceed the capacity of the cache on their own */
+  while (tc->num_of_tiles > tc->max_tiles)
+    tile_cache_remove(tc, tc->last);
+  return had_err;
+}
+
+int gt_tile_cache_tile_to_stream(GtTileCache *tc, const char *seqid,
+                                 unsigned int zoom, GtUword tile,
+                                 GtStr *stream, GtError *err)
+{
+  int had_err;
+  gt_assert(tc && seqid && stream);
+  gt_error_check(err);
+
+  had_err = gt_tile_cache_render(tc, seqid, zoom, tile, tile, err);
+  if (!had_err) {
+    /* the requested tile is the most recently used one */
+    gt_assert(tc->first && tc->first->image);
+    gt_str_append_str(stream, tc->first->image);
+  }
+  return had_err;
+}
+
+int gt_tile_cache_tile_to_file(GtTileCache *tc, const char *seqid,
+                               unsigned int zoom, GtUword tile,
+                               const char *filename, GtError *err)
+{
+  GtFile *file;
+  GtStr *image;
+  int had_err;
+  gt_assert(tc && seqid && filename);
+  gt_error_check(err);
+
+  image = gt_str_new();
+  had_err = gt_tile_cache_tile_to_stream(tc, seqid, zoom, tile, image, err);
+  if (!had_err) {
+    if (!(file = gt_file_new(filename, "w", err)))
+      had_err = -1;
+    else {
+      gt_file_xwrite(file, gt_str_get_mem(image), gt_str_length(image));
+      gt_file_delete(file);
+    }
+  }
+  gt_str_delete(image);
+  return had_err;
+}
+
+void gt_tile_cache_clear(GtTileCache *tc)
+{
+  gt_assert(tc);
+  while (tc->first)
+    tile_cache_remove(tc, tc->first);
+  gt_assert(tc->num_of_tiles == 0);
+}
+
+void gt_tile_cache_delete(GtTileCache *tc)
+{
+  if (!tc) return;
+  gt_tile_cache_clear(tc);
+  gt_hashmap_delete(tc->entries);
+  gt_style_delete(tc->style);
+  gt_feature_index_delete(tc->feature_index);
+  gt_free(tc);
+}
+
+int gt_tile_cache_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtTileCache *tc = NULL;
+  GtStyle *style;
+  GtStr *image1, *image2;
+  GtRange range;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gn = gt_feature_node_new_standard_gene();
+  fi = gt_feature_index_memory_new();
+  style = gt_style_new(err);
+  image1 = gt_str_new();
+  image2 = gt_str_new();
+  if (!style)
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_feature_index_add_feature_node(fi, gt_feature_node_cast(gn),
+                                                err);
+  gt_genome_node_delete(gn);
+
+  if (!had_err) {
+    gt_ensure(!gt_tile_cache_new(fi, style, 1000, 50, 4, err));
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+  }
+  if (!had_err && !(tc = gt_tile_cache_new(fi, style, 1000, 400, 4, err)))
+    had_err = -1;
+
+  if (!had_err) {
+    range = gt_tile_cache_get_tile_range(tc, 0, 0);
+    gt_ensure(range.start == 1 && range.end == 1000);
+    range = gt_tile_cache_get_tile_range(tc, 2, 3);
+    gt_ensure(range.start == 12001 && range.end == 16000);
+  }
+
+  /* the standard gene spans 1000-9000, render tiles 0-9 at zoom level 0 */
+  if (!had_err)
+    had_err = gt_tile_cache_render(tc, "ctg123", 0, 0, 9, err);
+  gt_ensure(!had_err && tc->num_of_tiles == 4);
+  if (!had_err) {
+    had_err = gt_tile_cache_tile_to_stream(tc, "ctg123", 0, 8, image1, err);
+    gt_ensure(!had_err && gt_str_length(image1) > 8);
+    gt_ensure(memcmp(gt_str_get_mem(image1), "\211PNG", 4) == 0);
+    gt_ensure(tc->num_of_tiles == 4);
+  }
+  /* tile 8 is taken from the cache */
+  if (!had_err) {
+    had_err = gt_tile_cache_tile_to_stream(tc, "ctg123", 0, 8, image2, err);
+    gt_ensure(!had_err && gt_str_cmp(image1, image2) == 0);
+    gt_str_reset(image2);
+  }
+  /* tile 1 has been dropped and is rendered again */
+  if (!had_err) {
+    had_err = gt_tile_cache_tile_to_stream(tc, "ctg123", 0, 1, image2, err);
+    gt_ensure(!had_err && gt_str_length(image2) > 0);
+    gt_ensure(tc->num_of_tiles == 4);
+  }
+
+  /* errors */
+  if (!had_err) {
+    gt_ensure(gt_tile_cache_render(tc, "foo", 0, 0, 1, err));
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+    gt_ensure(gt_tile_cache_render(tc, "ctg123", 0, 2, 1, err));
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+    gt_ensure(gt_tile_cache_render(tc, "ctg123", 0, GT_UWORD_MAX, GT_UWORD_MAX,
+                                   err));
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+  }
+
+  if (!had_err) {
+    gt_tile_cache_clear(tc);
+    gt_ensure(tc->num_of_tiles == 0 && !tc->first && !tc->last);
+  }
+
+  gt_tile_cache_delete(tc);
+  gt_str_delete(image1);
+  gt_str_delete(image2);
+  gt_style_delete(style);
+  gt_feature_index_delete(fi);
+  return had_err;
+}
@@ -0,0 +1,78 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TILE_CACHE_API_H
+#define TILE_CACHE_API_H
+
+#include "annotationsketch/style_api.h"
+#include "core/range_api.h"
+#include "core/str_api.h"
+#include "extended/feature_index_api.h"
+
+/* The <GtTileCache> class renders the features of a <GtFeatureIndex> as
+   fixed-size tiles, as needed by genome browsers. At zoom level 0 a tile
+   covers <tile_length> bases, each further zoom level doubles the length of
+   a tile, while the width of its image stays the same. Tile <n> of a zoom
+   level starts at base <n> * <tile length> + 1.
+   Layouts and rendered PNG images are cached per sequence region, zoom level,
+   tile and style, so repeated requests and requests for neighbouring tiles
+   do not rebuild diagrams. Tiles missing from the cache are laid out and
+   rendered in parallel (using <gt_jobs> threads), each into its own Cairo
+   surface. Changes to the <GtStyle> result in new cache entries, changes to
+   the <GtFeatureIndex> require a call to <gt_tile_cache_clear()>.
+   A <GtTileCache> must not be used by several threads at once. */
+typedef struct GtTileCache GtTileCache;
+
+/* Returns a new <GtTileCache> object for the features in <feature_index>
+   rendered using <style>. Tiles at zoom level 0 cover <tile_length> bases and
+   are rendered <tile_width> pixels wide. At most <max_tiles> tiles are kept in
+   the cache, the least recently used tiles are dropped first.
+   Returns NULL and sets <err> if <tile_width> is too small for the margins
+   defined in <style>. */
+GtTileCache* gt_tile_cache_new(GtFeatureIndex *feature_index, GtStyle *style,
+                               GtUword tile_length, unsigned int tile_width,
+                               GtUword max_tiles, GtError *err);
+/* Returns the range covered by tile number <tile> at zoom level <zoom> in
+   <tile_cache>. */
+GtRange      gt_tile_cache_get_tile_range(const GtTileCache *tile_cache,
+                                          unsigned int zoom, GtUword tile);
+/* Makes sure that the tiles <from> to <to> (inclusively) at zoom level <zoom>
+   of the sequence region <seqid> are cached, rendering all missing tiles in
+   parallel. Returns 0 on success, -1 otherwise (<err> is set accordingly). */
+int          gt_tile_cache_render(GtTileCache *tile_cache, const char *seqid,
+                                  unsigned int zoom, GtUword from, GtUword to,
+                                  GtError *err);
+/* Appends the PNG image of tile <tile> at zoom level <zoom> of the sequence
+   region <seqid> to <stream>, rendering the tile if it is not cached.
+   Returns 0 on success, -1 otherwise (<err> is set accordingly). */
+int          gt_tile_cache_tile_to_stream(GtTileCache *tile_cache,
+                                          const char *seqid, unsigned int zoom,
+                                          GtUword tile, GtStr *stream,
+                                          GtError *err);
+/* Writes the PNG image of tile <tile> at zoom level <zoom> of the sequence
+   region <seqid> to the file <filename>, rendering the tile if it is not
+   cached. Returns 0 on success, -1 otherwise (<err> is set accordingly). */
+int          gt_tile_cache_tile_to_file(GtTileCache *tile_cache,
+                                        const char *seqid, unsigned int zoom,
+                                        GtUword tile, const char *filename,
+                                        GtError *err);
+/* Drops all tiles from <tile_cache>. Must be called after the contents of the
+   underlying <GtFeatureIndex> have changed. */
+void         gt_tile_cache_clear(GtTileCache *tile_cache);
+/* Deletes <tile_cache> and all cached tiles. */
+void         gt_tile_cache_delete(GtTileCache *tile_cache);
+
+#endif
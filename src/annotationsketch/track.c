@@ -53,17 +53,38 @@ GtTrack* gt_track_new(GtStr *title, GtUword max_num_lines,
   return track;
 }
 
-static int get_next_free_line(GtTrack *track, GtLine **result, GtBlock *block,
-                              GtError *err)
+static int get_next_free_line(GtTrack *track, GtLine **result,
+                              GtUword *line_number, GtBlock *block,
+                              GtUword preferred_line, GtError *err)
 {
   GtUword i;
   GtLine* line;
   int had_err = 0;
   bool is_occupied;
-  gt_assert(track);
+  gt_assert(track && line_number);
+
+  /* try the preferred line first, to keep the block where it was before;
+     missing lines are added, those staying empty are removed afterwards by
+     gt_track_remove_empty_lines() */
+  if (track->split && preferred_line != GT_UNDEF_UWORD
+        && (track->max_num_lines == GT_UNDEF_UWORD
+              || preferred_line < track->max_num_lines)) {
+    while (gt_array_size(track->lines) <= preferred_line) {
+      line = gt_line_new();
+      gt_array_add(track->lines, line);
+    }
+    line = *(GtLine**) gt_array_get(track->lines, preferred_line);
+    had_err = gt_line_breaker_line_is_occupied(track->lb, &is_occupied, line,
+                                               block, err);
+    if (!had_err && !is_occupied) {
+      *result = line;
+      *line_number = preferred_line;
+      return 0;
+    }
+  }
 
   /* find unoccupied line -- may need optimisation */
-  for (i = 0; i < gt_array_size(track->lines); i++) {
+  for (i = 0; !had_err && i < gt_array_size(track->lines); i++) {
     line = *(GtLine**) gt_array_get(track->lines, i);
     had_err = gt_line_breaker_line_is_occupied(track->lb, &is_occupied, line,
                                                block, err);
@@ -71,6 +92,7 @@ static int get_next_free_line(GtTrack *track, GtLine **result, GtBlock *block,
       break;
     if (!is_occupied) {
       *result = line;
+      *line_number = i;
       return 0;
     }
   }
@@ -101,6 +123,7 @@ static int get_next_free_line(GtTrack *track, GtLine **result, GtBlock *block,
       gt_array_add(track->lines, line);
     }
     gt_assert(line);
+    *line_number = gt_array_size(track->lines) - 1;
   }
   *result = line;
   return had_err;
@@ -125,12 +148,22 @@ GtUword gt_track_get_number_of_discarded_blocks(GtTrack *track)
 }
 
 int gt_track_insert_block(GtTrack *track, GtBlock *block, GtError *err)
+{
+  GtUword line_number;
+  return gt_track_insert_block_with_preference(track, block, GT_UNDEF_UWORD,
+                                               &line_number, err);
+}
+
+int gt_track_insert_block_with_preference(GtTrack *track, GtBlock *block,
+                                          GtUword preferred_line,
+                                          GtUword *line_number, GtError *err)
 {
   GtLine *line = NULL;
   int had_err = 0;
 
-  gt_assert(track && block);
-  had_err = get_next_free_line(track, &line, block, err);
+  gt_assert(track && block && line_number);
+  had_err = get_next_free_line(track, &line, line_number, block,
+                               preferred_line, err);
   if (!had_err)
   {
     if (line) {
@@ -142,6 +175,30 @@ int gt_track_insert_block(GtTrack *track, GtBlock *block, GtError *err)
   return had_err;
 }
 
+void gt_track_remove_empty_lines(GtTrack *track, GtUword *line_numbers,
+                                 GtUword nof_line_numbers)
+{
+  GtUword i, j, nof_lines, *new_index;
+  GtLine *line;
+  gt_assert(track);
+  nof_lines = gt_array_size(track->lines);
+  new_index = gt_malloc(sizeof *new_index * (nof_lines + 1));
+  for (i = 0, j = 0; i < nof_lines; i++) {
+    line = *(GtLine**) gt_array_get(track->lines, i);
+    new_index[i] = j;
+    if (gt_array_size(gt_line_get_blocks(line)) > 0)
+      *(GtLine**) gt_array_get(track->lines, j++) = line;
+    else
+      gt_line_delete(line);
+  }
+  gt_array_set_size(track->lines, j);
+  for (i = 0; i < nof_line_numbers; i++) {
+    gt_assert(line_numbers[i] < nof_lines);
+    line_numbers[i] = new_index[line_numbers[i]];
+  }
+  gt_free(new_index);
+}
+
 GtStr* gt_track_get_title(const GtTrack *track)
 {
   gt_assert(track && track->title);
@@ -391,6 +448,26 @@ int gt_track_unit_test(GtError *err)
   gt_ensure(gt_track_get_number_of_discarded_blocks(track) == 0);
 
   gt_track_delete(track);
+
+  /* lines added for a preferred line are removed again if they stay empty */
+  if (!had_err) {
+    GtUword line_numbers[2];
+    lb = gt_line_breaker_bases_new();
+    track = gt_track_new(title, GT_UNDEF_UWORD, true, lb);
+    gt_ensure(gt_track_insert_block_with_preference(track, b[0], 2UL,
+                                                    line_numbers, err) == 0);
+    gt_ensure(line_numbers[0] == 2UL);
+    gt_ensure(gt_track_insert_block_with_preference(track, b[2], 2UL,
+                                                    line_numbers + 1,
+                                                    err) == 0);
+    gt_ensure(line_numbers[1] == 0);
+    gt_ensure(gt_track_get_number_of_lines(track) == 3UL);
+    gt_track_remove_empty_lines(track, line_numbers, 2UL);
+    gt_ensure(gt_track_get_number_of_lines(track) == 2UL);
+    gt_ensure(line_numbers[0] == 1UL);
+    gt_ensure(line_numbers[1] == 0);
+    gt_track_delete(track);
+  }
   gt_str_delete(title);
   gt_style_delete(sty);
   for (i=0;i<4;i++)
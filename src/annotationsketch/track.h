@@ -29,6 +29,23 @@ typedef struct GtTrack GtTrack;
 GtTrack*      gt_track_new(GtStr *title, GtUword max_num_lines,
                            bool split_lines, GtLineBreaker *lb);
 int           gt_track_insert_block(GtTrack*, GtBlock*, GtError*);
+/* Like <gt_track_insert_block()>, but inserts <block> into the line with index
+   <preferred_line> if lines are split and it is not occupied, missing lines
+   are added (up to the line limit). Pass GT_UNDEF_UWORD for no preference.
+   The index of the line <block> was inserted into is stored in
+   <line_number>. Lines added this way may stay empty, use
+   <gt_track_remove_empty_lines()> after inserting all blocks. */
+int           gt_track_insert_block_with_preference(GtTrack *track,
+                                                    GtBlock *block,
+                                                    GtUword preferred_line,
+                                                    GtUword *line_number,
+                                                    GtError *err);
+/* Removes the lines of <track> which contain no block, keeping the order of
+   the others. The <nof_line_numbers> line indices in <line_numbers> are
+   changed to the indices of the same lines after the removal. */
+void          gt_track_remove_empty_lines(GtTrack *track,
+                                          GtUword *line_numbers,
+                                          GtUword nof_line_numbers);
 GtStr*        gt_track_get_title(const GtTrack*);
 GtUword gt_track_get_number_of_discarded_blocks(GtTrack *track);
 int           gt_track_sketch(GtTrack*, GtCanvas*, GtError*);
@@ -16,6 +16,7 @@
 */
 
 #include <limits.h>
+#include <string.h>
 #include "core/dlist.h"
 #include "core/ensure.h"
 #include "core/ma.h"
@@ -31,6 +32,9 @@ struct GtDlist {
               *last;
   void *data;
   GtUword size;
+  GtDlistAllocFunc alloc_func; /* NULL if allocated with gt_calloc() */
+  GtDlistFreeFunc free_func;
+  void *alloc_data;
 };
 
 struct GtDlistelem {
@@ -63,6 +67,43 @@ GtDlist* gt_dlist_new_with_data(GtCompareWithData cmp_func, void *data)
   return dlist;
 }
 
+GtDlist* gt_dlist_new_with_allocator(GtCompare cmp_func,
+                                     GtDlistAllocFunc alloc_func,
+                                     GtDlistFreeFunc free_func,
+                                     void *alloc_data)
+{
+  GtDlist *dlist;
+  gt_assert(alloc_func && free_func);
+  dlist = alloc_func(sizeof (GtDlist), alloc_data);
+  memset(dlist, 0, sizeof (GtDlist));
+  if (cmp_func)
+    dlist->cmp_func = gt_dlist_cmp_wrapper;
+  dlist->data = cmp_func;
+  dlist->alloc_func = alloc_func;
+  dlist->free_func = free_func;
+  dlist->alloc_data = alloc_data;
+  return dlist;
+}
+
+static GtDlistelem* dlist_elem_new(GtDlist *dlist)
+{
+  GtDlistelem *elem;
+  if (!dlist->alloc_func)
+    return gt_calloc(1, sizeof (GtDlistelem));
+  elem = dlist->alloc_func(sizeof (GtDlistelem), dlist->alloc_data);
+  memset(elem, 0, sizeof (GtDlistelem));
+  return elem;
+}
+
+static void dlist_elem_delete(GtDlist *dlist, GtDlistelem *elem)
+{
+  if (!elem) return;
+  if (dlist->free_func)
+    dlist->free_func(elem, sizeof (GtDlistelem), dlist->alloc_data);
+  else
+    gt_free(elem);
+}
+
 GtDlistelem* gt_dlist_first(const GtDlist *dlist)
 {
   gt_assert(dlist);
@@ -100,7 +141,7 @@ void gt_dlist_add(GtDlist *dlist, void *data)
 {
   GtDlistelem *oldelem, *newelem;
   gt_assert(dlist); /* data can be null */
-  newelem = gt_calloc(1, sizeof (GtDlistelem));
+  newelem = dlist_elem_new(dlist);
   newelem->data = data;
 
   if (!dlist->first) {
@@ -170,7 +211,7 @@ void gt_dlist_remove(GtDlist *dlist, GtDlistelem *dlistelem)
   if (dlistelem == dlist->last)
     dlist->last = dlistelem->previous;
   dlist->size--;
-  gt_free(dlistelem);
+  dlist_elem_delete(dlist, dlistelem);
 }
 
 static int intcompare(const void *a, const void *b)
@@ -203,6 +244,18 @@ int gt_dlist_example(GT_UNUSED GtError *err)
   return 0;
 }
 
+static void* dlist_test_alloc(size_t size, void *data)
+{
+  (*(GtUword*) data)++;
+  return gt_malloc(size);
+}
+
+static void dlist_test_free(void *ptr, GT_UNUSED size_t size, void *data)
+{
+  (*(GtUword*) data)--;
+  gt_free(ptr);
+}
+
 int gt_dlist_unit_test(GtError *err)
 {
   GtDlist *dlist;
@@ -213,6 +266,7 @@ int gt_dlist_unit_test(GtError *err)
       elems[MAX_SIZE],
       elems_backup[MAX_SIZE],
       had_err = 0;
+  GtUword nof_allocs = 0;
   gt_error_check(err);
 
   /* boundary case: empty dlist */
@@ -256,6 +310,20 @@ int gt_dlist_unit_test(GtError *err)
          elem_a == *(int*) gt_dlistelem_get_data(gt_dlist_first(dlist)));
   gt_dlist_delete(dlist);
 
+  /* a dlist with its own allocator gives all memory back to it */
+  dlist = gt_dlist_new_with_allocator(intcompare, dlist_test_alloc,
+                                      dlist_test_free, &nof_allocs);
+  gt_dlist_add(dlist, &elem_a);
+  gt_dlist_add(dlist, &elem_b);
+  gt_dlist_add(dlist, &elem_a);
+  gt_ensure(nof_allocs == 4);
+  gt_dlist_remove(dlist, gt_dlist_first(dlist));
+  gt_ensure(nof_allocs == 3 && gt_dlist_size(dlist) == 2);
+  gt_ensure(
+         elem_a == *(int*) gt_dlistelem_get_data(gt_dlist_first(dlist)));
+  gt_dlist_delete(dlist);
+  gt_ensure(!nof_allocs);
+
   for (i = 0; i < NUM_OF_TESTS && !had_err; i++) {
     /* construct the random elements for the list */
     size = gt_rand_max(MAX_SIZE);
@@ -368,11 +436,14 @@ void gt_dlist_delete(GtDlist *dlist)
   if (!dlist) return;
   elem = dlist->first;
   while (elem) {
-    gt_free(elem->previous);
+    dlist_elem_delete(dlist, elem->previous);
     elem = elem->next;
   }
-  gt_free(dlist->last);
-  gt_free(dlist);
+  dlist_elem_delete(dlist, dlist->last);
+  if (dlist->free_func)
+    dlist->free_func(dlist, sizeof (GtDlist), dlist->alloc_data);
+  else
+    gt_free(dlist);
 }
 
 GtDlistelem* gt_dlistelem_next(const GtDlistelem *dlistelem)
@@ -22,6 +22,18 @@
 
 #include "core/dlist_api.h"
 
+/* Allocates <size> bytes of memory for a <GtDlist>, using <data>. */
+typedef void* (*GtDlistAllocFunc)(size_t size, void *data);
+/* Frees the memory <ptr> of <size> bytes allocated by a <GtDlistAllocFunc>. */
+typedef void  (*GtDlistFreeFunc)(void *ptr, size_t size, void *data);
+
+/* Like <gt_dlist_new()>, but the list and its elements are allocated with
+   <alloc_func> and freed with <free_func>, both are called with
+   <alloc_data>. */
+GtDlist*      gt_dlist_new_with_allocator(GtCompare cmp_func,
+                                          GtDlistAllocFunc alloc_func,
+                                          GtDlistFreeFunc free_func,
+                                          void *alloc_data);
 int           gt_dlist_unit_test(GtError*);
 
 #endif
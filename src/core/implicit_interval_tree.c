@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/assert_api.h"
+#include "core/implicit_interval_tree.h"
+#include "core/minmax.h"
+
+/* subtrees of at most this height are scanned linearly */
+#define GT_IMPLICIT_INTERVAL_TREE_SCANHEIGHT  3
+#define GT_IMPLICIT_INTERVAL_TREE_MAXHEIGHT   64
+
+#define IIT_ENTRY(A, SIZE, I) \
+        ((GtImplicitIntervalTreeEntry*) ((char*) (A) + (I) * (SIZE)))
+#define IIT_CONST_ENTRY(A, SIZE, I) \
+        ((const GtImplicitIntervalTreeEntry*) \
+         ((const char*) (A) + (I) * (SIZE)))
+
+unsigned int gt_implicit_interval_tree_build(void *entries, GtUword n,
+                                             size_t entry_size)
+{
+  GtImplicitIntervalTreeEntry *e;
+  GtUword i, k, last_i = 0;
+  uint64_t last = 0;
+
+  if (n == 0)
+    return 0;
+  for (i = 0; i < n; i += 2) {
+    e = IIT_ENTRY(entries, entry_size, i);
+    last_i = i;
+    last = e->maxend = e->end;
+  }
+  /* compute the max values bottom-up, level by level; <last> keeps the max
+     value of the rightmost subtree, whose root may lie beyond the array */
+  for (k = 1; (GtUword) 1 << k <= n; k++) {
+    GtUword x = (GtUword) 1 << (k - 1), i0 = (x << 1) - 1, step = x << 2;
+    for (i = i0; i < n; i += step) {
+      uint64_t el = IIT_ENTRY(entries, entry_size, i - x)->maxend,
+               er = i + x < n ? IIT_ENTRY(entries, entry_size, i + x)->maxend
+                              : last;
+      e = IIT_ENTRY(entries, entry_size, i);
+      e->maxend = MAX(e->end, el);
+      e->maxend = MAX(e->maxend, er);
+    }
+    /* move <last_i> to its parent, which has height k */
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+    if (last_i < n && IIT_ENTRY(entries, entry_size, last_i)->maxend > last)
+      last = IIT_ENTRY(entries, entry_size, last_i)->maxend;
+  }
+  gt_assert(k - 1 < GT_IMPLICIT_INTERVAL_TREE_MAXHEIGHT);
+  return (unsigned int) (k - 1);
+}
+
+void gt_implicit_interval_tree_find(const void *entries, GtUword n,
+                                    size_t entry_size, unsigned int height,
+                                    uint64_t start, uint64_t end,
+                                    GtImplicitIntervalTreeFunc func,
+                                    void *data)
+{
+  struct {
+    GtUword x;
+    unsigned int height;
+    bool right;
+  } stack[GT_IMPLICIT_INTERVAL_TREE_MAXHEIGHT], z;
+  const GtImplicitIntervalTreeEntry *e;
+  GtUword i, i0, i1;
+  unsigned int sp = 0;
+  gt_assert(func);
+
+  if (n == 0)
+    return;
+  stack[sp].x = ((GtUword) 1 << height) - 1;
+  stack[sp].height = height;
+  stack[sp++].right = false;
+  while (sp > 0) {
+    z = stack[--sp];
+    if (z.height <= GT_IMPLICIT_INTERVAL_TREE_SCANHEIGHT) {
+      /* small subtree: scan its entries from left to right */
+      i0 = z.x >> z.height << z.height;
+      i1 = MIN(i0 + ((GtUword) 1 << (z.height + 1)) - 1, n);
+      for (i = i0; i < i1; i++) {
+        e = IIT_CONST_ENTRY(entries, entry_size, i);
+        if (e->start > end)
+          break;
+        if (start <= e->end && func(i, data))
+          return;
+      }
+    }
+    else if (!z.right) {
+      /* descend into the left subtree first, revisit the entry afterwards */
+      i = z.x - ((GtUword) 1 << (z.height - 1));
+      stack[sp].x = z.x;
+      stack[sp].height = z.height;
+      stack[sp++].right = true;
+      if (i >= n ||
+          IIT_CONST_ENTRY(entries, entry_size, i)->maxend >= start) {
+        stack[sp].x = i;
+        stack[sp].height = z.height - 1;
+        stack[sp++].right = false;
+      }
+    }
+    else if (z.x < n &&
+             (e = IIT_CONST_ENTRY(entries, entry_size, z.x))->start <= end) {
+      if (start <= e->end && func(z.x, data))
+        return;
+      stack[sp].x = z.x + ((GtUword) 1 << (z.height - 1));
+      stack[sp].height = z.height - 1;
+      stack[sp++].right = false;
+    }
+  }
+}
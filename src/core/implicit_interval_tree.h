@@ -0,0 +1,56 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef IMPLICIT_INTERVAL_TREE_H
+#define IMPLICIT_INTERVAL_TREE_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "core/types_api.h"
+
+/* An implicit augmented interval tree is an array of intervals sorted by
+   their start positions: the entry at index i has height k if the k lowest
+   bits of i are set and bit k is not, its children are at i - 2^(k-1) and
+   i + 2^(k-1), and its <maxend> is the largest end position in its subtree.
+   The entries of such an array may be of any type, as long as it begins with
+   a <GtImplicitIntervalTreeEntry>. */
+typedef struct {
+  uint64_t start, end, maxend;
+} GtImplicitIntervalTreeEntry;
+
+/* Called for the entry <idx> of an implicit interval tree. Returning true
+   stops the search. */
+typedef bool (*GtImplicitIntervalTreeFunc)(GtUword idx, void *data);
+
+/* Computes the <maxend> fields of the <n> sorted entries of size
+   <entry_size> in <entries> and returns the height of the root. */
+unsigned int gt_implicit_interval_tree_build(void *entries, GtUword n,
+                                             size_t entry_size);
+
+/* Calls <func> with <data> for the index of each of the <n> entries of size
+   <entry_size> in <entries> which overlap [<start>,<end>], in ascending
+   order. <height> is the value returned by
+   <gt_implicit_interval_tree_build()>. Only the entries on the search paths
+   are touched. */
+void         gt_implicit_interval_tree_find(const void *entries, GtUword n,
+                                            size_t entry_size,
+                                            unsigned int height,
+                                            uint64_t start, uint64_t end,
+                                            GtImplicitIntervalTreeFunc func,
+                                            void *data);
+
+#endif
@@ -18,6 +18,7 @@
 #include <limits.h>
 #include <string.h>
 #include "core/ensure.h"
+#include "core/implicit_interval_tree.h"
 #include "core/interval_tree.h"
 #include "core/ma.h"
 #include "core/mathsupport.h"
@@ -38,10 +39,19 @@ struct GtIntervalTreeNode {
   GtUword low, high, max;
 };
 
+/* Entry of the static index of a frozen tree, see
+   core/implicit_interval_tree.h for its layout. */
+typedef struct {
+  GtImplicitIntervalTreeEntry iv;
+  GtIntervalTreeNode *node;
+} GtIntervalTreeStaticEntry;
+
 struct GtIntervalTree {
   GtIntervalTreeNode *root, sentinel, *nil;
   GtUword size;
   GtFree free_func;
+  GtIntervalTreeStaticEntry *frozen;
+  unsigned int frozen_height;
 };
 
 GtIntervalTreeNode* gt_interval_tree_node_new(void *data,
@@ -113,6 +123,86 @@ static GtIntervalTreeNode* interval_tree_search_internal(GtIntervalTree *it,
   return (x == it->nil) ? NULL : x;
 }
 
+static void interval_tree_collect_in_order(GtIntervalTree *it,
+                                           GtIntervalTreeNode *node,
+                                           GtIntervalTreeStaticEntry *a,
+                                           GtUword *n)
+{
+  while (node != it->nil) {
+    interval_tree_collect_in_order(it, node->left, a, n);
+    a[*n].iv.start = (uint64_t) node->low;
+    a[*n].iv.end = (uint64_t) node->high;
+    a[*n].node = node;
+    (*n)++;
+    node = node->right;
+  }
+}
+
+void gt_interval_tree_freeze(GtIntervalTree *it)
+{
+  GtIntervalTreeStaticEntry *a;
+  GtUword n = 0;
+  gt_assert(it);
+
+  if (it->frozen || it->size == 0)
+    return;
+  /* the in-order traversal yields the intervals sorted by their low values */
+  a = gt_malloc(sizeof (*a) * it->size);
+  interval_tree_collect_in_order(it, it->root, a, &n);
+  gt_assert(n == it->size);
+  it->frozen_height = gt_implicit_interval_tree_build(a, n, sizeof (*a));
+  /* the index is only used once it is complete */
+  it->frozen = a;
+}
+
+static void interval_tree_thaw(GtIntervalTree *it)
+{
+  gt_free(it->frozen);
+  it->frozen = NULL;
+}
+
+typedef struct {
+  const GtIntervalTreeStaticEntry *entries;
+  GtIntervalTreeIteratorFunc func;
+  void *data;
+  GtIntervalTreeNode *first;
+} GtIntervalTreeStaticFindInfo;
+
+static bool interval_tree_static_visit(GtUword idx, void *data)
+{
+  GtIntervalTreeStaticFindInfo *info = data;
+
+  if (!info->func) {
+    info->first = info->entries[idx].node;
+    return true;
+  }
+  (void) info->func(info->entries[idx].node, info->data);
+  return false;
+}
+
+/* Calls <func> for all entries of the static index overlapping [low,high] in
+   ascending order of their low values. If <func> is NULL, the search stops at
+   the first overlapping entry, whose node is returned. */
+static GtIntervalTreeNode* interval_tree_static_find(GtIntervalTree *it,
+                                                     GtUword low,
+                                                     GtUword high,
+                                                     GtIntervalTreeIteratorFunc
+                                                                          func,
+                                                     void *data)
+{
+  GtIntervalTreeStaticFindInfo info;
+
+  info.entries = it->frozen;
+  info.func = func;
+  info.data = data;
+  info.first = NULL;
+  gt_implicit_interval_tree_find(it->frozen, it->size, sizeof (*it->frozen),
+                                 it->frozen_height, (uint64_t) low,
+                                 (uint64_t) high, interval_tree_static_visit,
+                                 &info);
+  return info.first;
+}
+
 GtIntervalTreeNode* gt_interval_tree_find_first_overlapping(GtIntervalTree *it,
                                                             GtUword low,
                                                             GtUword high)
@@ -120,6 +210,8 @@ GtIntervalTreeNode* gt_interval_tree_find_first_overlapping(GtIntervalTree *it,
   gt_assert(it);
   if (it->root == it->nil)
     return NULL;
+  if (it->frozen)
+    return interval_tree_static_find(it, low, high, NULL, NULL);
   return interval_tree_search_internal(it, it->root, low, high);
 }
 
@@ -164,12 +256,14 @@ static void interval_tree_find_all_internal(GtIntervalTree *it,
   GtIntervalTreeNode* x;
   if (node == it->nil) return;
   x = node;
-  if (low <= x->high && x->low <= high)
-    func(node, data);
-  /* recursively search left and right subtrees */
+  /* search in order, as the static index of a frozen tree does, so that both
+     report the overlapping intervals in the same order; all intervals in the
+     right subtree start at or after <x->low> */
   if (x->left != it->nil && low <= x->left->max)
     interval_tree_find_all_internal(it, x->left, func, low, high, data);
-  if (x->right != it->nil && low <= x->right->max)
+  if (low <= x->high && x->low <= high)
+    func(node, data);
+  if (x->right != it->nil && low <= x->right->max && x->low <= high)
     interval_tree_find_all_internal(it, x->right, func, low, high, data);
 }
 
@@ -179,6 +273,11 @@ void gt_interval_tree_find_all_overlapping(GtIntervalTree *it,
 {
   gt_assert(it && a && start <= end);
   if (it->root == it->nil) return;
+  if (it->frozen) {
+    (void) interval_tree_static_find(it, start, end,
+                                     store_interval_node_in_array, a);
+    return;
+  }
   interval_tree_find_all_internal(it, it->root, store_interval_node_in_array,
                                   start, end, a);
 }
@@ -190,6 +289,10 @@ void gt_interval_tree_iterate_overlapping(GtIntervalTree *it,
                                           void *data)
 {
   gt_assert(it && func && start <= end);
+  if (it->frozen) {
+    (void) interval_tree_static_find(it, start, end, func, data);
+    return;
+  }
   interval_tree_find_all_internal(it, it->root, func, start, end, data);
 }
 
@@ -367,6 +470,7 @@ static void interval_tree_insert_internal(GtIntervalTree *it,
 void gt_interval_tree_insert(GtIntervalTree *it, GtIntervalTreeNode *n)
 {
   gt_assert(it && n);
+  interval_tree_thaw(it);
   n->parent = it->nil;
   n->left = it->nil;
   n->right = it->nil;
@@ -380,6 +484,7 @@ void gt_interval_tree_insert(GtIntervalTree *it, GtIntervalTreeNode *n)
 void gt_interval_tree_delete(GtIntervalTree *it)
 {
   if (!it) return;
+  interval_tree_thaw(it);
   interval_tree_node_rec_delete(it, it->root);
   gt_free(it);
 }
@@ -467,6 +572,7 @@ void gt_interval_tree_remove(GtIntervalTree *it, GtIntervalTreeNode *z)
 {
   GtIntervalTreeNode *y, *x;
   gt_assert(it && it->size > 0);
+  interval_tree_thaw(it);
   y = (z->left == it->nil || z->right == it->nil)
     ? z
     : gt_interval_tree_get_successor(it, z);
@@ -644,6 +750,67 @@ int gt_interval_tree_unit_test(GT_UNUSED GtError *err)
     }
     gt_array_delete(res);
   }
+
+  /* the static index of a frozen tree must give the same results in the same
+     order as the tree itself, ordered by start position */
+  gt_interval_tree_freeze(it);
+  for (i = 0; i < num_find_all_samples && !had_err; i++)
+  {
+    GtArray *hits, *ref, *dyn;
+    GtUword j, start = gt_rand_max(gt_range_max_basepos);
+    qrange.start = start;
+    qrange.end = start + gt_rand_max(query_width);
+    hits = gt_array_new(sizeof (GtRange*));
+    ref = gt_array_new(sizeof (GtRange*));
+    dyn = gt_array_new(sizeof (GtRange*));
+    gt_interval_tree_find_all_overlapping(it, qrange.start, qrange.end, hits);
+    interval_tree_find_all_internal(it, it->root, store_interval_node_in_array,
+                                    qrange.start, qrange.end, dyn);
+    gt_ensure(gt_array_size(dyn) == gt_array_size(hits));
+    if (!had_err)
+      gt_ensure(gt_array_cmp(dyn, hits) == 0);
+    gt_array_delete(dyn);
+    for (j = 0; j < gt_array_size(arr); j++)
+    {
+      GtRange *this_rng = *(GtRange**) gt_array_get(arr, j);
+      if (gt_range_overlap(this_rng, &qrange))
+        gt_array_add(ref, this_rng);
+    }
+    for (j = 1; !had_err && j < gt_array_size(hits); j++)
+    {
+      gt_ensure((*(GtRange**) gt_array_get(hits, j - 1))->start <=
+                (*(GtRange**) gt_array_get(hits, j))->start);
+    }
+    res = gt_interval_tree_find_first_overlapping(it, qrange.start,
+                                                  qrange.end);
+    if (!had_err && gt_array_size(hits) == 0)
+      gt_ensure(res == NULL);
+    else if (!had_err)
+    {
+      gt_ensure(res != NULL && gt_interval_tree_node_get_data(res)
+                                 == *(GtRange**) gt_array_get(hits, 0));
+    }
+    gt_array_sort_stable(ref, range_ptr_compare);
+    gt_array_sort_stable(hits, range_ptr_compare);
+    if (!had_err)
+      gt_ensure(gt_array_size(ref) == gt_array_size(hits));
+    if (!had_err)
+      gt_ensure(gt_array_cmp(ref, hits) == 0);
+    gt_array_delete(ref);
+    gt_array_delete(hits);
+  }
+
+  /* inserting into a frozen tree discards the static index */
+  if (!had_err)
+  {
+    GtRange *rng = gt_calloc(1, sizeof (GtRange));
+    rng->start = (GtUword) gt_range_max_basepos + 2 * width;
+    rng->end = rng->start + 1;
+    gt_interval_tree_insert(it, gt_interval_tree_node_new(rng, rng->start,
+                                                          rng->end));
+    res = gt_interval_tree_find_first_overlapping(it, rng->end, rng->end);
+    gt_ensure(res != NULL && gt_interval_tree_node_get_data(res) == rng);
+  }
   gt_interval_tree_delete(it);
 
   it = gt_interval_tree_new(NULL);
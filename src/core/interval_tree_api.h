@@ -73,6 +73,19 @@ void                gt_interval_tree_iterate_overlapping(GtIntervalTree *it,
                                                 GtUword end,
                                                 void *data);
 
+/* Freezes <tree>: builds a static index of its intervals, stored in a single
+   array sorted by start position, which is used by all subsequent calls of
+   <gt_interval_tree_find_first_overlapping()>,
+   <gt_interval_tree_find_all_overlapping()> and
+   <gt_interval_tree_iterate_overlapping()>. Like the tree itself, these
+   report the overlapping intervals in ascending order of their start
+   positions, with the same order for equal start positions. Inserting or
+   removing a node discards the static index again. Freezing pays off for
+   large trees which are queried often but rarely changed. A frozen <tree> can
+   be queried concurrently, but the freezing itself must not overlap with
+   queries or other modifications of <tree>. */
+void                gt_interval_tree_freeze(GtIntervalTree *tree);
+
 /* Traverses the <GtIntervalTree> in a depth-first fashion, applying <func> to
    each node encountered. The <data> pointer can be used to reference arbitrary
    data needed in the <GtIntervalTreeIteratorFunc>. */
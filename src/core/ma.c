@@ -19,6 +19,7 @@
 #include <string.h>
 #include "core/array_api.h"
 #include "core/compat.h"
+#include "core/ensure.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/multithread_api.h"
@@ -28,18 +29,37 @@
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
-/* the memory allocator class */
+/* Number of shards the bookkeeping of allocated pointers is distributed
+   over. Every shard has its own lock, so concurrent allocations only contend
+   if their pointers map to the same shard. Must be a power of two. */
+#define MA_NUM_OF_SHARDS  64
+
+/* The current size and the peak are global, they are updated with atomic
+   operations if the compiler supports them and under <size_lock>
+   otherwise. */
+#if defined(GT_THREADS_ENABLED) && defined(__GNUC__)
+#define MA_ATOMIC_SIZE
+#endif
+
 typedef struct {
   GtHashmap *allocated_pointer;
+  GtMutex *lock;
+  GtUint64 mallocevents;
+} MAShard;
+
+/* the memory allocator class */
+typedef struct {
+  MAShard shards[MA_NUM_OF_SHARDS];
   bool bookkeeping,
        global_space_peak;
-  GtUint64 mallocevents;
   GtUword current_size,
-                max_size;
+          max_size;
 } MA;
 
 static MA *ma = NULL;
-static GtMutex *bookkeeping_lock = NULL;
+#ifndef MA_ATOMIC_SIZE
+static GtMutex *size_lock = NULL;
+#endif
 
 typedef struct {
   size_t size;
@@ -103,52 +123,132 @@ static void ma_info_free(MAInfo *mainfo)
 
 void gt_ma_init(bool bookkeeping)
 {
+  GtUword i;
   gt_assert(!ma);
   ma = xcalloc(1, sizeof (MA), 0, __FILE__, __LINE__);
   gt_assert(!ma->bookkeeping);
-  ma->allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL,
-                                               (GtFree) ma_info_free);
+  for (i = 0; i < MA_NUM_OF_SHARDS; i++) {
+    ma->shards[i].allocated_pointer =
+      gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL, (GtFree) ma_info_free);
+    ma->shards[i].lock = gt_mutex_new();
+  }
+#ifndef MA_ATOMIC_SIZE
+  size_lock = gt_mutex_new();
+#endif
   /* MA is ready to use */
   ma->bookkeeping = bookkeeping;
-  bookkeeping_lock = gt_mutex_new();
   ma->global_space_peak = false;
 }
 
+/* Returns the shard responsible for <ptr>. The lower bits of pointers
+   returned by malloc(3) are mostly zero due to alignment, so they are mixed
+   with higher bits. */
+static MAShard* ma_shard(MA *ma, const void *ptr)
+{
+  GtUword key = (GtUword) ptr;
+  key ^= (key >> 4) ^ (key >> 10) ^ (key >> 16);
+  return ma->shards + (key & (MA_NUM_OF_SHARDS - 1));
+}
+
 static void add_size(MA* ma, GtUword size)
 {
+  GtUword current_size;
+#ifdef MA_ATOMIC_SIZE
+  GtUword max_size;
+#endif
   gt_assert(ma);
-  ma->current_size += size;
+#ifdef MA_ATOMIC_SIZE
+  current_size = __sync_add_and_fetch(&ma->current_size, size);
+  max_size = ma->max_size;
+  while (current_size > max_size) {
+    GtUword old = __sync_val_compare_and_swap(&ma->max_size, max_size,
+                                              current_size);
+    if (old == max_size)
+      break;
+    max_size = old;
+  }
+#else
+  gt_mutex_lock(size_lock);
+  current_size = ma->current_size += size;
+  if (current_size > ma->max_size)
+    ma->max_size = current_size;
+  gt_mutex_unlock(size_lock);
+#endif
   if (ma->global_space_peak)
     gt_spacepeak_add(size);
-  if (ma->current_size > ma->max_size)
-    ma->max_size = ma->current_size;
 }
 
 static void subtract_size(MA *ma, GtUword size)
 {
+  GT_UNUSED GtUword old_size;
   gt_assert(ma);
-  gt_assert(ma->current_size >= size);
+#ifdef MA_ATOMIC_SIZE
+  old_size = __sync_fetch_and_sub(&ma->current_size, size);
+#else
+  gt_mutex_lock(size_lock);
+  old_size = ma->current_size;
   ma->current_size -= size;
+  gt_mutex_unlock(size_lock);
+#endif
+  gt_assert(old_size >= size);
   if (ma->global_space_peak)
     gt_spacepeak_free(size);
 }
 
+static MAInfo* ma_info_new(size_t size, const char *src_file, int src_line)
+{
+  MAInfo *mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file,
+                           src_line);
+  mainfo->size = size;
+  mainfo->src_file = src_file;
+  mainfo->src_line = src_line;
+  return mainfo;
+}
+
+/* Records the newly allocated block <mem> described by <mainfo>. */
+static void ma_track(MA *ma, void *mem, MAInfo *mainfo)
+{
+  MAShard *shard = ma_shard(ma, mem);
+  gt_mutex_lock(shard->lock);
+  shard->mallocevents++;
+  gt_hashmap_add(shard->allocated_pointer, mem, mainfo);
+  gt_mutex_unlock(shard->lock);
+  add_size(ma, mainfo->size);
+}
+
+/* Stops tracking <ptr> before it is passed to free(3) or realloc(3), so that
+   no other thread can obtain the same address while it is still recorded. */
+static void ma_untrack(MA *ma, void *ptr, GT_UNUSED const char *src_file,
+                       GT_UNUSED int src_line)
+{
+  MAShard *shard = ma_shard(ma, ptr);
+  MAInfo *mainfo;
+  size_t size;
+  gt_mutex_lock(shard->lock);
+  mainfo = gt_hashmap_get(shard->allocated_pointer, ptr);
+#ifndef NDEBUG
+  if (!mainfo) {
+    fprintf(stderr, "bug: double free() attempted on line %d in file "
+            "\"%s\"\n", src_line, src_file);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+#endif
+  gt_assert(mainfo);
+  size = mainfo->size;
+  gt_hashmap_remove(shard->allocated_pointer, ptr);
+  gt_mutex_unlock(shard->lock);
+  subtract_size(ma, size);
+}
+
 void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
 {
   MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
+    mainfo = ma_info_new(size, src_file, src_line);
     mem = xmalloc(size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    ma_track(ma, mem, mainfo);
     return mem;
   }
   return xmalloc(size, ma->current_size, src_file, src_line);
@@ -161,16 +261,9 @@ void* gt_calloc_mem(size_t nmemb, size_t size, const char *src_file,
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = nmemb * size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
+    mainfo = ma_info_new(nmemb * size, src_file, src_line);
     mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, nmemb * size);
-    gt_mutex_unlock(bookkeeping_lock);
+    ma_track(ma, mem, mainfo);
     return mem;
   }
   return xcalloc(nmemb, size, ma->current_size, src_file, src_line);
@@ -182,22 +275,11 @@ void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    if (ptr) {
-      mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-      gt_assert(mainfo);
-      subtract_size(ma, mainfo->size);
-      gt_hashmap_remove(ma->allocated_pointer, ptr);
-    }
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
+    if (ptr)
+      ma_untrack(ma, ptr, src_file, src_line);
+    mainfo = ma_info_new(size, src_file, src_line);
     mem = xrealloc(ptr, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    ma_track(ma, mem, mainfo);
     return mem;
   }
   return xrealloc(ptr, size, ma->current_size, src_file, src_line);
@@ -206,28 +288,11 @@ void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
 void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
                  GT_UNUSED int src_line)
 {
-  MAInfo *mainfo;
   gt_assert(ma);
   if (ptr == NULL) return;
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-#ifndef NDEBUG
-    if (!gt_hashmap_get(ma->allocated_pointer, ptr)) {
-      fprintf(stderr, "bug: double free() attempted on line %d in file "
-              "\"%s\"\n", src_line, src_file);
-      exit(GT_EXIT_PROGRAMMING_ERROR);
-    }
-#endif
-    mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-    gt_assert(mainfo);
-    subtract_size(ma, mainfo->size);
-    gt_hashmap_remove(ma->allocated_pointer, ptr);
-    free(ptr);
-    gt_mutex_unlock(bookkeeping_lock);
-  }
-  else {
-    free(ptr);
-  }
+  if (ma->bookkeeping)
+    ma_untrack(ma, ptr, src_file, src_line);
+  free(ptr);
 }
 
 void gt_free_func(void *ptr)
@@ -278,23 +343,33 @@ GtUword gt_ma_get_space_current(void)
 
 void gt_ma_show_space_peak(FILE *fp)
 {
+  GtUint64 mallocevents = 0;
+  GtUword i;
   gt_assert(ma);
+  for (i = 0; i < MA_NUM_OF_SHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    mallocevents += ma->shards[i].mallocevents;
+    gt_mutex_unlock(ma->shards[i].lock);
+  }
   fprintf(fp, "# space peak in megabytes: %.2f (in "GT_LLU" events)\n",
           GT_MEGABYTES(ma->max_size),
-          ma->mallocevents);
+          mallocevents);
 }
 
 int gt_ma_check_space_leak(void)
 {
   CheckSpaceLeakInfo info;
   GT_UNUSED int had_err;
+  GtUword i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   info.has_leak = false;
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, check_space_leak, &info,
-                               NULL);
-  gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
-  gt_mutex_unlock(bookkeeping_lock);
+  for (i = 0; i < MA_NUM_OF_SHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 check_space_leak, &info, NULL);
+    gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
+    gt_mutex_unlock(ma->shards[i].lock);
+  }
   if (info.has_leak)
     return -1;
   return 0;
@@ -321,22 +396,30 @@ static int print_allocation(GT_UNUSED void *key, void *value,
 void gt_ma_show_allocations(FILE *outfp)
 {
   GT_UNUSED int had_err;
+  GtUword i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, print_allocation,
-                               outfp, NULL);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  for (i = 0; i < MA_NUM_OF_SHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 print_allocation, outfp, NULL);
+    gt_mutex_unlock(ma->shards[i].lock);
+    gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  }
 }
 
 void gt_ma_clean(void)
 {
+  GtUword i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   ma->bookkeeping = false;
-  gt_hashmap_delete(ma->allocated_pointer);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_mutex_delete(bookkeeping_lock);
+  for (i = 0; i < MA_NUM_OF_SHARDS; i++) {
+    gt_hashmap_delete(ma->shards[i].allocated_pointer);
+    gt_mutex_delete(ma->shards[i].lock);
+  }
+#ifndef MA_ATOMIC_SIZE
+  gt_mutex_delete(size_lock);
+  size_lock = NULL;
+#endif
   free(ma);
   ma = NULL;
 }
@@ -401,12 +484,20 @@ static void* test_realloc(GT_UNUSED void *data)
 
 int gt_ma_unit_test(GtError *err)
 {
+  GtUword space_current;
   int had_err;
   gt_error_check(err);
+  space_current = gt_ma_get_space_current();
   had_err = gt_multithread(test_malloc, NULL, err);
   if (!had_err)
     had_err = gt_multithread(test_calloc, NULL, err);
   if (!had_err)
     had_err = gt_multithread(test_realloc, NULL, err);
+  /* the allocations of all threads must be balanced in the counters */
+  gt_ensure(gt_ma_get_space_current() == space_current);
+  if (!had_err && gt_ma_bookkeeping_enabled()) {
+    gt_ensure(gt_ma_get_space_peak() >=
+              space_current + NUMBER_OF_ALLOCS * SIZE_OF_ALLOCS);
+  }
   return had_err;
 }
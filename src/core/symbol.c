@@ -16,41 +16,181 @@
 */
 
 #include <string.h>
-#include "core/cstr_table.h"
+#include "core/array_api.h"
+#include "core/ensure.h"
+#include "core/hashtable.h"
+#include "core/ma_api.h"
 #include "core/mathsupport.h"
 #include "core/multithread_api.h"
+#include "core/str_api.h"
 #include "core/symbol.h"
 #include "core/unused_api.h"
 
-static GtCstrTable *symbols = NULL;
-static GtMutex *symbol_mutex = NULL;
+/* The symbols are distributed over independently locked stripes, each an open
+   addressing hash table of pointers into an append-only string store. Slots
+   are written only once and symbols never move, so if the compiler provides
+   memory barriers, lookups of existing symbols do not take any lock: a new
+   string or table is completely written before it becomes visible. Replaced
+   tables are kept until <gt_symbol_clean()>, because readers may still
+   probe them. */
+#define SYMBOL_NUM_OF_STRIPES  64U  /* must be a power of two */
+#define SYMBOL_INITIAL_SLOTS   64U  /* must be a power of two */
+#define SYMBOL_CHUNK_SIZE      4096U
+
+#if defined(GT_THREADS_ENABLED) && defined(__GNUC__)
+#define SYMBOL_LOCKFREE_LOOKUP
+#define SYMBOL_PUBLISH_BARRIER() __sync_synchronize()
+#else
+#define SYMBOL_PUBLISH_BARRIER()
+#endif
+
+typedef struct {
+  GtUword mask;
+  const char * volatile *slots;
+} SymbolTable;
+
+typedef struct {
+  SymbolTable * volatile table;
+  GtArray *retired_tables,
+          *chunks;
+  char *chunk;
+  GtUword chunk_left,
+          num_of_symbols;
+  GtMutex *mutex;
+} SymbolStripe;
+
+static SymbolStripe *stripes = NULL;
+
+static SymbolTable* symbol_table_new(GtUword num_of_slots)
+{
+  SymbolTable *table;
+  table = gt_calloc(1, sizeof *table + num_of_slots * sizeof (char*));
+  table->mask = num_of_slots - 1;
+  table->slots = (const char * volatile *) (table + 1);
+  return table;
+}
 
 void gt_symbol_init(void)
 {
-  if (!symbols)
-    symbols = gt_cstr_table_new();
-  if (!symbol_mutex)
-    symbol_mutex = gt_mutex_new();
+  unsigned int i;
+  if (stripes)
+    return;
+  stripes = gt_calloc(SYMBOL_NUM_OF_STRIPES, sizeof *stripes);
+  for (i = 0; i < SYMBOL_NUM_OF_STRIPES; i++) {
+    stripes[i].table = symbol_table_new(SYMBOL_INITIAL_SLOTS);
+    stripes[i].retired_tables = gt_array_new(sizeof (SymbolTable*));
+    stripes[i].chunks = gt_array_new(sizeof (char*));
+    stripes[i].mutex = gt_mutex_new();
+  }
+}
+
+static const char* symbol_table_get(const SymbolTable *table,
+                                    const char *cstr, uint32_t hash)
+{
+  const char *symbol;
+  GtUword slot = (GtUword) (hash / SYMBOL_NUM_OF_STRIPES) & table->mask;
+  while ((symbol = table->slots[slot]) != NULL) {
+    if (symbol == cstr || !strcmp(symbol, cstr))
+      return symbol;
+    slot = (slot + 1) & table->mask;
+  }
+  return NULL;
+}
+
+static void symbol_table_insert(SymbolTable *table, const char *symbol,
+                                uint32_t hash)
+{
+  GtUword slot = (GtUword) (hash / SYMBOL_NUM_OF_STRIPES) & table->mask;
+  while (table->slots[slot] != NULL)
+    slot = (slot + 1) & table->mask;
+  table->slots[slot] = symbol;
+}
+
+/* Doubles the table of <stripe>, the old table stays readable. */
+static void symbol_stripe_grow(SymbolStripe *stripe)
+{
+  SymbolTable *old_table = stripe->table, *new_table;
+  const char *symbol;
+  GtUword slot;
+  new_table = symbol_table_new(2 * (old_table->mask + 1));
+  for (slot = 0; slot <= old_table->mask; slot++) {
+    if ((symbol = old_table->slots[slot]) != NULL) {
+      symbol_table_insert(new_table, symbol,
+                          gt_uint32_data_hash(symbol, strlen(symbol)));
+    }
+  }
+  SYMBOL_PUBLISH_BARRIER();
+  stripe->table = new_table;
+  gt_array_add(stripe->retired_tables, old_table);
+}
+
+static const char* symbol_stripe_add(SymbolStripe *stripe, const char *cstr,
+                                     size_t length, uint32_t hash)
+{
+  char *symbol;
+  if (2 * (stripe->num_of_symbols + 1) > stripe->table->mask + 1)
+    symbol_stripe_grow(stripe);
+  if (length + 1 > SYMBOL_CHUNK_SIZE) {
+    symbol = gt_malloc(length + 1);
+    gt_array_add(stripe->chunks, symbol);
+  }
+  else {
+    if (stripe->chunk_left < length + 1) {
+      stripe->chunk = gt_malloc(SYMBOL_CHUNK_SIZE);
+      stripe->chunk_left = SYMBOL_CHUNK_SIZE;
+      gt_array_add(stripe->chunks, stripe->chunk);
+    }
+    symbol = stripe->chunk;
+    stripe->chunk += length + 1;
+    stripe->chunk_left -= length + 1;
+  }
+  memcpy(symbol, cstr, length + 1);
+  SYMBOL_PUBLISH_BARRIER();
+  symbol_table_insert(stripe->table, symbol, hash);
+  stripe->num_of_symbols++;
+  return symbol;
 }
 
 const char* gt_symbol(const char *cstr)
 {
+  SymbolStripe *stripe;
   const char *symbol;
+  size_t length;
+  uint32_t hash;
   if (!cstr)
     return NULL;
-  gt_mutex_lock(symbol_mutex);
-  if (!(symbol = gt_cstr_table_get(symbols, cstr))) {
-    gt_cstr_table_add(symbols, cstr);
-    symbol = gt_cstr_table_get(symbols, cstr);
-  }
-  gt_mutex_unlock(symbol_mutex);
+  gt_assert(stripes);
+  length = strlen(cstr);
+  hash = gt_uint32_data_hash(cstr, length);
+  stripe = stripes + (hash & (SYMBOL_NUM_OF_STRIPES - 1));
+#ifdef SYMBOL_LOCKFREE_LOOKUP
+  if ((symbol = symbol_table_get(stripe->table, cstr, hash)) != NULL)
+    return symbol;
+#endif
+  gt_mutex_lock(stripe->mutex);
+  if (!(symbol = symbol_table_get(stripe->table, cstr, hash)))
+    symbol = symbol_stripe_add(stripe, cstr, length, hash);
+  gt_mutex_unlock(stripe->mutex);
   return symbol;
 }
 
 void gt_symbol_clean(void)
 {
-  gt_cstr_table_delete(symbols);
-  gt_mutex_delete(symbol_mutex);
+  GtUword i, j;
+  if (!stripes)
+    return;
+  for (i = 0; i < SYMBOL_NUM_OF_STRIPES; i++) {
+    for (j = 0; j < gt_array_size(stripes[i].retired_tables); j++)
+      gt_free(*(SymbolTable**) gt_array_get(stripes[i].retired_tables, j));
+    gt_array_delete(stripes[i].retired_tables);
+    for (j = 0; j < gt_array_size(stripes[i].chunks); j++)
+      gt_free(*(char**) gt_array_get(stripes[i].chunks, j));
+    gt_array_delete(stripes[i].chunks);
+    gt_free(stripes[i].table);
+    gt_mutex_delete(stripes[i].mutex);
+  }
+  gt_free(stripes);
+  stripes = NULL;
 }
 
 /* we use randomly generated numbers to test the symbol mechanism */
@@ -74,6 +214,24 @@ static void* test_symbol(GT_UNUSED void *data)
 
 int gt_symbol_unit_test(GtError *err)
 {
+  char long_cstr[2 * SYMBOL_CHUNK_SIZE], cstr[16];
+  const char *symbol;
+  int had_err;
   gt_error_check(err);
-  return gt_multithread(test_symbol, NULL, err);
+  had_err = gt_multithread(test_symbol, NULL, err);
+  if (!had_err) {
+    /* equal strings map to the same symbol */
+    (void) strcpy(cstr, "gene");
+    symbol = gt_symbol(cstr);
+    gt_ensure(symbol != cstr && !strcmp(symbol, "gene"));
+    gt_ensure(gt_symbol("gene") == symbol);
+    gt_ensure(gt_symbol("gene_") != symbol);
+    /* symbols larger than a chunk */
+    memset(long_cstr, 'a', sizeof long_cstr - 1);
+    long_cstr[sizeof long_cstr - 1] = '\0';
+    symbol = gt_symbol(long_cstr);
+    gt_ensure(!strcmp(symbol, long_cstr));
+    gt_ensure(gt_symbol(long_cstr) == symbol);
+  }
+  return had_err;
 }
@@ -174,6 +174,22 @@ void gt_timer_get_formatted(GtTimer *t, const char *fmt, GtStr *str)
 #endif
 }
 
+double gt_timer_get_elapsed_seconds(GtTimer *t)
+{
+#ifndef _WIN32
+  struct timeval elapsed_tv;
+  if (t->state == TIMER_RUNNING)
+    gt_timer_stop(t);
+  gt_assert(t->state == TIMER_STOPPED);
+  timeval_subtract(&elapsed_tv, &t->stop_tv, &t->gstart_tv);
+  return (double) elapsed_tv.tv_sec + (double) elapsed_tv.tv_usec / 1000000.0;
+#else
+  /* XXX */
+  fprintf(stderr, "gt_timer_get_elapsed_seconds() not implemented\n");
+  exit(EXIT_FAILURE);
+#endif
+}
+
 void gt_timer_show(GtTimer *t, FILE *fp)
 {
   gt_timer_show_formatted(t, GT_WD ".%06lds real " GT_WD "s user " GT_WD
@@ -26,11 +26,13 @@
 #include "core/hashmap-generic.h"
 #include "core/log_api.h"
 #include "core/ma.h"
+#include "core/minmax.h"
 #include "core/range.h"
 #include "core/strand_api.h"
 #include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
+#include "core/warning_api.h"
 #include "core/fa.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -49,6 +51,7 @@
 #include "extended/rdb_api.h"
 #include "extended/rdb_sqlite_api.h"
 #include "extended/rdb_visitor_rep.h"
+#include "extended/region_node_api.h"
 
 struct GtAnnoDBGFFlike {
   const GtAnnoDBSchema parent_instance;
@@ -61,6 +64,20 @@ typedef struct {
   GtAnnoDBGFFlike *annodb;
 } GFFlikeSetupVisitor;
 
+typedef struct {
+  const GtRDBVisitor parent_instance;
+  bool finish,
+       drop_indexes;
+} GFFlikeBulkVisitor;
+
+/* the tables filled in batches during a bulk load */
+typedef enum {
+  GFFLIKE_BULK_FEATURES,
+  GFFLIKE_BULK_ATTRIBUTES,
+  GFFLIKE_BULK_PARENTS,
+  GFFLIKE_BULK_NOF_TABLES
+} GFFlikeBulkTable;
+
 typedef struct {
   const GtFeatureIndex parent_instance;
   GtHashmap *node_to_parent_array,
@@ -78,10 +95,18 @@ typedef struct {
   GtRDB *db;
   GtMutex *dblock;
   bool transaction_lock;
+  /* bulk loading */
+  bool bulk;
+  GtArray *bulk_rows[GFFLIKE_BULK_NOF_TABLES],
+          *bulk_tree_nodes;
+  GtRDBStmt *bulk_stmts[GFFLIKE_BULK_NOF_TABLES];
+  GtHashmap *bulk_node2id;
+  GtUword bulk_next_id;
 } GtFeatureIndexGFFlike;
 
 const GtAnnoDBSchemaClass* gt_anno_db_gfflike_class(void);
 static const GtRDBVisitorClass* gfflike_setup_visitor_class(void);
+static const GtRDBVisitorClass* gfflike_bulk_visitor_class(void);
 static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 
 #define anno_db_gfflike_cast(V)\
@@ -90,6 +115,9 @@ static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 #define gfflike_setup_visitor_cast(V)\
         gt_rdb_visitor_cast(gfflike_setup_visitor_class(), V)
 
+#define gfflike_bulk_visitor_cast(V)\
+        gt_rdb_visitor_cast(gfflike_bulk_visitor_class(), V)
+
 #define feature_index_gfflike_cast(V)\
         gt_feature_index_cast(feature_index_gfflike_class(), V)
 
@@ -929,6 +957,579 @@ static int insert_feature_node(GtFeatureIndexGFFlike *fi,
   return had_err;
 }
 
+/* bulk loading: rows are collected in memory and written with multi-row
+   INSERT statements, the number of rows per statement keeps the number of
+   parameters below the default limit of SQLite (999) */
+#define GFFLIKE_BULK_FEATURE_ROWS    64
+#define GFFLIKE_BULK_ATTRIBUTE_ROWS  256
+#define GFFLIKE_BULK_PARENT_ROWS     256
+
+typedef struct {
+  GtUword id,
+          start,
+          end,
+          multi_rep;
+  double score;
+  int seqid,
+      source,
+      type,
+      strand,
+      phase,
+      multi,
+      pseudo,
+      marked;
+} GFFlikeBulkFeature;
+
+typedef struct {
+  GtUword feature_id;
+  char *key,
+       *value;
+} GFFlikeBulkAttribute;
+
+typedef struct {
+  GtUword feature_id,
+          parent;
+} GFFlikeBulkParent;
+
+typedef int (*GFFlikeBulkBindFunc)(GtRDBStmt *stmt, GtUword param_no,
+                                   const void *row, GtError *err);
+
+typedef struct {
+  const char *insert;
+  GtUword nof_columns,
+          rows_per_stmt;
+  size_t row_size;
+  GFFlikeBulkBindFunc bind;
+  bool has_strings;
+} GFFlikeBulkTableInfo;
+
+static int gfflike_bulk_bind_feature(GtRDBStmt *stmt, GtUword param_no,
+                                     const void *row, GtError *err)
+{
+  const GFFlikeBulkFeature *f = row;
+  int had_err;
+
+  had_err = gt_rdb_stmt_bind_ulong(stmt, param_no, f->id, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 1, f->seqid, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 2, f->source, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 3, f->type, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_ulong(stmt, param_no + 4, f->start, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_ulong(stmt, param_no + 5, f->end, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_double(stmt, param_no + 6, f->score, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 7, f->strand, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 8, f->phase, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 9, f->multi, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_ulong(stmt, param_no + 10, f->multi_rep, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 11, f->pseudo, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_int(stmt, param_no + 12, f->marked, err);
+  return had_err;
+}
+
+static int gfflike_bulk_bind_attribute(GtRDBStmt *stmt, GtUword param_no,
+                                       const void *row, GtError *err)
+{
+  const GFFlikeBulkAttribute *a = row;
+  int had_err;
+
+  had_err = gt_rdb_stmt_bind_ulong(stmt, param_no, a->feature_id, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_string(stmt, param_no + 1, a->key, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_string(stmt, param_no + 2, a->value, err);
+  return had_err;
+}
+
+static int gfflike_bulk_bind_parent(GtRDBStmt *stmt, GtUword param_no,
+                                    const void *row, GtError *err)
+{
+  const GFFlikeBulkParent *p = row;
+  int had_err;
+
+  had_err = gt_rdb_stmt_bind_ulong(stmt, param_no, p->feature_id, err);
+  if (!had_err)
+    had_err = gt_rdb_stmt_bind_ulong(stmt, param_no + 1, p->parent, err);
+  return had_err;
+}
+
+static const GFFlikeBulkTableInfo gfflike_bulk_tables[] = {
+  { "INSERT INTO features "
+    "(id, seqid, source, type, start, end, score, strand, phase, is_multi, "
+    "multi_representative, is_pseudo, is_marked) VALUES ",
+    13, GFFLIKE_BULK_FEATURE_ROWS, sizeof (GFFlikeBulkFeature),
+    gfflike_bulk_bind_feature, false },
+  { "INSERT INTO attributes (feature_id, keystr, value) VALUES ",
+    3, GFFLIKE_BULK_ATTRIBUTE_ROWS, sizeof (GFFlikeBulkAttribute),
+    gfflike_bulk_bind_attribute, true },
+  { "INSERT INTO parents (feature_id, parent) VALUES ",
+    2, GFFLIKE_BULK_PARENT_ROWS, sizeof (GFFlikeBulkParent),
+    gfflike_bulk_bind_parent, false }
+};
+
+/* indexes on the tables filled during a bulk load, these are dropped before
+   loading into an empty database and created again afterwards */
+static const char *gfflike_bulk_indexes[][2] = {
+  { "feature_all", "features" },
+  { "feature_seqid", "features" },
+  { "attribs_value", "attributes" },
+  { "attribs_key", "attributes" },
+  { "attribs_feature", "attributes" },
+  { "parent_id", "parents" }
+};
+
+static int gfflike_exec_query(GtRDB *db, const char *query, GtError *err)
+{
+  GtRDBStmt *stmt;
+  int had_err = 0;
+
+  if (!(stmt = gt_rdb_prepare(db, query, 0, err)))
+    return -1;
+  if (gt_rdb_stmt_exec(stmt, err) < 0)
+    had_err = -1;
+  gt_rdb_stmt_delete(stmt);
+  return had_err;
+}
+
+static GtRDBStmt* gfflike_bulk_prepare(GtRDB *db,
+                                       const GFFlikeBulkTableInfo *info,
+                                       GtUword nof_rows, GtError *err)
+{
+  GtRDBStmt *stmt;
+  GtStr *query;
+  GtUword i, j;
+
+  query = gt_str_new_cstr(info->insert);
+  for (i = 0; i < nof_rows; i++) {
+    gt_str_append_cstr(query, i == 0 ? "(" : ", (");
+    for (j = 0; j < info->nof_columns; j++)
+      gt_str_append_cstr(query, j == 0 ? "?" : ", ?");
+    gt_str_append_char(query, ')');
+  }
+  stmt = gt_rdb_prepare(db, gt_str_get(query), nof_rows * info->nof_columns,
+                        err);
+  gt_str_delete(query);
+  return stmt;
+}
+
+static void gfflike_bulk_clear_rows(GtArray *rows, GtUword nof_rows,
+                                    const GFFlikeBulkTableInfo *info)
+{
+  GtUword i;
+
+  if (info->has_strings) {
+    for (i = 0; i < nof_rows; i++) {
+      GFFlikeBulkAttribute *a = gt_array_get(rows, i);
+      gt_free(a->key);
+      gt_free(a->value);
+    }
+  }
+  if (nof_rows == gt_array_size(rows))
+    gt_array_reset(rows);
+  else if (nof_rows > 0)
+    gt_array_rem_span(rows, 0, nof_rows - 1);
+}
+
+/* Writes the buffered rows of table <tab> in full batches. If <all> is true,
+   the remaining rows are written as well. */
+static int gfflike_bulk_flush(GtFeatureIndexGFFlike *fi, GFFlikeBulkTable tab,
+                              bool all, GtError *err)
+{
+  const GFFlikeBulkTableInfo *info = gfflike_bulk_tables + tab;
+  GtArray *rows = fi->bulk_rows[tab];
+  GtUword i, nof_rows, done = 0, size = gt_array_size(rows);
+  GtRDBStmt *stmt;
+  int had_err = 0;
+
+  while (!had_err && (size - done >= info->rows_per_stmt ||
+                      (all && done < size))) {
+    nof_rows = MIN(size - done, info->rows_per_stmt);
+    if (nof_rows == info->rows_per_stmt) {
+      if (!fi->bulk_stmts[tab]) {
+        fi->bulk_stmts[tab] = gfflike_bulk_prepare(fi->db, info, nof_rows,
+                                                   err);
+      }
+      else
+        (void) gt_rdb_stmt_reset(fi->bulk_stmts[tab], err);
+      stmt = fi->bulk_stmts[tab];
+    }
+    else
+      stmt = gfflike_bulk_prepare(fi->db, info, nof_rows, err);
+    if (!stmt)
+      had_err = -1;
+    for (i = 0; !had_err && i < nof_rows; i++) {
+      had_err = info->bind(stmt, i * info->nof_columns,
+                           gt_array_get(rows, done + i), err);
+    }
+    if (!had_err && gt_rdb_stmt_exec(stmt, err) < 0)
+      had_err = -1;
+    if (stmt != fi->bulk_stmts[tab])
+      gt_rdb_stmt_delete(stmt);
+    if (!had_err)
+      done += nof_rows;
+  }
+  gfflike_bulk_clear_rows(rows, done, info);
+  return had_err;
+}
+
+static void gfflike_bulk_add_node(GtFeatureIndexGFFlike *fi,
+                                  GtFeatureNode *fn)
+{
+  GFFlikeBulkFeature row;
+  GtStrArray *attribs;
+  GtRange rng;
+  GtUword i;
+
+  /* nodes with multiple parents are only stored once */
+  if (gt_hashmap_get(fi->bulk_node2id, fn))
+    return;
+
+  row.id = fi->bulk_next_id++;
+  row.type = GT_UNDEF_INT;
+  if (!gt_feature_node_is_pseudo(fn)) {
+    /* pseudo-features do not have a type */
+    row.type =
+      gt_feature_index_gfflike_insert_helper(fi,
+                                         fi->stmts[GT_PSTMT_TYPE_SELECT],
+                                         fi->stmts[GT_PSTMT_TYPE_INSERT],
+                                         gt_feature_node_get_type(fn),
+                                         "types",
+                                         NULL);
+  }
+  row.source =
+    gt_feature_index_gfflike_insert_helper(fi,
+                                           fi->stmts[GT_PSTMT_SOURCE_SELECT],
+                                           fi->stmts[GT_PSTMT_SOURCE_INSERT],
+                                           gt_feature_node_get_source(fn),
+                                           "sources",
+                                           NULL);
+  row.seqid =
+    gt_feature_index_gfflike_insert_helper(fi,
+                    fi->stmts[GT_PSTMT_SEQUENCEREGION_SELECT],
+                    fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT],
+                    gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) fn)),
+                    "sequenceregions",
+                    NULL);
+  rng = gt_genome_node_get_range((GtGenomeNode*) fn);
+  row.start = rng.start;
+  row.end = rng.end;
+  row.score = gt_feature_node_score_is_defined(fn)
+                ? gt_feature_node_get_score(fn)
+                : GT_UNDEF_DOUBLE;
+  row.strand = gt_feature_node_get_strand(fn);
+  row.phase = gt_feature_node_get_phase(fn);
+  row.multi = gt_feature_node_is_multi(fn) ? 1 : 0;
+  row.multi_rep = 0;
+  if (row.multi) {
+    GtFeatureNode *rep = gt_feature_node_get_multi_representative(fn);
+    if (rep != fn) {
+      row.multi_rep = (GtUword) gt_hashmap_get(fi->bulk_node2id, rep);
+      gt_assert(row.multi_rep);
+    }
+  }
+  row.pseudo = gt_feature_node_is_pseudo(fn);
+  row.marked = gt_feature_node_is_marked(fn);
+  gt_array_add(fi->bulk_rows[GFFLIKE_BULK_FEATURES], row);
+  gt_hashmap_add(fi->bulk_node2id, fn, (void*) row.id);
+  gt_array_add(fi->bulk_tree_nodes, fn);
+
+  attribs = gt_feature_node_get_attribute_list(fn);
+  for (i = 0; i < gt_str_array_size(attribs); i++) {
+    GFFlikeBulkAttribute attr;
+    attr.feature_id = row.id;
+    attr.key = gt_cstr_dup(gt_str_array_get(attribs, i));
+    attr.value = gt_cstr_dup(gt_feature_node_get_attribute(fn, attr.key));
+    gt_array_add(fi->bulk_rows[GFFLIKE_BULK_ATTRIBUTES], attr);
+  }
+  gt_str_array_delete(attribs);
+}
+
+static int bulk_insert_feature_node(GtFeatureIndexGFFlike *fi,
+                                    GtFeatureNode *fn,
+                                    GtError *err)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *node, *child;
+  GtUword i;
+  int tab, had_err = 0;
+
+  gt_mutex_lock(fi->dblock);
+  gt_hashmap_reset(fi->bulk_node2id);
+  gt_array_reset(fi->bulk_tree_nodes);
+
+  /* IDs are assigned in insertion order, as in insert_feature_node() */
+  if (gt_feature_node_is_pseudo(fn))
+    gfflike_bulk_add_node(fi, fn);
+  fni = gt_feature_node_iterator_new(fn);
+  while ((node = gt_feature_node_iterator_next(fni)))
+    gfflike_bulk_add_node(fi, node);
+  gt_feature_node_iterator_delete(fni);
+
+  /* all nodes of the subgraph have their IDs now, store relationships (pseudo
+     nodes are not stored as parents) */
+  for (i = 0; i < gt_array_size(fi->bulk_tree_nodes); i++) {
+    node = *(GtFeatureNode**) gt_array_get(fi->bulk_tree_nodes, i);
+    if (gt_feature_node_is_pseudo(node))
+      continue;
+    fni = gt_feature_node_iterator_new_direct(node);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      GFFlikeBulkParent par;
+      par.feature_id = (GtUword) gt_hashmap_get(fi->bulk_node2id, child);
+      par.parent = (GtUword) gt_hashmap_get(fi->bulk_node2id, node);
+      gt_assert(par.feature_id && par.parent);
+      gt_array_add(fi->bulk_rows[GFFLIKE_BULK_PARENTS], par);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+
+  for (tab = 0; !had_err && tab < GFFLIKE_BULK_NOF_TABLES; tab++)
+    had_err = gfflike_bulk_flush(fi, tab, false, err);
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
+static int gfflike_bulk_visit_sqlite(GtRDBVisitor *rdbv, GtRDBSqlite *db,
+                                     GtError *err)
+{
+  GFFlikeBulkVisitor *bv = gfflike_bulk_visitor_cast(rdbv);
+  GtStr *query;
+  GtUword i;
+  int had_err = 0;
+
+  if (bv->finish)
+    return anno_db_gfflike_create_indexes_sqlite(db, err);
+
+  had_err = gfflike_exec_query((GtRDB*) db, "PRAGMA synchronous=OFF", err);
+  if (!had_err)
+    had_err = gfflike_exec_query((GtRDB*) db, "PRAGMA journal_mode=MEMORY",
+                                 err);
+  if (!had_err)
+    had_err = gfflike_exec_query((GtRDB*) db, "PRAGMA temp_store=MEMORY",
+                                 err);
+  if (!had_err)
+    had_err = gfflike_exec_query((GtRDB*) db, "PRAGMA cache_size=512000",
+                                 err);
+  if (bv->drop_indexes) {
+    query = gt_str_new();
+    for (i = 0; !had_err && i < sizeof gfflike_bulk_indexes /
+                                sizeof gfflike_bulk_indexes[0]; i++) {
+      gt_str_reset(query);
+      gt_str_append_cstr(query, "DROP INDEX IF EXISTS ");
+      gt_str_append_cstr(query, gfflike_bulk_indexes[i][0]);
+      had_err = gfflike_exec_query((GtRDB*) db, gt_str_get(query), err);
+    }
+    gt_str_delete(query);
+  }
+  return had_err;
+}
+
+static int gfflike_bulk_visit_mysql(GtRDBVisitor *rdbv, GtRDBMySQL *db,
+                                    GtError *err)
+{
+  GFFlikeBulkVisitor *bv = gfflike_bulk_visitor_cast(rdbv);
+  GtCstrTable *cst;
+  GtStr *query;
+  GtUword i;
+  int had_err = 0;
+
+  if (bv->finish) {
+    had_err = anno_db_gfflike_create_indexes_mysql(db, err);
+    if (!had_err)
+      had_err = gfflike_exec_query((GtRDB*) db, "SET unique_checks=1", err);
+    if (!had_err)
+      had_err = gfflike_exec_query((GtRDB*) db, "SET foreign_key_checks=1",
+                                   err);
+    return had_err;
+  }
+
+  had_err = gfflike_exec_query((GtRDB*) db, "SET unique_checks=0", err);
+  if (!had_err)
+    had_err = gfflike_exec_query((GtRDB*) db, "SET foreign_key_checks=0",
+                                 err);
+  if (!had_err && bv->drop_indexes) {
+    if (!(cst = gt_rdb_get_indexes((GtRDB*) db, err)))
+      return -1;
+    query = gt_str_new();
+    for (i = 0; !had_err && i < sizeof gfflike_bulk_indexes /
+                                sizeof gfflike_bulk_indexes[0]; i++) {
+      if (!gt_cstr_table_get(cst, gfflike_bulk_indexes[i][0]))
+        continue;
+      gt_str_reset(query);
+      gt_str_append_cstr(query, "DROP INDEX ");
+      gt_str_append_cstr(query, gfflike_bulk_indexes[i][0]);
+      gt_str_append_cstr(query, " ON ");
+      gt_str_append_cstr(query, gfflike_bulk_indexes[i][1]);
+      had_err = gfflike_exec_query((GtRDB*) db, gt_str_get(query), err);
+    }
+    gt_str_delete(query);
+    gt_cstr_table_delete(cst);
+  }
+  return had_err;
+}
+
+static int gfflike_bulk_visit(GtFeatureIndexGFFlike *fi, bool finish,
+                              bool drop_indexes, GtError *err)
+{
+  GtRDBVisitor *v = gt_rdb_visitor_create(gfflike_bulk_visitor_class());
+  GFFlikeBulkVisitor *bv = gfflike_bulk_visitor_cast(v);
+  int had_err;
+
+  bv->finish = finish;
+  bv->drop_indexes = drop_indexes;
+  had_err = gt_rdb_accept(fi->db, v, err);
+  gt_rdb_visitor_delete(v);
+  return had_err;
+}
+
+static void gfflike_bulk_free(GtFeatureIndexGFFlike *fi)
+{
+  int tab;
+
+  for (tab = 0; tab < GFFLIKE_BULK_NOF_TABLES; tab++) {
+    if (fi->bulk_rows[tab]) {
+      gfflike_bulk_clear_rows(fi->bulk_rows[tab],
+                              gt_array_size(fi->bulk_rows[tab]),
+                              gfflike_bulk_tables + tab);
+      gt_array_delete(fi->bulk_rows[tab]);
+      fi->bulk_rows[tab] = NULL;
+    }
+    gt_rdb_stmt_delete(fi->bulk_stmts[tab]);
+    fi->bulk_stmts[tab] = NULL;
+  }
+  gt_array_delete(fi->bulk_tree_nodes);
+  fi->bulk_tree_nodes = NULL;
+  gt_hashmap_delete(fi->bulk_node2id);
+  fi->bulk_node2id = NULL;
+  fi->bulk = false;
+}
+
+/* Recreates the indexes dropped by a bulk load which did not finish. */
+static void gfflike_bulk_restore_indexes(GtFeatureIndexGFFlike *fi)
+{
+  GtError *err = gt_error_new();
+
+  if (gfflike_bulk_visit(fi, true, false, err))
+    gt_warning("could not restore indexes: %s", gt_error_get(err));
+  gt_error_delete(err);
+}
+
+/* Rolls back a failed bulk load and leaves the database with its
+   indexes. */
+static void gfflike_bulk_cleanup(GtFeatureIndexGFFlike *fi)
+{
+  GtError *err = gt_error_new();
+  int i;
+
+  gfflike_bulk_free(fi);
+  /* statements still stepping through a result would keep their tables
+     locked */
+  for (i = 0; i < GT_PSTMT_NOF_STATEMENTS; i++) {
+    if (fi->stmts[i])
+      (void) gt_rdb_stmt_reset(fi->stmts[i], err);
+  }
+  (void) gfflike_exec_query(fi->db, "ROLLBACK", err);
+  gt_error_delete(err);
+  /* cached type, source and sequence region IDs may have been rolled back */
+  gt_hashmap_reset(fi->string_caches);
+  gfflike_bulk_restore_indexes(fi);
+}
+
+int gt_feature_index_gfflike_bulk_load_begin(GtFeatureIndex *gfi,
+                                             GtError *err)
+{
+  GtFeatureIndexGFFlike *fi;
+  GtRDBStmt *stmt;
+  GtUword max_id = 0;
+  int tab, had_err = 0;
+  gt_assert(gfi);
+  gt_error_check(err);
+
+  fi = feature_index_gfflike_cast(gfi);
+  gt_assert(!fi->bulk);
+
+  /* feature IDs are assigned in memory, following the largest one stored */
+  stmt = gt_rdb_prepare(fi->db, "SELECT COALESCE(MAX(id), 0) FROM features",
+                        0, err);
+  if (!stmt || gt_rdb_stmt_exec(stmt, err) != 0 ||
+      gt_rdb_stmt_get_ulong(stmt, 0, &max_id, err)) {
+    if (!gt_error_is_set(err))
+      gt_error_set(err, "could not determine largest feature ID");
+    had_err = -1;
+  }
+  gt_rdb_stmt_delete(stmt);
+
+  /* building the indexes once after loading into an empty database is
+     cheaper than maintaining them during the load */
+  if (!had_err) {
+    had_err = gfflike_bulk_visit(fi, false, max_id == 0, err);
+    if (!had_err)
+      had_err = gfflike_exec_query(fi->db, "BEGIN", err);
+    /* some indexes may already have been dropped */
+    if (had_err)
+      gfflike_bulk_restore_indexes(fi);
+  }
+
+  if (!had_err) {
+    for (tab = 0; tab < GFFLIKE_BULK_NOF_TABLES; tab++) {
+      fi->bulk_rows[tab] = gt_array_new(gfflike_bulk_tables[tab].row_size);
+      fi->bulk_stmts[tab] = NULL;
+    }
+    fi->bulk_tree_nodes = gt_array_new(sizeof (GtFeatureNode*));
+    fi->bulk_node2id = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+    fi->bulk_next_id = max_id + 1;
+    fi->bulk = true;
+  }
+  return had_err;
+}
+
+int gt_feature_index_gfflike_bulk_load_end(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexGFFlike *fi;
+  int tab, had_err = 0;
+  gt_assert(gfi);
+  gt_error_check(err);
+
+  fi = feature_index_gfflike_cast(gfi);
+  gt_assert(fi->bulk);
+
+  gt_mutex_lock(fi->dblock);
+  for (tab = 0; !had_err && tab < GFFLIKE_BULK_NOF_TABLES; tab++)
+    had_err = gfflike_bulk_flush(fi, tab, true, err);
+  if (!had_err)
+    had_err = gfflike_exec_query(fi->db, "COMMIT", err);
+  if (had_err)
+    gfflike_bulk_cleanup(fi);
+  else {
+    gfflike_bulk_free(fi);
+    had_err = gfflike_bulk_visit(fi, true, false, err);
+  }
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
+void gt_feature_index_gfflike_bulk_load_abort(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexGFFlike *fi;
+  gt_assert(gfi);
+
+  fi = feature_index_gfflike_cast(gfi);
+  gt_assert(fi->bulk);
+
+  gt_mutex_lock(fi->dblock);
+  gfflike_bulk_cleanup(fi);
+  gt_mutex_unlock(fi->dblock);
+}
+
 typedef struct {
   GtError *err;
   GtFeatureIndexGFFlike *fis;
@@ -1022,6 +1623,9 @@ int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
   gt_assert(gfi && gf);
 
   fi = feature_index_gfflike_cast(gfi);
+  /* during a bulk load, nodes are only written */
+  if (fi->bulk)
+    return bulk_insert_feature_node(fi, gf, err);
   had_err = insert_feature_node(fi,
                                 (GtFeatureNode*)
                                          gt_genome_node_ref((GtGenomeNode*) gf),
@@ -1650,6 +2254,7 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
   GtUword i;
   if (!gfi) return;
   fi = feature_index_gfflike_cast(gfi);
+  gfflike_bulk_free(fi);
   for (i=0;i<GT_PSTMT_NOF_STATEMENTS;i++) {
     gt_rdb_stmt_delete(fi->stmts[i]);
   }
@@ -2014,6 +2619,20 @@ static const GtRDBVisitorClass* gfflike_setup_visitor_class()
   return svc;
 }
 
+static const GtRDBVisitorClass* gfflike_bulk_visitor_class()
+{
+  static const GtRDBVisitorClass *bvc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!bvc) {
+    bvc = gt_rdb_visitor_class_new(sizeof (GFFlikeBulkVisitor),
+                                   NULL,
+                                   gfflike_bulk_visit_sqlite,
+                                   gfflike_bulk_visit_mysql);
+  }
+  gt_class_alloc_lock_leave();
+  return bvc;
+}
+
 static GtRDBVisitor* gfflike_setup_visitor_new(GtAnnoDBGFFlike *adb)
 {
   GtRDBVisitor *v = gt_rdb_visitor_create(gfflike_setup_visitor_class());
@@ -2031,6 +2650,136 @@ GtAnnoDBSchema* gt_anno_db_gfflike_new(void)
   return s;
 }
 
+#ifdef HAVE_SQLITE
+static int anno_db_gfflike_bulk_load_unit_test(GtError *err)
+{
+  GtGenomeNode *region, *gene, *mrna1, *mrna2, *exon1, *exon2;
+  GtFeatureNodeIterator *fni;
+  GtFeatureIndex *fi = NULL;
+  GtAnnoDBSchema *adb;
+  GtCstrTable *indexes = NULL;
+  GtArray *results;
+  GtFeatureNode *fn = NULL;
+  GtRDB *rdb;
+  GtStr *tmpfilename, *seqid;
+  GtRange rng;
+  GtUword i, nof_nodes = 0;
+  FILE *tmpfp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(tmpfp);
+  seqid = gt_str_new_cstr("ctg1");
+  results = gt_array_new(sizeof (GtFeatureNode*));
+
+  /* gene with two transcripts sharing an exon */
+  region = gt_region_node_new(seqid, 1, 10000);
+  gene = gt_feature_node_new(seqid, "gene", 100, 900, GT_STRAND_FORWARD);
+  gt_feature_node_set_attribute((GtFeatureNode*) gene, "ID", "gene1");
+  mrna1 = gt_feature_node_new(seqid, "mRNA", 100, 900, GT_STRAND_FORWARD);
+  mrna2 = gt_feature_node_new(seqid, "mRNA", 100, 500, GT_STRAND_FORWARD);
+  exon1 = gt_feature_node_new(seqid, "exon", 100, 200, GT_STRAND_FORWARD);
+  exon2 = gt_feature_node_new(seqid, "exon", 800, 900, GT_STRAND_FORWARD);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna1);
+  gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) mrna2);
+  gt_feature_node_add_child((GtFeatureNode*) mrna1, (GtFeatureNode*) exon1);
+  gt_feature_node_add_child((GtFeatureNode*) mrna1, (GtFeatureNode*) exon2);
+  gt_feature_node_add_child((GtFeatureNode*) mrna2,
+                            (GtFeatureNode*) gt_genome_node_ref(exon1));
+
+  rdb = gt_rdb_sqlite_new(gt_str_get(tmpfilename), err);
+  gt_ensure(rdb != NULL);
+  adb = gt_anno_db_gfflike_new();
+  if (!had_err) {
+    fi = gt_anno_db_schema_get_feature_index(adb, rdb, err);
+    gt_ensure(fi != NULL);
+  }
+
+  /* an aborted load leaves neither rows nor a database without indexes */
+  if (!had_err)
+    had_err = gt_feature_index_gfflike_bulk_load_begin(fi, err);
+  if (!had_err) {
+    had_err = gt_feature_index_add_region_node(fi, (GtRegionNode*) region,
+                                               err);
+  }
+  /* enough copies to have the first batch of rows written */
+  for (i = 0; !had_err && i < GFFLIKE_BULK_FEATURE_ROWS; i++) {
+    had_err = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gene,
+                                                err);
+  }
+  if (!had_err) {
+    gt_feature_index_gfflike_bulk_load_abort(fi);
+    indexes = gt_rdb_get_indexes(rdb, err);
+    gt_ensure(indexes != NULL);
+  }
+  if (!had_err)
+    gt_ensure(gt_cstr_table_get(indexes, "feature_all") != NULL);
+  gt_cstr_table_delete(indexes);
+  indexes = NULL;
+
+  /* the gene is loaded again below, it must only be found once */
+  if (!had_err)
+    had_err = gt_feature_index_gfflike_bulk_load_begin(fi, err);
+  if (!had_err) {
+    had_err = gt_feature_index_add_region_node(fi, (GtRegionNode*) region,
+                                               err);
+  }
+  if (!had_err) {
+    had_err = gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gene,
+                                                err);
+  }
+  /* the nodes are not referenced by the index during a bulk load */
+  gt_genome_node_delete(gene);
+  if (!had_err)
+    had_err = gt_feature_index_gfflike_bulk_load_end(fi, err);
+
+  if (!had_err) {
+    indexes = gt_rdb_get_indexes(rdb, err);
+    gt_ensure(indexes != NULL);
+  }
+  if (!had_err)
+    gt_ensure(gt_cstr_table_get(indexes, "feature_all") != NULL);
+  if (!had_err) {
+    rng.start = 1;
+    rng.end = 10000;
+    had_err = gt_feature_index_get_features_for_range(fi, results, "ctg1",
+                                                      &rng, err);
+  }
+  if (!had_err)
+    gt_ensure(gt_array_size(results) == 1);
+  if (!had_err) {
+    fn = *(GtFeatureNode**) gt_array_get(results, 0);
+    gt_ensure(strcmp(gt_feature_node_get_type(fn), "gene") == 0);
+    gt_ensure(gt_feature_node_get_attribute(fn, "ID") != NULL &&
+              strcmp(gt_feature_node_get_attribute(fn, "ID"), "gene1") == 0);
+    gt_ensure(gt_feature_node_number_of_children(fn) == 2);
+  }
+  if (!had_err) {
+    fni = gt_feature_node_iterator_new(fn);
+    while (gt_feature_node_iterator_next(fni))
+      nof_nodes++;
+    gt_feature_node_iterator_delete(fni);
+    /* the shared exon is reported once per parent */
+    gt_ensure(nof_nodes == 6);
+  }
+
+  for (i = 0; i < gt_array_size(results); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(results, i));
+  gt_array_delete(results);
+  gt_cstr_table_delete(indexes);
+  gt_genome_node_delete(region);
+  gt_feature_index_delete(fi);
+  gt_anno_db_schema_delete(adb);
+  gt_rdb_delete(rdb);
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  gt_str_delete(seqid);
+  return had_err;
+}
+#endif
+
 int gt_anno_db_gfflike_unit_test(GtError *err)
 {
   int had_err = 0, status = 0;
@@ -2070,6 +2819,11 @@ int gt_anno_db_gfflike_unit_test(GtError *err)
     gt_ensure(status == 0);
   }
 
+#ifdef HAVE_SQLITE
+  if (!had_err)
+    had_err = anno_db_gfflike_bulk_load_unit_test(err);
+#endif
+
   gt_xremove(gt_str_get(tmpfilename));
   gt_str_delete(tmpfilename);
   gt_feature_index_delete(fi);
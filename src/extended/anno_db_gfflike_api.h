@@ -36,6 +36,32 @@ int             gt_feature_index_gfflike_get_all_features(GtFeatureIndex *gfi,
                                                           GtArray *results,
                                                           GtError *err);
 
+/* Starts a bulk load into <gfi>, which must have been created by a
+   <GtAnnoDBGFFlike> schema. Until <gt_feature_index_gfflike_bulk_load_end()>
+   is called, added feature nodes are only written to the database (they are
+   neither referenced nor observed for changes): feature IDs are assigned in
+   memory, rows are inserted in batches within a single transaction spanning
+   the whole load, and the indexes of an empty database are only created at
+   the end. Returns 0 on success, a negative value otherwise. The message in
+   <err> is set accordingly. */
+int             gt_feature_index_gfflike_bulk_load_begin(GtFeatureIndex *gfi,
+                                                         GtError *err);
+
+/* Writes all pending rows of the bulk load into <gfi>, commits them and
+   creates the indexes. If writing fails, all rows of the bulk load are
+   rolled back and the indexes are recreated nevertheless. Returns 0 on
+   success, a negative value otherwise. The message in <err> is set
+   accordingly. */
+int             gt_feature_index_gfflike_bulk_load_end(GtFeatureIndex *gfi,
+                                                       GtError *err);
+
+/* Ends a bulk load into <gfi> which failed. All rows of the bulk load are
+   rolled back and the indexes dropped by
+   <gt_feature_index_gfflike_bulk_load_begin()> are recreated. Must be called
+   instead of <gt_feature_index_gfflike_bulk_load_end()> if adding nodes
+   failed. */
+void            gt_feature_index_gfflike_bulk_load_abort(GtFeatureIndex *gfi);
+
 int             gt_anno_db_gfflike_unit_test(GtError *err);
 
 #endif
@@ -98,11 +98,14 @@ void gt_bitoutstream_flush(GtBitOutStream *bitstream)
 void gt_bitoutstream_flush_advance(GtBitOutStream *bitstream)
 {
   GtWord fpos;
-  bool is_not_at_pageborder = (ftell(bitstream->fp) % bitstream->pagesize) != 0;
+  bool is_not_at_pageborder;
 
   gt_assert(bitstream);
 
+  /* the position has to be checked after the flush, the buffered bits may
+     move it past a page border */
   gt_bitoutstream_flush(bitstream);
+  is_not_at_pageborder = (ftell(bitstream->fp) % bitstream->pagesize) != 0;
 
   if (is_not_at_pageborder) {
     fpos = (ftell(bitstream->fp) / bitstream->pagesize + 1) *
@@ -15,6 +15,8 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+
 #include "core/byte_popcount_api.h"
 #include "core/byte_select_api.h"
 #include "core/combinatorics.h"
@@ -24,6 +26,7 @@
 #include "core/log_api.h"
 #include "core/ma_api.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/unused_api.h"
 #include "extended/compressed_bitsequence.h"
@@ -31,6 +34,8 @@
 
 /* this seems to be a good default value. maybe change this in the future */
 #define GT_COMP_BITSEQ_BLOCKSIZE 15U
+/* default distance of the sampled bits for select */
+#define GT_COMP_BITSEQ_SELECT_SAMPLERATE 1024UL
 
 /* gt_compressed_bitsequence_ps_overflow contains a bit mask x consisting of 8
    bytes x[7],...,x[0] and each is set to 128-i */
@@ -106,11 +111,17 @@ struct GtCompressedBitsequence
                                    *superblockranks;
   GtCompressedBitsequenceBlockInfo *cbs_bi;
   void                             *mmapped;
+  /* superblocks containing every select_samplerate-th 1 (0) bit */
+  GtUword                          *select_1_samples,
+                                   *select_0_samples;
+  unsigned int                     *offset_bits_tab;
   GtUword                           c_offsets_size,
                                     classes_size,
                                     num_of_bits,
                                     num_of_blocks,
                                     num_of_superblocks,
+                                    num_of_ones,
+                                    select_samplerate,
                                     superblockoffsets_size,
                                     superblockranks_size;
   unsigned int                      blocksize,
@@ -263,6 +274,96 @@ gt_compressed_bitsequence_set_class(GtCompressedBitsequence *cbs,
                                                (GtBitsequence) class);
 }
 
+/* Returns the classes of the <num> blocks starting with block <idx>, the
+   first class in the most significant bits. <num> classes have to fit into
+   one word. */
+static inline GtBitsequence
+gt_compressed_bitsequence_get_classes(GtCompressedBitsequence *cbs,
+                                      GtUword idx,
+                                      unsigned int num)
+{
+  const unsigned int len = num * cbs->class_bits;
+  gt_assert(len != 0 && len <= (unsigned int) GT_INTWORDSIZE);
+  return gt_compressed_bitsequence_get_variable_field(cbs->classes,
+                                                      idx * cbs->class_bits,
+                                                      len)
+         << (GtBitsequence) (GT_INTWORDSIZE - len);
+}
+
+/* number of 1 bits upto the end of superblock <sblock> */
+static inline GtUword
+gt_compressed_bitsequence_superblock_rank(GtCompressedBitsequence *cbs,
+                                          GtUword sblock)
+{
+  return (GtUword) gt_compressed_bitsequence_get_variable_field(
+                                            cbs->superblockranks,
+                                            sblock * cbs->superblockranks_bits,
+                                            cbs->superblockranks_bits);
+}
+
+/* number of 1 (or 0) bits upto the end of superblock <sblock> */
+static inline GtUword
+gt_compressed_bitsequence_superblock_count(GtCompressedBitsequence *cbs,
+                                           GtUword sblock,
+                                           bool ones)
+{
+  GtUword rank = gt_compressed_bitsequence_superblock_rank(cbs, sblock),
+          end = (sblock + 1) * cbs->superblocksize * cbs->blocksize;
+  if (ones)
+    return rank;
+  return MIN(end, cbs->num_of_bits) - rank;
+}
+
+/* position of the class offset of the first block after superblock
+   <sblock> */
+static inline GtUword
+gt_compressed_bitsequence_superblock_offset(GtCompressedBitsequence *cbs,
+                                            GtUword sblock)
+{
+  return (GtUword) gt_compressed_bitsequence_get_variable_field(
+                                          cbs->superblockoffsets,
+                                          sblock * cbs->superblockoffsets_bits,
+                                          cbs->superblockoffsets_bits);
+}
+
+/* Sets <rank_sum> to the number of 1 bits before block <idx> and
+   <offsets_bitpos> to the position of its class offset. The classes between
+   the preceding superblock sample and <idx> are read a word at a time. */
+static inline void
+gt_compressed_bitsequence_block_start(GtCompressedBitsequence *cbs,
+                                      GtUword idx,
+                                      GtUword *rank_sum,
+                                      GtUword *offsets_bitpos)
+{
+  const unsigned int chunksize =
+    (unsigned int) GT_INTWORDSIZE / cbs->class_bits;
+  GtUword jdx, sample = idx / cbs->superblocksize;
+
+  if (sample == 0) {
+    *rank_sum = 0;
+    *offsets_bitpos = 0;
+  }
+  else {
+    *rank_sum = gt_compressed_bitsequence_superblock_rank(cbs, sample - 1);
+    *offsets_bitpos =
+      gt_compressed_bitsequence_superblock_offset(cbs, sample - 1);
+  }
+  jdx = sample * cbs->superblocksize;
+  while (jdx < idx) {
+    unsigned int num = (unsigned int) MIN((GtUword) chunksize, idx - jdx);
+    GtBitsequence classes = gt_compressed_bitsequence_get_classes(cbs, jdx,
+                                                                  num);
+    jdx += num;
+    for (; num > 0; num--) {
+      unsigned int class = (unsigned int)
+        (classes >> (GtBitsequence) (GT_INTWORDSIZE - cbs->class_bits));
+      classes <<= (GtBitsequence) cbs->class_bits;
+      *rank_sum += class;
+      *offsets_bitpos += cbs->offset_bits_tab[class];
+    }
+  }
+}
+
 static void gt_compressed_bitsequence_fill_tabs(GtCompressedBitsequence *cbs,
                                                 GtBitsequence *bitseq)
 {
@@ -382,16 +483,12 @@ gt_compressed_bitsequence_fill_c_tab_init_o_tab(GtCompressedBitsequence *cbs,
                                           (GtUword) current_blk);
     gt_compressed_bitsequence_set_class(cbs, current_class, idx);
     o_size += gt_popcount_tab_offset_bits(cbs->popcount_tab, current_class);
-    ones += current_blk;
+    ones += current_class;
   }
   cbs->c_offsets_size = (GtUword) GT_NUMOFINTSFORBITS(o_size);
-#ifdef __SSE4_2__
-  cbs->superblockoffsets_bits = __builtin_clzl(o_size);
-  cbs->superblockranks_bits = __builtin_clzl(ones);
-#else
+  cbs->num_of_ones = ones;
   cbs->superblockoffsets_bits = gt_determinebitspervalue(o_size);
   cbs->superblockranks_bits = gt_determinebitspervalue(ones);
-#endif
   GT_INITBITTAB(cbs->c_offsets, o_size);
 }
 
@@ -419,6 +516,9 @@ static inline void gt_compressed_bitsequence_init(GtCompressedBitsequence *cbs,
   cbs->mmapped = NULL;
 }
 
+static void
+gt_compressed_bitsequence_init_lookup(GtCompressedBitsequence *cbs);
+
 GtCompressedBitsequence *
 gt_compressed_bitsequence_new(GtBitsequence *bitseq,
                               unsigned int samplerate,
@@ -435,6 +535,7 @@ gt_compressed_bitsequence_new(GtBitsequence *bitseq,
   gt_compressed_bitsequence_fill_c_tab_init_o_tab(cbs, bitseq);
   gt_compressed_bitsequence_init_s_tabs(cbs);
   gt_compressed_bitsequence_fill_tabs(cbs, bitseq);
+  gt_compressed_bitsequence_init_lookup(cbs);
   cbs->from_file = false;
   gt_log_log("new cbs:\n"
              "blzise: %u\n"
@@ -467,38 +568,17 @@ gt_compressed_bitsequence_calc_block_info(GtCompressedBitsequence *cbs,
 
   if (idx != bi->idx) {
     unsigned int offset_bits;
-    GtUword jdx, sample, offsets_bitpos;
+    GtUword offsets_bitpos;
 
     bi->idx = idx;
     bi->block_len = cbs->blocksize;
     if (idx == cbs->num_of_blocks -1)
       bi->block_len = cbs->last_block_len;
 
-    sample = idx / cbs->superblocksize;
-    if (sample==0) {
-      offsets_bitpos = 0;
-      bi->rank_sum = 0;
-    }
-    else {
-      offsets_bitpos = (GtUword)
-        gt_compressed_bitsequence_get_variable_field(
-                                     cbs->superblockoffsets,
-                                     (sample - 1) * cbs->superblockoffsets_bits,
-                                     cbs->superblockoffsets_bits);
-      bi->rank_sum = (GtUword)
-        gt_compressed_bitsequence_get_variable_field(
-                                       cbs->superblockranks,
-                                       (sample - 1) * cbs->superblockranks_bits,
-                                       cbs->superblockranks_bits);
-    }
-    for (jdx = sample * cbs->superblocksize; jdx < idx; jdx++) {
-      bi->class = gt_compressed_bitsequence_get_class(cbs, jdx);
-      bi->rank_sum += bi->class;
-      offsets_bitpos += gt_popcount_tab_offset_bits(cbs->popcount_tab,
-                                                    bi->class);
-    }
+    gt_compressed_bitsequence_block_start(cbs, idx, &bi->rank_sum,
+                                          &offsets_bitpos);
     bi->class = gt_compressed_bitsequence_get_class(cbs, idx);
-    offset_bits = gt_popcount_tab_offset_bits(cbs->popcount_tab, bi->class);
+    offset_bits = cbs->offset_bits_tab[bi->class];
     bi->block_offset = (GtUword)
       gt_compressed_bitsequence_get_variable_field(cbs->c_offsets,
                                                    offsets_bitpos,
@@ -642,250 +722,336 @@ gt_compressed_bitsequence_select_1_word(uint64_t word, unsigned int i)
 #endif
 }
 
-GtUword gt_compressed_bitsequence_select_1(GtCompressedBitsequence *cbs,
-                                           GtUword num)
+/* Returns the superblock containing the <num>th 1 (or 0) bit. The select
+   samples restrict the binary search over the superblock ranks to the
+   superblocks between two samples. */
+static inline GtUword
+gt_compressed_bitsequence_select_superblock(GtCompressedBitsequence *cbs,
+                                            GtUword num,
+                                            bool ones)
 {
-  unsigned int block_offset_bits,
-               class = cbs->blocksize + 1;
-  GtUword block_idx,
-          blocks_offset_pos,
-          containing_s_block,
-          end_s_block, middle_s_block, start_s_block,
-          position,
-          rank_sum = 0,
-          start, start_l, start_r;
-  uint64_t block;
-
-  gt_assert(num != 0);
-  gt_assert(cbs != NULL);
-  gt_assert(num < cbs->num_of_bits);
-
-  /* if larger then max rank1 */
-  if (num > (GtUword) gt_compressed_bitsequence_get_variable_field(
-                      cbs->superblockranks,
-                      (cbs->num_of_superblocks - 1) * cbs->superblockranks_bits,
-                      cbs->superblockranks_bits))
-    return cbs->num_of_bits;
-  if (num <= (GtUword)
-      gt_compressed_bitsequence_get_variable_field(cbs->superblockranks, 0,
-                                                   cbs->superblockranks_bits)) {
-    rank_sum = 0;
-    containing_s_block = 0;
-    blocks_offset_pos = 0;
+  GtUword left, right, middle, sample;
+  const GtUword *samples = ones ? cbs->select_1_samples
+                                : cbs->select_0_samples;
+
+  if (samples != NULL) {
+    sample = (num - 1) / cbs->select_samplerate;
+    left = samples[sample];
+    right = samples[sample + 1];
   }
   else {
-    /* binary search for superblock */
-    start_s_block = num / (cbs->blocksize * cbs->superblocksize);
-    end_s_block = cbs->num_of_superblocks;
-    middle_s_block = GT_DIV2(start_s_block + end_s_block);
-    while (start_s_block < end_s_block) {
-      start = middle_s_block * cbs->superblockranks_bits;
-      if ((GtUword) gt_compressed_bitsequence_get_variable_field(
-                                                    cbs->superblockranks, start,
-                                                    cbs->superblockranks_bits)
-          < num) {
-        start_r = start + cbs->superblockranks_bits;
-        if ((GtUword) gt_compressed_bitsequence_get_variable_field(
-                                                  cbs->superblockranks, start_r,
-                                                  cbs->superblockranks_bits)
-            < num)
-          start_s_block = middle_s_block;
-        else
-          break;
-      }
-      else {
-        start_l = start - cbs->superblockranks_bits;
-        if ((GtUword) gt_compressed_bitsequence_get_variable_field(
-                                                  cbs->superblockranks, start_l,
-                                                  cbs->superblockranks_bits)
-            >= num)
-          end_s_block = middle_s_block;
-        else {
-          middle_s_block--;
-          break;
-        }
-      }
-      middle_s_block = GT_DIV2(start_s_block + end_s_block);
-    }
-    blocks_offset_pos = (GtUword)
-      gt_compressed_bitsequence_get_variable_field(
-                                   cbs->superblockoffsets,
-                                   middle_s_block * cbs->superblockoffsets_bits,
-                                   cbs->superblockoffsets_bits);
-    rank_sum = (GtUword) gt_compressed_bitsequence_get_variable_field(
-                                     cbs->superblockranks,
-                                     middle_s_block * cbs->superblockranks_bits,
-                                     cbs->superblockranks_bits);
-    containing_s_block = middle_s_block+1;
+    left = 0;
+    right = cbs->num_of_superblocks - 1;
   }
-
-  /* search within superblock */
-  for (block_idx = containing_s_block * cbs->superblocksize;
-       block_idx < cbs->num_of_blocks;
-       block_idx++) {
-    class = gt_compressed_bitsequence_get_class(cbs, block_idx);
-    if (num <= rank_sum + class)
-      break;
-    blocks_offset_pos += gt_popcount_tab_offset_bits(cbs->popcount_tab, class);
-    rank_sum += class;
+  while (left < right) {
+    middle = left + GT_DIV2(right - left);
+    if (gt_compressed_bitsequence_superblock_count(cbs, middle, ones) >= num)
+      right = middle;
+    else
+      left = middle + 1;
   }
-  gt_assert(class != cbs->blocksize + 1);
-  position = block_idx * cbs->blocksize;
-  if (class == cbs->blocksize) {
-    position += num - rank_sum - 1;
+  return left;
+}
+
+/* Returns the block in superblock <sblock> containing the <num>th 1 (or 0)
+   bit, <rank_sum> and <offsets_bitpos> have to be set to the values of the
+   first block of <sblock> and are updated to the values of the returned
+   block, whose class is stored in <class>. */
+static inline GtUword
+gt_compressed_bitsequence_select_block(GtCompressedBitsequence *cbs,
+                                       GtUword sblock,
+                                       GtUword num,
+                                       bool ones,
+                                       GtUword *rank_sum,
+                                       GtUword *offsets_bitpos,
+                                       unsigned int *class)
+{
+  const unsigned int chunksize =
+    (unsigned int) GT_INTWORDSIZE / cbs->class_bits;
+  GtUword idx = sblock * cbs->superblocksize,
+          end = MIN(idx + cbs->superblocksize, cbs->num_of_blocks);
+
+  while (idx < end) {
+    unsigned int num_of_classes =
+      (unsigned int) MIN((GtUword) chunksize, end - idx);
+    GtBitsequence classes =
+      gt_compressed_bitsequence_get_classes(cbs, idx, num_of_classes);
+    for (; num_of_classes > 0; num_of_classes--, idx++) {
+      unsigned int count;
+      *class = (unsigned int)
+        (classes >> (GtBitsequence) (GT_INTWORDSIZE - cbs->class_bits));
+      classes <<= (GtBitsequence) cbs->class_bits;
+      count = ones ? *class : cbs->blocksize - *class;
+      if (num <= *rank_sum + count)
+        return idx;
+      *rank_sum += count;
+      *offsets_bitpos += cbs->offset_bits_tab[*class];
+    }
   }
-  else {
-    block_offset_bits = gt_popcount_tab_offset_bits(cbs->popcount_tab, class);
+  gt_assert(false);
+  return end;
+}
 
-    /* search within block */
-    block = (uint64_t)
-      gt_popcount_tab_get(cbs->popcount_tab, class, (GtUword)
-                          gt_compressed_bitsequence_get_variable_field(
-                                              cbs->c_offsets, blocks_offset_pos,
-                                              block_offset_bits));
-    if (block_idx != cbs->num_of_blocks - 1)
-      block <<= ((sizeof (block) * CHAR_BIT) - cbs->blocksize);
-    else
-      block <<= ((sizeof (block) * CHAR_BIT) - cbs->last_block_len);
+static GtUword gt_compressed_bitsequence_select(GtCompressedBitsequence *cbs,
+                                                GtUword num,
+                                                bool ones)
+{
+  unsigned int class, block_offset_bits;
+  GtUword sblock, block_idx, position,
+          rank_sum = 0,
+          offsets_bitpos = 0;
+  uint64_t block;
 
-    position +=
-      gt_compressed_bitsequence_select_1_word(block,
-                                              (unsigned int) (num - rank_sum));
+  sblock = gt_compressed_bitsequence_select_superblock(cbs, num, ones);
+  if (sblock != 0) {
+    rank_sum = gt_compressed_bitsequence_superblock_count(cbs, sblock - 1,
+                                                          ones);
+    offsets_bitpos = gt_compressed_bitsequence_superblock_offset(cbs,
+                                                                 sblock - 1);
   }
+  block_idx = gt_compressed_bitsequence_select_block(cbs, sblock, num, ones,
+                                                     &rank_sum,
+                                                     &offsets_bitpos, &class);
+  position = block_idx * cbs->blocksize;
+  if (class == (ones ? cbs->blocksize : 0))
+    return position + num - rank_sum - 1;
+
+  /* search within block */
+  block_offset_bits = cbs->offset_bits_tab[class];
+  block = (uint64_t)
+    gt_popcount_tab_get(cbs->popcount_tab, class, (GtUword)
+                        gt_compressed_bitsequence_get_variable_field(
+                                                 cbs->c_offsets, offsets_bitpos,
+                                                 block_offset_bits));
+  if (block_idx != cbs->num_of_blocks - 1)
+    block <<= ((sizeof (block) * CHAR_BIT) - cbs->blocksize);
+  else
+    block <<= ((sizeof (block) * CHAR_BIT) - cbs->last_block_len);
+
+  /* invert if we search for 0 */
+  return position +
+    gt_compressed_bitsequence_select_1_word(ones ? block : ~block,
+                                            (unsigned int) (num - rank_sum));
+}
+
+GtUword gt_compressed_bitsequence_select_1(GtCompressedBitsequence *cbs,
+                                           GtUword num)
+{
+  gt_assert(num != 0);
+  gt_assert(cbs != NULL);
+  gt_assert(num < cbs->num_of_bits);
 
-  return position;
+  if (num > cbs->num_of_ones)
+    return cbs->num_of_bits;
+  return gt_compressed_bitsequence_select(cbs, num, true);
 }
 
 GtUword gt_compressed_bitsequence_select_0(GtCompressedBitsequence *cbs,
                                            GtUword num)
 {
-  unsigned int block_offset_bits,
-               class = cbs->blocksize + 1;
-  GtUword block_idx,
-          blocks_offset_pos,
-          containing_s_block,
-          end_s_block, middle_s_block, start_s_block,
-          first_0_superblock_rank,
-          max_0_rank,
-          position,
-          rank_sum = 0,
-          s_block_bits,
-          start, start_l, start_r;
-  uint64_t block;
-
   gt_assert(num != 0);
   gt_assert(cbs != NULL);
   gt_assert(num < cbs->num_of_bits);
 
-  s_block_bits = (GtUword) cbs->blocksize * cbs->superblocksize;
-  max_0_rank = cbs->num_of_bits - gt_compressed_bitsequence_get_variable_field(
-                      cbs->superblockranks,
-                      (cbs->num_of_superblocks - 1) * cbs->superblockranks_bits,
-                      cbs->superblockranks_bits);
-  if (num > max_0_rank)
+  if (num > cbs->num_of_bits - cbs->num_of_ones)
     return cbs->num_of_bits;
+  return gt_compressed_bitsequence_select(cbs, num, false);
+}
 
-  first_0_superblock_rank =
-    s_block_bits - gt_compressed_bitsequence_get_variable_field(
-                                                     cbs->superblockranks, 0,
-                                                     cbs->superblockranks_bits);
-  if (num <= first_0_superblock_rank) {
-    rank_sum = 0;
-    containing_s_block = 0;
-    blocks_offset_pos = 0;
-  }
-  else {
-    GtUword middle_s_block_max,
-            middle_s_block_r_max,
-            middle_s_block_l_max;
-    /* search for superblock */
-    start_s_block = num / s_block_bits; /* cannot be smaller than this */
-    end_s_block = cbs->num_of_superblocks;
-    middle_s_block = GT_DIV2(start_s_block + end_s_block);
-    while (start_s_block < end_s_block) {
-      middle_s_block_max = s_block_bits * (middle_s_block+1);
-      start = middle_s_block * cbs->superblockranks_bits;
-      if ((middle_s_block_max -
-            gt_compressed_bitsequence_get_variable_field(
-                                                  cbs->superblockranks, start,
-                                                  cbs->superblockranks_bits))
-          < num) {
-        middle_s_block_r_max = middle_s_block_max + s_block_bits;
-        start_r = start + cbs->superblockranks_bits;
-        if ((middle_s_block_r_max -
-              gt_compressed_bitsequence_get_variable_field(
-                                                  cbs->superblockranks, start_r,
-                                                  cbs->superblockranks_bits))
-            < num)
-          start_s_block = middle_s_block;
-        else
-          break;
-      }
-      else {
-        middle_s_block_l_max = middle_s_block_max - s_block_bits;
-        start_l = start - cbs->superblockranks_bits;
-        if ((middle_s_block_l_max -
-               gt_compressed_bitsequence_get_variable_field(
-                                                  cbs->superblockranks, start_l,
-                                                  cbs->superblockranks_bits))
-            >= num)
-          end_s_block = middle_s_block;
-        else {
-          middle_s_block--;
-          break;
-        }
-      }
-      middle_s_block = GT_DIV2(start_s_block + end_s_block);
-    }
-    middle_s_block_max = s_block_bits * (middle_s_block + 1);
-    blocks_offset_pos = (GtUword)
-      gt_compressed_bitsequence_get_variable_field(
-                                   cbs->superblockoffsets,
-                                   middle_s_block * cbs->superblockoffsets_bits,
-                                   cbs->superblockoffsets_bits);
-    rank_sum = (GtUword)
-      middle_s_block_max - gt_compressed_bitsequence_get_variable_field(
-                                     cbs->superblockranks,
-                                     middle_s_block * cbs->superblockranks_bits,
-                                     cbs->superblockranks_bits);
-    containing_s_block = middle_s_block+1;
+static void
+gt_compressed_bitsequence_fill_select_samples(GtCompressedBitsequence *cbs,
+                                              GtUword *samples,
+                                              GtUword num_of_samples,
+                                              bool ones)
+{
+  GtUword sblock, sample = 0;
+  for (sblock = 0; sblock < cbs->num_of_superblocks; sblock++) {
+    GtUword count = gt_compressed_bitsequence_superblock_count(cbs, sblock,
+                                                               ones);
+    while (sample < num_of_samples &&
+           sample * cbs->select_samplerate + 1 <= count)
+      samples[sample++] = sblock;
   }
+  while (sample < num_of_samples)
+    samples[sample++] = cbs->num_of_superblocks - 1;
+}
 
-  /* search within superblock */
-  for (block_idx = containing_s_block * cbs->superblocksize;
-       block_idx < cbs->num_of_blocks;
-       block_idx++) {
-    class = gt_compressed_bitsequence_get_class(cbs, block_idx);
-    if (num <= rank_sum + (cbs->blocksize - class))
-      break;
-    blocks_offset_pos += gt_popcount_tab_offset_bits(cbs->popcount_tab, class);
-    rank_sum += cbs->blocksize - class;
+void gt_compressed_bitsequence_set_select_samplerate(
+                                                   GtCompressedBitsequence *cbs,
+                                                   GtUword samplerate)
+{
+  GtUword num_of_samples;
+  gt_assert(cbs != NULL);
+  gt_free(cbs->select_1_samples);
+  gt_free(cbs->select_0_samples);
+  cbs->select_1_samples = cbs->select_0_samples = NULL;
+  cbs->select_samplerate = samplerate;
+  if (samplerate == 0)
+    return;
+  num_of_samples = cbs->num_of_ones / samplerate + 2;
+  cbs->select_1_samples = gt_malloc(sizeof (*cbs->select_1_samples) *
+                                    num_of_samples);
+  gt_compressed_bitsequence_fill_select_samples(cbs, cbs->select_1_samples,
+                                                num_of_samples, true);
+  num_of_samples = (cbs->num_of_bits - cbs->num_of_ones) / samplerate + 2;
+  cbs->select_0_samples = gt_malloc(sizeof (*cbs->select_0_samples) *
+                                    num_of_samples);
+  gt_compressed_bitsequence_fill_select_samples(cbs, cbs->select_0_samples,
+                                                num_of_samples, false);
+}
+
+struct GtCompressedBitsequenceRunIterator {
+  GtCompressedBitsequence *cbs;
+  GtUword                  next_block,
+                           offsets_bitpos,
+                           position;
+  /* the bits of the current block not read yet, in the most significant
+     positions */
+  uint64_t                 block;
+  unsigned int             block_left;
+};
+
+static inline bool
+gt_compressed_bitsequence_run_iterator_load(
+                                       GtCompressedBitsequenceRunIterator *it);
+
+GtCompressedBitsequenceRunIterator*
+gt_compressed_bitsequence_run_iterator_new(GtCompressedBitsequence *cbs,
+                                           GtUword position)
+{
+  GtCompressedBitsequenceRunIterator *it;
+  GtUword GT_UNUSED rank_sum;
+  gt_assert(cbs != NULL && position <= cbs->num_of_bits);
+  it = gt_malloc(sizeof (*it));
+  it->cbs = cbs;
+  it->next_block = position / cbs->blocksize;
+  it->position = it->next_block * cbs->blocksize;
+  it->block = 0;
+  it->block_left = 0;
+  if (it->next_block < cbs->num_of_blocks)
+    gt_compressed_bitsequence_block_start(cbs, it->next_block, &rank_sum,
+                                          &it->offsets_bitpos);
+  /* skip the bits of the first block before <position> */
+  if (it->position < position) {
+    unsigned int skip = (unsigned int) (position - it->position);
+    GT_UNUSED bool loaded =
+      gt_compressed_bitsequence_run_iterator_load(it);
+    gt_assert(loaded && skip <= it->block_left);
+    it->block <<= skip;
+    it->block_left -= skip;
+    it->position = position;
   }
-  position = block_idx * cbs->blocksize;
-  gt_assert(class != cbs->blocksize + 1);
+  return it;
+}
+
+/* decodes the next block, returns false at the end of the sequence */
+static inline bool
+gt_compressed_bitsequence_run_iterator_load(
+                                        GtCompressedBitsequenceRunIterator *it)
+{
+  GtCompressedBitsequence *cbs = it->cbs;
+  unsigned int class, block_len;
+
+  if (it->next_block >= cbs->num_of_blocks)
+    return false;
+  block_len = it->next_block == cbs->num_of_blocks - 1 ? cbs->last_block_len
+                                                       : cbs->blocksize;
+  class = gt_compressed_bitsequence_get_class(cbs, it->next_block);
   if (class == 0)
-    position += num - rank_sum - 1;
+    it->block = 0;
+  else if (class == cbs->blocksize)
+    it->block = ~((uint64_t) 0);
   else {
-    block_offset_bits = gt_popcount_tab_offset_bits(cbs->popcount_tab, class);
-
-    /* search within block */
-    block = (uint64_t)
+    it->block = (uint64_t)
       gt_popcount_tab_get(cbs->popcount_tab, class, (GtUword)
                           gt_compressed_bitsequence_get_variable_field(
-                                              cbs->c_offsets, blocks_offset_pos,
-                                              block_offset_bits));
-    if (block_idx != cbs->num_of_blocks - 1)
-      block <<= ((sizeof (block) * CHAR_BIT) - cbs->blocksize);
-    else
-      block <<= ((sizeof (block) * CHAR_BIT) - cbs->last_block_len);
+                                                cbs->c_offsets,
+                                                it->offsets_bitpos,
+                                                cbs->offset_bits_tab[class]));
+    it->block <<= (sizeof (it->block) * CHAR_BIT) - block_len;
+  }
+  it->offsets_bitpos += cbs->offset_bits_tab[class];
+  it->block_left = block_len;
+  it->next_block++;
+  return true;
+}
+
+/* number of leading 0 bits of <w> within its first <len> bits */
+static inline unsigned int gt_compressed_bitsequence_leading_zeros(uint64_t w,
+                                                            unsigned int len)
+{
+  unsigned int zeros;
+  if (w == 0)
+    return len;
+#ifdef __GNUC__
+  zeros = (unsigned int) __builtin_clzll((unsigned long long) w);
+#else
+  for (zeros = 0; (w & ((uint64_t) 1 << 63)) == 0; w <<= 1)
+    zeros++;
+#endif
+  return MIN(zeros, len);
+}
 
-    /* invert because we search for 0 */
-    position +=
-      gt_compressed_bitsequence_select_1_word(~block,
-                                              (unsigned int) (num - rank_sum));
+bool gt_compressed_bitsequence_run_iterator_next(
+                                         GtCompressedBitsequenceRunIterator *it,
+                                         GtUword *start,
+                                         GtUword *length)
+{
+  unsigned int count;
+  gt_assert(it != NULL && start != NULL && length != NULL);
+
+  /* skip 0 bits, blocks of class 0 are skipped as a whole */
+  for (;;) {
+    if (it->block_left == 0 &&
+        !gt_compressed_bitsequence_run_iterator_load(it))
+      return false;
+    count = gt_compressed_bitsequence_leading_zeros(it->block,
+                                                    it->block_left);
+    it->position += count;
+    it->block_left -= count;
+    if (it->block_left > 0) {
+      it->block <<= count;
+      break;
+    }
+  }
+  *start = it->position;
+  *length = 0;
+  /* collect 1 bits, the run may continue in the following blocks */
+  for (;;) {
+    count = gt_compressed_bitsequence_leading_zeros(~it->block,
+                                                    it->block_left);
+    it->position += count;
+    *length += count;
+    it->block_left -= count;
+    if (it->block_left > 0) {
+      it->block <<= count;
+      break;
+    }
+    if (!gt_compressed_bitsequence_run_iterator_load(it))
+      break;
   }
+  return true;
+}
 
-  return position;
+void gt_compressed_bitsequence_run_iterator_delete(
+                                        GtCompressedBitsequenceRunIterator *it)
+{
+  gt_free(it);
+}
+
+/* tabulates the offset bits of each class and samples the positions for
+   select, both are not stored in the index file */
+static void gt_compressed_bitsequence_init_lookup(GtCompressedBitsequence *cbs)
+{
+  unsigned int class;
+  cbs->offset_bits_tab = gt_malloc(sizeof (*cbs->offset_bits_tab) *
+                                   (cbs->blocksize + 1));
+  for (class = 0; class <= cbs->blocksize; class++)
+    cbs->offset_bits_tab[class] =
+      gt_popcount_tab_offset_bits(cbs->popcount_tab, class);
+  gt_compressed_bitsequence_set_select_samplerate(
+                                              cbs,
+                                              GT_COMP_BITSEQ_SELECT_SAMPLERATE);
 }
 
 static size_t
@@ -931,8 +1097,16 @@ size_t gt_compressed_bitsequence_size(GtCompressedBitsequence *cbs)
     sizeof (cbs->c_offsets[0]) * cbs->c_offsets_size +
     sizeof (cbs->classes[0]) * cbs->classes_size +
     sizeof (cbs->superblockoffsets[0]) * cbs->superblockoffsets_size +
-    sizeof (cbs->superblockranks[0]) * cbs->superblockranks_size;
-
+    sizeof (cbs->superblockranks[0]) * cbs->superblockranks_size +
+    sizeof (cbs->offset_bits_tab[0]) * (cbs->blocksize + 1);
+
+  if (cbs->select_samplerate != 0) {
+    size += sizeof (cbs->select_1_samples[0]) *
+            (cbs->num_of_ones / cbs->select_samplerate + 2);
+    size += sizeof (cbs->select_0_samples[0]) *
+            ((cbs->num_of_bits - cbs->num_of_ones) / cbs->select_samplerate +
+             2);
+  }
   return size;
 }
 
@@ -1050,6 +1224,10 @@ gt_compressed_bitsequence_new_from_file(const char *filename,
     return NULL;
   }
   cbs->popcount_tab = gt_popcount_tab_new(cbs->blocksize);
+  cbs->num_of_ones =
+    gt_compressed_bitsequence_superblock_rank(cbs,
+                                              cbs->num_of_superblocks - 1);
+  gt_compressed_bitsequence_init_lookup(cbs);
   cbs->from_file = true;
   return cbs;
 }
@@ -1068,6 +1246,9 @@ void gt_compressed_bitsequence_delete(GtCompressedBitsequence *cbs)
       gt_free(cbs->superblockoffsets);
     }
     gt_free(cbs->cbs_bi);
+    gt_free(cbs->offset_bits_tab);
+    gt_free(cbs->select_1_samples);
+    gt_free(cbs->select_0_samples);
     gt_free(cbs);
   }
 }
@@ -1182,6 +1363,73 @@ static int gt_compressed_bitsequence_unit_test_block_identical(
   return had_err;
 }
 
+/* compares select and the run iterator with a scan of <bitseq> */
+static int gt_compressed_bitsequence_unit_test_select_runs(
+                                                          GtError *err,
+                                                          GtBitsequence *bitseq,
+                                                          GtUword num_of_bits,
+                                                          unsigned int
+                                                            samplerate)
+{
+  int had_err = 0;
+  const GtUword select_samplerates[] = {0, 1UL, 7UL, 100UL,
+                                        GT_COMP_BITSEQ_SELECT_SAMPLERATE};
+  GtUword idx, ones = 0, zeros = 0, start, length, run_end, pos;
+  GtCompressedBitsequence *cbs;
+  GtCompressedBitsequenceRunIterator *it;
+  size_t rate;
+
+  cbs = gt_compressed_bitsequence_new(bitseq, samplerate, num_of_bits);
+  for (rate = 0;
+       !had_err && rate < sizeof (select_samplerates) /
+                          sizeof (select_samplerates[0]);
+       rate++) {
+    gt_compressed_bitsequence_set_select_samplerate(cbs,
+                                                    select_samplerates[rate]);
+    ones = zeros = 0;
+    for (idx = 0; !had_err && idx < num_of_bits; idx++) {
+      if (GT_ISIBITSET(bitseq, idx)) {
+        ones++;
+        if (ones < num_of_bits)
+          gt_ensure(gt_compressed_bitsequence_select_1(cbs, ones) == idx);
+      }
+      else {
+        zeros++;
+        if (zeros < num_of_bits)
+          gt_ensure(gt_compressed_bitsequence_select_0(cbs, zeros) == idx);
+      }
+    }
+    if (!had_err && ones + 1 < num_of_bits)
+      gt_ensure(gt_compressed_bitsequence_select_1(cbs, ones + 1) ==
+                num_of_bits);
+    if (!had_err && zeros + 1 < num_of_bits)
+      gt_ensure(gt_compressed_bitsequence_select_0(cbs, zeros + 1) ==
+                num_of_bits);
+  }
+  /* the runs have to cover exactly the 1 bits, starting anywhere */
+  for (pos = 0; !had_err && pos <= num_of_bits; pos += 1 + pos / 3) {
+    it = gt_compressed_bitsequence_run_iterator_new(cbs, pos);
+    run_end = pos;
+    while (!had_err &&
+           gt_compressed_bitsequence_run_iterator_next(it, &start, &length)) {
+      gt_ensure(length > 0 && start >= run_end);
+      gt_ensure(start + length <= num_of_bits);
+      for (idx = run_end; !had_err && idx < start; idx++)
+        gt_ensure(!GT_ISIBITSET(bitseq, idx));
+      for (idx = start; !had_err && idx < start + length; idx++)
+        gt_ensure(GT_ISIBITSET(bitseq, idx));
+      if (!had_err && start + length < num_of_bits)
+        gt_ensure(!GT_ISIBITSET(bitseq, start + length));
+      run_end = start + length;
+    }
+    for (idx = run_end; !had_err && idx < num_of_bits; idx++)
+      gt_ensure(!GT_ISIBITSET(bitseq, idx));
+    gt_compressed_bitsequence_run_iterator_delete(it);
+  }
+  gt_compressed_bitsequence_delete(cbs);
+  return had_err;
+}
+
 int gt_compressed_bitsequence_unit_test(GtError *err)
 {
   const unsigned int sample_testratio = 32U;
@@ -1282,6 +1530,28 @@ int gt_compressed_bitsequence_unit_test(GtError *err)
     gt_compressed_bitsequence_delete(cbs);
   }
 
+  /* random bits of varying density, including long runs */
+  if (!had_err) {
+    const GtUword densities[] = {0, 3UL, 50UL, 97UL, 100UL},
+                  sizes[] = {1UL, 15UL, 16UL, 1000UL, cbs_testsize};
+    size_t d, sz;
+    for (d = 0;
+         !had_err && d < sizeof (densities) / sizeof (densities[0]);
+         d++) {
+      for (sz = 0; !had_err && sz < sizeof (sizes) / sizeof (sizes[0]);
+           sz++) {
+        memset(bitseq, 0, (size_t) bitseq_testsize * sizeof (*bitseq));
+        for (idx = 0; idx < sizes[sz]; idx++) {
+          if (gt_rand_max(99UL) < densities[d])
+            GT_SETIBIT(bitseq, idx);
+        }
+        had_err = gt_compressed_bitsequence_unit_test_select_runs(
+                                     err, bitseq, sizes[sz],
+                                     d % 2 == 0 ? sample_testratio : 3U);
+      }
+    }
+  }
+
   gt_free(bitseq);
 
   return had_err;
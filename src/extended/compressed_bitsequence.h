@@ -18,6 +18,8 @@
 #ifndef COMPRESSED_BITSEQUENCE_H
 #define COMPRESSED_BITSEQUENCE_H
 
+#include <stdbool.h>
+
 #include "core/error_api.h"
 #include "core/intbits.h"
 #include "core/mapspec.h"
@@ -69,6 +71,40 @@ GtUword                  gt_compressed_bitsequence_select_0(
                                                    GtCompressedBitsequence *cbs,
                                                    GtUword num);
 
+/* Sets the sampling of <cbs> used by select: the superblocks containing every
+   <samplerate>th 1 and 0 bit are stored, so that select only searches the
+   superblocks between two samples. A <samplerate> of 0 disables the sampling,
+   the default is to sample every 1024th bit. The samples are not stored in the
+   file written by <gt_compressed_bitsequence_write()>. */
+void                     gt_compressed_bitsequence_set_select_samplerate(
+                                                   GtCompressedBitsequence *cbs,
+                                                   GtUword samplerate);
+
+/* The <GtCompressedBitsequenceRunIterator> class iterates over the maximal runs
+   of 1 bits in a <GtCompressedBitsequence>. It decodes the blocks one after
+   another and skips blocks without 1 bits as a whole, which is much faster than
+   repeated access or select calls. */
+typedef struct GtCompressedBitsequenceRunIterator
+  GtCompressedBitsequenceRunIterator;
+
+/* Returns a new <GtCompressedBitsequenceRunIterator> for the bits of <cbs>
+   starting at <position>. */
+GtCompressedBitsequenceRunIterator*
+                         gt_compressed_bitsequence_run_iterator_new(
+                                                   GtCompressedBitsequence *cbs,
+                                                   GtUword position);
+
+/* Stores the start position and the length of the next run of 1 bits of <it>
+   in <start> and <length>. Returns false if there is no further run. */
+bool                     gt_compressed_bitsequence_run_iterator_next(
+                                         GtCompressedBitsequenceRunIterator *it,
+                                         GtUword *start,
+                                         GtUword *length);
+
+/* Frees the memory of <it>. */
+void                     gt_compressed_bitsequence_run_iterator_delete(
+                                        GtCompressedBitsequenceRunIterator *it);
+
 size_t                   gt_compressed_bitsequence_file_size(
                                                   GtCompressedBitsequence *cbs);
 
@@ -17,6 +17,7 @@
 
 #include <ctype.h>
 #include <string.h>
+#include "core/array_api.h"
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #include "core/ma.h"
@@ -653,6 +654,153 @@ static GtUword evaluateallDBtabcolumns(GtLinspaceManagement *spacemanager,
   return Rtabcolumn[high_row-low_row];
 }
 
+/* The subproblems of one recursion level of <evaluateDBcrosspoints> are
+   collected as jobs before any of them is solved. They only share the
+   entries of <Diagcolumn> at their borders, which are either restored after
+   solving a subproblem or overwritten by the subproblem left of it.
+   Therefore they can be solved in parallel on private copies of their part
+   of <Diagcolumn>, which are copied back in the original order. */
+typedef struct
+{
+  GtDiagAlignentry     *Diagcolumn,
+                       *privatecolumn, /* used if solved by a thread */
+                       *cpointentry,   /* restore lastcpoint of this entry */
+                        firstentry;
+  const GtScoreHandler *scorehandler;
+  const GtUchar        *useq,
+                       *vseq;
+  LinearAlignEdge       edge;
+  GtUword               rowoffset,
+                        coloffset,
+                        ustart,
+                        ulen,
+                        vstart,
+                        vlen,
+                        lastcpoint;
+  GtWord                left_dist,
+                        right_dist;
+  bool                  restorefirst;
+} GtDBcrosspointjob;
+
+static GtDBcrosspointjob *add_DBcrosspointjob(GtArray *jobs,
+                                              GtDiagAlignentry *Diagcolumn,
+                                              const GtScoreHandler
+                                              *scorehandler,
+                                              LinearAlignEdge edge,
+                                              GtUword rowoffset,
+                                              GtUword coloffset,
+                                              const GtUchar *useq,
+                                              GtUword ustart,
+                                              GtUword ulen,
+                                              const GtUchar *vseq,
+                                              GtUword vstart,
+                                              GtUword vlen,
+                                              GtWord left_dist,
+                                              GtWord right_dist)
+{
+  GtDBcrosspointjob job;
+
+  job.Diagcolumn = Diagcolumn;
+  job.privatecolumn = NULL;
+  job.cpointentry = NULL;
+  job.firstentry = Diagcolumn[0];
+  job.scorehandler = scorehandler;
+  job.useq = useq;
+  job.vseq = vseq;
+  job.edge = edge;
+  job.rowoffset = rowoffset;
+  job.coloffset = coloffset;
+  job.ustart = ustart;
+  job.ulen = ulen;
+  job.vstart = vstart;
+  job.vlen = vlen;
+  job.lastcpoint = GT_UWORD_MAX;
+  job.left_dist = left_dist;
+  job.right_dist = right_dist;
+  job.restorefirst = false;
+  gt_array_add(jobs, job);
+  return gt_array_get_last(jobs);
+}
+
+static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
+                                  GtDiagAlignentry *Diagcolumn,
+                                  const GtScoreHandler *scorehandler,
+                                  LinearAlignEdge edge,
+                                  GtUword rowoffset,
+                                  GtUword coloffset,
+                                  const GtUchar *useq,
+                                  GtUword ustart,
+                                  GtUword ulen,
+                                  const GtUchar *vseq,
+                                  GtUword vstart,
+                                  GtUword vlen,
+                                  GtWord left_dist,
+                                  GtWord right_dist);
+
+static void solve_DBcrosspointjob(GtLinspaceManagement *spacemanager,
+                                  void *data)
+{
+  GtDBcrosspointjob *job = data;
+
+  evaluateDBcrosspoints(spacemanager,
+                        job->privatecolumn != NULL ? job->privatecolumn
+                                                   : job->Diagcolumn,
+                        job->scorehandler, job->edge,
+                        job->rowoffset, job->coloffset,
+                        job->useq, job->ustart, job->ulen,
+                        job->vseq, job->vstart, job->vlen,
+                        job->left_dist, job->right_dist);
+}
+
+static void finish_DBcrosspointjob(GtDBcrosspointjob *job)
+{
+  if (job->restorefirst)
+    job->Diagcolumn[0] = job->firstentry;
+  if (job->cpointentry != NULL)
+    job->cpointentry->lastcpoint = job->lastcpoint;
+}
+
+static void run_DBcrosspointjobs(GtLinspaceManagement *spacemanager,
+                                 GtArray *jobs)
+{
+  GtDBcrosspointjob *job = gt_array_get_space(jobs);
+  GtDiagAlignentry *privatespace;
+  GtUword idx, offset, numofjobs = gt_array_size(jobs), numofthreads = 0;
+
+  if (numofjobs > 1UL)
+    numofthreads = gt_linspace_management_reserve_threads(spacemanager,
+                                                          numofjobs - 1);
+  if (numofthreads == 0)
+  {
+    for (idx = 0; idx < numofjobs; idx++)
+    {
+      solve_DBcrosspointjob(spacemanager, job + idx);
+      finish_DBcrosspointjob(job + idx);
+    }
+    return;
+  }
+  for (offset = 0, idx = 0; idx < numofjobs; idx++)
+    offset += job[idx].vlen + 1;
+  privatespace = gt_malloc(sizeof (*privatespace) * offset);
+  for (offset = 0, idx = 0; idx < numofjobs; idx++)
+  {
+    job[idx].privatecolumn = privatespace + offset;
+    memcpy(job[idx].privatecolumn, job[idx].Diagcolumn,
+           sizeof (*privatespace) * (job[idx].vlen + 1));
+    offset += job[idx].vlen + 1;
+  }
+  gt_linspace_management_run_jobs(spacemanager, numofthreads, job,
+                                  sizeof (*job), numofjobs,
+                                  solve_DBcrosspointjob);
+  for (idx = 0; idx < numofjobs; idx++)
+  {
+    memcpy(job[idx].Diagcolumn, job[idx].privatecolumn,
+           sizeof (*privatespace) * (job[idx].vlen + 1));
+    finish_DBcrosspointjob(job + idx);
+  }
+  gt_free(privatespace);
+}
+
 /* calculate crosspoint realting to diagonal in recursive way */
 static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
                                   GtDiagAlignentry *Diagcolumn,
@@ -669,9 +817,10 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
                                   GtWord left_dist,
                                   GtWord right_dist)
 {
-  GtUword idx, prevcpoint, cpoint, ctemp, new_ulen;
+  GtUword idx, prevcpoint, cpoint, new_ulen;
   GtWord new_left, new_right, diag = GT_DIV2(left_dist+right_dist);
-  GtDiagAlignentry dtemp;
+  GtArray *jobs;
+  GtDBcrosspointjob *job = NULL;
 
   if (ulen == 0)
   {
@@ -729,25 +878,24 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
     }
   }
 
+  jobs = gt_array_new(sizeof (GtDBcrosspointjob));
   /* exception, if last crosspoint != (m+1)entry, bottom right corner */
   if (cpoint != vlen)
   {
     if (diag + ((GtWord)ulen-(GtWord)vlen) > 0)
     {
-      dtemp = Diagcolumn[cpoint];
       new_left = MAX((GtWord)left_dist-diag+1,
                     -((GtWord)ulen-((GtWord)Diagcolumn[cpoint].currentrowindex+1
                     -(GtWord)rowoffset)));
       new_right = 0;
       new_ulen =  ulen - (Diagcolumn[cpoint].currentrowindex+1-rowoffset);
-      evaluateDBcrosspoints(spacemanager, Diagcolumn+cpoint, scorehandler,
-                            Linear_D, Diagcolumn[cpoint].currentrowindex+1,
-                            coloffset+cpoint, useq,
-                            Diagcolumn[cpoint].currentrowindex+1, new_ulen,
-                            vseq, vstart+cpoint, vlen-cpoint,
-                            new_left, new_right);
-
-    Diagcolumn[cpoint] = dtemp;
+      job = add_DBcrosspointjob(jobs, Diagcolumn+cpoint, scorehandler,
+                                Linear_D, Diagcolumn[cpoint].currentrowindex+1,
+                                coloffset+cpoint, useq,
+                                Diagcolumn[cpoint].currentrowindex+1, new_ulen,
+                                vseq, vstart+cpoint, vlen-cpoint,
+                                new_left, new_right);
+      job->restorefirst = true;
     }
     else
     {
@@ -755,12 +903,12 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
       new_right =  MIN((GtWord)right_dist-((GtWord)diag)-1,
                       ((GtWord)vlen-(GtWord)cpoint-1));
       new_ulen = ulen - (Diagcolumn[cpoint].currentrowindex-rowoffset);
-      evaluateDBcrosspoints(spacemanager,Diagcolumn+cpoint+1,scorehandler,
-                            Linear_I, Diagcolumn[cpoint].currentrowindex,
-                            coloffset+cpoint+1, useq,
-                            Diagcolumn[cpoint].currentrowindex, new_ulen,
-                            vseq, vstart+cpoint+1, vlen-cpoint-1,
-                            new_left, new_right);
+      (void) add_DBcrosspointjob(jobs, Diagcolumn+cpoint+1, scorehandler,
+                                 Linear_I, Diagcolumn[cpoint].currentrowindex,
+                                 coloffset+cpoint+1, useq,
+                                 Diagcolumn[cpoint].currentrowindex, new_ulen,
+                                 vseq, vstart+cpoint+1, vlen-cpoint-1,
+                                 new_left, new_right);
     }
   }
 
@@ -773,7 +921,6 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
       break;
 
     cpoint = Diagcolumn[cpoint].lastcpoint;
-    ctemp =  Diagcolumn[cpoint].lastcpoint;
     if (Diagcolumn[prevcpoint].last_type == Linear_R ||
        ((Diagcolumn[prevcpoint].last_type == Linear_I) &&
        (prevcpoint-cpoint == 1)))
@@ -788,7 +935,7 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
       new_ulen = Diagcolumn[prevcpoint].currentrowindex-
                  Diagcolumn[cpoint].currentrowindex-1;
 
-      evaluateDBcrosspoints(spacemanager,Diagcolumn+cpoint+1,scorehandler,
+      job = add_DBcrosspointjob(jobs, Diagcolumn+cpoint+1, scorehandler,
                    Linear_I, Diagcolumn[cpoint].currentrowindex,
                    coloffset+cpoint+1, useq, Diagcolumn[cpoint].currentrowindex,
                    new_ulen, vseq, vstart + cpoint+1, prevcpoint-cpoint-1,
@@ -796,26 +943,26 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
     }
     else if (Diagcolumn[prevcpoint].last_type == Linear_I)
     {
-      dtemp = Diagcolumn[cpoint];
       new_ulen = Diagcolumn[prevcpoint].currentrowindex-
                  Diagcolumn[cpoint].currentrowindex-1;
       new_left = MAX(left_dist-diag+1,-new_ulen);
       new_right = 0;
 
-      evaluateDBcrosspoints(spacemanager,Diagcolumn+cpoint,scorehandler,
-                            Linear_D, Diagcolumn[cpoint].currentrowindex+1,
-                            coloffset+cpoint, useq,
-                            Diagcolumn[cpoint].currentrowindex+1, new_ulen,
-                            vseq, vstart + cpoint, prevcpoint-1-cpoint,
-                            new_left, new_right);
-      Diagcolumn[cpoint] = dtemp;
+      job = add_DBcrosspointjob(jobs, Diagcolumn+cpoint, scorehandler,
+                                Linear_D, Diagcolumn[cpoint].currentrowindex+1,
+                                coloffset+cpoint, useq,
+                                Diagcolumn[cpoint].currentrowindex+1, new_ulen,
+                                vseq, vstart + cpoint, prevcpoint-1-cpoint,
+                                new_left, new_right);
+      job->restorefirst = true;
     }
     else
     {
       /* if (Diagcolumn[cpoint].last_type == Linear_X), never reach this line */
       gt_assert(false);
     }
-    Diagcolumn[cpoint].lastcpoint  = ctemp;
+    job->cpointentry = Diagcolumn + cpoint;
+    job->lastcpoint = Diagcolumn[cpoint].lastcpoint;
   }
 
   /* exception, if first crosspoint != 0-entry, upper left corner */
@@ -827,11 +974,11 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
       new_left =  MAX(diag, -new_ulen);
       new_right = MIN(right_dist, (GtWord)cpoint);
 
-      evaluateDBcrosspoints(spacemanager, Diagcolumn, scorehandler,
-                            edge, rowoffset, coloffset,
-                            useq, ustart, new_ulen,
-                            vseq, vstart, cpoint,
-                            new_left, new_right);
+      (void) add_DBcrosspointjob(jobs, Diagcolumn, scorehandler,
+                                 edge, rowoffset, coloffset,
+                                 useq, ustart, new_ulen,
+                                 vseq, vstart, cpoint,
+                                 new_left, new_right);
 
     }
     else if (Diagcolumn[cpoint].last_type == Linear_I)
@@ -839,11 +986,11 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
       new_left = MAX(left_dist,
                  -((GtWord)Diagcolumn[cpoint].currentrowindex-(GtWord)ustart));
       new_right = MIN((GtWord)cpoint-1, diag);
-      evaluateDBcrosspoints(spacemanager, Diagcolumn, scorehandler,
-                            edge, rowoffset, coloffset, useq, ustart,
-                            Diagcolumn[cpoint].currentrowindex-ustart,
-                            vseq, vstart, cpoint-1,
-                            new_left, new_right);
+      (void) add_DBcrosspointjob(jobs, Diagcolumn, scorehandler,
+                                 edge, rowoffset, coloffset, useq, ustart,
+                                 Diagcolumn[cpoint].currentrowindex-ustart,
+                                 vseq, vstart, cpoint-1,
+                                 new_left, new_right);
     }
     else if (Diagcolumn[cpoint].last_type == Linear_R ||
              Diagcolumn[cpoint].last_type  == Linear_X)
@@ -852,6 +999,8 @@ static void evaluateDBcrosspoints(GtLinspaceManagement *spacemanager,
                            it have to be 0-entry */
     }
   }
+  run_DBcrosspointjobs(spacemanager, jobs);
+  gt_array_delete(jobs);
 }
 
 /* calculating alignment in linear space within a specified diagonal band */
@@ -17,6 +17,7 @@
 
 #include <ctype.h>
 #include <string.h>
+#include "core/array_api.h"
 #include "core/array2dim_api.h"
 #include "core/minmax.h"
 #include "core/types_api.h"
@@ -1019,6 +1020,227 @@ static GtAffineAlignRnode evaluateallaffineDBcolumns(
 }
 
 /* calculate affine crosspoint realting to diagonal in recursive way */
+/* The subproblems of one recursion level of <evaluateaffineDBcrosspoints> are
+   collected as jobs before any of them is solved and can be solved in
+   parallel on private copies of their part of <Diagcolumn>, like in the case
+   of linear gap costs. The updates of the entries at their borders and of
+   the last crosspoint depend on the results of the subproblems and are
+   applied afterwards in the original order. */
+typedef enum {
+  AFFINE_DB_BOTTOMRIGHT_D,
+  AFFINE_DB_BOTTOMRIGHT_I,
+  AFFINE_DB_SEGMENT_D,
+  AFFINE_DB_SEGMENT_I,
+  AFFINE_DB_UPPERLEFT_D,
+  AFFINE_DB_UPPERLEFT_I
+} GtAffineDBcrosspointjobtype;
+
+typedef struct
+{
+  GtAffineDBcrosspointjobtype type;
+  GtAffineDiagAlignentry *Diagcolumn,
+                         *privatecolumn, /* used if solved by a thread */
+                          firstentry;
+  const GtScoreHandler   *scorehandler;
+  const GtUchar          *useq,
+                         *vseq;
+  GtAffineAlignEdge       edge,
+                          from_edge,
+                          to_edge,
+                          cp_type;
+  GtUword                 rowoffset,
+                          coloffset,
+                          ustart,
+                          ulen,
+                          vstart,
+                          vlen,
+                          col_start,
+                          col_end;
+  GtWord                  left_dist,
+                          right_dist;
+  GtAffineAlignRnode      rpoint;
+} GtAffineDBcrosspointjob;
+
+static GtAffineDBcrosspointjob *add_affineDBcrosspointjob(GtArray *jobs,
+                                             GtAffineDBcrosspointjobtype type,
+                                             GtAffineDiagAlignentry *Diagcolumn,
+                                             const GtScoreHandler *scorehandler,
+                                             GtAffineAlignEdge edge,
+                                             GtAffineAlignEdge from_edge,
+                                             GtAffineAlignEdge to_edge,
+                                             GtUword rowoffset,
+                                             GtUword coloffset,
+                                             const GtUchar *useq,
+                                             GtUword ustart,
+                                             GtUword ulen,
+                                             const GtUchar *vseq,
+                                             GtUword vstart,
+                                             GtUword vlen,
+                                             GtWord left_dist,
+                                             GtWord right_dist)
+{
+  GtAffineDBcrosspointjob job;
+
+  job.type = type;
+  job.Diagcolumn = Diagcolumn;
+  job.privatecolumn = NULL;
+  job.firstentry = Diagcolumn[0];
+  job.scorehandler = scorehandler;
+  job.useq = useq;
+  job.vseq = vseq;
+  job.edge = edge;
+  job.from_edge = from_edge;
+  job.to_edge = to_edge;
+  job.cp_type = Affine_X;
+  job.rowoffset = rowoffset;
+  job.coloffset = coloffset;
+  job.ustart = ustart;
+  job.ulen = ulen;
+  job.vstart = vstart;
+  job.vlen = vlen;
+  job.col_start = job.col_end = 0;
+  job.left_dist = left_dist;
+  job.right_dist = right_dist;
+  job.rpoint = (GtAffineAlignRnode) {GT_UWORD_MAX, Affine_X};
+  gt_array_add(jobs, job);
+  return gt_array_get_last(jobs);
+}
+
+static GtAffineAlignRnode evaluateaffineDBcrosspoints(
+                                             GtLinspaceManagement *spacemanager,
+                                             GtAffineDiagAlignentry *Diagcolumn,
+                                             const GtScoreHandler *scorehandler,
+                                             GtAffineAlignEdge edge,
+                                             GtAffineAlignEdge from_edge,
+                                             GtAffineAlignEdge to_edge,
+                                             GtUword rowoffset,
+                                             GtUword coloffset,
+                                             const GtUchar *useq,
+                                             GtUword ustart,
+                                             GtUword ulen,
+                                             const GtUchar *vseq,
+                                             GtUword vstart,
+                                             GtUword vlen,
+                                             GtWord left_dist,
+                                             GtWord right_dist);
+
+static void solve_affineDBcrosspointjob(GtLinspaceManagement *spacemanager,
+                                        void *data)
+{
+  GtAffineDBcrosspointjob *job = data;
+
+  job->rpoint = evaluateaffineDBcrosspoints(spacemanager,
+                                            job->privatecolumn != NULL
+                                            ? job->privatecolumn
+                                            : job->Diagcolumn,
+                                            job->scorehandler, job->edge,
+                                            job->from_edge, job->to_edge,
+                                            job->rowoffset, job->coloffset,
+                                            job->useq, job->ustart, job->ulen,
+                                            job->vseq, job->vstart, job->vlen,
+                                            job->left_dist, job->right_dist);
+}
+
+static inline void set_last_type_of_Diagentry(GtAffineDiagAlignentry *entry,
+                                              GtAffineAlignEdge edge)
+{
+  entry->val_R.last_type = edge;
+  entry->val_D.last_type = edge;
+  entry->val_I.last_type = edge;
+}
+
+static void finish_affineDBcrosspointjob(const GtAffineDBcrosspointjob *job,
+                                         GtAffineDiagAlignentry *Diagcolumn,
+                                         GtUword vlen,
+                                         GtAffineAlignRnode *lastrpoint)
+{
+  GtUword col_start = job->col_start;
+  GtAffineAlignRnode rpoint = job->rpoint;
+
+  switch (job->type) {
+    case AFFINE_DB_BOTTOMRIGHT_D:
+      Diagcolumn[col_start] = job->firstentry;
+      set_last_type_of_Diagentry(Diagcolumn + col_start + 1, job->cp_type);
+      *lastrpoint = rpoint;
+      lastrpoint->idx += col_start;
+      break;
+    case AFFINE_DB_BOTTOMRIGHT_I:
+      *lastrpoint = rpoint;
+      lastrpoint->idx += col_start + 1;
+      break;
+    case AFFINE_DB_SEGMENT_D:
+      if (rpoint.idx + col_start + 1 < vlen)
+      {
+        set_last_type_of_Diagentry(Diagcolumn + rpoint.idx + col_start + 2,
+                                   rpoint.edge);
+      }
+      if (rpoint.idx + col_start + 1 == lastrpoint->idx)
+      {
+        *lastrpoint = rpoint;
+        lastrpoint->idx += col_start + 1;
+      }
+      break;
+    case AFFINE_DB_SEGMENT_I:
+      Diagcolumn[col_start] = job->firstentry;
+      set_last_type_of_Diagentry(Diagcolumn + col_start + 1, job->cp_type);
+      Diagcolumn[job->col_end].val_I.last_type = rpoint.edge;
+      break;
+    case AFFINE_DB_UPPERLEFT_D:
+      if (col_start + 1 <= vlen)
+        set_last_type_of_Diagentry(Diagcolumn + col_start + 1, rpoint.edge);
+      if (rpoint.idx == lastrpoint->idx)
+        *lastrpoint = rpoint;
+      break;
+    default:
+      gt_assert(job->type == AFFINE_DB_UPPERLEFT_I);
+      Diagcolumn[col_start].val_I.last_type = rpoint.edge;
+  }
+}
+
+static void run_affineDBcrosspointjobs(GtLinspaceManagement *spacemanager,
+                                       GtArray *jobs,
+                                       GtAffineDiagAlignentry *Diagcolumn,
+                                       GtUword vlen,
+                                       GtAffineAlignRnode *lastrpoint)
+{
+  GtAffineDBcrosspointjob *job = gt_array_get_space(jobs);
+  GtAffineDiagAlignentry *privatespace;
+  GtUword idx, offset, numofjobs = gt_array_size(jobs), numofthreads = 0;
+
+  if (numofjobs > 1UL)
+    numofthreads = gt_linspace_management_reserve_threads(spacemanager,
+                                                          numofjobs - 1);
+  if (numofthreads == 0)
+  {
+    for (idx = 0; idx < numofjobs; idx++)
+    {
+      solve_affineDBcrosspointjob(spacemanager, job + idx);
+      finish_affineDBcrosspointjob(job + idx, Diagcolumn, vlen, lastrpoint);
+    }
+    return;
+  }
+  for (offset = 0, idx = 0; idx < numofjobs; idx++)
+    offset += job[idx].vlen + 1;
+  privatespace = gt_malloc(sizeof (*privatespace) * offset);
+  for (offset = 0, idx = 0; idx < numofjobs; idx++)
+  {
+    job[idx].privatecolumn = privatespace + offset;
+    memcpy(job[idx].privatecolumn, job[idx].Diagcolumn,
+           sizeof (*privatespace) * (job[idx].vlen + 1));
+    offset += job[idx].vlen + 1;
+  }
+  gt_linspace_management_run_jobs(spacemanager, numofthreads, job,
+                                  sizeof (*job), numofjobs,
+                                  solve_affineDBcrosspointjob);
+  for (idx = 0; idx < numofjobs; idx++)
+  {
+    memcpy(job[idx].Diagcolumn, job[idx].privatecolumn,
+           sizeof (*privatespace) * (job[idx].vlen + 1));
+    finish_affineDBcrosspointjob(job + idx, Diagcolumn, vlen, lastrpoint);
+  }
+  gt_free(privatespace);
+}
+
 static GtAffineAlignRnode evaluateaffineDBcrosspoints(
                                              GtLinspaceManagement *spacemanager,
                                              GtAffineDiagAlignentry *Diagcolumn,
@@ -1041,9 +1263,10 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
           row_start = 0, row_end;
   GtWord new_left, new_right, diag;
   GtDiagAlignentry cpoint = {0,0,0}, prevcpoint;
-  GtAffineDiagAlignentry temp_entry;
-  GtAffineAlignRnode rpoint, temprpoint, lastrpoint;
+  GtAffineAlignRnode rpoint, lastrpoint;
   GtAffineAlignEdge prevcp_type,cp_type;
+  GtArray *jobs;
+  GtAffineDBcrosspointjob *job = NULL;
 
   diag = GT_DIV2(left_dist+right_dist);
   gt_assert(vstart == coloffset);
@@ -1183,6 +1406,7 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
     }
   }
 
+  jobs = gt_array_new(sizeof (GtAffineDBcrosspointjob));
   /* exception, if last cpoint != (m+1)entry */
   if (col_start != vlen)
   {
@@ -1193,19 +1417,12 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
       new_left = MAX((GtWord)left_dist-diag+1,
                     -(GtWord)new_ulen);
       new_right = 0;
-      temp_entry = Diagcolumn[col_start];
-      lastrpoint = evaluateaffineDBcrosspoints(spacemanager,
+      job = add_affineDBcrosspointjob(jobs, AFFINE_DB_BOTTOMRIGHT_D,
                       Diagcolumn+col_start, scorehandler, Affine_D,
                       cpoint.last_type, to_edge,
                       row_start+1, coloffset+col_start, useq,
                       row_start+1, new_ulen, vseq,
                       vstart+col_start, new_vlen, new_left, new_right);
-      Diagcolumn[col_start] = temp_entry;
-      Diagcolumn[col_start+1].val_R.last_type = cp_type;
-      Diagcolumn[col_start+1].val_D.last_type = cp_type;
-      Diagcolumn[col_start+1].val_I.last_type = cp_type;
-
-      lastrpoint.idx += col_start;
     }
     else
     {
@@ -1214,13 +1431,14 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
       new_left = -1;
       new_right = MIN((GtWord)right_dist-((GtWord)diag)-1,new_vlen);
 
-      lastrpoint = evaluateaffineDBcrosspoints(spacemanager,
+      job = add_affineDBcrosspointjob(jobs, AFFINE_DB_BOTTOMRIGHT_I,
                             Diagcolumn+col_start+1,scorehandler, Affine_I,
                             cp_type, to_edge, row_start, coloffset+col_start+1,
                             useq, row_start, new_ulen, vseq, vstart+col_start+1,
                             new_vlen, new_left, new_right);
-      lastrpoint.idx += (col_start+1);
     }
+    job->col_start = col_start;
+    job->cp_type = cp_type;
   }
   /* look at all 'normally' crosspoints */
   while (cpoint.lastcpoint != GT_UWORD_MAX)
@@ -1261,24 +1479,12 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
       new_left = -1;
       new_right = MIN(right_dist-diag-1,new_vlen);
 
-      temprpoint = evaluateaffineDBcrosspoints(spacemanager,
+      job = add_affineDBcrosspointjob(jobs, AFFINE_DB_SEGMENT_D,
                            Diagcolumn+col_start+1, scorehandler,
                            Affine_I, cp_type, Affine_D, row_start,
                            coloffset + col_start + 1, useq, row_start,
                            new_ulen, vseq, vstart + col_start + 1,
                            new_vlen, new_left, new_right);
-      if (temprpoint.idx + col_start + 1 < vlen)
-      {
-        GtUword update_idx = temprpoint.idx+1+col_start+1;
-        Diagcolumn[update_idx].val_R.last_type = temprpoint.edge;
-        Diagcolumn[update_idx].val_D.last_type = temprpoint.edge;
-        Diagcolumn[update_idx].val_I.last_type = temprpoint.edge;
-      }
-      if (temprpoint.idx + col_start + 1 == lastrpoint.idx)
-      {
-        lastrpoint = temprpoint;
-        lastrpoint.idx += col_start + 1;
-      }
     }
     else if (prevcp_type == Affine_I)
     {
@@ -1286,25 +1492,22 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
       new_left = MAX(left_dist-diag+1,
                         -(GtWord)new_ulen);
       new_right = 0;
-      temp_entry = Diagcolumn[col_start];
-      temprpoint = evaluateaffineDBcrosspoints(spacemanager,
+      job = add_affineDBcrosspointjob(jobs, AFFINE_DB_SEGMENT_I,
                             Diagcolumn + col_start, scorehandler,
                             Affine_D, cpoint.last_type, Affine_I, row_start + 1,
                             coloffset + col_start,
                             useq, row_start+1, new_ulen,
                             vseq, vstart+col_start, col_end-col_start-1,
                             new_left, new_right);
-      Diagcolumn[col_start] = temp_entry;
-      Diagcolumn[col_start+1].val_R.last_type = cp_type;
-      Diagcolumn[col_start+1].val_D.last_type = cp_type;
-      Diagcolumn[col_start+1].val_I.last_type = cp_type;
-      Diagcolumn[col_end].val_I.last_type = temprpoint.edge;
     }
     else
     {
       /* if (Diagcolumn[cpoint].last_type == Linear_X), never reach this line */
       gt_assert(false);
     }
+    job->col_start = col_start;
+    job->col_end = col_end;
+    job->cp_type = cp_type;
   }
   col_end = col_start;
   row_end = row_start;
@@ -1319,19 +1522,11 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
        new_left =  MAX(-new_ulen, diag);
        new_right = MIN(right_dist, (GtWord)col_end);
 
-       rpoint = evaluateaffineDBcrosspoints(spacemanager, Diagcolumn,
+       job = add_affineDBcrosspointjob(jobs, AFFINE_DB_UPPERLEFT_D, Diagcolumn,
                                         scorehandler, edge, from_edge,Affine_D,
                                         rowoffset,coloffset, useq, ustart,
                                         new_ulen, vseq, vstart, col_end,
                                         new_left, new_right);
-       if (col_start + 1 <= vlen)
-       {
-         Diagcolumn[col_start+1].val_R.last_type = rpoint.edge;
-         Diagcolumn[col_start+1].val_D.last_type = rpoint.edge;
-         Diagcolumn[col_start+1].val_I.last_type = rpoint.edge;
-       }
-       if (rpoint.idx == lastrpoint.idx)
-         lastrpoint = rpoint;
        break;
      case Affine_I:
        new_ulen = row_end-ustart;
@@ -1340,25 +1535,27 @@ static GtAffineAlignRnode evaluateaffineDBcrosspoints(
                  -(GtWord)new_ulen);
 
        new_right = MIN(diag,new_vlen);
-       rpoint = evaluateaffineDBcrosspoints(spacemanager, Diagcolumn,
+       job = add_affineDBcrosspointjob(jobs, AFFINE_DB_UPPERLEFT_I, Diagcolumn,
                                scorehandler,edge, from_edge, Affine_I,rowoffset,
                                coloffset, useq, ustart, new_ulen, vseq, vstart,
                                new_vlen, new_left, new_right);
-
-       Diagcolumn[col_start].val_I.last_type = rpoint.edge;
        break;
      default:
        gt_assert(false);
      }
+     job->col_start = col_start;
    }
-   else if (cp_type == Affine_D)
-   {
-     Diagcolumn[1].val_I.last_type = Affine_R;
-     Diagcolumn[1].val_D.last_type = Affine_R;
-     Diagcolumn[1].val_R.last_type = Affine_R;
-     Diagcolumn[0].val_R.currentrowindex = rowoffset;
-     Diagcolumn[0].val_R.last_type = from_edge;
-   }
+  run_affineDBcrosspointjobs(spacemanager, jobs, Diagcolumn, vlen,
+                             &lastrpoint);
+  gt_array_delete(jobs);
+  if (vstart-coloffset == col_end && cp_type == Affine_D)
+  {
+    Diagcolumn[1].val_I.last_type = Affine_R;
+    Diagcolumn[1].val_D.last_type = Affine_R;
+    Diagcolumn[1].val_R.last_type = Affine_R;
+    Diagcolumn[0].val_R.currentrowindex = rowoffset;
+    Diagcolumn[0].val_R.last_type = from_edge;
+  }
   return lastrpoint;
 }
 
@@ -1231,6 +1231,11 @@ static int encdesc_next_desc(GtEncdesc *encdesc, GtStr *desc, GtError *err)
     else
       had_err = sample_status;
   }
+  /* gt_encdesc_decode() has reset the decoder to this sample */
+  else if (encdesc->sampling != NULL && encdesc->cur_desc != 0 &&
+           encdesc->cur_desc ==
+             gt_sampling_get_current_elementnum(encdesc->sampling))
+    sampled = true;
 
   if (had_err)
     gt_error_set(err, "sampling did not work, input data corrupt?");
@@ -1450,8 +1455,10 @@ int gt_encdesc_decode(GtEncdesc *encdesc,
                                 num,
                                 &nearestsample,
                                 &startofnearestsample);
-    /* nearestsample <= cur_read < readnum: current sample is the right one */
-    if (nearestsample <= encdesc->cur_desc && encdesc->cur_desc <= num)
+    /* nearestsample < cur_read < readnum: current sample is the right one,
+       if cur_read is the sample itself the decoder has to be reset to it, as
+       the sampled description is stored differently */
+    if (nearestsample < encdesc->cur_desc && encdesc->cur_desc <= num)
       descs2read = num - encdesc->cur_desc;
     else { /* reset decoder to new sample */
       gt_bitinstream_reinit(encdesc->bitinstream,
@@ -0,0 +1,1460 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/hashmap.h"
+#include "core/implicit_interval_tree.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/str_array.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
+#include "extended/feature_index_mapped.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/region_node_api.h"
+
+/*
+  Layout of an index file (all integers in native byte order):
+
+  header:      GtFeatureIndexMappedHeader
+  trees:       the feature trees in the order they were added, see below
+  padding:     to a multiple of 8 bytes
+  intervals:   for each sequence id in strcmp() order, a
+               GtFeatureIndexMappedInterval for each top-level feature,
+               sorted by position and laid out as an implicit augmented
+               interval tree (the interval at position i with k trailing one
+               bits is an inner node of height k, its maxend field is the
+               maximum end position in its subtree)
+  seqid table: GtFeatureIndexMappedSeqid for each sequence id
+  strings:     nofstrings uint64_t offsets into the following '\0'
+               terminated strings (sequence ids, types, sources, and
+               attribute names)
+
+  A feature tree is stored as a varint (LEB128) encoded number of nodes
+  followed by the nodes in topological order (parents before children):
+  flags byte (GT_FIM_*_FLAG), type string (unless pseudo), source string (if
+  set), start, length - 1, strand, phase, float score (if defined), number of
+  attributes followed by name string and value length and value for each
+  attribute, number of children followed by their node numbers, and the node
+  number of the multi-feature representative (for multi-features). String
+  numbers refer to the string table.
+*/
+
+#define GT_FEATURE_INDEX_MAPPED_MAGIC    UINT64_C(0x31584449464d5447)
+#define GT_FEATURE_INDEX_MAPPED_VERSION  1
+
+#define GT_FEATURE_INDEX_MAPPED_MAXHEIGHT   64
+
+#define GT_FIM_PSEUDO_FLAG  1
+#define GT_FIM_SOURCE_FLAG  2
+#define GT_FIM_SCORE_FLAG   4
+#define GT_FIM_MULTI_FLAG   8
+
+typedef struct {
+  uint64_t magic, version, nofseqids, firstseqid, seqidtab_offset,
+           nofstrings, stringtab_offset;
+} GtFeatureIndexMappedHeader;
+
+typedef struct {
+  uint64_t name, has_region, orig_start, orig_end, start, end, nofintervals,
+           intervals_offset, height;
+} GtFeatureIndexMappedSeqid;
+
+typedef struct {
+  GtImplicitIntervalTreeEntry iv;
+  uint64_t tree_offset;
+} GtFeatureIndexMappedInterval;
+
+typedef struct {
+  GtStr *seqid;
+  GtFeatureNode **nodes; /* materialized top-level nodes, one per interval */
+} GtFeatureIndexMappedCache;
+
+struct GtFeatureIndexMapped {
+  const GtFeatureIndex parent_instance;
+  GtStr *filename;
+  void *map;
+  size_t mapsize;
+  const GtFeatureIndexMappedHeader *header;
+  const GtFeatureIndexMappedSeqid *seqidtab;
+  const uint64_t *stringoffsets;
+  const char *strings;
+  GtFeatureIndexMappedCache *caches;
+  GtStr **sources;
+  GtStr *valuebuf;
+  GtMutex *mutex; /* protects caches, sources, and valuebuf */
+};
+
+#define gt_feature_index_mapped_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_mapped_class(), FI)
+
+/* --- writer --- */
+
+typedef struct {
+  GtUword indegree,
+          number;
+} GtFeatureIndexMappedNodeInfo;
+
+typedef struct {
+  GtArray *intervals;
+  GtRange orig_range,
+          range;
+  bool has_region;
+} GtFeatureIndexMappedWriterSeqid;
+
+struct GtFeatureIndexMappedWriter {
+  FILE *fp;
+  GtStr *filename;
+  uint64_t offset;
+  GtHashmap *seqids;      /* seqid -> GtFeatureIndexMappedWriterSeqid* */
+  char *firstseqid;
+  GtHashmap *stringnums;  /* string -> GtUword*, keys belong to <strings> */
+  GtStrArray *strings;
+  GtHashmap *nodeinfo;    /* GtFeatureNode* -> GtFeatureIndexMappedNodeInfo* */
+  GtArray *discovered,
+          *nodes;         /* GtFeatureNode* in topological order */
+  GtStr *buf,
+        *attrbuf;
+  GtUword nofattrs;
+};
+
+static void feature_index_mapped_writer_seqid_delete(
+                                         GtFeatureIndexMappedWriterSeqid *info)
+{
+  gt_array_delete(info->intervals);
+  gt_free(info);
+}
+
+GtFeatureIndexMappedWriter* gt_feature_index_mapped_writer_new(const char
+                                                               *filename,
+                                                               GtError *err)
+{
+  GtFeatureIndexMappedWriter *writer;
+  GtFeatureIndexMappedHeader header;
+  FILE *fp;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!(fp = gt_fa_fopen(filename, "wb", err)))
+    return NULL;
+  writer = gt_calloc((size_t) 1, sizeof (*writer));
+  writer->fp = fp;
+  writer->filename = gt_str_new_cstr(filename);
+  writer->seqids = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                            (GtFree) feature_index_mapped_writer_seqid_delete);
+  writer->stringnums = gt_hashmap_new(GT_HASH_STRING, NULL, gt_free_func);
+  writer->strings = gt_str_array_new();
+  writer->nodeinfo = gt_hashmap_new(GT_HASH_DIRECT, NULL, gt_free_func);
+  writer->discovered = gt_array_new(sizeof (GtFeatureNode*));
+  writer->nodes = gt_array_new(sizeof (GtFeatureNode*));
+  writer->buf = gt_str_new();
+  writer->attrbuf = gt_str_new();
+  /* the header is written by gt_feature_index_mapped_writer_finish() */
+  memset(&header, 0, sizeof header);
+  gt_xfwrite(&header, sizeof header, (size_t) 1, writer->fp);
+  writer->offset = (uint64_t) sizeof header;
+  return writer;
+}
+
+static void feature_index_mapped_append_varint(GtStr *buf, GtUword value)
+{
+  while (value >= 0x80) {
+    gt_str_append_char(buf, (char) ((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  gt_str_append_char(buf, (char) value);
+}
+
+static GtUword feature_index_mapped_string_number(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                                  const char *string)
+{
+  GtUword *num;
+  if (!(num = gt_hashmap_get(writer->stringnums, string))) {
+    num = gt_malloc(sizeof *num);
+    *num = gt_str_array_size(writer->strings);
+    gt_str_array_add_cstr(writer->strings, string);
+    gt_hashmap_add(writer->stringnums,
+                   (void*) gt_str_array_get(writer->strings, *num), num);
+  }
+  return *num;
+}
+
+static void feature_index_mapped_write_data(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                            const void *data, size_t size)
+{
+  if (size > 0)
+    gt_xfwrite(data, size, (size_t) 1, writer->fp);
+  writer->offset += (uint64_t) size;
+}
+
+static void feature_index_mapped_write_padding(GtFeatureIndexMappedWriter
+                                                                       *writer)
+{
+  static const char zeros[sizeof (uint64_t)] = { 0 };
+  size_t rest = (size_t) (writer->offset % sizeof (uint64_t));
+  if (rest > 0)
+    feature_index_mapped_write_data(writer, zeros, sizeof (uint64_t) - rest);
+}
+
+static GtFeatureIndexMappedWriterSeqid*
+feature_index_mapped_writer_seqid(GtFeatureIndexMappedWriter *writer,
+                                  GtGenomeNode *gn)
+{
+  GtFeatureIndexMappedWriterSeqid *info;
+  const char *seqid = gt_str_get(gt_genome_node_get_seqid(gn));
+  if (!(info = gt_hashmap_get(writer->seqids, seqid))) {
+    info = gt_calloc((size_t) 1, sizeof (*info));
+    info->intervals = gt_array_new(sizeof (GtFeatureIndexMappedInterval));
+    info->range.start = GT_UNDEF_UWORD;
+    info->range.end = 0;
+    gt_hashmap_add(writer->seqids, gt_cstr_dup(seqid), info);
+    if (!writer->firstseqid)
+      writer->firstseqid = gt_cstr_dup(seqid);
+  }
+  return info;
+}
+
+int gt_feature_index_mapped_writer_add_region_node(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                                   GtRegionNode *rn,
+                                                   GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMappedWriterSeqid *info;
+  gt_error_check(err);
+  gt_assert(writer && rn);
+
+  info = feature_index_mapped_writer_seqid(writer, (GtGenomeNode*) rn);
+  if (!info->has_region) {
+    info->has_region = true;
+    info->orig_range = gt_genome_node_get_range((GtGenomeNode*) rn);
+  }
+  return 0;
+}
+
+static GtFeatureIndexMappedNodeInfo*
+feature_index_mapped_node_info(GtFeatureIndexMappedWriter *writer,
+                               GtFeatureNode *fn)
+{
+  GtFeatureIndexMappedNodeInfo *info;
+  if (!(info = gt_hashmap_get(writer->nodeinfo, fn))) {
+    info = gt_malloc(sizeof *info);
+    info->indegree = 0;
+    info->number = GT_UNDEF_UWORD;
+    gt_hashmap_add(writer->nodeinfo, fn, info);
+    gt_array_add(writer->discovered, fn);
+  }
+  return info;
+}
+
+/* numbers the nodes of the DAG rooted at <root> in topological order */
+static void feature_index_mapped_number_nodes(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                              GtFeatureNode *root)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child;
+  GtUword i;
+
+  gt_hashmap_reset(writer->nodeinfo);
+  gt_array_reset(writer->discovered);
+  gt_array_reset(writer->nodes);
+  (void) feature_index_mapped_node_info(writer, root);
+  for (i = 0; i < gt_array_size(writer->discovered); i++) {
+    fn = *(GtFeatureNode**) gt_array_get(writer->discovered, i);
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni)))
+      feature_index_mapped_node_info(writer, child)->indegree++;
+    gt_feature_node_iterator_delete(fni);
+  }
+  gt_array_add(writer->nodes, root);
+  for (i = 0; i < gt_array_size(writer->nodes); i++) {
+    fn = *(GtFeatureNode**) gt_array_get(writer->nodes, i);
+    feature_index_mapped_node_info(writer, fn)->number = i;
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (--feature_index_mapped_node_info(writer, child)->indegree == 0)
+        gt_array_add(writer->nodes, child);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  gt_assert(gt_array_size(writer->nodes) ==
+            gt_array_size(writer->discovered));
+}
+
+static void feature_index_mapped_encode_attribute(const char *attr_name,
+                                                  const char *attr_value,
+                                                  void *data)
+{
+  GtFeatureIndexMappedWriter *writer = data;
+  GtUword length = (GtUword) strlen(attr_value);
+  feature_index_mapped_append_varint(writer->attrbuf,
+                          feature_index_mapped_string_number(writer,
+                                                             attr_name));
+  feature_index_mapped_append_varint(writer->attrbuf, length);
+  gt_str_append_cstr_nt(writer->attrbuf, attr_value, length);
+  writer->nofattrs++;
+}
+
+static void feature_index_mapped_encode_node(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                             GtFeatureNode *fn,
+                                             GtUword number)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  GtRange range;
+  GtUword nofchildren = 0;
+  unsigned char flags = 0;
+  float score;
+
+  if (gt_feature_node_is_pseudo(fn))
+    flags |= GT_FIM_PSEUDO_FLAG;
+  else if (gt_feature_node_is_multi(fn))
+    flags |= GT_FIM_MULTI_FLAG;
+  if (gt_feature_node_has_source(fn))
+    flags |= GT_FIM_SOURCE_FLAG;
+  if (gt_feature_node_score_is_defined(fn))
+    flags |= GT_FIM_SCORE_FLAG;
+  gt_str_append_char(writer->buf, (char) flags);
+  if (!(flags & GT_FIM_PSEUDO_FLAG)) {
+    feature_index_mapped_append_varint(writer->buf,
+                feature_index_mapped_string_number(writer,
+                                                gt_feature_node_get_type(fn)));
+  }
+  if (flags & GT_FIM_SOURCE_FLAG) {
+    feature_index_mapped_append_varint(writer->buf,
+              feature_index_mapped_string_number(writer,
+                                              gt_feature_node_get_source(fn)));
+  }
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  feature_index_mapped_append_varint(writer->buf, range.start);
+  feature_index_mapped_append_varint(writer->buf, range.end - range.start);
+  feature_index_mapped_append_varint(writer->buf,
+                                     (GtUword) gt_feature_node_get_strand(fn));
+  feature_index_mapped_append_varint(writer->buf,
+                                     (GtUword) gt_feature_node_get_phase(fn));
+  if (flags & GT_FIM_SCORE_FLAG) {
+    score = gt_feature_node_get_score(fn);
+    gt_str_append_cstr_nt(writer->buf, (const char*) &score, sizeof score);
+  }
+
+  gt_str_reset(writer->attrbuf);
+  writer->nofattrs = 0;
+  gt_feature_node_foreach_attribute(fn, feature_index_mapped_encode_attribute,
+                                    writer);
+  feature_index_mapped_append_varint(writer->buf, writer->nofattrs);
+  gt_str_append_str(writer->buf, writer->attrbuf);
+
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while (gt_feature_node_iterator_next(fni))
+    nofchildren++;
+  gt_feature_node_iterator_delete(fni);
+  feature_index_mapped_append_varint(writer->buf, nofchildren);
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while ((child = gt_feature_node_iterator_next(fni))) {
+    feature_index_mapped_append_varint(writer->buf,
+                          feature_index_mapped_node_info(writer,
+                                                         child)->number);
+  }
+  gt_feature_node_iterator_delete(fni);
+
+  if (flags & GT_FIM_MULTI_FLAG) {
+    GtFeatureIndexMappedNodeInfo *info;
+    /* a representative outside of the tree cannot be referenced, the node
+       becomes its own representative then */
+    info = gt_hashmap_get(writer->nodeinfo,
+                          gt_feature_node_get_multi_representative(fn));
+    feature_index_mapped_append_varint(writer->buf,
+                                       info ? info->number : number);
+  }
+}
+
+int gt_feature_index_mapped_writer_add_feature_node(GtFeatureIndexMappedWriter
+                                                                       *writer,
+                                                    GtFeatureNode *fn,
+                                                    GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMappedWriterSeqid *info;
+  GtFeatureIndexMappedInterval interval;
+  GtRange range;
+  GtUword i;
+  gt_error_check(err);
+  gt_assert(writer && fn);
+
+  info = feature_index_mapped_writer_seqid(writer, (GtGenomeNode*) fn);
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  interval.iv.start = (uint64_t) range.start;
+  interval.iv.end = (uint64_t) range.end;
+  interval.iv.maxend = 0;
+  interval.tree_offset = writer->offset;
+  gt_array_add(info->intervals, interval);
+  info->range.start = MIN(info->range.start, range.start);
+  info->range.end = MAX(info->range.end, range.end);
+
+  feature_index_mapped_number_nodes(writer, fn);
+  gt_str_reset(writer->buf);
+  feature_index_mapped_append_varint(writer->buf,
+                                     gt_array_size(writer->nodes));
+  for (i = 0; i < gt_array_size(writer->nodes); i++) {
+    feature_index_mapped_encode_node(writer,
+                             *(GtFeatureNode**) gt_array_get(writer->nodes, i),
+                                     i);
+  }
+  feature_index_mapped_write_data(writer, gt_str_get_mem(writer->buf),
+                                  (size_t) gt_str_length(writer->buf));
+  return 0;
+}
+
+/* sorts by start and end position, features with equal ranges stay in the
+   order they were added */
+static int feature_index_mapped_cmp_interval(const void *v1, const void *v2)
+{
+  const GtFeatureIndexMappedInterval *i1 = v1, *i2 = v2;
+  if (i1->iv.start != i2->iv.start)
+    return i1->iv.start < i2->iv.start ? -1 : 1;
+  if (i1->iv.end != i2->iv.end)
+    return i1->iv.end < i2->iv.end ? -1 : 1;
+  if (i1->tree_offset != i2->tree_offset)
+    return i1->tree_offset < i2->tree_offset ? -1 : 1;
+  return 0;
+}
+
+static int feature_index_mapped_collect_seqid(void *key,
+                                              GT_UNUSED void *value,
+                                              void *data,
+                                              GT_UNUSED GtError *err)
+{
+  gt_array_add((GtArray*) data, key);
+  return 0;
+}
+
+static int feature_index_mapped_cmp_cstr(const void *v1, const void *v2)
+{
+  return strcmp(*(const char**) v1, *(const char**) v2);
+}
+
+int gt_feature_index_mapped_writer_finish(GtFeatureIndexMappedWriter *writer,
+                                          GtError *err)
+{
+  GtFeatureIndexMappedHeader header;
+  GtFeatureIndexMappedSeqid *seqidtab;
+  GtFeatureIndexMappedWriterSeqid *info;
+  GtArray *seqids;
+  const char *seqid;
+  uint64_t stringoffset;
+  GtUword i, nofseqids;
+  GT_UNUSED int rval;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(writer && writer->fp);
+
+  seqids = gt_array_new(sizeof (char*));
+  rval = gt_hashmap_foreach(writer->seqids, feature_index_mapped_collect_seqid,
+                            seqids, NULL);
+  gt_assert(!rval); /* feature_index_mapped_collect_seqid() is sane */
+  gt_array_sort(seqids, feature_index_mapped_cmp_cstr);
+  nofseqids = gt_array_size(seqids);
+
+  memset(&header, 0, sizeof header);
+  header.magic = GT_FEATURE_INDEX_MAPPED_MAGIC;
+  header.version = GT_FEATURE_INDEX_MAPPED_VERSION;
+  header.nofseqids = (uint64_t) nofseqids;
+  header.firstseqid = 0;
+
+  /* the interval arrays of all sequence ids follow the feature trees */
+  feature_index_mapped_write_padding(writer);
+  seqidtab = gt_calloc((size_t) nofseqids + 1, sizeof (*seqidtab));
+  for (i = 0; i < nofseqids; i++) {
+    GtFeatureIndexMappedSeqid *entry = seqidtab + i;
+    GtUword nofintervals;
+
+    seqid = *(const char**) gt_array_get(seqids, i);
+    info = gt_hashmap_get(writer->seqids, seqid);
+    if (strcmp(seqid, writer->firstseqid) == 0)
+      header.firstseqid = (uint64_t) i;
+    entry->name = feature_index_mapped_string_number(writer, seqid);
+    if (info->has_region) {
+      entry->has_region = 1;
+      entry->orig_start = (uint64_t) info->orig_range.start;
+      entry->orig_end = (uint64_t) info->orig_range.end;
+    }
+    /* like a <GtFeatureIndexMemory>, report the range covered by the
+       features if there are any and the sequence region otherwise */
+    nofintervals = gt_array_size(info->intervals);
+    if (nofintervals > 0) {
+      entry->start = (uint64_t) info->range.start;
+      entry->end = (uint64_t) info->range.end;
+    }
+    else {
+      entry->start = entry->orig_start;
+      entry->end = entry->orig_end;
+    }
+    gt_array_sort(info->intervals, feature_index_mapped_cmp_interval);
+    entry->nofintervals = (uint64_t) nofintervals;
+    entry->height = (uint64_t)
+                    gt_implicit_interval_tree_build(
+                                       gt_array_get_space(info->intervals),
+                                       nofintervals,
+                                       sizeof (GtFeatureIndexMappedInterval));
+    entry->intervals_offset = writer->offset;
+    feature_index_mapped_write_data(writer,
+                                    gt_array_get_space(info->intervals),
+                                    sizeof (GtFeatureIndexMappedInterval) *
+                                    nofintervals);
+  }
+
+  header.seqidtab_offset = writer->offset;
+  feature_index_mapped_write_data(writer, seqidtab,
+                                  sizeof (*seqidtab) * nofseqids);
+  header.nofstrings = (uint64_t) gt_str_array_size(writer->strings);
+  header.stringtab_offset = writer->offset;
+  for (i = 0, stringoffset = 0; i < gt_str_array_size(writer->strings); i++) {
+    feature_index_mapped_write_data(writer, &stringoffset,
+                                    sizeof stringoffset);
+    stringoffset += (uint64_t) strlen(gt_str_array_get(writer->strings,
+                                                       i)) + 1;
+  }
+  for (i = 0; i < gt_str_array_size(writer->strings); i++) {
+    const char *string = gt_str_array_get(writer->strings, i);
+    feature_index_mapped_write_data(writer, string, strlen(string) + 1);
+  }
+  gt_xfseek(writer->fp, 0, SEEK_SET);
+  gt_xfwrite(&header, sizeof header, (size_t) 1, writer->fp);
+  if (fflush(writer->fp) != 0) {
+    gt_error_set(err, "could not write feature index file %s",
+                 gt_str_get(writer->filename));
+    had_err = -1;
+  }
+  gt_fa_xfclose(writer->fp);
+  writer->fp = NULL;
+
+  gt_free(seqidtab);
+  gt_array_delete(seqids);
+  return had_err;
+}
+
+void gt_feature_index_mapped_writer_delete(GtFeatureIndexMappedWriter *writer)
+{
+  if (!writer) return;
+  gt_fa_xfclose(writer->fp);
+  gt_str_delete(writer->attrbuf);
+  gt_str_delete(writer->buf);
+  gt_array_delete(writer->nodes);
+  gt_array_delete(writer->discovered);
+  gt_hashmap_delete(writer->nodeinfo);
+  gt_str_array_delete(writer->strings);
+  gt_hashmap_delete(writer->stringnums);
+  gt_free(writer->firstseqid);
+  gt_hashmap_delete(writer->seqids);
+  gt_str_delete(writer->filename);
+  gt_free(writer);
+}
+
+/* --- reader --- */
+
+typedef struct {
+  const unsigned char *ptr,
+                      *end;
+} GtFeatureIndexMappedDecoder;
+
+static bool feature_index_mapped_decode_varint(GtFeatureIndexMappedDecoder
+                                                                          *dec,
+                                               GtUword *value)
+{
+  GtUword result = 0;
+  unsigned int shift = 0;
+  while (dec->ptr < dec->end && shift < sizeof (GtUword) * CHAR_BIT) {
+    unsigned char c = *dec->ptr++;
+    result |= (GtUword) (c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      *value = result;
+      return true;
+    }
+    shift += 7;
+  }
+  return false;
+}
+
+static bool feature_index_mapped_decode_string(GtFeatureIndexMapped *fim,
+                                               GtFeatureIndexMappedDecoder
+                                                                          *dec,
+                                               GtUword *num)
+{
+  return feature_index_mapped_decode_varint(dec, num) &&
+         *num < (GtUword) fim->header->nofstrings &&
+         fim->strings[fim->stringoffsets[*num]] != '\0';
+}
+
+/* decodes the node with number <nodenum> of a tree consisting of <nofnodes>
+   nodes and stores the numbers of its children in <children> and the number
+   of its representative in <rep> */
+static bool feature_index_mapped_decode_node(GtFeatureIndexMapped *fim,
+                                             GtFeatureIndexMappedDecoder *dec,
+                                             GtStr *seqid, GtUword nodenum,
+                                             GtUword nofnodes,
+                                             GtFeatureNode **fn,
+                                             GtArray *children, GtUword *rep)
+{
+  GtUword type = 0, source = 0, start, length, strand, phase, nofattrs,
+          nofchildren, name, i, child;
+  unsigned char flags;
+  float score = 0.0;
+
+  if (dec->ptr == dec->end)
+    return false;
+  flags = *dec->ptr++;
+  if (flags & ~(GT_FIM_PSEUDO_FLAG | GT_FIM_SOURCE_FLAG | GT_FIM_SCORE_FLAG |
+                GT_FIM_MULTI_FLAG) ||
+      ((flags & GT_FIM_PSEUDO_FLAG) && (flags & GT_FIM_MULTI_FLAG)))
+    return false;
+  if (!(flags & GT_FIM_PSEUDO_FLAG) &&
+      !feature_index_mapped_decode_string(fim, dec, &type))
+    return false;
+  if ((flags & GT_FIM_SOURCE_FLAG) &&
+      !feature_index_mapped_decode_string(fim, dec, &source))
+    return false;
+  if (!feature_index_mapped_decode_varint(dec, &start) ||
+      !feature_index_mapped_decode_varint(dec, &length) ||
+      length > GT_UWORD_MAX - start ||
+      !feature_index_mapped_decode_varint(dec, &strand) ||
+      strand >= (GtUword) GT_NUM_OF_STRAND_TYPES ||
+      !feature_index_mapped_decode_varint(dec, &phase) ||
+      phase > (GtUword) GT_PHASE_UNDEFINED)
+    return false;
+  if (flags & GT_FIM_SCORE_FLAG) {
+    if ((size_t) (dec->end - dec->ptr) < sizeof score)
+      return false;
+    memcpy(&score, dec->ptr, sizeof score);
+    dec->ptr += sizeof score;
+  }
+
+  if (flags & GT_FIM_PSEUDO_FLAG) {
+    *fn = (GtFeatureNode*) gt_feature_node_new_pseudo(seqid, start,
+                                                      start + length,
+                                                      (GtStrand) strand);
+  }
+  else {
+    *fn = (GtFeatureNode*) gt_feature_node_new(seqid,
+                                 fim->strings + fim->stringoffsets[type],
+                                 start, start + length, (GtStrand) strand);
+  }
+  if (flags & GT_FIM_SOURCE_FLAG) {
+    if (!fim->sources[source]) {
+      fim->sources[source] =
+                 gt_str_new_cstr(fim->strings + fim->stringoffsets[source]);
+    }
+    gt_feature_node_set_source(*fn, fim->sources[source]);
+  }
+  gt_feature_node_set_phase(*fn, (GtPhase) phase);
+  if (flags & GT_FIM_SCORE_FLAG)
+    gt_feature_node_set_score(*fn, score);
+
+  if (!feature_index_mapped_decode_varint(dec, &nofattrs))
+    return false;
+  for (i = 0; i < nofattrs; i++) {
+    if (!feature_index_mapped_decode_string(fim, dec, &name) ||
+        !feature_index_mapped_decode_varint(dec, &length) ||
+        length == 0 || length > (GtUword) (dec->end - dec->ptr) ||
+        memchr(dec->ptr, '\0', (size_t) length))
+      return false;
+    gt_str_reset(fim->valuebuf);
+    gt_str_append_cstr_nt(fim->valuebuf, (const char*) dec->ptr, length);
+    dec->ptr += length;
+    gt_feature_node_set_attribute(*fn, fim->strings + fim->stringoffsets[name],
+                                  gt_str_get(fim->valuebuf));
+  }
+
+  if (!feature_index_mapped_decode_varint(dec, &nofchildren))
+    return false;
+  for (i = 0; i < nofchildren; i++) {
+    /* children follow their parents, hence the stored graph is acyclic */
+    if (!feature_index_mapped_decode_varint(dec, &child) ||
+        child <= nodenum || child >= nofnodes)
+      return false;
+    gt_array_add(children, child);
+  }
+
+  *rep = GT_UNDEF_UWORD;
+  if ((flags & GT_FIM_MULTI_FLAG) &&
+      (!feature_index_mapped_decode_varint(dec, rep) || *rep >= nofnodes))
+    return false;
+  return true;
+}
+
+/* creates the feature tree stored at <interval>, <fim->mutex> must be held */
+static GtFeatureNode* feature_index_mapped_materialize(GtFeatureIndexMapped
+                                                                          *fim,
+                                                       GtStr *seqid,
+                                                       const
+                                                  GtFeatureIndexMappedInterval
+                                                                     *interval,
+                                                       GtError *err)
+{
+  GtFeatureIndexMappedDecoder dec;
+  GtFeatureNode **nodes = NULL, *root = NULL;
+  GtArray *children;
+  GtUword nofnodes = 0, *childstart = NULL, *reps = NULL, i, j, child;
+  bool *linked = NULL, ok = true;
+
+  children = gt_array_new(sizeof (GtUword));
+  dec.ptr = (const unsigned char*) fim->map + interval->tree_offset;
+  dec.end = (const unsigned char*) fim->map + fim->mapsize;
+  if (!feature_index_mapped_decode_varint(&dec, &nofnodes) || nofnodes == 0 ||
+      nofnodes > (GtUword) (dec.end - dec.ptr))
+    ok = false;
+  if (ok) {
+    nodes = gt_calloc((size_t) nofnodes, sizeof (*nodes));
+    childstart = gt_malloc(sizeof (*childstart) * (nofnodes + 1));
+    reps = gt_malloc(sizeof (*reps) * nofnodes);
+    linked = gt_calloc((size_t) nofnodes, sizeof (*linked));
+  }
+  for (i = 0; ok && i < nofnodes; i++) {
+    childstart[i] = gt_array_size(children);
+    ok = feature_index_mapped_decode_node(fim, &dec, seqid, i, nofnodes,
+                                          nodes + i, children, reps + i);
+  }
+  if (ok) {
+    childstart[nofnodes] = gt_array_size(children);
+    /* every node except the root has a parent, representatives represent
+       themselves */
+    for (i = 0; i < gt_array_size(children); i++)
+      linked[*(GtUword*) gt_array_get(children, i)] = true;
+    for (i = 1; ok && i < nofnodes; i++) {
+      if (!linked[i])
+        ok = false;
+    }
+    for (i = 0; ok && i < nofnodes; i++) {
+      if (reps[i] != GT_UNDEF_UWORD && reps[reps[i]] != reps[i])
+        ok = false;
+    }
+  }
+  if (ok && (interval->iv.start != (uint64_t)
+             gt_genome_node_get_start((GtGenomeNode*) nodes[0]) ||
+             interval->iv.end != (uint64_t)
+             gt_genome_node_get_end((GtGenomeNode*) nodes[0])))
+    ok = false;
+
+  if (ok) {
+    memset(linked, 0, sizeof (*linked) * nofnodes);
+    for (i = 0; i < nofnodes; i++) {
+      for (j = childstart[i]; j < childstart[i+1]; j++) {
+        child = *(GtUword*) gt_array_get(children, j);
+        /* nodes with multiple parents are referenced by each of them */
+        if (linked[child])
+          (void) gt_genome_node_ref((GtGenomeNode*) nodes[child]);
+        gt_feature_node_add_child(nodes[i], nodes[child]);
+        linked[child] = true;
+      }
+    }
+    for (i = 0; i < nofnodes; i++) {
+      if (reps[i] == i)
+        gt_feature_node_make_multi_representative(nodes[i]);
+    }
+    for (i = 0; i < nofnodes; i++) {
+      if (reps[i] != GT_UNDEF_UWORD && reps[i] != i)
+        gt_feature_node_set_multi_representative(nodes[i], nodes[reps[i]]);
+    }
+    root = nodes[0];
+  }
+  else {
+    for (i = 0; nodes && i < nofnodes; i++)
+      gt_genome_node_delete((GtGenomeNode*) nodes[i]);
+    gt_error_set(err, "feature index file %s is corrupt",
+                 gt_str_get(fim->filename));
+  }
+
+  gt_free(linked);
+  gt_free(reps);
+  gt_free(childstart);
+  gt_free(nodes);
+  gt_array_delete(children);
+  return root;
+}
+
+static GtUword feature_index_mapped_seqnum(const GtFeatureIndexMapped *fim,
+                                           const char *seqid)
+{
+  GtUword left = 0, right = (GtUword) fim->header->nofseqids, mid;
+  int cmp;
+  while (left < right) {
+    mid = left + (right - left) / 2;
+    cmp = strcmp(seqid, fim->strings +
+                        fim->stringoffsets[fim->seqidtab[mid].name]);
+    if (cmp == 0)
+      return mid;
+    if (cmp < 0)
+      right = mid;
+    else
+      left = mid + 1;
+  }
+  return GT_UNDEF_UWORD;
+}
+
+/* returns the top-level node for interval <intnum> of sequence id <seqnum>,
+   <fim->mutex> must be held */
+static GtFeatureNode* feature_index_mapped_get_node(GtFeatureIndexMapped *fim,
+                                                    GtUword seqnum,
+                                                    GtUword intnum,
+                                                    GtError *err)
+{
+  const GtFeatureIndexMappedSeqid *entry = fim->seqidtab + seqnum;
+  const GtFeatureIndexMappedInterval *intervals;
+  GtFeatureIndexMappedCache *cache = fim->caches + seqnum;
+
+  if (!cache->nodes) {
+    cache->nodes = gt_calloc((size_t) entry->nofintervals,
+                             sizeof (*cache->nodes));
+  }
+  if (!cache->nodes[intnum]) {
+    if (!cache->seqid) {
+      cache->seqid = gt_str_new_cstr(fim->strings +
+                                     fim->stringoffsets[entry->name]);
+    }
+    intervals = (const GtFeatureIndexMappedInterval*)
+                ((const char*) fim->map + entry->intervals_offset);
+    cache->nodes[intnum] = feature_index_mapped_materialize(fim, cache->seqid,
+                                                      intervals + intnum, err);
+  }
+  return cache->nodes[intnum];
+}
+
+static int feature_index_mapped_read_only(GtError *err)
+{
+  gt_error_set(err, "feature index is read-only");
+  return -1;
+}
+
+int gt_feature_index_mapped_add_region_node(GT_UNUSED GtFeatureIndex *gfi,
+                                            GT_UNUSED GtRegionNode *rn,
+                                            GtError *err)
+{
+  return feature_index_mapped_read_only(err);
+}
+
+int gt_feature_index_mapped_add_feature_node(GT_UNUSED GtFeatureIndex *gfi,
+                                             GT_UNUSED GtFeatureNode *fn,
+                                             GtError *err)
+{
+  return feature_index_mapped_read_only(err);
+}
+
+int gt_feature_index_mapped_remove_node(GT_UNUSED GtFeatureIndex *gfi,
+                                        GT_UNUSED GtFeatureNode *fn,
+                                        GtError *err)
+{
+  return feature_index_mapped_read_only(err);
+}
+
+GtArray* gt_feature_index_mapped_get_features_for_seqid(GtFeatureIndex *gfi,
+                                                        const char *seqid,
+                                                        GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureNode *fn;
+  GtArray *a;
+  GtUword seqnum, i;
+  gt_assert(gfi && seqid);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  seqnum = feature_index_mapped_seqnum(fim, seqid);
+  if (seqnum != GT_UNDEF_UWORD) {
+    gt_mutex_lock(fim->mutex);
+    for (i = 0; i < (GtUword) fim->seqidtab[seqnum].nofintervals; i++) {
+      if (!(fn = feature_index_mapped_get_node(fim, seqnum, i, err))) {
+        gt_array_delete(a);
+        a = NULL;
+        break;
+      }
+      gt_array_add(a, fn);
+    }
+    gt_mutex_unlock(fim->mutex);
+  }
+  return a;
+}
+
+static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
+{
+  GtGenomeNode *n1, *n2;
+  n1 = *(GtGenomeNode**) v1;
+  n2 = *(GtGenomeNode**) v2;
+  return gt_genome_node_compare(&n1, &n2);
+}
+
+static bool feature_index_mapped_collect_hit(GtUword idx, void *data)
+{
+  gt_array_add((GtArray*) data, idx);
+  return false;
+}
+
+int gt_feature_index_mapped_get_features_for_range(GtFeatureIndex *gfi,
+                                                   GtArray *results,
+                                                   const char *seqid,
+                                                   const GtRange *qry_range,
+                                                   GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureNode *fn;
+  GtArray *hits;
+  GtUword seqnum, i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi && results && qry_range);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  seqnum = feature_index_mapped_seqnum(fim, seqid);
+  if (seqnum == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+
+  /* only the intervals on the search paths are touched, the hits are found in
+     ascending order, so features with equal ranges are returned in the order
+     they were added */
+  hits = gt_array_new(sizeof (GtUword));
+  gt_implicit_interval_tree_find((const char*) fim->map +
+                                 fim->seqidtab[seqnum].intervals_offset,
+                                 (GtUword) fim->seqidtab[seqnum].nofintervals,
+                                 sizeof (GtFeatureIndexMappedInterval),
+                                 (unsigned int) fim->seqidtab[seqnum].height,
+                                 (uint64_t) qry_range->start,
+                                 (uint64_t) qry_range->end,
+                                 feature_index_mapped_collect_hit, hits);
+  gt_mutex_lock(fim->mutex);
+  for (i = 0; !had_err && i < gt_array_size(hits); i++) {
+    if (!(fn = feature_index_mapped_get_node(fim, seqnum,
+                                             *(GtUword*) gt_array_get(hits, i),
+                                             err)))
+      had_err = -1;
+    else
+      gt_array_add(results, fn);
+  }
+  gt_mutex_unlock(fim->mutex);
+  gt_array_delete(hits);
+  if (!had_err)
+    gt_array_sort_stable(results, gt_genome_node_cmp_range_start);
+  return had_err;
+}
+
+char* gt_feature_index_mapped_get_first_seqid(const GtFeatureIndex *gfi,
+                                              GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi);
+
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (fim->header->nofseqids == 0) {
+    gt_error_set(err, "no sequence regions in index");
+    return NULL;
+  }
+  return gt_cstr_dup(fim->strings + fim->stringoffsets[
+                                fim->seqidtab[fim->header->firstseqid].name]);
+}
+
+GtStrArray* gt_feature_index_mapped_get_seqids(const GtFeatureIndex *gfi,
+                                               GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtStrArray *seqids;
+  GtUword i;
+  gt_assert(gfi);
+
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  seqids = gt_str_array_new();
+  for (i = 0; i < (GtUword) fim->header->nofseqids; i++) {
+    gt_str_array_add_cstr(seqids, fim->strings +
+                                  fim->stringoffsets[fim->seqidtab[i].name]);
+  }
+  return seqids;
+}
+
+int gt_feature_index_mapped_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                GtRange *range,
+                                                const char *seqid,
+                                                GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword seqnum;
+  gt_assert(gfi && range && seqid);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  seqnum = feature_index_mapped_seqnum(fim, seqid);
+  if (seqnum == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  range->start = (GtUword) fim->seqidtab[seqnum].start;
+  range->end = (GtUword) fim->seqidtab[seqnum].end;
+  return 0;
+}
+
+int gt_feature_index_mapped_get_orig_range_for_seqid(GtFeatureIndex *gfi,
+                                                     GtRange *range,
+                                                     const char *seqid,
+                                                     GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword seqnum;
+  gt_assert(gfi && range && seqid);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  seqnum = feature_index_mapped_seqnum(fim, seqid);
+  if (seqnum == GT_UNDEF_UWORD) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  if (fim->seqidtab[seqnum].has_region) {
+    range->start = (GtUword) fim->seqidtab[seqnum].orig_start;
+    range->end = (GtUword) fim->seqidtab[seqnum].orig_end;
+  }
+  return 0;
+}
+
+int gt_feature_index_mapped_has_seqid(const GtFeatureIndex *gfi,
+                                      bool *has_seqid,
+                                      const char *seqid,
+                                      GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && has_seqid && seqid);
+
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  *has_seqid = (feature_index_mapped_seqnum(fim, seqid) != GT_UNDEF_UWORD);
+  return 0;
+}
+
+void gt_feature_index_mapped_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword i, j;
+  if (!gfi) return;
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->caches) {
+    for (i = 0; i < (GtUword) fim->header->nofseqids; i++) {
+      if (fim->caches[i].nodes) {
+        for (j = 0; j < (GtUword) fim->seqidtab[i].nofintervals; j++)
+          gt_genome_node_delete((GtGenomeNode*) fim->caches[i].nodes[j]);
+        gt_free(fim->caches[i].nodes);
+      }
+      gt_str_delete(fim->caches[i].seqid);
+    }
+    gt_free(fim->caches);
+  }
+  if (fim->sources) {
+    for (i = 0; i < (GtUword) fim->header->nofstrings; i++)
+      gt_str_delete(fim->sources[i]);
+    gt_free(fim->sources);
+  }
+  gt_str_delete(fim->valuebuf);
+  gt_mutex_delete(fim->mutex);
+  gt_fa_xmunmap(fim->map);
+  gt_str_delete(fim->filename);
+}
+
+const GtFeatureIndexClass* gt_feature_index_mapped_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexMapped),
+                     gt_feature_index_mapped_add_region_node,
+                     gt_feature_index_mapped_add_feature_node,
+                     gt_feature_index_mapped_remove_node,
+                     gt_feature_index_mapped_get_features_for_seqid,
+                     gt_feature_index_mapped_get_features_for_range,
+                     gt_feature_index_mapped_get_first_seqid,
+                     NULL,
+                     gt_feature_index_mapped_get_seqids,
+                     gt_feature_index_mapped_get_range_for_seqid,
+                     gt_feature_index_mapped_get_orig_range_for_seqid,
+                     gt_feature_index_mapped_has_seqid,
+                     gt_feature_index_mapped_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+/* returns true if <count> elements of size <size> starting at <offset> are
+   contained in a mapping of <mapsize> bytes */
+static bool feature_index_mapped_fits(uint64_t offset, uint64_t count,
+                                      uint64_t size, size_t mapsize)
+{
+  return offset % sizeof (uint64_t) == 0 && offset <= (uint64_t) mapsize &&
+         count <= ((uint64_t) mapsize - offset) / size;
+}
+
+static int feature_index_mapped_check(GtFeatureIndexMapped *fim, GtError *err)
+{
+  const GtFeatureIndexMappedHeader *header;
+  const GtFeatureIndexMappedSeqid *entry;
+  uint64_t charsize, i;
+
+  if (fim->mapsize < sizeof (GtFeatureIndexMappedHeader)) {
+    gt_error_set(err, "file %s is too short for a feature index",
+                 gt_str_get(fim->filename));
+    return -1;
+  }
+  header = fim->header = fim->map;
+  if (header->magic != GT_FEATURE_INDEX_MAPPED_MAGIC ||
+      header->version != GT_FEATURE_INDEX_MAPPED_VERSION) {
+    gt_error_set(err, "file %s is not a feature index file of version "GT_WU,
+                 gt_str_get(fim->filename),
+                 (GtUword) GT_FEATURE_INDEX_MAPPED_VERSION);
+    return -1;
+  }
+  if (!feature_index_mapped_fits(header->seqidtab_offset, header->nofseqids,
+                                 sizeof (GtFeatureIndexMappedSeqid),
+                                 fim->mapsize) ||
+      !feature_index_mapped_fits(header->stringtab_offset, header->nofstrings,
+                                 sizeof (uint64_t), fim->mapsize) ||
+      (header->nofseqids > 0 && header->firstseqid >= header->nofseqids)) {
+    gt_error_set(err, "file %s is truncated", gt_str_get(fim->filename));
+    return -1;
+  }
+  fim->seqidtab = (const GtFeatureIndexMappedSeqid*)
+                  ((const char*) fim->map + header->seqidtab_offset);
+  fim->stringoffsets = (const uint64_t*)
+                       ((const char*) fim->map + header->stringtab_offset);
+  fim->strings = (const char*) (fim->stringoffsets + header->nofstrings);
+  charsize = (uint64_t) fim->mapsize - header->stringtab_offset -
+             header->nofstrings * sizeof (uint64_t);
+  if (header->nofstrings > 0 &&
+      (charsize == 0 || fim->strings[charsize - 1] != '\0')) {
+    gt_error_set(err, "file %s is truncated", gt_str_get(fim->filename));
+    return -1;
+  }
+  for (i = 0; i < header->nofstrings; i++) {
+    if (fim->stringoffsets[i] >= charsize) {
+      gt_error_set(err, "feature index file %s is corrupt",
+                   gt_str_get(fim->filename));
+      return -1;
+    }
+  }
+  for (i = 0; i < header->nofseqids; i++) {
+    entry = fim->seqidtab + i;
+    if (entry->name >= header->nofstrings || entry->start > entry->end ||
+        entry->orig_start > entry->orig_end ||
+        entry->height >= GT_FEATURE_INDEX_MAPPED_MAXHEIGHT / 2 ||
+        (entry->nofintervals > 0 &&
+         (uint64_t) 1 << entry->height > entry->nofintervals) ||
+        !feature_index_mapped_fits(entry->intervals_offset,
+                                   entry->nofintervals,
+                                   sizeof (GtFeatureIndexMappedInterval),
+                                   fim->mapsize)) {
+      gt_error_set(err, "feature index file %s is corrupt",
+                   gt_str_get(fim->filename));
+      return -1;
+    }
+  }
+  return 0;
+}
+
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename, GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  fi = gt_feature_index_create(gt_feature_index_mapped_class());
+  fim = gt_feature_index_mapped_cast(fi);
+  fim->filename = gt_str_new_cstr(filename);
+  fim->mutex = gt_mutex_new();
+  fim->valuebuf = gt_str_new();
+  if (!(fim->map = gt_fa_mmap_read(filename, &fim->mapsize, err)) ||
+      feature_index_mapped_check(fim, err) != 0) {
+    fim->header = NULL;
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  fim->caches = gt_calloc((size_t) fim->header->nofseqids + 1,
+                          sizeof (*fim->caches));
+  fim->sources = gt_calloc((size_t) fim->header->nofstrings + 1,
+                           sizeof (*fim->sources));
+  return fi;
+}
+
+static GtFeatureNode* feature_index_mapped_random_feature(GtStr *seqid,
+                                                          GtStr *source,
+                                                          GtUword maxpos)
+{
+  static const char *types[] = { "gene", "mRNA", "exon", "CDS", "repeat" };
+  GtGenomeNode *gn;
+  GtUword start = gt_rand_max(maxpos - 1) + 1,
+          end = MIN(start + gt_rand_max(999), maxpos);
+  char value[32];
+
+  gn = gt_feature_node_new(seqid, types[gt_rand_max(4)], start, end,
+                           (GtStrand) gt_rand_max(GT_NUM_OF_STRAND_TYPES - 1));
+  if (gt_rand_max(1))
+    gt_feature_node_set_source((GtFeatureNode*) gn, source);
+  if (gt_rand_max(1))
+    gt_feature_node_set_score((GtFeatureNode*) gn,
+                              (float) gt_rand_max_double(100.0));
+  gt_feature_node_set_phase((GtFeatureNode*) gn,
+                            (GtPhase) gt_rand_max(GT_PHASE_UNDEFINED));
+  (void) snprintf(value, sizeof value, GT_WU, gt_rand_max(1000));
+  gt_feature_node_add_attribute((GtFeatureNode*) gn, "Name", value);
+  return (GtFeatureNode*) gn;
+}
+
+static int feature_index_mapped_compare_trees(GtFeatureNode *root,
+                                              GtFeatureNode *mroot,
+                                              GtError *err)
+{
+  GtFeatureNodeIterator *fni, *mfni;
+  GtFeatureNode *fn, *mfn;
+  GtStrArray *attrs;
+  GtRange range, mrange;
+  GtUword i;
+  int had_err = 0;
+
+  fni = gt_feature_node_iterator_new(root);
+  mfni = gt_feature_node_iterator_new(mroot);
+  while (!had_err && (fn = gt_feature_node_iterator_next(fni))) {
+    mfn = gt_feature_node_iterator_next(mfni);
+    gt_ensure(mfn != NULL);
+    if (had_err)
+      break;
+    gt_ensure(gt_feature_node_is_pseudo(fn) ==
+              gt_feature_node_is_pseudo(mfn));
+    if (!gt_feature_node_is_pseudo(fn)) {
+      gt_ensure(strcmp(gt_feature_node_get_type(fn),
+                       gt_feature_node_get_type(mfn)) == 0);
+    }
+    gt_ensure(strcmp(gt_feature_node_get_source(fn),
+                     gt_feature_node_get_source(mfn)) == 0);
+    range = gt_genome_node_get_range((GtGenomeNode*) fn);
+    mrange = gt_genome_node_get_range((GtGenomeNode*) mfn);
+    gt_ensure(gt_range_compare(&range, &mrange) == 0);
+    gt_ensure(gt_feature_node_get_strand(fn) ==
+              gt_feature_node_get_strand(mfn));
+    gt_ensure(gt_feature_node_get_phase(fn) ==
+              gt_feature_node_get_phase(mfn));
+    gt_ensure(gt_feature_node_score_is_defined(fn) ==
+              gt_feature_node_score_is_defined(mfn));
+    if (!had_err && gt_feature_node_score_is_defined(fn)) {
+      gt_ensure(gt_feature_node_get_score(fn) ==
+                gt_feature_node_get_score(mfn));
+    }
+    gt_ensure(gt_feature_node_is_multi(fn) == gt_feature_node_is_multi(mfn));
+    if (!had_err && gt_feature_node_is_multi(fn)) {
+      range = gt_genome_node_get_range((GtGenomeNode*)
+                                  gt_feature_node_get_multi_representative(fn));
+      mrange = gt_genome_node_get_range((GtGenomeNode*)
+                                 gt_feature_node_get_multi_representative(mfn));
+      gt_ensure(gt_range_compare(&range, &mrange) == 0);
+    }
+    gt_ensure(gt_feature_node_number_of_children(fn) ==
+              gt_feature_node_number_of_children(mfn));
+    attrs = gt_feature_node_get_attribute_list(fn);
+    for (i = 0; !had_err && i < gt_str_array_size(attrs); i++) {
+      const char *value;
+      value = gt_feature_node_get_attribute(mfn, gt_str_array_get(attrs, i));
+      gt_ensure(value != NULL &&
+                strcmp(value,
+                       gt_feature_node_get_attribute(fn,
+                                          gt_str_array_get(attrs, i))) == 0);
+    }
+    gt_str_array_delete(attrs);
+  }
+  if (!had_err)
+    gt_ensure(gt_feature_node_iterator_next(mfni) == NULL);
+  gt_feature_node_iterator_delete(mfni);
+  gt_feature_node_iterator_delete(fni);
+  return had_err;
+}
+
+static int feature_index_mapped_compare(GtFeatureIndex *fi,
+                                        GtFeatureIndex *fim,
+                                        const char *seqid,
+                                        const GtRange *range, GtError *err)
+{
+  GtArray *results, *mresults;
+  GtUword i;
+  int had_err = 0;
+
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  mresults = gt_array_new(sizeof (GtFeatureNode*));
+  had_err = gt_feature_index_get_features_for_range(fi, results, seqid, range,
+                                                    err);
+  if (!had_err) {
+    had_err = gt_feature_index_get_features_for_range(fim, mresults, seqid,
+                                                      range, err);
+  }
+  if (!had_err)
+    gt_ensure(gt_array_size(results) == gt_array_size(mresults));
+  for (i = 0; !had_err && i < gt_array_size(results); i++) {
+    had_err = feature_index_mapped_compare_trees(
+                              *(GtFeatureNode**) gt_array_get(results, i),
+                              *(GtFeatureNode**) gt_array_get(mresults, i),
+                              err);
+  }
+  gt_array_delete(mresults);
+  gt_array_delete(results);
+  return had_err;
+}
+
+int gt_feature_index_mapped_unit_test(GtError *err)
+{
+  GtFeatureIndexMappedWriter *writer;
+  GtFeatureIndex *fi, *fim = NULL;
+  GtFeatureNode *fn, *child, *grandchild, *pseudo;
+  GtGenomeNode *rn;
+  GtStr *seqid1, *seqid2, *source, *tmpfilename;
+  GtStrArray *seqids = NULL;
+  GtRange range, mrange;
+  char *firstseqid;
+  FILE *tmpfp;
+  GtUword i;
+  GtError *testerr;
+  bool has_seqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  testerr = gt_error_new();
+  seqid1 = gt_str_new_cstr("seq1");
+  seqid2 = gt_str_new_cstr("ctg0");
+  source = gt_str_new_cstr("unittest");
+  fi = gt_feature_index_memory_new();
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(tmpfp);
+  if (!(writer = gt_feature_index_mapped_writer_new(gt_str_get(tmpfilename),
+                                                    err)))
+    had_err = -1;
+
+  /* add the same nodes to a memory index and to the index file */
+  rn = gt_region_node_new(seqid1, 1, 100000);
+  if (!had_err)
+    had_err = gt_feature_index_add_region_node(fi, (GtRegionNode*) rn, err);
+  if (!had_err) {
+    had_err = gt_feature_index_mapped_writer_add_region_node(writer,
+                                                      (GtRegionNode*) rn, err);
+  }
+  gt_genome_node_delete(rn);
+  for (i = 0; !had_err && i < 500; i++) {
+    fn = feature_index_mapped_random_feature(seqid1, source, 100000);
+    if (i % 5 == 0) {
+      /* a DAG with a shared child and a multi-feature */
+      child = feature_index_mapped_random_feature(seqid1, source, 100000);
+      grandchild = feature_index_mapped_random_feature(seqid1, source, 100000);
+      gt_feature_node_add_child(fn, child);
+      gt_feature_node_add_child(child, grandchild);
+      child = feature_index_mapped_random_feature(seqid1, source, 100000);
+      gt_feature_node_add_child(fn, child);
+      gt_genome_node_ref((GtGenomeNode*) grandchild);
+      gt_feature_node_add_child(child, grandchild);
+      gt_feature_node_make_multi_representative(grandchild);
+      gt_feature_node_set_multi_representative(child, grandchild);
+    }
+    had_err = gt_feature_index_add_feature_node(fi, fn, err);
+    if (!had_err)
+      had_err = gt_feature_index_mapped_writer_add_feature_node(writer, fn,
+                                                                err);
+    gt_genome_node_delete((GtGenomeNode*) fn);
+  }
+  if (!had_err) {
+    pseudo = (GtFeatureNode*) gt_feature_node_new_pseudo(seqid2, 10, 500,
+                                                         GT_STRAND_FORWARD);
+    child = (GtFeatureNode*) gt_feature_node_new(seqid2, "match", 10, 100,
+                                                 GT_STRAND_FORWARD);
+    gt_feature_node_make_multi_representative(child);
+    gt_feature_node_add_child(pseudo, child);
+    grandchild = (GtFeatureNode*) gt_feature_node_new(seqid2, "match", 400,
+                                                      500, GT_STRAND_FORWARD);
+    gt_feature_node_set_multi_representative(grandchild, child);
+    gt_feature_node_add_child(pseudo, grandchild);
+    had_err = gt_feature_index_add_feature_node(fi, pseudo, err);
+    if (!had_err)
+      had_err = gt_feature_index_mapped_writer_add_feature_node(writer, pseudo,
+                                                                err);
+    gt_genome_node_delete((GtGenomeNode*) pseudo);
+  }
+
+  if (!had_err)
+    had_err = gt_feature_index_mapped_writer_finish(writer, err);
+  gt_feature_index_mapped_writer_delete(writer);
+  if (!had_err && !(fim = gt_feature_index_mapped_new(gt_str_get(tmpfilename),
+                                                      err)))
+    had_err = -1;
+
+  if (!had_err) {
+    seqids = gt_feature_index_get_seqids(fim, err);
+    gt_ensure(gt_str_array_size(seqids) == 2);
+    gt_ensure(strcmp(gt_str_array_get(seqids, 0), "ctg0") == 0);
+    gt_ensure(strcmp(gt_str_array_get(seqids, 1), "seq1") == 0);
+    firstseqid = gt_feature_index_get_first_seqid(fim, err);
+    gt_ensure(firstseqid && strcmp(firstseqid, "seq1") == 0);
+    gt_free(firstseqid);
+    gt_ensure(!gt_feature_index_has_seqid(fim, &has_seqid, "seq2", err));
+    gt_ensure(!has_seqid);
+    fn = feature_index_mapped_random_feature(seqid1, source, 100000);
+    gt_ensure(gt_feature_index_add_feature_node(fim, fn, testerr) == -1);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_unset(testerr);
+    gt_genome_node_delete((GtGenomeNode*) fn);
+  }
+  for (i = 0; !had_err && seqids && i < gt_str_array_size(seqids); i++) {
+    const char *seqid = gt_str_array_get(seqids, i);
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fi, &range, seqid, err));
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fim, &mrange, seqid,
+                                                    err));
+    gt_ensure(gt_range_compare(&range, &mrange) == 0);
+    if (!had_err)
+      had_err = feature_index_mapped_compare(fi, fim, seqid, &range, err);
+  }
+  for (i = 0; !had_err && i < 200; i++) {
+    range.start = gt_rand_max(100000) + 1;
+    range.end = range.start + gt_rand_max(i < 100 ? 100 : 10000);
+    had_err = feature_index_mapped_compare(fi, fim, "seq1", &range, err);
+  }
+  if (!had_err) {
+    GtArray *results = gt_array_new(sizeof (GtGenomeNode*));
+    gt_ensure(gt_feature_index_get_features_for_range(fim, results, "seq2",
+                                                      &range, testerr) == -1);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_array_delete(results);
+  }
+
+  gt_str_array_delete(seqids);
+  gt_feature_index_delete(fim);
+  gt_feature_index_delete(fi);
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  gt_str_delete(source);
+  gt_str_delete(seqid2);
+  gt_str_delete(seqid1);
+  gt_error_delete(testerr);
+  return had_err;
+}
@@ -0,0 +1,68 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FEATURE_INDEX_MAPPED_API_H
+#define FEATURE_INDEX_MAPPED_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexMapped> class implements a read-only <GtFeatureIndex>
+   on top of a memory mapped index file. Opening an index only maps the file,
+   the feature trees overlapping a query range are materialized on demand and
+   are owned by the index afterwards, just like the nodes returned by a
+   <GtFeatureIndexMemory>. */
+typedef struct GtFeatureIndexMapped GtFeatureIndexMapped;
+
+/* The <GtFeatureIndexMappedWriter> class writes the index files read by
+   <GtFeatureIndexMapped>. The feature trees are written as they are added,
+   only their ranges are kept in memory. */
+typedef struct GtFeatureIndexMappedWriter GtFeatureIndexMappedWriter;
+
+/* Creates a new <GtFeatureIndexMappedWriter> object writing to the index file
+   <filename>. Returns NULL and sets <err> if the file cannot be opened. */
+GtFeatureIndexMappedWriter* gt_feature_index_mapped_writer_new(const char
+                                                               *filename,
+                                                               GtError *err);
+
+/* Adds the sequence region given by <region_node> to <writer>. */
+int             gt_feature_index_mapped_writer_add_region_node(
+                                            GtFeatureIndexMappedWriter *writer,
+                                            GtRegionNode *region_node,
+                                            GtError *err);
+
+/* Adds the feature tree rooted at <feature_node> to <writer>. */
+int             gt_feature_index_mapped_writer_add_feature_node(
+                                            GtFeatureIndexMappedWriter *writer,
+                                            GtFeatureNode *feature_node,
+                                            GtError *err);
+
+/* Writes the index structures and closes the index file of <writer>.
+   Returns 0 on success, -1 otherwise (<err> is set accordingly). */
+int             gt_feature_index_mapped_writer_finish(
+                                            GtFeatureIndexMappedWriter *writer,
+                                            GtError *err);
+
+/* Deletes <writer>. */
+void            gt_feature_index_mapped_writer_delete(
+                                           GtFeatureIndexMappedWriter *writer);
+
+/* Creates a new <GtFeatureIndexMapped> object for the index file <filename>
+   written by a <GtFeatureIndexMappedWriter>. Returns NULL and sets <err>
+   if the file cannot be mapped or is not a valid index file. */
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename,
+                                            GtError *err);
+
+#endif
@@ -28,6 +28,7 @@
 #include "core/ma.h"
 #include "core/minmax.h"
 #include "core/range.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_index_memory.h"
@@ -41,6 +42,8 @@ struct GtFeatureIndexMemory {
   GtHashmap *regions;
   GtHashmap *nodes_in_index;
   GtArray *ids;
+  GtMutex *freeze_lock;
+  GtRWLock *tree_lock;
   char *firstseqid;
   GtUword nof_region_nodes,
                 reference_count,
@@ -50,10 +53,18 @@ struct GtFeatureIndexMemory {
 #define gt_feature_index_memory_cast(FI)\
         gt_feature_index_cast(gt_feature_index_memory_class(), FI)
 
+/* Freezing an interval tree costs about as much as a number of queries
+   proportional to its size. A tree is therefore frozen once it has been
+   queried MAX(GT_FEATURE_INDEX_MEMORY_FREEZE_QUERIES, size / 64) times without
+   being changed, which bounds the overhead of alternating changes and
+   queries. */
+#define GT_FEATURE_INDEX_MEMORY_FREEZE_QUERIES  16
+
 typedef struct {
   GtIntervalTree *features;
   GtRegionNode *region;
   GtRange dyn_range;
+  GtUword queries_since_change;
 } RegionInfo;
 
 static void region_info_delete(RegionInfo *info)
@@ -128,6 +139,7 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   /* add node to the appropriate array in the hashtable */
   new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
   gt_interval_tree_insert(info->features, new_node);
+  info->queries_since_change = 0;
   /* update dynamic range */
   info->dyn_range.start = MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = MAX(info->dyn_range.end, node_range.end);
@@ -178,8 +190,10 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                    node_range.end,
                                    &info);
 
-  if (info.node)
+  if (info.node) {
     gt_interval_tree_remove(rinfo->features, info.node);
+    rinfo->queries_since_change = 0;
+  }
   return 0;
 }
 
@@ -228,6 +242,7 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
 {
   RegionInfo *ri;
   GtFeatureIndexMemory *fi;
+  bool freeze;
   gt_error_check(err);
   gt_assert(gfi && results);
 
@@ -237,9 +252,25 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
+  /* queries may run concurrently, the tree must not be frozen while another
+     query is reading it */
+  gt_mutex_lock(fi->freeze_lock);
+  freeze = (++ri->queries_since_change ==
+            MAX(GT_FEATURE_INDEX_MEMORY_FREEZE_QUERIES,
+                gt_interval_tree_size(ri->features) / 64));
+  gt_mutex_unlock(fi->freeze_lock);
+  if (freeze) {
+    gt_rwlock_wrlock(fi->tree_lock);
+    gt_interval_tree_freeze(ri->features);
+    gt_rwlock_unlock(fi->tree_lock);
+  }
+  gt_rwlock_rdlock(fi->tree_lock);
   gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
                                         qry_range->end, results);
-  gt_array_sort(results, gt_genome_node_cmp_range_start);
+  gt_rwlock_unlock(fi->tree_lock);
+  /* frozen or not, the tree reports the features in the same order, which
+     is kept for features with equal ranges */
+  gt_array_sort_stable(results, gt_genome_node_cmp_range_start);
   return 0;
 }
 
@@ -358,6 +389,8 @@ void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
   fi = gt_feature_index_memory_cast(gfi);
   gt_hashmap_delete(fi->regions);
   gt_hashmap_delete(fi->nodes_in_index);
+  gt_mutex_delete(fi->freeze_lock);
+  gt_rwlock_delete(fi->tree_lock);
 }
 
 const GtFeatureIndexClass* gt_feature_index_memory_class(void)
@@ -393,6 +426,8 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   fim->regions = gt_hashmap_new(GT_HASH_STRING, NULL,
                                 (GtFree) region_info_delete);
   fim->nodes_in_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  fim->freeze_lock = gt_mutex_new();
+  fim->tree_lock = gt_rwlock_new();
   return fi;
 }
 
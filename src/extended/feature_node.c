@@ -20,6 +20,7 @@
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/cstr_api.h"
+#include "core/dlist.h"
 #include "core/ensure.h"
 #include "core/hashtable.h"
 #include "core/ma.h"
@@ -84,9 +85,12 @@ typedef struct {
 static void feature_node_free(GtGenomeNode *gn)
 {
   GtFeatureNode *fn = gt_feature_node_cast(gn);
-  gt_str_delete(fn->seqid);
-  gt_str_delete(fn->source);
-  gt_tag_value_map_delete(fn->attributes);
+  /* the strings of nodes in an arena belong to the arena */
+  if (!gn->arena) {
+    gt_str_delete(fn->seqid);
+    gt_str_delete(fn->source);
+  }
+  gt_tag_value_map_delete_in_arena(fn->attributes, gn->arena);
   if (fn->children) {
     GtDlistelem *dlistelem;
     for (dlistelem = gt_dlist_first(fn->children);
@@ -150,16 +154,24 @@ static void feature_node_change_seqid(GtGenomeNode *gn, GtStr *seqid)
 {
   GtFeatureNode *fn = gt_feature_node_cast(gn);
   gt_assert(fn && seqid);
-  gt_str_delete(fn->seqid);
-  fn->seqid = gt_str_ref(seqid);
+  if (gn->arena)
+    fn->seqid = gt_node_arena_get_str(gn->arena, seqid);
+  else {
+    gt_str_delete(fn->seqid);
+    fn->seqid = gt_str_ref(seqid);
+  }
 }
 
 void gt_feature_node_set_source(GtFeatureNode *fn, GtStr *source)
 {
   gt_assert(fn && source);
-  if (fn->source)
-    gt_str_delete(fn->source);
-  fn->source = gt_str_ref(source);
+  if (fn->parent_instance.arena)
+    fn->source = gt_node_arena_get_str(fn->parent_instance.arena, source);
+  else {
+    if (fn->source)
+      gt_str_delete(fn->source);
+    fn->source = gt_str_ref(source);
+  }
   if (fn->observer && fn->observer->source_changed)
     fn->observer->source_changed(fn, source, fn->observer->data);
 }
@@ -234,14 +246,22 @@ static void set_tree_status(unsigned int *bit_field, TreeStatus tree_status)
 GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
                                   GtUword start, GtUword end,
                                   GtStrand strand)
+{
+  return gt_feature_node_new_in_arena(NULL, seqid, type, start, end, strand);
+}
+
+GtGenomeNode* gt_feature_node_new_in_arena(GtNodeArena *arena, GtStr *seqid,
+                                           const char *type, GtUword start,
+                                           GtUword end, GtStrand strand)
 {
   GtGenomeNode *gn;
   GtFeatureNode *fn;
   gt_assert(seqid && type);
   gt_assert(start <= end);
-  gn = gt_genome_node_create(gt_feature_node_class());
+  gn = gt_genome_node_create_in_arena(gt_feature_node_class(), arena);
   fn = gt_feature_node_cast(gn);
-  fn->seqid       = gt_str_ref(seqid);
+  fn->seqid       = arena ? gt_node_arena_get_str(arena, seqid)
+                          : gt_str_ref(seqid);
   fn->source      = NULL;
   fn->type        = gt_symbol(type);
   fn->score       = GT_UNDEF_FLOAT;
@@ -670,10 +690,14 @@ void gt_feature_node_add_attribute(GtFeatureNode *fn,
   gt_assert(fn && attr_name && attr_value);
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
-  if (!fn->attributes)
-    fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
-  else
-    gt_tag_value_map_add(&fn->attributes, attr_name, attr_value);
+  if (!fn->attributes) {
+    fn->attributes = gt_tag_value_map_new_in_arena(fn->parent_instance.arena,
+                                                   attr_name, attr_value);
+  }
+  else {
+    gt_tag_value_map_add_in_arena(&fn->attributes, fn->parent_instance.arena,
+                                  attr_name, attr_value);
+  }
   if (fn->observer && fn->observer->attribute_changed) {
     fn->observer->attribute_changed(fn, true, attr_name, attr_value,
                                     fn->observer->data);
@@ -687,10 +711,14 @@ void gt_feature_node_set_attribute(GtFeatureNode *fn,
   gt_assert(fn && attr_name && attr_value);
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
-  if (!fn->attributes)
-    fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
-  else
-    gt_tag_value_map_set(&fn->attributes, attr_name, attr_value);
+  if (!fn->attributes) {
+    fn->attributes = gt_tag_value_map_new_in_arena(fn->parent_instance.arena,
+                                                   attr_name, attr_value);
+  }
+  else {
+    gt_tag_value_map_set_in_arena(&fn->attributes, fn->parent_instance.arena,
+                                  attr_name, attr_value);
+  }
   if (fn->observer && fn->observer->attribute_changed) {
     fn->observer->attribute_changed(fn, false, attr_name, attr_value,
                                     fn->observer->data);
@@ -704,10 +732,13 @@ void gt_feature_node_remove_attribute(GtFeatureNode *fn,
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(fn->attributes); /* attribute list must exist already */
   if (gt_tag_value_map_size(fn->attributes) == 1) {
-    gt_tag_value_map_delete(fn->attributes);
+    gt_tag_value_map_delete_in_arena(fn->attributes,
+                                     fn->parent_instance.arena);
     fn->attributes = NULL;
-  } else
-    gt_tag_value_map_remove(&fn->attributes, attr_name);
+  } else {
+    gt_tag_value_map_remove_in_arena(&fn->attributes,
+                                     fn->parent_instance.arena, attr_name);
+  }
   if (fn->observer && fn->observer->attribute_deleted) {
     fn->observer->attribute_deleted(fn, attr_name, fn->observer->data);
   }
@@ -812,8 +843,10 @@ bool gt_feature_node_is_similar(const GtFeatureNode *fn_a,
 
 int gt_feature_node_unit_test(GtError *err)
 {
-  GtGenomeNode *fn;
-  GtStr *seqid;
+  GtGenomeNode *fn, *exon;
+  GtNodeArena *arena;
+  GtStr *seqid, *source;
+  GtUword i, j;
   int had_err = 0;
 
   gt_error_check(err);
@@ -824,6 +857,39 @@ int gt_feature_node_unit_test(GtError *err)
   gt_ensure(!gt_feature_node_score_is_defined((GtFeatureNode*) fn));
 
   gt_genome_node_delete(fn);
+
+  /* a tree in an arena, first deleted node by node, then released in bulk */
+  for (i = 0; !had_err && i < 2; i++) {
+    arena = gt_node_arena_new();
+    source = gt_str_new_cstr("source");
+    fn = gt_feature_node_new_in_arena(arena, seqid, gt_ft_gene, 1, 1000,
+                                      GT_STRAND_FORWARD);
+    gt_feature_node_set_source((GtFeatureNode*) fn, source);
+    gt_feature_node_add_attribute((GtFeatureNode*) fn, "ID", "gene1");
+    gt_feature_node_set_attribute((GtFeatureNode*) fn, "Name", "gene1");
+    for (j = 0; j < 3; j++) {
+      exon = gt_feature_node_new_in_arena(arena, seqid, gt_ft_exon,
+                                          1 + j * 300, 200 + j * 300,
+                                          GT_STRAND_FORWARD);
+      gt_feature_node_add_attribute((GtFeatureNode*) exon, "Parent", "gene1");
+      gt_feature_node_add_child((GtFeatureNode*) fn, (GtFeatureNode*) exon);
+    }
+    gt_str_delete(source);
+    gt_ensure(gt_feature_node_number_of_children((GtFeatureNode*) fn) == 3);
+    gt_ensure(!strcmp(gt_feature_node_get_source((GtFeatureNode*) fn),
+                      "source"));
+    gt_ensure(!strcmp(gt_feature_node_get_attribute((GtFeatureNode*) fn,
+                                                    "Name"), "gene1"));
+    gt_ensure(gt_genome_node_get_seqid(fn) != seqid &&
+              !gt_str_cmp(gt_genome_node_get_seqid(fn), seqid));
+    if (i == 0) {
+      /* the nodes keep the arena alive */
+      gt_node_arena_delete(arena);
+      gt_genome_node_delete(fn);
+    }
+    else
+      gt_node_arena_release_all(arena);
+  }
   gt_str_delete(seqid);
 
   return had_err;
@@ -1091,6 +1157,16 @@ GtUword gt_feature_node_number_of_children_of_type(const GtFeatureNode
   return traverseinfo.number;
 }
 
+static void* feature_node_arena_alloc(size_t size, void *arena)
+{
+  return gt_node_arena_alloc(arena, size);
+}
+
+static void feature_node_arena_free(void *ptr, size_t size, void *arena)
+{
+  gt_node_arena_free(arena, ptr, size);
+}
+
 void gt_feature_node_add_child(GtFeatureNode *parent, GtFeatureNode *child)
 {
   gt_assert(parent && child);
@@ -1099,9 +1175,18 @@ void gt_feature_node_add_child(GtFeatureNode *parent, GtFeatureNode *child)
                         gt_genome_node_get_seqid((GtGenomeNode*) child)));
   /* pseudo-features have to be top-level */
   gt_assert(!gt_feature_node_is_pseudo((GtFeatureNode*) child));
-  /* create children list on demand */
-  if (!parent->children)
-    parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  /* create children list on demand, in the arena of <parent> if it has one */
+  if (!parent->children) {
+    GtNodeArena *arena = parent->parent_instance.arena;
+    if (arena) {
+      parent->children =
+        gt_dlist_new_with_allocator((GtCompare) gt_genome_node_cmp,
+                                    feature_node_arena_alloc,
+                                    feature_node_arena_free, arena);
+    }
+    else
+      parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  }
   gt_dlist_add(parent->children, child); /* XXX: check for cycles */
   /* update tree status of <parent> */
   set_tree_status(&parent->bit_field, TREE_STATUS_UNDETERMINED);
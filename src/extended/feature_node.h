@@ -26,12 +26,18 @@
 #include "extended/feature_node_observer.h"
 #include "extended/feature_type.h"
 #include "extended/genome_node.h"
+#include "extended/node_arena.h"
 #include "extended/transcript_feature_type.h"
 
 typedef int (*GtFeatureNodeTraverseFunc)(GtFeatureNode*, void*, GtError*);
 
 const GtGenomeNodeClass* gt_feature_node_class(void);
 
+/* Like <gt_feature_node_new()>, but the node is allocated from <arena>. */
+GtGenomeNode*  gt_feature_node_new_in_arena(GtNodeArena *arena, GtStr *seqid,
+                                            const char *type, GtUword start,
+                                            GtUword end, GtStrand strand);
+
 GtFeatureNode* gt_feature_node_clone(const GtFeatureNode*);
 void           gt_feature_node_get_exons(GtFeatureNode*,
                                          GtArray *exon_features);
@@ -213,18 +213,28 @@ static int compare_genome_nodes_with_delta(GtGenomeNode *gn_a,
 }
 
 GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+{
+  return gt_genome_node_create_in_arena(gnc, NULL);
+}
+
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass *gnc,
+                                             GtNodeArena *arena)
 {
   GtGenomeNode *gn;
   gt_assert(gnc && gnc->size);
-  gn                     = gt_malloc(gnc->size);
+  gn                     = arena ? gt_node_arena_alloc(arena, gnc->size)
+                                 : gt_malloc(gnc->size);
   gn->c_class            = gnc;
+  gn->arena              = arena;
   gn->filename           = NULL; /* means the node is generated */
   gn->line_number        = 0;
   gn->reference_count    = 0;
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
 #ifdef GT_THREADS_ENABLED
-  gn->lock              = gt_rwlock_new();
+  /* the nodes of an arena share its lock */
+  gn->lock              = arena ? gt_node_arena_get_node_lock(arena)
+                                : gt_rwlock_new();
 #endif
   return gn;
 }
@@ -233,8 +243,12 @@ void gt_genome_node_set_origin(GtGenomeNode *gn, GtStr *filename,
                                unsigned int line_number)
 {
   gt_assert(gn && filename && line_number);
-  gt_str_delete(gn->filename);
-  gn->filename = gt_str_ref(filename);
+  if (gn->arena)
+    gn->filename = gt_node_arena_get_str(gn->arena, filename);
+  else {
+    gt_str_delete(gn->filename);
+    gn->filename = gt_str_ref(filename);
+  }
   gn->line_number = line_number;
 }
 
@@ -529,15 +543,21 @@ void gt_genome_node_delete(GtGenomeNode *gn)
     gt_rwlock_unlock(gn->lock);
     return;
   }
+  /* the last reference is gone, the lock must not be held while the children
+     are deleted, they may share it */
+  gt_rwlock_unlock(gn->lock);
   gt_assert(gn->c_class);
   if (gn->c_class->free)
     gn->c_class->free(gn);
-  gt_str_delete(gn->filename);
   if (gn->userdata)
     gt_hashmap_delete(gn->userdata);
-  gt_rwlock_unlock(gn->lock);
+  if (gn->arena)
+    gt_node_arena_free(gn->arena, gn, gn->c_class->size);
+  else {
+    gt_str_delete(gn->filename);
 #ifdef GT_THREADS_ENABLED
-  gt_rwlock_delete(gn->lock);
+    gt_rwlock_delete(gn->lock);
 #endif
-  gt_free(gn);
+    gt_free(gn);
+  }
 }
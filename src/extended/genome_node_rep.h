@@ -23,6 +23,7 @@
 #include "core/hashmap.h"
 #include "core/thread_api.h"
 #include "extended/genome_node.h"
+#include "extended/node_arena.h"
 
 typedef void    (*GtGenomeNodeFreeFunc)(GtGenomeNode*);
 typedef GtStr*  (*GtGenomeNodeSetSeqidFunc)(GtGenomeNode*);
@@ -52,6 +53,7 @@ struct GtGenomeNode
   const GtGenomeNodeClass *c_class;
   GtStr *filename;
   GtHashmap *userdata; /* created on demand */
+  GtNodeArena *arena; /* the memory of the node, NULL if on the heap */
   /* GtGenomeNodes are very space critical, therefore we can justify a bit
      ifdef-hell here... */
 #ifdef GT_THREADS_ENABLED
@@ -71,5 +73,9 @@ const GtGenomeNodeClass* gt_genome_node_class_new(size_t size,
                                        GtGenomeNodeChangeSeqidFunc change_seqid,
                                        GtGenomeNodeAcceptFunc accept);
 GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass*);
+/* Like <gt_genome_node_create()>, but the node is allocated from <arena>
+   (which may be NULL). */
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass*,
+                                             GtNodeArena *arena);
 
 #endif
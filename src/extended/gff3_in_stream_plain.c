@@ -312,6 +312,13 @@ void gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream *ns)
   gt_gff3_parser_enable_tidy_mode(is->gff3_parser);
 }
 
+void gt_gff3_in_stream_plain_enable_node_arena(GtNodeStream *ns)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  gt_assert(is);
+  gt_gff3_parser_enable_node_arena(is->gff3_parser);
+}
+
 GtNodeStream* gt_gff3_in_stream_plain_new_unsorted(int num_of_files,
                                                    const char **filenames)
 {
@@ -44,6 +44,7 @@
 #include "extended/gff3_escaping.h"
 #include "extended/gff3_parser.h"
 #include "extended/mapping.h"
+#include "extended/node_arena.h"
 #include "extended/orphanage.h"
 #include "extended/region_node.h"
 #include "extended/xrf_checker_api.h"
@@ -66,6 +67,7 @@ struct GtGFF3Parser {
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   GtXRFChecker *xrf_checker;
+  GtNodeArena *node_arena; /* feature nodes are allocated from here */
   unsigned int last_terminator; /* line number of the last terminator */
 };
 
@@ -173,6 +175,13 @@ void gt_gff3_parser_enable_strict_mode(GtGFF3Parser *parser)
   parser->strict = true;
 }
 
+void gt_gff3_parser_enable_node_arena(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (!parser->node_arena)
+    parser->node_arena = gt_node_arena_new();
+}
+
 void gt_gff3_parser_enable_tidy_mode(GtGFF3Parser *parser)
 {
   gt_assert(parser && !parser->strict);
@@ -1597,8 +1606,9 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* create the feature */
   if (!had_err) {
-    feature_node = gt_feature_node_new(seqid_str, type, range.start, range.end,
-                                       gt_strand_value);
+    feature_node = gt_feature_node_new_in_arena(parser->node_arena, seqid_str,
+                                                type, range.start, range.end,
+                                                gt_strand_value);
     gt_genome_node_set_origin(feature_node, filenamestr, line_number);
   }
 
@@ -2208,5 +2218,6 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
   gt_xrf_checker_delete(parser->xrf_checker);
+  gt_node_arena_delete(parser->node_arena);
   gt_free(parser);
 }
@@ -21,6 +21,9 @@
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
+/* Allocate the parsed feature nodes from a <GtNodeArena>. The arena lives
+   until the parser and all nodes allocated from it have been deleted. */
+void gt_gff3_parser_enable_node_arena(GtGFF3Parser*);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
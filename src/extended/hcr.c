@@ -20,6 +20,7 @@
 #include <fcntl.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -34,9 +35,11 @@
 #include "core/intbits.h"
 #include "core/log_api.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/seq_iterator_fastq_api.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -54,6 +57,14 @@
 #define HCR_DESCSEPSEQ '@'
 #define HCR_DESCSEPQUAL '+'
 #define HCR_PAGES_PER_CHUNK 10UL
+/* number of reads encoded by one job of the multithreaded encoder, every
+   thread gets <HCR_JOBS_PER_THREAD> jobs per batch of reads */
+#define HCR_READS_PER_JOB 1024UL
+#define HCR_JOBS_PER_THREAD 4UL
+/* minimal number of reads per batch of decoded reads, every thread of the
+   multithreaded decoder gets <HCR_DECODE_JOBS_PER_THREAD> batches at once */
+#define HCR_DECODE_BATCHSIZE 4096UL
+#define HCR_DECODE_JOBS_PER_THREAD 2UL
 
 typedef struct GtBaseQualDistr {
   GtUint64 **distr;
@@ -134,6 +145,18 @@ typedef struct GtHcrSeqDecoder {
 struct GtHcrDecoder {
   GtEncdesc       *encdesc;
   GtHcrSeqDecoder *seq_dec;
+  GtStr           *name;
+};
+
+struct GtHcrRecordBatch {
+  GtStr   *seqs,
+          *quals,
+          *descs;
+  GtUword *seqstart,
+          *descstart,
+           first_readnum,
+           num_of_records,
+           allocated;
 };
 
 typedef struct WriteNodeInfo {
@@ -298,6 +321,31 @@ static int hcr_cmp_FastqFileInfo(const void *node1, const void *node2,
   return 0;
 }
 
+static inline GtUword hcr_seq_symbol(const GtHcrSeqEncoder *seq_encoder,
+                                     GtUchar base, GtUchar qual)
+{
+  unsigned cur_char_code = (unsigned) base,
+           cur_qual = (unsigned) qual;
+
+  if (cur_char_code == WILDCARD)
+    cur_char_code = gt_alphabet_size(seq_encoder->alpha) - 1;
+
+  if (seq_encoder->qrange.start != GT_UNDEF_UINT) {
+    if (cur_qual <= seq_encoder->qrange.start)
+      cur_qual = seq_encoder->qrange.start;
+  }
+
+  if (seq_encoder->qrange.end != GT_UNDEF_UINT) {
+    if (cur_qual >= seq_encoder->qrange.end)
+      cur_qual = seq_encoder->qrange.end;
+  }
+
+  cur_qual = cur_qual - seq_encoder->qual_offset;
+
+  return (GtUword) (gt_alphabet_size(seq_encoder->alpha) * cur_qual +
+                    cur_char_code);
+}
+
 static GtUword hcr_write_seq(GtHcrSeqEncoder *seq_encoder,
                                    const GtUchar *seq,
                                    const GtUchar *qual,
@@ -305,43 +353,106 @@ static GtUword hcr_write_seq(GtHcrSeqEncoder *seq_encoder,
                                    GtBitOutStream *bitstream,
                                    bool dry)
 {
-  unsigned bits_to_write,
-           cur_char_code,
-           cur_qual,
-           symbol;
+  unsigned bits_to_write;
   GtUword i,
                 written_bits = 0;
   GtBitsequence code;
 
   for (i = 0; i < len; i++) {
-    cur_char_code = (unsigned) seq[i];
+    gt_huffman_encode(seq_encoder->huffman,
+                      hcr_seq_symbol(seq_encoder, seq[i], qual[i]),
+                      &code, &bits_to_write);
+    written_bits += bits_to_write;
+    if (!dry) {
+      gt_bitoutstream_append(bitstream, code, bits_to_write);
+    }
+  }
+  return written_bits;
+}
 
-    if (cur_char_code == WILDCARD)
-      cur_char_code = gt_alphabet_size(seq_encoder->alpha) - 1;
+/* state of the sampling while writing the encoded reads */
+typedef struct {
+  GtUword read_counter,
+          page_counter,
+          bits_left_in_page;
+} HcrSamplingState;
 
-    cur_qual = (unsigned) qual[i];
+static void hcr_sampling_state_reset(HcrSamplingState *state,
+                                     const GtHcrEncoder *hcr_enc)
+{
+  state->read_counter = 0;
+  state->page_counter = 0;
+  gt_safe_assign(state->bits_left_in_page, (hcr_enc->pagesize * 8));
+}
 
-    if (seq_encoder->qrange.start != GT_UNDEF_UINT) {
-      if (cur_qual <= seq_encoder->qrange.start)
-        cur_qual = seq_encoder->qrange.start;
-    }
+/* adds a sample before the read with number <cur_read> of encoding size
+   <bits_to_write> if the sampling requires it */
+static int hcr_write_seqs_sample(GtHcrEncoder *hcr_enc,
+                                 GtBitOutStream *bitstream,
+                                 HcrSamplingState *state,
+                                 GtUword bits_to_write,
+                                 GtUword cur_read,
+                                 GtError *err)
+{
+  GtSampling *sampling = hcr_enc->seq_encoder->sampling;
+  GtWord filepos;
+
+  if (sampling != NULL &&
+      gt_sampling_is_next_element_sample(sampling,
+                                         state->page_counter,
+                                         state->read_counter,
+                                         bits_to_write,
+                                         state->bits_left_in_page)) {
+    gt_log_log("sampling read " GT_WU, cur_read);
+    gt_bitoutstream_flush_advance(bitstream);
 
-    if (seq_encoder->qrange.end != GT_UNDEF_UINT) {
-      if (cur_qual >= seq_encoder->qrange.end)
-        cur_qual = seq_encoder->qrange.end;
+    filepos = gt_bitoutstream_pos(bitstream);
+    if (filepos < 0) {
+      gt_error_set(err, "error by ftell: %s", strerror(errno));
+      return -1;
     }
+    gt_sampling_add_sample(sampling, (size_t) filepos, cur_read);
+    hcr_sampling_state_reset(state, hcr_enc);
+  }
+  return 0;
+}
 
-    cur_qual = cur_qual - seq_encoder->qual_offset;
+/* updates the counters for the sampling after a read of encoding size
+   <bits_to_write> was written */
+static void hcr_write_seqs_count(GtHcrEncoder *hcr_enc,
+                                 HcrSamplingState *state,
+                                 GtUword bits_to_write)
+{
+  while (state->bits_left_in_page < bits_to_write) {
+    state->page_counter++;
+    bits_to_write -= state->bits_left_in_page;
+    gt_safe_assign(state->bits_left_in_page, (hcr_enc->pagesize * 8));
+  }
+  state->bits_left_in_page -= bits_to_write;
+  /* always set first page as written */
+  if (state->page_counter == 0)
+    state->page_counter++;
+  state->read_counter++;
+}
 
-    symbol = gt_alphabet_size(seq_encoder->alpha) * cur_qual + cur_char_code;
-    gt_huffman_encode(seq_encoder->huffman, (GtUword) symbol,
-                      &code, &bits_to_write);
-    written_bits += bits_to_write;
-    if (!dry) {
-      gt_bitoutstream_append(bitstream, code, bits_to_write);
-    }
+static int hcr_write_seqs_finish(FILE *fp, GtHcrEncoder *hcr_enc,
+                                 GtBitOutStream *bitstream, GtError *err)
+{
+  GtWord filepos;
+
+  gt_bitoutstream_flush(bitstream);
+  filepos = gt_bitoutstream_pos(bitstream);
+  if (filepos < 0) {
+    gt_error_set(err, "error by ftell: %s", strerror(errno));
+    return -1;
   }
-  return written_bits;
+  hcr_enc->seq_encoder->startofsamplingtab = filepos;
+  gt_log_log("start of samplingtab: " GT_WU,
+             hcr_enc->seq_encoder->startofsamplingtab);
+  if (hcr_enc->seq_encoder->sampling != NULL) {
+    gt_sampling_write(hcr_enc->seq_encoder->sampling, fp);
+  }
+  return 0;
 }
 
 static int hcr_write_seqs(FILE *fp, GtHcrEncoder *hcr_enc, GtError *err)
@@ -349,11 +460,8 @@ static int hcr_write_seqs(FILE *fp, GtHcrEncoder *hcr_enc, GtError *err)
   int had_err = 0, seqit_err;
   GtUword bits_to_write = 0,
                 len,
-                read_counter = 0,
-                page_counter = 0,
-                bits_left_in_page,
                 cur_read = 0;
-  GtWord filepos;
+  HcrSamplingState state;
   GtSeqIterator *seqit;
   const GtUchar *seq,
                 *qual;
@@ -362,7 +470,7 @@ static int hcr_write_seqs(FILE *fp, GtHcrEncoder *hcr_enc, GtError *err)
 
   gt_error_check(err);
 
-  gt_safe_assign(bits_left_in_page, (hcr_enc->pagesize * 8));
+  hcr_sampling_state_reset(&state, hcr_enc);
 
   gt_xfseek(fp, hcr_enc->seq_encoder->start_of_encoding, SEEK_SET);
   bitstream = gt_bitoutstream_new(fp);
@@ -383,56 +491,23 @@ static int hcr_write_seqs(FILE *fp, GtHcrEncoder *hcr_enc, GtError *err)
                                             &seq,
                                             &len,
                                             &desc, err)) == 1) {
-      GtSampling *sampling = hcr_enc->seq_encoder->sampling;
-
       /* count the bits */
       bits_to_write = hcr_write_seq(hcr_enc->seq_encoder, seq, qual, len,
                                     bitstream, true);
 
       /* check if a new sample has to be added */
-      if (sampling != NULL &&
-          gt_sampling_is_next_element_sample(sampling,
-                                             page_counter,
-                                             read_counter,
-                                             bits_to_write,
-                                             bits_left_in_page)) {
-        gt_log_log("sampling read " GT_WU, cur_read);
-        gt_bitoutstream_flush_advance(bitstream);
-
-        filepos = gt_bitoutstream_pos(bitstream);
-        if (filepos < 0) {
-          had_err = -1;
-          gt_error_set(err, "error by ftell: %s", strerror(errno));
-        }
-        else {
-        gt_sampling_add_sample(sampling,
-                               (size_t) filepos,
-                               cur_read);
-
-        read_counter = 0;
-        page_counter = 0;
-        gt_safe_assign(bits_left_in_page, (hcr_enc->pagesize * 8));
-        }
-      }
+      had_err = hcr_write_seqs_sample(hcr_enc, bitstream, &state,
+                                      bits_to_write, cur_read, err);
 
       if (!had_err) {
-      /* do the writing */
-      bits_to_write = hcr_write_seq(hcr_enc->seq_encoder,
-                                    seq, qual, len, bitstream, false);
-
-      /* update counter for sampling */
-      while (bits_left_in_page < bits_to_write) {
-        page_counter++;
-        bits_to_write -= bits_left_in_page;
-        gt_safe_assign(bits_left_in_page, (hcr_enc->pagesize * 8));
-      }
-      bits_left_in_page -= bits_to_write;
-      /* always set first page as written */
-      if (page_counter == 0)
-        page_counter++;
-      read_counter++;
-      hcr_enc->seq_encoder->total_num_of_symbols += len;
-      cur_read++;
+        /* do the writing */
+        bits_to_write = hcr_write_seq(hcr_enc->seq_encoder,
+                                      seq, qual, len, bitstream, false);
+
+        /* update counter for sampling */
+        hcr_write_seqs_count(hcr_enc, &state, bits_to_write);
+        hcr_enc->seq_encoder->total_num_of_symbols += len;
+        cur_read++;
       }
     }
     gt_assert(hcr_enc->num_of_reads == cur_read);
@@ -442,22 +517,295 @@ static int hcr_write_seqs(FILE *fp, GtHcrEncoder *hcr_enc, GtError *err)
     }
   }
 
-  if (!had_err) {
-    gt_bitoutstream_flush(bitstream);
-    filepos = gt_bitoutstream_pos(bitstream);
-    if (filepos < 0) {
-      had_err = -1;
-      gt_error_set(err, "error by ftell: %s", strerror(errno));
+  if (!had_err)
+    had_err = hcr_write_seqs_finish(fp, hcr_enc, bitstream, err);
+  gt_bitoutstream_delete(bitstream);
+  gt_seq_iterator_delete(seqit);
+  return had_err;
+}
+
+/* A job of the multithreaded encoder: the reads <firstread> to <lastread - 1>
+   of a batch are Huffman encoded into the independent bit buffer <bits>. */
+typedef struct {
+  GtBitsequence *bits;
+  GtUword        firstread,
+                 lastread,
+                 numofbits,
+                 allocatedbits;
+} HcrEncodeJob;
+
+/* A batch of reads copied from the input files, all jobs of a batch are
+   encoded concurrently. The encoded reads are then written in the order of
+   the input files, hence the sampling table and the output do not depend on
+   the number of threads. */
+typedef struct {
+  const GtHcrSeqEncoder *seq_encoder;
+  GtUchar              *seqs,
+                       *quals;
+  GtUword              *readstart,
+                       *readbits,
+                        num_of_reads,
+                        max_num_of_reads,
+                        allocatedsymbols,
+                        nextjob;
+  HcrEncodeJob         *jobs;
+  GtUword               num_of_jobs;
+  GtMutex              *mutex;
+} HcrEncodeBatch;
+
+static void hcr_encode_job_append(HcrEncodeJob *job, GtBitsequence code,
+                                  unsigned codelength)
+{
+  GtUword word = job->numofbits / GT_INTWORDSIZE;
+  unsigned offset = (unsigned) (job->numofbits % GT_INTWORDSIZE),
+           free_bits = (unsigned) GT_INTWORDSIZE - offset;
+
+  if (codelength == 0)
+    return;
+  if (job->numofbits + codelength > job->allocatedbits) {
+    job->allocatedbits = job->allocatedbits * 2 + GT_INTWORDSIZE * 64;
+    job->bits = gt_realloc(job->bits, sizeof (*job->bits) *
+                           (job->allocatedbits / GT_INTWORDSIZE + 1));
+  }
+  if (offset == 0)
+    job->bits[word] = 0;
+  if (codelength <= free_bits)
+    job->bits[word] |= code << (free_bits - codelength);
+  else {
+    job->bits[word] |= code >> (codelength - free_bits);
+    job->bits[word + 1] = code << (GT_INTWORDSIZE - (codelength - free_bits));
+  }
+  job->numofbits += codelength;
+}
+
+static void hcr_encode_job_run(HcrEncodeBatch *batch, HcrEncodeJob *job)
+{
+  const GtHcrSeqEncoder *seq_encoder = batch->seq_encoder;
+  GtBitsequence code;
+  unsigned codelength;
+  GtUword r, i, startbits;
+
+  job->numofbits = 0;
+  for (r = job->firstread; r < job->lastread; r++) {
+    startbits = job->numofbits;
+    for (i = batch->readstart[r]; i < batch->readstart[r + 1]; i++) {
+      gt_huffman_encode(seq_encoder->huffman,
+                        hcr_seq_symbol(seq_encoder, batch->seqs[i],
+                                       batch->quals[i]),
+                        &code, &codelength);
+      hcr_encode_job_append(job, code, codelength);
     }
-    else {
-      hcr_enc->seq_encoder->startofsamplingtab = filepos;
-      gt_log_log("start of samplingtab: " GT_WU,
-                 hcr_enc->seq_encoder->startofsamplingtab);
-      if (hcr_enc->seq_encoder->sampling != NULL) {
-        gt_sampling_write(hcr_enc->seq_encoder->sampling, fp);
+    batch->readbits[r] = job->numofbits - startbits;
+  }
+}
+
+static void* hcr_encode_batch_thread(void *data)
+{
+  HcrEncodeBatch *batch = data;
+  GtUword jobnum;
+
+  for (;;) {
+    gt_mutex_lock(batch->mutex);
+    jobnum = batch->nextjob++;
+    gt_mutex_unlock(batch->mutex);
+    if (jobnum >= batch->num_of_jobs)
+      break;
+    hcr_encode_job_run(batch, batch->jobs + jobnum);
+  }
+  return NULL;
+}
+
+static void hcr_encode_batch_add(HcrEncodeBatch *batch, const GtUchar *seq,
+                                 const GtUchar *qual, GtUword len)
+{
+  GtUword start = batch->readstart[batch->num_of_reads];
+
+  gt_assert(batch->num_of_reads < batch->max_num_of_reads);
+  if (start + len > batch->allocatedsymbols) {
+    batch->allocatedsymbols = (start + len) * 2;
+    batch->seqs = gt_realloc(batch->seqs, sizeof (*batch->seqs) *
+                             batch->allocatedsymbols);
+    batch->quals = gt_realloc(batch->quals, sizeof (*batch->quals) *
+                              batch->allocatedsymbols);
+  }
+  memcpy(batch->seqs + start, seq, sizeof (*seq) * len);
+  memcpy(batch->quals + start, qual, sizeof (*qual) * len);
+  batch->readstart[++batch->num_of_reads] = start + len;
+}
+
+/* encodes all reads of <batch> using <threads> threads, the current thread
+   encodes as well. If a thread cannot be created, the others take over its
+   share. */
+static void hcr_encode_batch_compute(HcrEncodeBatch *batch,
+                                     unsigned int threads)
+{
+  GtThread **threadtab;
+  GtError *err;
+  GtUword j;
+  unsigned int t;
+
+  batch->num_of_jobs = (batch->num_of_reads + HCR_READS_PER_JOB - 1) /
+                       HCR_READS_PER_JOB;
+  for (j = 0; j < batch->num_of_jobs; j++) {
+    batch->jobs[j].firstread = j * HCR_READS_PER_JOB;
+    batch->jobs[j].lastread = MIN(batch->num_of_reads,
+                                  (j + 1) * HCR_READS_PER_JOB);
+  }
+  batch->nextjob = 0;
+  if (threads > batch->num_of_jobs)
+    threads = (unsigned int) batch->num_of_jobs;
+
+  threadtab = gt_calloc((size_t) threads, sizeof (*threadtab));
+  err = gt_error_new();
+  for (t = 1U; t < threads; t++) {
+    threadtab[t] = gt_thread_new(hcr_encode_batch_thread, batch, err);
+    if (!threadtab[t])
+      gt_error_unset(err);
+  }
+  (void) hcr_encode_batch_thread(batch);
+  for (t = 1U; t < threads; t++) {
+    if (threadtab[t]) {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threadtab[t]);
+#endif
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(threadtab);
+}
+
+/* appends the <len> bits of <bits> starting at bit <from> to <bitstream> */
+static void hcr_bitoutstream_append_bits(GtBitOutStream *bitstream,
+                                         const GtBitsequence *bits,
+                                         GtUword from, GtUword len)
+{
+  const unsigned maxbits = (unsigned) GT_INTWORDSIZE / 2;
+  GtBitsequence value;
+  GtUword word;
+  unsigned offset, n;
+
+  while (len > 0) {
+    n = len < (GtUword) maxbits ? (unsigned) len : maxbits;
+    word = from / GT_INTWORDSIZE;
+    offset = (unsigned) (from % GT_INTWORDSIZE);
+    value = bits[word] << offset;
+    if (offset + n > (unsigned) GT_INTWORDSIZE)
+      value |= bits[word + 1] >> (GT_INTWORDSIZE - offset);
+    gt_bitoutstream_append(bitstream, value >> (GT_INTWORDSIZE - n), n);
+    from += n;
+    len -= n;
+  }
+}
+
+static int hcr_encode_batch_write(HcrEncodeBatch *batch, GtHcrEncoder *hcr_enc,
+                                  GtBitOutStream *bitstream,
+                                  HcrSamplingState *state, GtUword *cur_read,
+                                  GtError *err)
+{
+  int had_err = 0;
+  GtUword j, r, from;
+
+  for (j = 0; !had_err && j < batch->num_of_jobs; j++) {
+    HcrEncodeJob *job = batch->jobs + j;
+    from = 0;
+    for (r = job->firstread; !had_err && r < job->lastread; r++) {
+      had_err = hcr_write_seqs_sample(hcr_enc, bitstream, state,
+                                      batch->readbits[r], *cur_read, err);
+      if (!had_err) {
+        hcr_bitoutstream_append_bits(bitstream, job->bits, from,
+                                     batch->readbits[r]);
+        from += batch->readbits[r];
+        hcr_write_seqs_count(hcr_enc, state, batch->readbits[r]);
+        (*cur_read)++;
       }
     }
   }
+  hcr_enc->seq_encoder->total_num_of_symbols +=
+    batch->readstart[batch->num_of_reads];
+  batch->num_of_reads = 0;
+  return had_err;
+}
+
+/* Like <hcr_write_seqs()>, but the reads are collected in batches, which are
+   Huffman encoded by <threads> threads into independent bit buffers. The
+   buffers are concatenated by the current thread, adding the samples between
+   the reads exactly like the single threaded encoder. */
+static int hcr_write_seqs_threaded(FILE *fp, GtHcrEncoder *hcr_enc,
+                                   unsigned int threads, GtError *err)
+{
+  int had_err = 0, seqit_err = 0;
+  GtUword len,
+          j,
+          cur_read = 0;
+  HcrSamplingState state;
+  HcrEncodeBatch batch;
+  GtSeqIterator *seqit;
+  const GtUchar *seq,
+                *qual;
+  char *desc;
+  GtBitOutStream *bitstream;
+
+  gt_error_check(err);
+  gt_assert(threads > 1U);
+
+  hcr_sampling_state_reset(&state, hcr_enc);
+
+  gt_xfseek(fp, hcr_enc->seq_encoder->start_of_encoding, SEEK_SET);
+  bitstream = gt_bitoutstream_new(fp);
+
+  memset(&batch, 0, sizeof (batch));
+  batch.seq_encoder = hcr_enc->seq_encoder;
+  batch.max_num_of_reads = threads * HCR_JOBS_PER_THREAD * HCR_READS_PER_JOB;
+  batch.readstart = gt_calloc((size_t) batch.max_num_of_reads + 1,
+                              sizeof (*batch.readstart));
+  batch.readbits = gt_malloc(sizeof (*batch.readbits) *
+                             batch.max_num_of_reads);
+  batch.jobs = gt_calloc((size_t) (threads * HCR_JOBS_PER_THREAD),
+                         sizeof (*batch.jobs));
+  batch.mutex = gt_mutex_new();
+
+  seqit = gt_seq_iterator_fastq_new(hcr_enc->files, err);
+  if (!seqit) {
+    gt_assert(gt_error_is_set(err));
+    had_err = -1;
+  }
+
+  if (!had_err) {
+    gt_seq_iterator_set_quality_buffer(seqit, &qual);
+    gt_seq_iterator_set_symbolmap(seqit,
+                            gt_alphabet_symbolmap(hcr_enc->seq_encoder->alpha));
+    hcr_enc->seq_encoder->total_num_of_symbols = 0;
+    seqit_err = 1;
+    while (!had_err && seqit_err == 1) {
+      while (batch.num_of_reads < batch.max_num_of_reads &&
+             (seqit_err = gt_seq_iterator_next(seqit, &seq, &len, &desc,
+                                               err)) == 1) {
+        hcr_encode_batch_add(&batch, seq, qual, len);
+      }
+      if (batch.num_of_reads == 0)
+        break;
+      hcr_encode_batch_compute(&batch, threads);
+      had_err = hcr_encode_batch_write(&batch, hcr_enc, bitstream, &state,
+                                       &cur_read, err);
+    }
+    if (!had_err && seqit_err) {
+      had_err = seqit_err;
+      gt_assert(gt_error_is_set(err));
+    }
+    gt_assert(had_err || hcr_enc->num_of_reads == cur_read);
+  }
+
+  if (!had_err)
+    had_err = hcr_write_seqs_finish(fp, hcr_enc, bitstream, err);
+  for (j = 0; j < threads * HCR_JOBS_PER_THREAD; j++)
+    gt_free(batch.jobs[j].bits);
+  gt_free(batch.jobs);
+  gt_free(batch.seqs);
+  gt_free(batch.quals);
+  gt_free(batch.readstart);
+  gt_free(batch.readbits);
+  gt_mutex_delete(batch.mutex);
   gt_bitoutstream_delete(bitstream);
   gt_seq_iterator_delete(seqit);
   return had_err;
@@ -566,7 +914,10 @@ static int hcr_write_seq_qual_data(const char *name, GtHcrEncoder *hcr_enc,
           gt_sampling_new_regular(hcr_enc->sampling_rate,
                                (off_t) hcr_enc->seq_encoder->start_of_encoding);
 
-      had_err = hcr_write_seqs(fp, hcr_enc, err);
+      if (gt_jobs > 1U)
+        had_err = hcr_write_seqs_threaded(fp, hcr_enc, gt_jobs, err);
+      else
+        had_err = hcr_write_seqs(fp, hcr_enc, err);
     }
     if (!had_err) {
       gt_assert(fp);
@@ -832,6 +1183,7 @@ GtHcrDecoder *gt_hcr_decoder_new(const char *name, GtAlphabet *alpha,
 
   hcr_dec = gt_malloc(sizeof (GtHcrDecoder));
   hcr_dec->seq_dec = NULL;
+  hcr_dec->name = gt_str_new_cstr(name);
 
   if (descs) {
     hcr_dec->encdesc = gt_encdesc_load(name, err);
@@ -1023,63 +1375,415 @@ int gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec, GtUword readnum,
   return had_err;
 }
 
+static GtHcrRecordBatch* hcr_record_batch_new(bool descs)
+{
+  GtHcrRecordBatch *batch = gt_calloc((size_t) 1, sizeof (*batch));
+  batch->seqs = gt_str_new();
+  batch->quals = gt_str_new();
+  if (descs)
+    batch->descs = gt_str_new();
+  return batch;
+}
+
+static void hcr_record_batch_reset(GtHcrRecordBatch *batch,
+                                   GtUword first_readnum)
+{
+  gt_str_reset(batch->seqs);
+  gt_str_reset(batch->quals);
+  if (batch->descs != NULL)
+    gt_str_reset(batch->descs);
+  batch->first_readnum = first_readnum;
+  batch->num_of_records = 0;
+}
+
+static void hcr_record_batch_add(GtHcrRecordBatch *batch, const char *seq,
+                                 const char *qual, const GtStr *desc)
+{
+  if (batch->num_of_records == batch->allocated) {
+    batch->allocated = batch->allocated * 2 + 16UL;
+    batch->seqstart = gt_realloc(batch->seqstart, sizeof (*batch->seqstart) *
+                                 batch->allocated);
+    batch->descstart = gt_realloc(batch->descstart,
+                                  sizeof (*batch->descstart) *
+                                  batch->allocated);
+  }
+  /* the records are stored '\0' separated */
+  batch->seqstart[batch->num_of_records] = gt_str_length(batch->seqs);
+  gt_str_append_cstr(batch->seqs, seq);
+  gt_str_append_char(batch->seqs, '\0');
+  gt_str_append_cstr(batch->quals, qual);
+  gt_str_append_char(batch->quals, '\0');
+  if (batch->descs != NULL) {
+    batch->descstart[batch->num_of_records] = gt_str_length(batch->descs);
+    gt_str_append_str(batch->descs, desc);
+    gt_str_append_char(batch->descs, '\0');
+  }
+  batch->num_of_records++;
+}
+
+static void hcr_record_batch_delete(GtHcrRecordBatch *batch)
+{
+  if (batch == NULL)
+    return;
+  gt_str_delete(batch->seqs);
+  gt_str_delete(batch->quals);
+  gt_str_delete(batch->descs);
+  gt_free(batch->seqstart);
+  gt_free(batch->descstart);
+  gt_free(batch);
+}
+
+GtUword gt_hcr_record_batch_first_readnum(const GtHcrRecordBatch *batch)
+{
+  gt_assert(batch);
+  return batch->first_readnum;
+}
+
+GtUword gt_hcr_record_batch_size(const GtHcrRecordBatch *batch)
+{
+  gt_assert(batch);
+  return batch->num_of_records;
+}
+
+const char* gt_hcr_record_batch_get_seq(const GtHcrRecordBatch *batch,
+                                        GtUword idx)
+{
+  gt_assert(batch && idx < batch->num_of_records);
+  return gt_str_get(batch->seqs) + batch->seqstart[idx];
+}
+
+const char* gt_hcr_record_batch_get_qual(const GtHcrRecordBatch *batch,
+                                         GtUword idx)
+{
+  gt_assert(batch && idx < batch->num_of_records);
+  return gt_str_get(batch->quals) + batch->seqstart[idx];
+}
+
+const char* gt_hcr_record_batch_get_desc(const GtHcrRecordBatch *batch,
+                                         GtUword idx)
+{
+  gt_assert(batch && idx < batch->num_of_records);
+  if (batch->descs == NULL)
+    return NULL;
+  return gt_str_get(batch->descs) + batch->descstart[idx];
+}
+
+/* the buffers of a thread decoding reads with its own decoder */
+typedef struct {
+  GtHcrDecoder *hcr_dec;
+  char         *seq,
+               *qual;
+  GtStr        *desc;
+  void         *shared;
+} HcrDecodeWorker;
+
+static void hcr_decode_worker_init(HcrDecodeWorker *worker,
+                                   GtHcrDecoder *hcr_dec)
+{
+  GtUword i, maxlength = 0;
+
+  for (i = 0; i < hcr_dec->seq_dec->num_of_files; i++)
+    maxlength = MAX(maxlength, hcr_dec->seq_dec->fileinfos[i].readlength);
+  worker->hcr_dec = hcr_dec;
+  worker->seq = gt_malloc(sizeof (*worker->seq) * (maxlength + 1));
+  worker->qual = gt_malloc(sizeof (*worker->qual) * (maxlength + 1));
+  worker->desc = gt_str_new();
+}
+
+static void hcr_decode_worker_free(HcrDecodeWorker *worker)
+{
+  gt_free(worker->seq);
+  gt_free(worker->qual);
+  gt_str_delete(worker->desc);
+}
+
+/* decodes the reads <from> to <to - 1> into <batch> */
+static int hcr_decode_batch(HcrDecodeWorker *worker, GtHcrRecordBatch *batch,
+                            GtUword from, GtUword to, GtError *err)
+{
+  int had_err = 0;
+  GtUword readnum;
+
+  hcr_record_batch_reset(batch, from);
+  for (readnum = from; !had_err && readnum < to; readnum++) {
+    had_err = gt_hcr_decoder_decode(worker->hcr_dec, readnum, worker->seq,
+                                    worker->qual, worker->desc, err);
+    if (!had_err)
+      hcr_record_batch_add(batch, worker->seq, worker->qual, worker->desc);
+  }
+  return had_err;
+}
+
+/* a batch of reads decoded by one of the threads */
+typedef struct {
+  GtHcrRecordBatch *batch;
+  GtError          *err;
+  GtUword           from,
+                    to;
+  int               had_err;
+} HcrDecodeJob;
+
+typedef struct {
+  HcrDecodeJob *jobs;
+  GtUword       num_of_jobs,
+                nextjob;
+  GtMutex      *mutex;
+} HcrDecodeRound;
+
+static void* hcr_decode_thread(void *data)
+{
+  HcrDecodeWorker *worker = data;
+  HcrDecodeRound *round = worker->shared;
+  HcrDecodeJob *job;
+  GtUword jobnum;
+
+  for (;;) {
+    gt_mutex_lock(round->mutex);
+    jobnum = round->nextjob++;
+    gt_mutex_unlock(round->mutex);
+    if (jobnum >= round->num_of_jobs)
+      break;
+    job = round->jobs + jobnum;
+    gt_error_unset(job->err);
+    job->had_err = hcr_decode_batch(worker, job->batch, job->from, job->to,
+                                    job->err);
+  }
+  return NULL;
+}
+
+/* decodes the jobs of <round> with <threads> threads, the current thread
+   uses <workers[0]>. If a thread cannot be created, the others take over its
+   share. */
+static void hcr_decode_round(HcrDecodeRound *round, HcrDecodeWorker *workers,
+                             unsigned int threads)
+{
+  GtThread **threadtab;
+  GtError *err;
+  unsigned int t;
+
+  round->nextjob = 0;
+  if (threads > round->num_of_jobs)
+    threads = (unsigned int) round->num_of_jobs;
+  threadtab = gt_calloc((size_t) threads, sizeof (*threadtab));
+  err = gt_error_new();
+  for (t = 1U; t < threads; t++) {
+    threadtab[t] = gt_thread_new(hcr_decode_thread, workers + t, err);
+    if (!threadtab[t])
+      gt_error_unset(err);
+  }
+  (void) hcr_decode_thread(workers);
+  for (t = 1U; t < threads; t++) {
+    if (threadtab[t]) {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threadtab[t]);
+#endif
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(threadtab);
+}
+
+/* returns the borders of the batches decoded by the threads, all except the
+   first one are sampled reads. The number of borders is stored in
+   <num_of_borders>. */
+static GtUword* hcr_decode_batch_borders(const GtSampling *sampling,
+                                         GtUword start, GtUword end,
+                                         GtUword *num_of_borders)
+{
+  GtUword *borders, i, elementnum, num = 0,
+          num_of_samples = gt_sampling_num_of_samples(sampling);
+
+  borders = gt_malloc(sizeof (*borders) * (num_of_samples + 2));
+  borders[num++] = start;
+  for (i = 0; i < num_of_samples; i++) {
+    elementnum = gt_sampling_get_sample_elementnum(sampling, i);
+    if (elementnum > end)
+      break;
+    if (elementnum >= borders[num - 1] + HCR_DECODE_BATCHSIZE)
+      borders[num++] = elementnum;
+  }
+  borders[num++] = end + 1;
+  *num_of_borders = num;
+  return borders;
+}
+
+static int hcr_decode_range_batches_threaded(GtHcrDecoder *hcr_dec,
+                                             GtUword start, GtUword end,
+                                             unsigned int threads,
+                                             GtHcrRecordBatchFunc func,
+                                             void *data, GtError *err)
+{
+  int had_err = 0;
+  HcrDecodeWorker *workers;
+  HcrDecodeRound round;
+  GtUword *borders, num_of_borders, num_of_slots, b, j;
+  unsigned int t;
+
+  borders = hcr_decode_batch_borders(hcr_dec->seq_dec->sampling, start, end,
+                                     &num_of_borders);
+  num_of_slots = threads * HCR_DECODE_JOBS_PER_THREAD;
+  round.jobs = gt_calloc((size_t) num_of_slots, sizeof (*round.jobs));
+  for (j = 0; j < num_of_slots; j++) {
+    round.jobs[j].batch = hcr_record_batch_new(hcr_dec->encdesc != NULL);
+    round.jobs[j].err = gt_error_new();
+  }
+  round.mutex = gt_mutex_new();
+
+  /* every thread needs a decoder of its own, the current one uses
+     <hcr_dec> */
+  workers = gt_calloc((size_t) threads, sizeof (*workers));
+  hcr_decode_worker_init(workers, hcr_dec);
+  workers[0].shared = &round;
+  for (t = 1U; !had_err && t < threads; t++) {
+    GtHcrDecoder *thread_dec =
+      gt_hcr_decoder_new(gt_str_get(hcr_dec->name), hcr_dec->seq_dec->alpha,
+                         hcr_dec->encdesc != NULL, NULL, err);
+    if (thread_dec == NULL)
+      had_err = -1;
+    else {
+      hcr_decode_worker_init(workers + t, thread_dec);
+      workers[t].shared = &round;
+    }
+  }
+
+  for (b = 0; !had_err && b + 1 < num_of_borders; b += round.num_of_jobs) {
+    round.num_of_jobs = MIN(num_of_slots, num_of_borders - 1 - b);
+    for (j = 0; j < round.num_of_jobs; j++) {
+      round.jobs[j].from = borders[b + j];
+      round.jobs[j].to = borders[b + j + 1];
+    }
+    hcr_decode_round(&round, workers, threads);
+    /* pass the batches on in the order of the reads */
+    for (j = 0; !had_err && j < round.num_of_jobs; j++) {
+      if (round.jobs[j].had_err) {
+        gt_error_set(err, "%s", gt_error_get(round.jobs[j].err));
+        had_err = -1;
+      }
+      else
+        had_err = func(round.jobs[j].batch, data, err);
+    }
+  }
+
+  for (t = 0; t < threads; t++) {
+    if (workers[t].hcr_dec != NULL) {
+      if (t > 0)
+        gt_hcr_decoder_delete(workers[t].hcr_dec);
+      hcr_decode_worker_free(workers + t);
+    }
+  }
+  gt_free(workers);
+  for (j = 0; j < num_of_slots; j++) {
+    hcr_record_batch_delete(round.jobs[j].batch);
+    gt_error_delete(round.jobs[j].err);
+  }
+  gt_free(round.jobs);
+  gt_mutex_delete(round.mutex);
+  gt_free(borders);
+  return had_err;
+}
+
+int gt_hcr_decoder_decode_range_batches(GtHcrDecoder *hcr_dec,
+                                        GtUword start, GtUword end,
+                                        unsigned int threads,
+                                        GtHcrRecordBatchFunc func,
+                                        void *data, GtError *err)
+{
+  int had_err = 0;
+  HcrDecodeWorker worker;
+  GtHcrRecordBatch *batch;
+  GtUword from;
+
+  gt_error_check(err);
+  gt_assert(hcr_dec && func && threads > 0);
+  gt_assert(start <= end && end < hcr_dec->seq_dec->num_of_reads);
+
+  if (threads > 1U && hcr_dec->seq_dec->sampling != NULL)
+    return hcr_decode_range_batches_threaded(hcr_dec, start, end, threads,
+                                             func, data, err);
+
+  hcr_decode_worker_init(&worker, hcr_dec);
+  batch = hcr_record_batch_new(hcr_dec->encdesc != NULL);
+  for (from = start; !had_err && from <= end; from += HCR_DECODE_BATCHSIZE) {
+    had_err = hcr_decode_batch(&worker, batch, from,
+                               MIN(end + 1, from + HCR_DECODE_BATCHSIZE), err);
+    if (!had_err)
+      had_err = func(batch, data, err);
+  }
+  hcr_record_batch_delete(batch);
+  hcr_decode_worker_free(&worker);
+  return had_err;
+}
+
+static void hcr_write_wrapped(const char *text, GtUword width, FILE *output)
+{
+  GtUword cur_width;
+  size_t i;
+
+  for (i = 0, cur_width = 0; text[i] != '\0'; i++, cur_width++) {
+    if (width != 0 && cur_width == width) {
+      cur_width = 0;
+      gt_xfputc('\n', output);
+    }
+    gt_xfputc(text[i], output);
+  }
+  gt_xfputc('\n', output);
+}
+
+typedef struct {
+  FILE   *output;
+  GtUword width;
+} HcrWriteFastqInfo;
+
+static int hcr_write_fastq_batch(const GtHcrRecordBatch *batch, void *data,
+                                 GT_UNUSED GtError *err)
+{
+  HcrWriteFastqInfo *info = data;
+  const char *desc;
+  GtUword idx;
+
+  for (idx = 0; idx < gt_hcr_record_batch_size(batch); idx++) {
+    gt_xfputc(HCR_DESCSEPSEQ, info->output);
+    if ((desc = gt_hcr_record_batch_get_desc(batch, idx)) != NULL)
+      gt_xfputs(desc, info->output);
+    else
+      fprintf(info->output, ""GT_WU"",
+              gt_hcr_record_batch_first_readnum(batch) + idx);
+    gt_xfputc('\n', info->output);
+    hcr_write_wrapped(gt_hcr_record_batch_get_seq(batch, idx), info->width,
+                      info->output);
+    gt_xfputc(HCR_DESCSEPQUAL, info->output);
+    gt_xfputc('\n', info->output);
+    hcr_write_wrapped(gt_hcr_record_batch_get_qual(batch, idx), info->width,
+                      info->output);
+  }
+  return 0;
+}
+
 int gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec, const char *name,
                                 GtUword start, GtUword end, GtUword width,
                                 GtTimer *timer, GtError *err)
 {
-  char qual[BUFSIZ] = {0},
-       seq[BUFSIZ] = {0};
-  GtStr *desc = gt_str_new();
   int had_err = 0;
-  GtUword cur_width,
-                cur_read;
-  size_t i;
-  FILE *output;
-  GT_UNUSED GtHcrSeqDecoder *seq_dec;
+  HcrWriteFastqInfo info;
 
   gt_error_check(err);
   gt_assert(hcr_dec && name);
-  seq_dec = hcr_dec->seq_dec;
   gt_assert(start <= end);
-  gt_assert(start < seq_dec->num_of_reads && end < seq_dec->num_of_reads);
+  gt_assert(start < hcr_dec->seq_dec->num_of_reads &&
+            end < hcr_dec->seq_dec->num_of_reads);
   if (timer != NULL)
     gt_timer_show_progress(timer, "decode hcr", stdout);
-  output = gt_fa_fopen_with_suffix(name, HCRFILEDECODEDSUFFIX, "w", err);
-  if (output == NULL)
+  info.width = width;
+  info.output = gt_fa_fopen_with_suffix(name, HCRFILEDECODEDSUFFIX, "w", err);
+  if (info.output == NULL)
     had_err = -1;
 
-  for (cur_read = start; had_err == 0 && cur_read <= end; cur_read++) {
-    if (gt_hcr_decoder_decode(hcr_dec, cur_read, seq, qual, desc, err) != 0)
-      had_err = -1;
-    else {
-      gt_xfputc(HCR_DESCSEPSEQ, output);
-      if (hcr_dec->encdesc != NULL)
-        gt_xfputs(gt_str_get(desc), output);
-      else
-        fprintf(output, ""GT_WU"", cur_read);
-      gt_xfputc('\n', output);
-      for (i = 0, cur_width = 0; i < strlen(seq); i++, cur_width++) {
-        if (width != 0 && cur_width == width) {
-          cur_width = 0;
-          gt_xfputc('\n', output);
-        }
-        gt_xfputc(seq[i], output);
-      }
-      gt_xfputc('\n', output);
-      gt_xfputc(HCR_DESCSEPQUAL, output);
-      gt_xfputc('\n', output);
-      for (i = 0, cur_width = 0; i < strlen(qual); i++, cur_width++) {
-        if (width != 0 && cur_width == width) {
-          cur_width = 0;
-          gt_xfputc('\n', output);
-        }
-        gt_xfputc(qual[i], output);
-      }
-      gt_xfputc('\n', output);
-    }
-  }
-  gt_fa_xfclose(output);
-  gt_str_delete(desc);
+  if (!had_err)
+    had_err = gt_hcr_decoder_decode_range_batches(hcr_dec, start, end, gt_jobs,
+                                                  hcr_write_fastq_batch, &info,
+                                                  err);
+  gt_fa_xfclose(info.output);
   return had_err;
 }
 
@@ -1097,24 +1801,207 @@ GtUword gt_hcr_decoder_readlength(GtHcrDecoder *hcr_dec,
   return hcr_dec->seq_dec->fileinfos[filenum].readlength;
 }
 
-GtHcrEncoder *gt_hcr_encoder_new(GtStrArray *files, GtAlphabet *alpha,
-                                 bool descs, GtQualRange qrange, GtTimer *timer,
-                                 GtError *err)
+/* checks if the reads in file <filename> are of the same length and adds
+   their <base, quality> pairs to <bqd>. The number of reads and the read
+   length are stored in <num_of_reads> and <readlength>. */
+static int hcr_base_qual_distr_add_file(GtBaseQualDistr *bqd,
+                                        GtStr *filename,
+                                        GtAlphabet *alpha,
+                                        GtUword *num_of_reads,
+                                        GtUword *readlength,
+                                        GtError *err)
 {
-  GtBaseQualDistr *bqd;
-  GtHcrEncoder *hcr_enc;
   GtSeqIterator *seqit;
   GtStrArray *file;
   int had_err = 0,
       status;
-  GtUword len1,
-                len2,
-                i,
-                num_of_reads = 0;
+  GtUword len1 = 0,
+          len2;
   const GtUchar *seq,
                 *qual;
   char *desc;
 
+  *num_of_reads = 0;
+  file = gt_str_array_new();
+  gt_str_array_add(file, filename);
+  seqit = gt_seq_iterator_fastq_new(file, err);
+  if (!seqit) {
+    gt_error_set(err, "cannot initialize GtSeqIteratorFastQ object");
+    had_err = -1;
+  }
+  if (!had_err) {
+    gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alpha));
+    gt_seq_iterator_set_quality_buffer(seqit, &qual);
+    status = gt_seq_iterator_next(seqit, &seq, &len1, &desc, err);
+
+    if (status == 1) {
+      *num_of_reads = 1UL;
+      while (!had_err) {
+        status = gt_seq_iterator_next(seqit, &seq, &len2, &desc, err);
+        if (status == -1)
+          had_err = -1;
+        if (status != 1)
+          break;
+        if (len2 != len1) {
+          gt_error_set(err, "reads have to be of equal length");
+          had_err = -1;
+          break;
+        }
+        if (hcr_base_qual_distr_add(bqd, qual, seq, len1) != 0)
+          had_err = -1;
+        len1 = len2;
+        (*num_of_reads)++;
+      }
+    }
+    else if (status == -1)
+      had_err = -1;
+  }
+  *readlength = len1;
+  gt_str_array_delete(file);
+  gt_seq_iterator_delete(seqit);
+  return had_err;
+}
+
+static void hcr_encoder_set_file_info(GtHcrEncoder *hcr_enc, GtUword filenum,
+                                      GtUword num_of_reads, GtUword readlength)
+{
+  FastqFileInfo *fileinfos = hcr_enc->seq_encoder->fileinfos;
+
+  if (filenum == 0)
+    fileinfos[filenum].readnum = num_of_reads;
+  else
+    fileinfos[filenum].readnum = fileinfos[filenum - 1].readnum + num_of_reads;
+  fileinfos[filenum].readlength = readlength;
+  hcr_enc->num_of_reads += num_of_reads;
+}
+
+/* the <base, quality> pair distribution of a single input file */
+typedef struct {
+  GtBaseQualDistr *bqd;
+  GtStr           *filename;
+  GtError         *err;
+  GtUword          num_of_reads,
+                   readlength;
+  int              had_err;
+} HcrFileDistr;
+
+typedef struct {
+  HcrFileDistr *filedistrs;
+  GtAlphabet   *alpha;
+  GtUword       num_of_files,
+                nextfile;
+  GtMutex      *mutex;
+} HcrFileDistrInfo;
+
+static void* hcr_base_qual_distr_thread(void *data)
+{
+  HcrFileDistrInfo *info = data;
+  HcrFileDistr *filedistr;
+  GtUword filenum;
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    filenum = info->nextfile++;
+    gt_mutex_unlock(info->mutex);
+    if (filenum >= info->num_of_files)
+      break;
+    filedistr = info->filedistrs + filenum;
+    filedistr->had_err =
+      hcr_base_qual_distr_add_file(filedistr->bqd, filedistr->filename,
+                                   info->alpha, &filedistr->num_of_reads,
+                                   &filedistr->readlength, filedistr->err);
+  }
+  return NULL;
+}
+
+/* Like calling <hcr_base_qual_distr_add_file()> for all input files, but the
+   files are read by <threads> threads, each file gets its own distribution.
+   The distributions are summed up in the order of the files afterwards. */
+static int hcr_base_qual_distr_add_files_threaded(GtBaseQualDistr *bqd,
+                                                  GtHcrEncoder *hcr_enc,
+                                                  GtQualRange qrange,
+                                                  unsigned int threads,
+                                                  GtError *err)
+{
+  HcrFileDistrInfo info;
+  GtThread **threadtab;
+  GtError *thread_err;
+  GtUword i, row, col;
+  unsigned int t;
+  int had_err = 0;
+
+  info.num_of_files = hcr_enc->num_of_files;
+  info.nextfile = 0;
+  info.alpha = bqd->alpha;
+  info.mutex = gt_mutex_new();
+  info.filedistrs = gt_calloc((size_t) info.num_of_files,
+                              sizeof (*info.filedistrs));
+  for (i = 0; i < info.num_of_files; i++) {
+    info.filedistrs[i].bqd = hcr_base_qual_distr_new(bqd->alpha, qrange);
+    info.filedistrs[i].filename = gt_str_array_get_str(hcr_enc->files, i);
+    info.filedistrs[i].err = gt_error_new();
+  }
+  if (threads > info.num_of_files)
+    threads = (unsigned int) info.num_of_files;
+
+  threadtab = gt_calloc((size_t) threads, sizeof (*threadtab));
+  thread_err = gt_error_new();
+  for (t = 1U; t < threads; t++) {
+    threadtab[t] = gt_thread_new(hcr_base_qual_distr_thread, &info,
+                                 thread_err);
+    if (!threadtab[t])
+      gt_error_unset(thread_err);
+  }
+  (void) hcr_base_qual_distr_thread(&info);
+  for (t = 1U; t < threads; t++) {
+    if (threadtab[t]) {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threadtab[t]);
+#endif
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  gt_error_delete(thread_err);
+  gt_free(threadtab);
+
+  for (i = 0; i < info.num_of_files; i++) {
+    HcrFileDistr *filedistr = info.filedistrs + i;
+    if (!had_err) {
+      if (filedistr->had_err) {
+        gt_error_set(err, "%s", gt_error_get(filedistr->err));
+        had_err = -1;
+      }
+      else {
+        for (row = 0; row < (GtUword) bqd->nrows; row++)
+          for (col = 0; col < (GtUword) bqd->ncols; col++)
+            bqd->distr[row][col] += filedistr->bqd->distr[row][col];
+        if (filedistr->bqd->max_qual > bqd->max_qual)
+          bqd->max_qual = filedistr->bqd->max_qual;
+        if (filedistr->bqd->min_qual < bqd->min_qual)
+          bqd->min_qual = filedistr->bqd->min_qual;
+        hcr_encoder_set_file_info(hcr_enc, i, filedistr->num_of_reads,
+                                  filedistr->readlength);
+      }
+    }
+    hcr_base_qual_distr_delete(filedistr->bqd);
+    gt_error_delete(filedistr->err);
+  }
+  gt_free(info.filedistrs);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
+GtHcrEncoder *gt_hcr_encoder_new(GtStrArray *files, GtAlphabet *alpha,
+                                 bool descs, GtQualRange qrange, GtTimer *timer,
+                                 GtError *err)
+{
+  GtBaseQualDistr *bqd;
+  GtHcrEncoder *hcr_enc;
+  int had_err = 0;
+  GtUword len1 = 0,
+          i,
+          num_of_reads = 0;
+
   gt_error_check(err);
   gt_assert(alpha && files);
 
@@ -1153,53 +2040,17 @@ GtHcrEncoder *gt_hcr_encoder_new(GtStrArray *files, GtAlphabet *alpha,
 
   /* check if reads in the same file are of same length and get
      <base, quality> pair distribution */
-  for (i = 0; i < hcr_enc->num_of_files; i++) {
-    file = gt_str_array_new();
-    gt_str_array_add(file, gt_str_array_get_str(files, i));
-    seqit = gt_seq_iterator_fastq_new(file, err);
-    if (!seqit) {
-      gt_error_set(err, "cannot initialize GtSeqIteratorFastQ object");
-      had_err = -1;
-    }
-    if (!had_err) {
-      gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alpha));
-      gt_seq_iterator_set_quality_buffer(seqit, &qual);
-      status = gt_seq_iterator_next(seqit, &seq, &len1, &desc, err);
-
-      if (status == 1) {
-        num_of_reads = 1UL;
-        while (!had_err) {
-          status = gt_seq_iterator_next(seqit, &seq, &len2, &desc, err);
-          if (status == -1)
-            had_err = -1;
-          if (status != 1)
-            break;
-          if (len2 != len1) {
-            gt_error_set(err, "reads have to be of equal length");
-            had_err = -1;
-            break;
-          }
-          if (hcr_base_qual_distr_add(bqd, qual, seq, len1) != 0)
-            had_err = -1;
-          len1 = len2;
-          num_of_reads++;
-        }
-      }
-      else if (status == -1)
-        had_err = -1;
-
-      if (!had_err) {
-        if (i == 0)
-          hcr_enc->seq_encoder->fileinfos[i].readnum = num_of_reads;
-        else
-          hcr_enc->seq_encoder->fileinfos[i].readnum =
-            hcr_enc->seq_encoder->fileinfos[i - 1].readnum + num_of_reads;
-        hcr_enc->seq_encoder->fileinfos[i].readlength = len1;
-      }
+  if (gt_jobs > 1U && hcr_enc->num_of_files > 1UL)
+    had_err = hcr_base_qual_distr_add_files_threaded(bqd, hcr_enc, qrange,
+                                                     gt_jobs, err);
+  else {
+    for (i = 0; !had_err && i < hcr_enc->num_of_files; i++) {
+      had_err = hcr_base_qual_distr_add_file(bqd,
+                                             gt_str_array_get_str(files, i),
+                                             alpha, &num_of_reads, &len1, err);
+      if (!had_err)
+        hcr_encoder_set_file_info(hcr_enc, i, num_of_reads, len1);
     }
-    hcr_enc->num_of_reads += num_of_reads;
-    gt_str_array_delete(file);
-    gt_seq_iterator_delete(seqit);
   }
   if (!had_err)
     hcr_base_qual_distr_trim(bqd);
@@ -1337,6 +2188,7 @@ void gt_hcr_decoder_delete(GtHcrDecoder *hcr_dec)
   if (hcr_dec != NULL) {
     hcr_seq_decoder_delete(hcr_dec->seq_dec);
     gt_encdesc_delete(hcr_dec->encdesc);
+    gt_str_delete(hcr_dec->name);
     gt_free(hcr_dec);
   }
 }
@@ -94,7 +94,8 @@ int           gt_hcr_decoder_decode(GtHcrDecoder *hcr_dec,
                                     char *qual, GtStr * desc, GtError *err);
 
 /* Decodes the hcr encoded file starting at record number <start> until record
-   number <end> and writes the decoding to a file with base name <name>. If
+   number <end> and writes the decoding to a file with base name <name>, using
+   <gt_jobs> threads (see <gt_hcr_decoder_decode_range_batches()>). If
    <width> is not 0 output of sequences and qualities will have that width. Be
    advised to not use this if the data should be machine readable. */
 int           gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec,
@@ -102,6 +103,48 @@ int           gt_hcr_decoder_decode_range(GtHcrDecoder *hcr_dec,
                                           GtUword end, GtUword width,
                                           GtTimer *timer, GtError *err);
 
+/* A <GtHcrRecordBatch> holds consecutive reads decoded by
+   <gt_hcr_decoder_decode_range_batches()>. */
+typedef struct GtHcrRecordBatch GtHcrRecordBatch;
+
+/* Function called by <gt_hcr_decoder_decode_range_batches()> for each
+   <batch> of decoded reads, in the order of the reads. <data> is passed
+   through. Must return 0 on success, a negative value otherwise (and set
+   <err> accordingly), which stops the decoding. */
+typedef int (*GtHcrRecordBatchFunc)(const GtHcrRecordBatch *batch, void *data,
+                                    GtError *err);
+
+/* Decodes the reads with numbers <start> to <end> of <hcr_dec> and passes
+   them in batches to <func>. The reads are decoded by <threads> threads, each
+   of them decodes whole batches starting at samples of the encoding with a
+   decoder of its own. Without sampling the reads are decoded by the current
+   thread only. Returns 0 on success, -1 otherwise (<err> is set
+   accordingly). */
+int           gt_hcr_decoder_decode_range_batches(GtHcrDecoder *hcr_dec,
+                                                  GtUword start, GtUword end,
+                                                  unsigned int threads,
+                                                  GtHcrRecordBatchFunc func,
+                                                  void *data, GtError *err);
+
+/* Returns the number of the first read in <batch>. */
+GtUword       gt_hcr_record_batch_first_readnum(const GtHcrRecordBatch *batch);
+
+/* Returns the number of reads in <batch>. */
+GtUword       gt_hcr_record_batch_size(const GtHcrRecordBatch *batch);
+
+/* Returns the sequence of the read with index <idx> in <batch>. */
+const char*   gt_hcr_record_batch_get_seq(const GtHcrRecordBatch *batch,
+                                          GtUword idx);
+
+/* Returns the qualities of the read with index <idx> in <batch>. */
+const char*   gt_hcr_record_batch_get_qual(const GtHcrRecordBatch *batch,
+                                           GtUword idx);
+
+/* Returns the description of the read with index <idx> in <batch>, or NULL
+   if descriptions are not decoded. */
+const char*   gt_hcr_record_batch_get_desc(const GtHcrRecordBatch *batch,
+                                           GtUword idx);
+
 /* Returns the total number of reads in <hcr_dec>. */
 GtUword gt_hcr_decoder_num_of_reads(GtHcrDecoder *hcr_dec);
 
@@ -26,9 +26,6 @@
 #include "core/minmax.h"
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
-#ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
-#endif
 #include "core/unused_api.h"
 #include "core/divmodmul.h"
 #include "match/squarededist.h"
@@ -173,79 +170,53 @@ static void determineCtab0(GtUword *Ctab, const GtScoreHandler *scorehandler,
   }
 }
 
-#ifdef GT_THREADS_ENABLED
-typedef struct{
-  GtLinspaceManagement *spacemanager;
+static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
+                                         const GtScoreHandler *scorehandler,
+                                         const GtUchar *useq,
+                                         GtUword ustart, GtUword ulen,
+                                         const GtUchar *vseq,
+                                         GtUword vstart, GtUword vlen,
+                                         GtUword *Ctab,
+                                         GtUword rowoffset);
+
+/* the two subproblems of one recursion step, they write to disjoint parts of
+   Ctab and can be solved in parallel */
+typedef struct {
   const GtScoreHandler *scorehandler;
   const GtUchar        *useq, *vseq;
   GtUword              ustart, ulen, vstart, vlen,
-                       *Ctab, rowoffset,
-                       threadidx, /* ensures threads do not overlap */
-                       *threadcount;
-}GtLinearCrosspointthreadinfo;
+                       *Ctab, rowoffset;
+} GtLinearCrosspointjob;
 
-static GtLinearCrosspointthreadinfo
-            set_LinearCrosspointthreadinfo(GtLinspaceManagement *spacemanager,
-                                           const GtScoreHandler *scorehandler,
-                                           const GtUchar *useq,
-                                           GtUword ustart,
-                                           GtUword ulen,
-                                           const GtUchar *vseq,
-                                           GtUword vstart,
-                                           GtUword vlen,
-                                           GtUword *Ctab,
-                                           GtUword rowoffset,
-                                           GtUword threadidx,
-                                           GtUword *threadcount)
+static void solve_LinearCrosspointjob(GtLinspaceManagement *spacemanager,
+                                      void *data)
 {
-  GtLinearCrosspointthreadinfo threadinfo;
-  threadinfo.spacemanager = spacemanager;
-  threadinfo.scorehandler = scorehandler;
-  threadinfo.useq = useq;
-  threadinfo.ustart = ustart;
-  threadinfo.ulen = ulen;
-  threadinfo.vseq = vseq;
-  threadinfo.vstart = vstart;
-  threadinfo.vlen = vlen;
-  threadinfo.Ctab = Ctab;
-  threadinfo.rowoffset = rowoffset;
-  threadinfo.threadidx = threadidx;
-  threadinfo.threadcount = threadcount;
-
-  return threadinfo;
+  GtLinearCrosspointjob *job = data;
+
+  (void) evaluatelinearcrosspoints(spacemanager, job->scorehandler,
+                                   job->useq, job->ustart, job->ulen,
+                                   job->vseq, job->vstart, job->vlen,
+                                   job->Ctab, job->rowoffset);
 }
-static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
-                                         const GtScoreHandler *scorehandler,
-                                         const GtUchar *useq,
-                                         GtUword ustart,
-                                         GtUword ulen,
-                                         const GtUchar *vseq,
-                                         GtUword vstart,
-                                         GtUword vlen,
-                                         GtUword *Ctab,
-                                         GtUword rowoffset,
-                                         GT_UNUSED GtUword threadidx,
-                                         GT_UNUSED GtUword *threadcount);
 
-static void *evaluatelinearcrosspoints_thread_caller(void *data)
+static void run_LinearCrosspointjobs(GtLinspaceManagement *spacemanager,
+                                     GtLinearCrosspointjob *jobs,
+                                     GtUword numofjobs)
 {
-  GtLinearCrosspointthreadinfo *threadinfo =
-                                         (GtLinearCrosspointthreadinfo *) data;
-  (void) evaluatelinearcrosspoints(threadinfo->spacemanager,
-                                   threadinfo->scorehandler,
-                                   threadinfo->useq,
-                                   threadinfo->ustart,
-                                   threadinfo-> ulen,
-                                   threadinfo->vseq,
-                                   threadinfo->vstart,
-                                   threadinfo->vlen,
-                                   threadinfo->Ctab,
-                                   threadinfo->rowoffset,
-                                   threadinfo->threadidx,
-                                   threadinfo->threadcount);
-  return NULL;
+  GtUword idx, numofthreads;
+
+  numofthreads = gt_linspace_management_reserve_threads(spacemanager,
+                                                        numofjobs - 1);
+  if (numofthreads == 0)
+  {
+    for (idx = 0; idx < numofjobs; idx++)
+      solve_LinearCrosspointjob(spacemanager, jobs + idx);
+  }
+  else
+    gt_linspace_management_run_jobs(spacemanager, numofthreads, jobs,
+                                    sizeof (*jobs), numofjobs,
+                                    solve_LinearCrosspointjob);
 }
-#endif
 
 /* evaluate crosspoints in recursive way */
 static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
@@ -255,47 +226,36 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtUchar *vseq,
                                          GtUword vstart, GtUword vlen,
                                          GtUword *Ctab,
-                                         GtUword rowoffset,
-                                         GT_UNUSED GtUword threadidx,
-                                         GT_UNUSED GtUword *threadcount)
+                                         GtUword rowoffset)
 {
   GtUword midrow, midcol, distance, *EDtabcolumn = NULL, *Rtabcolumn = NULL;
-#ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
-  GtLinearCrosspointthreadinfo threadinfo1, threadinfo2;
-#endif
+  GtLinearCrosspointjob jobs[2];
 
   if (vlen >= 2UL)
   {
     if (ulen == 0)
     {
       GtUword i;
-      for (i = 0; i <= vlen; i++)
+      /* Ctab[vlen] has been set by the caller */
+      for (i = 0; i < vlen; i++)
         Ctab[i] = rowoffset;
       return rowoffset;
     }
 
-#ifdef GT_THREADS_ENABLED
-    if (gt_jobs == 1)
-    {
-#endif
-      if (gt_linspace_management_checksquare(spacemanager, ulen,vlen,
-                                             sizeof (GtUword),
-                                             sizeof (Rtabcolumn)))
-      { /* product of subsquences is lower than space allocated already or
-         * lower than timesquarfactor * ulen*/
-        return gt_squarealign_ctab(spacemanager, scorehandler, Ctab, useq,
-                                   ustart, ulen, vseq, vstart, vlen, rowoffset);
-      }
-#ifdef GT_THREADS_ENABLED
+    if (gt_linspace_management_checksquare(spacemanager, ulen,vlen,
+                                           sizeof (GtUword),
+                                           sizeof (Rtabcolumn)))
+    { /* product of subsquences is lower than space allocated already or
+       * lower than timesquarfactor * ulen*/
+      return gt_squarealign_ctab(spacemanager, scorehandler, Ctab, useq,
+                                 ustart, ulen, vseq, vstart, vlen, rowoffset);
     }
-#endif
 
     midcol = GT_DIV2(vlen);
     Rtabcolumn = gt_linspace_management_get_rTabspace(spacemanager);
     EDtabcolumn = gt_linspace_management_get_valueTabspace(spacemanager);
-    Rtabcolumn = Rtabcolumn + rowoffset + threadidx;
-    EDtabcolumn = EDtabcolumn + rowoffset + threadidx;
+    Rtabcolumn = Rtabcolumn + rowoffset;
+    EDtabcolumn = EDtabcolumn + rowoffset;
 
     distance = evaluateallEDtabRtabcolumns(EDtabcolumn, Rtabcolumn,
                                            scorehandler, midcol,
@@ -304,60 +264,29 @@ static GtUword evaluatelinearcrosspoints(GtLinspaceManagement *spacemanager,
     midrow = Rtabcolumn[ulen];
     Ctab[midcol] = rowoffset + midrow;
 
-#ifdef GT_THREADS_ENABLED
-    if (*threadcount + 2 > gt_jobs)
-    {
-#endif
-      /* upper left corner */
-      (void) evaluatelinearcrosspoints(spacemanager, scorehandler,
-                                       useq, ustart, midrow,
-                                       vseq, vstart, midcol,
-                                       Ctab, rowoffset,
-                                       threadidx, threadcount);
-
-      /* bottom right corner */
-      (void) evaluatelinearcrosspoints(spacemanager, scorehandler,
-                                       useq, ustart + midrow,
-                                       ulen - midrow,
-                                       vseq, vstart + midcol,
-                                       vlen - midcol,
-                                       Ctab + midcol,
-                                       rowoffset + midrow,
-                                       threadidx, threadcount);
-#ifdef GT_THREADS_ENABLED
-    }
-    else
-    {
-      threadinfo1 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart, midrow,
-                                                   vseq, vstart, midcol,
-                                                   Ctab, rowoffset,
-                                                   threadidx, threadcount);
-      (*threadcount)++;
-      t1 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo1, NULL);
-
-      threadinfo2 = set_LinearCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart + midrow,
-                                                   ulen - midrow,
-                                                   vseq, vstart + midcol,
-                                                   vlen - midcol,
-                                                   Ctab + midcol,
-                                                   rowoffset + midrow,
-                                                   threadidx + GT_DIV2(midcol),
-                                                   threadcount);
-      (*threadcount)++;
-      t2 = gt_thread_new(evaluatelinearcrosspoints_thread_caller,
-                         &threadinfo2, NULL);
-
-      gt_thread_join(t1);
-      (*threadcount)--;
-      gt_thread_join(t2);
-      (*threadcount)--;
-      gt_thread_delete(t1);
-      gt_thread_delete(t2);
-    }
-#endif
+    /* upper left corner */
+    jobs[0].scorehandler = scorehandler;
+    jobs[0].useq = useq;
+    jobs[0].ustart = ustart;
+    jobs[0].ulen = midrow;
+    jobs[0].vseq = vseq;
+    jobs[0].vstart = vstart;
+    jobs[0].vlen = midcol;
+    jobs[0].Ctab = Ctab;
+    jobs[0].rowoffset = rowoffset;
+
+    /* bottom right corner */
+    jobs[1].scorehandler = scorehandler;
+    jobs[1].useq = useq;
+    jobs[1].ustart = ustart + midrow;
+    jobs[1].ulen = ulen - midrow;
+    jobs[1].vseq = vseq;
+    jobs[1].vstart = vstart + midcol;
+    jobs[1].vlen = vlen - midcol;
+    jobs[1].Ctab = Ctab + midcol;
+    jobs[1].rowoffset = rowoffset + midrow;
+
+    run_LinearCrosspointjobs(spacemanager, jobs, 2UL);
     return distance;
   }
   return 0;
@@ -374,7 +303,7 @@ GtUword gt_calc_linearalign(GtLinspaceManagement *spacemanager,
                             GtUword vstart,
                             GtUword vlen)
 {
-  GtUword distance, gapcost, *Ctab, *EDtabcolumn, *Rtabcolumn, threadcount = 1;
+  GtUword distance, gapcost, *Ctab, *EDtabcolumn, *Rtabcolumn;
 
   gt_assert(scorehandler);
   gt_linspace_management_set_ulen(spacemanager,ulen);
@@ -405,21 +334,15 @@ GtUword gt_calc_linearalign(GtLinspaceManagement *spacemanager,
                                             vseq, vstart, vlen, scorehandler);
   }
 
-#ifdef GT_THREADS_ENABLED
-  gt_linspace_management_check(spacemanager, ulen + GT_DIV2(vlen), vlen,
-                               sizeof (*EDtabcolumn), sizeof (*Rtabcolumn),
-                               sizeof (*Ctab));
-#else
   gt_linspace_management_check(spacemanager, ulen, vlen, sizeof (*EDtabcolumn),
                                sizeof (*Rtabcolumn), sizeof (*Ctab));
-#endif
   Ctab = gt_linspace_management_get_crosspointTabspace(spacemanager);
 
   Ctab[vlen] = ulen;
   distance = evaluatelinearcrosspoints(spacemanager, scorehandler,
                                        useq, ustart, ulen,
                                        vseq, vstart, vlen,
-                                       Ctab, 0, 0, &threadcount);
+                                       Ctab, 0);
 
   determineCtab0(Ctab, scorehandler, vseq[vstart], useq, ustart);
   gt_reconstructalignment_from_Ctab(align, Ctab, useq, ustart, vseq, vstart,
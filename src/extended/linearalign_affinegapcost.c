@@ -22,9 +22,6 @@
 #include "core/error.h"
 #include "core/ma_api.h"
 #include "core/minmax.h"
-#ifdef GT_THREADS_ENABLED
-#include "core/thread_api.h"
-#endif
 #include "core/types_api.h"
 #include "extended/affinealign.h"
 #include "extended/maxcoordvalue.h"
@@ -311,48 +308,6 @@ GtAffineAlignEdge gt_linearalign_affinegapcost_minAdditionalCosts(
   return gt_linearalign_affinegapcost_set_edge(rdist, ddist, idist);
 }
 
-#ifdef GT_THREADS_ENABLED
-typedef struct{
-  GtLinspaceManagement *spacemanager;
-  const GtScoreHandler *scorehandler;
-  const GtUchar *useq, * vseq;
-  GtUword ustart, ulen, vstart, vlen,
-          *Ctab, rowoffset, *threadcount;
-  GtAffineAlignEdge from_edge, to_edge;
-}GtAffineCrosspointthreadinfo;
-
-static GtAffineCrosspointthreadinfo
-              set_AffineCrosspointthreadinfo(GtLinspaceManagement *spacemanager,
-                                             const GtScoreHandler *scorehandler,
-                                             const GtUchar *useq,
-                                             GtUword ustart,
-                                             GtUword ulen,
-                                             const GtUchar *vseq,
-                                             GtUword vstart,
-                                             GtUword vlen,
-                                             GtUword *Ctab,
-                                             GtUword rowoffset,
-                                             GtAffineAlignEdge from_edge,
-                                             GtAffineAlignEdge to_edge,
-                                             GtUword *threadcount)
-{
-  GtAffineCrosspointthreadinfo threadinfo;
-  threadinfo.spacemanager = spacemanager;
-  threadinfo.scorehandler = scorehandler;
-  threadinfo.useq = useq;
-  threadinfo.ustart = ustart;
-  threadinfo.ulen = ulen;
-  threadinfo.vseq = vseq;
-  threadinfo.vstart = vstart;
-  threadinfo.vlen = vlen;
-  threadinfo.Ctab = Ctab;
-  threadinfo.rowoffset = rowoffset;
-  threadinfo.from_edge = from_edge;
-  threadinfo.to_edge = to_edge;
-  threadinfo.threadcount = threadcount;
-
-  return threadinfo;
-}
 static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          const GtScoreHandler *scorehandler,
                                          const GtUchar *useq,
@@ -364,29 +319,75 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
                                          GtAffineAlignEdge from_edge,
-                                         GtAffineAlignEdge to_edge,
-                                         GtUword *threadcount);
+                                         GtAffineAlignEdge to_edge);
+
+/* the subproblems of one recursion step, they write to disjoint parts of
+   Ctab and can be solved in parallel */
+typedef struct {
+  const GtScoreHandler *scorehandler;
+  const GtUchar *useq, *vseq;
+  GtUword ustart, ulen, vstart, vlen,
+          *Ctab, rowoffset;
+  GtAffineAlignEdge from_edge, to_edge;
+} GtAffineCrosspointjob;
+
+static void set_AffineCrosspointjob(GtAffineCrosspointjob *job,
+                                    const GtScoreHandler *scorehandler,
+                                    const GtUchar *useq,
+                                    GtUword ustart,
+                                    GtUword ulen,
+                                    const GtUchar *vseq,
+                                    GtUword vstart,
+                                    GtUword vlen,
+                                    GtUword *Ctab,
+                                    GtUword rowoffset,
+                                    GtAffineAlignEdge from_edge,
+                                    GtAffineAlignEdge to_edge)
+{
+  job->scorehandler = scorehandler;
+  job->useq = useq;
+  job->ustart = ustart;
+  job->ulen = ulen;
+  job->vseq = vseq;
+  job->vstart = vstart;
+  job->vlen = vlen;
+  job->Ctab = Ctab;
+  job->rowoffset = rowoffset;
+  job->from_edge = from_edge;
+  job->to_edge = to_edge;
+}
+
+static void solve_AffineCrosspointjob(GtLinspaceManagement *spacemanager,
+                                      void *data)
+{
+  GtAffineCrosspointjob *job = data;
 
-static void *evaluateaffinecrosspoints_thread_caller(void *data)
+  (void) evaluateaffinecrosspoints(spacemanager, job->scorehandler,
+                                   job->useq, job->ustart, job->ulen,
+                                   job->vseq, job->vstart, job->vlen,
+                                   job->Ctab, job->rowoffset,
+                                   job->from_edge, job->to_edge);
+}
+
+static void run_AffineCrosspointjobs(GtLinspaceManagement *spacemanager,
+                                     GtAffineCrosspointjob *jobs,
+                                     GtUword numofjobs)
 {
-  GtAffineCrosspointthreadinfo *threadinfo =
-                                         (GtAffineCrosspointthreadinfo *) data;
-  (void) evaluateaffinecrosspoints(threadinfo->spacemanager,
-                                   threadinfo->scorehandler,
-                                   threadinfo->useq,
-                                   threadinfo->ustart,
-                                   threadinfo-> ulen,
-                                   threadinfo->vseq,
-                                   threadinfo->vstart,
-                                   threadinfo->vlen,
-                                   threadinfo->Ctab,
-                                   threadinfo->rowoffset,
-                                   threadinfo->from_edge,
-                                   threadinfo->to_edge,
-                                   threadinfo->threadcount);
-  return NULL;
+  GtUword idx, numofthreads = 0;
+
+  if (numofjobs > 1UL)
+    numofthreads = gt_linspace_management_reserve_threads(spacemanager,
+                                                          numofjobs - 1);
+  if (numofthreads == 0)
+  {
+    for (idx = 0; idx < numofjobs; idx++)
+      solve_AffineCrosspointjob(spacemanager, jobs + idx);
+  }
+  else
+    gt_linspace_management_run_jobs(spacemanager, numofthreads, jobs,
+                                    sizeof (*jobs), numofjobs,
+                                    solve_AffineCrosspointjob);
 }
-#endif
 
 /* evaluate crosspoints in recursive way */
 static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
@@ -400,37 +401,26 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
                                          GtUword *Ctab,
                                          GtUword rowoffset,
                                          GtAffineAlignEdge from_edge,
-                                         GtAffineAlignEdge to_edge,
-                                         GT_UNUSED GtUword *threadcount)
+                                         GtAffineAlignEdge to_edge)
 {
-  GtUword  midrow = 0, midcol = GT_DIV2(vlen), distance, colindex;
+  GtUword  midrow = 0, midcol = GT_DIV2(vlen), distance, colindex,
+           numofjobs = 0;
   GtAffineAlignEdge bottomtype, midtype = Affine_X;
   GtAffinealignDPentry *Atabcolumn = NULL;
   GtAffineAlignRtabentry *Rtabcolumn = NULL;
-
-#ifdef GT_THREADS_ENABLED
-  GtThread *t1 = NULL, *t2 = NULL;
-  GtAffineCrosspointthreadinfo threadinfo1, threadinfo2;
-#endif
+  GtAffineCrosspointjob jobs[2];
 
   if (vlen >= 2UL)
   {
-#ifdef GT_THREADS_ENABLED
-    if (gt_jobs == 1)
+    if (gt_linspace_management_checksquare(spacemanager, ulen, vlen,
+                                           sizeof (*Atabcolumn),
+                                           sizeof (*Rtabcolumn)))
     {
-#endif
-      if (gt_linspace_management_checksquare(spacemanager, ulen, vlen,
-                                             sizeof (*Atabcolumn),
-                                             sizeof (*Rtabcolumn)))
-      {
-        gt_affinealign_ctab(spacemanager, scorehandler, Ctab,
-                            useq, ustart, ulen, vseq, vstart, vlen,
-                            rowoffset, from_edge, to_edge);
-        return 0;
-      }
-#ifdef GT_THREADS_ENABLED
-   }
-#endif
+      gt_affinealign_ctab(spacemanager, scorehandler, Ctab,
+                          useq, ustart, ulen, vseq, vstart, vlen,
+                          rowoffset, from_edge, to_edge);
+      return 0;
+    }
     Rtabcolumn = gt_linspace_management_get_rTabspace(spacemanager);
     Atabcolumn = gt_linspace_management_get_valueTabspace(spacemanager);
     Rtabcolumn = Rtabcolumn + rowoffset;
@@ -472,119 +462,39 @@ static GtUword evaluateaffinecrosspoints(GtLinspaceManagement *spacemanager,
         case Affine_R:
           if (midcol > 1)
             Ctab[midcol-1] = Ctab[midcol] == 0 ? 0: Ctab[midcol] - 1;
-
-#ifdef GT_THREADS_ENABLED
-          if (*threadcount + 1 > gt_jobs)
-          {
-#endif
-            (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                             useq, ustart, midrow-1,
-                                             vseq, vstart, midcol-1,
-                                             Ctab, rowoffset,
-                                             from_edge, midtype,
-                                             threadcount);
-#ifdef GT_THREADS_ENABLED
-          }
-          else
-          {
-            threadinfo1=set_AffineCrosspointthreadinfo(spacemanager,
-                                                       scorehandler,
-                                                       useq, ustart, midrow-1,
-                                                       vseq, vstart, midcol-1,
-                                                       Ctab, rowoffset,
-                                                       from_edge, midtype,
-                                                       threadcount);
-            (*threadcount)++;
-            t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
-          }
-#endif
+          set_AffineCrosspointjob(jobs + numofjobs++, scorehandler,
+                                  useq, ustart, midrow-1,
+                                  vseq, vstart, midcol-1,
+                                  Ctab, rowoffset,
+                                  from_edge, midtype);
           break;
         case Affine_D:
-#ifdef GT_THREADS_ENABLED
-          if (*threadcount + 1 > gt_jobs)
-          {
-#endif
-          (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                           useq, ustart, midrow-1,
-                                           vseq, vstart, midcol,
-                                           Ctab, rowoffset,
-                                           from_edge,midtype,
-                                           threadcount);
-#ifdef GT_THREADS_ENABLED
-         }
-         else
-         {
-           threadinfo1=set_AffineCrosspointthreadinfo(spacemanager,
-                                                      scorehandler,
-                                                      useq, ustart, midrow-1,
-                                                      vseq, vstart, midcol,
-                                                      Ctab, rowoffset,
-                                                      from_edge, midtype,
-                                                      threadcount);
-
-           (*threadcount)++;
-           t1 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                               &threadinfo1, NULL);
-          }
-#endif
+          set_AffineCrosspointjob(jobs + numofjobs++, scorehandler,
+                                  useq, ustart, midrow-1,
+                                  vseq, vstart, midcol,
+                                  Ctab, rowoffset,
+                                  from_edge, midtype);
           break;
         case Affine_I:
           if (midcol > 1)
             Ctab[midcol-1] = Ctab[midcol];
-          (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                           useq, ustart, midrow,
-                                           vseq, vstart, midcol-1,
-                                           Ctab, rowoffset,
-                                           from_edge, midtype,
-                                           threadcount);
+          set_AffineCrosspointjob(jobs + numofjobs++, scorehandler,
+                                  useq, ustart, midrow,
+                                  vseq, vstart, midcol-1,
+                                  Ctab, rowoffset,
+                                  from_edge, midtype);
           break;
         case Affine_X: /*never reach this line*/
                 gt_assert(false);
       }
     }
-   /*bottom right corner */
-#ifdef GT_THREADS_ENABLED
-    if (*threadcount + 1 > gt_jobs)
-    {
-#endif
-      (void) evaluateaffinecrosspoints(spacemanager, scorehandler,
-                                          useq, ustart+midrow, ulen-midrow,
-                                          vseq, vstart+midcol, vlen-midcol,
-                                          Ctab+midcol,rowoffset+midrow,
-                                          midtype, to_edge, threadcount);
-#ifdef GT_THREADS_ENABLED
-    }
-    else
-    {
-      threadinfo2 = set_AffineCrosspointthreadinfo(spacemanager, scorehandler,
-                                                   useq, ustart + midrow,
-                                                   ulen - midrow,
-                                                   vseq, vstart + midcol,
-                                                   vlen - midcol,
-                                                   Ctab + midcol,
-                                                   rowoffset + midrow,
-                                                   midtype, to_edge,
-                                                   threadcount);
-      (*threadcount)++;
-      t2 = gt_thread_new(evaluateaffinecrosspoints_thread_caller,
-                         &threadinfo2, NULL);
-    }
-
-    if (t1 != NULL)
-    {
-      gt_thread_join(t1);
-      (*threadcount)--;
-      gt_thread_delete(t1);
-    }
-    if (t2 != NULL)
-    {
-      gt_thread_join(t2);
-      (*threadcount)--;
-      gt_thread_delete(t2);
-    }
-
-#endif
+    /*bottom right corner */
+    set_AffineCrosspointjob(jobs + numofjobs++, scorehandler,
+                            useq, ustart+midrow, ulen-midrow,
+                            vseq, vstart+midcol, vlen-midcol,
+                            Ctab+midcol, rowoffset+midrow,
+                            midtype, to_edge);
+    run_AffineCrosspointjobs(spacemanager, jobs, numofjobs);
     return distance;
   }
   return 0;
@@ -629,7 +539,7 @@ GtUword gt_calc_affinealign_linear(GtLinspaceManagement *spacemanager,
                                    GtUword vstart,
                                    GtUword vlen)
 {
-  GtUword distance, *Ctab, threadcount = 1;
+  GtUword distance, *Ctab;
   GtWord gap_extension, gap_opening;
   GtAffinealignDPentry *Atabcolumn;
   GtAffineAlignRtabentry *Rtabcolumn;
@@ -675,7 +585,7 @@ GtUword gt_calc_affinealign_linear(GtLinspaceManagement *spacemanager,
                                          useq, ustart, ulen,
                                          vseq, vstart, vlen,
                                          Ctab, 0, Affine_X,
-                                         Affine_X, &threadcount);
+                                         Affine_X);
 
     affine_determineCtab0(Ctab, spacemanager, scorehandler,
                           useq, ustart, vseq, vstart);
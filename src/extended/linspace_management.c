@@ -18,9 +18,18 @@
 #include <ctype.h>
 #include <string.h>
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
 #include "extended/maxcoordvalue.h"
 #include "extended/linspace_management.h"
 
+/* number of additional threads currently used by the recursions working
+   with one spacemanager and its clones */
+typedef struct {
+  GtMutex         *mutex;
+  GtUword          running;
+} GtLinspaceThreads;
+
 struct GtLinspaceManagement{
   void             *valueTabspace,
                    *rTabspace,
@@ -32,6 +41,8 @@ struct GtLinspaceManagement{
                    crosspointTabsize,
                    spacepeak; /*sum of space in bytes*/
   GtMaxcoordvalue *maxscoordvaluespace;
+  GtLinspaceThreads *threads; /* shared by all clones of a spacemanager */
+  bool             ownsthreads;
 };
 
 GtLinspaceManagement* gt_linspace_management_new()
@@ -48,6 +59,10 @@ GtLinspaceManagement* gt_linspace_management_new()
   spacemanager->timesquarefactor = 1;
   spacemanager->ulen = 0;
   spacemanager->spacepeak = 0;
+  spacemanager->threads = gt_malloc(sizeof (*spacemanager->threads));
+  spacemanager->threads->mutex = gt_mutex_new();
+  spacemanager->threads->running = 0;
+  spacemanager->ownsthreads = true;
   return spacemanager;
 }
 
@@ -60,6 +75,11 @@ void gt_linspace_management_delete(GtLinspaceManagement *spacemanager)
     if (spacemanager->crosspointTabspace != NULL)
       gt_free(spacemanager->crosspointTabspace);
     gt_maxcoordvalue_delete(spacemanager->maxscoordvaluespace);
+    if (spacemanager->ownsthreads)
+    {
+      gt_mutex_delete(spacemanager->threads->mutex);
+      gt_free(spacemanager->threads);
+    }
     gt_free(spacemanager);
   }
 }
@@ -279,3 +299,149 @@ void gt_linspace_management_set_TSfactor(GtLinspaceManagement *spacemanager,
   gt_assert(spacemanager != NULL);
   spacemanager->timesquarefactor = timesquarefactor;
 }
+
+GtUword gt_linspace_management_reserve_threads(GtLinspaceManagement
+                                               *spacemanager,
+                                               GtUword wanted)
+{
+  GtUword reserved = 0;
+#ifdef GT_THREADS_ENABLED
+  GtLinspaceThreads *threads;
+
+  gt_assert(spacemanager != NULL);
+  threads = spacemanager->threads;
+  gt_mutex_lock(threads->mutex);
+  if (threads->running + 1 < (GtUword) gt_jobs)
+  {
+    reserved = MIN(wanted, (GtUword) gt_jobs - 1 - threads->running);
+    threads->running += reserved;
+  }
+  gt_mutex_unlock(threads->mutex);
+#else
+  (void) spacemanager;
+  (void) wanted;
+#endif
+  return reserved;
+}
+
+#ifdef GT_THREADS_ENABLED
+/* a clone has the same settings and the same amount of valueTab and rTab
+   space as <spacemanager>, so that all decisions between linear and square
+   space are the same as for <spacemanager> itself */
+static GtLinspaceManagement *linspace_management_clone(const
+                                                       GtLinspaceManagement
+                                                       *spacemanager)
+{
+  GtLinspaceManagement *clone = gt_malloc(sizeof (*clone));
+
+  clone->valueTabspace = gt_malloc(spacemanager->valueTabsize);
+  clone->rTabspace = gt_malloc(spacemanager->rTabsize);
+  clone->crosspointTabspace = NULL;
+  clone->maxscoordvaluespace = NULL;
+  clone->valueTabsize = spacemanager->valueTabsize;
+  clone->rTabsize = spacemanager->rTabsize;
+  clone->crosspointTabsize = 0;
+  clone->timesquarefactor = spacemanager->timesquarefactor;
+  clone->ulen = spacemanager->ulen;
+  clone->spacepeak = clone->valueTabsize + clone->rTabsize;
+  clone->threads = spacemanager->threads;
+  clone->ownsthreads = false;
+  return clone;
+}
+
+typedef struct {
+  GtLinspaceManagement *spacemanager;
+  GtLinspaceJobFunc     jobfunc;
+  char                 *jobs;
+  size_t                jobsize;
+  GtUword               numofjobs,
+                       *nextjob;
+  GtMutex              *mutex;
+} GtLinspaceJobthreadinfo;
+
+static void *linspace_management_job_thread(void *data)
+{
+  GtLinspaceJobthreadinfo *threadinfo = data;
+  GtUword jobnum;
+
+  for (;;)
+  {
+    gt_mutex_lock(threadinfo->mutex);
+    jobnum = (*threadinfo->nextjob)++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (jobnum >= threadinfo->numofjobs)
+      break;
+    threadinfo->jobfunc(threadinfo->spacemanager,
+                        threadinfo->jobs + jobnum * threadinfo->jobsize);
+  }
+  return NULL;
+}
+#endif
+
+void gt_linspace_management_run_jobs(GtLinspaceManagement *spacemanager,
+                                     GtUword numofthreads,
+                                     void *jobs, size_t jobsize,
+                                     GtUword numofjobs,
+                                     GtLinspaceJobFunc jobfunc)
+{
+#ifdef GT_THREADS_ENABLED
+  GtLinspaceJobthreadinfo *threadinfo;
+  GtThread **threadtab;
+  GtMutex *mutex;
+  GtUword t, nextjob = 0;
+  size_t space;
+
+  gt_assert(spacemanager != NULL && jobfunc != NULL);
+  mutex = gt_mutex_new();
+  threadinfo = gt_malloc(sizeof (*threadinfo) * (numofthreads + 1));
+  threadtab = gt_calloc(numofthreads + 1, sizeof (*threadtab));
+  for (t = 0; t <= numofthreads; t++)
+  {
+    threadinfo[t].spacemanager = t == 0
+                                 ? spacemanager
+                                 : linspace_management_clone(spacemanager);
+    threadinfo[t].jobfunc = jobfunc;
+    threadinfo[t].jobs = jobs;
+    threadinfo[t].jobsize = jobsize;
+    threadinfo[t].numofjobs = numofjobs;
+    threadinfo[t].nextjob = &nextjob;
+    threadinfo[t].mutex = mutex;
+  }
+  /* the current thread also works on the jobs; if a thread cannot be
+     created, the remaining threads take over its share */
+  for (t = 1; t <= numofthreads; t++)
+  {
+    threadtab[t] = gt_thread_new(linspace_management_job_thread,
+                                 threadinfo + t, NULL);
+  }
+  (void) linspace_management_job_thread(threadinfo);
+  space = spacemanager->valueTabsize + spacemanager->rTabsize +
+          spacemanager->crosspointTabsize;
+  for (t = 1; t <= numofthreads; t++)
+  {
+    if (threadtab[t] != NULL)
+    {
+      gt_thread_join(threadtab[t]);
+      gt_thread_delete(threadtab[t]);
+    }
+    space += threadinfo[t].spacemanager->spacepeak;
+    gt_linspace_management_delete(threadinfo[t].spacemanager);
+  }
+  if (space > spacemanager->spacepeak)
+    spacemanager->spacepeak = space;
+  gt_free(threadtab);
+  gt_free(threadinfo);
+  gt_mutex_delete(mutex);
+
+  gt_mutex_lock(spacemanager->threads->mutex);
+  gt_assert(spacemanager->threads->running >= numofthreads);
+  spacemanager->threads->running -= numofthreads;
+  gt_mutex_unlock(spacemanager->threads->mutex);
+#else
+  GtUword jobnum;
+
+  gt_assert(numofthreads == 0);
+  for (jobnum = 0; jobnum < numofjobs; jobnum++)
+    jobfunc(spacemanager, (char *) jobs + jobnum * jobsize);
+#endif
+}
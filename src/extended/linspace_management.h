@@ -112,6 +112,32 @@ void          gt_linspace_management_set_TSfactor(GtLinspaceManagement
                                                   *spacemanager,
                                                   GtUword timesquarefactor);
 
+/* Function applied by <gt_linspace_management_run_jobs()> to one <job>,
+   using the given <spacemanager> for all of its space requirements. */
+typedef void  (*GtLinspaceJobFunc)(GtLinspaceManagement *spacemanager,
+                                   void *job);
+
+/* Reserve up to <wanted> additional threads for the recursion using the given
+   <spacemanager>. The threads are shared by all recursion levels and limited
+   to <gt_jobs> - 1. Return the number of reserved threads, which is 0 if
+   threads are not enabled or all of them are in use. */
+GtUword       gt_linspace_management_reserve_threads(GtLinspaceManagement
+                                                     *spacemanager,
+                                                     GtUword wanted);
+
+/* Apply <jobfunc> to each of the <numofjobs> independent jobs of size
+   <jobsize> stored in <jobs>, using the current thread and <numofthreads>
+   threads reserved before by <gt_linspace_management_reserve_threads()>.
+   Each additional thread works with its own copy of <spacemanager>, whose
+   space peak is added to the space peak of <spacemanager>. The reserved
+   threads are released before the function returns. */
+void          gt_linspace_management_run_jobs(GtLinspaceManagement
+                                              *spacemanager,
+                                              GtUword numofthreads,
+                                              void *jobs, size_t jobsize,
+                                              GtUword numofjobs,
+                                              GtLinspaceJobFunc jobfunc);
+
 #define add_safe(val1, val2, exception) (((val1) != (exception))\
                                            ? (val1) + (val2)\
                                            : (exception))
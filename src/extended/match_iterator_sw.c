@@ -34,14 +34,28 @@ const GtMatchIteratorClass* gt_match_iterator_sw_class(void);
 #define gt_match_iterator_sw_cast(M)\
         gt_match_iterator_cast(gt_match_iterator_sw_class(), M)
 
+/* number of sequences from <es2> aligned at once against a sequence from
+   <es1> */
+#define GT_MATCH_ITERATOR_SW_BATCHSIZE 64
+
 typedef struct {
   GtScoreFunction *sf;
   GtEncseq *es1, *es2;
   GtUword seqno_es1,
                 seqno_es2,
                 min_len,
-                max_edist;
+                max_edist,
+                batch_seqno_es2,
+                batch_next,
+                num_b;
   bool firstali;
+  GtSWAlignBatch *batch;
+  GtSeq *seq_a,
+        *seqs_b[GT_MATCH_ITERATOR_SW_BATCHSIZE];
+  char *a,
+       *b[GT_MATCH_ITERATOR_SW_BATCHSIZE];
+  GtUword b_size[GT_MATCH_ITERATOR_SW_BATCHSIZE],
+          a_size;
 } GtMatchIteratorSWMembers;
 
 struct GtMatchIteratorSW {
@@ -49,59 +63,97 @@ struct GtMatchIteratorSW {
   GtMatchIteratorSWMembers *pvt;
 };
 
+static char* match_iterator_sw_decode(GtEncseq *es, GtUword seqno,
+                                      char *buf, GtUword *bufsize)
+{
+  GtUword seqlen = gt_encseq_seqlength(es, seqno),
+          seqpos = gt_encseq_seqstartpos(es, seqno);
+  if (*bufsize < seqlen + 1) {
+    *bufsize = seqlen + 1;
+    buf = gt_realloc(buf, *bufsize * sizeof (char));
+  }
+  if (seqlen > 0)
+    gt_encseq_extract_decoded(es, buf, seqpos, seqpos + seqlen - 1);
+  return buf;
+}
+
+/* aligns the current sequence from <es1> against the next batch of sequences
+   from <es2>, returns false if all pairs have been aligned */
+static bool match_iterator_sw_next_batch(GtMatchIteratorSWMembers *pvt)
+{
+  GtUword i, seqlen;
+  for (i = 0; i < pvt->num_b; i++)
+    gt_seq_delete(pvt->seqs_b[i]);
+  pvt->num_b = pvt->batch_next = 0;
+  if (pvt->firstali || pvt->seqno_es2
+                         == gt_encseq_num_of_sequences(pvt->es2)) {
+    if (!pvt->firstali)
+      pvt->seqno_es1++;
+    pvt->firstali = false;
+    pvt->seqno_es2 = 0;
+    gt_seq_delete(pvt->seq_a);
+    pvt->seq_a = NULL;
+    if (pvt->seqno_es1 >= gt_encseq_num_of_sequences(pvt->es1)
+          || gt_encseq_num_of_sequences(pvt->es2) == 0)
+      return false;
+    pvt->a = match_iterator_sw_decode(pvt->es1, pvt->seqno_es1, pvt->a,
+                                      &pvt->a_size);
+    pvt->seq_a = gt_seq_new(pvt->a,
+                            gt_encseq_seqlength(pvt->es1, pvt->seqno_es1),
+                            gt_encseq_alphabet(pvt->es1));
+  }
+  gt_swalign_batch_reset(pvt->batch, pvt->seq_a);
+  pvt->batch_seqno_es2 = pvt->seqno_es2;
+  for (i = 0; i < GT_MATCH_ITERATOR_SW_BATCHSIZE
+                && pvt->seqno_es2 < gt_encseq_num_of_sequences(pvt->es2);
+       i++, pvt->seqno_es2++) {
+    seqlen = gt_encseq_seqlength(pvt->es2, pvt->seqno_es2);
+    pvt->b[i] = match_iterator_sw_decode(pvt->es2, pvt->seqno_es2, pvt->b[i],
+                                         pvt->b_size + i);
+    pvt->seqs_b[i] = gt_seq_new(pvt->b[i], seqlen,
+                                gt_encseq_alphabet(pvt->es2));
+    (void) gt_swalign_batch_add(pvt->batch, pvt->seqs_b[i]);
+  }
+  pvt->num_b = i;
+  gt_swalign_batch_compute(pvt->batch);
+  return true;
+}
+
 static GtMatchIteratorStatus gt_match_iterator_sw_next(GtMatchIterator *mi,
                                                       GT_UNUSED GtMatch **match,
                                                       GT_UNUSED GtError *err)
 {
   GtMatchIteratorSW *mis;
-  GtSeq *seq_a, *seq_b;
-  char *a, *b;
+  GtMatchIteratorSWMembers *pvt;
   const char *adesc, *bdesc;
   GtAlignment *ali = NULL;
-  GtUword seqlen_a, seqlen_b, seqpos;
+  GtUword seqlen_a, seqlen_b, seqno_es2;
   GtRange arng, brng;
   gt_assert(mi && match);
 
   mis = gt_match_iterator_sw_cast(mi);
+  pvt = mis->pvt;
   while (true) {
-    if (!mis->pvt->firstali)
-      mis->pvt->seqno_es2++;
-    if (mis->pvt->seqno_es2 == gt_encseq_num_of_sequences(mis->pvt->es2)) {
-      mis->pvt->seqno_es1++;
-      if (mis->pvt->seqno_es1 == gt_encseq_num_of_sequences(mis->pvt->es1))
+    if (pvt->batch_next == pvt->num_b) {
+      if (!match_iterator_sw_next_batch(pvt))
         return GT_MATCHER_STATUS_END;
-      mis->pvt->seqno_es2 = 0;
+      continue;
     }
-    seqlen_a = gt_encseq_seqlength(mis->pvt->es1, mis->pvt->seqno_es1);
-    seqlen_b = gt_encseq_seqlength(mis->pvt->es2, mis->pvt->seqno_es2);
-    /* XXX: reuse buffers for performance improvement */
-    a = gt_malloc(seqlen_a * sizeof (char));
-    seqpos = gt_encseq_seqstartpos(mis->pvt->es1, mis->pvt->seqno_es1);
-    gt_encseq_extract_decoded(mis->pvt->es1, a, seqpos, seqpos + seqlen_a - 1);
-    b = gt_malloc(seqlen_b * sizeof (char));
-    seqpos = gt_encseq_seqstartpos(mis->pvt->es2, mis->pvt->seqno_es2);
-    gt_encseq_extract_decoded(mis->pvt->es1, b, seqpos, seqpos + seqlen_b - 1);
-    seq_a = gt_seq_new(a, seqlen_a, gt_encseq_alphabet(mis->pvt->es1));
-    seq_b = gt_seq_new(b, seqlen_b, gt_encseq_alphabet(mis->pvt->es2));
-    ali = gt_swalign(seq_a, seq_b, mis->pvt->sf);
-    mis->pvt->firstali = false;
-    if (ali && gt_alignment_get_length(ali) >= mis->pvt->min_len
-          && gt_alignment_eval(ali) <= mis->pvt->max_edist) {
+    seqno_es2 = pvt->batch_seqno_es2 + pvt->batch_next;
+    ali = gt_swalign_batch_get_alignment(pvt->batch, pvt->batch_next++);
+    if (ali && gt_alignment_get_length(ali) >= pvt->min_len
+          && gt_alignment_eval(ali) <= pvt->max_edist) {
       break;
     }
     gt_alignment_delete(ali);
-    gt_seq_delete(seq_a);
-    gt_seq_delete(seq_b);
-    gt_free(a);
-    gt_free(b);
   }
   arng = gt_alignment_get_urange(ali);
   brng = gt_alignment_get_vrange(ali);
-  adesc = gt_encseq_description(mis->pvt->es1, &seqlen_a, mis->pvt->seqno_es1);
-  bdesc = gt_encseq_description(mis->pvt->es2, &seqlen_b, mis->pvt->seqno_es2);
+  adesc = gt_encseq_description(pvt->es1, &seqlen_a, pvt->seqno_es1);
+  bdesc = gt_encseq_description(pvt->es2, &seqlen_b, seqno_es2);
   *match = gt_match_sw_new("", "",
-                           mis->pvt->seqno_es1,
-                           mis->pvt->seqno_es2,
+                           pvt->seqno_es1,
+                           seqno_es2,
                            gt_alignment_get_length(ali),
                            gt_alignment_eval(ali),
                            arng.start, brng.start,
@@ -110,10 +162,6 @@ static GtMatchIteratorStatus gt_match_iterator_sw_next(GtMatchIterator *mi,
   gt_match_set_seqid1_nt(*match, adesc, seqlen_a);
   gt_match_set_seqid2_nt(*match, bdesc, seqlen_b);
   gt_alignment_delete(ali);
-  gt_seq_delete(seq_a);
-  gt_seq_delete(seq_b);
-  gt_free(a);
-  gt_free(b);
   return GT_MATCHER_STATUS_OK;
 }
 
@@ -137,14 +185,23 @@ GtMatchIterator* gt_match_iterator_sw_new(GtEncseq *es1, GtEncseq *es2,
   mis->pvt->min_len = min_len;
   mis->pvt->max_edist = max_edist;
   mis->pvt->firstali = true;
+  mis->pvt->batch = gt_swalign_batch_new(sf);
   return mi;
 }
 
 static void gt_match_iterator_sw_free(GtMatchIterator *mi)
 {
   GtMatchIteratorSW *mis;
+  GtUword i;
   if (!mi) return;
   mis = gt_match_iterator_sw_cast(mi);
+  for (i = 0; i < mis->pvt->num_b; i++)
+    gt_seq_delete(mis->pvt->seqs_b[i]);
+  for (i = 0; i < GT_MATCH_ITERATOR_SW_BATCHSIZE; i++)
+    gt_free(mis->pvt->b[i]);
+  gt_seq_delete(mis->pvt->seq_a);
+  gt_free(mis->pvt->a);
+  gt_swalign_batch_delete(mis->pvt->batch);
   gt_encseq_delete(mis->pvt->es1);
   gt_encseq_delete(mis->pvt->es2);
   gt_score_function_delete(mis->pvt->sf);
@@ -0,0 +1,295 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array_api.h"
+#include "core/ensure.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "extended/node_arena.h"
+
+/* all node sizes are rounded up to multiples of this alignment */
+#define NODE_ARENA_ALIGNMENT  sizeof (GtUint64)
+/* larger objects are allocated on the heap */
+#define NODE_ARENA_MAX_SIZE   512UL
+#define NODE_ARENA_NUM_OF_SIZES \
+        (NODE_ARENA_MAX_SIZE / NODE_ARENA_ALIGNMENT)
+#define NODE_ARENA_SLAB_SIZE  (64UL * 1024)
+
+typedef struct NodeArenaFree NodeArenaFree;
+
+struct NodeArenaFree {
+  NodeArenaFree *next;
+};
+
+/* header of an object allocated on the heap, these are linked to be
+   released with the slabs */
+typedef struct NodeArenaLarge NodeArenaLarge;
+
+struct NodeArenaLarge {
+  NodeArenaLarge *previous,
+                 *next;
+};
+
+struct GtNodeArena {
+  NodeArenaFree *free_lists[NODE_ARENA_NUM_OF_SIZES];
+  GtArray *slabs;
+  char *slab_ptr;
+  size_t slab_left;
+  NodeArenaLarge *large_objects;
+  GtHashmap *strings;
+  GtRWLock *node_lock;
+  GtUword num_of_live_objects;
+  unsigned int reference_count;
+  bool deleted;
+  GtMutex *mutex;
+};
+
+GtNodeArena* gt_node_arena_new(void)
+{
+  GtNodeArena *arena = gt_calloc(1, sizeof *arena);
+  arena->slabs = gt_array_new(sizeof (char*));
+  arena->strings = gt_hashmap_new(GT_HASH_STRING, NULL,
+                                  (GtFree) gt_str_delete);
+  arena->node_lock = gt_rwlock_new();
+  arena->mutex = gt_mutex_new();
+  return arena;
+}
+
+GtNodeArena* gt_node_arena_ref(GtNodeArena *arena)
+{
+  gt_assert(arena);
+  gt_mutex_lock(arena->mutex);
+  arena->reference_count++;
+  gt_mutex_unlock(arena->mutex);
+  return arena;
+}
+
+static size_t node_arena_size_class(size_t size)
+{
+  gt_assert(size > 0);
+  return (size - 1) / NODE_ARENA_ALIGNMENT;
+}
+
+static void* node_arena_alloc_large(GtNodeArena *arena, size_t size)
+{
+  NodeArenaLarge *obj = gt_malloc(sizeof *obj + size);
+  obj->previous = NULL;
+  gt_mutex_lock(arena->mutex);
+  obj->next = arena->large_objects;
+  if (obj->next)
+    obj->next->previous = obj;
+  arena->large_objects = obj;
+  arena->num_of_live_objects++;
+  gt_mutex_unlock(arena->mutex);
+  return obj + 1;
+}
+
+void* gt_node_arena_alloc(GtNodeArena *arena, size_t size)
+{
+  NodeArenaFree *obj;
+  size_t size_class;
+  gt_assert(arena && !arena->deleted);
+  if (size > NODE_ARENA_MAX_SIZE)
+    return node_arena_alloc_large(arena, size);
+  size_class = node_arena_size_class(size);
+  gt_mutex_lock(arena->mutex);
+  if ((obj = arena->free_lists[size_class]) != NULL)
+    arena->free_lists[size_class] = obj->next;
+  else {
+    size = (size_class + 1) * NODE_ARENA_ALIGNMENT;
+    if (arena->slab_left < size) {
+      /* the rest of the current slab is wasted, it is smaller than the
+         largest object */
+      arena->slab_ptr = gt_malloc(NODE_ARENA_SLAB_SIZE);
+      arena->slab_left = NODE_ARENA_SLAB_SIZE;
+      gt_array_add(arena->slabs, arena->slab_ptr);
+    }
+    obj = (NodeArenaFree*) arena->slab_ptr;
+    arena->slab_ptr += size;
+    arena->slab_left -= size;
+  }
+  arena->num_of_live_objects++;
+  gt_mutex_unlock(arena->mutex);
+  return obj;
+}
+
+void* gt_node_arena_realloc(GtNodeArena *arena, void *ptr, size_t old_size,
+                            size_t new_size)
+{
+  void *new_ptr;
+  gt_assert(arena && ptr && new_size);
+  /* objects of the same size class are large enough already */
+  if (old_size <= NODE_ARENA_MAX_SIZE && new_size <= NODE_ARENA_MAX_SIZE &&
+      node_arena_size_class(old_size) == node_arena_size_class(new_size)) {
+    return ptr;
+  }
+  new_ptr = gt_node_arena_alloc(arena, new_size);
+  memcpy(new_ptr, ptr, MIN(old_size, new_size));
+  gt_node_arena_free(arena, ptr, old_size);
+  return new_ptr;
+}
+
+static void node_arena_release(GtNodeArena *arena)
+{
+  NodeArenaLarge *obj;
+  GtUword i;
+  for (i = 0; i < gt_array_size(arena->slabs); i++)
+    gt_free(*(char**) gt_array_get(arena->slabs, i));
+  gt_array_delete(arena->slabs);
+  while ((obj = arena->large_objects) != NULL) {
+    arena->large_objects = obj->next;
+    gt_free(obj);
+  }
+  gt_hashmap_delete(arena->strings);
+  gt_rwlock_delete(arena->node_lock);
+  gt_mutex_delete(arena->mutex);
+  gt_free(arena);
+}
+
+void gt_node_arena_free(GtNodeArena *arena, void *ptr, size_t size)
+{
+  NodeArenaLarge *large = NULL;
+  NodeArenaFree *obj = ptr;
+  size_t size_class;
+  bool release;
+  gt_assert(arena && ptr);
+  gt_mutex_lock(arena->mutex);
+  gt_assert(arena->num_of_live_objects > 0);
+  if (size > NODE_ARENA_MAX_SIZE) {
+    large = (NodeArenaLarge*) ptr - 1;
+    if (large->previous)
+      large->previous->next = large->next;
+    else
+      arena->large_objects = large->next;
+    if (large->next)
+      large->next->previous = large->previous;
+  }
+  else {
+    size_class = node_arena_size_class(size);
+    obj->next = arena->free_lists[size_class];
+    arena->free_lists[size_class] = obj;
+  }
+  arena->num_of_live_objects--;
+  release = arena->deleted && !arena->num_of_live_objects;
+  gt_mutex_unlock(arena->mutex);
+  gt_free(large);
+  if (release)
+    node_arena_release(arena);
+}
+
+GtStr* gt_node_arena_get_str(GtNodeArena *arena, const GtStr *str)
+{
+  GtStr *arena_str;
+  gt_assert(arena && str);
+  gt_mutex_lock(arena->mutex);
+  if (!(arena_str = gt_hashmap_get(arena->strings, gt_str_get(str)))) {
+    arena_str = gt_str_clone(str);
+    gt_hashmap_add(arena->strings, gt_str_get(arena_str), arena_str);
+  }
+  gt_mutex_unlock(arena->mutex);
+  return arena_str;
+}
+
+GtRWLock* gt_node_arena_get_node_lock(GtNodeArena *arena)
+{
+  gt_assert(arena);
+  return arena->node_lock;
+}
+
+void gt_node_arena_delete(GtNodeArena *arena)
+{
+  bool release;
+  if (!arena) return;
+  gt_mutex_lock(arena->mutex);
+  if (arena->reference_count) {
+    arena->reference_count--;
+    gt_mutex_unlock(arena->mutex);
+    return;
+  }
+  arena->deleted = true;
+  release = !arena->num_of_live_objects;
+  gt_mutex_unlock(arena->mutex);
+  if (release)
+    node_arena_release(arena);
+}
+
+void gt_node_arena_release_all(GtNodeArena *arena)
+{
+  if (!arena) return;
+  gt_assert(!arena->reference_count && !arena->deleted);
+  node_arena_release(arena);
+}
+
+int gt_node_arena_unit_test(GtError *err)
+{
+  GtNodeArena *arena;
+  GtStr *str, *arena_str;
+  void *objs[3000], *obj;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  arena = gt_node_arena_new();
+  for (i = 0; i < 3000UL; i++) {
+    objs[i] = gt_node_arena_alloc(arena, 1 + i % 100);
+    memset(objs[i], (int) (i & 0xff), 1 + i % 100);
+  }
+  for (i = 0; !had_err && i < 3000UL; i++) {
+    gt_ensure(((unsigned char*) objs[i])[i % 100] == (i & 0xff));
+    gt_ensure((GtUword) objs[i] % NODE_ARENA_ALIGNMENT == 0);
+  }
+  /* freed memory is reused for objects of the same size */
+  obj = objs[42];
+  gt_node_arena_free(arena, objs[42], 43);
+  objs[42] = gt_node_arena_alloc(arena, 43);
+  gt_ensure(objs[42] == obj);
+  /* large objects bypass the slabs */
+  obj = gt_node_arena_alloc(arena, NODE_ARENA_MAX_SIZE + 1);
+  gt_node_arena_free(arena, obj, NODE_ARENA_MAX_SIZE + 1);
+  /* resizing keeps the contents, also beyond the slabs and back */
+  obj = gt_node_arena_alloc(arena, 10);
+  memcpy(obj, "arena", 6);
+  obj = gt_node_arena_realloc(arena, obj, 10, 16);
+  obj = gt_node_arena_realloc(arena, obj, 16, 2 * NODE_ARENA_MAX_SIZE);
+  obj = gt_node_arena_realloc(arena, obj, 2 * NODE_ARENA_MAX_SIZE, 6);
+  gt_ensure(!strcmp(obj, "arena"));
+  gt_node_arena_free(arena, obj, 6);
+  /* equal strings are stored once */
+  str = gt_str_new_cstr("ctg123");
+  arena_str = gt_node_arena_get_str(arena, str);
+  gt_ensure(arena_str != str && !gt_str_cmp(arena_str, str));
+  gt_ensure(gt_node_arena_get_str(arena, str) == arena_str);
+  gt_str_delete(str);
+  /* the arena stays alive until the last object is freed */
+  gt_node_arena_delete(arena);
+  for (i = 0; i < 3000UL; i++)
+    gt_node_arena_free(arena, objs[i], 1 + i % 100);
+
+  /* releasing the arena in bulk frees the objects still in use */
+  arena = gt_node_arena_new();
+  for (i = 0; i < 3000UL; i++)
+    (void) gt_node_arena_alloc(arena, 1 + i % (2 * NODE_ARENA_MAX_SIZE));
+  str = gt_str_new_cstr("ctg123");
+  (void) gt_node_arena_get_str(arena, str);
+  gt_str_delete(str);
+  gt_node_arena_release_all(arena);
+
+  return had_err;
+}
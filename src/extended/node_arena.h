@@ -0,0 +1,62 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <stddef.h>
+#include "core/error_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+
+/* The <GtNodeArena> class hands out the memory of genome nodes and of the
+   objects they own (children lists, attribute maps) from large slabs instead
+   of allocating every object on its own. Freed objects are kept in per size
+   free lists and the slabs are released together once the arena has been
+   deleted and the last object allocated from it has been freed, so nodes may
+   safely outlive the stream that created them. The nodes also share the
+   strings and the lock kept by the arena. */
+typedef struct GtNodeArena GtNodeArena;
+
+GtNodeArena* gt_node_arena_new(void);
+GtNodeArena* gt_node_arena_ref(GtNodeArena *arena);
+/* Returns uninitialized memory of <size> bytes from <arena>. */
+void*        gt_node_arena_alloc(GtNodeArena *arena, size_t size);
+/* Resizes the memory <ptr> of <old_size> bytes from <arena> to <new_size>
+   bytes, keeping its contents up to the smaller size. Returns the possibly
+   moved memory. */
+void*        gt_node_arena_realloc(GtNodeArena *arena, void *ptr,
+                                   size_t old_size, size_t new_size);
+/* Gives the memory <ptr> of <size> bytes back to <arena>. <size> must be the
+   one <ptr> was allocated with. */
+void         gt_node_arena_free(GtNodeArena *arena, void *ptr, size_t size);
+/* Returns the string kept by <arena> which equals <str>, every distinct
+   string is stored only once. The string belongs to <arena> and is freed
+   together with its slabs, nodes use it without taking a reference. */
+GtStr*       gt_node_arena_get_str(GtNodeArena *arena, const GtStr *str);
+/* Returns the lock which protects the reference counts of all nodes
+   allocated from <arena>. */
+GtRWLock*    gt_node_arena_get_node_lock(GtNodeArena *arena);
+void         gt_node_arena_delete(GtNodeArena *arena);
+/* Deletes <arena> and releases all its memory at once, including the nodes
+   allocated from it which have not been deleted yet. Their destructors are
+   not called, so they must neither be used afterwards nor hold anything not
+   allocated from <arena> (user data, observers or children on the heap).
+   <arena> must not be referenced elsewhere. */
+void         gt_node_arena_release_all(GtNodeArena *arena);
+int          gt_node_arena_unit_test(GtError *err);
+
+#endif
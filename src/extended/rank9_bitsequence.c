@@ -0,0 +1,403 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/assert_api.h"
+#include "core/byte_popcount_api.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "extended/rank9_bitsequence.h"
+
+/* bits per block and words per block, each block is stored as the absolute
+   count, the relative counts and the data words */
+#define GT_RANK9_BLOCKBITS     512UL
+#define GT_RANK9_DATAWORDS     8UL
+#define GT_RANK9_BLOCKWORDS    (GT_RANK9_DATAWORDS + 2UL)
+/* every GT_RANK9_SAMPLERATE-th 1 (0) bit is sampled for select */
+#define GT_RANK9_SAMPLERATE    512UL
+
+struct GtRank9Bitsequence {
+  uint64_t *blocks;
+  GtUword  *select_1_samples,
+           *select_0_samples,
+            num_of_bits,
+            num_of_blocks,
+            num_of_ones;
+};
+
+static inline unsigned int gt_rank9_popcount(uint64_t x)
+{
+#ifdef __SSE4_2__
+  return (unsigned int) __builtin_popcountll(x);
+#else
+  /* see page 11, Knuth TAOCP Vol 4 F1A */
+  x = x - ((x >> 1) & (uint64_t) 0x5555555555555555ULL);
+  x = (x & (uint64_t) 0x3333333333333333ULL) +
+      ((x >> 2) & (uint64_t) 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & (uint64_t) 0x0f0f0f0f0f0f0f0fULL;
+  return (unsigned int) ((uint64_t) 0x0101010101010101ULL * x >> 56);
+#endif
+}
+
+/* number of 1 bits in the words of a block before word <word> */
+static inline GtUword gt_rank9_relative(const uint64_t *block,
+                                        GtUword word)
+{
+  /* the count for word w > 0 is stored at bit 9 * (w - 1), for w == 0 the
+     shift by 63 reads the unused (zero) topmost bit */
+  const int64_t t = (int64_t) word - 1;
+  return (GtUword) ((block[1] >> ((t + ((t >> 60) & 8)) * 9)) & 0x1FF);
+}
+
+/* number of 1 bits in the <bits> most significant bits of <w> */
+static inline GtUword gt_rank9_word_prefix(uint64_t w, unsigned int bits)
+{
+  return bits == 0 ? 0 : (GtUword) gt_rank9_popcount(w >> (64U - bits));
+}
+
+static inline uint64_t gt_rank9_get_input_word(const GtBitsequence *bitseq,
+                                               GtUword word,
+                                               GtUword num_of_words)
+{
+#if GT_LOGWORDSIZE == 6
+  gt_assert(word < num_of_words);
+  return (uint64_t) bitseq[word];
+#else
+  uint64_t w = ((uint64_t) bitseq[GT_MULT2(word)]) << 32;
+  if (GT_MULT2(word) + 1 < num_of_words)
+    w |= (uint64_t) bitseq[GT_MULT2(word) + 1];
+  return w;
+#endif
+}
+
+static void gt_rank9_bitsequence_fill_samples(GtRank9Bitsequence *rbs,
+                                              GtUword *samples,
+                                              GtUword num_of_samples,
+                                              bool ones)
+{
+  GtUword block, count, sample = 0;
+  for (block = 0; block + 1 < rbs->num_of_blocks; block++) {
+    /* number of the wanted bits upto the end of <block> */
+    count = rbs->blocks[(block + 1) * GT_RANK9_BLOCKWORDS];
+    if (!ones)
+      count = (block + 1) * GT_RANK9_BLOCKBITS - count;
+    while (sample < num_of_samples &&
+           sample * GT_RANK9_SAMPLERATE + 1 <= count)
+      samples[sample++] = block;
+  }
+  while (sample < num_of_samples)
+    samples[sample++] = rbs->num_of_blocks - 1;
+}
+
+GtRank9Bitsequence* gt_rank9_bitsequence_new(const GtBitsequence *bitseq,
+                                             GtUword num_of_bits)
+{
+  GtUword block, word, num_of_words, num_of_input_words, ones = 0;
+  GtRank9Bitsequence *rbs = gt_malloc(sizeof (*rbs));
+  gt_assert(bitseq != NULL || num_of_bits == 0);
+
+  rbs->num_of_bits = num_of_bits;
+  num_of_words = (num_of_bits + 63) / 64;
+  num_of_input_words = GT_NUMOFINTSFORBITS(num_of_bits);
+  /* one additional block at the end holds the total count, so that rank
+     queries at position <num_of_bits> need no special case */
+  rbs->num_of_blocks = num_of_bits / GT_RANK9_BLOCKBITS + 1;
+  rbs->blocks = gt_calloc((size_t) rbs->num_of_blocks * GT_RANK9_BLOCKWORDS,
+                          sizeof (*rbs->blocks));
+  for (block = 0; block < rbs->num_of_blocks; block++) {
+    uint64_t *b = rbs->blocks + block * GT_RANK9_BLOCKWORDS;
+    GtUword relative = 0;
+    b[0] = (uint64_t) ones;
+    for (word = 0; word < GT_RANK9_DATAWORDS; word++) {
+      GtUword idx = block * GT_RANK9_DATAWORDS + word;
+      uint64_t w = 0;
+      if (idx < num_of_words) {
+        w = gt_rank9_get_input_word(bitseq, idx, num_of_input_words);
+        /* clear the bits behind the end of the sequence */
+        if (idx + 1 == num_of_words && num_of_bits % 64 != 0)
+          w &= ~((uint64_t) 0) << (64 - num_of_bits % 64);
+      }
+      b[2 + word] = w;
+      if (word > 0)
+        b[1] |= ((uint64_t) relative) << (9 * (word - 1));
+      relative += gt_rank9_popcount(w);
+    }
+    ones += relative;
+  }
+  rbs->num_of_ones = ones;
+  rbs->select_1_samples =
+    gt_malloc(sizeof (*rbs->select_1_samples) *
+              (ones / GT_RANK9_SAMPLERATE + 2));
+  gt_rank9_bitsequence_fill_samples(rbs, rbs->select_1_samples,
+                                    ones / GT_RANK9_SAMPLERATE + 2, true);
+  rbs->select_0_samples =
+    gt_malloc(sizeof (*rbs->select_0_samples) *
+              ((num_of_bits - ones) / GT_RANK9_SAMPLERATE + 2));
+  gt_rank9_bitsequence_fill_samples(rbs, rbs->select_0_samples,
+                                    (num_of_bits - ones) / GT_RANK9_SAMPLERATE
+                                    + 2, false);
+  return rbs;
+}
+
+GtUword gt_rank9_bitsequence_length(const GtRank9Bitsequence *rbs)
+{
+  gt_assert(rbs != NULL);
+  return rbs->num_of_bits;
+}
+
+int gt_rank9_bitsequence_access(const GtRank9Bitsequence *rbs,
+                                GtUword position)
+{
+  const uint64_t *block;
+  gt_assert(rbs != NULL && position < rbs->num_of_bits);
+  block = rbs->blocks + (position / GT_RANK9_BLOCKBITS) * GT_RANK9_BLOCKWORDS;
+  return (int) ((block[2 + (position % GT_RANK9_BLOCKBITS) / 64]
+                 >> (63 - position % 64)) & 1);
+}
+
+GtUword gt_rank9_bitsequence_rank_1(const GtRank9Bitsequence *rbs,
+                                    GtUword position)
+{
+  const uint64_t *block;
+  GtUword word;
+  gt_assert(rbs != NULL && position <= rbs->num_of_bits);
+  block = rbs->blocks + (position / GT_RANK9_BLOCKBITS) * GT_RANK9_BLOCKWORDS;
+  word = (position % GT_RANK9_BLOCKBITS) / 64;
+  return (GtUword) block[0] + gt_rank9_relative(block, word) +
+         gt_rank9_word_prefix(block[2 + word],
+                              (unsigned int) (position % 64));
+}
+
+GtUword gt_rank9_bitsequence_rank_0(const GtRank9Bitsequence *rbs,
+                                    GtUword position)
+{
+  return position - gt_rank9_bitsequence_rank_1(rbs, position);
+}
+
+int gt_rank9_bitsequence_access_rank_1(const GtRank9Bitsequence *rbs,
+                                       GtUword position,
+                                       GtUword *rank_1)
+{
+  const uint64_t *block;
+  uint64_t w;
+  GtUword word;
+  unsigned int offset;
+  gt_assert(rbs != NULL && position < rbs->num_of_bits && rank_1 != NULL);
+  block = rbs->blocks + (position / GT_RANK9_BLOCKBITS) * GT_RANK9_BLOCKWORDS;
+  word = (position % GT_RANK9_BLOCKBITS) / 64;
+  w = block[2 + word];
+  offset = (unsigned int) (position % 64);
+  *rank_1 = (GtUword) block[0] + gt_rank9_relative(block, word) +
+            gt_rank9_word_prefix(w, offset);
+  return (int) ((w >> (63 - offset)) & 1);
+}
+
+uint64_t gt_rank9_bitsequence_get_word(const GtRank9Bitsequence *rbs,
+                                       GtUword word)
+{
+  gt_assert(rbs != NULL && word < (rbs->num_of_bits + 63) / 64);
+  return rbs->blocks[(word / GT_RANK9_DATAWORDS) * GT_RANK9_BLOCKWORDS + 2 +
+                     word % GT_RANK9_DATAWORDS];
+}
+
+/* position of the <num>th 1 bit in <w>, counted from the most significant
+   bit, <num> has to be between 1 and popcount(<w>) */
+static inline unsigned int gt_rank9_word_select(uint64_t w, GtUword num)
+{
+  unsigned int shift = 56, count, pos = 0;
+  gt_assert(num > 0 && num <= (GtUword) gt_rank9_popcount(w));
+  for (;;) {
+    unsigned char byte = (unsigned char) ((w >> shift) & 0xFF);
+    count = (unsigned int) gt_byte_popcount[byte];
+    if ((GtUword) count >= num)
+      break;
+    num -= count;
+    pos += 8;
+    shift -= 8;
+  }
+  w >>= shift;
+  for (shift = 7; ; shift--, pos++) {
+    if ((w >> shift) & 1) {
+      if (--num == 0)
+        break;
+    }
+  }
+  return pos;
+}
+
+/* number of 1 (or 0) bits before <block> */
+static inline GtUword gt_rank9_block_count(const GtRank9Bitsequence *rbs,
+                                           GtUword block, bool ones)
+{
+  GtUword count = (GtUword) rbs->blocks[block * GT_RANK9_BLOCKWORDS];
+  return ones ? count : block * GT_RANK9_BLOCKBITS - count;
+}
+
+static GtUword gt_rank9_bitsequence_select(const GtRank9Bitsequence *rbs,
+                                           const GtUword *samples,
+                                           GtUword num, bool ones)
+{
+  GtUword sample, left, right, word, count;
+  const uint64_t *block;
+  uint64_t w;
+
+  sample = (num - 1) / GT_RANK9_SAMPLERATE;
+  /* the wanted bit lies in a block between the two samples, find the last
+     block with fewer than <num> bits before it */
+  left = samples[sample];
+  right = samples[sample + 1];
+  while (left < right) {
+    GtUword mid = left + GT_DIV2(right - left + 1);
+    if (gt_rank9_block_count(rbs, mid, ones) < num)
+      left = mid;
+    else
+      right = mid - 1;
+  }
+  num -= gt_rank9_block_count(rbs, left, ones);
+  block = rbs->blocks + left * GT_RANK9_BLOCKWORDS;
+  for (word = 1; word < GT_RANK9_DATAWORDS; word++) {
+    count = gt_rank9_relative(block, word);
+    if (!ones)
+      count = word * 64 - count;
+    if (count >= num)
+      break;
+  }
+  word--;
+  count = gt_rank9_relative(block, word);
+  if (!ones)
+    count = word * 64 - count;
+  num -= count;
+  w = ones ? block[2 + word] : ~block[2 + word];
+  return left * GT_RANK9_BLOCKBITS + word * 64 + gt_rank9_word_select(w, num);
+}
+
+GtUword gt_rank9_bitsequence_select_1(const GtRank9Bitsequence *rbs,
+                                      GtUword num)
+{
+  gt_assert(rbs != NULL);
+  if (num == 0 || num > rbs->num_of_ones)
+    return rbs->num_of_bits;
+  return gt_rank9_bitsequence_select(rbs, rbs->select_1_samples, num, true);
+}
+
+GtUword gt_rank9_bitsequence_select_0(const GtRank9Bitsequence *rbs,
+                                      GtUword num)
+{
+  gt_assert(rbs != NULL);
+  if (num == 0 || num > rbs->num_of_bits - rbs->num_of_ones)
+    return rbs->num_of_bits;
+  return gt_rank9_bitsequence_select(rbs, rbs->select_0_samples, num, false);
+}
+
+void gt_rank9_bitsequence_prefetch(const GtRank9Bitsequence *rbs,
+                                   GtUword position)
+{
+  gt_assert(rbs != NULL && position <= rbs->num_of_bits);
+#ifdef __GNUC__
+  __builtin_prefetch(rbs->blocks +
+                     (position / GT_RANK9_BLOCKBITS) * GT_RANK9_BLOCKWORDS);
+#endif
+}
+
+size_t gt_rank9_bitsequence_size(const GtRank9Bitsequence *rbs)
+{
+  gt_assert(rbs != NULL);
+  return sizeof (*rbs) +
+         sizeof (*rbs->blocks) * rbs->num_of_blocks * GT_RANK9_BLOCKWORDS +
+         sizeof (*rbs->select_1_samples) *
+         (rbs->num_of_ones / GT_RANK9_SAMPLERATE + 2) +
+         sizeof (*rbs->select_0_samples) *
+         ((rbs->num_of_bits - rbs->num_of_ones) / GT_RANK9_SAMPLERATE + 2);
+}
+
+void gt_rank9_bitsequence_delete(GtRank9Bitsequence *rbs)
+{
+  if (rbs != NULL) {
+    gt_free(rbs->blocks);
+    gt_free(rbs->select_1_samples);
+    gt_free(rbs->select_0_samples);
+    gt_free(rbs);
+  }
+}
+
+static int gt_rank9_bitsequence_unit_test_random(GtError *err,
+                                                 GtUword num_of_bits,
+                                                 GtUword density)
+{
+  int had_err = 0;
+  GtUword idx, ones = 0, zeros = 0, rank_1;
+  GtBitsequence *bitseq;
+  GtRank9Bitsequence *rbs;
+
+  bitseq = gt_calloc((size_t) GT_NUMOFINTSFORBITS(num_of_bits + 1),
+                     sizeof (*bitseq));
+  for (idx = 0; idx < num_of_bits; idx++) {
+    if (gt_rand_max(99UL) < density)
+      GT_SETIBIT(bitseq, idx);
+  }
+  /* set a bit behind the end, it must not be counted */
+  GT_SETIBIT(bitseq, num_of_bits);
+  rbs = gt_rank9_bitsequence_new(bitseq, num_of_bits);
+  gt_ensure(gt_rank9_bitsequence_length(rbs) == num_of_bits);
+  for (idx = 0; !had_err && idx < num_of_bits; idx++) {
+    int bit = GT_ISIBITSET(bitseq, idx) ? 1 : 0;
+    gt_ensure(gt_rank9_bitsequence_rank_1(rbs, idx) == ones);
+    gt_ensure(gt_rank9_bitsequence_rank_0(rbs, idx) == zeros);
+    gt_ensure(gt_rank9_bitsequence_access(rbs, idx) == bit);
+    gt_ensure(gt_rank9_bitsequence_access_rank_1(rbs, idx, &rank_1) == bit);
+    gt_ensure(rank_1 == ones);
+    gt_ensure((int) ((gt_rank9_bitsequence_get_word(rbs, idx / 64)
+                      >> (63 - idx % 64)) & 1) == bit);
+    if (bit == 1) {
+      ones++;
+      gt_ensure(gt_rank9_bitsequence_select_1(rbs, ones) == idx);
+    }
+    else {
+      zeros++;
+      gt_ensure(gt_rank9_bitsequence_select_0(rbs, zeros) == idx);
+    }
+  }
+  gt_ensure(gt_rank9_bitsequence_rank_1(rbs, num_of_bits) == ones);
+  gt_ensure(gt_rank9_bitsequence_rank_0(rbs, num_of_bits) == zeros);
+  gt_ensure(gt_rank9_bitsequence_select_1(rbs, ones + 1) == num_of_bits);
+  gt_ensure(gt_rank9_bitsequence_select_0(rbs, zeros + 1) == num_of_bits);
+  gt_ensure(gt_rank9_bitsequence_select_1(rbs, 0) == num_of_bits);
+  gt_rank9_bitsequence_delete(rbs);
+  gt_free(bitseq);
+  return had_err;
+}
+
+int gt_rank9_bitsequence_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtUword sizes[] = {1UL, 63UL, 64UL, 511UL, 512UL, 513UL, 4096UL, 100000UL},
+          densities[] = {0, 1UL, 50UL, 99UL, 100UL};
+  size_t i, j;
+  gt_error_check(err);
+
+  for (i = 0; !had_err && i < sizeof (sizes) / sizeof (sizes[0]); i++) {
+    for (j = 0;
+         !had_err && j < sizeof (densities) / sizeof (densities[0]);
+         j++) {
+      had_err = gt_rank9_bitsequence_unit_test_random(err, sizes[i],
+                                                      densities[j]);
+    }
+  }
+  return had_err;
+}
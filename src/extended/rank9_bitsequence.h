@@ -0,0 +1,92 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef RANK9_BITSEQUENCE_H
+#define RANK9_BITSEQUENCE_H
+
+#include <stdint.h>
+#include "core/error_api.h"
+#include "core/intbits.h"
+
+/* The <GtRank9Bitsequence> class stores an uncompressed bitvector together
+   with the rank9 counters described by Vigna in 2008: every block of 512 bits
+   is preceded by the absolute number of 1 bits before the block and the
+   relative counts of its eight words, so that a rank query touches a single
+   cache line. A sample of every 512th 1 and 0 bit accelerates select. */
+typedef struct GtRank9Bitsequence GtRank9Bitsequence;
+
+/* Returns a new <GtRank9Bitsequence> object for the first <num_of_bits> bits
+   of <bitseq>. Words in <bitseq> are assumed to be filled continuously with the
+   most significant bits first, like in a <GtCompressedBitsequence>. */
+GtRank9Bitsequence* gt_rank9_bitsequence_new(const GtBitsequence *bitseq,
+                                             GtUword num_of_bits);
+
+/* Returns the number of bits stored in <rbs>. */
+GtUword             gt_rank9_bitsequence_length(const GtRank9Bitsequence *rbs);
+
+/* Returns 0 or 1 according to the bit at <position> in <rbs>. Note that
+   <position> has to be smaller than the length of <rbs>. */
+int                 gt_rank9_bitsequence_access(const GtRank9Bitsequence *rbs,
+                                                GtUword position);
+
+/* Returns the number of 1 bits in <rbs> before <position>, that is, unlike
+   <gt_compressed_bitsequence_rank_1()>, excluding <position>. Note that
+   <position> has to be smaller or equal to the length of <rbs>. */
+GtUword             gt_rank9_bitsequence_rank_1(const GtRank9Bitsequence *rbs,
+                                                GtUword position);
+
+/* Returns the number of 0 bits in <rbs> before <position>. Note that
+   <position> has to be smaller or equal to the length of <rbs>. */
+GtUword             gt_rank9_bitsequence_rank_0(const GtRank9Bitsequence *rbs,
+                                                GtUword position);
+
+/* Returns the bit at <position> in <rbs> and stores the number of 1 bits
+   before <position> in <rank_1>, both are read from the same block. Note that
+   <position> has to be smaller than the length of <rbs>. */
+int                 gt_rank9_bitsequence_access_rank_1(
+                                                  const GtRank9Bitsequence *rbs,
+                                                  GtUword position,
+                                                  GtUword *rank_1);
+
+/* Returns the <word>th 64 bit word of the bits stored in <rbs>, the first bit
+   in the most significant position. Bits behind the end of <rbs> are 0. */
+uint64_t            gt_rank9_bitsequence_get_word(const GtRank9Bitsequence *rbs,
+                                                  GtUword word);
+
+/* Returns the position of the <num>th bit set to 1 in <rbs>. Returns length of
+   <rbs> if there are less than <num> bits set to 1. */
+GtUword             gt_rank9_bitsequence_select_1(const GtRank9Bitsequence *rbs,
+                                                  GtUword num);
+
+/* Returns the position of the <num>th bit set to 0 in <rbs>. Returns length of
+   <rbs> if there are less than <num> bits set to 0. */
+GtUword             gt_rank9_bitsequence_select_0(const GtRank9Bitsequence *rbs,
+                                                  GtUword num);
+
+/* Requests the block containing <position> to be loaded into the cache, so
+   that a following rank query for a nearby position does not stall. Does
+   nothing if the compiler does not support prefetching. */
+void                gt_rank9_bitsequence_prefetch(const GtRank9Bitsequence *rbs,
+                                                  GtUword position);
+
+/* Returns the size of <rbs> in bytes. */
+size_t              gt_rank9_bitsequence_size(const GtRank9Bitsequence *rbs);
+
+/* Frees the memory of <rbs>. */
+void                gt_rank9_bitsequence_delete(GtRank9Bitsequence *rbs);
+
+int                 gt_rank9_bitsequence_unit_test(GtError *err);
+#endif
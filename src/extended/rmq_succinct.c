@@ -0,0 +1,477 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdint.h>
+#include "core/arraydef.h"
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/intbits.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "extended/rank9_bitsequence.h"
+#include "extended/rmq_succinct.h"
+
+/* the minimal excess is stored for blocks of GT_RMQ_SUCCINCT_BLOCKBITS
+   parentheses, a sparse table of one byte offsets answers queries for ranges
+   of upto GT_RMQ_SUCCINCT_SUPERBLOCK blocks, a sparse table over superblocks
+   answers all longer ranges */
+#define GT_RMQ_SUCCINCT_BLOCKBITS     512UL
+#define GT_RMQ_SUCCINCT_LOGSUPERBLOCK 6U
+#define GT_RMQ_SUCCINCT_SUPERBLOCK    (1UL << GT_RMQ_SUCCINCT_LOGSUPERBLOCK)
+
+struct GtRMQSuccinct {
+  /* 1 bits are opening, 0 bits closing parentheses, the ith closing
+     parenthesis belongs to index i of the array */
+  GtRank9Bitsequence *parentheses;
+  /* minimal excess in a block, relative to the excess before the block */
+  int16_t *block_minimum;
+  /* block_table[k-1][b] is the offset of the leftmost block with minimal
+     excess among the 2^k blocks starting at block b */
+  unsigned char *block_table[GT_RMQ_SUCCINCT_LOGSUPERBLOCK];
+  /* superblock_table[k][s] is the leftmost block with minimal excess among
+     the 2^k superblocks starting at superblock s */
+  GtUword **superblock_table,
+          superblock_levels,
+          num_of_superblocks,
+          num_of_blocks,
+          num_of_bits,
+          size;
+  /* excess of a byte, minimal excess of its prefixes and the position of the
+     leftmost such prefix */
+  signed char byte_excess[256],
+              byte_min_excess[256];
+  unsigned char byte_min_position[256];
+};
+
+/* number of opening minus number of closing parentheses before <position> */
+static inline GtWord gt_rmq_succinct_excess(const GtRMQSuccinct *rmq,
+                                            GtUword position)
+{
+  return (GtWord) GT_MULT2(gt_rank9_bitsequence_rank_1(rmq->parentheses,
+                                                       position)) -
+         (GtWord) position;
+}
+
+static inline GtWord gt_rmq_succinct_block_excess(const GtRMQSuccinct *rmq,
+                                                  GtUword block)
+{
+  return gt_rmq_succinct_excess(rmq, block * GT_RMQ_SUCCINCT_BLOCKBITS) +
+         (GtWord) rmq->block_minimum[block];
+}
+
+/* Returns the leftmost position among the parentheses from <from> to <to>
+   after which the excess is minimal. <excess> is the excess before <from>
+   and is set to the minimal excess. */
+static GtUword gt_rmq_succinct_scan(const GtRMQSuccinct *rmq,
+                                    GtUword from,
+                                    GtUword to,
+                                    GtWord *excess)
+{
+  GtWord current = *excess, best = current + 2;
+  GtUword position, best_position = from;
+  uint64_t word = 0;
+
+  gt_assert(from <= to && to < rmq->num_of_bits);
+  for (position = from; position <= to; /* Nothing */) {
+    unsigned int offset = (unsigned int) (position % 64);
+
+    if (offset == 0 || position == from)
+      word = gt_rank9_bitsequence_get_word(rmq->parentheses, position / 64);
+    if (offset % 8 == 0 && position + 7 <= to) {
+      unsigned int byte = (unsigned int) (word >> (56 - offset)) & 0xFFU;
+      if (current + rmq->byte_min_excess[byte] < best) {
+        best = current + rmq->byte_min_excess[byte];
+        best_position = position + rmq->byte_min_position[byte];
+      }
+      current += rmq->byte_excess[byte];
+      position += 8;
+    }
+    else {
+      current += ((word >> (63 - offset)) & 1) ? 1 : -1;
+      if (current < best) {
+        best = current;
+        best_position = position;
+      }
+      position++;
+    }
+  }
+  *excess = best;
+  return best_position;
+}
+
+static inline GtUword gt_rmq_succinct_table_block(const GtRMQSuccinct *rmq,
+                                                  unsigned int level,
+                                                  GtUword block)
+{
+  return level == 0 ? block : block + rmq->block_table[level - 1][block];
+}
+
+/* the one of <block1> and <block2> with the smaller minimal excess, <block1>
+   on ties as it is the left one */
+static inline GtUword gt_rmq_succinct_min2(const GtRMQSuccinct *rmq,
+                                           GtUword block1,
+                                           GtUword block2)
+{
+  return gt_rmq_succinct_block_excess(rmq, block2) <
+         gt_rmq_succinct_block_excess(rmq, block1) ? block2 : block1;
+}
+
+/* leftmost block with minimal excess among the superblocks from <first> to
+   <last> */
+static GtUword gt_rmq_succinct_min_superblock(const GtRMQSuccinct *rmq,
+                                              GtUword first,
+                                              GtUword last)
+{
+  unsigned int level = gt_determinebitspervalue(last - first + 1) - 1;
+
+  return gt_rmq_succinct_min2(rmq, rmq->superblock_table[level][first],
+                              rmq->superblock_table[level]
+                                                   [last + 1 - (1UL << level)]);
+}
+
+/* leftmost block with minimal excess among the blocks from <first> to
+   <last> */
+static GtUword gt_rmq_succinct_min_block(const GtRMQSuccinct *rmq,
+                                         GtUword first,
+                                         GtUword last)
+{
+  GtUword left, right, best;
+
+  if (last - first < GT_RMQ_SUCCINCT_SUPERBLOCK) {
+    unsigned int level = gt_determinebitspervalue(last - first + 1) - 1;
+    return gt_rmq_succinct_min2(rmq,
+                                gt_rmq_succinct_table_block(rmq, level, first),
+                                gt_rmq_succinct_table_block(rmq, level,
+                                                   last + 1 - (1UL << level)));
+  }
+  left = first / GT_RMQ_SUCCINCT_SUPERBLOCK;
+  right = last / GT_RMQ_SUCCINCT_SUPERBLOCK;
+  best = gt_rmq_succinct_min_block(rmq, first,
+                                   (left + 1) * GT_RMQ_SUCCINCT_SUPERBLOCK - 1);
+  if (right > left + 1) {
+    best = gt_rmq_succinct_min2(rmq, best,
+                                gt_rmq_succinct_min_superblock(rmq, left + 1,
+                                                               right - 1));
+  }
+  return gt_rmq_succinct_min2(rmq, best,
+                              gt_rmq_succinct_min_block(rmq,
+                                         right * GT_RMQ_SUCCINCT_SUPERBLOCK,
+                                         last));
+}
+
+GtUword gt_rmq_succinct_find_min_index(const GtRMQSuccinct *rmq,
+                                       GtUword start,
+                                       GtUword end)
+{
+  GtUword from, to, first, last, position;
+  GtWord excess;
+
+  gt_assert(rmq != NULL && start <= end && end < rmq->size);
+  if (start == end)
+    return start;
+  /* the leftmost minimum of the excess between the closing parentheses of
+     <start> and <end> is the closing parenthesis of the leftmost minimum */
+  from = gt_rank9_bitsequence_select_0(rmq->parentheses, start + 1);
+  to = gt_rank9_bitsequence_select_0(rmq->parentheses, end + 1);
+  first = from / GT_RMQ_SUCCINCT_BLOCKBITS;
+  last = to / GT_RMQ_SUCCINCT_BLOCKBITS;
+  excess = gt_rmq_succinct_excess(rmq, from);
+  if (first == last) {
+    position = gt_rmq_succinct_scan(rmq, from, to, &excess);
+  }
+  else {
+    GtUword candidate;
+    GtWord candidate_excess;
+
+    position = gt_rmq_succinct_scan(rmq, from,
+                                    (first + 1) * GT_RMQ_SUCCINCT_BLOCKBITS - 1,
+                                    &excess);
+    if (last > first + 1) {
+      GtUword block = gt_rmq_succinct_min_block(rmq, first + 1, last - 1);
+      candidate_excess = gt_rmq_succinct_excess(rmq, block *
+                                                     GT_RMQ_SUCCINCT_BLOCKBITS);
+      if (candidate_excess + (GtWord) rmq->block_minimum[block] < excess) {
+        position = gt_rmq_succinct_scan(rmq,
+                                        block * GT_RMQ_SUCCINCT_BLOCKBITS,
+                                        (block + 1) *
+                                        GT_RMQ_SUCCINCT_BLOCKBITS - 1,
+                                        &candidate_excess);
+        excess = candidate_excess;
+      }
+    }
+    candidate_excess = gt_rmq_succinct_excess(rmq, last *
+                                                   GT_RMQ_SUCCINCT_BLOCKBITS);
+    candidate = gt_rmq_succinct_scan(rmq, last * GT_RMQ_SUCCINCT_BLOCKBITS, to,
+                                     &candidate_excess);
+    if (candidate_excess < excess)
+      position = candidate;
+  }
+  return gt_rank9_bitsequence_rank_0(rmq->parentheses, position);
+}
+
+static void gt_rmq_succinct_init_byte_tables(GtRMQSuccinct *rmq)
+{
+  unsigned int byte, bit;
+
+  for (byte = 0; byte < 256U; byte++) {
+    int excess = 0, min_excess = 9;
+    unsigned char min_position = 0;
+    for (bit = 0; bit < 8U; bit++) {
+      excess += ((byte >> (7U - bit)) & 1U) ? 1 : -1;
+      if (excess < min_excess) {
+        min_excess = excess;
+        min_position = (unsigned char) bit;
+      }
+    }
+    rmq->byte_excess[byte] = (signed char) excess;
+    rmq->byte_min_excess[byte] = (signed char) min_excess;
+    rmq->byte_min_position[byte] = min_position;
+  }
+}
+
+/* Builds the parentheses sequence of the 2d-Min-Heap, in which the parent of
+   index i is the next index to the right with a smaller value, and whose
+   nodes are numbered in postorder. The sequence is written from right to left:
+   the stack holds the values on the path from the root to the current node. */
+static GtBitsequence* gt_rmq_succinct_parentheses(
+                                           GtRMQSuccinctGetValueFunc get_value,
+                                           const void *data,
+                                           GtUword size,
+                                           GtUword num_of_bits)
+{
+  GtArrayGtUword stack;
+  GtBitsequence *bits;
+  GtUword idx, value, position = num_of_bits - 1;
+
+  bits = gt_calloc((size_t) GT_NUMOFINTSFORBITS(num_of_bits), sizeof (*bits));
+  GT_INITARRAY(&stack, GtUword);
+  /* the last bit is the closing parenthesis of the root */
+  for (idx = size; idx > 0; idx--) {
+    value = get_value(data, idx - 1);
+    while (stack.nextfreeGtUword > 0 &&
+           stack.spaceGtUword[stack.nextfreeGtUword - 1] >= value) {
+      stack.nextfreeGtUword--;
+      position--;
+      GT_SETIBIT(bits, position);
+    }
+    position--;
+    GT_STOREINARRAY(&stack, GtUword, 128UL, value);
+  }
+  /* opening parentheses of the nodes left on the stack and of the root */
+  while (position > 0) {
+    position--;
+    GT_SETIBIT(bits, position);
+  }
+  GT_FREEARRAY(&stack, GtUword);
+  return bits;
+}
+
+GtRMQSuccinct* gt_rmq_succinct_new(GtRMQSuccinctGetValueFunc get_value,
+                                   const void *data,
+                                   GtUword size)
+{
+  GtRMQSuccinct *rmq;
+  GtBitsequence *bits;
+  GtWord *block_excess;
+  GtUword block, superblock, half;
+  unsigned int level;
+
+  gt_assert(get_value != NULL);
+  rmq = gt_calloc((size_t) 1, sizeof (*rmq));
+  gt_rmq_succinct_init_byte_tables(rmq);
+  rmq->size = size;
+  rmq->num_of_bits = GT_MULT2(size) + 2;
+  bits = gt_rmq_succinct_parentheses(get_value, data, size, rmq->num_of_bits);
+  rmq->parentheses = gt_rank9_bitsequence_new(bits, rmq->num_of_bits);
+  gt_free(bits);
+
+  rmq->num_of_blocks = (rmq->num_of_bits + GT_RMQ_SUCCINCT_BLOCKBITS - 1) /
+                       GT_RMQ_SUCCINCT_BLOCKBITS;
+  rmq->block_minimum = gt_malloc(sizeof (*rmq->block_minimum) *
+                                 rmq->num_of_blocks);
+  block_excess = gt_malloc(sizeof (*block_excess) * rmq->num_of_blocks);
+  for (block = 0; block < rmq->num_of_blocks; block++) {
+    GtUword from = block * GT_RMQ_SUCCINCT_BLOCKBITS,
+            to = from + GT_RMQ_SUCCINCT_BLOCKBITS - 1;
+    GtWord minimum = 0;
+    if (to >= rmq->num_of_bits)
+      to = rmq->num_of_bits - 1;
+    (void) gt_rmq_succinct_scan(rmq, from, to, &minimum);
+    rmq->block_minimum[block] = (int16_t) minimum;
+    block_excess[block] = gt_rmq_succinct_excess(rmq, from) + minimum;
+  }
+  for (level = 1U; level <= GT_RMQ_SUCCINCT_LOGSUPERBLOCK; level++) {
+    half = 1UL << (level - 1);
+    rmq->block_table[level - 1] = gt_malloc(sizeof (**rmq->block_table) *
+                                            rmq->num_of_blocks);
+    for (block = 0; block < rmq->num_of_blocks; block++) {
+      GtUword best = gt_rmq_succinct_table_block(rmq, level - 1, block);
+      if (block + half < rmq->num_of_blocks) {
+        GtUword other = gt_rmq_succinct_table_block(rmq, level - 1,
+                                                    block + half);
+        if (block_excess[other] < block_excess[best])
+          best = other;
+      }
+      rmq->block_table[level - 1][block] = (unsigned char) (best - block);
+    }
+  }
+
+  rmq->num_of_superblocks = (rmq->num_of_blocks +
+                             GT_RMQ_SUCCINCT_SUPERBLOCK - 1) /
+                            GT_RMQ_SUCCINCT_SUPERBLOCK;
+  rmq->superblock_levels = (GtUword)
+                           gt_determinebitspervalue(rmq->num_of_superblocks);
+  rmq->superblock_table = gt_malloc(sizeof (*rmq->superblock_table) *
+                                    rmq->superblock_levels);
+  rmq->superblock_table[0] = gt_malloc(sizeof (**rmq->superblock_table) *
+                                       rmq->num_of_superblocks);
+  for (superblock = 0; superblock < rmq->num_of_superblocks; superblock++) {
+    rmq->superblock_table[0][superblock]
+      = gt_rmq_succinct_table_block(rmq, GT_RMQ_SUCCINCT_LOGSUPERBLOCK,
+                                    superblock * GT_RMQ_SUCCINCT_SUPERBLOCK);
+  }
+  for (level = 1U; level < (unsigned int) rmq->superblock_levels; level++) {
+    GtUword *previous = rmq->superblock_table[level - 1];
+    half = 1UL << (level - 1);
+    rmq->superblock_table[level] = gt_malloc(sizeof (**rmq->superblock_table) *
+                                             rmq->num_of_superblocks);
+    for (superblock = 0; superblock < rmq->num_of_superblocks; superblock++) {
+      GtUword best = previous[superblock];
+      if (superblock + half < rmq->num_of_superblocks &&
+          block_excess[previous[superblock + half]] < block_excess[best])
+        best = previous[superblock + half];
+      rmq->superblock_table[level][superblock] = best;
+    }
+  }
+  gt_free(block_excess);
+  return rmq;
+}
+
+size_t gt_rmq_succinct_size(const GtRMQSuccinct *rmq)
+{
+  gt_assert(rmq != NULL);
+  return sizeof (*rmq) + gt_rank9_bitsequence_size(rmq->parentheses) +
+         (sizeof (*rmq->block_minimum) +
+          sizeof (**rmq->block_table) * GT_RMQ_SUCCINCT_LOGSUPERBLOCK) *
+         rmq->num_of_blocks +
+         (sizeof (*rmq->superblock_table) +
+          sizeof (**rmq->superblock_table) * rmq->num_of_superblocks) *
+         rmq->superblock_levels;
+}
+
+void gt_rmq_succinct_delete(GtRMQSuccinct *rmq)
+{
+  GtUword level;
+
+  if (rmq == NULL)
+    return;
+  gt_rank9_bitsequence_delete(rmq->parentheses);
+  gt_free(rmq->block_minimum);
+  for (level = 0; level < (GtUword) GT_RMQ_SUCCINCT_LOGSUPERBLOCK; level++)
+    gt_free(rmq->block_table[level]);
+  for (level = 0; level < rmq->superblock_levels; level++)
+    gt_free(rmq->superblock_table[level]);
+  gt_free(rmq->superblock_table);
+  gt_free(rmq);
+}
+
+static GtUword gt_rmq_succinct_unit_test_get_value(const void *data,
+                                                   GtUword idx)
+{
+  return ((const GtUword *) data)[idx];
+}
+
+/* index of the leftmost minimum, O(<end> - <start>) */
+static GtUword gt_rmq_succinct_naive(const GtUword *values,
+                                     GtUword start,
+                                     GtUword end)
+{
+  GtUword idx, min_idx = start;
+
+  for (idx = start + 1; idx <= end; idx++) {
+    if (values[idx] < values[min_idx])
+      min_idx = idx;
+  }
+  return min_idx;
+}
+
+#define GT_RMQ_SUCCINCT_NOFTESTS 10000UL
+
+static int gt_rmq_succinct_unit_test_values(GtError *err,
+                                            const GtUword *values,
+                                            GtUword size)
+{
+  int had_err = 0;
+  GtRMQSuccinct *rmq;
+  GtUword start, end, idx;
+
+  rmq = gt_rmq_succinct_new(gt_rmq_succinct_unit_test_get_value, values,
+                            size);
+  if (size <= 200UL) {
+    for (start = 0; !had_err && start < size; start++) {
+      for (end = start; !had_err && end < size; end++) {
+        gt_ensure(gt_rmq_succinct_find_min_index(rmq, start, end) ==
+                  gt_rmq_succinct_naive(values, start, end));
+      }
+    }
+  }
+  else {
+    for (idx = 0; !had_err && idx < GT_RMQ_SUCCINCT_NOFTESTS; idx++) {
+      /* mostly short ranges, every 16th range is long */
+      start = gt_rand_max(size - 2);
+      end = start + 1 + gt_rand_max(idx % 16 != 0 ? 1000UL : size - 1 - start);
+      if (end >= size)
+        end = size - 1;
+      gt_ensure(gt_rmq_succinct_find_min_index(rmq, start, end) ==
+                gt_rmq_succinct_naive(values, start, end));
+    }
+  }
+  gt_ensure(gt_rmq_succinct_size(rmq) > 0);
+  gt_rmq_succinct_delete(rmq);
+  return had_err;
+}
+
+int gt_rmq_succinct_unit_test(GtError *err)
+{
+  int had_err = 0;
+  const GtUword sizes[] = {1UL, 2UL, 7UL, 200UL, 5000UL, 300000UL},
+                maxvalues[] = {1UL, 3UL, 1000UL, 1000000UL};
+  GtUword *values, idx;
+  size_t s, m;
+
+  gt_error_check(err);
+  values = gt_malloc(sizeof (*values) * sizes[5]);
+  for (s = 0; !had_err && s < sizeof (sizes) / sizeof (sizes[0]); s++) {
+    for (m = 0;
+         !had_err && m < sizeof (maxvalues) / sizeof (maxvalues[0]);
+         m++) {
+      for (idx = 0; idx < sizes[s]; idx++)
+        values[idx] = gt_rand_max(maxvalues[m]);
+      had_err = gt_rmq_succinct_unit_test_values(err, values, sizes[s]);
+    }
+    /* increasing and decreasing values give the deepest heaps */
+    for (idx = 0; !had_err && idx < sizes[s]; idx++)
+      values[idx] = idx;
+    if (!had_err)
+      had_err = gt_rmq_succinct_unit_test_values(err, values, sizes[s]);
+    for (idx = 0; !had_err && idx < sizes[s]; idx++)
+      values[idx] = sizes[s] - idx;
+    if (!had_err)
+      had_err = gt_rmq_succinct_unit_test_values(err, values, sizes[s]);
+  }
+  gt_free(values);
+  return had_err;
+}
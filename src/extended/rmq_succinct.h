@@ -0,0 +1,57 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef RMQ_SUCCINCT_H
+#define RMQ_SUCCINCT_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* The <GtRMQSuccinct> class answers range minimum queries in constant time
+   without access to the values once it has been constructed. The array is
+   represented by the balanced parentheses sequence of its 2d-Min-Heap with
+   2n+2 bits (Ferrada and Navarro, 2016), together with rank and select support
+   and a sparse table over the minimal excess of blocks of 512 bits. In total,
+   about 3n bits are used, unlike a <GtRMQ> it does not need the array itself.
+   This is useful for large lcp-tables, which are stored byte compressed. */
+typedef struct GtRMQSuccinct GtRMQSuccinct;
+
+/* Function returning the value at index <idx> of the array given by <data>. */
+typedef GtUword (*GtRMQSuccinctGetValueFunc)(const void *data, GtUword idx);
+
+/* Returns a new <GtRMQSuccinct> object for the array of <size> values
+   delivered by <get_value> applied to <data>. The values are requested once
+   each, in decreasing order of their indices. */
+GtRMQSuccinct* gt_rmq_succinct_new(GtRMQSuccinctGetValueFunc get_value,
+                                   const void *data,
+                                   GtUword size);
+
+/* Returns the index of the leftmost minimum among the values with indices
+   from <start> to <end>, both inclusive. Note that <start> has to be smaller
+   or equal to <end>, which has to be smaller than the size of the array. */
+GtUword        gt_rmq_succinct_find_min_index(const GtRMQSuccinct *rmq,
+                                              GtUword start,
+                                              GtUword end);
+
+/* Returns the size of <rmq> in bytes. */
+size_t         gt_rmq_succinct_size(const GtRMQSuccinct *rmq);
+
+/* Frees the memory of <rmq>. */
+void           gt_rmq_succinct_delete(GtRMQSuccinct *rmq);
+
+int            gt_rmq_succinct_unit_test(GtError *err);
+#endif
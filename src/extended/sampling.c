@@ -219,31 +219,27 @@ static void get_pagewise_page(GtSampling *sampling,
                               GtUword *sampled_element,
                               size_t *position)
 {
-  GtWord start = (GtWord) -1,
-         end, middle;
+  GtUword start = 0,
+          end, middle;
 
   gt_assert(sampling->numofsamples != 0);
-  /* should not overflow, because this is a small table indexing into a larger
-     one. */
-  gt_safe_assign(end, sampling->numofsamples);
-  middle = GT_DIV2(end);
-  while (end - start > (GtWord) 1) {
-    if (element_num < sampling->page_sampling[middle]) {
+  gt_assert(sampling->page_sampling[0] <= element_num);
+  /* binary search for the last sample with page_sampling[start] <=
+     element_num in [start, end) */
+  end = sampling->numofsamples;
+  while (end - start > 1UL) {
+    middle = start + GT_DIV2(end - start);
+    if (sampling->page_sampling[middle] <= element_num)
       start = middle;
-    }
-    else {
+    else
       end = middle;
-    }
-    middle = start + GT_DIV2(end - start);
-  }
-  if (middle < 0) {
-    middle = 0;
   }
+  middle = start;
   *sampled_element =
     sampling->current_sample_elementnum =
     sampling->page_sampling[middle];
 
-  sampling->current_sample_num = (GtUword) middle;
+  sampling->current_sample_num = middle;
 
   *position = sampling->samplingtab[middle];
 }
@@ -268,6 +264,22 @@ void gt_sampling_get_page(GtSampling *sampling,
   }
 }
 
+GtUword gt_sampling_num_of_samples(const GtSampling *sampling)
+{
+  gt_assert(sampling != NULL);
+  return sampling->numofsamples;
+}
+
+GtUword gt_sampling_get_sample_elementnum(const GtSampling *sampling,
+                                          GtUword sample_num)
+{
+  gt_assert(sampling != NULL);
+  gt_assert(sample_num < sampling->numofsamples);
+  if (sampling->method == GT_SAMPLING_REGULAR)
+    return sample_num * sampling->sampling_rate;
+  return sampling->page_sampling[sample_num];
+}
+
 GtUword gt_sampling_get_current_elementnum(GtSampling *sampling)
 {
   return sampling->current_sample_elementnum;
@@ -76,6 +76,15 @@ int           gt_sampling_get_next_sample(GtSampling *sampling,
                                           GtUword *sampled_element,
                                           size_t *position);
 
+/* Returns the number of samples stored in <sampling>. */
+GtUword       gt_sampling_num_of_samples(const GtSampling *sampling);
+
+/* Returns the number of the first element of the sample with number
+   <sample_num>. Unlike <gt_sampling_get_page>, this does not change the
+   current sample of <sampling>. */
+GtUword       gt_sampling_get_sample_elementnum(const GtSampling *sampling,
+                                                GtUword sample_num);
+
 /* Returns the sampling rate of <sampling>. */
 GtUword gt_sampling_get_rate(GtSampling *sampling);
 
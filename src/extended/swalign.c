@@ -16,9 +16,18 @@
 */
 
 #include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "core/array_api.h"
 #include "core/array2dim_api.h"
 #include "core/assert_api.h"
 #include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/undef_api.h"
 #include "extended/swalign.h"
@@ -156,3 +165,459 @@ GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction *sf)
                               gt_score_function_get_insertion_score(sf),
                               gt_seq_get_alphabet(u), gt_seq_get_alphabet(v));
 }
+
+/* number of subjects aligned in parallel, one per lane of a vector of 16 bit
+   scores */
+#define SWALIGN_BATCH_LANES     8
+/* the 16 bit lanes are only used if all scores are in this range and if the
+   sequences are not longer than SWALIGN_BATCH_MAXLEN */
+#define SWALIGN_BATCH_MAXSCORE  1024
+#define SWALIGN_BATCH_MAXLEN    ((GtUword) SHRT_MAX)
+
+typedef struct {
+  GtSeq *seq;
+  GtWord score;
+  Coordinate end;
+} GtSWAlignBatchSubject;
+
+struct GtSWAlignBatch {
+  GtScoreFunction *sf;
+  GtSeq *u;
+  GtArray *subjects;
+  bool computed;
+  /* reusable scratch space */
+  GtWord *column;
+  GtUword columnsize;
+  DPentry *dpspace,
+          **dptable;
+  GtUword dpspacesize,
+          dptablesize;
+#ifdef __SSE2__
+  __m128i *vcolumn,
+          *profile;
+  GtUword vcolumnsize,
+          profilesize;
+#endif
+};
+
+GtSWAlignBatch* gt_swalign_batch_new(GtScoreFunction *sf)
+{
+  GtSWAlignBatch *batch;
+  gt_assert(sf);
+  batch = gt_calloc(1, sizeof *batch);
+  batch->sf = gt_score_function_ref(sf);
+  batch->subjects = gt_array_new(sizeof (GtSWAlignBatchSubject));
+  return batch;
+}
+
+void gt_swalign_batch_reset(GtSWAlignBatch *batch, GtSeq *u)
+{
+  gt_assert(batch && u);
+  batch->u = u;
+  gt_array_reset(batch->subjects);
+  batch->computed = false;
+}
+
+GtUword gt_swalign_batch_add(GtSWAlignBatch *batch, GtSeq *v)
+{
+  GtSWAlignBatchSubject subject;
+  gt_assert(batch && batch->u && v);
+  subject.seq = v;
+  subject.score = 0;
+  subject.end.x = subject.end.y = GT_UNDEF_UWORD;
+  gt_array_add(batch->subjects, subject);
+  batch->computed = false;
+  return gt_array_size(batch->subjects) - 1;
+}
+
+GtUword gt_swalign_batch_size(const GtSWAlignBatch *batch)
+{
+  gt_assert(batch);
+  return gt_array_size(batch->subjects);
+}
+
+static inline int swalign_symbol(GtUchar cc, unsigned int alpha_size)
+{
+  return (int) ((cc == WILDCARD) ? alpha_size - 1 : cc);
+}
+
+/* linear space version of swalign_fill_table(), which only determines the
+   maximal score and the first cell (in column major order) it occurs in */
+static void swalign_batch_score_scalar(GtSWAlignBatch *batch,
+                                       GtSWAlignBatchSubject *subject)
+{
+  const GtUchar *u = gt_seq_get_encoded(batch->u),
+                *v = gt_seq_get_encoded(subject->seq);
+  GtUword i, j, ulen = gt_seq_length(batch->u),
+          vlen = gt_seq_length(subject->seq);
+  const int **scores = gt_score_function_get_scores(batch->sf);
+  int deletion_score = gt_score_function_get_deletion_score(batch->sf),
+      insertion_score = gt_score_function_get_insertion_score(batch->sf);
+  unsigned int u_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(batch->u)),
+               v_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(
+                                                               subject->seq));
+  GtWord maxscore, overall_maxscore = LONG_MIN, diagonal;
+
+  if (batch->columnsize < ulen + 1) {
+    batch->columnsize = ulen + 1;
+    batch->column = gt_realloc(batch->column,
+                               sizeof (*batch->column) * batch->columnsize);
+  }
+  memset(batch->column, 0, sizeof (*batch->column) * (ulen + 1));
+  for (j = 1; j <= vlen; j++) {
+    const int *vscores;
+    int vval = swalign_symbol(v[j-1], v_alpha_size);
+    diagonal = 0;
+    for (i = 1; i <= ulen; i++) {
+      vscores = scores[swalign_symbol(u[i-1], u_alpha_size)];
+      maxscore = MAX(MAX(MAX(diagonal + vscores[vval],
+                             batch->column[i-1] + deletion_score),
+                         batch->column[i] + insertion_score), 0);
+      diagonal = batch->column[i];
+      batch->column[i] = maxscore;
+      if (maxscore > overall_maxscore) {
+        overall_maxscore = maxscore;
+        subject->end.x = i;
+        subject->end.y = j;
+      }
+    }
+  }
+  subject->score = overall_maxscore == LONG_MIN ? 0 : overall_maxscore;
+}
+
+#ifdef __SSE2__
+static inline __m128i swalign_batch_select(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* Computes the scores of up to SWALIGN_BATCH_LANES subjects at once with
+   saturated 16 bit arithmetic. The cells are visited in the same order as by
+   swalign_fill_table(), so the end coordinates are the same. Lanes whose
+   score may have saturated are recomputed by the scalar version. */
+static void swalign_batch_score_sse2(GtSWAlignBatch *batch,
+                                     GtSWAlignBatchSubject *subjects,
+                                     GtUword numofsubjects)
+{
+  const GtUchar *u = gt_seq_get_encoded(batch->u),
+                *v[SWALIGN_BATCH_LANES];
+  GtUword i, j, c, lane, ulen = gt_seq_length(batch->u), maxvlen = 0;
+  const int **scores = gt_score_function_get_scores(batch->sf);
+  unsigned int u_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(batch->u)),
+               v_alpha_size[SWALIGN_BATCH_LANES];
+  short vlen[SWALIGN_BATCH_LANES], lanevalues[SWALIGN_BATCH_LANES],
+        lanei[SWALIGN_BATCH_LANES], lanej[SWALIGN_BATCH_LANES];
+  __m128i zero = _mm_setzero_si128(),
+          deletion = _mm_set1_epi16((short)
+                              gt_score_function_get_deletion_score(batch->sf)),
+          insertion = _mm_set1_epi16((short)
+                              gt_score_function_get_insertion_score(batch->sf)),
+          maxscore = _mm_set1_epi16(-1),
+          maxi = zero,
+          maxj = zero,
+          vlenvec;
+
+  gt_assert(numofsubjects > 0 && numofsubjects <= SWALIGN_BATCH_LANES);
+  for (lane = 0; lane < SWALIGN_BATCH_LANES; lane++) {
+    if (lane < numofsubjects) {
+      v[lane] = gt_seq_get_encoded(subjects[lane].seq);
+      vlen[lane] = (short) gt_seq_length(subjects[lane].seq);
+      v_alpha_size[lane]
+        = gt_alphabet_size(gt_seq_get_alphabet(subjects[lane].seq));
+      maxvlen = MAX(maxvlen, (GtUword) vlen[lane]);
+    } else {
+      v[lane] = NULL;
+      vlen[lane] = 0;
+      v_alpha_size[lane] = 0;
+    }
+  }
+  vlenvec = _mm_loadu_si128((const __m128i *) vlen);
+  if (batch->vcolumnsize < ulen + 1) {
+    gt_free(batch->vcolumn);
+    batch->vcolumnsize = ulen + 1;
+    batch->vcolumn = gt_malloc(sizeof (*batch->vcolumn) * batch->vcolumnsize);
+  }
+  if (batch->profilesize < u_alpha_size) {
+    gt_free(batch->profile);
+    batch->profilesize = u_alpha_size;
+    batch->profile = gt_malloc(sizeof (*batch->profile) * batch->profilesize);
+  }
+  for (i = 0; i <= ulen; i++)
+    _mm_storeu_si128(batch->vcolumn + i, zero);
+  for (j = 1; j <= maxvlen; j++) {
+    __m128i diagonal = zero, up = zero, h,
+            jvec = _mm_set1_epi16((short) j),
+            /* lanes of the subjects with at least <j> symbols */
+            column_mask = _mm_cmpgt_epi16(vlenvec,
+                                          _mm_set1_epi16((short) (j - 1)));
+
+    /* score profile of column <j>: the score of each symbol of u against the
+       <j>-th symbol of each subject */
+    for (c = 0; c < u_alpha_size; c++) {
+      for (lane = 0; lane < SWALIGN_BATCH_LANES; lane++) {
+        lanevalues[lane] = (j <= (GtUword) vlen[lane])
+                           ? (short) scores[c][swalign_symbol(v[lane][j-1],
+                                                            v_alpha_size[lane])]
+                           : 0;
+      }
+      _mm_storeu_si128(batch->profile + c,
+                       _mm_loadu_si128((const __m128i *) lanevalues));
+    }
+    for (i = 1; i <= ulen; i++) {
+      __m128i left = _mm_loadu_si128(batch->vcolumn + i), better;
+      h = _mm_adds_epi16(diagonal,
+                         _mm_loadu_si128(batch->profile +
+                                         swalign_symbol(u[i-1], u_alpha_size)));
+      h = _mm_max_epi16(h, _mm_adds_epi16(up, deletion));
+      h = _mm_max_epi16(h, _mm_adds_epi16(left, insertion));
+      h = _mm_max_epi16(h, zero);
+      diagonal = left;
+      _mm_storeu_si128(batch->vcolumn + i, h);
+      up = h;
+      better = _mm_and_si128(_mm_cmpgt_epi16(h, maxscore), column_mask);
+      maxscore = swalign_batch_select(better, h, maxscore);
+      maxi = swalign_batch_select(better, _mm_set1_epi16((short) i), maxi);
+      maxj = swalign_batch_select(better, jvec, maxj);
+    }
+  }
+  _mm_storeu_si128((__m128i *) lanevalues, maxscore);
+  _mm_storeu_si128((__m128i *) lanei, maxi);
+  _mm_storeu_si128((__m128i *) lanej, maxj);
+  for (lane = 0; lane < numofsubjects; lane++) {
+    if (lanevalues[lane] >= SHRT_MAX - 2 * SWALIGN_BATCH_MAXSCORE) {
+      swalign_batch_score_scalar(batch, subjects + lane);
+    } else if (vlen[lane] > 0) {
+      subjects[lane].score = (GtWord) lanevalues[lane];
+      subjects[lane].end.x = (GtUword) lanei[lane];
+      subjects[lane].end.y = (GtUword) lanej[lane];
+    } else {
+      subjects[lane].score = 0;
+    }
+  }
+}
+
+static bool swalign_batch_use_sse2(const GtSWAlignBatch *batch)
+{
+  const int **scores = gt_score_function_get_scores(batch->sf);
+  unsigned int c, d,
+               u_alpha_size = gt_alphabet_size(gt_seq_get_alphabet(batch->u));
+  GtUword idx;
+  int deletion_score = gt_score_function_get_deletion_score(batch->sf),
+      insertion_score = gt_score_function_get_insertion_score(batch->sf);
+
+  if (gt_seq_length(batch->u) > SWALIGN_BATCH_MAXLEN
+        || abs(deletion_score) > SWALIGN_BATCH_MAXSCORE
+        || abs(insertion_score) > SWALIGN_BATCH_MAXSCORE)
+    return false;
+  for (idx = 0; idx < gt_array_size(batch->subjects); idx++) {
+    const GtSWAlignBatchSubject *subject = gt_array_get(batch->subjects, idx);
+    unsigned int v_alpha_size
+      = gt_alphabet_size(gt_seq_get_alphabet(subject->seq));
+    if (gt_seq_length(subject->seq) > SWALIGN_BATCH_MAXLEN)
+      return false;
+    for (c = 0; c < u_alpha_size; c++) {
+      for (d = 0; d < v_alpha_size; d++) {
+        if (abs(scores[c][d]) > SWALIGN_BATCH_MAXSCORE)
+          return false;
+      }
+    }
+  }
+  return true;
+}
+#endif
+
+void gt_swalign_batch_compute(GtSWAlignBatch *batch)
+{
+  GtSWAlignBatchSubject *subjects;
+  GtUword idx, numofsubjects;
+  gt_assert(batch && batch->u);
+
+  subjects = gt_array_get_space(batch->subjects);
+  numofsubjects = gt_array_size(batch->subjects);
+  if (gt_seq_length(batch->u) == 0) {
+    for (idx = 0; idx < numofsubjects; idx++)
+      subjects[idx].score = 0;
+  }
+#ifdef __SSE2__
+  else if (swalign_batch_use_sse2(batch)) {
+    for (idx = 0; idx < numofsubjects; idx += SWALIGN_BATCH_LANES) {
+      swalign_batch_score_sse2(batch, subjects + idx,
+                               MIN(numofsubjects - idx,
+                                   (GtUword) SWALIGN_BATCH_LANES));
+    }
+  }
+#endif
+  else {
+    for (idx = 0; idx < numofsubjects; idx++)
+      swalign_batch_score_scalar(batch, subjects + idx);
+  }
+  batch->computed = true;
+}
+
+GtWord gt_swalign_batch_get_score(const GtSWAlignBatch *batch, GtUword idx)
+{
+  const GtSWAlignBatchSubject *subject;
+  gt_assert(batch && batch->computed);
+  subject = gt_array_get(batch->subjects, idx);
+  return subject->score;
+}
+
+GtAlignment* gt_swalign_batch_get_alignment(GtSWAlignBatch *batch,
+                                            GtUword idx)
+{
+  GtSWAlignBatchSubject *subject;
+  Coordinate alignment_start, alignment_end, max_coordinate;
+  GtRange urange, vrange;
+  GtAlignment *a;
+  GtUword i;
+  gt_assert(batch && batch->computed);
+
+  subject = gt_array_get(batch->subjects, idx);
+  if (subject->score <= 0)
+    return NULL;
+  alignment_end = subject->end;
+  /* the DP matrix is only needed up to the end of the alignment */
+  if (batch->dptablesize < alignment_end.x + 1) {
+    batch->dptablesize = alignment_end.x + 1;
+    batch->dptable = gt_realloc(batch->dptable, sizeof (*batch->dptable) *
+                                                batch->dptablesize);
+  }
+  if (batch->dpspacesize < (alignment_end.x + 1) * (alignment_end.y + 1)) {
+    batch->dpspacesize = (alignment_end.x + 1) * (alignment_end.y + 1);
+    batch->dpspace = gt_realloc(batch->dpspace, sizeof (*batch->dpspace) *
+                                                batch->dpspacesize);
+  }
+  for (i = 0; i <= alignment_end.x; i++)
+    batch->dptable[i] = batch->dpspace + i * (alignment_end.y + 1);
+  memset(batch->dptable[0], 0,
+         sizeof (*batch->dpspace) * (alignment_end.y + 1));
+  for (i = 1; i <= alignment_end.x; i++)
+    batch->dptable[i][0].score = 0;
+  swalign_fill_table(batch->dptable,
+                     gt_seq_get_encoded(batch->u), alignment_end.x,
+                     gt_seq_get_encoded(subject->seq), alignment_end.y,
+                     gt_score_function_get_scores(batch->sf),
+                     gt_score_function_get_deletion_score(batch->sf),
+                     gt_score_function_get_insertion_score(batch->sf),
+                     &max_coordinate,
+                     gt_alphabet_size(gt_seq_get_alphabet(batch->u)),
+                     gt_alphabet_size(gt_seq_get_alphabet(subject->seq)));
+  gt_assert(max_coordinate.x == alignment_end.x &&
+            max_coordinate.y == alignment_end.y);
+  a = gt_alignment_new();
+  alignment_start = traceback(a, batch->dptable, alignment_end.x,
+                              alignment_end.y);
+  urange.start = --alignment_start.x;
+  vrange.start = --alignment_start.y;
+  urange.end = --alignment_end.x;
+  vrange.end = --alignment_end.y;
+  gt_alignment_set_seqs(a,
+                        (const GtUchar *) (gt_seq_get_orig(batch->u)
+                                           + alignment_start.x),
+                        alignment_end.x - alignment_start.x + 1,
+                        (const GtUchar *) (gt_seq_get_orig(subject->seq)
+                                           + alignment_start.y),
+                        alignment_end.y - alignment_start.y + 1);
+  gt_alignment_set_urange(a, urange);
+  gt_alignment_set_vrange(a, vrange);
+  return a;
+}
+
+void gt_swalign_batch_delete(GtSWAlignBatch *batch)
+{
+  if (!batch) return;
+  gt_score_function_delete(batch->sf);
+  gt_array_delete(batch->subjects);
+  gt_free(batch->column);
+  gt_free(batch->dptable);
+  gt_free(batch->dpspace);
+#ifdef __SSE2__
+  gt_free(batch->vcolumn);
+  gt_free(batch->profile);
+#endif
+  gt_free(batch);
+}
+
+static char* swalign_random_dna(GtUword length)
+{
+  static const char characters[] = "acgtn";
+  char *seq = gt_malloc(sizeof (char) * (length + 1));
+  GtUword i;
+
+  for (i = 0; i < length; i++)
+    seq[i] = characters[gt_rand_max(gt_rand_max(9) ? 3 : 4)];
+  seq[length] = '\0';
+  return seq;
+}
+
+int gt_swalign_batch_unit_test(GtError *err)
+{
+  GtAlphabet *alpha;
+  GtScoreMatrix *sm;
+  GtScoreFunction *sf;
+  GtSWAlignBatch *batch;
+  GtSeq *u, *v[50];
+  char *useq, *vseq[50];
+  GtUword i, j, idx, round, query;
+  int had_err = 0;
+  gt_error_check(err);
+
+  alpha = gt_alphabet_new_dna();
+  for (round = 0; !had_err && round < 2UL; round++) {
+    sm = gt_score_matrix_new(alpha);
+    for (i = 0; i < gt_alphabet_size(alpha); i++) {
+      for (j = 0; j < gt_alphabet_size(alpha); j++) {
+        gt_score_matrix_set_score(sm, i, j,
+                                  i == j ? 2 : (round == 0 ? -1 : -3));
+      }
+    }
+    sf = gt_score_function_new(sm, round == 0 ? -2 : -1, round == 0 ? -2 : -4);
+    batch = gt_swalign_batch_new(sf);
+    /* the scratch space of the batch is reused for the second query */
+    for (query = 0; !had_err && query < 2UL; query++) {
+      useq = swalign_random_dna(1 + gt_rand_max(80));
+      u = gt_seq_new(useq, strlen(useq), alpha);
+      gt_swalign_batch_reset(batch, u);
+      for (i = 0; i < 50UL; i++) {
+        vseq[i] = swalign_random_dna(i == 7 ? 0 : gt_rand_max(60));
+        v[i] = gt_seq_new(vseq[i], strlen(vseq[i]), alpha);
+        idx = gt_swalign_batch_add(batch, v[i]);
+        gt_ensure(idx == i);
+      }
+      gt_ensure(gt_swalign_batch_size(batch) == 50UL);
+      gt_swalign_batch_compute(batch);
+      for (i = 0; !had_err && i < 50UL; i++) {
+        GtAlignment *a = NULL, *b;
+        if (gt_seq_length(v[i]) > 0)
+          a = gt_swalign(u, v[i], sf);
+        b = gt_swalign_batch_get_alignment(batch, i);
+        gt_ensure((a == NULL) == (b == NULL));
+        gt_ensure((b == NULL) == (gt_swalign_batch_get_score(batch, i) == 0));
+        if (!had_err && a != NULL) {
+          gt_ensure(gt_alignment_get_urange(a).start
+                    == gt_alignment_get_urange(b).start);
+          gt_ensure(gt_alignment_get_urange(a).end
+                    == gt_alignment_get_urange(b).end);
+          gt_ensure(gt_alignment_get_vrange(a).start
+                    == gt_alignment_get_vrange(b).start);
+          gt_ensure(gt_alignment_get_vrange(a).end
+                    == gt_alignment_get_vrange(b).end);
+          gt_ensure(gt_alignment_get_length(a) == gt_alignment_get_length(b));
+          gt_ensure(gt_alignment_eval(a) == gt_alignment_eval(b));
+        }
+        gt_alignment_delete(a);
+        gt_alignment_delete(b);
+      }
+      for (i = 0; i < 50UL; i++) {
+        gt_seq_delete(v[i]);
+        gt_free(vseq[i]);
+      }
+      gt_seq_delete(u);
+      gt_free(useq);
+    }
+    gt_swalign_batch_delete(batch);
+    gt_score_function_delete(sf);
+  }
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
@@ -27,4 +27,34 @@
    If no such alignment was found, NULL is returned. */
 GtAlignment* gt_swalign(GtSeq *u, GtSeq *v, const GtScoreFunction*);
 
+/* A <GtSWAlignBatch> (locally) aligns one sequence u against many sequences
+   v at once. The scores are computed for several v in parallel, using SIMD
+   instructions if available. The results are the same as those of
+   <gt_swalign()>. The scratch space is kept and reused for further
+   batches. */
+typedef struct GtSWAlignBatch GtSWAlignBatch;
+
+GtSWAlignBatch* gt_swalign_batch_new(GtScoreFunction*);
+/* Removes all sequences from <batch> and sets <u> as the sequence the
+   following sequences are aligned against. <u> is not copied and must
+   exist as long as <batch> uses it. */
+void            gt_swalign_batch_reset(GtSWAlignBatch *batch, GtSeq *u);
+/* Adds <v> to <batch> and returns its index. <v> is not copied. */
+GtUword         gt_swalign_batch_add(GtSWAlignBatch *batch, GtSeq *v);
+GtUword         gt_swalign_batch_size(const GtSWAlignBatch *batch);
+/* Computes the optimal local alignment scores of u against all sequences in
+   <batch>. */
+void            gt_swalign_batch_compute(GtSWAlignBatch *batch);
+/* Returns the optimal local alignment score of u and the sequence with index
+   <idx>. */
+GtWord          gt_swalign_batch_get_score(const GtSWAlignBatch *batch,
+                                           GtUword idx);
+/* Returns one optimal local alignment of u and the sequence with index <idx>
+   or NULL, if no alignment with a positive score exists. The alignment
+   refers to the original sequences and must be deleted by the caller. */
+GtAlignment*    gt_swalign_batch_get_alignment(GtSWAlignBatch *batch,
+                                               GtUword idx);
+void            gt_swalign_batch_delete(GtSWAlignBatch *batch);
+int             gt_swalign_batch_unit_test(GtError *err);
+
 #endif
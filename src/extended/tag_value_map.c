@@ -29,15 +29,33 @@
    tag\0value\0tag\0value\0\0
 */
 
+/* Resizes <map> from <old_size> to <new_size> bytes, on the heap if <arena> is
+   NULL. */
+static GtTagValueMap resize_map(GtTagValueMap map, GtNodeArena *arena,
+                                size_t old_size, size_t new_size)
+{
+  if (arena)
+    return gt_node_arena_realloc(arena, map, old_size, new_size);
+  return gt_realloc(map, new_size);
+}
+
 GtTagValueMap gt_tag_value_map_new(const char *tag, const char *value)
+{
+  return gt_tag_value_map_new_in_arena(NULL, tag, value);
+}
+
+GtTagValueMap gt_tag_value_map_new_in_arena(GtNodeArena *arena,
+                                            const char *tag,
+                                            const char *value)
 {
   GtTagValueMap map;
-  size_t tag_len, value_len;
+  size_t tag_len, value_len, map_size;
   gt_assert(tag && value);
   tag_len = strlen(tag);
   value_len = strlen(value);
   gt_assert(tag_len && value_len);
-  map = gt_malloc((tag_len + 1 + value_len + 1 + 1) * sizeof *map);
+  map_size = (tag_len + 1 + value_len + 1 + 1) * sizeof *map;
+  map = arena ? gt_node_arena_alloc(arena, map_size) : gt_malloc(map_size);
   memcpy(map, tag, tag_len + 1);
   memcpy(map + tag_len + 1, value, value_len + 1);
   map[tag_len + 1 + value_len + 1] = '\0';
@@ -117,6 +135,12 @@ static size_t get_map_nof_items(const GtTagValueMap map)
 
 void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
                           const char *value)
+{
+  gt_tag_value_map_add_in_arena(map, NULL, tag, value);
+}
+
+void gt_tag_value_map_add_in_arena(GtTagValueMap *map, GtNodeArena *arena,
+                                   const char *tag, const char *value)
 {
   size_t tag_len, value_len, map_len = 0;
   GT_UNUSED const char *tag_already_used;
@@ -128,7 +152,8 @@ void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
   tag_already_used = get_value(*map, tag, &map_len);
   gt_assert(!tag_already_used); /* map does not contain given <tag> already */
   /* allocate additional space */
-  *map = gt_realloc(*map, map_len + tag_len + 1 + value_len + 1 + 1);
+  *map = resize_map(*map, arena, map_len + 1,
+                    map_len + tag_len + 1 + value_len + 1 + 1);
   /* store new tag/value pair */
   memcpy(*map + map_len, tag, tag_len + 1);
   memcpy(*map + map_len + tag_len + 1, value, value_len + 1);
@@ -136,6 +161,12 @@ void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
 }
 
 void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
+{
+  gt_tag_value_map_remove_in_arena(map, NULL, tag);
+}
+
+void gt_tag_value_map_remove_in_arena(GtTagValueMap *map, GtNodeArena *arena,
+                                      const char *tag)
 {
   size_t tag_len, value_len, map_len;
   char *value;
@@ -150,12 +181,19 @@ void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
   /* move memory from end position of value to start position of tag */
   memmove(value - tag_len - 1, value + value_len + 1,
           map_len - ((size_t) value - (size_t) *map + value_len));
-  *map = gt_realloc(*map, map_len - (tag_len + 1 + value_len + 1) + 1);
+  *map = resize_map(*map, arena, map_len + 1,
+                    map_len - (tag_len + 1 + value_len + 1) + 1);
   gt_assert((*map)[map_len - (tag_len + 1 + value_len + 1)] == '\0');
 }
 
 void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
                           const char *new_value)
+{
+  gt_tag_value_map_set_in_arena(map, NULL, tag, new_value);
+}
+
+void gt_tag_value_map_set_in_arena(GtTagValueMap *map, GtNodeArena *arena,
+                                   const char *tag, const char *new_value)
 {
   size_t old_value_len, new_value_len, map_len = 0;
   char *old_value;
@@ -166,7 +204,7 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
   /* determine current map length */
   old_value = get_value(*map, tag, &map_len);
   if (!old_value)
-    return gt_tag_value_map_add(map, tag, new_value);
+    return gt_tag_value_map_add_in_arena(map, arena, tag, new_value);
   /* tag already used -> replace it */
   old_value_len = strlen(old_value);
   map_len = get_map_len(*map);
@@ -174,13 +212,15 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
     memcpy(old_value, new_value, new_value_len);
     memmove(old_value + new_value_len, old_value + old_value_len,
             map_len - ((size_t) old_value - (size_t) *map + old_value_len) + 1);
-    *map = gt_realloc(*map, map_len - (old_value_len - new_value_len) + 1);
+    *map = resize_map(*map, arena, map_len + 1,
+                      map_len - (old_value_len - new_value_len) + 1);
   }
   else if (new_value_len == old_value_len) {
     memcpy(old_value, new_value, new_value_len);
   }
   else { /* (new_value_len > old_value_len)  */
-    *map = gt_realloc(*map, map_len + (new_value_len - old_value_len) + 1);
+    *map = resize_map(*map, arena, map_len + 1,
+                      map_len + (new_value_len - old_value_len) + 1);
     /* determine old_value again, realloc() might have moved it */
     old_value = get_value(*map, tag, &map_len);
     gt_assert(old_value);
@@ -400,11 +440,37 @@ int gt_tag_value_map_unit_test(GtError *err)
     gt_tag_value_map_delete(map);
   }
 
+  /* test a map in an arena, growing beyond the slab objects and back */
+  if (!had_err) {
+    GtNodeArena *arena = gt_node_arena_new();
+    char long_value[1024];
+    memset(long_value, 'x', sizeof long_value - 1);
+    long_value[sizeof long_value - 1] = '\0';
+    map = gt_tag_value_map_new_in_arena(arena, "tag 1", "value 1");
+    gt_tag_value_map_add_in_arena(&map, arena, "tag 2", "value 2");
+    gt_tag_value_map_set_in_arena(&map, arena, "tag 1", long_value);
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 1"), long_value));
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 2"), "value 2"));
+    gt_tag_value_map_remove_in_arena(&map, arena, "tag 1");
+    gt_ensure(gt_tag_value_map_size(map) == 1);
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 2"), "value 2"));
+    gt_tag_value_map_delete_in_arena(map, arena);
+    gt_node_arena_delete(arena);
+  }
+
   return had_err;
 }
 
 void gt_tag_value_map_delete(GtTagValueMap map)
+{
+  gt_tag_value_map_delete_in_arena(map, NULL);
+}
+
+void gt_tag_value_map_delete_in_arena(GtTagValueMap map, GtNodeArena *arena)
 {
   if (!map) return;
-  gt_free(map);
+  if (arena)
+    gt_node_arena_free(arena, map, get_map_len(map) + 1);
+  else
+    gt_free(map);
 }
@@ -18,8 +18,28 @@
 #ifndef TAG_VALUE_MAP_H
 #define TAG_VALUE_MAP_H
 
+#include "extended/node_arena.h"
 #include "extended/tag_value_map_api.h"
 
+/* The following functions are like the ones without the <_in_arena> suffix,
+   but the memory of the map comes from <arena>, or from the heap if <arena> is
+   NULL. All calls for one map must use the same <arena>. */
+GtTagValueMap gt_tag_value_map_new_in_arena(GtNodeArena *arena,
+                                            const char *tag,
+                                            const char *value);
+void          gt_tag_value_map_add_in_arena(GtTagValueMap *tag_value_map,
+                                            GtNodeArena *arena,
+                                            const char *tag,
+                                            const char *value);
+void          gt_tag_value_map_set_in_arena(GtTagValueMap *tag_value_map,
+                                            GtNodeArena *arena,
+                                            const char *tag,
+                                            const char *value);
+void          gt_tag_value_map_remove_in_arena(GtTagValueMap *tag_value_map,
+                                               GtNodeArena *arena,
+                                               const char *tag);
+void          gt_tag_value_map_delete_in_arena(GtTagValueMap tag_value_map,
+                                               GtNodeArena *arena);
 void          gt_tag_value_map_show(const GtTagValueMap);
 int           gt_tag_value_map_unit_test(GtError*);
 
@@ -17,6 +17,7 @@
 #include "extended/wtree_rep.h"
 
 #include "core/assert_api.h"
+#include "core/class_alloc.h"
 #include "core/ma.h"
 #include "core/unused_api.h"
 
@@ -68,6 +69,23 @@ GtUword gt_wtree_rank(GtWtree *wtree,
   return ULONG_MAX;
 }
 
+void gt_wtree_rank_batch(GtWtree *wtree,
+                         const GtUword *positions,
+                         const GtWtreeSymbol *symbols,
+                         GtUword *ranks,
+                         GtUword num)
+{
+  GtUword idx;
+  gt_assert(wtree != NULL);
+  gt_assert(wtree->c_class != NULL);
+  if (wtree->c_class->rank_batch_func != NULL) {
+    wtree->c_class->rank_batch_func(wtree, positions, symbols, ranks, num);
+    return;
+  }
+  for (idx = 0; idx < num; idx++)
+    ranks[idx] = gt_wtree_rank(wtree, positions[idx], symbols[idx]);
+}
+
 GtUword gt_wtree_select(GtWtree *wtree,
                         GtUword i,
                         GtWtreeSymbol symbol)
@@ -92,13 +110,15 @@ GtUword gt_wtree_num_of_symbols(GtWtree *wtree)
 const GtWtreeClass* gt_wtree_class_new(size_t size,
                                        GtWtreeAccessFunc access_func,
                                        GtWtreeRankFunc rank_func,
+                                       GtWtreeRankBatchFunc rank_batch_func,
                                        GtWtreeSelectFunc select_func,
                                        GtWtreeDeleteFunc delete_func)
 {
-  GtWtreeClass *wtree_c = gt_malloc(sizeof (*wtree_c));
+  GtWtreeClass *wtree_c = gt_class_alloc(sizeof (*wtree_c));
   wtree_c->size = size;
   wtree_c->access_func = access_func;
   wtree_c->rank_func = rank_func;
+  wtree_c->rank_batch_func = rank_batch_func;
   wtree_c->select_func = select_func;
   wtree_c-> delete_func = delete_func;
   return wtree_c;
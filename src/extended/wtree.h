@@ -45,6 +45,16 @@ GtUword       gt_wtree_rank(GtWtree *wtree,
                             GtUword pos,
                             GtWtreeSymbol symbol);
 
+/* Stores the number of symbols <symbols>[j] in the prefix of <wtree> upto
+   position <positions>[j] in <ranks>[j] for all j < <num>. Implementations
+   may answer the queries interleaved to hide memory latency, otherwise this
+   is equivalent to calling <gt_wtree_rank()> for each query. */
+void          gt_wtree_rank_batch(GtWtree *wtree,
+                                  const GtUword *positions,
+                                  const GtWtreeSymbol *symbols,
+                                  GtUword *ranks,
+                                  GtUword num);
+
 /* Returns the position of the <i>th <symbol> in wtree, returns ULONG_MAX if the
    <wtree> contains less than <i> symbols. Note that 0 < <i> <= length of
    <wtree>.
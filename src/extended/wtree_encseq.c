@@ -349,7 +349,7 @@ const GtWtreeClass* gt_wtree_encseq_class(void)
   if (this_c == NULL) {
     this_c =
       gt_wtree_class_new(sizeof (GtWtreeEncseq), gt_wtree_encseq_access,
-                         gt_wtree_encseq_rank, gt_wtree_encseq_select,
+                         gt_wtree_encseq_rank, NULL, gt_wtree_encseq_select,
                          gt_wtree_encseq_delete);
   }
   return this_c;
@@ -0,0 +1,388 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <string.h>
+
+#include "core/alphabet_api.h"
+#include "core/chardef.h"
+#include "core/encseq_api.h"
+#include "core/ensure.h"
+#include "core/intbits.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/mathsupport.h"
+#include "core/unused_api.h"
+#include "extended/rank9_bitsequence.h"
+#include "extended/wtree_encseq.h"
+#include "extended/wtree_matrix_encseq.h"
+#include "extended/wtree_rep.h"
+
+/* number of rank queries answered together by the batched rank */
+#define GT_WTREE_MATRIX_BATCHSIZE 64UL
+
+struct GtWtreeMatrixEncseq {
+  GtWtree              parent_instance;
+  GtAlphabet          *alpha;
+  GtRank9Bitsequence **levelbits;
+  /* number of 0 bits in each level, the 1 bits of a level are stored behind
+     the 0 bits in the following level */
+  GtUword             *zeros;
+  unsigned int         alpha_size,
+                       levels;
+};
+
+const GtWtreeClass* gt_wtree_matrix_encseq_class(void);
+
+#define gt_wtree_matrix_encseq_cast(wtree) \
+  gt_wtree_cast(gt_wtree_matrix_encseq_class(), wtree)
+
+#define GT_WTREE_MATRIX_BIT(WM, SYM, LEVEL) \
+  (((SYM) >> ((WM)->levels - 1 - (LEVEL))) & 1)
+
+static GtWtreeSymbol gt_wtree_matrix_encseq_access(GtWtree *wtree,
+                                                   GtUword pos)
+{
+  GtWtreeMatrixEncseq *wm;
+  GtWtreeSymbol sym = 0;
+  GtUword rank_1;
+  unsigned int level;
+  gt_assert(wtree != NULL);
+
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  gt_assert(pos < wtree->members->length);
+
+  for (level = 0; level < wm->levels; level++) {
+    int bit = gt_rank9_bitsequence_access_rank_1(wm->levelbits[level], pos,
+                                                 &rank_1);
+    sym = (sym << 1) | (GtWtreeSymbol) bit;
+    pos = bit == 1 ? wm->zeros[level] + rank_1 : pos - rank_1;
+  }
+  return sym;
+}
+
+/* maps the interval [<*start>, <*end>) of one level to the interval of the
+   next level containing the symbols with the same bit as <sym> */
+static inline void gt_wtree_matrix_encseq_descend(GtWtreeMatrixEncseq *wm,
+                                                  unsigned int level,
+                                                  GtWtreeSymbol sym,
+                                                  GtUword *start,
+                                                  GtUword *end)
+{
+  const GtRank9Bitsequence *bits = wm->levelbits[level];
+  if (GT_WTREE_MATRIX_BIT(wm, sym, level) == 1) {
+    *start = wm->zeros[level] + gt_rank9_bitsequence_rank_1(bits, *start);
+    *end = wm->zeros[level] + gt_rank9_bitsequence_rank_1(bits, *end);
+  }
+  else {
+    *start = gt_rank9_bitsequence_rank_0(bits, *start);
+    *end = gt_rank9_bitsequence_rank_0(bits, *end);
+  }
+}
+
+static GtUword gt_wtree_matrix_encseq_rank(GtWtree *wtree,
+                                           GtUword pos,
+                                           GtWtreeSymbol symbol)
+{
+  GtWtreeMatrixEncseq *wm;
+  GtUword start = 0,
+          end = pos + 1; /* convert position to exclusive end */
+  unsigned int level;
+  gt_assert(wtree != NULL);
+
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  gt_assert(pos < wtree->members->length);
+  gt_assert(symbol < (GtWtreeSymbol) wm->alpha_size);
+
+  for (level = 0; level < wm->levels && start < end; level++)
+    gt_wtree_matrix_encseq_descend(wm, level, symbol, &start, &end);
+  return end - start;
+}
+
+/* The queries of a batch walk down the levels together. Before the ranks of
+   one level are computed, the blocks of all queries are prefetched, so the
+   cache misses of different queries overlap instead of adding up. */
+static void gt_wtree_matrix_encseq_rank_batch(GtWtree *wtree,
+                                              const GtUword *positions,
+                                              const GtWtreeSymbol *symbols,
+                                              GtUword *ranks,
+                                              GtUword num)
+{
+  GtWtreeMatrixEncseq *wm;
+  GtUword starts[GT_WTREE_MATRIX_BATCHSIZE],
+          ends[GT_WTREE_MATRIX_BATCHSIZE],
+          offset, idx, batchsize;
+  unsigned int level;
+  gt_assert(wtree != NULL);
+
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  for (offset = 0; offset < num; offset += batchsize) {
+    batchsize = MIN(GT_WTREE_MATRIX_BATCHSIZE, num - offset);
+    for (idx = 0; idx < batchsize; idx++) {
+      gt_assert(positions[offset + idx] < wtree->members->length);
+      gt_assert(symbols[offset + idx] < (GtWtreeSymbol) wm->alpha_size);
+      starts[idx] = 0;
+      ends[idx] = positions[offset + idx] + 1;
+    }
+    for (level = 0; level < wm->levels; level++) {
+      for (idx = 0; idx < batchsize; idx++) {
+        gt_rank9_bitsequence_prefetch(wm->levelbits[level], starts[idx]);
+        gt_rank9_bitsequence_prefetch(wm->levelbits[level], ends[idx]);
+      }
+      for (idx = 0; idx < batchsize; idx++) {
+        if (starts[idx] < ends[idx])
+          gt_wtree_matrix_encseq_descend(wm, level, symbols[offset + idx],
+                                         starts + idx, ends + idx);
+      }
+    }
+    for (idx = 0; idx < batchsize; idx++)
+      ranks[offset + idx] = ends[idx] - starts[idx];
+  }
+}
+
+static GtUword gt_wtree_matrix_encseq_select(GtWtree *wtree,
+                                             GtUword i,
+                                             GtWtreeSymbol symbol)
+{
+  GtWtreeMatrixEncseq *wm;
+  GtUword start = 0,
+          end,
+          pos;
+  unsigned int level;
+  gt_assert(wtree != NULL);
+
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  gt_assert(i <= wtree->members->length);
+  gt_assert(i != 0);
+  gt_assert(symbol < (GtWtreeSymbol) wm->alpha_size);
+
+  /* find the interval of <symbol> in the last level */
+  end = wtree->members->length;
+  for (level = 0; level < wm->levels; level++)
+    gt_wtree_matrix_encseq_descend(wm, level, symbol, &start, &end);
+  if (end - start < i)
+    return ULONG_MAX;
+
+  /* and follow its <i>th element up to the first level */
+  pos = start + i - 1;
+  for (level = wm->levels; level > 0; level--) {
+    if (GT_WTREE_MATRIX_BIT(wm, symbol, level - 1) == 1)
+      pos = gt_rank9_bitsequence_select_1(wm->levelbits[level - 1],
+                                          pos - wm->zeros[level - 1] + 1);
+    else
+      pos = gt_rank9_bitsequence_select_0(wm->levelbits[level - 1], pos + 1);
+  }
+  return pos;
+}
+
+static void gt_wtree_matrix_encseq_delete(GtWtree *wtree)
+{
+  if (wtree != NULL) {
+    unsigned int level;
+    GtWtreeMatrixEncseq *wm = gt_wtree_matrix_encseq_cast(wtree);
+    for (level = 0; level < wm->levels; level++)
+      gt_rank9_bitsequence_delete(wm->levelbits[level]);
+    gt_free(wm->levelbits);
+    gt_free(wm->zeros);
+    gt_alphabet_delete(wm->alpha);
+  }
+}
+
+static inline GtWtreeSymbol gt_wtree_matrix_encseq_map(GtWtreeMatrixEncseq *wm,
+                                                       GtUchar symbol)
+{
+  if (ISNOTSPECIAL(symbol))
+    return (GtWtreeSymbol) symbol;
+  else {
+    if (symbol == (GtUchar) SEPARATOR) {
+      return (GtWtreeSymbol) wm->alpha_size - 1;
+    }
+    if (symbol == (GtUchar) WILDCARD)
+      return (GtWtreeSymbol) wm->alpha_size - 2;
+  }
+  gt_assert(symbol == (GtUchar) UNDEFCHAR);
+  return (GtWtreeSymbol) wm->alpha_size - 3;
+}
+
+char gt_wtree_matrix_encseq_unmap_decoded(GtWtree *wtree,
+                                          GtWtreeSymbol symbol)
+{
+  GtWtreeMatrixEncseq *wm;
+  GtUchar encseq_sym = (GtUchar) symbol;
+  gt_assert(wtree != NULL);
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  switch (wm->alpha_size - encseq_sym) {
+    case 1:
+      return (char) SEPARATOR;
+    case 2:
+      return gt_alphabet_decode(wm->alpha, (GtUchar) WILDCARD);
+    case 3:
+      return (char) UNDEFCHAR;
+    default:
+      return gt_alphabet_decode(wm->alpha, encseq_sym);
+  }
+}
+
+/* map static local methods to interface */
+const GtWtreeClass* gt_wtree_matrix_encseq_class(void)
+{
+  static const GtWtreeClass *this_c = NULL;
+  if (this_c == NULL) {
+    this_c =
+      gt_wtree_class_new(sizeof (GtWtreeMatrixEncseq),
+                         gt_wtree_matrix_encseq_access,
+                         gt_wtree_matrix_encseq_rank,
+                         gt_wtree_matrix_encseq_rank_batch,
+                         gt_wtree_matrix_encseq_select,
+                         gt_wtree_matrix_encseq_delete);
+  }
+  return this_c;
+}
+
+/* Each level stores the bits of the symbols in the order given by a stable
+   partition of the previous level by its bit, all symbols with bit 0 first. */
+static void gt_wtree_matrix_encseq_fill_levels(GtWtreeMatrixEncseq *wm,
+                                               GtEncseq *encseq)
+{
+  GtUword idx, zero_idx, one_idx,
+          length = wm->parent_instance.members->length;
+  GtUchar *current, *next, *tmp;
+  GtBitsequence *bits;
+  GtEncseqReader *er;
+  unsigned int level;
+
+  current = gt_malloc(sizeof (*current) * length);
+  next = gt_malloc(sizeof (*next) * length);
+  er = gt_encseq_create_reader_with_readmode(encseq, GT_READMODE_FORWARD, 0);
+  for (idx = 0; idx < length; idx++)
+    current[idx] =
+      (GtUchar) gt_wtree_matrix_encseq_map(wm,
+                                  gt_encseq_reader_next_encoded_char(er));
+  gt_encseq_reader_delete(er);
+
+  GT_INITBITTAB(bits, length);
+  for (level = 0; level < wm->levels; level++) {
+    GT_CLEARBITTAB(bits, length);
+    wm->zeros[level] = 0;
+    for (idx = 0; idx < length; idx++) {
+      if (GT_WTREE_MATRIX_BIT(wm, current[idx], level) == 1)
+        GT_SETIBIT(bits, idx);
+      else
+        wm->zeros[level]++;
+    }
+    wm->levelbits[level] = gt_rank9_bitsequence_new(bits, length);
+    zero_idx = 0;
+    one_idx = wm->zeros[level];
+    for (idx = 0; idx < length; idx++) {
+      if (GT_WTREE_MATRIX_BIT(wm, current[idx], level) == 1)
+        next[one_idx++] = current[idx];
+      else
+        next[zero_idx++] = current[idx];
+    }
+    tmp = current;
+    current = next;
+    next = tmp;
+  }
+  gt_free(bits);
+  gt_free(current);
+  gt_free(next);
+}
+
+GtWtree* gt_wtree_matrix_encseq_new(GtEncseq *encseq)
+{
+  GtWtree *wtree;
+  GtWtreeMatrixEncseq *wm;
+  wtree = gt_wtree_create(gt_wtree_matrix_encseq_class());
+  wm = gt_wtree_matrix_encseq_cast(wtree);
+  wm->alpha = gt_alphabet_ref(gt_encseq_alphabet(encseq));
+  /* encoded chars + WC given by gt_alphabet_size,
+     we have to encode UNDEFCHAR and SEPARATOR too */
+  wm->alpha_size = gt_alphabet_size(wm->alpha) + 2;
+  gt_assert(wm->alpha_size <= (unsigned int) UCHAR_MAX + 1);
+  wtree->members->num_of_symbols = (GtUword) wm->alpha_size;
+  /* levels in matrix: \lceil log_2(\sigma)\rceil */
+  wm->levels = gt_determinebitspervalue((GtUword) wm->alpha_size);
+  wtree->members->length = gt_encseq_total_length(encseq);
+  wm->levelbits = gt_calloc((size_t) wm->levels, sizeof (*wm->levelbits));
+  wm->zeros = gt_calloc((size_t) wm->levels, sizeof (*wm->zeros));
+  gt_wtree_matrix_encseq_fill_levels(wm, encseq);
+  return wtree;
+}
+
+int gt_wtree_matrix_encseq_unit_test(GtError *err)
+{
+  int had_err = 0;
+  const char *seqs[] = {"ACGTTGCANNACGTACGTACGTTTTTTTTTTGGGA",
+                        "CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC",
+                        "A",
+                        "NNNNACGTNTACGATCGATCGATCGATGCATCGACTGACTGACTAGCTA"};
+  GtAlphabet *alpha = gt_alphabet_new_dna();
+  GtEncseqBuilder *eb = gt_encseq_builder_new(alpha);
+  GtEncseq *encseq;
+  GtWtree *wt, *wm;
+  GtUword idx, length, syms, *positions, *ranks;
+  GtWtreeSymbol sym, *symbols;
+  size_t i;
+  gt_error_check(err);
+
+  for (i = 0; i < sizeof (seqs) / sizeof (seqs[0]); i++)
+    gt_encseq_builder_add_cstr(eb, seqs[i], (GtUword) strlen(seqs[i]), NULL);
+  encseq = gt_encseq_builder_build(eb, err);
+  gt_ensure(encseq != NULL);
+  if (!had_err) {
+    wt = gt_wtree_encseq_new(encseq);
+    wm = gt_wtree_matrix_encseq_new(encseq);
+    length = gt_wtree_length(wm);
+    syms = gt_wtree_num_of_symbols(wm);
+    gt_ensure(length == gt_wtree_length(wt));
+    gt_ensure(syms == gt_wtree_num_of_symbols(wt));
+    positions = gt_malloc(sizeof (*positions) * length * syms);
+    symbols = gt_malloc(sizeof (*symbols) * length * syms);
+    ranks = gt_malloc(sizeof (*ranks) * length * syms);
+    /* the matrix and the tree have to agree on all queries */
+    for (idx = 0; !had_err && idx < length; idx++) {
+      sym = gt_wtree_access(wm, idx);
+      gt_ensure(sym == gt_wtree_access(wt, idx));
+      gt_ensure(gt_wtree_matrix_encseq_unmap_decoded(wm, sym) ==
+                gt_wtree_encseq_unmap_decoded(wt, sym));
+      for (sym = 0; !had_err && sym < (GtWtreeSymbol) syms; sym++) {
+        gt_ensure(gt_wtree_rank(wm, idx, sym) == gt_wtree_rank(wt, idx, sym));
+        positions[idx * syms + sym] = idx;
+        symbols[idx * syms + sym] = sym;
+      }
+    }
+    for (sym = 0; !had_err && sym < (GtWtreeSymbol) syms; sym++) {
+      for (idx = 1; !had_err && idx <= length; idx++)
+        gt_ensure(gt_wtree_select(wm, idx, sym) ==
+                  gt_wtree_select(wt, idx, sym));
+    }
+    if (!had_err) {
+      gt_wtree_rank_batch(wm, positions, symbols, ranks, length * syms);
+      for (idx = 0; !had_err && idx < length * syms; idx++)
+        gt_ensure(ranks[idx] == gt_wtree_rank(wm, positions[idx],
+                                              symbols[idx]));
+    }
+    gt_free(positions);
+    gt_free(symbols);
+    gt_free(ranks);
+    gt_wtree_delete(wt);
+    gt_wtree_delete(wm);
+  }
+  gt_encseq_delete(encseq);
+  gt_encseq_builder_delete(eb);
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
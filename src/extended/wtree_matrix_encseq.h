@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef WTREE_MATRIX_ENCSEQ_H
+#define WTREE_MATRIX_ENCSEQ_H
+
+#include "core/encseq_api.h"
+#include "core/error_api.h"
+#include "extended/wtree.h"
+
+/* The <GtWtreeMatrixEncseq> class implements the <GtWtree> interface as a
+   wavelet matrix (Claude, Navarro and Ordonez, 2012) over the sequence part of
+   an encoded sequence. It stores one uncompressed <GtRank9Bitsequence> per
+   level instead of a pointer-free tree in a <GtCompressedBitsequence>, so
+   access, rank and select need one rank or select per level, each touching a
+   single cache line. Symbols are mapped like in a <GtWtreeEncseq>. */
+typedef struct GtWtreeMatrixEncseq GtWtreeMatrixEncseq;
+
+/* Return a new <GtWtree> object, representing an <encseq>. */
+GtWtree* gt_wtree_matrix_encseq_new(GtEncseq *encseq);
+
+/* Maps <symbol> to a decoded character symbol as defined by the original
+   alphabet <wtree> was built with. */
+char     gt_wtree_matrix_encseq_unmap_decoded(GtWtree *wtree,
+                                              GtWtreeSymbol symbol);
+
+int      gt_wtree_matrix_encseq_unit_test(GtError *err);
+
+#endif
@@ -27,6 +27,8 @@ typedef struct GtWtreeMembers GtWtreeMembers;
 typedef GtWtreeSymbol (*GtWtreeAccessFunc)(GtWtree*, GtUword);
 typedef GtUword (*GtWtreeRankFunc)(GtWtree*, GtUword,
                                          GtWtreeSymbol);
+typedef void (*GtWtreeRankBatchFunc)(GtWtree*, const GtUword*,
+                                     const GtWtreeSymbol*, GtUword*, GtUword);
 typedef GtUword (*GtWtreeSelectFunc)(GtWtree*, GtUword,
                                           GtWtreeSymbol);
 typedef void (*GtWtreeDeleteFunc)(GtWtree*);
@@ -40,6 +42,7 @@ struct GtWtreeClass {
   GtWtreeAccessFunc access_func;
   GtWtreeDeleteFunc delete_func;
   GtWtreeRankFunc   rank_func;
+  GtWtreeRankBatchFunc rank_batch_func;
   GtWtreeSelectFunc select_func;
   size_t            size;
 };
@@ -53,6 +56,7 @@ struct GtWtreeMembers {
 const GtWtreeClass* gt_wtree_class_new(size_t size,
                                        GtWtreeAccessFunc,
                                        GtWtreeRankFunc,
+                                       GtWtreeRankBatchFunc,
                                        GtWtreeSelectFunc,
                                        GtWtreeDeleteFunc);
 
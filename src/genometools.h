@@ -106,6 +106,7 @@ extern "C" {
 #include "extended/eof_node_api.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_in_stream_api.h"
 #include "extended/feature_node_api.h"
@@ -174,10 +175,12 @@ extern "C" {
 #include "annotationsketch/graphics_api.h"
 #include "annotationsketch/image_info_api.h"
 #include "annotationsketch/layout_api.h"
+#include "annotationsketch/layout_context_api.h"
 #include "annotationsketch/rec_map_api.h"
 #include "annotationsketch/style_api.h"
 #include "annotationsketch/text_width_calculator_api.h"
 #include "annotationsketch/text_width_calculator_cairo_api.h"
+#include "annotationsketch/tile_cache_api.h"
 #endif
 
 #ifdef __cplusplus
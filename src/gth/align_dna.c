@@ -16,7 +16,11 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -46,53 +50,268 @@ static const char* dna_showretracenames(DnaRetrace retrace)
   return dna_retracenames[retrace];
 }
 
-/* the following function allocates space for the DP tables for cDNAs/ESTs */
+/*
+  Checkpointing of the backtrace table:
+
+  If the complete backtrace table does not fit into memory, it is divided into
+  segments of <segment_rows> consecutive rows (i.e., twice as many genomic
+  positions) and only the rows of one segment are kept. While the DP tables
+  are computed, the DP state (scores, intron and exon starts) of the last
+  genomic position of every segment is stored as a checkpoint. During the
+  backtracing, the rows of the segments are recomputed from these checkpoints
+  in reverse order. This doubles the computation time but reduces the space
+  requirement from O(nm) to O(sqrt(n)m), without changing the result.
+*/
+
+/* size of the DP state of a single cell stored in a checkpoint */
+#define DNA_CHECKPOINT_CELL_SIZE \
+        (DNA_NUMOFSTATES * sizeof (GthFlt) + 2 * sizeof (GtUword))
+
+struct GthDPCheckpoints {
+  GthPath *segment;               /* rows of the current segment */
+  GtUword path_rows,              /* number of rows of the complete table */
+          segment_rows,           /* number of rows per segment */
+          num_of_segments,
+          current_segment;
+  GthFlt *score[DNA_NUMOFSTATES]; /* DP state at the end of every segment
+                                     except the last one */
+  GtUword *intronstart,
+          *exonstart;
+  /* the arguments of the DP, necessary for the recomputation of segments */
+  const unsigned char *gen_seq_tran,
+                      *ref_seq_tran;
+  GtAlphabet *gen_alphabet;
+  GthDPParam *dp_param;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsCore *dp_options_core;
+  GthDbl **outputweights;
+};
+
+/* the number of rows per segment which minimizes the space requirement */
+static GtUword dp_checkpoints_segment_rows(GtUword path_rows)
+{
+  GtUword segment_rows;
+  segment_rows = (GtUword) ceil(sqrt((double) path_rows *
+                                     DNA_CHECKPOINT_CELL_SIZE));
+  if (segment_rows > path_rows)
+    segment_rows = path_rows;
+  return segment_rows ? segment_rows : 1;
+}
+
+static GtUword dp_checkpoints_size(GtUword path_rows, GtUword segment_rows,
+                                   GtUword ref_dp_length)
+{
+  GtUword num_of_segments = (path_rows + segment_rows - 1) / segment_rows;
+  return (segment_rows * sizeof (GthPath) +
+          (num_of_segments - 1) * DNA_CHECKPOINT_CELL_SIZE) *
+         (ref_dp_length + 1);
+}
+
+static GthDPCheckpoints* dp_checkpoints_new(GtUword path_rows,
+                                            GtUword segment_rows,
+                                            GtUword ref_dp_length)
+{
+  GthDPCheckpoints *cp = gt_calloc(1, sizeof *cp);
+  GtUword t, num_of_checkpoints;
+  cp->path_rows = path_rows;
+  cp->segment_rows = segment_rows;
+  cp->num_of_segments = (path_rows + segment_rows - 1) / segment_rows;
+  cp->current_segment = GT_UNDEF_UWORD;
+  cp->segment = gt_malloc(sizeof *cp->segment * segment_rows *
+                          (ref_dp_length + 1));
+  num_of_checkpoints = cp->num_of_segments - 1;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    cp->score[t] = gt_malloc(sizeof (GthFlt) * num_of_checkpoints *
+                             (ref_dp_length + 1));
+  }
+  cp->intronstart = gt_malloc(sizeof (GtUword) * num_of_checkpoints *
+                              (ref_dp_length + 1));
+  cp->exonstart = gt_malloc(sizeof (GtUword) * num_of_checkpoints *
+                            (ref_dp_length + 1));
+  return cp;
+}
+
+static void dp_checkpoints_delete(GthDPCheckpoints *cp)
+{
+  GtUword t;
+  if (!cp) return;
+  gt_free(cp->segment);
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++)
+    gt_free(cp->score[t]);
+  gt_free(cp->intronstart);
+  gt_free(cp->exonstart);
+  if (cp->outputweights)
+    gt_array2dim_delete(cp->outputweights);
+  gt_free(cp);
+}
+
+/* let the rows of <segment> in <dpm->path> point to the segment storage */
+static void dp_checkpoints_map_segment(GthDPMatrix *dpm, GtUword segment)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword r, start, end;
+  gt_assert(segment < cp->num_of_segments);
+  if (cp->current_segment != GT_UNDEF_UWORD) {
+    start = cp->current_segment * cp->segment_rows;
+    end = MIN(start + cp->segment_rows, cp->path_rows);
+    for (r = start; r < end; r++)
+      dpm->path[r] = NULL;
+  }
+  start = segment * cp->segment_rows;
+  end = MIN(start + cp->segment_rows, cp->path_rows);
+  for (r = start; r < end; r++)
+    dpm->path[r] = cp->segment + (r - start) * (dpm->ref_dp_length + 1);
+  cp->current_segment = segment;
+}
+
+/* the range of genomic positions (rows of the score tables) of <segment> */
+static void dp_checkpoints_segment_range(const GthDPMatrix *dpm,
+                                         GtUword segment, GtUword *from,
+                                         GtUword *to)
+{
+  GtUword segment_rows = dpm->checkpoints->segment_rows;
+  *from = segment ? GT_MULT2(segment * segment_rows) : 1;
+  *to = MIN(GT_MULT2((segment + 1) * segment_rows) - 1, dpm->gen_dp_length);
+}
+
+/* store the DP state of genomic position <n> as checkpoint <checkpoint> */
+static void dp_checkpoints_save(GthDPMatrix *dpm, GtUword checkpoint,
+                                GtUword n)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword t, columns = dpm->ref_dp_length + 1;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    memcpy(cp->score[t] + checkpoint * columns, dpm->score[t][GT_MOD2(n)],
+           sizeof (GthFlt) * columns);
+  }
+  memcpy(cp->intronstart + checkpoint * columns, dpm->intronstart[GT_MOD2(n)],
+         sizeof (GtUword) * columns);
+  memcpy(cp->exonstart + checkpoint * columns, dpm->exonstart[GT_MOD2(n)],
+         sizeof (GtUword) * columns);
+}
+
+/* restore the DP state of genomic position <n> from checkpoint <checkpoint> */
+static void dp_checkpoints_restore(GthDPMatrix *dpm, GtUword checkpoint,
+                                   GtUword n)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword t, columns = dpm->ref_dp_length + 1;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    memcpy(dpm->score[t][GT_MOD2(n)], cp->score[t] + checkpoint * columns,
+           sizeof (GthFlt) * columns);
+  }
+  memcpy(dpm->intronstart[GT_MOD2(n)], cp->intronstart + checkpoint * columns,
+         sizeof (GtUword) * columns);
+  memcpy(dpm->exonstart[GT_MOD2(n)], cp->exonstart + checkpoint * columns,
+         sizeof (GtUword) * columns);
+}
+
+/* the following function initializes the DP tables for genomic position 0 */
+static void dp_matrix_init_first_row(GthDPMatrix *dpm)
+{
+  GtUword n, m;
+
+  dpm->path[0][0]  = DNA_E_NM;
+  dpm->path[0][0] |= I_STATE_E_N;
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->path[0][m]  = DNA_E_M;
+    dpm->path[0][m] |= I_STATE_I_N;
+  }
+
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    dpm->score[DNA_E_STATE][n][0] = 0.0;
+    dpm->score[DNA_I_STATE][n][0] = 0.0;
+
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
+      /* disallow intron status for 5' non-matching cDNA letters: */
+      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
+    }
+
+    for (m = 0; m <= dpm->ref_dp_length; m++) {
+      dpm->intronstart[n][m] = 0;
+      dpm->exonstart[n][m] = 0;
+    }
+  }
+}
+
+/* the following function allocates space for the DP tables for cDNAs/ESTs,
+   if <use_checkpoints> is true, checkpointing is used instead of failing if
+   the backtrace table is too large */
 static int dp_matrix_init(GthDPMatrix *dpm,
                           GtUword gen_dp_length,
                           GtUword ref_dp_length,
                           GtUword autoicmaxmatrixsize,
                           bool introncutout,
+                          bool use_checkpoints,
                           GthJumpTable *jump_table,
                           GthStat *stat)
 {
-  GtUword t, n, m, matrixsize, sizeofpathtype =  sizeof (GthPath);
+  GtUword t, n, path_rows, segment_rows = 0, matrixsize = 0,
+          sizeofpathtype =  sizeof (GthPath);
+  bool checkpoints = false;
+
+  gt_assert(!use_checkpoints || !jump_table);
+  path_rows = GT_DIV2(gen_dp_length + 1) + GT_MOD2(gen_dp_length + 1);
+  if (use_checkpoints)
+    segment_rows = dp_checkpoints_segment_rows(path_rows);
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
   if (DNA_NUMOFSTATES * sizeofpathtype * (gen_dp_length + 1) >=
       (~0)/(ref_dp_length + 1)) {
     /* in this case the matrix would be larger than the addressable memory
        of this machine -> return ERROR_MATRIX_ALLOCATION_FAILED */
-    return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
-  }
-
-  matrixsize = gt_safe_mult_ulong((GT_DIV2(gen_dp_length + 1) +
-                                   GT_MOD2(gen_dp_length + 1)),
-                                   ref_dp_length + 1);
-
-  if (!introncutout && autoicmaxmatrixsize > 0) {
-    /* in this case the automatic intron cutout technique is enabled
-       check if allocated matrix would be larger as specified maximal
-       matrix size. If so, return matrix allocation error */
-    if (sizeofpathtype * matrixsize * DNA_NUMOFSTATES >
-        autoicmaxmatrixsize << 20) {
+    if (!use_checkpoints)
       return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
+    checkpoints = true;
+  }
+  else {
+    matrixsize = gt_safe_mult_ulong(path_rows, ref_dp_length + 1);
+
+    if (!introncutout && autoicmaxmatrixsize > 0) {
+      /* in this case the automatic intron cutout technique is enabled
+         check if allocated matrix would be larger as specified maximal
+         matrix size. If so, use checkpoints if they fit or return matrix
+         allocation error */
+      if (sizeofpathtype * matrixsize * DNA_NUMOFSTATES >
+          autoicmaxmatrixsize << 20) {
+        if (!use_checkpoints ||
+            dp_checkpoints_size(path_rows, segment_rows, ref_dp_length) >
+            autoicmaxmatrixsize << 20) {
+          return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
+        }
+        checkpoints = true;
+      }
     }
   }
 
+  dpm->gen_dp_length = gen_dp_length;
+  dpm->ref_dp_length = ref_dp_length;
+  dpm->path_jt = NULL;
+  dpm->checkpoints = NULL;
+
   /* allocate space for dpm->path */
-  if (jump_table) {
-    gth_array2dim_plain_calloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+  if (!checkpoints) {
+    if (jump_table) {
+      gth_array2dim_plain_calloc(dpm->path, path_rows, ref_dp_length + 1);
+    }
+    else {
+      gth_array2dim_plain_malloc(dpm->path, path_rows, ref_dp_length + 1);
+    }
+    if (!dpm->path) {
+      if (!use_checkpoints)
+        return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
+      checkpoints = true;
+    }
   }
-  else {
-    gth_array2dim_plain_malloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+  if (checkpoints) {
+    dpm->checkpoints = dp_checkpoints_new(path_rows, segment_rows,
+                                          ref_dp_length);
+    dpm->path = gt_calloc(path_rows, sizeof *dpm->path);
+    dp_checkpoints_map_segment(dpm, 0);
+    matrixsize = dp_checkpoints_size(path_rows, segment_rows, ref_dp_length)
+                 / sizeofpathtype;
   }
-  dpm->path_jt = NULL;
-  if (!dpm->path)
-    return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
 
   /* allocate space for dpm->score */
   for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
@@ -103,31 +322,14 @@ static int dp_matrix_init(GthDPMatrix *dpm,
 
   /* allocating space for intronstart and exonstart */
   for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->intronstart[n] = gt_calloc(ref_dp_length + 1,
-                                    sizeof *dpm->intronstart);
-    dpm->exonstart[n] = gt_calloc(ref_dp_length + 1, sizeof *dpm->exonstart);
+    dpm->intronstart[n] = gt_malloc(sizeof **dpm->intronstart *
+                                    (ref_dp_length + 1));
+    dpm->exonstart[n] = gt_malloc(sizeof **dpm->exonstart *
+                                  (ref_dp_length + 1));
   }
 
   /* initialize the DP matrices */
-  dpm->path[0][0]  = DNA_E_NM;
-  dpm->path[0][0] |= I_STATE_E_N;
-  for (m = 1; m <= ref_dp_length; m++) {
-    dpm->path[0][m]  = DNA_E_M;
-    dpm->path[0][m] |= I_STATE_I_N;
-  }
-
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->score[DNA_E_STATE][n][0] = 0.0;
-    dpm->score[DNA_I_STATE][n][0] = 0.0;
-
-    for (m = 1; m <= ref_dp_length; m++) {
-      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
-      /* disallow intron status for 5' non-matching cDNA letters: */
-      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
-    }
-  }
-  dpm->gen_dp_length = gen_dp_length;
-  dpm->ref_dp_length = ref_dp_length;
+  dp_matrix_init_first_row(dpm);
 
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
@@ -275,44 +477,44 @@ static void I_1m(GthDPMatrix *dpm, GtUword m, GthDbl log_1minusprobies)
   }
 }
 
-/* the following function evaluate the dynamic programming tables */
-static void dna_complete_path_matrix(GthDPMatrix *dpm,
-                                     const unsigned char *gen_seq_tran,
-                                     const unsigned char *ref_seq_tran,
-                                     GtUword genomic_offset,
-                                     GtAlphabet *gen_alphabet,
-                                     GthDPParam *dp_param,
-                                     GthDPOptionsEST *dp_options_est,
-                                     GthDPOptionsCore *dp_options_core)
+/* the following function evaluates the dynamic programming tables for the
+   genomic positions <from> to <to> */
+static void dna_complete_path_matrix_rows(GthDPMatrix *dpm,
+                                          const unsigned char *gen_seq_tran,
+                                          const unsigned char *ref_seq_tran,
+                                          GtUword from, GtUword to,
+                                          GthDbl **outputweights,
+                                          GtAlphabet *gen_alphabet,
+                                          GthDPParam *dp_param,
+                                          GthDPOptionsEST *dp_options_est,
+                                          GthDPOptionsCore *dp_options_core)
 {
   GthFlt value, maxvalue;
-  GthPath retrace;
-  GtUword n, m, modn, modnminus1;
-  GthDbl rval, outputweight, **outputweights,
+  GthPath retrace, *path;
+  GtUword n, m, modn, modnminus1, *intronstart, *intronstart_prev, *exonstart,
+          *exonstart_prev;
+  GthDbl rval, outputweight, *outputweights_gen, *outputweights_dash,
          log_probies,          /* initial exon state probability */
-         log_1minusprobies;    /* initial intron state probability */
+         log_1minusprobies,    /* initial intron state probability */
+         log_nodonor,          /* no deletion and no donor at n-1 */
+         log_acceptor;         /* no deletion and acceptor at n-2 */
   GthFlt log_probdelgen,       /* deletion in genomic sequence */
-         log_1minusprobdelgen;
+         log_1minusprobdelgen,
+         log_donor,            /* no deletion and donor at n-1 */
+         log_1minusacceptor,
+         *score_e, *score_e_prev, *score_i, *score_i_prev;
   unsigned char genomicchar, referencechar;
-  unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
 
   gt_assert(dpm->gen_dp_length > 1);
+  gt_assert(from && from <= to && to <= dpm->gen_dp_length);
 
   log_probies = (GthDbl) log((double) dp_options_est->probies);
   log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
   log_probdelgen = (GthFlt) log((double) dp_options_est->probdelgen);
   log_1minusprobdelgen = (GthFlt) log(1.0 - dp_options_est->probdelgen);
+  outputweights_dash = outputweights[DASH];
 
-  /* precompute outputweights
-     XXX: move this to somewhere else, maybe make it smaller */
-  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
-  for (n = 0; n <= UCHAR_MAX; n++) {
-    for (m = 0; m <= UCHAR_MAX; m++) {
-      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
-    }
-  }
-
-  if (!genomic_offset) {
+  if (from == 1) {
     /* handle case for n equals 1 */
     dpm->path[0][0] |= UPPER_E_N;
     dpm->path[0][0] |= UPPER_I_STATE_I_N;
@@ -323,27 +525,43 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
            dp_options_est, dp_options_core);
       I_1m(dpm, m, log_1minusprobies);
     }
+    from = 2;
   }
 
   /* handle all other n's
      stepping along the genomic sequence */
-  if (genomic_offset)
-    n = genomic_offset + 1;
-  else
-    n = 2;
-
-  for (; n <= dpm->gen_dp_length; n++) {
+  for (n = from; n <= to; n++) {
     modn = GT_MOD2(n);
     modnminus1 = GT_MOD2(n-1);
     genomicchar = gen_seq_tran[n-1];
 
+    /* the following values do not depend on the cDNA/EST position, the
+       table rows are fetched here because the compiler cannot know that they
+       are not changed by the stores below */
+    outputweights_gen = outputweights[genomicchar];
+    log_nodonor = (GthDbl) (log_1minusprobdelgen +
+                            dp_param->log_1minusPdonor[n-1]);
+    log_acceptor = (GthDbl) (dp_param->log_Pacceptor[n-2] +
+                             log_1minusprobdelgen);
+    log_donor = log_1minusprobdelgen + dp_param->log_Pdonor[n-1];
+    log_1minusacceptor = dp_param->log_1minusPacceptor[n-2];
+    path = dpm->path[GT_DIV2(n)];
+    score_e = dpm->score[DNA_E_STATE][modn];
+    score_e_prev = dpm->score[DNA_E_STATE][modnminus1];
+    score_i = dpm->score[DNA_I_STATE][modn];
+    score_i_prev = dpm->score[DNA_I_STATE][modnminus1];
+    intronstart = dpm->intronstart[modn];
+    intronstart_prev = dpm->intronstart[modnminus1];
+    exonstart = dpm->exonstart[modn];
+    exonstart_prev = dpm->exonstart[modnminus1];
+
     if (modn) {
-      dpm->path[GT_DIV2(n)][0] |= UPPER_E_N;
-      dpm->path[GT_DIV2(n)][0] |= UPPER_I_STATE_I_N;
+      path[0] |= UPPER_E_N;
+      path[0] |= UPPER_I_STATE_I_N;
     }
     else {
-      dpm->path[GT_DIV2(n)][0]  = DNA_E_N;
-      dpm->path[GT_DIV2(n)][0] |= I_STATE_I_N;
+      path[0]  = DNA_E_N;
+      path[0] |= I_STATE_I_N;
     }
 
     /* stepping along the cDNA/EST sequence */
@@ -354,54 +572,50 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
 
       /* 0. */
       outputweight = 0.0;
-      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      rval += outputweights[genomicchar][referencechar];
+      rval = log_nodonor;
+      rval += outputweights_gen[referencechar];
       if ((m < dp_options_est->wdecreasedoutput ||
            m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
            genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+        outputweight += outputweights_gen[referencechar];
         rval -= (outputweight / 2.0);
       }
-      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
+      maxvalue = (GthFlt) (score_e_prev[m-1] + rval);
       retrace  = DNA_E_NM;
 
       /* 1. */
       outputweight = 0.0;
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      rval += outputweights[genomicchar][referencechar];
+      rval = log_acceptor;
+      rval += outputweights_gen[referencechar];
       if ((m < dp_options_est->wdecreasedoutput ||
            m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
            genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+        outputweight += outputweights_gen[referencechar];
         rval -= (outputweight / 2.0);
       }
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
+      value = (GthFlt) (score_i_prev[m-1] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m - 1] <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart_prev[m - 1] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_NM);
 
       /* 2. */
       rval = 0.0;
       if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
-        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
+        rval += log_nodonor;
       if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
+        rval += outputweights_gen[DASH];
+      value = (GthFlt) (score_e_prev[m] + rval);
       UPDATEMAX(DNA_E_N);
 
       /* 3. */
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
+      rval = log_acceptor;
       if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
+        rval += outputweights_gen[DASH];
+      value = (GthFlt) (score_i_prev[m] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m] <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart_prev[m] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_N);
 
       /* 4. */
@@ -409,8 +623,8 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
         rval = (GthDbl) log_probdelgen;
       if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
+        rval += outputweights_dash[referencechar];
+      value = (GthFlt) (score_e[m-1] + rval);
       UPDATEMAX(DNA_E_M);
 
       /* 5. */
@@ -418,36 +632,34 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       if (n < dpm->gen_dp_length)
        rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
       if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
+        rval += outputweights_dash[referencechar];
+      value = (GthFlt) (score_i[m-1] + rval);
       /* intron from intronstart to n => n - intronstart + 1 */
-      if (n - dpm->intronstart[modn][m - 1] + 1 <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart[m - 1] + 1 < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_M);
 
       /* save maximum values */
-      dpm->score[DNA_E_STATE][modn][m] = maxvalue;
+      score_e[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        path[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m]  = retrace;
+        path[m]  = retrace;
 
       switch (retrace) {
         case DNA_I_NM:
         case DNA_I_N:
         case DNA_I_M:
-          dpm->exonstart[modn][m] = n;
+          exonstart[m] = n;
           break;
         case DNA_E_NM:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m - 1];
+          exonstart[m] = exonstart_prev[m - 1];
           break;
         case DNA_E_N:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+          exonstart[m] = exonstart_prev[m];
           break;
         case DNA_E_M:
-          dpm->exonstart[modn][m] = dpm->exonstart[modn][m - 1];
+          exonstart[m] = exonstart[m - 1];
           break;
         default: gt_assert(0);
       }
@@ -455,45 +667,121 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       /* evaluate I_nm */
 
       /* 0. */
-      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
-                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
-      if (n - dpm->exonstart[modnminus1][m]
-          < dp_options_core->dpminexonlength) {
+      maxvalue = score_e_prev[m] + log_donor;
+      if (n - exonstart_prev[m] < dp_options_core->dpminexonlength)
          maxvalue -= dp_options_core->shortexonpenalty;
-      }
       retrace  = I_STATE_E_N;
 
       /* 1. */
-      value = dpm->score[DNA_I_STATE][modnminus1][m];
+      value = score_i_prev[m];
       if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
-        value += dp_param->log_1minusPacceptor[n-2];
+        value += log_1minusacceptor;
       UPDATEMAX(I_STATE_I_N);
 
       /* save maximum values */
-      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
+      score_i[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        path[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m] |= retrace;
+        path[m] |= retrace;
 
       switch (retrace) {
        case I_STATE_E_N:
           /* begin of a new intron */
-          dpm->intronstart[modn][m] = n;
+          intronstart[m] = n;
           break;
         case I_STATE_I_N:
           /* continue existing intron */
-          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
+          intronstart[m] = intronstart_prev[m];
           break;
         default: gt_assert(0);
       }
     }
   }
+}
+
+/* the following function evaluate the dynamic programming tables */
+static void dna_complete_path_matrix(GthDPMatrix *dpm,
+                                     const unsigned char *gen_seq_tran,
+                                     const unsigned char *ref_seq_tran,
+                                     GtUword genomic_offset,
+                                     GtAlphabet *gen_alphabet,
+                                     GthDPParam *dp_param,
+                                     GthDPOptionsEST *dp_options_est,
+                                     GthDPOptionsCore *dp_options_core)
+{
+  GtUword n, m, from, to;
+  GthDbl **outputweights;
+  unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
+
+  gt_assert(dpm->gen_dp_length > 1);
+
+  /* precompute outputweights
+     XXX: move this to somewhere else, maybe make it smaller */
+  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
+  for (n = 0; n <= UCHAR_MAX; n++) {
+    for (m = 0; m <= UCHAR_MAX; m++) {
+      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
+    }
+  }
+
+  if (dpm->checkpoints) {
+    GthDPCheckpoints *cp = dpm->checkpoints;
+    gt_assert(!genomic_offset && cp->current_segment == 0);
+    /* keep the arguments for the recomputation during the backtracing */
+    cp->gen_seq_tran = gen_seq_tran;
+    cp->ref_seq_tran = ref_seq_tran;
+    cp->gen_alphabet = gen_alphabet;
+    cp->dp_param = dp_param;
+    cp->dp_options_est = dp_options_est;
+    cp->dp_options_core = dp_options_core;
+    cp->outputweights = outputweights;
+    for (n = 0; n < cp->num_of_segments; n++) {
+      if (n)
+        dp_checkpoints_map_segment(dpm, n);
+      dp_checkpoints_segment_range(dpm, n, &from, &to);
+      dna_complete_path_matrix_rows(dpm, gen_seq_tran, ref_seq_tran, from, to,
+                                    outputweights, gen_alphabet, dp_param,
+                                    dp_options_est, dp_options_core);
+      if (n + 1 < cp->num_of_segments)
+        dp_checkpoints_save(dpm, n, to);
+    }
+    return;
+  }
+
+  from = genomic_offset ? genomic_offset + 1 : 1;
+  if (from <= dpm->gen_dp_length) {
+    dna_complete_path_matrix_rows(dpm, gen_seq_tran, ref_seq_tran, from,
+                                  dpm->gen_dp_length, outputweights,
+                                  gen_alphabet, dp_param, dp_options_est,
+                                  dp_options_core);
+  }
 
   /* free space  */
   gt_array2dim_delete(outputweights);
 }
 
+/* the following function makes sure that row <r> of the backtrace table is
+   available, by recomputing its segment from the preceding checkpoint */
+static void dp_checkpoints_provide_row(GthDPMatrix *dpm, GtUword r)
+{
+  GthDPCheckpoints *cp = dpm->checkpoints;
+  GtUword segment = r / cp->segment_rows, from, to;
+
+  if (segment == cp->current_segment)
+    return;
+  dp_checkpoints_map_segment(dpm, segment);
+  dp_checkpoints_segment_range(dpm, segment, &from, &to);
+  if (segment)
+    dp_checkpoints_restore(dpm, segment - 1, from - 1);
+  else
+    dp_matrix_init_first_row(dpm);
+  dna_complete_path_matrix_rows(dpm, cp->gen_seq_tran, cp->ref_seq_tran, from,
+                                to, cp->outputweights, cp->gen_alphabet,
+                                cp->dp_param, cp->dp_options_est,
+                                cp->dp_options_core);
+}
+
 static void dna_include_exon(GthBacktracePath *backtrace_path,
                              GtUword exonlength)
 {
@@ -539,6 +827,8 @@ static int dna_evaltracepath(GthBacktracePath *backtrace_path, GthDPMatrix *dpm,
   gt_assert(!gth_backtrace_path_length(backtrace_path));
 
   while ((genptr > 0) || (refptr > 0)) {
+    if (dpm->checkpoints)
+      dp_checkpoints_provide_row(dpm, GT_DIV2(genptr));
     /* here we map the quarter matrix bitvector stuff back on the simple Retrace
        types.  Thereby, no further changes on the backtracing procedure are
        necessary. */
@@ -761,7 +1051,13 @@ static void dp_matrix_free(GthDPMatrix *dpm)
   }
 
   /* freeing space for dpm->path */
-  gth_array2dim_plain_delete(dpm->path);
+  if (dpm->checkpoints) {
+    dp_checkpoints_delete(dpm->checkpoints);
+    gt_free(dpm->path);
+  }
+  else {
+    gth_array2dim_plain_delete(dpm->path);
+  }
   if (dpm->path_jt)
     gt_array2dim_delete(dpm->path_jt);
 }
@@ -997,7 +1293,7 @@ static void detect_small_terminal_exons(GthSA *sa,
   }
 
   if (dp_matrix_init(&dpm_terminal, gen_dp_length_terminal,
-                     ref_dp_length_terminal, 0, false, NULL, stat)) {
+                     ref_dp_length_terminal, 0, false, false, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1135,7 +1431,7 @@ static void detect_small_initial_exons(GthSA *sa,
             gen_seq_bounds->end);
 
   if (dp_matrix_init(&dpm_initial, gen_dp_length_initial,
-                     ref_dp_length_initial, 0, false, NULL, stat)) {
+                     ref_dp_length_initial, 0, false, false, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1273,7 +1569,9 @@ int gth_align_dna(GthSA *sa,
                              introncutout ? spliced_seq->splicedseqlen
                                           : gen_dp_length,
                              ref_dp_length, autoicmaxmatrixsize, introncutout,
-                             jump_table, stat))) {
+                             dp_options_core->dpcheckpoints && !jump_table &&
+                             dp_options_core->btmatrixgenrange.start ==
+                             GT_UNDEF_UWORD, jump_table, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     return rval;
@@ -1454,3 +1752,121 @@ GthSA* gth_align_dna_simple(GthInput *input,
   gth_dp_options_core_delete(dp_options_core);
   return sa;
 }
+
+#define ALIGN_DNA_TEST_GEN_LENGTH 3000
+
+/* aligns an artificial cDNA with two introns to its genomic sequence, once
+   with the complete backtrace matrix and once with a matrix size limit which
+   is only met by the checkpoints; both spliced alignments must be equal */
+int gth_align_dna_unit_test(GtError *err)
+{
+  static const GtRange exons[] = { { 100, 499 }, { 900, 1299 },
+                                   { 2000, 2399 } };
+  static const char acgt[] = "acgt";
+  unsigned char gen_seq_orig[ALIGN_DNA_TEST_GEN_LENGTH],
+                gen_seq_tran[ALIGN_DNA_TEST_GEN_LENGTH],
+                ref_seq_orig[ALIGN_DNA_TEST_GEN_LENGTH],
+                ref_seq_tran[ALIGN_DNA_TEST_GEN_LENGTH];
+  GtUword i, e, ref_length = 0;
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsPostpro *dp_options_postpro;
+  GthSpliceSiteModel *splice_site_model;
+  GtAlphabet *alphabet;
+  GtArray *gen_ranges;
+  GtRange gen_seq_bounds;
+  GthSA *sa_full, *sa_checkpoints, *sa_failed;
+  GthStat *stat;
+  int rval, had_err = 0;
+
+  gt_error_check(err);
+
+  /* genomic sequence with canonical splice sites between the exons */
+  for (i = 0; i < ALIGN_DNA_TEST_GEN_LENGTH; i++)
+    gen_seq_orig[i] = (unsigned char) acgt[gt_rand_max(3)];
+  for (e = 1; e < sizeof exons / sizeof exons[0]; e++) {
+    memcpy(gen_seq_orig + exons[e-1].end + 1, "gt", 2);
+    memcpy(gen_seq_orig + exons[e].start - 2, "ag", 2);
+  }
+  /* cDNA consisting of the exons with some mismatches */
+  for (e = 0; e < sizeof exons / sizeof exons[0]; e++) {
+    for (i = exons[e].start; i <= exons[e].end; i++) {
+      ref_seq_orig[ref_length++] = gt_rand_max(99) ? gen_seq_orig[i]
+                                                   : (unsigned char) 'a';
+    }
+  }
+
+  alphabet = gt_alphabet_new_dna();
+  gt_alphabet_encode_seq(alphabet, gen_seq_tran, (char*) gen_seq_orig,
+                         ALIGN_DNA_TEST_GEN_LENGTH);
+  gt_alphabet_encode_seq(alphabet, ref_seq_tran, (char*) ref_seq_orig,
+                         ref_length);
+  gen_seq_bounds.start = 0;
+  gen_seq_bounds.end = ALIGN_DNA_TEST_GEN_LENGTH - 1;
+  gen_ranges = gt_array_new(sizeof (GtRange));
+  gt_array_add(gen_ranges, gen_seq_bounds);
+  splice_site_model = gth_splice_site_model_new();
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_est = gth_dp_options_est_new();
+  dp_options_postpro = gth_dp_options_postpro_new();
+  stat = gth_stat_new();
+  sa_full = gth_sa_new();
+  sa_checkpoints = gth_sa_new();
+  sa_failed = gth_sa_new();
+  gth_sa_set_gen_total_length(sa_full, ALIGN_DNA_TEST_GEN_LENGTH);
+  gth_sa_set_gen_total_length(sa_checkpoints, ALIGN_DNA_TEST_GEN_LENGTH);
+  gth_sa_set_gen_total_length(sa_failed, ALIGN_DNA_TEST_GEN_LENGTH);
+  gth_sa_set_ref_total_length(sa_full, ref_length);
+  gth_sa_set_ref_total_length(sa_checkpoints, ref_length);
+  gth_sa_set_ref_total_length(sa_failed, ref_length);
+
+  /* the complete backtrace matrix (no size limit) */
+  dp_options_core->dpcheckpoints = true;
+  rval = gth_align_dna(sa_full, gen_ranges, gen_seq_tran, gen_seq_orig,
+                       ref_seq_tran, ref_seq_orig, ref_length, alphabet,
+                       alphabet, false, 0, false, false, false,
+                       &gen_seq_bounds, splice_site_model, dp_options_core,
+                       dp_options_est, dp_options_postpro, NULL, NULL, 0, stat,
+                       NULL);
+  gt_ensure(!rval);
+  gt_ensure(gth_sa_num_of_introns(sa_full) == 2);
+
+  /* the complete matrix exceeds 1 MB, hence it cannot be allocated without
+     checkpoints */
+  if (!had_err) {
+    dp_options_core->dpcheckpoints = false;
+    rval = gth_align_dna(sa_failed, gen_ranges, gen_seq_tran, gen_seq_orig,
+                         ref_seq_tran, ref_seq_orig, ref_length, alphabet,
+                         alphabet, false, 1, false, false, false,
+                         &gen_seq_bounds, splice_site_model, dp_options_core,
+                         dp_options_est, dp_options_postpro, NULL, NULL, 0,
+                         stat, NULL);
+    gt_ensure(rval == GTH_ERROR_MATRIX_ALLOCATION_FAILED);
+  }
+
+  /* the checkpoints fit into 1 MB and yield the same spliced alignment */
+  if (!had_err) {
+    dp_options_core->dpcheckpoints = true;
+    rval = gth_align_dna(sa_checkpoints, gen_ranges, gen_seq_tran,
+                         gen_seq_orig, ref_seq_tran, ref_seq_orig, ref_length,
+                         alphabet, alphabet, false, 1, false, false, false,
+                         &gen_seq_bounds, splice_site_model, dp_options_core,
+                         dp_options_est, dp_options_postpro, NULL, NULL, 0,
+                         stat, NULL);
+    gt_ensure(!rval);
+    gt_ensure(gth_sas_are_equal(sa_full, sa_checkpoints));
+  }
+
+  gth_sa_delete(sa_failed);
+  gth_sa_delete(sa_checkpoints);
+  gth_sa_delete(sa_full);
+  gth_stat_delete(stat);
+  gth_dp_options_postpro_delete(dp_options_postpro);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  gth_splice_site_model_delete(splice_site_model);
+  gt_array_delete(gen_ranges);
+  gt_alphabet_delete(alphabet);
+
+  return had_err;
+}
@@ -147,4 +147,6 @@ void gth_show_backtrace_matrix(GthPath **path,
                                const GtRange *btmatrixgenrange,
                                const GtRange *btmatrixrefrange);
 
+int  gth_align_dna_unit_test(GtError*);
+
 #endif
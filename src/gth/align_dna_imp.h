@@ -70,6 +70,10 @@ typedef enum {
   DNA_NUMOFRETRACE
 } DnaRetrace;
 
+/* bookkeeping for the checkpointed computation of the backtrace table, see
+   align_dna.c */
+typedef struct GthDPCheckpoints GthDPCheckpoints;
+
 /* the following structure bundles all tables involved in the dynamic
    programming for cDNAs/ESTs */
 struct GthDPMatrix {
@@ -82,6 +86,9 @@ struct GthDPMatrix {
                 *exonstart[DNA_NUMOFSCORETABLES],
                 gen_dp_length,
                 ref_dp_length;
+  GthDPCheckpoints *checkpoints;    /* if not NULL, only the rows of <path>
+                                       belonging to the current segment are
+                                       available */
 };
 
 #endif
@@ -129,6 +129,11 @@ void            gth_backtrace_path_show_complete(const GthBacktracePath*,
                                                  bool xmlout,
                                                  unsigned int indentlevel,
                                                  GtFile*);
+/* return all underlying edit operations (including cutoffs), in the order in
+   which they are stored (that is, reversed) */
+const Editoperation* gth_backtrace_path_get_complete(const GthBacktracePath*);
+GtUword              gth_backtrace_path_length_complete(
+                                                       const GthBacktracePath*);
 void            gth_backtrace_path_cutoff_start(GthBacktracePath*);
 void            gth_backtrace_path_cutoff_end(GthBacktracePath*);
 void            gth_backtrace_path_cutoff_walked_path(GthBacktracePath*,
@@ -0,0 +1,309 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <string.h>
+#include "core/bittab_api.h"
+#include "core/cstr_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "gth/binary_inter_sa_visitor.h"
+#include "gth/sa_visitor_rep.h"
+
+struct GthBinaryInterSAVisitor {
+  const GthSAVisitor parent_instance;
+  GthInput *input;
+  GtFile *outfp;
+  GtStr *buf;
+  GtBittab *gen_files_defined,
+           *ref_files_defined;
+  GtHashmap *ids; /* maps ids to their number + 1 */
+  GtUword num_of_ids;
+};
+
+#define binary_inter_sa_visitor_cast(GV)\
+        gth_sa_visitor_cast(gth_binary_inter_sa_visitor_class(), GV)
+
+static void append_varint(GtStr *buf, GtUword value)
+{
+  while (value >= 0x80) {
+    gt_str_append_char(buf, (char) ((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  gt_str_append_char(buf, (char) value);
+}
+
+static void append_zigzag(GtStr *buf, GtUword value, GtUword previous)
+{
+  GtWord diff = (GtWord) (value - previous);
+  append_varint(buf, diff < 0 ? ((GtUword) ~diff << 1) | 1
+                              : (GtUword) diff << 1);
+}
+
+static void append_cstr(GtStr *buf, const char *cstr)
+{
+  GtUword length = strlen(cstr);
+  append_varint(buf, length);
+  gt_str_append_cstr_nt(buf, cstr, length);
+}
+
+/* append the <nbytes> least significant bytes of <bits>, least significant
+   byte first, so that the format does not depend on the byte order */
+static void append_fixed(GtStr *buf, GtUint64 bits, size_t nbytes)
+{
+  size_t i;
+  for (i = 0; i < nbytes; i++) {
+    gt_str_append_char(buf, (char) (bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+/* floating point values are stored as their IEEE 754 bit patterns */
+static void append_float(GtStr *buf, GthFlt value)
+{
+  uint32_t bits;
+  gt_assert(sizeof value == sizeof bits);
+  memcpy(&bits, &value, sizeof bits);
+  append_fixed(buf, bits, sizeof bits);
+}
+
+static void append_double(GtStr *buf, GthDbl value)
+{
+  GtUint64 bits;
+  gt_assert(sizeof value == sizeof bits);
+  memcpy(&bits, &value, sizeof bits);
+  append_fixed(buf, bits, sizeof bits);
+}
+
+/* make sure that <bittab> can hold bit <num> */
+static GtBittab* bittab_ensure(GtBittab *bittab, GtUword num)
+{
+  GtUword i, size = bittab ? gt_bittab_size(bittab) : 0;
+  GtBittab *new_bittab;
+  if (num < size)
+    return bittab;
+  new_bittab = gt_bittab_new(2 * num + 16);
+  for (i = 0; i < size; i++) {
+    if (gt_bittab_bit_is_set(bittab, i))
+      gt_bittab_set_bit(new_bittab, i);
+  }
+  gt_bittab_delete(bittab);
+  return new_bittab;
+}
+
+/* define the files of <sa> in the output, if necessary */
+static void define_files(GthBinaryInterSAVisitor *visitor, GthSA *sa)
+{
+  GtUword filenum = gth_sa_gen_file_num(sa);
+  visitor->gen_files_defined = bittab_ensure(visitor->gen_files_defined,
+                                             filenum);
+  if (!gt_bittab_bit_is_set(visitor->gen_files_defined, filenum)) {
+    gt_str_append_char(visitor->buf, GTH_BINARY_INTER_GENFILE);
+    append_varint(visitor->buf, filenum);
+    append_cstr(visitor->buf, gth_input_get_genomic_filename(visitor->input,
+                                                             filenum));
+    gt_bittab_set_bit(visitor->gen_files_defined, filenum);
+  }
+  filenum = gth_sa_ref_file_num(sa);
+  visitor->ref_files_defined = bittab_ensure(visitor->ref_files_defined,
+                                             filenum);
+  if (!gt_bittab_bit_is_set(visitor->ref_files_defined, filenum)) {
+    gt_str_append_char(visitor->buf, GTH_BINARY_INTER_REFFILE);
+    append_varint(visitor->buf, filenum);
+    gt_str_append_char(visitor->buf, (char) gth_sa_alphatype(sa));
+    append_cstr(visitor->buf, gth_input_get_reference_filename(visitor->input,
+                                                               filenum));
+    gt_bittab_set_bit(visitor->ref_files_defined, filenum);
+  }
+}
+
+/* returns the number of <id>, it is defined in the output if necessary */
+static GtUword intern_id(GthBinaryInterSAVisitor *visitor, const char *id)
+{
+  GtUword num = (GtUword) gt_hashmap_get(visitor->ids, id);
+  if (num)
+    return num - 1;
+  gt_str_append_char(visitor->buf, GTH_BINARY_INTER_ID);
+  append_cstr(visitor->buf, id);
+  gt_hashmap_add(visitor->ids, gt_cstr_dup(id),
+                 (void*) (visitor->num_of_ids + 1));
+  return visitor->num_of_ids++;
+}
+
+/* append the edit operations of <sa> as runs of the same type, in the order
+   used by gt_editoperation_show() */
+static void append_eops(GtStr *buf, GthSA *sa)
+{
+  const Editoperation *eops;
+  GtUword i, num_of_eops, num_of_runs = 0, run_length = 0;
+  bool proteineops = gth_sa_alphatype(sa) == PROTEIN_ALPHA;
+  GtStr *runs;
+  Eoptype eoptype;
+
+  eops = gth_backtrace_path_get_complete(gth_sa_backtrace_path(sa));
+  num_of_eops = gth_backtrace_path_length_complete(gth_sa_backtrace_path(sa));
+  runs = gt_str_new();
+  for (i = num_of_eops; i > 0; i--) {
+    eoptype = gt_editoperation_type(eops[i-1], proteineops);
+    run_length += gt_editoperation_length(eops[i-1], proteineops);
+    if (i == 1 || gt_editoperation_type(eops[i-2], proteineops) != eoptype) {
+      gt_str_append_char(runs, (char) eoptype);
+      append_varint(runs, run_length);
+      num_of_runs++;
+      run_length = 0;
+    }
+  }
+  append_varint(buf, num_of_runs);
+  gt_str_append_str(buf, runs);
+  gt_str_delete(runs);
+}
+
+static void binary_inter_show_spliced_alignment(GthBinaryInterSAVisitor
+                                                *visitor, GthSA *sa)
+{
+  GtUword i, gen_id, ref_id, gen_prev, ref_prev;
+  GtStr *buf = visitor->buf;
+  unsigned char flags = 0;
+
+  gt_str_reset(buf);
+  define_files(visitor, sa);
+  gen_id = intern_id(visitor, gth_sa_gen_id(sa));
+  ref_id = intern_id(visitor, gth_sa_ref_id(sa));
+
+  if (gth_sa_gen_strand_forward(sa))
+    flags |= GTH_BINARY_INTER_GEN_FORWARD_FLAG;
+  if (gth_sa_ref_strand_forward(sa))
+    flags |= GTH_BINARY_INTER_REF_FORWARD_FLAG;
+  if (gth_sa_genomic_cov_is_highest(sa))
+    flags |= GTH_BINARY_INTER_GEN_COV_FLAG;
+
+  gt_str_append_char(buf, GTH_BINARY_INTER_SA);
+  gt_str_append_char(buf, (char) gth_sa_alphatype(sa));
+  gt_str_append_char(buf, (char) flags);
+  append_varint(buf, gth_sa_gen_file_num(sa));
+  append_varint(buf, gth_sa_gen_seq_num(sa));
+  append_varint(buf, gth_sa_ref_file_num(sa));
+  append_varint(buf, gth_sa_ref_seq_num(sa));
+  append_varint(buf, gen_id);
+  append_varint(buf, ref_id);
+  append_varint(buf, gth_sa_gen_total_length(sa));
+  append_varint(buf, gth_sa_gen_offset(sa));
+  append_varint(buf, gth_sa_ref_total_length(sa));
+  append_varint(buf, gth_sa_gen_dp_start(sa));
+  append_varint(buf, gth_sa_gen_dp_length(sa));
+  append_varint(buf, gth_sa_genomiccutoff_start(sa));
+  append_varint(buf, gth_sa_referencecutoff_start(sa));
+  append_varint(buf, gth_sa_eopcutoff_start(sa));
+  append_varint(buf, gth_sa_genomiccutoff_end(sa));
+  append_varint(buf, gth_sa_referencecutoff_end(sa));
+  append_varint(buf, gth_sa_eopcutoff_end(sa));
+  append_varint(buf, gth_sa_polyAtail_start(sa));
+  append_varint(buf, gth_sa_polyAtail_stop(sa));
+  append_varint(buf, gth_sa_cumlen_scored_exons(sa));
+  append_float(buf, gth_sa_score(sa));
+  append_float(buf, gth_sa_coverage(sa));
+
+  append_eops(buf, sa);
+
+  append_varint(buf, gth_sa_num_of_exons(sa));
+  gen_prev = gth_sa_gen_dp_start(sa);
+  ref_prev = 0;
+  for (i = 0; i < gth_sa_num_of_exons(sa); i++) {
+    Exoninfo *exon = gth_sa_get_exon(sa, i);
+    append_zigzag(buf, exon->leftgenomicexonborder, gen_prev);
+    append_zigzag(buf, exon->rightgenomicexonborder,
+                  exon->leftgenomicexonborder);
+    append_zigzag(buf, exon->leftreferenceexonborder, ref_prev);
+    append_zigzag(buf, exon->rightreferenceexonborder,
+                  exon->leftreferenceexonborder);
+    append_double(buf, exon->exonscore);
+    gen_prev = exon->rightgenomicexonborder;
+    ref_prev = exon->rightreferenceexonborder;
+  }
+
+  append_varint(buf, gth_sa_num_of_introns(sa));
+  for (i = 0; i < gth_sa_num_of_introns(sa); i++) {
+    Introninfo *intron = gth_sa_get_intron(sa, i);
+    append_float(buf, intron->donorsiteprobability);
+    append_float(buf, intron->acceptorsiteprobability);
+    append_double(buf, intron->donorsitescore);
+    append_double(buf, intron->acceptorsitescore);
+  }
+
+  gt_file_xwrite(visitor->outfp, gt_str_get(buf), gt_str_length(buf));
+}
+
+static void binary_inter_sa_visitor_free(GthSAVisitor *sa_visitor)
+{
+  GthBinaryInterSAVisitor *visitor = binary_inter_sa_visitor_cast(sa_visitor);
+  gt_str_delete(visitor->buf);
+  gt_bittab_delete(visitor->gen_files_defined);
+  gt_bittab_delete(visitor->ref_files_defined);
+  gt_hashmap_delete(visitor->ids);
+}
+
+static void binary_inter_sa_visitor_preface(GthSAVisitor *sa_visitor)
+{
+  GthBinaryInterSAVisitor *visitor = binary_inter_sa_visitor_cast(sa_visitor);
+  gt_str_reset(visitor->buf);
+  gt_str_append_cstr_nt(visitor->buf, GTH_BINARY_INTER_MAGIC,
+                        GTH_BINARY_INTER_MAGIC_LENGTH);
+  append_varint(visitor->buf, GTH_BINARY_INTER_VERSION);
+  gt_file_xwrite(visitor->outfp, gt_str_get(visitor->buf),
+                 gt_str_length(visitor->buf));
+}
+
+static void binary_inter_sa_visitor_visit_sa(GthSAVisitor *sa_visitor,
+                                             GthSA *sa)
+{
+  GthBinaryInterSAVisitor *visitor = binary_inter_sa_visitor_cast(sa_visitor);
+  gt_assert(sa);
+  binary_inter_show_spliced_alignment(visitor, sa);
+}
+
+static void binary_inter_sa_visitor_trailer(GthSAVisitor *sa_visitor,
+                                            GtUword num_of_sas)
+{
+  GthBinaryInterSAVisitor *visitor = binary_inter_sa_visitor_cast(sa_visitor);
+  gt_str_reset(visitor->buf);
+  gt_str_append_char(visitor->buf, GTH_BINARY_INTER_END);
+  append_varint(visitor->buf, num_of_sas);
+  gt_file_xwrite(visitor->outfp, gt_str_get(visitor->buf),
+                 gt_str_length(visitor->buf));
+}
+
+const GthSAVisitorClass* gth_binary_inter_sa_visitor_class()
+{
+  static const GthSAVisitorClass savc = { sizeof (GthBinaryInterSAVisitor),
+                                          binary_inter_sa_visitor_free,
+                                          binary_inter_sa_visitor_preface,
+                                          binary_inter_sa_visitor_visit_sa,
+                                          binary_inter_sa_visitor_trailer };
+  return &savc;
+}
+
+GthSAVisitor* gth_binary_inter_sa_visitor_new(GthInput *input, GtFile *outfp)
+{
+  GthSAVisitor *sa_visitor =
+    gth_sa_visitor_create(gth_binary_inter_sa_visitor_class());
+  GthBinaryInterSAVisitor *visitor = binary_inter_sa_visitor_cast(sa_visitor);
+  visitor->input = input;
+  visitor->outfp = outfp;
+  visitor->buf = gt_str_new();
+  visitor->ids = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  return sa_visitor;
+}
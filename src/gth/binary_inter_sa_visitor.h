@@ -0,0 +1,81 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_INTER_SA_VISITOR_H
+#define BINARY_INTER_SA_VISITOR_H
+
+#include "gth/sa_visitor.h"
+
+/*
+  Binary intermediate format for spliced alignments. All integers are stored
+  as LEB128 varints, floating point values as their IEEE 754 bit patterns
+  (4 bytes for floats, 8 bytes for doubles), least significant byte first.
+
+  header:  GTH_BINARY_INTER_MAGIC, varint GTH_BINARY_INTER_VERSION
+  records: a record type byte followed by the record data
+
+  GTH_BINARY_INTER_GENFILE: varint file number, varint length, file name
+  GTH_BINARY_INTER_REFFILE: varint file number, byte alphatype,
+                            varint length, file name
+  GTH_BINARY_INTER_ID:      varint length, sequence id; the ids are numbered
+                            consecutively in the order of their definition
+  GTH_BINARY_INTER_SA:      a spliced alignment, see below
+  GTH_BINARY_INTER_END:     varint number of spliced alignments in the file
+
+  Files and ids are defined once per file, before the first spliced
+  alignment referring to them. A spliced alignment consists of:
+
+  byte alphatype, byte flags (GTH_BINARY_INTER_*_FLAG),
+  varint genomic file number, genomic sequence number, reference file
+  number, reference sequence number, genomic id, reference id, genomic total
+  length, genomic offset, reference total length, genomic DP start, genomic
+  DP length, 2 * 3 cutoffs (start, end), polyA tail start, polyA tail stop,
+  cumulative length of scored exons,
+  float score, float coverage,
+  varint number of edit operation runs, for each run a byte edit operation
+  type and a varint length (in the order shown in the XML output),
+  varint number of exons, for each exon the 4 borders as zigzag encoded
+  varint differences to the previous genomic (reference) border, starting at
+  the genomic DP start (0), and the double exon score,
+  varint number of introns, for each intron 2 floats (donor and acceptor
+  site probability) and 2 doubles (donor and acceptor site score).
+
+  Written files are sorted by genomic position, the way the spliced alignment
+  collection is ordered.
+*/
+
+#define GTH_BINARY_INTER_MAGIC          "\211GSA"
+#define GTH_BINARY_INTER_MAGIC_LENGTH   4
+#define GTH_BINARY_INTER_VERSION        1
+
+#define GTH_BINARY_INTER_GENFILE        'g'
+#define GTH_BINARY_INTER_REFFILE        'r'
+#define GTH_BINARY_INTER_ID             'i'
+#define GTH_BINARY_INTER_SA             's'
+#define GTH_BINARY_INTER_END            'e'
+
+#define GTH_BINARY_INTER_GEN_FORWARD_FLAG  1
+#define GTH_BINARY_INTER_REF_FORWARD_FLAG  2
+#define GTH_BINARY_INTER_GEN_COV_FLAG      4
+
+/* implements the ``spliced alignment visitor'' interface */
+typedef struct GthBinaryInterSAVisitor GthBinaryInterSAVisitor;
+
+const GthSAVisitorClass* gth_binary_inter_sa_visitor_class(void);
+GthSAVisitor*            gth_binary_inter_sa_visitor_new(GthInput*,
+                                                         GtFile *outfp);
+
+#endif
@@ -16,6 +16,7 @@
 */
 
 #include "core/cstr_api.h"
+#include "core/thread_api.h"
 #include "gth/default.h"
 #include "gth/call_info.h"
 #include "gth/gthspeciestab.h"
@@ -28,12 +29,14 @@ GthCallInfo* gth_call_info_new(const char *progname)
 
   call_info->progname                 = gt_cstr_dup(progname);
   call_info->scorematrixfile          = gt_str_new();
+  call_info->sacollectionfile         = gt_str_new();
   call_info->dp_options_core          = gth_dp_options_core_new();
   call_info->dp_options_est           = gth_dp_options_est_new();
   call_info->dp_options_postpro       = gth_dp_options_postpro_new();
   call_info->translationtable         = GTH_DEFAULT_TRANSLATIONTABLE;
   call_info->out->skipalignmentout    = GTH_DEFAULT_SKIPALIGNMENTOUT;
   call_info->speciesnum               = NUMOFSPECIES;
+  call_info->threads                  = gt_jobs;
 
   call_info->out->comments            = GTH_DEFAULT_COMMENTS;
   call_info->out->verboseseqs         = GTH_DEFAULT_VERBOSESEQS;
@@ -54,6 +57,7 @@ void gth_call_info_delete(GthCallInfo *call_info)
 
   gt_free(call_info->progname);
   gt_str_delete(call_info->scorematrixfile);
+  gt_str_delete(call_info->sacollectionfile);
   gth_dp_options_core_delete(call_info->dp_options_core);
   gth_dp_options_est_delete(call_info->dp_options_est);
   gth_dp_options_postpro_delete(call_info->dp_options_postpro);
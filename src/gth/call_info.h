@@ -37,11 +37,16 @@ typedef struct {
                firstalshown,         /* number of cDNA/EST alignments shown
                                        (GS2=maxnest) */
                gcmaxgapwidth,        /* maximum gap width for global chains */
-               gcmincoverage;        /* minimum coverage of global chains
+               gcmincoverage,        /* minimum coverage of global chains
                                         regarding to the reference sequence */
+               threads;              /* number of threads used to compute the
+                                        spliced alignments of the chains and
+                                        to assemble the PGLs */
   char *progname;                    /* name of this binary (e.g., ``gth'') */
   GtStr *scorematrixfile;            /* file name of amino acid substitution
                                         matrix */
+  GtStr *sacollectionfile;           /* file name of persistent spliced
+                                        alignment collection (gthconsensus) */
   Gthsimfilterparam simfilterparam;  /* the parameter for the similarity filter
                                       */
   GthDPOptionsCore *dp_options_core; /* the core DP options */
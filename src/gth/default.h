@@ -98,6 +98,7 @@
 
 #define GTH_DEFAULT_NOICININTRONCHECK    false
 #define GTH_DEFAULT_FREEINTRONTRANS      false
+#define GTH_DEFAULT_DPCHECKPOINTS        true
 #define GTH_DEFAULT_DPMINEXONLENGTH      5
 #define GTH_DEFAULT_DPMININTRONLENGTH    50
 #define GTH_DEFAULT_SHORTEXONPENALTY     100.0
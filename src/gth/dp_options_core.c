@@ -25,6 +25,7 @@ GthDPOptionsCore* gth_dp_options_core_new(void)
   GthDPOptionsCore *dp_options_core = gt_malloc(sizeof *dp_options_core);
   dp_options_core->noicinintroncheck = GTH_DEFAULT_NOICININTRONCHECK;
   dp_options_core->freeintrontrans = GTH_DEFAULT_FREEINTRONTRANS;
+  dp_options_core->dpcheckpoints = GTH_DEFAULT_DPCHECKPOINTS;
   dp_options_core->dpminexonlength = GTH_DEFAULT_DPMINEXONLENGTH;
   dp_options_core->dpminintronlength = GTH_DEFAULT_DPMININTRONLENGTH;
   dp_options_core->shortexonpenalty = GTH_DEFAULT_SHORTEXONPENALTY;
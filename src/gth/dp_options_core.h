@@ -24,8 +24,10 @@
 typedef struct {
   bool noicinintroncheck,         /* perform no check if intron coutout is in
                                      intron */
-       freeintrontrans;           /* free state transitions between intron
+       freeintrontrans,           /* free state transitions between intron
                                      states */
+       dpcheckpoints;             /* use checkpoints for the backtrace table
+                                     if it does not fit into memory */
   unsigned int dpminexonlength,   /* minimum exon length for the DP */
                dpminintronlength; /* minimum intron length */
   double shortexonpenalty,        /* penalty for short exons */
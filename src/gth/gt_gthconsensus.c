@@ -15,6 +15,11 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/fileutils_api.h"
+#include "gth/binary_inter_sa_visitor.h"
 #include "gth/gthxml.h"
 #include "gth/gthverbosefunc.h"
 #include "gth/gthverbosefuncvm.h"
@@ -23,26 +28,70 @@
 #include "gth/proc_sa_collection.h"
 #include "gth/gt_gthconsensus.h"
 
+/* stores <sa_collection> in <filename> (in binary intermediate format). The
+   collection is written to a temporary file first, which replaces <filename>
+   afterwards, so that the old collection is kept if anything goes wrong. */
+static int store_sa_collection(GthSACollection *sa_collection, GthInput *input,
+                               const char *filename, GtError *err)
+{
+  GthSAVisitor *sa_visitor;
+  GtStr *tmpfilename;
+  GtFile *outfp;
+  int had_err = 0;
+
+  gt_error_check(err);
+  tmpfilename = gt_str_new_cstr(filename);
+  gt_str_append_cstr(tmpfilename, ".tmp");
+  outfp = gt_file_xopen(gt_str_get(tmpfilename), "w");
+  sa_visitor = gth_binary_inter_sa_visitor_new(input, outfp);
+  gth_sa_collection_traverse(sa_collection, sa_visitor, input);
+  gth_sa_visitor_delete(sa_visitor);
+  gt_file_delete(outfp);
+  if (rename(gt_str_get(tmpfilename), filename)) {
+    gt_error_set(err, "could not rename file \"%s\" to \"%s\": %s",
+                 gt_str_get(tmpfilename), filename, strerror(errno));
+    had_err = -1;
+  }
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
+
 static int process_consensus_files(GtStrArray *consensusfiles,
                                    GthCallInfo *call_info, GthInput *input,
                                    GthStat *stat, GtUword indentlevel,
                                    GtError *err)
 {
   GthSACollection *sa_collection;
-  int had_err;
+  int had_err = 0;
 
   gt_error_check(err);
 
   /* initialization */
   sa_collection = gth_sa_collection_new(call_info->duplicate_check);
 
-  if (call_info->out->showverbose)
+  /* load the stored collection of spliced alignments, if it exists. this way
+     only the newly given intermediate files have to be parsed */
+  if (gt_str_length(call_info->sacollectionfile) &&
+      gt_file_exists(gt_str_get(call_info->sacollectionfile))) {
+    GtStrArray *sacollectionfiles = gt_str_array_new();
+    if (call_info->out->showverbose)
+      call_info->out->showverbose("load spliced alignment collection");
+    gt_str_array_add(sacollectionfiles, call_info->sacollectionfile);
+    had_err = gth_build_sa_collection(sa_collection, input, sacollectionfiles,
+                                      call_info->sa_filter, stat,
+                                      call_info->out->showverbose, err);
+    gt_str_array_delete(sacollectionfiles);
+  }
+
+  if (!had_err && call_info->out->showverbose)
     call_info->out->showverbose("process all intermediate output files");
 
   /* build tree of alignments from intermediate files */
-  had_err = gth_build_sa_collection(sa_collection, input, consensusfiles,
-                                    call_info->sa_filter, stat,
-                                    call_info->out->showverbose, err);
+  if (!had_err) {
+    had_err = gth_build_sa_collection(sa_collection, input, consensusfiles,
+                                      call_info->sa_filter, stat,
+                                      call_info->out->showverbose, err);
+  }
 
   /* make sure the necessary indices of all input files are created */
   if (!had_err) {
@@ -60,6 +109,15 @@ static int process_consensus_files(GtStrArray *consensusfiles,
                                    err);
   }
 
+  /* store the updated collection of spliced alignments */
+  if (!had_err && gt_str_length(call_info->sacollectionfile)) {
+    if (call_info->out->showverbose)
+      call_info->out->showverbose("store spliced alignment collection");
+    had_err = store_sa_collection(sa_collection, input,
+                                  gt_str_get(call_info->sacollectionfile),
+                                  err);
+  }
+
   /* set reference MD5s, if necessary */
   gth_sa_collection_set_md5s(sa_collection, input);
 
@@ -127,7 +185,7 @@ int gt_gthconsensus(int argc, const char **argv, const GthPlugins *plugins,
   }
 
   /* output statistics */
-  if (!had_err && !call_info->out->gff3out)
+  if (!had_err && !call_info->out->gff3out && !call_info->out->binaryout)
     gth_stat_show(stat, false, call_info->out->xmlout, call_info->out->outfp);
 
   /* free space */
@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/thread_api.h"
 #include "gth/gthverbosefunc.h"
 #include "gth/intermediate.h"
 #include "gth/pgl_collection.h"
@@ -115,7 +116,7 @@ static int gthfilestat_process_files(GthFileStatInfo *file_stat_info,
 
   if (!had_err && gth_sa_collection_contains_sa(sa_collection)) {
     /* compute PGLs */
-    pgl_collection = gth_pgl_collection_new(sa_collection, false);
+    pgl_collection = gth_pgl_collection_new(sa_collection, false, gt_jobs);
 
     /* save statistics for PGLs */
     gth_stat_increase_numofPGLs_stored(stat,
@@ -68,6 +68,8 @@ typedef struct {
        pglgentemplate,              /* show genomic template in PGL lines */
        xmlout,                      /* show output in XML format */
        gff3out,                     /* show output in GFF3 format */
+       binaryout,                   /* show intermediate output in binary
+                                       format */
        gff3descranges,              /* use description ranges for GFF3 output */
        gs2out,                      /* output in deprecated GeneSeqer2 format */
        md5ids,                      /* show MD5 fingerprints as sequence IDs */
@@ -15,11 +15,21 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
 #include <expat.h>
 #include "core/compat.h"
+#include "core/ensure.h"
 #include "core/fa.h"
+#include "core/ma.h"
+#include "core/undef_api.h"
 #include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/priority_queue.h"
+#include "gth/binary_inter_sa_visitor.h"
 #include "gth/intermediate.h"
+#include "gth/sa_cmp.h"
 
 #define SPLICEDALIGNMENT_TAG            "spliced_alignment"
 #define REFERENCEALPHATYPE_TAG          "referencealphatype"
@@ -546,6 +556,567 @@ int gt_parse_intermediate_output(GthInput *input,
   return had_err;
 }
 
+#define BINARY_INTER_BUFSIZE  65536
+
+/* reads spliced alignments from a file in the binary intermediate format (see
+   binary_inter_sa_visitor.h) */
+typedef struct {
+  GtFile *fp;
+  const char *filename;
+  unsigned char *buf;
+  size_t pos,
+         len;
+  GtArray *gen_files, /* map the file numbers of the file to the file */
+          *ref_files; /* numbers of the input */
+  GtStrArray *ids;
+  GtStr *strbuf;
+  GtUword num_of_sas;
+} BinaryInterReader;
+
+static BinaryInterReader* binary_inter_reader_new(GtFile *fp,
+                                                  const char *filename)
+{
+  BinaryInterReader *reader = gt_malloc(sizeof *reader);
+  reader->fp = fp;
+  reader->filename = filename;
+  reader->buf = gt_malloc(BINARY_INTER_BUFSIZE);
+  reader->pos = reader->len = 0;
+  reader->gen_files = gt_array_new(sizeof (GtUword));
+  reader->ref_files = gt_array_new(sizeof (GtUword));
+  reader->ids = gt_str_array_new();
+  reader->strbuf = gt_str_new();
+  reader->num_of_sas = 0;
+  return reader;
+}
+
+static void binary_inter_reader_delete(BinaryInterReader *reader)
+{
+  if (!reader) return;
+  gt_file_delete(reader->fp);
+  gt_free(reader->buf);
+  gt_array_delete(reader->gen_files);
+  gt_array_delete(reader->ref_files);
+  gt_str_array_delete(reader->ids);
+  gt_str_delete(reader->strbuf);
+  gt_free(reader);
+}
+
+static int binary_inter_truncated(BinaryInterReader *reader, GtError *err)
+{
+  gt_error_set(err, "intermediate file \"%s\" is truncated", reader->filename);
+  return -1;
+}
+
+static int binary_inter_illegal(BinaryInterReader *reader, GtError *err)
+{
+  gt_error_set(err, "intermediate file \"%s\" contains illegal data",
+               reader->filename);
+  return -1;
+}
+
+/* returns EOF at the end of the file */
+static int binary_inter_getc(BinaryInterReader *reader)
+{
+  if (reader->pos == reader->len) {
+    int rval = gt_file_xread(reader->fp, reader->buf, BINARY_INTER_BUFSIZE);
+    if (rval <= 0)
+      return EOF;
+    reader->len = (size_t) rval;
+    reader->pos = 0;
+  }
+  return reader->buf[reader->pos++];
+}
+
+static int binary_inter_read_byte(BinaryInterReader *reader,
+                                  unsigned char *byte, GtError *err)
+{
+  int cc = binary_inter_getc(reader);
+  if (cc == EOF)
+    return binary_inter_truncated(reader, err);
+  *byte = (unsigned char) cc;
+  return 0;
+}
+
+/* reads <nbytes> bytes, least significant byte first */
+static int binary_inter_read_fixed(BinaryInterReader *reader, GtUint64 *bits,
+                                   size_t nbytes, GtError *err)
+{
+  unsigned char byte;
+  size_t i;
+  *bits = 0;
+  for (i = 0; i < nbytes; i++) {
+    if (binary_inter_read_byte(reader, &byte, err))
+      return -1;
+    *bits |= (GtUint64) byte << (i * CHAR_BIT);
+  }
+  return 0;
+}
+
+/* floating point values are stored as their IEEE 754 bit patterns */
+static int binary_inter_read_float(BinaryInterReader *reader, GthFlt *value,
+                                   GtError *err)
+{
+  GtUint64 bits;
+  uint32_t bits32;
+  gt_assert(sizeof *value == sizeof bits32);
+  if (binary_inter_read_fixed(reader, &bits, sizeof bits32, err))
+    return -1;
+  bits32 = (uint32_t) bits;
+  memcpy(value, &bits32, sizeof bits32);
+  return 0;
+}
+
+static int binary_inter_read_double(BinaryInterReader *reader, GthDbl *value,
+                                    GtError *err)
+{
+  GtUint64 bits;
+  gt_assert(sizeof *value == sizeof bits);
+  if (binary_inter_read_fixed(reader, &bits, sizeof bits, err))
+    return -1;
+  memcpy(value, &bits, sizeof bits);
+  return 0;
+}
+
+static int binary_inter_read_varint(BinaryInterReader *reader,
+                                    GtUword *value, GtError *err)
+{
+  unsigned int shift = 0;
+  unsigned char byte;
+  *value = 0;
+  do {
+    if (shift >= sizeof (GtUword) * CHAR_BIT)
+      return binary_inter_illegal(reader, err);
+    if (binary_inter_read_byte(reader, &byte, err))
+      return -1;
+    *value |= (GtUword) (byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return 0;
+}
+
+static int binary_inter_read_zigzag(BinaryInterReader *reader,
+                                    GtUword *value, GtUword previous,
+                                    GtError *err)
+{
+  GtUword zigzag;
+  if (binary_inter_read_varint(reader, &zigzag, err))
+    return -1;
+  if (zigzag & 1)
+    *value = previous - (zigzag >> 1) - 1;
+  else
+    *value = previous + (zigzag >> 1);
+  return 0;
+}
+
+/* reads a string into <reader->strbuf> */
+static int binary_inter_read_str(BinaryInterReader *reader, GtError *err)
+{
+  GtUword i, length;
+  unsigned char byte;
+  gt_str_reset(reader->strbuf);
+  if (binary_inter_read_varint(reader, &length, err))
+    return -1;
+  for (i = 0; i < length; i++) {
+    if (binary_inter_read_byte(reader, &byte, err))
+      return -1;
+    gt_str_append_char(reader->strbuf, (char) byte);
+  }
+  return 0;
+}
+
+static int binary_inter_read_file(BinaryInterReader *reader, GthInput *input,
+                                  bool isreferencefile, GtError *err)
+{
+  GtUword filenum, undef = GT_UNDEF_UWORD, *files;
+  GthAlphatype alphatype = UNDEF_ALPHA;
+  GtArray *filemap = isreferencefile ? reader->ref_files : reader->gen_files;
+  unsigned char byte;
+  if (binary_inter_read_varint(reader, &filenum, err))
+    return -1;
+  if (isreferencefile) {
+    if (binary_inter_read_byte(reader, &byte, err))
+      return -1;
+    if (byte != DNA_ALPHA && byte != PROTEIN_ALPHA)
+      return binary_inter_illegal(reader, err);
+    alphatype = byte;
+  }
+  if (binary_inter_read_str(reader, err))
+    return -1;
+  while (gt_array_size(filemap) <= filenum)
+    gt_array_add(filemap, undef);
+  files = gt_array_get_space(filemap);
+  files[filenum] = process_file(input, gt_str_get(reader->strbuf),
+                                GTH_UNDEFINED_HASH, isreferencefile,
+                                alphatype);
+  return 0;
+}
+
+static int binary_inter_map(BinaryInterReader *reader, GtArray *filemap,
+                            GtUword *filenum, GtError *err)
+{
+  if (*filenum >= gt_array_size(filemap) ||
+      *(GtUword*) gt_array_get(filemap, *filenum) == GT_UNDEF_UWORD) {
+    return binary_inter_illegal(reader, err);
+  }
+  *filenum = *(GtUword*) gt_array_get(filemap, *filenum);
+  return 0;
+}
+
+static const char* binary_inter_id(BinaryInterReader *reader, GtUword id)
+{
+  if (id >= gt_str_array_size(reader->ids))
+    return NULL;
+  return gt_str_array_get(reader->ids, id);
+}
+
+static int binary_inter_read_sa(BinaryInterReader *reader, GthSA *sa,
+                                GtError *err)
+{
+  GtUword i, values[20], num, gen_prev, ref_prev;
+  unsigned char alphatype, flags, eoptype;
+  const char *gen_id, *ref_id;
+  GthFlt score, coverage;
+  Cutoffs cutoffs;
+  Exoninfo exoninfo;
+  Introninfo introninfo;
+  int had_err;
+
+  had_err = binary_inter_read_byte(reader, &alphatype, err);
+  if (!had_err)
+    had_err = binary_inter_read_byte(reader, &flags, err);
+  if (!had_err && alphatype != DNA_ALPHA && alphatype != PROTEIN_ALPHA)
+    had_err = binary_inter_illegal(reader, err);
+  for (i = 0; !had_err && i < sizeof values / sizeof values[0]; i++)
+    had_err = binary_inter_read_varint(reader, values + i, err);
+  if (!had_err)
+    had_err = binary_inter_read_float(reader, &score, err);
+  if (!had_err)
+    had_err = binary_inter_read_float(reader, &coverage, err);
+  if (!had_err)
+    had_err = binary_inter_map(reader, reader->gen_files, values, err);
+  if (!had_err)
+    had_err = binary_inter_map(reader, reader->ref_files, values + 2, err);
+  if (!had_err) {
+    gen_id = binary_inter_id(reader, values[4]);
+    ref_id = binary_inter_id(reader, values[5]);
+    if (!gen_id || !ref_id)
+      had_err = binary_inter_illegal(reader, err);
+  }
+  if (had_err)
+    return had_err;
+
+  gth_sa_set_alphatype(sa, alphatype);
+
+  /* edit operations */
+  had_err = binary_inter_read_varint(reader, &num, err);
+  for (i = 0; !had_err && i < num; i++) {
+    GtUword length;
+    had_err = binary_inter_read_byte(reader, &eoptype, err);
+    if (!had_err)
+      had_err = binary_inter_read_varint(reader, &length, err);
+    if (!had_err && eoptype >= NUM_OF_EOP_TYPES)
+      had_err = binary_inter_illegal(reader, err);
+    if (!had_err) {
+      gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), eoptype, length);
+    }
+  }
+  if (had_err)
+    return had_err;
+
+  gth_sa_set_gen_dp_length(sa, values[10]);
+  gth_sa_set_gen_total_length(sa, values[6]);
+  gth_sa_set_gen_offset(sa, values[7]);
+  gth_sa_set_ref_total_length(sa, values[8]);
+  gth_sa_set_gen_dp_start(sa, values[9]);
+  gth_sa_set_gen_file_num(sa, values[0]);
+  gth_sa_set_gen_seq_num(sa, values[1]);
+  gth_sa_set_ref_file_num(sa, values[2]);
+  gth_sa_set_ref_seq_num(sa, values[3]);
+  gth_sa_set_gen_id(sa, gen_id);
+  gth_sa_set_ref_id(sa, ref_id);
+  gth_sa_set_gen_strand(sa, flags & GTH_BINARY_INTER_GEN_FORWARD_FLAG);
+  gth_sa_set_ref_strand(sa, flags & GTH_BINARY_INTER_REF_FORWARD_FLAG);
+  cutoffs.genomiccutoff = values[11];
+  cutoffs.referencecutoff = values[12];
+  cutoffs.eopcutoff = values[13];
+  gth_sa_set_cutoffs_start(sa, &cutoffs);
+  cutoffs.genomiccutoff = values[14];
+  cutoffs.referencecutoff = values[15];
+  cutoffs.eopcutoff = values[16];
+  gth_sa_set_cutoffs_end(sa, &cutoffs);
+
+  /* exons */
+  had_err = binary_inter_read_varint(reader, &num, err);
+  gen_prev = values[9];
+  ref_prev = 0;
+  for (i = 0; !had_err && i < num; i++) {
+    had_err = binary_inter_read_zigzag(reader,
+                                       &exoninfo.leftgenomicexonborder,
+                                       gen_prev, err);
+    if (!had_err) {
+      had_err = binary_inter_read_zigzag(reader,
+                                         &exoninfo.rightgenomicexonborder,
+                                         exoninfo.leftgenomicexonborder, err);
+    }
+    if (!had_err) {
+      had_err = binary_inter_read_zigzag(reader,
+                                         &exoninfo.leftreferenceexonborder,
+                                         ref_prev, err);
+    }
+    if (!had_err) {
+      had_err = binary_inter_read_zigzag(reader,
+                                         &exoninfo.rightreferenceexonborder,
+                                         exoninfo.leftreferenceexonborder,
+                                         err);
+    }
+    if (!had_err) {
+      had_err = binary_inter_read_double(reader, &exoninfo.exonscore, err);
+    }
+    if (!had_err) {
+      gth_sa_add_exon(sa, &exoninfo);
+      gen_prev = exoninfo.rightgenomicexonborder;
+      ref_prev = exoninfo.rightreferenceexonborder;
+    }
+  }
+
+  /* introns */
+  if (!had_err)
+    had_err = binary_inter_read_varint(reader, &num, err);
+  for (i = 0; !had_err && i < num; i++) {
+    had_err = binary_inter_read_float(reader,
+                                      &introninfo.donorsiteprobability, err);
+    if (!had_err) {
+      had_err = binary_inter_read_float(reader,
+                                        &introninfo.acceptorsiteprobability,
+                                        err);
+    }
+    if (!had_err) {
+      had_err = binary_inter_read_double(reader, &introninfo.donorsitescore,
+                                         err);
+    }
+    if (!had_err) {
+      had_err = binary_inter_read_double(reader,
+                                         &introninfo.acceptorsitescore, err);
+    }
+    if (!had_err)
+      gth_sa_add_intron(sa, &introninfo);
+  }
+  if (had_err)
+    return had_err;
+
+  gth_sa_set_polyAtail_start(sa, values[17]);
+  gth_sa_set_polyAtail_stop(sa, values[18]);
+  gth_sa_set_score(sa, score);
+  gth_sa_set_coverage(sa, coverage);
+  gth_sa_set_highest_cov(sa, flags & GTH_BINARY_INTER_GEN_COV_FLAG);
+  gth_sa_set_cumlen_scored_exons(sa, values[19]);
+
+  /* the edit operations have been added in forward direction, see
+     end_element_handler() */
+  gth_backtrace_path_reverse(gth_sa_backtrace_path(sa));
+  gth_backtrace_path_ensure_length_1_before_introns(gth_sa_backtrace_path(sa));
+
+  return 0;
+}
+
+/* Reads the next spliced alignment from <reader> and stores it in <sa_out>.
+   At the end of the file <sa_out> is set to NULL. */
+static int binary_inter_reader_next(BinaryInterReader *reader,
+                                    GthInput *input, GthSA **sa_out,
+                                    GtError *err)
+{
+  GtUword num_of_sas;
+  int cc, had_err = 0;
+
+  gt_error_check(err);
+  *sa_out = NULL;
+  while (!had_err) {
+    if ((cc = binary_inter_getc(reader)) == EOF)
+      return binary_inter_truncated(reader, err);
+    switch (cc) {
+      case GTH_BINARY_INTER_GENFILE:
+        had_err = binary_inter_read_file(reader, input, false, err);
+        break;
+      case GTH_BINARY_INTER_REFFILE:
+        had_err = binary_inter_read_file(reader, input, true, err);
+        break;
+      case GTH_BINARY_INTER_ID:
+        had_err = binary_inter_read_str(reader, err);
+        if (!had_err)
+          gt_str_array_add(reader->ids, reader->strbuf);
+        break;
+      case GTH_BINARY_INTER_SA:
+        *sa_out = gth_sa_new();
+        if (binary_inter_read_sa(reader, *sa_out, err)) {
+          gth_sa_delete(*sa_out);
+          *sa_out = NULL;
+          return -1;
+        }
+        reader->num_of_sas++;
+        return 0;
+      case GTH_BINARY_INTER_END:
+        had_err = binary_inter_read_varint(reader, &num_of_sas, err);
+        if (!had_err && num_of_sas != reader->num_of_sas) {
+          gt_error_set(err, "intermediate file \"%s\" should contain "GT_WU
+                       " spliced alignments, but "GT_WU" have been read",
+                       reader->filename, num_of_sas, reader->num_of_sas);
+          had_err = -1;
+        }
+        return had_err;
+      default:
+        had_err = binary_inter_illegal(reader, err);
+    }
+  }
+  return had_err;
+}
+
+/* Sets <binary> to true, if the intermediate file <fp> is in binary format. In
+   this case, the file header has been consumed. */
+static int binary_inter_detect(GtFile *fp, const char *filename, bool *binary,
+                               GtError *err)
+{
+  char magic[GTH_BINARY_INTER_MAGIC_LENGTH];
+  GtUword version = 0, shift = 0;
+  int cc, i;
+
+  *binary = false;
+  if ((cc = gt_file_xfgetc(fp)) == EOF)
+    return 0;
+  if (cc != (unsigned char) GTH_BINARY_INTER_MAGIC[0]) {
+    gt_file_unget_char(fp, (char) cc);
+    return 0;
+  }
+  *binary = true;
+  magic[0] = (char) cc;
+  for (i = 1; i < GTH_BINARY_INTER_MAGIC_LENGTH; i++) {
+    if ((cc = gt_file_xfgetc(fp)) == EOF)
+      break;
+    magic[i] = (char) cc;
+  }
+  if (i < GTH_BINARY_INTER_MAGIC_LENGTH ||
+      memcmp(magic, GTH_BINARY_INTER_MAGIC, GTH_BINARY_INTER_MAGIC_LENGTH)) {
+    gt_error_set(err, "file \"%s\" is not an intermediate file", filename);
+    return -1;
+  }
+  do {
+    if ((cc = gt_file_xfgetc(fp)) == EOF || shift >= 28) {
+      gt_error_set(err, "intermediate file \"%s\" is truncated", filename);
+      return -1;
+    }
+    version |= (GtUword) (cc & 0x7f) << shift;
+    shift += 7;
+  } while (cc & 0x80);
+  if (version != GTH_BINARY_INTER_VERSION) {
+    gt_error_set(err, "intermediate file \"%s\" has unsupported version "GT_WU
+                 " (expected %d)", filename, version, GTH_BINARY_INTER_VERSION);
+    return -1;
+  }
+  return 0;
+}
+
+static int parse_binary_intermediate_output(GthInput *input,
+                                            GthSAProcessFunc saprocessfunc,
+                                            void *data,
+                                            BinaryInterReader *reader,
+                                            GtError *err)
+{
+  GthSA *sa;
+  int had_err;
+  gt_error_check(err);
+  while (!(had_err = binary_inter_reader_next(reader, input, &sa, err)) && sa)
+    had_err = saprocessfunc(data, sa, reader->filename, err);
+  return had_err;
+}
+
+/* parses an intermediate file in XML or binary format */
+static int parse_intermediate_output(GthInput *input,
+                                     GthSAProcessFunc saprocessfunc,
+                                     void *data, const char *outputfilename,
+                                     GtFile *intermediate_fp, GtError *err)
+{
+  BinaryInterReader *reader;
+  bool binary;
+  int had_err;
+  gt_error_check(err);
+  had_err = binary_inter_detect(intermediate_fp, outputfilename, &binary, err);
+  if (!had_err && !binary) {
+    return gt_parse_intermediate_output(input, saprocessfunc, data,
+                                        outputfilename, intermediate_fp, err);
+  }
+  if (!had_err) {
+    reader = binary_inter_reader_new(intermediate_fp, outputfilename);
+    had_err = parse_binary_intermediate_output(input, saprocessfunc, data,
+                                               reader, err);
+    reader->fp = NULL; /* is owned by the caller */
+    binary_inter_reader_delete(reader);
+  }
+  return had_err;
+}
+
+typedef struct {
+  BinaryInterReader *reader;
+  GthSA *sa;
+  GtUword filenum;
+} MergeEntry;
+
+static int merge_entry_compare(const void *a, const void *b)
+{
+  const MergeEntry *entry_a = a, *entry_b = b;
+  int rval;
+  if ((rval = gth_sa_cmp_genomic_forward(entry_a->sa, entry_b->sa)))
+    return rval;
+  if (entry_a->filenum < entry_b->filenum)
+    return -1;
+  if (entry_a->filenum > entry_b->filenum)
+    return 1;
+  return 0;
+}
+
+/* The following function merges the spliced alignments of all binary
+   intermediate files in <readers> by their genomic position (k-way merge).
+   If each file is sorted, <saprocessfunc> is called in sorted order. */
+static int merge_binary_intermediate_files(GtArray *readers, GthInput *input,
+                                           GthSAProcessFunc saprocessfunc,
+                                           void *data, GtError *err)
+{
+  GtUword i, num_of_readers = gt_array_size(readers);
+  GtPriorityQueue *pq;
+  MergeEntry *entries, *entry;
+  GthSA *sa;
+  int had_err = 0;
+
+  gt_error_check(err);
+  pq = gt_priority_queue_new(merge_entry_compare, num_of_readers);
+  entries = gt_malloc(sizeof *entries * num_of_readers);
+  for (i = 0; !had_err && i < num_of_readers; i++) {
+    entries[i].reader = *(BinaryInterReader**) gt_array_get(readers, i);
+    entries[i].filenum = i;
+    had_err = binary_inter_reader_next(entries[i].reader, input,
+                                       &entries[i].sa, err);
+    if (!had_err && entries[i].sa)
+      gt_priority_queue_add(pq, entries + i);
+  }
+  while (!had_err && !gt_priority_queue_is_empty(pq)) {
+    entry = gt_priority_queue_extract_min(pq);
+    sa = entry->sa;
+    had_err = binary_inter_reader_next(entry->reader, input, &entry->sa, err);
+    if (!had_err && entry->sa)
+      gt_priority_queue_add(pq, entry);
+    if (!had_err)
+      had_err = saprocessfunc(data, sa, entry->reader->filename, err);
+    else
+      gth_sa_delete(sa);
+  }
+  /* free the pending spliced alignments, if an error occurred */
+  while (!gt_priority_queue_is_empty(pq)) {
+    entry = gt_priority_queue_extract_min(pq);
+    gth_sa_delete(entry->sa);
+  }
+  gt_priority_queue_delete(pq);
+  gt_free(entries);
+  return had_err;
+}
+
 bool gth_intermediate_output_is_correct(char *outputfilename,
                                         GthSACollection *orig_sa_collection,
                                         GthInput *input,
@@ -584,7 +1155,7 @@ bool gth_intermediate_output_is_correct(char *outputfilename,
   gt_assert(*outfp);
 
   /* read in the intermediate output */
-  if (gt_parse_intermediate_output(input, store_in_sa_collection,
+  if (parse_intermediate_output(input, store_in_sa_collection,
                                    &sa_collection_data, outputfilename, *outfp,
                                    err)) {
     fprintf(stderr, "error: %s\n", gt_error_get(err));
@@ -630,12 +1201,17 @@ int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
 {
   GtUword i;
   GtFile *fp, *genfile;
+  GtArray *readers;
+  bool binary;
   int had_err = 0;
 
   gt_error_check(err);
 
   /* process all files */
   if (gt_str_array_size(consensusfiles)) {
+    /* XML files are processed one after another, binary files are merged
+       afterwards */
+    readers = gt_array_new(sizeof (BinaryInterReader*));
     for (i = 0; !had_err && i < gt_str_array_size(consensusfiles); i++) {
       /* open file */
       fp = gt_file_xopen(gt_str_array_get(consensusfiles, i), "r");
@@ -646,18 +1222,38 @@ int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
                                gt_str_array_get(consensusfiles, i));
       }
 
-      had_err = gt_parse_intermediate_output(input, saprocessfunc, data,
-                                          gt_str_array_get(consensusfiles, i),
-                                          fp, err);
+      had_err = binary_inter_detect(fp, gt_str_array_get(consensusfiles, i),
+                                    &binary, err);
+      if (!had_err && binary) {
+        BinaryInterReader *reader =
+          binary_inter_reader_new(fp, gt_str_array_get(consensusfiles, i));
+        gt_array_add(readers, reader);
+        continue;
+      }
+      if (!had_err) {
+        had_err = gt_parse_intermediate_output(input, saprocessfunc, data,
+                                            gt_str_array_get(consensusfiles, i),
+                                            fp, err);
+      }
 
       /* close file */
       gt_file_delete(fp);
     }
+    if (!had_err && gt_array_size(readers)) {
+      if (showverbose)
+        showverbose("merge binary intermediate files");
+      had_err = merge_binary_intermediate_files(readers, input, saprocessfunc,
+                                                data, err);
+    }
+    for (i = 0; i < gt_array_size(readers); i++)
+      binary_inter_reader_delete(*(BinaryInterReader**)
+                                 gt_array_get(readers, i));
+    gt_array_delete(readers);
   }
   else {
     genfile = gt_file_new_from_fileptr(stdin);
-    had_err = gt_parse_intermediate_output(input, saprocessfunc, data, "stdin",
-                                           genfile, err);
+    had_err = parse_intermediate_output(input, saprocessfunc, data, "stdin",
+                                        genfile, err);
     gt_file_delete_without_handle(genfile);
   }
 
@@ -679,3 +1275,150 @@ int gth_build_sa_collection(GthSACollection *sa_collection, GthInput *input,
                                         store_in_sa_collection,
                                         &sa_collection_data, showverbose, err);
 }
+
+static GthSeqCon* intermediate_test_seq_con_new(GT_UNUSED const char
+                                                *indexname,
+                                                GT_UNUSED bool assign_rc,
+                                                GT_UNUSED bool orig_seq,
+                                                GT_UNUSED bool tran_seq)
+{
+  gt_assert(0); /* the test does not access any sequences */
+  return NULL;
+}
+
+static int intermediate_test_store_sa(void *data, GthSA *sa,
+                                      GT_UNUSED const char *outputfilename,
+                                      GT_UNUSED GtError *err)
+{
+  gt_array_add((GtArray*) data, sa);
+  return 0;
+}
+
+/* finds the byte sequence <pattern> of length <length> in <str> */
+static bool intermediate_test_contains(const GtStr *str,
+                                       const unsigned char *pattern,
+                                       size_t length)
+{
+  const char *cstr = gt_str_get(str);
+  GtUword i;
+  for (i = 0; i + length <= gt_str_length(str); i++) {
+    if (!memcmp(cstr + i, pattern, length))
+      return true;
+  }
+  return false;
+}
+
+/* writes a spliced alignment in the binary intermediate format, checks that
+   its floating point values are stored independently of the byte order of
+   this machine, and reads it back */
+int gth_intermediate_unit_test(GtError *err)
+{
+  /* IEEE 754 bit patterns of 0.75f and 0.625, least significant byte first */
+  static const unsigned char score_bytes[] = { 0x00, 0x00, 0x40, 0x3f },
+                             exonscore_bytes[] = { 0x00, 0x00, 0x00, 0x00,
+                                                   0x00, 0x00, 0xe4, 0x3f };
+  Exoninfo exoninfo;
+  Introninfo introninfo;
+  GtStr *filename, *content;
+  GtStrArray *consensusfiles;
+  GtArray *read_sas;
+  GthSAVisitor *visitor;
+  GthInput *input;
+  GthSA *sa;
+  GtFile *outfp;
+  FILE *fp;
+  int cc, had_err = 0;
+
+  gt_error_check(err);
+
+  /* the spliced alignment refers to an (empty) temporary file as genomic and
+     reference file, its name is stored in the intermediate file */
+  filename = gt_str_new();
+  fp = gt_xtmpfp(filename);
+  gt_fa_xfclose(fp);
+  input = gth_input_new(NULL, intermediate_test_seq_con_new);
+  gth_input_add_genomic_file(input, gt_str_get(filename));
+  gth_input_add_reference_file(input, gt_str_get(filename), DNA_ALPHA);
+
+  sa = gth_sa_new();
+  gth_sa_set(sa, DNA_ALPHA, 100, 500);
+  gth_sa_set_gen_id(sa, "gen");
+  gth_sa_set_ref_id(sa, "ref");
+  gth_sa_set_gen_strand(sa, true);
+  gth_sa_set_ref_strand(sa, false);
+  gth_sa_set_gen_total_length(sa, 1000);
+  gth_sa_set_ref_total_length(sa, 210);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MATCH, 100);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_INTRON,
+                             300);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MISMATCH, 1);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MATCH, 99);
+  gth_backtrace_path_reverse(gth_sa_backtrace_path(sa));
+  exoninfo.leftgenomicexonborder = 100;
+  exoninfo.rightgenomicexonborder = 199;
+  exoninfo.leftreferenceexonborder = 0;
+  exoninfo.rightreferenceexonborder = 99;
+  exoninfo.exonscore = 0.625;
+  gth_sa_add_exon(sa, &exoninfo);
+  exoninfo.leftgenomicexonborder = 500;
+  exoninfo.rightgenomicexonborder = 599;
+  exoninfo.leftreferenceexonborder = 100;
+  exoninfo.rightreferenceexonborder = 199;
+  exoninfo.exonscore = 0.99;
+  gth_sa_add_exon(sa, &exoninfo);
+  introninfo.donorsiteprobability = (GthFlt) 0.123;
+  introninfo.acceptorsiteprobability = (GthFlt) 0.987;
+  introninfo.donorsitescore = 0.321;
+  introninfo.acceptorsitescore = 0.789;
+  gth_sa_add_intron(sa, &introninfo);
+  gth_sa_set_polyAtail_start(sa, 200);
+  gth_sa_set_polyAtail_stop(sa, 209);
+  gth_sa_set_score(sa, (GthFlt) 0.75);
+  gth_sa_set_coverage(sa, (GthFlt) 0.952);
+
+  /* write the spliced alignment */
+  outfp = gt_file_xopen(gt_str_get(filename), "w");
+  visitor = gth_binary_inter_sa_visitor_new(input, outfp);
+  gth_sa_visitor_preface(visitor);
+  gth_sa_visitor_visit_sa(visitor, sa);
+  gth_sa_visitor_trailer(visitor, 1);
+  gth_sa_visitor_delete(visitor);
+  gt_file_delete(outfp);
+
+  /* the floating point values are stored in little endian byte order */
+  content = gt_str_new();
+  fp = gt_fa_xfopen(gt_str_get(filename), "r");
+  while ((cc = getc(fp)) != EOF)
+    gt_str_append_char(content, (char) cc);
+  gt_fa_xfclose(fp);
+  gt_ensure(intermediate_test_contains(content, score_bytes,
+                                       sizeof score_bytes));
+  gt_ensure(intermediate_test_contains(content, exonscore_bytes,
+                                       sizeof exonscore_bytes));
+
+  /* read it back */
+  read_sas = gt_array_new(sizeof (GthSA*));
+  if (!had_err) {
+    consensusfiles = gt_str_array_new();
+    gt_str_array_add(consensusfiles, filename);
+    had_err = gth_process_intermediate_files(input, consensusfiles,
+                                             intermediate_test_store_sa,
+                                             read_sas, NULL, err);
+    gt_str_array_delete(consensusfiles);
+  }
+  gt_ensure(gt_array_size(read_sas) == 1);
+  gt_ensure(gth_sas_are_equal(sa, *(GthSA**) gt_array_get_first(read_sas)));
+  gt_ensure(gth_input_num_of_gen_files(input) == 1);
+  gt_ensure(gth_input_num_of_ref_files(input) == 1);
+
+  while (gt_array_size(read_sas))
+    gth_sa_delete(*(GthSA**) gt_array_pop(read_sas));
+  gt_array_delete(read_sas);
+  gt_str_delete(content);
+  gth_sa_delete(sa);
+  gth_input_delete_complete(input);
+  gt_xremove(gt_str_get(filename));
+  gt_str_delete(filename);
+
+  return had_err;
+}
@@ -40,4 +40,6 @@ int  gth_build_sa_collection(GthSACollection*, GthInput*,
                              GtStrArray *consensusfiles, GthSAFilter*, GthStat*,
                              GthShowVerbose, GtError*);
 
+int  gth_intermediate_unit_test(GtError*);
+
 #endif
@@ -16,6 +16,7 @@
 */
 
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "gth/default.h"
 #include "gth/gthdef.h"
@@ -124,6 +125,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optcomments = NULL,             /* output */
          *optxmlout = NULL,               /* output */
          *optgff3out = NULL,              /* output */
+         *optbinaryout = NULL,            /* output */
          *optgff3descranges = NULL,       /* output */
          *optmd5ids = NULL,               /* output */
          *optskipalignmentout = NULL,     /* output */
@@ -168,6 +170,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optintroncutout = NULL,         /* sim. filter, after gl. chaining */
          *optfastdp = NULL,               /* sim. filter, after gl. chaining */
          *optautointroncutout = NULL,     /* sim. filter, after gl. chaining */
+         *optdpcheckpoints = NULL,        /* sim. filter, after gl. chaining */
          *opticinitialdelta = NULL,       /* sim. filter, after gl. chaining */
          *opticiterations = NULL,         /* sim. filter, after gl. chaining */
          *opticdeltaincrease = NULL,      /* sim. filter, after gl. chaining */
@@ -208,6 +211,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optminaveragessp = NULL,        /* advanced similarity filter */
          *optduplicatecheck= NULL,        /* advanced similarity filter */
          *optintermediate = NULL,         /* stop after SA computation */
+         *optsacollection = NULL,         /* incremental consensus */
          *optsortags = NULL,              /* postproc. of PGLs, sorting of
                                              AGSs */
          *optsortagswf = NULL,            /* postproc. of PGLs, sorting of
@@ -221,6 +225,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optrefseqcovdistri = NULL,      /* statistics */
          *optmatchnumdistri = NULL,       /* statistics */
          *optfirstalshown = NULL,         /* miscellaneous */
+         *optjobs = NULL,                 /* miscellaneous */
          *optshoweops = NULL;             /* testing */
   GtOPrval oprval;
 
@@ -404,6 +409,13 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
                                &call_info->out->gff3out, false);
   gt_option_parser_add_option(op, optgff3out);
 
+  /* -binaryout */
+  optbinaryout = gt_option_new_bool("binaryout", "show intermediate output in "
+                                    "compact binary format (faster to write "
+                                    "and to read than XML)",
+                                    &call_info->out->binaryout, false);
+  gt_option_parser_add_option(op, optbinaryout);
+
   /* -gff3descrange */
   optgff3descranges = gt_option_new_bool("gff3descranges", "use description "
                                          "ranges to offset GFF3 output",
@@ -790,6 +802,22 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optautointroncutout);
   }
 
+  /* -dpcheckpoints */
+  if (!gthconsensus_parsing) {
+    optdpcheckpoints = gt_option_new_bool("dpcheckpoints", "if the backtrace "
+                                          "matrix of a cDNA/EST DP does not "
+                                          "fit into memory (or into the size "
+                                          "given by -autointroncutout), only "
+                                          "store checkpoints and recompute the "
+                                          "matrix piecewise during "
+                                          "backtracing",
+                                          &call_info->dp_options_core
+                                          ->dpcheckpoints,
+                                          GTH_DEFAULT_DPCHECKPOINTS);
+    gt_option_is_extended_option(optdpcheckpoints);
+    gt_option_parser_add_option(op, optdpcheckpoints);
+  }
+
   /* -icinitialdelta */
   if (!gthconsensus_parsing) {
     opticinitialdelta = gt_option_new_uint(ICINITIALDELTA_OPT_CSTR, "set the "
@@ -1173,13 +1201,27 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
   /* -intermediate */
   optintermediate = gt_option_new_bool("intermediate", "stop after calculation "
                                        "of spliced alignments and output "
-                                       "results in reusable XML format. Do not "
-                                       "process this output yourself, use the "
+                                       "results in reusable XML (or binary) "
+                                       "format. Do not process this output "
+                                       "yourself, use the "
                                        "``normal'' XML output instead!",
                                        &call_info->intermediate,
                                        GTH_DEFAULT_INTERMEDIATE);
   gt_option_parser_add_option(op, optintermediate);
 
+  /* -sacollection */
+  if (gthconsensus_parsing) {
+    optsacollection = gt_option_new_filename("sacollection", "load the "
+                                             "spliced alignment collection "
+                                             "from file (if it exists), add "
+                                             "the spliced alignments of the "
+                                             "given files, and store the "
+                                             "updated collection in file (in "
+                                             "binary intermediate format)",
+                                             call_info->sacollectionfile);
+    gt_option_parser_add_option(op, optsacollection);
+  }
+
   /* -sortags */
   optsortags = gt_option_new_bool("sortags", "sort alternative gene structures "
                                   "according to the weighted mean of the "
@@ -1260,6 +1302,14 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optfirstalshown);
   }
 
+  /* -j */
+  optjobs = gt_option_new_uint_min("j", "set the number of threads used to "
+                                   "compute the spliced alignments of the "
+                                   "chains and to assemble the PGLs",
+                                   &call_info->threads, gt_jobs, 1);
+  gt_option_is_extended_option(optjobs);
+  gt_option_parser_add_option(op, optjobs);
+
   /* -showeops */
   if (!gthconsensus_parsing) {
     optshoweops = gt_option_new_bool("showeops", "show complete array of multi "
@@ -1316,6 +1366,10 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_exclude(optskipalignmentout, optintermediate);
   if (optxmlout && optgff3out)
     gt_option_exclude(optxmlout, optgff3out);
+  if (optxmlout && optbinaryout)
+    gt_option_exclude(optxmlout, optbinaryout);
+  if (optgff3out && optbinaryout)
+    gt_option_exclude(optgff3out, optbinaryout);
 
   /* option implications (single) */
   if (opttopos && optfrompos)
@@ -1328,6 +1382,8 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_imply(optsortagswf, optsortags);
   gt_option_imply(optgff3descranges, optgff3out);
   gt_option_imply(optmd5ids, optgff3out);
+  if (optbinaryout && optintermediate)
+    gt_option_imply(optbinaryout, optintermediate);
   if (optbtmatrixgenrange && optbtmatrixrefrange) {
     gt_option_imply(optbtmatrixgenrange, optbtmatrixrefrange);
     gt_option_imply(optbtmatrixrefrange, optbtmatrixrefrange);
@@ -1352,8 +1408,9 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_imply_either_2(opticminremlength, optintroncutout,
                           optautointroncutout);
   }
-  if (optintermediate && optxmlout && optgff3out) {
-    gt_option_imply_either_2(optintermediate, optxmlout, optgff3out);
+  if (optintermediate && optxmlout && optgff3out && optbinaryout) {
+    gt_option_imply_either_3(optintermediate, optxmlout, optgff3out,
+                             optbinaryout);
   }
 
   /* set mail addresse */
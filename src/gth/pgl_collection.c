@@ -15,7 +15,10 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/ensure.h"
+#include "core/ma.h"
 #include "core/parseutils.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/consensus_sa.h"
@@ -122,13 +125,95 @@ void assemble_cluster(GthPGL *pgl, bool disableclustersas)
   gt_array_add(pgl->saclusters, sacluster);
 }
 
+static void assemble_pgl(GthPGL *pgl, bool disableclustersas)
+{
+  /* sort the spliced alignments */
+  qsort(gt_array_get_space(pgl->alignments), gt_array_size(pgl->alignments),
+        sizeof (GthSA*), gth_sa_cmp_genomic_actual);
+
+  /* cluster spliced alignments which are equal on the genomic sequence.
+     this way we only have to consider one spliced alignment for each cluster
+     later on */
+  assemble_cluster(pgl, disableclustersas);
+
+  /* call consensus phase */
+  gt_consensus_sa(gt_array_get_space(pgl->saclusters),
+                  gt_array_size(pgl->saclusters),
+                  sizeof (GthSACluster*), pgl_get_genomic_range,
+                  pgl_get_strand, get_exons_func, process_splice_form_func,
+                  pgl);
+}
+
+typedef struct {
+  GtArray *pgls;
+  GtUword *nextpgl;
+  GtMutex *mutex;
+  bool disableclustersas;
+} AssemblePGLsThreadInfo;
+
+static void* assemble_pgls_thread(void *data)
+{
+  AssemblePGLsThreadInfo *threadinfo = data;
+  GtUword pglctr;
+  for (;;) {
+    gt_mutex_lock(threadinfo->mutex);
+    pglctr = (*threadinfo->nextpgl)++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (pglctr >= gt_array_size(threadinfo->pgls))
+      break;
+    assemble_pgl(*(GthPGL**) gt_array_get(threadinfo->pgls, pglctr),
+                 threadinfo->disableclustersas);
+  }
+  return NULL;
+}
+
+/* Each PGL refers to a single genomic sequence and strand and does not share
+   spliced alignments with other PGLs, hence the PGLs can be assembled
+   independently of each other. They are distributed dynamically among the
+   threads, because their sizes vary a lot. */
+static void assemble_pgls_threaded(GtArray *pgls, bool disableclustersas,
+                                   unsigned int threads)
+{
+  AssemblePGLsThreadInfo threadinfo;
+  GtUword nextpgl = 0;
+  GtThread **threadtab;
+  GtError *err;
+  unsigned int t;
+
+  threadinfo.pgls = pgls;
+  threadinfo.nextpgl = &nextpgl;
+  threadinfo.mutex = gt_mutex_new();
+  threadinfo.disableclustersas = disableclustersas;
+  threadtab = gt_calloc(threads, sizeof *threadtab);
+  err = gt_error_new();
+  /* the current thread assembles PGLs as well; if a thread cannot be created,
+     the remaining threads assemble its share */
+  for (t = 1; t < threads; t++) {
+    threadtab[t] = gt_thread_new(assemble_pgls_thread, &threadinfo, err);
+    if (!threadtab[t])
+      gt_error_unset(err);
+  }
+  assemble_pgls_thread(&threadinfo);
+  for (t = 1; t < threads; t++) {
+    if (threadtab[t]) {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threadtab[t]);
+#endif
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(threadtab);
+  gt_mutex_delete(threadinfo.mutex);
+}
+
 GthPGLCollection* gth_pgl_collection_new(GthSACollection *sacollection,
-                                         bool disableclustersas)
+                                         bool disableclustersas,
+                                         unsigned int threads)
 {
   GthPGLCollection *pgl_collection;
-  GthPGL *pgl;
   GtUword i;
-  gt_assert(sacollection);
+  gt_assert(sacollection && threads);
 
   /* init */
   pgl_collection = gt_malloc(sizeof *pgl_collection);
@@ -138,23 +223,16 @@ GthPGLCollection* gth_pgl_collection_new(GthSACollection *sacollection,
   gthclusterSAstoPGLs(pgl_collection->pgls, sacollection);
 
   /* assemble (clustered) alignments */
-  for (i = 0; i < gt_array_size(pgl_collection->pgls); i++) {
-    pgl = *(GthPGL**) gt_array_get(pgl_collection->pgls, i);
-    /* sort the spliced alignments */
-    qsort(gt_array_get_space(pgl->alignments), gt_array_size(pgl->alignments),
-          sizeof (GthSA*), gth_sa_cmp_genomic_actual);
-
-    /* cluster spliced alignments which are equal on the genomic sequence.
-       this way we only have to consider one spliced alignment for each cluster
-       later on */
-    assemble_cluster(pgl, disableclustersas);
-
-    /* call consensus phase */
-    gt_consensus_sa(gt_array_get_space(pgl->saclusters),
-                    gt_array_size(pgl->saclusters),
-                    sizeof (GthSACluster*), pgl_get_genomic_range,
-                    pgl_get_strand, get_exons_func, process_splice_form_func,
-                    pgl);
+  if (threads > 1 && gt_array_size(pgl_collection->pgls) > 1) {
+    if (threads > gt_array_size(pgl_collection->pgls))
+      threads = (unsigned int) gt_array_size(pgl_collection->pgls);
+    assemble_pgls_threaded(pgl_collection->pgls, disableclustersas, threads);
+  }
+  else {
+    for (i = 0; i < gt_array_size(pgl_collection->pgls); i++) {
+      assemble_pgl(*(GthPGL**) gt_array_get(pgl_collection->pgls, i),
+                   disableclustersas);
+    }
   }
 
   return pgl_collection;
@@ -239,3 +317,138 @@ void gth_pgl_collection_traverse(const GthPGLCollection *pgl_collection,
   }
   gth_pgl_visitor_trailer(pgl_visitor);
 }
+
+static GthSA* pgl_collection_test_sa(const GtUword *exons, GtUword num_of_exons,
+                                     GtUword offset, bool forward,
+                                     GtUword ref_seq_num)
+{
+  Exoninfo exoninfo;
+  Introninfo introninfo;
+  char ref_id[32];
+  GthSA *sa;
+  GtUword i;
+
+  sa = gth_sa_new();
+  gth_sa_set(sa, DNA_ALPHA, offset + exons[0],
+             exons[2 * num_of_exons - 1] - exons[0] + 1);
+  (void) snprintf(ref_id, sizeof ref_id, "ref"GT_WU, ref_seq_num);
+  gth_sa_set_gen_id(sa, "gen");
+  gth_sa_set_ref_id(sa, ref_id);
+  gth_sa_set_gen_file_num(sa, 0);
+  gth_sa_set_gen_seq_num(sa, 0);
+  gth_sa_set_ref_file_num(sa, 0);
+  gth_sa_set_ref_seq_num(sa, ref_seq_num);
+  gth_sa_set_gen_strand(sa, forward);
+  gth_sa_set_ref_strand(sa, true);
+  gth_sa_set_gen_offset(sa, 0);
+  gth_sa_set_gen_total_length(sa, 10000);
+  for (i = 0; i < num_of_exons; i++) {
+    exoninfo.leftgenomicexonborder = offset + exons[2 * i];
+    exoninfo.rightgenomicexonborder = offset + exons[2 * i + 1];
+    exoninfo.leftreferenceexonborder = 0;
+    exoninfo.rightreferenceexonborder = 0;
+    exoninfo.exonscore = 0.5 + (GthDbl) ((ref_seq_num + i) % 5) / 10.0;
+    gth_sa_add_exon(sa, &exoninfo);
+    if (i) {
+      introninfo.donorsiteprobability = (GthFlt) 0.8;
+      introninfo.acceptorsiteprobability = (GthFlt) 0.9;
+      introninfo.donorsitescore = 0.7;
+      introninfo.acceptorsitescore = 0.6;
+      gth_sa_add_intron(sa, &introninfo);
+    }
+  }
+  gth_sa_set_score(sa, (GthFlt) 0.9);
+  gth_sa_set_coverage(sa, (GthFlt) 0.9);
+  return sa;
+}
+
+static bool pgl_collections_are_equal(const GthPGLCollection *pgl_collection_a,
+                                      const GthPGLCollection *pgl_collection_b)
+{
+  GtUword i, j, k;
+  if (gth_pgl_collection_size(pgl_collection_a) !=
+      gth_pgl_collection_size(pgl_collection_b)) {
+    return false;
+  }
+  for (i = 0; i < gth_pgl_collection_size(pgl_collection_a); i++) {
+    GthPGL *pgl_a = gth_pgl_collection_get(pgl_collection_a, i),
+           *pgl_b = gth_pgl_collection_get(pgl_collection_b, i);
+    if (gt_range_compare(&pgl_a->maxrange, &pgl_b->maxrange) ||
+        gth_pgl_is_forward(pgl_a) != gth_pgl_is_forward(pgl_b) ||
+        gth_pgl_num_of_ags(pgl_a) != gth_pgl_num_of_ags(pgl_b)) {
+      return false;
+    }
+    for (j = 0; j < gth_pgl_num_of_ags(pgl_a); j++) {
+      GthAGS *ags_a = gth_pgl_get_ags(pgl_a, j),
+             *ags_b = gth_pgl_get_ags(pgl_b, j);
+      if (gth_ags_num_of_exons(ags_a) != gth_ags_num_of_exons(ags_b) ||
+          gt_array_size(ags_a->alignments) !=
+          gt_array_size(ags_b->alignments)) {
+        return false;
+      }
+      for (k = 0; k < gth_ags_num_of_exons(ags_a); k++) {
+        GthExonAGS *exon_a = gth_ags_get_exon(ags_a, k),
+                   *exon_b = gth_ags_get_exon(ags_b, k);
+        if (gt_range_compare(&exon_a->range, &exon_b->range) ||
+            exon_a->score != exon_b->score) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+int gth_pgl_collection_unit_test(GtError *err)
+{
+  /* exon borders of the spliced alignments of a single locus: a three exon
+     alignment, one with an alternative acceptor site, a duplicate of the
+     first one (which is clustered with it), and one skipping the middle
+     exon */
+  static const GtUword exons_a[] = { 10, 99, 200, 299, 400, 499 },
+                       exons_b[] = { 10, 99, 250, 299, 400, 520 },
+                       exons_c[] = { 50, 99, 400, 499 };
+  GthPGLCollection *sequential, *threaded;
+  GthSACollection *sa_collection;
+  GtUword locus, ref_seq_num = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+
+  sa_collection = gth_sa_collection_new(GTH_DC_NONE);
+  for (locus = 0; locus < 8; locus++) {
+    /* every other locus is on the reverse strand, the PGLs of both strands
+       are assembled independently */
+    GtUword offset = (locus / 2) * 1000;
+    bool forward = locus % 2 == 0;
+    gth_sa_collection_insert_sa(sa_collection,
+                                pgl_collection_test_sa(exons_a, 3, offset,
+                                                       forward, ref_seq_num++),
+                                NULL, NULL);
+    gth_sa_collection_insert_sa(sa_collection,
+                                pgl_collection_test_sa(exons_b, 3, offset,
+                                                       forward, ref_seq_num++),
+                                NULL, NULL);
+    gth_sa_collection_insert_sa(sa_collection,
+                                pgl_collection_test_sa(exons_a, 3, offset,
+                                                       forward, ref_seq_num++),
+                                NULL, NULL);
+    gth_sa_collection_insert_sa(sa_collection,
+                                pgl_collection_test_sa(exons_c, 2, offset,
+                                                       forward, ref_seq_num++),
+                                NULL, NULL);
+  }
+
+  /* the assembly must not depend on the number of threads */
+  sequential = gth_pgl_collection_new(sa_collection, false, 1);
+  threaded = gth_pgl_collection_new(sa_collection, false, 4);
+  gt_ensure(gth_pgl_collection_size(sequential) == 8);
+  gt_ensure(gth_pgl_num_of_ags(gth_pgl_collection_get(sequential, 0)) > 1);
+  gt_ensure(pgl_collections_are_equal(sequential, threaded));
+  gth_pgl_collection_delete(threaded);
+  gth_pgl_collection_delete(sequential);
+
+  gth_sa_collection_delete(sa_collection);
+
+  return had_err;
+}
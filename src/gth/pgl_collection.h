@@ -25,8 +25,11 @@
 
 typedef struct GthPGLCollection GthPGLCollection;
 
+/* Computes the PGLs of the spliced alignments in the given collection, the
+   PGLs are assembled with <threads> threads. */
 GthPGLCollection* gth_pgl_collection_new(GthSACollection*,
-                                         bool disableclustersas);
+                                         bool disableclustersas,
+                                         unsigned int threads);
 void              gth_pgl_collection_delete(GthPGLCollection*);
 /* Sort the alternative gene structures (AGSs) in <pgl_collection> according to
    weight factor <sortagswf>. */
@@ -40,5 +43,6 @@ GtUword     gth_pgl_collection_size(const GthPGLCollection*);
 void              gth_pgl_collection_traverse(const GthPGLCollection*,
                                               GthPGLVisitor*, GthInput*,
                                               bool use_desc_ranges);
+int               gth_pgl_collection_unit_test(GtError*);
 
 #endif
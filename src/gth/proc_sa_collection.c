@@ -16,6 +16,7 @@
 */
 
 #include "core/undef_api.h"
+#include "gth/binary_inter_sa_visitor.h"
 #include "gth/proc_sa_collection.h"
 #include "gth/gthsadistri.h"
 #include "gth/pgl_collection.h"
@@ -53,7 +54,12 @@ void gth_proc_sa_collection(GthSACollection *sa_collection,
   /* output alignments */
   if (!call_info->out->skipalignmentout) {
     GthSAVisitor *sa_visitor;
-    if (call_info->out->xmlout) {
+    if (call_info->out->binaryout) {
+      gt_assert(call_info->intermediate);
+      sa_visitor = gth_binary_inter_sa_visitor_new(input,
+                                                   call_info->out->outfp);
+    }
+    else if (call_info->out->xmlout) {
       if (call_info->intermediate) {
         sa_visitor = gth_xml_inter_sa_visitor_new(input, indentlevel + 1,
                                                   call_info->out->outfp);
@@ -95,7 +101,8 @@ void gth_proc_sa_collection(GthSACollection *sa_collection,
 
     /* compute PGLs */
     pgl_collection = gth_pgl_collection_new(sa_collection,
-                                            call_info->disableclustersas);
+                                            call_info->disableclustersas,
+                                            call_info->threads);
     if (call_info->out->sortags)
       gth_pgl_collection_sortAGSs(pgl_collection, call_info->out->sortagswf);
 
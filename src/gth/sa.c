@@ -986,6 +986,12 @@ GtUword gth_sa_call_number(const GthSA *sa)
   return sa->call_number;
 }
 
+void gth_sa_set_call_number(GthSA *sa, GtUword call_number)
+{
+  gt_assert(sa);
+  sa->call_number = call_number;
+}
+
 static void set_gff3_target_attribute(GthSA *sa, bool md5ids)
 {
   gt_assert(sa && !sa->gff3_target_attribute);
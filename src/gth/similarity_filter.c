@@ -15,6 +15,11 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -24,6 +29,7 @@
 #include "gth/gthxml.h"
 #include "gth/intermediate.h"
 #include "gth/proc_sa_collection.h"
+#include "gth/seq_con_rep.h"
 #include "gth/similarity_filter.h"
 
 #define UNSUCCESSFULALIGNMENTSCORE      0.0
@@ -355,106 +361,128 @@ static bool isunsuccessfulalignment(GthSA *sa,
   return false;
 }
 
-static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
-                       GthInput *input, GthStat *stat,
-                       GthSACollection *sa_collection, GthSA *saA,
-                       GtUword gen_file_num,
-                       GtUword ref_file_num,
-                       GtUword gen_total_length,
-                       GtUword gen_offset,
-                       const GtRange *gen_seq_bounds,
-                       const GtRange *gen_seq_bounds_rc,
-                       GtUword ref_total_length, GtUword ref_offset,
-                       GtUword chainctr,
-                       GtUword num_of_chains, GthMatchInfo *match_info,
-                       const unsigned char *ref_seq_tran,
-                       const unsigned char *ref_seq_orig,
-                       const unsigned char *ref_seq_tran_rc,
-                       const unsigned char *ref_seq_orig_rc,
-                       GthChain *chain,
-                       GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
-                       GthProteinCompletePathMatrixJT
-                       protein_complete_path_matrix_jt)
+/* the outcome of the DNA DP for a single chain, which determines how the
+   computed spliced alignments are processed */
+typedef enum {
+  DNA_DP_DISCARD,             /* discard saA */
+  DNA_DP_DISCARD_SIGNIFICANT, /* discard saA, but mark match as significant */
+  DNA_DP_SAVE_A,              /* save saA, discard saB */
+  DNA_DP_SAVE_B               /* save saB, discard saA */
+} DNADPOutcome;
+
+/* bundles the data necessary to compute the DNA DP for a single chain */
+typedef struct {
+  GthChain *chain;
+  GthSA *saA,
+        *saB; /* only allocated if the second strand has to be considered,
+                 in advance for the threaded computation */
+  GtUword chainctr,
+          call_number,
+          gen_total_length,
+          gen_offset,
+          ref_total_length,
+          ref_offset;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc;
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  DNADPOutcome outcome;
+  int rval;
+} ChainDP;
+
+/* computes the DNA DP for <dp> without modifying the spliced alignment
+   collection or the match info, that is, it can be called for different
+   chains in parallel (given that <stat> and <out> are not shared). */
+static int compute_dna_DP(ChainDP *dp, bool directmatches,
+                          GthCallInfo *call_info, GthInput *input,
+                          GthStat *stat, GthOutput *out,
+                          GtUword gen_file_num, GtUword ref_file_num,
+                          GtUword num_of_chains,
+                          GthDNACompletePathMatrixJT
+                          dna_complete_path_matrix_jt,
+                          GthProteinCompletePathMatrixJT
+                          protein_complete_path_matrix_jt)
 {
   int rval;
-  bool bothstrandsanalyzed, firstdp = true,
-       GT_UNUSED gs2outdirectmatches = directmatches;
-  GthSA *saB = NULL;
-  GtFile *outfp = call_info->out->outfp;
+  bool firstdp = true;
+
+  dp->outcome = DNA_DP_SAVE_A;
 
   if (directmatches ? gth_input_forward(input)
                     : gth_input_reverse(input)) {
     /* calculate alignment */
-    rval = callsahmt(true, saA, directmatches, gen_file_num, ref_file_num,
-                     chain, gen_total_length, gen_offset, gen_seq_bounds,
-                     gen_seq_bounds_rc,
-                     ref_seq_tran, ref_seq_orig, ref_total_length, ref_offset,
-                     input, &call_info->simfilterparam.introncutoutinfo, stat,
-                     chainctr, num_of_chains, call_info->translationtable,
+    rval = callsahmt(true, dp->saA, directmatches, gen_file_num, ref_file_num,
+                     dp->chain, dp->gen_total_length, dp->gen_offset,
+                     &dp->gen_seq_bounds, &dp->gen_seq_bounds_rc,
+                     dp->ref_seq_tran, dp->ref_seq_orig, dp->ref_total_length,
+                     dp->ref_offset, input,
+                     &call_info->simfilterparam.introncutoutinfo, stat,
+                     dp->chainctr, num_of_chains, call_info->translationtable,
                      directmatches, call_info->proteinexonpenal,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
                      dna_complete_path_matrix_jt,
-                     protein_complete_path_matrix_jt, call_info->out);
+                     protein_complete_path_matrix_jt, out);
     if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                      /* ^ this error is treated below */
       return rval;
     }
 
     firstdp = false;
-    bothstrandsanalyzed = gth_input_both(input);
 
     if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-        isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-      match_info->call_number--;
+        isunsuccessfulalignment(dp->saA, out->comments, out->outfp)) {
       /* if the spliced alignment was unsuccessful, it is deleted and the
          next hit is considered. */
-      gth_sa_delete(saA);
+      dp->outcome = DNA_DP_DISCARD;
       return 0; /* continue */
     }
 
     /* if not both strands are analyzed, we can save this alignment now.
        Otherwise we have to calculate the alignment to the other strand
        first and then save the better one. */
-    if (!bothstrandsanalyzed)
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+    if (!gth_input_both(input))
+      return 0;
   }
 
   if (directmatches ? gth_input_reverse(input)
                     : gth_input_forward(input)) {
-    if ((firstdp || gth_sa_is_poor(saA, call_info->minaveragessp)) &&
+    if ((firstdp || gth_sa_is_poor(dp->saA, call_info->minaveragessp)) &&
         !call_info->cdnaforward) {
       if (firstdp) {
         /* space for first alignment is already allocated, but we have to
            change the direction of the genomic and the reference strand */
-        gth_sa_set_gen_strand(saA, !directmatches);
-        gth_sa_set_ref_strand(saA, false);
+        gth_sa_set_gen_strand(dp->saA, !directmatches);
+        gth_sa_set_ref_strand(dp->saA, false);
       }
-      else {
-        /* allocating space for second alignment */
-        saB = gth_sa_new_and_set(!directmatches, false, input,
-                                 chain->gen_file_num, chain->gen_seq_num,
-                                 chain->ref_file_num, chain->ref_seq_num,
-                                 match_info->call_number, gen_total_length,
-                                 gen_offset, ref_total_length);
+      else if (!dp->saB) {
+        /* allocating space for second alignment (in the threaded computation
+           this has been done in advance, because it accesses <input>) */
+        dp->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                     dp->chain->gen_file_num,
+                                     dp->chain->gen_seq_num,
+                                     dp->chain->ref_file_num,
+                                     dp->chain->ref_seq_num, dp->call_number,
+                                     dp->gen_total_length, dp->gen_offset,
+                                     dp->ref_total_length);
       }
 
-      /* setting gs2outdirectmatches (for compatibility) */
-      gs2outdirectmatches = (bool) !directmatches;
-
       /* calculate alignment */
-      rval = callsahmt(true, firstdp ? saA : saB, !directmatches,
-                       gen_file_num, ref_file_num, chain, gen_total_length,
-                       gen_offset, gen_seq_bounds, gen_seq_bounds_rc,
-                       ref_seq_tran_rc, ref_seq_orig_rc, ref_total_length,
-                       ref_offset, input,
+      rval = callsahmt(true, firstdp ? dp->saA : dp->saB, !directmatches,
+                       gen_file_num, ref_file_num, dp->chain,
+                       dp->gen_total_length, dp->gen_offset,
+                       &dp->gen_seq_bounds, &dp->gen_seq_bounds_rc,
+                       dp->ref_seq_tran_rc, dp->ref_seq_orig_rc,
+                       dp->ref_total_length, dp->ref_offset, input,
                        &call_info->simfilterparam.introncutoutinfo, stat,
-                       chainctr, num_of_chains, call_info->translationtable,
+                       dp->chainctr, num_of_chains, call_info->translationtable,
                        directmatches, call_info->proteinexonpenal,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
                        dna_complete_path_matrix_jt,
-                       protein_complete_path_matrix_jt, call_info->out);
+                       protein_complete_path_matrix_jt, out);
       if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                        /* ^ this error is treated below */
         return rval;
@@ -462,44 +490,54 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
       if (firstdp) {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
+            isunsuccessfulalignment(dp->saA, out->comments, out->outfp)) {
           /* for compatibility with GS2 */
           /* XXX: makes no sense. Possibly only if -gs2out is used. */
-          match_info->significant_match_found= true;
-
-          /* if the spliced alignment was unsuccessful, it is deleted and
-             the next hit is considered. */
-          gth_sa_delete(saA);
-          return 0; /* continue */
+          dp->outcome = DNA_DP_DISCARD_SIGNIFICANT;
         }
-
-        save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
       }
       else /* !firstdp */
       {
-        if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saB, call_info->out->comments, outfp) ||
-            !gth_sa_B_is_better_than_A(saA, saB)) {
-          /* insert first SA */
-          save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-          /* discard second SA */
-          gth_sa_delete(saB);
-        }
-        else {
-          /* insert second SA */
-          save_sa(sa_collection, saB, call_info->sa_filter, match_info, stat);
-          /* free first SA */
-          gth_sa_delete(saA);
+        if (rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED &&
+            !isunsuccessfulalignment(dp->saB, out->comments, out->outfp) &&
+            gth_sa_B_is_better_than_A(dp->saA, dp->saB)) {
+          dp->outcome = DNA_DP_SAVE_B;
         }
       }
     }
-    else
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
   }
 
   return 0;
 }
 
+/* processes the spliced alignments computed by compute_dna_DP() for <dp>
+   according to its outcome */
+static void save_dna_DP(ChainDP *dp, GthSACollection *sa_collection,
+                        GthSAFilter *sa_filter, GthMatchInfo *match_info,
+                        GthStat *stat)
+{
+  switch (dp->outcome) {
+    case DNA_DP_DISCARD:
+      match_info->call_number--;
+      gth_sa_delete(dp->saA);
+      break;
+    case DNA_DP_DISCARD_SIGNIFICANT:
+      match_info->significant_match_found = true;
+      gth_sa_delete(dp->saA);
+      break;
+    case DNA_DP_SAVE_A:
+      save_sa(sa_collection, dp->saA, sa_filter, match_info, stat);
+      break;
+    case DNA_DP_SAVE_B:
+      save_sa(sa_collection, dp->saB, sa_filter, match_info, stat);
+      gth_sa_delete(dp->saA);
+      dp->saB = NULL;
+      break;
+  }
+  gth_sa_delete(dp->saB);
+  dp->saA = dp->saB = NULL;
+}
+
 static int call_protein_DP(bool directmatches,
                            GthCallInfo *call_info,
                            GthInput *input,
@@ -615,7 +653,8 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
 
   if (!gth_chain_collection_size(chain_collection)) {
     /* no matches found -> return */
-    if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
+    if (!call_info->out->xmlout && !call_info->out->gff3out &&
+        !call_info->out->binaryout && !directmatches &&
         !match_info->significant_match_found) {
       show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
     }
@@ -626,6 +665,270 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
   return chain_collection;
 }
 
+/* sets up <dp> for the given <chain>, that is, determines the considered
+   genomic and reference regions, allocates the spliced alignment (and the one
+   for the second strand, if <alloc_saB> is set), and extends the DP borders
+   of <chain> */
+static void prepare_chain_DP(ChainDP *dp, GthChain *chain, GtUword chainctr,
+                             bool directmatches, bool refseqisdna,
+                             bool alloc_saB, GthInput *input,
+                             GtUword call_number)
+{
+  GtRange range;
+
+  dp->chain = chain;
+  dp->chainctr = chainctr;
+  dp->call_number = call_number;
+  dp->saB = NULL;
+  dp->ref_seq_tran_rc = NULL;
+  dp->ref_seq_orig_rc = NULL;
+  dp->rval = 0;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    dp->gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
+                                                     chain->gen_seq_num);
+    dp->gen_total_length  = gt_range_length(&dp->gen_seq_bounds);
+    dp->gen_offset        = dp->gen_seq_bounds.start;
+    dp->gen_seq_bounds_rc = dp->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    dp->gen_total_length = gth_input_genomic_file_total_length(input,
+                                                               chain
+                                                               ->gen_file_num);
+    dp->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    dp->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    dp->gen_offset              = 0;
+    dp->gen_seq_bounds_rc.start = dp->gen_total_length - 1
+                                  - dp->gen_seq_bounds.end;
+    dp->gen_seq_bounds_rc.end   = dp->gen_total_length - 1
+                                  - dp->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                        chain->ref_seq_num);
+  dp->ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
+  dp->ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
+  if (refseqisdna) {
+    dp->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input)
+                          + range.start;
+    dp->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input)
+                          + range.start;
+  }
+  dp->ref_total_length = range.end - range.start + 1;
+  dp->ref_offset = range.start;
+
+  /* allocating space for alignment */
+  dp->saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
+                               chain->gen_seq_num, chain->ref_file_num,
+                               chain->ref_seq_num, call_number,
+                               dp->gen_total_length, dp->gen_offset,
+                               dp->ref_total_length);
+
+  /* allocating space for the alignment to the other strand, if necessary */
+  if (alloc_saB) {
+    dp->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                 chain->gen_file_num, chain->gen_seq_num,
+                                 chain->ref_file_num, chain->ref_seq_num,
+                                 call_number, dp->gen_total_length,
+                                 dp->gen_offset, dp->ref_total_length);
+  }
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &dp->gen_seq_bounds, &dp->gen_seq_bounds_rc,
+                           dp->gen_total_length, dp->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+/* handles the error code <rval> returned by the DP for <dp>. Returns -1 for
+   fatal errors, 0 otherwise. */
+static int process_chain_DP_error(ChainDP *dp, int rval,
+                                  GthMatchInfo *match_info, GthStat *stat)
+{
+  gt_assert(rval);
+  gth_sa_delete(dp->saA);
+  gth_sa_delete(dp->saB);
+  dp->saA = dp->saB = NULL;
+  if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    match_info->call_number--;
+    return 0; /* continue with the next DP range */
+  }
+  return -1;
+}
+
+#ifdef GT_THREADS_ENABLED
+
+typedef struct {
+  ChainDP *dps;
+  GtUword num_of_chains,
+          *nextchain,
+          gen_file_num,
+          ref_file_num;
+  GtMutex *mutex;
+  bool directmatches;
+  GthCallInfo *call_info;
+  GthInput *input;
+  GthStat *stat;  /* private statistics of the thread */
+  GthOutput out;  /* private copy without verbose output */
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+} DNADPThreadInfo;
+
+static void* compute_dna_DP_thread(void *data)
+{
+  DNADPThreadInfo *threadinfo = data;
+  GtUword chainctr;
+
+  for (;;) {
+    /* fetch the next chain, the DP matrices are allocated in
+       gth_align_dna() and are therefore private to this thread */
+    gt_mutex_lock(threadinfo->mutex);
+    chainctr = (*threadinfo->nextchain)++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (chainctr >= threadinfo->num_of_chains)
+      break;
+    threadinfo->dps[chainctr].rval =
+      compute_dna_DP(threadinfo->dps + chainctr, threadinfo->directmatches,
+                     threadinfo->call_info, threadinfo->input,
+                     threadinfo->stat, &threadinfo->out,
+                     threadinfo->gen_file_num, threadinfo->ref_file_num,
+                     threadinfo->num_of_chains,
+                     threadinfo->dna_complete_path_matrix_jt,
+                     threadinfo->protein_complete_path_matrix_jt);
+  }
+  return NULL;
+}
+
+/* Computes the DNA spliced alignments for all chains in <chain_collection>
+   with <call_info->threads> threads. The resulting spliced alignments are
+   inserted into <sa_collection> in the order of the chains, hence the result
+   is the same as for the sequential computation. */
+static int calc_dna_spliced_alignments_threaded(GthSACollection *sa_collection,
+                                                GthChainCollection
+                                                *chain_collection,
+                                                GthCallInfo *call_info,
+                                                GthInput *input,
+                                                GthStat *stat,
+                                                GtUword gen_file_num,
+                                                GtUword ref_file_num,
+                                                bool directmatches,
+                                                GthMatchInfo *match_info,
+                                                GthDNACompletePathMatrixJT
+                                                dna_complete_path_matrix_jt,
+                                                GthProteinCompletePathMatrixJT
+                                                protein_complete_path_matrix_jt)
+{
+  GtUword chainctr, nextchain = 0,
+          num_of_chains = gth_chain_collection_size(chain_collection);
+  unsigned int t, threads = call_info->threads;
+  DNADPThreadInfo *threadinfo;
+  GtThread **threadtab;
+  GtMutex *mutex;
+  ChainDP *dps;
+  GtError *err;
+  int had_err = 0;
+
+  if (threads > num_of_chains)
+    threads = (unsigned int) num_of_chains;
+
+  if (call_info->out->showverbose) {
+    char buf[SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE];
+    GT_UNUSED int rval;
+    rval = snprintf(buf, SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE,
+                    "compute spliced alignments of " GT_WU " chains with %u "
+                    "threads", num_of_chains, threads);
+    gt_assert(rval < SHOW_MATRIX_CALCULATION_STATUS_BUF_SIZE);
+    call_info->out->showverbose(buf);
+  }
+
+  /* the preparation is done sequentially, because it accesses <input> */
+  dps = gt_malloc(sizeof *dps * num_of_chains);
+  for (chainctr = 0; chainctr < num_of_chains; chainctr++) {
+    prepare_chain_DP(dps + chainctr,
+                     gth_chain_collection_get(chain_collection, chainctr),
+                     chainctr, directmatches, true,
+                     gth_input_both(input) && !call_info->cdnaforward, input,
+                     GT_UNDEF_UWORD);
+  }
+
+  mutex = gt_mutex_new();
+  threadinfo = gt_malloc(sizeof *threadinfo * threads);
+  threadtab = gt_calloc(threads, sizeof *threadtab);
+  err = gt_error_new();
+  for (t = 0; t < threads; t++) {
+    threadinfo[t].dps = dps;
+    threadinfo[t].num_of_chains = num_of_chains;
+    threadinfo[t].nextchain = &nextchain;
+    threadinfo[t].gen_file_num = gen_file_num;
+    threadinfo[t].ref_file_num = ref_file_num;
+    threadinfo[t].mutex = mutex;
+    threadinfo[t].directmatches = directmatches;
+    threadinfo[t].call_info = call_info;
+    threadinfo[t].input = input;
+    threadinfo[t].stat = gth_stat_new();
+    threadinfo[t].out = *call_info->out;
+    threadinfo[t].out.showverbose = NULL;
+    threadinfo[t].dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+    threadinfo[t].protein_complete_path_matrix_jt =
+      protein_complete_path_matrix_jt;
+  }
+  /* the current thread computes chains as well; if a thread cannot be
+     created, the remaining threads compute its share */
+  for (t = 1; t < threads; t++) {
+    threadtab[t] = gt_thread_new(compute_dna_DP_thread, threadinfo + t, err);
+    if (!threadtab[t])
+      gt_error_unset(err);
+  }
+  (void) compute_dna_DP_thread(threadinfo);
+  for (t = 1; t < threads; t++) {
+    if (threadtab[t]) {
+      gt_thread_join(threadtab[t]);
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  for (t = 0; t < threads; t++) {
+    gth_stat_add_counters(stat, threadinfo[t].stat);
+    gth_stat_delete(threadinfo[t].stat);
+  }
+  gt_error_delete(err);
+  gt_free(threadtab);
+  gt_free(threadinfo);
+  gt_mutex_delete(mutex);
+
+  /* process the computed spliced alignments in the order of the chains */
+  for (chainctr = 0; chainctr < num_of_chains; chainctr++) {
+    ChainDP *dp = dps + chainctr;
+    if (had_err) {
+      gth_sa_delete(dp->saA);
+      gth_sa_delete(dp->saB);
+      continue;
+    }
+    match_info->call_number++;
+    gth_sa_set_call_number(dp->saA, match_info->call_number);
+    if (dp->saB)
+      gth_sa_set_call_number(dp->saB, match_info->call_number);
+    if (dp->rval)
+      had_err = process_chain_DP_error(dp, dp->rval, match_info, stat);
+    else {
+      save_dna_DP(dp, sa_collection, call_info->sa_filter, match_info,
+                  stat);
+    }
+  }
+  gt_free(dps);
+
+  return had_err;
+}
+
+#endif
+
 static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthChainCollection *chain_collection,
                                    GthCallInfo *call_info,
@@ -640,34 +943,48 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthProteinCompletePathMatrixJT
                                    protein_complete_path_matrix_jt)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
+  GtUword chainctr;
   GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
   bool refseqisdna;
   GthChain *chain;
-  GtRange range;
-  GthSA *saA;
+  ChainDP dp;
   int rval;
 
   gt_assert(sa_collection && chain_collection);
 
   refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
 
+#ifdef GT_THREADS_ENABLED
+  /* the DNA DPs of the chains are computed in parallel, unless the results
+     of previous chains are needed (-first) or the DP writes to the output */
+  if (call_info->threads > 1 && refseqisdna && !call_info->firstalshown &&
+      !call_info->out->comments && !call_info->out->showeops &&
+      gth_chain_collection_size(chain_collection) > 1) {
+    if (calc_dna_spliced_alignments_threaded(sa_collection, chain_collection,
+                                             call_info, input, stat,
+                                             gen_file_num, ref_file_num,
+                                             directmatches, match_info,
+                                             dna_complete_path_matrix_jt,
+                                             protein_complete_path_matrix_jt)) {
+      return -1;
+    }
+  }
+  else
+#endif
   for (chainctr = 0;
        chainctr < gth_chain_collection_size(chain_collection);
        chainctr++) {
        chain = gth_chain_collection_get(chain_collection, chainctr);
     if (++match_info->call_number > call_info->firstalshown &&
         call_info->firstalshown > 0) {
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
+      if (!(call_info->out->xmlout || call_info->out->gff3out ||
+            call_info->out->binaryout)) {
         gt_file_xfputc('\n', outfp);
+      }
       else if (call_info->out->xmlout)
         gt_file_xprintf(outfp, "<!--\n");
 
-      if (!call_info->out->gff3out) {
+      if (!call_info->out->gff3out && !call_info->out->binaryout) {
         gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
                         refseqisdna ? "EST" : "protein",
                         call_info->firstalshown);
@@ -675,8 +992,10 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                            "displayed.\n", call_info->firstalshown);
       }
 
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
+      if (!(call_info->out->xmlout || call_info->out->gff3out ||
+            call_info->out->binaryout)) {
         gt_file_xfputc('\n', outfp);
+      }
       else if (call_info->out->xmlout)
         gt_file_xprintf(outfp, "-->\n");
 
@@ -684,41 +1003,12 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
       break; /* break out of loop */
     }
 
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
-
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
-    }
-    ref_total_length = range.end - range.start + 1;
+    prepare_chain_DP(&dp, chain, chainctr, directmatches, refseqisdna,
+                     false, input, match_info->call_number);
 
     /* check if protein sequences have a stop amino acid */
     if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
+       dp.ref_seq_orig[dp.ref_total_length - 1] != GT_STOP_AMINO) {
       GtStr *ref_id = gt_str_new();
       gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
                             chain->ref_seq_num);
@@ -734,57 +1024,36 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
       gt_str_delete(ref_id);
     }
 
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
     /* call the Dynamic Programming */
     if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
+      rval = compute_dna_DP(&dp, directmatches, call_info, input, stat,
+                            call_info->out, gen_file_num, ref_file_num,
+                            gth_chain_collection_size(chain_collection),
+                            dna_complete_path_matrix_jt,
+                            protein_complete_path_matrix_jt);
+      if (!rval) {
+        save_dna_DP(&dp, sa_collection, call_info->sa_filter, match_info,
+                    stat);
+      }
     }
     else {
       rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
+                             stat, sa_collection, dp.saA, gen_file_num,
+                             ref_file_num, dp.gen_total_length, dp.gen_offset,
+                             &dp.gen_seq_bounds, &dp.gen_seq_bounds_rc,
+                             dp.ref_total_length, dp.ref_offset, chainctr,
                              gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
+                             match_info, dp.ref_seq_tran, dp.ref_seq_orig,
+                             chain, dna_complete_path_matrix_jt,
                              protein_complete_path_matrix_jt);
     }
     /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
-    }
-    else if (rval)
+    if (rval && process_chain_DP_error(&dp, rval, match_info, stat))
       return -1;
   }
 
-  if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
+  if (!call_info->out->xmlout && !call_info->out->gff3out &&
+      !call_info->out->binaryout && !directmatches &&
       !match_info->significant_match_found &&
       match_info->call_number <= call_info->firstalshown) {
     show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
@@ -928,7 +1197,7 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
   }
 
   /* output statistics */
-  if (!call_info->out->gff3out)
+  if (!call_info->out->gff3out && !call_info->out->binaryout)
     gth_stat_show(stat, true, call_info->out->xmlout, call_info->out->outfp);
 
 #ifndef NDEBUG
@@ -945,3 +1214,327 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
 
   return 0;
 }
+
+#define SIMFILTER_TEST_GENE_LENGTH  3000
+#define SIMFILTER_TEST_NUM_OF_GENES 4
+#define SIMFILTER_TEST_GEN_FILE     "similarity_filter_test_gen"
+#define SIMFILTER_TEST_REF_FILE     "similarity_filter_test_ref"
+
+static const GtRange simfilter_test_exons[] = { { 100, 499 }, { 900, 1299 },
+                                                { 2000, 2399 } };
+
+/* a sequence container which holds a single DNA sequence in memory, it is
+   used by the unit test instead of an indexed sequence file */
+typedef struct {
+  GthSeqCon parent_instance;
+  GtAlphabet *alphabet;
+  GtUchar *orig_seq,
+          *tran_seq,
+          *orig_seq_rc,
+          *tran_seq_rc;
+  GtUword length;
+  const char *description;
+} SimFilterTestSeqCon;
+
+static const GthSeqConClass* simfilter_test_seq_con_class(void);
+
+#define simfilter_test_seq_con_cast(SC)\
+        gth_seq_con_cast(simfilter_test_seq_con_class(), SC)
+
+static void simfilter_test_seq_con_demand_orig_seq(GT_UNUSED GthSeqCon *sc)
+{
+  /* the original sequence is always present */
+}
+
+static GtUchar* simfilter_test_seq_con_get_orig_seq(GthSeqCon *sc,
+                                                    GT_UNUSED GtUword seq_num)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->orig_seq;
+}
+
+static GtUchar* simfilter_test_seq_con_get_tran_seq(GthSeqCon *sc,
+                                                    GT_UNUSED GtUword seq_num)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->tran_seq;
+}
+
+static GtUchar* simfilter_test_seq_con_get_orig_seq_rc(GthSeqCon *sc,
+                                                       GT_UNUSED GtUword
+                                                       seq_num)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->orig_seq_rc;
+}
+
+static GtUchar* simfilter_test_seq_con_get_tran_seq_rc(GthSeqCon *sc,
+                                                       GT_UNUSED GtUword
+                                                       seq_num)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->tran_seq_rc;
+}
+
+static void simfilter_test_seq_con_get_description(GthSeqCon *sc,
+                                                   GT_UNUSED GtUword seq_num,
+                                                   GtStr *desc)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  gt_str_append_cstr(desc, tsc->description);
+}
+
+static void simfilter_test_seq_con_echo_description(GthSeqCon *sc,
+                                                    GT_UNUSED GtUword seq_num,
+                                                    GtFile *outfp)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  gt_file_xfputs(tsc->description, outfp);
+}
+
+static GtUword simfilter_test_seq_con_num_of_seqs(GT_UNUSED GthSeqCon *sc)
+{
+  return 1;
+}
+
+static GtUword simfilter_test_seq_con_total_length(GthSeqCon *sc)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->length;
+}
+
+static GtRange simfilter_test_seq_con_get_range(GthSeqCon *sc,
+                                                GT_UNUSED GtUword seq_num)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  GtRange range;
+  range.start = 0;
+  range.end = tsc->length - 1;
+  return range;
+}
+
+static GtAlphabet* simfilter_test_seq_con_get_alphabet(GthSeqCon *sc)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  return tsc->alphabet;
+}
+
+static void simfilter_test_seq_con_free(GthSeqCon *sc)
+{
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  gt_alphabet_delete(tsc->alphabet);
+  gt_free(tsc->orig_seq);
+  gt_free(tsc->tran_seq);
+  gt_free(tsc->orig_seq_rc);
+  gt_free(tsc->tran_seq_rc);
+}
+
+static const GthSeqConClass* simfilter_test_seq_con_class(void)
+{
+  static const GthSeqConClass *scc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!scc) {
+    scc = gth_seq_con_class_new(sizeof (SimFilterTestSeqCon),
+                                simfilter_test_seq_con_demand_orig_seq,
+                                simfilter_test_seq_con_get_orig_seq,
+                                simfilter_test_seq_con_get_tran_seq,
+                                simfilter_test_seq_con_get_orig_seq_rc,
+                                simfilter_test_seq_con_get_tran_seq_rc,
+                                simfilter_test_seq_con_get_description,
+                                simfilter_test_seq_con_echo_description,
+                                simfilter_test_seq_con_num_of_seqs,
+                                simfilter_test_seq_con_total_length,
+                                simfilter_test_seq_con_get_range,
+                                simfilter_test_seq_con_get_alphabet,
+                                simfilter_test_seq_con_free);
+  }
+  gt_class_alloc_lock_leave();
+  return scc;
+}
+
+/* returns the next pseudo random nucleotide, the sequences have to be the same
+   whenever a file is loaded */
+static GtUchar simfilter_test_next_base(GtUword *state)
+{
+  static const char acgt[] = "acgt";
+  *state = (*state * 1103515245 + 12345) & 0x7fffffff;
+  return (GtUchar) acgt[(*state >> 16) & 3];
+}
+
+/* creates the cDNA (if <genomic> is false) or the genomic sequence with
+   <SIMFILTER_TEST_NUM_OF_GENES> copies of its gene, which differ by some
+   mismatches, with canonical splice sites between the exons */
+static GtUchar* simfilter_test_sequence(bool genomic, GtUword *length)
+{
+  GtUchar *cdna, *gen_seq;
+  GtUword i, e, g, cdna_length = 0, state = 42;
+
+  cdna = gt_malloc(sizeof *cdna * SIMFILTER_TEST_GENE_LENGTH);
+  for (e = 0; e < sizeof simfilter_test_exons / sizeof (GtRange); e++) {
+    for (i = 0; i < gt_range_length(simfilter_test_exons + e); i++)
+      cdna[cdna_length++] = simfilter_test_next_base(&state);
+  }
+  if (!genomic) {
+    *length = cdna_length;
+    return cdna;
+  }
+
+  *length = SIMFILTER_TEST_NUM_OF_GENES * SIMFILTER_TEST_GENE_LENGTH;
+  gen_seq = gt_malloc(sizeof *gen_seq * *length);
+  for (g = 0; g < SIMFILTER_TEST_NUM_OF_GENES; g++) {
+    GtUchar *gene = gen_seq + g * SIMFILTER_TEST_GENE_LENGTH;
+    GtUword cdna_pos = 0;
+    for (i = 0; i < SIMFILTER_TEST_GENE_LENGTH; i++)
+      gene[i] = simfilter_test_next_base(&state);
+    for (e = 0; e < sizeof simfilter_test_exons / sizeof (GtRange); e++) {
+      for (i = simfilter_test_exons[e].start;
+           i <= simfilter_test_exons[e].end; i++) {
+        gene[i] = cdna[cdna_pos++];
+        if (cdna_pos % (40 + 7 * g) == 0)
+          gene[i] = gene[i] == (GtUchar) 'a' ? (GtUchar) 'c' : (GtUchar) 'a';
+      }
+      if (e) {
+        memcpy(gene + simfilter_test_exons[e-1].end + 1, "gt", 2);
+        memcpy(gene + simfilter_test_exons[e].start - 2, "ag", 2);
+      }
+    }
+  }
+  gt_free(cdna);
+  return gen_seq;
+}
+
+static GthSeqCon* simfilter_test_seq_con_new(const char *indexname,
+                                             GT_UNUSED bool assign_rc,
+                                             GT_UNUSED bool orig_seq,
+                                             GT_UNUSED bool tran_seq)
+{
+  GthSeqCon *sc = gth_seq_con_create(simfilter_test_seq_con_class());
+  SimFilterTestSeqCon *tsc = simfilter_test_seq_con_cast(sc);
+  bool genomic = !strncmp(indexname, SIMFILTER_TEST_GEN_FILE,
+                          strlen(SIMFILTER_TEST_GEN_FILE));
+  GtUword i;
+
+  tsc->alphabet = gt_alphabet_new_dna();
+  tsc->description = genomic ? "gen" : "ref";
+  tsc->orig_seq = simfilter_test_sequence(genomic, &tsc->length);
+  tsc->tran_seq = gt_malloc(sizeof *tsc->tran_seq * tsc->length);
+  tsc->orig_seq_rc = gt_malloc(sizeof *tsc->orig_seq_rc * tsc->length);
+  tsc->tran_seq_rc = gt_malloc(sizeof *tsc->tran_seq_rc * tsc->length);
+  gt_alphabet_encode_seq(tsc->alphabet, tsc->tran_seq,
+                         (char*) tsc->orig_seq, tsc->length);
+  for (i = 0; i < tsc->length; i++) {
+    GtUchar cc = tsc->tran_seq[tsc->length - 1 - i];
+    tsc->tran_seq_rc[i] = (GtUchar) 3 - cc;
+    tsc->orig_seq_rc[i] = (GtUchar) "tgca"[cc];
+  }
+  return sc;
+}
+
+/* computes the spliced alignments of the cDNA for the chains of all gene
+   copies with <threads> threads */
+static GthSACollection* simfilter_test_sa_collection(GthInput *input,
+                                                     unsigned int threads,
+                                                     GtUword *call_number,
+                                                     GtError *err)
+{
+  GthChainCollection *chain_collection;
+  GthSACollection *sa_collection;
+  GthCallInfo *call_info;
+  GthMatchInfo match_info;
+  GthStat *stat;
+  GtUword e, g;
+  int had_err;
+
+  call_info = gth_call_info_new("gt");
+  call_info->threads = threads;
+  stat = gth_stat_new();
+  chain_collection = gth_chain_collection_new();
+  for (g = 0; g < SIMFILTER_TEST_NUM_OF_GENES; g++) {
+    GthChain *chain = gth_chain_new();
+    chain->gen_file_num = chain->gen_seq_num = 0;
+    chain->ref_file_num = chain->ref_seq_num = 0;
+    for (e = 0; e < sizeof simfilter_test_exons / sizeof (GtRange); e++) {
+      GtRange range = simfilter_test_exons[e];
+      range.start += g * SIMFILTER_TEST_GENE_LENGTH;
+      range.end += g * SIMFILTER_TEST_GENE_LENGTH;
+      gt_array_add(chain->forwardranges, range);
+    }
+    gt_ranges_copy_to_opposite_strand(chain->reverseranges,
+                                      chain->forwardranges,
+                                      SIMFILTER_TEST_NUM_OF_GENES
+                                      * SIMFILTER_TEST_GENE_LENGTH, 0);
+    gth_chain_collection_add(chain_collection, chain);
+  }
+  match_info.call_number = 0;
+  match_info.significant_match_found = false;
+  match_info.max_call_number_reached = false;
+  match_info.stop_amino_acid_warning = false;
+
+  sa_collection = gth_sa_collection_new(call_info->duplicate_check);
+  had_err = calc_spliced_alignments(sa_collection, chain_collection, call_info,
+                                    input, stat, 0, 0, true, &match_info, NULL,
+                                    NULL);
+  if (had_err) {
+    gt_error_set(err, "computing the spliced alignments failed");
+    gth_sa_collection_delete(sa_collection);
+    sa_collection = NULL;
+  }
+  *call_number = match_info.call_number;
+
+  gth_chain_collection_delete(chain_collection);
+  gth_stat_delete(stat);
+  gth_call_info_delete(call_info);
+  return sa_collection;
+}
+
+/* computes the spliced alignments of a cDNA to several copies of its gene
+   sequentially and with several threads, the results must be the same */
+int gth_similarity_filter_unit_test(GtError *err)
+{
+  GthSACollection *sequential = NULL, *threaded = NULL;
+  GtUword sequential_calls = 0, threaded_calls = 0;
+  GthSACollectionIterator *iterator;
+  GthInput *input;
+  GthSA *sa;
+  GtUword num_of_sas = 0;
+  int had_err = 0;
+
+  gt_error_check(err);
+
+  input = gth_input_new(NULL, simfilter_test_seq_con_new);
+  gth_input_add_genomic_file(input, SIMFILTER_TEST_GEN_FILE);
+  gth_input_add_reference_file(input, SIMFILTER_TEST_REF_FILE, DNA_ALPHA);
+  gth_input_load_genomic_file(input, 0, true);
+  gth_input_load_reference_file(input, 0, true);
+
+  sequential = simfilter_test_sa_collection(input, 1, &sequential_calls, err);
+  if (!sequential)
+    had_err = -1;
+  if (!had_err) {
+    threaded = simfilter_test_sa_collection(input, 3, &threaded_calls, err);
+    if (!threaded)
+      had_err = -1;
+  }
+
+  /* one spliced alignment per gene copy */
+  if (!had_err) {
+    iterator = gth_sa_collection_iterator_new(sequential);
+    while ((sa = gth_sa_collection_iterator_next(iterator))) {
+      gt_ensure(gth_sa_num_of_exons(sa) == 3);
+      num_of_sas++;
+    }
+    gth_sa_collection_iterator_delete(iterator);
+    gt_ensure(num_of_sas == SIMFILTER_TEST_NUM_OF_GENES);
+  }
+
+  /* the threaded computation must yield the same spliced alignments */
+  gt_ensure(sequential_calls == threaded_calls);
+  if (!had_err)
+    gt_ensure(gth_sa_collections_are_equal(sequential, threaded));
+
+  gth_sa_collection_delete(threaded);
+  gth_sa_collection_delete(sequential);
+  gth_input_delete_complete(input);
+
+  return had_err;
+}
@@ -214,6 +214,28 @@ void gth_stat_increase_numofPGLs_stored(GthStat *stat, GtUword addend)
   stat->numofPGLs_stored += addend;
 }
 
+/* adds the counters of <src> to <dest>, distributions are not merged */
+void gth_stat_add_counters(GthStat *dest, const GthStat *src)
+{
+  gt_assert(dest && src);
+  dest->numofchains                       += src->numofchains;
+  dest->numofremovedzerobaseexons         += src->numofremovedzerobaseexons;
+  dest->numofautointroncutoutcalls        += src->numofautointroncutoutcalls;
+  dest->numofunsuccessfulintroncutoutDPs  +=
+    src->numofunsuccessfulintroncutoutDPs;
+  dest->numoffailedDPparameterallocations +=
+    src->numoffailedDPparameterallocations;
+  dest->numoffailedmatrixallocations      += src->numoffailedmatrixallocations;
+  dest->numofundeterminedSAs              += src->numofundeterminedSAs;
+  dest->numoffilteredpolyAtailmatches     += src->numoffilteredpolyAtailmatches;
+  dest->numofSAs                          += src->numofSAs;
+  dest->numofPGLs_stored                  += src->numofPGLs_stored;
+  dest->totalsizeofbacktracematricesinMB  +=
+    src->totalsizeofbacktracematricesinMB;
+  dest->numofbacktracematrixallocations   +=
+    src->numofbacktracematrixallocations;
+}
+
 GtUword gth_stat_get_numofSAs(GthStat *stat)
 {
   gt_assert(stat);
@@ -20,6 +20,7 @@
 #include "gtlua/diagram_lua.h"
 #include "gtlua/image_info_lua.h"
 #include "gtlua/layout_lua.h"
+#include "gtlua/tile_cache_lua.h"
 #include "gtlua/annotationsketch_lua.h"
 
 int gt_lua_open_annotationsketch(lua_State *L)
@@ -35,6 +36,7 @@ int gt_lua_open_annotationsketch(lua_State *L)
   gt_lua_open_diagram(L);
   gt_lua_open_imageinfo(L);
   gt_lua_open_layout(L);
+  gt_lua_open_tile_cache(L);
   gt_assert(lua_gettop(L) == stack_size);
   return 1;
 }
@@ -0,0 +1,162 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef WITHOUT_CAIRO
+
+#include <limits.h>
+#include "lauxlib.h"
+#include "annotationsketch/luastyle.h"
+#include "annotationsketch/tile_cache.h"
+#include "core/error.h"
+#include "extended/luahelper.h"
+#include "gtlua/feature_index_lua.h"
+#include "gtlua/range_lua.h"
+#include "gtlua/tile_cache_lua.h"
+
+static int tile_cache_lua_new(lua_State *L)
+{
+  GtTileCache **tc;
+  GtFeatureIndex **feature_index;
+  GtUword tile_length, max_tiles;
+  unsigned int tile_width;
+  GtStyle *style;
+  GtError *err;
+  feature_index = check_feature_index(L, 1);
+  tile_length = luaL_checklong(L, 2);
+  luaL_argcheck(L, tile_length > 0, 2, "must be > 0");
+  tile_width = luaL_checkint(L, 3);
+  max_tiles = luaL_checklong(L, 4);
+  luaL_argcheck(L, max_tiles > 0, 4, "must be > 0");
+  style = gt_lua_get_style_from_registry(L);
+  tc = lua_newuserdata(L, sizeof (GtTileCache*));
+  gt_assert(tc);
+  err = gt_error_new();
+  *tc = gt_tile_cache_new(*feature_index, style, tile_length, tile_width,
+                          max_tiles, err);
+  if (!*tc)
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  luaL_getmetatable(L, TILE_CACHE_METATABLE);
+  lua_setmetatable(L, -2);
+  return 1;
+}
+
+static int tile_cache_lua_get_tile_range(lua_State *L)
+{
+  GtTileCache **tc;
+  unsigned int zoom;
+  GtUword tile;
+  tc = check_tile_cache(L, 1);
+  zoom = luaL_checkint(L, 2);
+  luaL_argcheck(L, zoom < sizeof (GtUword) * CHAR_BIT, 2, "zoom level too "
+                "large");
+  tile = luaL_checklong(L, 3);
+  return gt_lua_range_push(L, gt_tile_cache_get_tile_range(*tc, zoom, tile));
+}
+
+static int tile_cache_lua_render(lua_State *L)
+{
+  GtTileCache **tc;
+  const char *seqid;
+  unsigned int zoom;
+  GtUword from, to;
+  GtError *err;
+  tc = check_tile_cache(L, 1);
+  seqid = luaL_checkstring(L, 2);
+  zoom = luaL_checkint(L, 3);
+  from = luaL_checklong(L, 4);
+  to = luaL_checklong(L, 5);
+  err = gt_error_new();
+  if (gt_tile_cache_render(*tc, seqid, zoom, from, to, err))
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  return 0;
+}
+
+static int tile_cache_lua_to_file(lua_State *L)
+{
+  GtTileCache **tc;
+  const char *seqid, *fn;
+  unsigned int zoom;
+  GtUword tile;
+  GtError *err;
+  tc = check_tile_cache(L, 1);
+  seqid = luaL_checkstring(L, 2);
+  zoom = luaL_checkint(L, 3);
+  tile = luaL_checklong(L, 4);
+  fn = luaL_checkstring(L, 5);
+  err = gt_error_new();
+  if (gt_tile_cache_tile_to_file(*tc, seqid, zoom, tile, fn, err))
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  return 0;
+}
+
+static int tile_cache_lua_clear(lua_State *L)
+{
+  GtTileCache **tc;
+  tc = check_tile_cache(L, 1);
+  gt_tile_cache_clear(*tc);
+  return 0;
+}
+
+static int tile_cache_lua_delete(lua_State *L)
+{
+  GtTileCache **tc;
+  tc = check_tile_cache(L, 1);
+  gt_tile_cache_delete(*tc);
+  return 0;
+}
+
+static const struct luaL_Reg tile_cache_lib_f [] = {
+  { "tile_cache_new", tile_cache_lua_new },
+  { NULL, NULL }
+};
+
+static const struct luaL_Reg tile_cache_lib_m [] = {
+  { "get_tile_range", tile_cache_lua_get_tile_range },
+  { "render", tile_cache_lua_render },
+  { "to_file", tile_cache_lua_to_file },
+  { "clear", tile_cache_lua_clear },
+  { NULL, NULL }
+};
+
+int gt_lua_open_tile_cache(lua_State *L)
+{
+#ifndef NDEBUG
+  int stack_size;
+#endif
+  gt_assert(L);
+#ifndef NDEBUG
+  stack_size = lua_gettop(L);
+#endif
+  luaL_newmetatable(L, TILE_CACHE_METATABLE);
+  lua_pushvalue(L, -1); /* duplicate the metatable */
+  lua_setfield(L, -2, "__index");
+  /* set its _gc field */
+  lua_pushstring(L, "__gc");
+  lua_pushcfunction(L, tile_cache_lua_delete);
+  lua_settable(L, -3);
+  /* register functions */
+  luaL_register(L, NULL, tile_cache_lib_m);
+  lua_pop(L, 1);
+  luaL_register(L, "gt", tile_cache_lib_f);
+  lua_pop(L, 1);
+  gt_assert(lua_gettop(L) == stack_size);
+  return 1;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TILE_CACHE_LUA_H
+#define TILE_CACHE_LUA_H
+
+#include "lua.h"
+
+/* exports the TileCache class to Lua:
+
+   -- Return a TileCache object which renders the features in <feature_index>
+   -- as tiles of <tile_width> pixels, covering <tile_length> bases at zoom
+   -- level 0. At most <max_tiles> tiles are cached.
+   function tile_cache_new(feature_index, tile_length, tile_width, max_tiles)
+
+   -- Return the range covered by tile <tile> at zoom level <zoom>.
+   function tile_cache:get_tile_range(zoom, tile)
+
+   -- Render the tiles <from> to <to> at zoom level <zoom> of the sequence
+   -- region <seqid> in parallel, unless they are cached already.
+   function tile_cache:render(seqid, zoom, from, to)
+
+   -- Write the PNG image of tile <tile> at zoom level <zoom> of the sequence
+   -- region <seqid> to the file named <filename>.
+   function tile_cache:to_file(seqid, zoom, tile, filename)
+
+   -- Drop all cached tiles.
+   function tile_cache:clear()
+*/
+int gt_lua_open_tile_cache(lua_State*);
+
+#define TILE_CACHE_METATABLE  "GenomeTools.tile_cache"
+#define check_tile_cache(L, POS) \
+              (GtTileCache**) luaL_checkudata(L, POS, TILE_CACHE_METATABLE)
+
+#endif
@@ -62,6 +62,7 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_mapped.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
@@ -74,21 +75,32 @@
 #include "extended/kmer_database.h"
 #include "extended/luaserialize.h"
 #include "extended/multieoplist.h"
+#include "extended/node_arena.h"
 #include "extended/popcount_tab.h"
 #include "extended/priority_queue.h"
+#include "extended/rank9_bitsequence.h"
 #include "extended/ranked_list.h"
 #include "extended/rbtree.h"
 #include "extended/rmq.h"
+#include "extended/rmq_succinct.h"
 #include "extended/splicedseq.h"
 #include "extended/string_matching.h"
+#include "extended/swalign.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
+#include "extended/wtree_matrix_encseq.h"
+#include "gth/align_dna.h"
+#include "gth/intermediate.h"
+#include "gth/pgl_collection.h"
+#include "gth/similarity_filter.h"
 #include "ltr/gt_ltrclustering.h"
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
+#include "ltr/pdom_phmm.h"
 #include "match/rdj-spmlist.h"
 #include "match/rdj-strgraph.h"
+#include "match/rdj-strgraph-csr.h"
 #include "match/shu-encseq-gc.h"
 #include "match/xdrop.h"
 #include "tools/gt_bed_to_gff3.h"
@@ -172,8 +184,10 @@
 #include "annotationsketch/gt_sketch.h"
 #include "annotationsketch/gt_sketch_page.h"
 #include "annotationsketch/image_info.h"
+#include "annotationsketch/layout_context.h"
 #include "annotationsketch/rec_map.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/tile_cache.h"
 #include "annotationsketch/track.h"
 #endif
 
@@ -330,6 +344,13 @@ GtHashmap* gtt_unit_tests(void)
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
   gt_hashmap_add(unit_tests, "golomb class", gt_golomb_unit_test);
+  gt_hashmap_add(unit_tests, "gth align dna module", gth_align_dna_unit_test);
+  gt_hashmap_add(unit_tests, "gth intermediate module",
+                 gth_intermediate_unit_test);
+  gt_hashmap_add(unit_tests, "gth pgl collection module",
+                 gth_pgl_collection_unit_test);
+  gt_hashmap_add(unit_tests, "gth similarity filter module",
+                 gth_similarity_filter_unit_test);
   gt_hashmap_add(unit_tests, "hashmap class", gt_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
@@ -339,22 +360,33 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "kmer_database class", gt_kmer_database_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
+  gt_hashmap_add(unit_tests, "mapped feature index class",
+                                             gt_feature_index_mapped_unit_test);
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
   gt_hashmap_add(unit_tests, "memory allocator module", gt_ma_unit_test);
   gt_hashmap_add(unit_tests, "multieoplist", gt_multieoplist_unit_test);
+  gt_hashmap_add(unit_tests, "node arena class", gt_node_arena_unit_test);
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
   gt_hashmap_add(unit_tests, "PBS finder module",
                                             gt_ltrdigest_pbs_visitor_unit_test);
+  gt_hashmap_add(unit_tests, "pHMM domain scoring class",
+                                                        gt_pdom_phmm_unit_test);
   gt_hashmap_add(unit_tests, "popcount sorted tab", gt_popcount_tab_unit_test);
   gt_hashmap_add(unit_tests, "quality module", gt_quality_unit_test);
   gt_hashmap_add(unit_tests, "queue class", gt_queue_unit_test);
   gt_hashmap_add(unit_tests, "range class", gt_range_unit_test);
+  gt_hashmap_add(unit_tests, "rank9 bitsequence class",
+                                                gt_rank9_bitsequence_unit_test);
   gt_hashmap_add(unit_tests, "ranked list class", gt_ranked_list_unit_test);
   gt_hashmap_add(unit_tests, "red-black tree class", gt_rbtree_unit_test);
   gt_hashmap_add(unit_tests, "range minimum query class", gt_rmq_unit_test);
+  gt_hashmap_add(unit_tests, "succinct range minimum query class",
+                 gt_rmq_succinct_unit_test);
   gt_hashmap_add(unit_tests, "rdj: string graph class", gt_strgraph_unit_test);
+  gt_hashmap_add(unit_tests, "rdj: compressed string graph file",
+                                                     gt_strgraph_csr_unit_test);
   gt_hashmap_add(unit_tests, "priority queue class",
                              gt_priority_queue_unit_test);
   gt_hashmap_add(unit_tests, "safearith example", gt_safearith_example);
@@ -366,6 +398,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
   gt_hashmap_add(unit_tests, "string matching module",
                                                   gt_string_matching_unit_test);
+  gt_hashmap_add(unit_tests, "swalign batch class",
+                 gt_swalign_batch_unit_test);
   gt_hashmap_add(unit_tests, "symbol module", gt_symbol_unit_test);
   gt_hashmap_add(unit_tests, "tag value map class", gt_tag_value_map_unit_test);
   gt_hashmap_add(unit_tests, "tag value map example", gt_tag_value_map_example);
@@ -373,6 +407,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "translator class", gt_translator_unit_test);
   gt_hashmap_add(unit_tests, "transtable class", gt_trans_table_unit_test);
   gt_hashmap_add(unit_tests, "uint64hashtable", gt_uint64hashtable_unit_test);
+  gt_hashmap_add(unit_tests, "wavelet matrix class",
+                                              gt_wtree_matrix_encseq_unit_test);
   gt_hashmap_add(unit_tests, "xdrop", gt_xdrop_unit_test);
 #ifndef WITHOUT_CAIRO
   gt_hashmap_add(unit_tests, "block class", gt_block_unit_test);
@@ -382,7 +418,10 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "memory feature index class",
                                              gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "imageinfo class", gt_image_info_unit_test);
+  gt_hashmap_add(unit_tests, "layout context class",
+                 gt_layout_context_unit_test);
   gt_hashmap_add(unit_tests, "line class", gt_line_unit_test);
+  gt_hashmap_add(unit_tests, "tile cache class", gt_tile_cache_unit_test);
   gt_hashmap_add(unit_tests, "track class", gt_track_unit_test);
 #endif
 #if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
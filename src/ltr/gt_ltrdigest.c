@@ -46,7 +46,7 @@
 #include "ltr/pdom_model_set.h"
 
 typedef struct GtLTRdigestOptions {
-  GtStr *trna_lib, *prefix, *cutoffs;
+  GtStr *trna_lib, *prefix, *cutoffs, *pdom_engine;
   bool verbose,
        write_alignments,
        write_aaseqs,
@@ -91,6 +91,7 @@ static void* gt_ltrdigest_arguments_new(void)
   arguments->trna_lib = gt_str_new();
   arguments->prefix = gt_str_new();
   arguments->cutoffs = gt_str_new();
+  arguments->pdom_engine = gt_str_new();
   arguments->ofi = gt_output_file_info_new();
   arguments->hmm_files = gt_str_array_new();
   arguments->s2fi = gt_seqid2file_info_new();
@@ -104,6 +105,7 @@ static void gt_ltrdigest_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->trna_lib);
   gt_str_delete(arguments->prefix);
   gt_str_delete(arguments->cutoffs);
+  gt_str_delete(arguments->pdom_engine);
   gt_str_array_delete(arguments->hmm_files);
   gt_file_delete(arguments->outfp);
   gt_output_file_info_delete(arguments->ofi);
@@ -117,7 +119,8 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *o, *ot, *oto;
   GtOption *oh, *oc, *oeval;
-  static const char *cutoffs[] = {"NONE", "GA", "TC", NULL};
+  static const char *cutoffs[] = {"NONE", "GA", "TC", NULL},
+                    *engines[] = {"hmmscan", "builtin", NULL};
   static GtRange pptlen_defaults           = { 8UL, 30UL},
                  uboxlen_defaults          = { 3UL, 30UL},
                  pbsalilen_defaults        = {11UL, 30UL},
@@ -306,6 +309,16 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(oeval);
   gt_option_imply(oeval, oh);
 
+  o = gt_option_new_choice("pdomengine", "pHMM search implementation\n"
+                                       "choose from hmmscan (run external "
+                                       "HMMER3 hmmscan) | "
+                                       "builtin (search in-process, "
+                                       "HMMER3 models only)",
+                           arguments->pdom_engine, engines[0], engines);
+  gt_option_parser_add_option(op, o);
+  gt_option_is_extended_option(o);
+  gt_option_imply(o, oh);
+
   o = gt_option_new_bool("aliout",
                          "output pHMM to amino acid sequence alignments",
                          &arguments->write_alignments,
@@ -528,8 +541,11 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
 
   if (!had_err && gt_str_array_size(arguments->hmm_files) > 0) {
     GtNodeVisitor *pdom_v;
-    ms = gt_pdom_model_set_new(arguments->hmm_files, arguments->force_recreate,
-                               err);
+    if (strcmp(gt_str_get(arguments->pdom_engine), "builtin") == 0)
+      ms = gt_pdom_model_set_new_builtin(arguments->hmm_files, err);
+    else
+      ms = gt_pdom_model_set_new(arguments->hmm_files,
+                                 arguments->force_recreate, err);
     if (ms != NULL) {
       pdom_v = gt_ltrdigest_pdom_visitor_new(ms, arguments->evalue_cutoff,
                                              arguments->chain_max_gap_length,
@@ -281,12 +281,13 @@ static int gt_pbs_hit_compare(const void *h1, const void *h2)
 static GtPBSResults* gt_pbs_find(GtLTRdigestPBSVisitor *lv, const char *seq,
                           const char *rev_seq, GtError *err)
 {
-  GtSeq *seq_forward, *seq_rev;
+  GtSeq *seq_forward, *seq_rev, **trna_seqs, **trnas_from3;
   GtPBSResults *results;
-  GtUword j;
+  GtUword j, num_of_trnas;
   GtAlignment *ali;
   GtAlphabet *a = gt_alphabet_new_dna();
   GtScoreFunction *sf;
+  GtSWAlignBatch *batch_forward, *batch_rev;
   gt_assert(lv && seq && rev_seq);
 
   sf = gt_dna_scorefunc_new(a, lv->ali_score_match, lv->ali_score_mismatch,
@@ -304,36 +305,56 @@ static GtPBSResults* gt_pbs_find(GtLTRdigestPBSVisitor *lv, const char *seq,
                            (GtUword) (2 * lv->radius + 1),
                            a);
 
-  for (j = 0; j < gt_bioseq_number_of_sequences(lv->trna_lib); j++)
+  /* align both strands against all tRNAs at once */
+  num_of_trnas = gt_bioseq_number_of_sequences(lv->trna_lib);
+  trna_seqs = gt_malloc(sizeof (*trna_seqs) * num_of_trnas);
+  trnas_from3 = gt_malloc(sizeof (*trnas_from3) * num_of_trnas);
+  batch_forward = gt_swalign_batch_new(sf);
+  batch_rev = gt_swalign_batch_new(sf);
+  gt_swalign_batch_reset(batch_forward, seq_forward);
+  gt_swalign_batch_reset(batch_rev, seq_rev);
+  for (j = 0; j < num_of_trnas; j++)
   {
-    GtSeq *trna_seq, *trna_from3;
     char *trna_from3_full;
     GtUword trna_seqlen;
 
-    trna_seq = gt_bioseq_get_seq(lv->trna_lib, j);
-    trna_seqlen = gt_seq_length(trna_seq);
+    trna_seqs[j] = gt_bioseq_get_seq(lv->trna_lib, j);
+    trna_seqlen = gt_seq_length(trna_seqs[j]);
 
     trna_from3_full = gt_calloc((size_t) trna_seqlen, sizeof (char));
-    memcpy(trna_from3_full, gt_seq_get_orig(trna_seq),
+    memcpy(trna_from3_full, gt_seq_get_orig(trna_seqs[j]),
            sizeof (char) * trna_seqlen);
     (void) gt_reverse_complement(trna_from3_full, trna_seqlen, err);
-    trna_from3 = gt_seq_new_own(trna_from3_full, trna_seqlen, a);
+    trnas_from3[j] = gt_seq_new_own(trna_from3_full, trna_seqlen, a);
+    (void) gt_swalign_batch_add(batch_forward, trnas_from3[j]);
+    (void) gt_swalign_batch_add(batch_rev, trnas_from3[j]);
+  }
+  gt_swalign_batch_compute(batch_forward);
+  gt_swalign_batch_compute(batch_rev);
+
+  for (j = 0; j < num_of_trnas; j++)
+  {
+    GtUword trna_seqlen = gt_seq_length(trna_seqs[j]);
 
-    ali = gt_swalign(seq_forward, trna_from3, sf);
+    ali = gt_swalign_batch_get_alignment(batch_forward, j);
     gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_FORWARD,
+                   gt_seq_get_description(trna_seqs[j]), GT_STRAND_FORWARD,
                    results);
     gt_alignment_delete(ali);
 
-    ali = gt_swalign(seq_rev, trna_from3, sf);
+    ali = gt_swalign_batch_get_alignment(batch_rev, j);
     gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_REVERSE,
+                   gt_seq_get_description(trna_seqs[j]), GT_STRAND_REVERSE,
                    results);
     gt_alignment_delete(ali);
 
-    gt_seq_delete(trna_seq);
-    gt_seq_delete(trna_from3);
+    gt_seq_delete(trna_seqs[j]);
+    gt_seq_delete(trnas_from3[j]);
   }
+  gt_swalign_batch_delete(batch_forward);
+  gt_swalign_batch_delete(batch_rev);
+  gt_free(trna_seqs);
+  gt_free(trnas_from3);
   gt_seq_delete(seq_forward);
   gt_seq_delete(seq_rev);
   gt_score_function_delete(sf);
@@ -37,6 +37,7 @@
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/mathsupport.h"
+#include "core/multithread_api.h"
 #include "core/range.h"
 #include "core/str_api.h"
 #include "core/strand_api.h"
@@ -55,9 +56,14 @@
 #include "extended/node_visitor_api.h"
 #include "extended/reverse_api.h"
 #include "ltr/ltrdigest_def.h"
+#include "ltr/pdom_phmm.h"
 #include "ltr/ltrdigest_pdom_visitor.h"
 
 #define GT_HMMER_BUF_LEN  122
+/* MSV filter P-value threshold of the builtin search, as in HMMER3 (F1) */
+#define GT_PDOM_BUILTIN_MSV_PVALUE 0.02
+/* maximal number of domains reported per model and frame */
+#define GT_PDOM_BUILTIN_MAX_DOMAINS 16UL
 
 struct GtLTRdigestPdomVisitor {
   const GtNodeVisitor parent_instance;
@@ -506,6 +512,139 @@ static int gt_ltrdigest_pdom_visitor_parse_output(GtLTRdigestPdomVisitor *lv,
 }
 #endif
 
+#ifndef _WIN32
+typedef struct {
+  GtLTRdigestPdomVisitor *lv;
+  GtUword next_model;
+  GtArray **hits;
+  GtMutex *mutex;
+} GtLTRdigestPdomBuiltinInfo;
+
+static void gt_ltrdigest_pdom_visitor_builtin_model(GtLTRdigestPdomVisitor *lv,
+                                                    const GtPdomPHMM *phmm,
+                                                    GtArray *hits,
+                                                    GtArray *domains,
+                                                    GtPdomPHMMScratch *scratch)
+{
+  double min_score = -DBL_MAX, max_evalue = DBL_MAX;
+  GtUword frame, strand, i;
+  char seqname[3];
+
+  switch (lv->cutoff) {
+    case GT_PHMM_CUTOFF_GA:
+      (void) gt_pdom_phmm_get_ga(phmm, &min_score);
+      break;
+    case GT_PHMM_CUTOFF_TC:
+      (void) gt_pdom_phmm_get_tc(phmm, &min_score);
+      break;
+    case GT_PHMM_CUTOFF_NONE:
+      max_evalue = lv->eval_cutoff;
+      break;
+  }
+  for (strand = 0; strand < 2UL; strand++) {
+    for (frame = 0; frame < 3UL; frame++) {
+      GtStr *aaseq = (strand == 0 ? lv->fwd[frame] : lv->rev[frame]);
+      if (gt_pdom_phmm_msv_pvalue(phmm, gt_str_get(aaseq),
+                                  gt_str_length(aaseq), scratch)
+            > GT_PDOM_BUILTIN_MSV_PVALUE)
+        continue;
+      (void) snprintf(seqname, sizeof (seqname), ""GT_WU"%c", frame,
+                      strand == 0 ? '+' : '-');
+      gt_array_reset(domains);
+      (void) gt_pdom_phmm_find_domains(phmm, gt_str_get(aaseq),
+                                       gt_str_length(aaseq), seqname,
+                                       gt_pdom_model_set_size(lv->model),
+                                       min_score, max_evalue,
+                                       GT_PDOM_BUILTIN_MAX_DOMAINS, domains,
+                                       scratch);
+      for (i = 0; i < gt_array_size(domains); i++) {
+        GtPdomPHMMDomain *dom = gt_array_get(domains, i);
+        GtHMMERSingleHit *shit = gt_calloc((size_t) 1, sizeof (*shit));
+        shit->hmmfrom = dom->hmmfrom;
+        shit->hmmto = dom->hmmto;
+        shit->alifrom = dom->alifrom;
+        shit->alito = dom->alito;
+        shit->score = dom->score;
+        shit->evalue = dom->evalue;
+        shit->strand = (strand == 0 ? GT_STRAND_FORWARD : GT_STRAND_REVERSE);
+        shit->frame = frame;
+        shit->reported = true;
+        shit->chains = gt_array_new(sizeof (GtUword));
+        shit->alignment = dom->alignment;
+        shit->aastring = dom->aastring;
+        gt_array_add(hits, shit);
+      }
+    }
+  }
+}
+
+static void* gt_ltrdigest_pdom_visitor_builtin_thread(void *data)
+{
+  GtLTRdigestPdomBuiltinInfo *info = (GtLTRdigestPdomBuiltinInfo*) data;
+  GtPdomPHMMScratch *scratch;
+  GtArray *domains;
+  GtUword m, nof_models;
+  gt_assert(info);
+
+  scratch = gt_pdom_phmm_scratch_new();
+  domains = gt_array_new(sizeof (GtPdomPHMMDomain));
+  nof_models = gt_pdom_model_set_size(info->lv->model);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    m = info->next_model++;
+    gt_mutex_unlock(info->mutex);
+    if (m >= nof_models)
+      break;
+    gt_ltrdigest_pdom_visitor_builtin_model(info->lv,
+                                       gt_pdom_model_set_get(info->lv->model,
+                                                             m),
+                                       info->hits[m], domains, scratch);
+  }
+  gt_array_delete(domains);
+  gt_pdom_phmm_scratch_delete(scratch);
+  return NULL;
+}
+
+/* Scores all six translations against all models in-process, distributing
+   models over <gt_jobs> threads. Hits are collected in model order to keep
+   the results independent of thread scheduling. */
+static int gt_ltrdigest_pdom_visitor_run_builtin(GtLTRdigestPdomVisitor *lv,
+                                                 GtHMMERParseStatus *status,
+                                                 GtError *err)
+{
+  GtLTRdigestPdomBuiltinInfo info;
+  GtUword m, i, nof_models;
+  int had_err = 0;
+  gt_assert(lv && status);
+  gt_error_check(err);
+
+  nof_models = gt_pdom_model_set_size(lv->model);
+  info.lv = lv;
+  info.next_model = 0;
+  info.mutex = gt_mutex_new();
+  info.hits = gt_malloc(sizeof (GtArray*) * nof_models);
+  for (m = 0; m < nof_models; m++)
+    info.hits[m] = gt_array_new(sizeof (GtHMMERSingleHit*));
+
+  had_err = gt_multithread(gt_ltrdigest_pdom_visitor_builtin_thread, &info,
+                           err);
+
+  for (m = 0; m < nof_models; m++) {
+    gt_str_set(status->cur_model,
+               gt_pdom_phmm_get_name(gt_pdom_model_set_get(lv->model, m)));
+    for (i = 0; i < gt_array_size(info.hits[m]); i++) {
+      GtHMMERSingleHit *shit = *(GtHMMERSingleHit**)
+                                               gt_array_get(info.hits[m], i);
+      gt_hmmer_parse_status_add_hit(status, shit);
+    }
+    gt_array_delete(info.hits[m]);
+  }
+  gt_free(info.hits);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+#endif
+
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_fragcmp(const void *frag1,
                                              const void *frag2)
@@ -827,6 +966,7 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
 #endif
     unsigned int frame;
     GtStr *seq;
+    bool builtin = gt_pdom_model_set_is_builtin(lv->model);
 
     seq = gt_str_new();
     rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
@@ -875,15 +1015,25 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
       gt_codon_iterator_delete(ci);
       gt_translator_delete(tr);
 
+  #ifndef _WIN32
+      /* run builtin domain search */
+      if (!had_err && builtin) {
+        pstatus = gt_hmmer_parse_status_new();
+        had_err = gt_ltrdigest_pdom_visitor_run_builtin(lv, pstatus, err);
+        if (!had_err)
+          had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus, err);
+        gt_hmmer_parse_status_delete(pstatus);
+      }
+  #endif
       /* run HMMER and handle results */
-      if (!had_err) {
+      if (!had_err && !builtin) {
   #ifndef _WIN32
         had_err = gt_ltrdigest_checkpipe(pc, err);
       }
-      if (!had_err) {
+      if (!had_err && !builtin) {
         had_err = gt_ltrdigest_checkpipe(cp,err);
       }
-      if (!had_err) {
+      if (!had_err && !builtin) {
         switch ((pid = (int) fork())) {
           case -1:
             gt_error_set(err, "can't fork new HMMER process");
@@ -1021,21 +1171,37 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   int had_err = 0, i, rval;
   gt_assert(model && rmap);
 
-  rval = system("hmmscan -h > /dev/null");
-  if (rval == -1) {
-    gt_error_set(err, "error executing system(hmmscan)");
-    return NULL;
-  }
+  if (gt_pdom_model_set_is_builtin(model)) {
+    GtUword m;
+    double cut;
+    for (m = 0; m < gt_pdom_model_set_size(model); m++) {
+      const GtPdomPHMM *phmm = gt_pdom_model_set_get(model, m);
+      if ((cutoff == GT_PHMM_CUTOFF_GA && !gt_pdom_phmm_get_ga(phmm, &cut))
+            || (cutoff == GT_PHMM_CUTOFF_TC
+                  && !gt_pdom_phmm_get_tc(phmm, &cut))) {
+        gt_error_set(err, "model %s has no %s cutoff",
+                     gt_pdom_phmm_get_name(phmm),
+                     cutoff == GT_PHMM_CUTOFF_GA ? "GA" : "TC");
+        return NULL;
+      }
+    }
+  } else {
+    rval = system("hmmscan -h > /dev/null");
+    if (rval == -1) {
+      gt_error_set(err, "error executing system(hmmscan)");
+      return NULL;
+    }
 #ifndef _WIN32
-  if (WEXITSTATUS(rval) != 0) {
-    gt_error_set(err, "cannot find the hmmscan executable in PATH");
-    return NULL;
-  }
+    if (WEXITSTATUS(rval) != 0) {
+      gt_error_set(err, "cannot find the hmmscan executable in PATH");
+      return NULL;
+    }
 #else
-  /* XXX */
-  gt_error_set(err, "hmmscan for Windows not implemented");
-  return NULL;
+    /* XXX */
+    gt_error_set(err, "hmmscan for Windows not implemented");
+    return NULL;
 #endif
+  }
 
   nv = gt_node_visitor_create(gt_ltrdigest_pdom_visitor_class());
   lv = gt_ltrdigest_pdom_visitor_cast(nv);
@@ -1046,13 +1212,14 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   lv->output_all_chains = false;
   lv->tag = gt_str_new_cstr("GenomeTools");
   lv->root_type = gt_symbol(gt_ft_LTR_retrotransposon);
+  lv->model = model;
 
   for (i = 0; i < 3; i++) {
     lv->fwd[i] = gt_str_new();
     lv->rev[i] = gt_str_new();
   }
 
-  if (!had_err) {
+  if (!had_err && !gt_pdom_model_set_is_builtin(model)) {
     cmd = gt_str_new_cstr("hmmscan --cpu ");
     gt_str_append_uint(cmd, gt_jobs);
     gt_str_append_cstr(cmd, " ");
@@ -21,6 +21,7 @@
 #ifndef _WIN32
 #include <sys/wait.h>
 #endif
+#include "core/array_api.h"
 #include "core/compat.h"
 #include "core/error_api.h"
 #include "core/fileutils_api.h"
@@ -39,6 +40,7 @@
 struct GtPdomModelSet
 {
   GtStr *filename;
+  GtArray *phmms;
 };
 
 #define PDOM_MODEL_SET_HMMER_NOT_FOUND "Please make sure that all HMMER " \
@@ -176,15 +178,66 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, bool force,
   return pdom_model_set;
 }
 
-const char* gt_pdom_model_set_get_filename(GtPdomModelSet *set)
+GtPdomModelSet* gt_pdom_model_set_new_builtin(GtStrArray *hmmfiles,
+                                              GtError *err)
+{
+  GtPdomModelSet *pdom_model_set;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(hmmfiles);
+  gt_error_check(err);
+
+  pdom_model_set = gt_calloc((size_t) 1, sizeof (GtPdomModelSet));
+  pdom_model_set->phmms = gt_array_new(sizeof (GtPdomPHMM*));
+  for (i = 0; !had_err && i < gt_str_array_size(hmmfiles); i++) {
+    const char *filename = gt_str_array_get(hmmfiles, i);
+    if (!gt_file_exists(filename)) {
+      gt_error_set(err, "invalid HMM file: %s", filename);
+      had_err = -1;
+    } else {
+      had_err = gt_pdom_phmm_parse_file(pdom_model_set->phmms, filename, err);
+    }
+  }
+  if (had_err) {
+    gt_pdom_model_set_delete(pdom_model_set);
+    pdom_model_set = NULL;
+  }
+  return pdom_model_set;
+}
+
+bool gt_pdom_model_set_is_builtin(const GtPdomModelSet *set)
 {
   gt_assert(set);
+  return (set->phmms != NULL);
+}
+
+const char* gt_pdom_model_set_get_filename(GtPdomModelSet *set)
+{
+  gt_assert(set && set->filename);
   return gt_str_get(set->filename);
 }
 
+GtUword gt_pdom_model_set_size(const GtPdomModelSet *set)
+{
+  gt_assert(set && set->phmms);
+  return gt_array_size(set->phmms);
+}
+
+const GtPdomPHMM* gt_pdom_model_set_get(const GtPdomModelSet *set, GtUword i)
+{
+  gt_assert(set && set->phmms && i < gt_array_size(set->phmms));
+  return *(GtPdomPHMM**) gt_array_get(set->phmms, i);
+}
+
 void gt_pdom_model_set_delete(GtPdomModelSet *set)
 {
+  GtUword i;
   if (!set) return;
   gt_str_delete(set->filename);
+  if (set->phmms != NULL) {
+    for (i = 0; i < gt_array_size(set->phmms); i++)
+      gt_pdom_phmm_delete(*(GtPdomPHMM**) gt_array_get(set->phmms, i));
+    gt_array_delete(set->phmms);
+  }
   gt_free(set);
 }
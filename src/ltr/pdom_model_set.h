@@ -18,11 +18,25 @@
 #ifndef PDOM_MODEL_SET_H
 #define PDOM_MODEL_SET_H
 
+#include "ltr/pdom_phmm.h"
+
 typedef struct GtPdomModelSet GtPdomModelSet;
 
 GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles,bool force,
                                       GtError *err);
+/* Returns a new <GtPdomModelSet> holding the profile HMMs from the HMMER3
+   files in <hmmfiles> in memory, for use with the builtin domain search.
+   No external HMMER binaries are needed. */
+GtPdomModelSet* gt_pdom_model_set_new_builtin(GtStrArray *hmmfiles,
+                                              GtError *err);
+/* Returns true if <set> was created by <gt_pdom_model_set_new_builtin()>. */
+bool            gt_pdom_model_set_is_builtin(const GtPdomModelSet *set);
 const char*     gt_pdom_model_set_get_filename(GtPdomModelSet *set);
+/* Returns the number of models in builtin model set <set>. */
+GtUword         gt_pdom_model_set_size(const GtPdomModelSet *set);
+/* Returns the <i>-th model in builtin model set <set>. */
+const GtPdomPHMM* gt_pdom_model_set_get(const GtPdomModelSet *set,
+                                        GtUword i);
 void            gt_pdom_model_set_delete(GtPdomModelSet *set);
 
 #endif
@@ -0,0 +1,1128 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/str.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "ltr/pdom_phmm.h"
+
+/* HMMER3 amino acid alphabet order; code GT_PDOM_PHMM_ANY is used for all
+   other (degenerate or stop) symbols */
+#define GT_PDOM_PHMM_ALPHABET   "ACDEFGHIKLMNPQRSTVWY"
+#define GT_PDOM_PHMM_K          20
+#define GT_PDOM_PHMM_ANY        GT_PDOM_PHMM_K
+#define GT_PDOM_PHMM_KP         (GT_PDOM_PHMM_K + 1)
+#define GT_PDOM_PHMM_NOF_TRANS  7
+#define GT_PDOM_PHMM_VECWIDTH   16
+#define GT_PDOM_PHMM_MSV_BASE   190
+#define GT_PDOM_PHMM_ALIWIDTH   60
+#define GT_PDOM_PHMM_NEGINF     (-FLT_MAX)
+
+/* transition indices, in the column order of HMMER3 save files */
+enum {
+  GT_PDOM_PHMM_MM = 0,
+  GT_PDOM_PHMM_MI,
+  GT_PDOM_PHMM_MD,
+  GT_PDOM_PHMM_IM,
+  GT_PDOM_PHMM_II,
+  GT_PDOM_PHMM_DM,
+  GT_PDOM_PHMM_DD
+};
+
+/* traceback flags */
+#define GT_PDOM_PHMM_TB_MMASK  3U
+#define GT_PDOM_PHMM_TB_FROM_B 0U
+#define GT_PDOM_PHMM_TB_FROM_M 1U
+#define GT_PDOM_PHMM_TB_FROM_I 2U
+#define GT_PDOM_PHMM_TB_FROM_D 3U
+#define GT_PDOM_PHMM_TB_II     4U
+#define GT_PDOM_PHMM_TB_DD     8U
+
+/* background amino acid frequencies used by HMMER3 (BLOSUM62 composition) */
+static const double gt_pdom_phmm_bg[GT_PDOM_PHMM_K] = {
+  0.0787945, 0.0151600, 0.0535222, 0.0668298, 0.0397062,
+  0.0695071, 0.0229198, 0.0590092, 0.0594422, 0.0963728,
+  0.0237718, 0.0414386, 0.0482904, 0.0395639, 0.0540978,
+  0.0683364, 0.0540687, 0.0673417, 0.0114135, 0.0304133
+};
+
+struct GtPdomPHMM {
+  char *name;
+  GtUword M;
+  bool has_ga, has_tc;
+  double ga, tc,
+         msv_mu, msv_lambda,
+         vit_mu, vit_lambda;
+  float *msc,  /* match log-odds scores (nats), (M+1) x GT_PDOM_PHMM_KP */
+        *tsc;  /* log transition probabilities, (M+1) x 7 */
+  char *cons;  /* consensus residues, 1-based */
+  /* striped byte profile for the MSV filter */
+  GtUword Q;
+  uint8_t *rbv, /* GT_PDOM_PHMM_KP x Q x GT_PDOM_PHMM_VECWIDTH */
+          bias_b,
+          tbm_b,
+          tec_b;
+  float scale_b;
+};
+
+typedef enum {
+  GT_PDOM_PHMM_OP_MATCH,
+  GT_PDOM_PHMM_OP_INSERT,
+  GT_PDOM_PHMM_OP_DELETE
+} GtPdomPHMMOp;
+
+struct GtPdomPHMMScratch {
+  uint8_t *dp,
+          *tb,
+          *dsq,
+          *mask;
+  float *rows;
+  GtPdomPHMMOp *ops;
+  GtUword dp_alloc, tb_alloc, dsq_alloc, rows_alloc, ops_alloc;
+  uint8_t code[UCHAR_MAX + 1];
+};
+
+GtPdomPHMMScratch* gt_pdom_phmm_scratch_new(void)
+{
+  GtPdomPHMMScratch *scratch;
+  const char *alpha = GT_PDOM_PHMM_ALPHABET;
+  unsigned int i;
+  scratch = gt_calloc((size_t) 1, sizeof (*scratch));
+  memset(scratch->code, GT_PDOM_PHMM_ANY, sizeof (scratch->code));
+  for (i = 0; i < (unsigned int) GT_PDOM_PHMM_K; i++) {
+    scratch->code[(unsigned char) alpha[i]] = (uint8_t) i;
+    scratch->code[tolower((unsigned char) alpha[i])] = (uint8_t) i;
+  }
+  return scratch;
+}
+
+void gt_pdom_phmm_scratch_delete(GtPdomPHMMScratch *scratch)
+{
+  if (!scratch) return;
+  gt_free(scratch->dp);
+  gt_free(scratch->tb);
+  gt_free(scratch->dsq);
+  gt_free(scratch->mask);
+  gt_free(scratch->rows);
+  gt_free(scratch->ops);
+  gt_free(scratch);
+}
+
+static void gt_pdom_phmm_scratch_digitize(GtPdomPHMMScratch *scratch,
+                                          const char *seq, GtUword len)
+{
+  GtUword i;
+  if (len + 1 > scratch->dsq_alloc) {
+    scratch->dsq_alloc = len + 1;
+    scratch->dsq = gt_realloc(scratch->dsq, (size_t) scratch->dsq_alloc);
+    scratch->mask = gt_realloc(scratch->mask, (size_t) scratch->dsq_alloc);
+  }
+  /* residues are 1-based, position 0 is a sentinel */
+  scratch->dsq[0] = GT_PDOM_PHMM_ANY;
+  for (i = 0; i < len; i++)
+    scratch->dsq[i+1] = scratch->code[(unsigned char) seq[i]];
+  memset(scratch->mask, 0, (size_t) (len + 1));
+}
+
+/* -- model construction --------------------------------------------------- */
+
+static uint8_t gt_pdom_phmm_unbiased_byteify(const GtPdomPHMM *phmm, float sc)
+{
+  sc = -1.0f * roundf(phmm->scale_b * sc);
+  if (sc > 255.0f) return (uint8_t) 255;
+  if (sc < 0.0f) return (uint8_t) 0;
+  return (uint8_t) sc;
+}
+
+static uint8_t gt_pdom_phmm_biased_byteify(const GtPdomPHMM *phmm, float sc)
+{
+  sc = -1.0f * roundf(phmm->scale_b * sc);
+  if (sc > (float) (255 - phmm->bias_b)) return (uint8_t) 255;
+  return (uint8_t) sc + phmm->bias_b;
+}
+
+static void gt_pdom_phmm_configure(GtPdomPHMM *phmm)
+{
+  GtUword k, q, z, x;
+  float max = 0.0f;
+  gt_assert(phmm && phmm->M > 0);
+
+  /* consensus residues */
+  for (k = 1; k <= phmm->M; k++) {
+    GtUword best = 0;
+    double p, bestp = -1.0;
+    for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++) {
+      p = gt_pdom_phmm_bg[x]
+            * exp((double) phmm->msc[k * GT_PDOM_PHMM_KP + x]);
+      if (p > bestp) {
+        bestp = p;
+        best = x;
+      }
+    }
+    phmm->cons[k] = GT_PDOM_PHMM_ALPHABET[best];
+    if (bestp < 0.5)
+      phmm->cons[k] = (char) tolower((int) phmm->cons[k]);
+  }
+  phmm->cons[phmm->M + 1] = '\0';
+
+  /* striped MSV profile, scores in 1/3 bits */
+  phmm->scale_b = 3.0f / (float) log(2.0);
+  for (k = 1; k <= phmm->M; k++) {
+    for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++)
+      max = MAX(max, phmm->msc[k * GT_PDOM_PHMM_KP + x]);
+  }
+  phmm->bias_b = gt_pdom_phmm_unbiased_byteify(phmm, -1.0f * max);
+  phmm->tbm_b = gt_pdom_phmm_unbiased_byteify(phmm,
+                    (float) log(2.0 / ((double) phmm->M *
+                                       (double) (phmm->M + 1))));
+  phmm->tec_b = gt_pdom_phmm_unbiased_byteify(phmm, (float) log(0.5));
+  phmm->Q = MAX((GtUword) 2, (phmm->M - 1) / GT_PDOM_PHMM_VECWIDTH + 1);
+  phmm->rbv = gt_malloc(sizeof (uint8_t) * GT_PDOM_PHMM_KP * phmm->Q
+                          * GT_PDOM_PHMM_VECWIDTH);
+  for (x = 0; x < (GtUword) GT_PDOM_PHMM_KP; x++) {
+    uint8_t *row = phmm->rbv + x * phmm->Q * GT_PDOM_PHMM_VECWIDTH;
+    for (q = 0; q < phmm->Q; q++) {
+      for (z = 0; z < (GtUword) GT_PDOM_PHMM_VECWIDTH; z++) {
+        /* striped order: vector q, lane z holds node z*Q+q+1 */
+        k = z * phmm->Q + q + 1;
+        row[q * GT_PDOM_PHMM_VECWIDTH + z] =
+          (k <= phmm->M)
+            ? gt_pdom_phmm_biased_byteify(phmm,
+                                          phmm->msc[k * GT_PDOM_PHMM_KP + x])
+            : (uint8_t) 255;
+      }
+    }
+  }
+}
+
+static GtPdomPHMM* gt_pdom_phmm_new(GtUword M)
+{
+  GtPdomPHMM *phmm;
+  GtUword i;
+  phmm = gt_calloc((size_t) 1, sizeof (*phmm));
+  phmm->M = M;
+  phmm->msc = gt_malloc(sizeof (float) * (M + 1) * GT_PDOM_PHMM_KP);
+  phmm->tsc = gt_malloc(sizeof (float) * (M + 1) * GT_PDOM_PHMM_NOF_TRANS);
+  for (i = 0; i < (M + 1) * GT_PDOM_PHMM_KP; i++)
+    phmm->msc[i] = 0.0f;
+  for (i = 0; i < (M + 1) * GT_PDOM_PHMM_NOF_TRANS; i++)
+    phmm->tsc[i] = GT_PDOM_PHMM_NEGINF;
+  phmm->cons = gt_calloc((size_t) M + 2, sizeof (char));
+  phmm->msv_lambda = phmm->vit_lambda = 0.69314718;
+  return phmm;
+}
+
+void gt_pdom_phmm_delete(GtPdomPHMM *phmm)
+{
+  if (!phmm) return;
+  gt_free(phmm->name);
+  gt_free(phmm->msc);
+  gt_free(phmm->tsc);
+  gt_free(phmm->cons);
+  gt_free(phmm->rbv);
+  gt_free(phmm);
+}
+
+/* -- parsing -------------------------------------------------------------- */
+
+/* converts a negative natural log probability from a HMMER3 file, '*' meaning
+   probability zero */
+static int gt_pdom_phmm_parse_logp(const char *tok, float *val)
+{
+  char *end;
+  double v;
+  if (strcmp(tok, "*") == 0) {
+    *val = GT_PDOM_PHMM_NEGINF;
+    return 0;
+  }
+  v = strtod(tok, &end);
+  if (end == tok || *end != '\0')
+    return -1;
+  *val = (float) -v;
+  return 0;
+}
+
+static int gt_pdom_phmm_parse_values(char *line, float *dest, GtUword n,
+                                     GtUword skip, const char *filename,
+                                     GtUword lineno, GtError *err)
+{
+  GtUword i;
+  char *tok, *saveptr = NULL;
+  int had_err = 0;
+  tok = strtok_r(line, " \t", &saveptr);
+  for (i = 0; !had_err && i < skip; i++) {
+    if (tok == NULL)
+      had_err = -1;
+    else
+      tok = strtok_r(NULL, " \t", &saveptr);
+  }
+  for (i = 0; !had_err && i < n; i++) {
+    if (tok == NULL || gt_pdom_phmm_parse_logp(tok, dest + i) != 0)
+      had_err = -1;
+    else
+      tok = strtok_r(NULL, " \t", &saveptr);
+  }
+  if (had_err) {
+    gt_error_set(err, "invalid HMMER3 model data in line "GT_WU" of file %s",
+                 lineno, filename);
+  }
+  return had_err;
+}
+
+static int gt_pdom_phmm_parse_cutoff(const char *line, double *cutoff,
+                                     const char *filename, GtUword lineno,
+                                     GtError *err)
+{
+  double seqcut, domcut;
+  if (sscanf(line + 2, "%lf %lf", &seqcut, &domcut) != 2) {
+    gt_error_set(err, "invalid cutoff line "GT_WU" in file %s", lineno,
+                 filename);
+    return -1;
+  }
+  *cutoff = domcut;
+  return 0;
+}
+
+typedef enum {
+  GT_PDOM_PHMM_PARSE_HEADER,
+  GT_PDOM_PHMM_PARSE_TAGS,
+  GT_PDOM_PHMM_PARSE_TRANSHEADER,
+  GT_PDOM_PHMM_PARSE_NODE0,
+  GT_PDOM_PHMM_PARSE_NODE0_TRANS,
+  GT_PDOM_PHMM_PARSE_MATCH,
+  GT_PDOM_PHMM_PARSE_INSERT,
+  GT_PDOM_PHMM_PARSE_TRANS,
+  GT_PDOM_PHMM_PARSE_END
+} GtPdomPHMMParseState;
+
+int gt_pdom_phmm_parse_file(GtArray *models, const char *filename,
+                            GtError *err)
+{
+  FILE *fp;
+  GtStr *line;
+  GtPdomPHMMParseState state = GT_PDOM_PHMM_PARSE_HEADER;
+  GtPdomPHMM *phmm = NULL;
+  GtUword lineno = 0, k = 0, leng = 0, nof_models = 0;
+  char *name = NULL;
+  bool amino = false;
+  int had_err = 0;
+  gt_assert(models && filename);
+  gt_error_check(err);
+
+  if (!(fp = gt_fa_fopen(filename, "r", err)))
+    return -1;
+  line = gt_str_new();
+  while (!had_err && gt_str_read_next_line(line, fp) != EOF) {
+    char *buf = gt_str_get(line);
+    lineno++;
+    switch (state) {
+      case GT_PDOM_PHMM_PARSE_HEADER:
+        if (gt_str_length(line) == 0)
+          break;
+        if (strncmp(buf, "HMMER3/", (size_t) 7) != 0) {
+          gt_error_set(err, "file %s is not in HMMER3 format (line "GT_WU"), "
+                            "please convert it with 'hmmconvert' first",
+                       filename, lineno);
+          had_err = -1;
+        }
+        leng = 0;
+        amino = false;
+        state = GT_PDOM_PHMM_PARSE_TAGS;
+        break;
+      case GT_PDOM_PHMM_PARSE_TAGS:
+        if (strncmp(buf, "NAME ", (size_t) 5) == 0) {
+          char tmp[BUFSIZ];
+          gt_free(name);
+          name = NULL;
+          if (sscanf(buf + 5, "%s", tmp) == 1)
+            name = gt_cstr_dup(tmp);
+        } else if (strncmp(buf, "LENG ", (size_t) 5) == 0) {
+          if (phmm != NULL || sscanf(buf + 5, GT_WU, &leng) != 1
+                || leng == 0) {
+            gt_error_set(err, "invalid model length in line "GT_WU" of file "
+                              "%s", lineno, filename);
+            had_err = -1;
+          } else
+            phmm = gt_pdom_phmm_new(leng);
+        } else if (strncmp(buf, "ALPH ", (size_t) 5) == 0) {
+          amino = (strstr(buf + 5, "amino") != NULL);
+        } else if (phmm == NULL) {
+          /* all other relevant tags need the model length to be known */
+          if (strncmp(buf, "HMM ", (size_t) 4) == 0
+                || strncmp(buf, "GA ", (size_t) 3) == 0
+                || strncmp(buf, "TC ", (size_t) 3) == 0
+                || strncmp(buf, "STATS ", (size_t) 6) == 0) {
+            gt_error_set(err, "missing LENG line before line "GT_WU" of file "
+                              "%s", lineno, filename);
+            had_err = -1;
+          }
+        } else if (strncmp(buf, "HMM ", (size_t) 4) == 0) {
+          if (name == NULL) {
+            gt_error_set(err, "missing NAME line before line "GT_WU" of file "
+                              "%s", lineno, filename);
+            had_err = -1;
+          } else if (!amino) {
+            gt_error_set(err, "model %s in file %s is not a protein model",
+                         name, filename);
+            had_err = -1;
+          } else {
+            phmm->name = name;
+            name = NULL;
+            state = GT_PDOM_PHMM_PARSE_TRANSHEADER;
+          }
+        } else if (strncmp(buf, "GA ", (size_t) 3) == 0) {
+          had_err = gt_pdom_phmm_parse_cutoff(buf, &phmm->ga, filename,
+                                              lineno, err);
+          phmm->has_ga = (had_err == 0);
+        } else if (strncmp(buf, "TC ", (size_t) 3) == 0) {
+          had_err = gt_pdom_phmm_parse_cutoff(buf, &phmm->tc, filename,
+                                              lineno, err);
+          phmm->has_tc = (had_err == 0);
+        } else if (strncmp(buf, "STATS LOCAL ", (size_t) 12) == 0) {
+          char which[BUFSIZ];
+          double mu, lambda;
+          if (sscanf(buf + 12, "%s %lf %lf", which, &mu, &lambda) != 3) {
+            gt_error_set(err, "invalid STATS line "GT_WU" in file %s", lineno,
+                         filename);
+            had_err = -1;
+          } else if (strcmp(which, "MSV") == 0) {
+            phmm->msv_mu = mu;
+            phmm->msv_lambda = lambda;
+          } else if (strcmp(which, "VITERBI") == 0) {
+            phmm->vit_mu = mu;
+            phmm->vit_lambda = lambda;
+          }
+        }
+        break;
+      case GT_PDOM_PHMM_PARSE_TRANSHEADER:
+        state = GT_PDOM_PHMM_PARSE_NODE0;
+        break;
+      case GT_PDOM_PHMM_PARSE_NODE0:
+        /* optional COMPO line, then node 0 insert emissions */
+        if (strstr(buf, "COMPO") == NULL)
+          state = GT_PDOM_PHMM_PARSE_NODE0_TRANS;
+        break;
+      case GT_PDOM_PHMM_PARSE_NODE0_TRANS:
+        had_err = gt_pdom_phmm_parse_values(buf, phmm->tsc,
+                                            GT_PDOM_PHMM_NOF_TRANS, 0,
+                                            filename, lineno, err);
+        k = 1;
+        state = GT_PDOM_PHMM_PARSE_MATCH;
+        break;
+      case GT_PDOM_PHMM_PARSE_MATCH:
+        {
+          GtUword x;
+          float *msc = phmm->msc + k * GT_PDOM_PHMM_KP;
+          had_err = gt_pdom_phmm_parse_values(buf, msc, GT_PDOM_PHMM_K, 1,
+                                              filename, lineno, err);
+          /* convert log probabilities to log-odds scores */
+          for (x = 0; !had_err && x < (GtUword) GT_PDOM_PHMM_K; x++)
+            msc[x] -= (float) log(gt_pdom_phmm_bg[x]);
+          msc[GT_PDOM_PHMM_ANY] = 0.0f;
+          state = GT_PDOM_PHMM_PARSE_INSERT;
+        }
+        break;
+      case GT_PDOM_PHMM_PARSE_INSERT:
+        /* insert emissions are scored as background */
+        state = GT_PDOM_PHMM_PARSE_TRANS;
+        break;
+      case GT_PDOM_PHMM_PARSE_TRANS:
+        had_err = gt_pdom_phmm_parse_values(buf,
+                                     phmm->tsc + k * GT_PDOM_PHMM_NOF_TRANS,
+                                     GT_PDOM_PHMM_NOF_TRANS, 0,
+                                     filename, lineno, err);
+        if (++k > phmm->M)
+          state = GT_PDOM_PHMM_PARSE_END;
+        else
+          state = GT_PDOM_PHMM_PARSE_MATCH;
+        break;
+      case GT_PDOM_PHMM_PARSE_END:
+        if (strncmp(buf, "//", (size_t) 2) != 0) {
+          gt_error_set(err, "expected '//' in line "GT_WU" of file %s",
+                       lineno, filename);
+          had_err = -1;
+        } else {
+          gt_pdom_phmm_configure(phmm);
+          gt_array_add(models, phmm);
+          nof_models++;
+          phmm = NULL;
+          state = GT_PDOM_PHMM_PARSE_HEADER;
+        }
+        break;
+    }
+    gt_str_reset(line);
+  }
+  if (!had_err && state != GT_PDOM_PHMM_PARSE_HEADER) {
+    gt_error_set(err, "unexpected end of file %s", filename);
+    had_err = -1;
+  }
+  if (!had_err && nof_models == 0) {
+    gt_error_set(err, "no models found in file %s", filename);
+    had_err = -1;
+  }
+  gt_pdom_phmm_delete(phmm);
+  gt_free(name);
+  gt_str_delete(line);
+  gt_fa_fclose(fp);
+  return had_err;
+}
+
+const char* gt_pdom_phmm_get_name(const GtPdomPHMM *phmm)
+{
+  gt_assert(phmm);
+  return phmm->name;
+}
+
+GtUword gt_pdom_phmm_get_length(const GtPdomPHMM *phmm)
+{
+  gt_assert(phmm);
+  return phmm->M;
+}
+
+bool gt_pdom_phmm_get_ga(const GtPdomPHMM *phmm, double *cutoff)
+{
+  gt_assert(phmm && cutoff);
+  if (phmm->has_ga)
+    *cutoff = phmm->ga;
+  return phmm->has_ga;
+}
+
+bool gt_pdom_phmm_get_tc(const GtPdomPHMM *phmm, double *cutoff)
+{
+  gt_assert(phmm && cutoff);
+  if (phmm->has_tc)
+    *cutoff = phmm->tc;
+  return phmm->has_tc;
+}
+
+/* -- statistics ----------------------------------------------------------- */
+
+/* null model score for a sequence of length <L>, in nats */
+static double gt_pdom_phmm_null_score(GtUword L)
+{
+  double l = (double) L;
+  return l * log(l / (l + 1.0)) + log(1.0 / (l + 1.0));
+}
+
+static double gt_pdom_phmm_gumbel_surv(double x, double mu, double lambda)
+{
+  double y = exp(-lambda * (x - mu));
+  /* 1 - exp(-y), accurate for small y */
+  return (y < 1e-7) ? y : 1.0 - exp(-y);
+}
+
+/* -- MSV filter ----------------------------------------------------------- */
+
+static void gt_pdom_phmm_scratch_ensure_dp(GtPdomPHMMScratch *scratch,
+                                           GtUword size)
+{
+  if (size > scratch->dp_alloc) {
+    scratch->dp_alloc = size;
+    scratch->dp = gt_realloc(scratch->dp, (size_t) size);
+  }
+}
+
+#ifdef __SSE2__
+static uint8_t gt_pdom_phmm_hmax_epu8(__m128i a)
+{
+  a = _mm_max_epu8(a, _mm_srli_si128(a, 8));
+  a = _mm_max_epu8(a, _mm_srli_si128(a, 4));
+  a = _mm_max_epu8(a, _mm_srli_si128(a, 2));
+  a = _mm_max_epu8(a, _mm_srli_si128(a, 1));
+  return (uint8_t) _mm_extract_epi16(a, 0);
+}
+
+/* Striped MSV recursion over byte vectors. Returns false on overflow. */
+static bool gt_pdom_phmm_msv_sse(const GtPdomPHMM *phmm,
+                                 const uint8_t *dsq, GtUword L,
+                                 uint8_t tjb, uint8_t *xJ_out,
+                                 GtPdomPHMMScratch *scratch)
+{
+  const GtUword Q = phmm->Q;
+  __m128i *dp, mpv, sv, xEv, xBv, biasv, *rsc;
+  uint8_t xJ = 0, xB, xE;
+  GtUword i, q;
+
+  gt_pdom_phmm_scratch_ensure_dp(scratch, Q * GT_PDOM_PHMM_VECWIDTH);
+  dp = (__m128i*) scratch->dp;
+  for (q = 0; q < Q; q++)
+    _mm_storeu_si128(dp + q, _mm_setzero_si128());
+  biasv = _mm_set1_epi8((char) phmm->bias_b);
+  xB = (uint8_t) GT_PDOM_PHMM_MSV_BASE - tjb;
+
+  for (i = 1; i <= L; i++) {
+    rsc = (__m128i*) (phmm->rbv + dsq[i] * Q * GT_PDOM_PHMM_VECWIDTH);
+    xEv = _mm_setzero_si128();
+    xBv = _mm_subs_epu8(_mm_set1_epi8((char) xB),
+                        _mm_set1_epi8((char) phmm->tbm_b));
+    mpv = _mm_slli_si128(_mm_loadu_si128(dp + Q - 1), 1);
+    for (q = 0; q < Q; q++) {
+      sv = _mm_max_epu8(mpv, xBv);
+      sv = _mm_adds_epu8(sv, biasv);
+      sv = _mm_subs_epu8(sv, _mm_loadu_si128(rsc + q));
+      xEv = _mm_max_epu8(xEv, sv);
+      mpv = _mm_loadu_si128(dp + q);
+      _mm_storeu_si128(dp + q, sv);
+    }
+    xE = gt_pdom_phmm_hmax_epu8(xEv);
+    if (xE >= (uint8_t) (255 - phmm->bias_b))
+      return false;
+    xE = (xE > phmm->tec_b) ? (uint8_t) (xE - phmm->tec_b) : (uint8_t) 0;
+    xJ = MAX(xJ, xE);
+    xB = MAX((uint8_t) GT_PDOM_PHMM_MSV_BASE, xJ);
+    xB = (xB > tjb) ? (uint8_t) (xB - tjb) : (uint8_t) 0;
+  }
+  *xJ_out = xJ;
+  return true;
+}
+#endif
+
+static uint8_t gt_pdom_phmm_adds(uint8_t a, uint8_t b)
+{
+  return (a + b > 255) ? (uint8_t) 255 : (uint8_t) (a + b);
+}
+
+static uint8_t gt_pdom_phmm_subs(uint8_t a, uint8_t b)
+{
+  return (a > b) ? (uint8_t) (a - b) : (uint8_t) 0;
+}
+
+/* Scalar MSV recursion with the same saturating byte arithmetic as the
+   striped version, on an unstriped row (node k at index k). */
+static bool gt_pdom_phmm_msv_scalar(const GtPdomPHMM *phmm,
+                                    const uint8_t *dsq, GtUword L,
+                                    uint8_t tjb, uint8_t *xJ_out,
+                                    GtPdomPHMMScratch *scratch)
+{
+  const GtUword M = phmm->M, Q = phmm->Q;
+  uint8_t *dp, xJ = 0, xB, xE, xBv, sv;
+  GtUword i, k;
+
+  gt_pdom_phmm_scratch_ensure_dp(scratch, M + 1);
+  dp = scratch->dp;
+  memset(dp, 0, (size_t) (M + 1));
+  xB = (uint8_t) GT_PDOM_PHMM_MSV_BASE - tjb;
+
+  for (i = 1; i <= L; i++) {
+    const uint8_t *rsc = phmm->rbv + dsq[i] * Q * GT_PDOM_PHMM_VECWIDTH;
+    xE = 0;
+    xBv = gt_pdom_phmm_subs(xB, phmm->tbm_b);
+    for (k = M; k > 0; k--) {
+      GtUword q = (k - 1) % Q, z = (k - 1) / Q;
+      sv = MAX(dp[k-1], xBv);
+      sv = gt_pdom_phmm_adds(sv, phmm->bias_b);
+      sv = gt_pdom_phmm_subs(sv, rsc[q * GT_PDOM_PHMM_VECWIDTH + z]);
+      xE = MAX(xE, sv);
+      dp[k] = sv;
+    }
+    if (xE >= (uint8_t) (255 - phmm->bias_b))
+      return false;
+    xE = gt_pdom_phmm_subs(xE, phmm->tec_b);
+    xJ = MAX(xJ, xE);
+    xB = gt_pdom_phmm_subs(MAX((uint8_t) GT_PDOM_PHMM_MSV_BASE, xJ), tjb);
+  }
+  *xJ_out = xJ;
+  return true;
+}
+
+static double gt_pdom_phmm_msv_pvalue_digitized(const GtPdomPHMM *phmm,
+                                                const uint8_t *dsq, GtUword L,
+                                                bool use_simd,
+                                                GtPdomPHMMScratch *scratch)
+{
+  uint8_t tjb, xJ = 0;
+  bool ok;
+  double sc;
+  gt_assert(phmm && dsq && scratch);
+  if (L == 0)
+    return 1.0;
+  tjb = gt_pdom_phmm_unbiased_byteify(phmm,
+                                      (float) log(3.0 / (double) (L + 3)));
+#ifdef __SSE2__
+  if (use_simd)
+    ok = gt_pdom_phmm_msv_sse(phmm, dsq, L, tjb, &xJ, scratch);
+  else
+#endif
+    ok = gt_pdom_phmm_msv_scalar(phmm, dsq, L, tjb, &xJ, scratch);
+  (void) use_simd;
+  if (!ok)
+    return 0.0;
+  sc = ((double) xJ - (double) tjb - (double) GT_PDOM_PHMM_MSV_BASE)
+         / (double) phmm->scale_b;
+  sc -= 3.0; /* approximates L log(L/(L+3)) for the N, C and J loops */
+  sc = (sc - gt_pdom_phmm_null_score(L)) / log(2.0);
+  return gt_pdom_phmm_gumbel_surv(sc, phmm->msv_mu, phmm->msv_lambda);
+}
+
+double gt_pdom_phmm_msv_pvalue(const GtPdomPHMM *phmm, const char *seq,
+                               GtUword len, GtPdomPHMMScratch *scratch)
+{
+  gt_assert(phmm && seq && scratch);
+  gt_pdom_phmm_scratch_digitize(scratch, seq, len);
+  return gt_pdom_phmm_msv_pvalue_digitized(phmm, scratch->dsq, len, true,
+                                           scratch);
+}
+
+/* -- Viterbi alignment ---------------------------------------------------- */
+
+#define GT_PDOM_PHMM_TSC(P,K,T) \
+        ((P)->tsc[(K) * GT_PDOM_PHMM_NOF_TRANS + (T)])
+
+/* Computes the best local alignment of <phmm> to the digitized sequence in
+   <scratch>, avoiding masked positions. Returns the score in nats, and
+   stores the end coordinates of the alignment. */
+static float gt_pdom_phmm_viterbi(const GtPdomPHMM *phmm, GtUword L,
+                                  GtUword *iend, GtUword *kend,
+                                  GtPdomPHMMScratch *scratch)
+{
+  const GtUword M = phmm->M;
+  float *prevM, *prevI, *prevD, *curM, *curI, *curD, *tmp,
+        tloop, tmove, tbm, best = GT_PDOM_PHMM_NEGINF;
+  GtUword i, k;
+
+  if (3 * (M + 1) * 2 > scratch->rows_alloc) {
+    scratch->rows_alloc = 3 * (M + 1) * 2;
+    scratch->rows = gt_realloc(scratch->rows,
+                               sizeof (float) * scratch->rows_alloc);
+  }
+  if ((L + 1) * (M + 1) > scratch->tb_alloc) {
+    scratch->tb_alloc = (L + 1) * (M + 1);
+    scratch->tb = gt_realloc(scratch->tb, (size_t) scratch->tb_alloc);
+  }
+  prevM = scratch->rows;
+  prevI = prevM + (M + 1);
+  prevD = prevI + (M + 1);
+  curM = prevD + (M + 1);
+  curI = curM + (M + 1);
+  curD = curI + (M + 1);
+  for (k = 0; k <= M; k++)
+    prevM[k] = prevI[k] = prevD[k] = curM[k] = curI[k] = curD[k]
+             = GT_PDOM_PHMM_NEGINF;
+
+  /* unihit local configuration for target length L */
+  tloop = (float) log((double) L / (double) (L + 2));
+  tmove = (float) log(2.0 / (double) (L + 2));
+  tbm = (float) log(2.0 / ((double) M * (double) (M + 1)));
+
+  for (i = 1; i <= L; i++) {
+    const uint8_t x = scratch->dsq[i];
+    const float *msc = phmm->msc;
+    uint8_t *tb = scratch->tb + i * (M + 1);
+    const bool masked = (scratch->mask[i] != 0);
+    float entry = (float) (i - 1) * tloop + tmove + tbm,
+          exitsc = (float) (L - i) * tloop + tmove;
+
+    curM[0] = curI[0] = curD[0] = GT_PDOM_PHMM_NEGINF;
+    for (k = 1; k <= M; k++) {
+      float sc, cand;
+      uint8_t flags = (uint8_t) GT_PDOM_PHMM_TB_FROM_B;
+
+      if (masked) {
+        curM[k] = curI[k] = GT_PDOM_PHMM_NEGINF;
+      } else {
+        sc = entry;
+        cand = prevM[k-1] + GT_PDOM_PHMM_TSC(phmm, k-1, GT_PDOM_PHMM_MM);
+        if (k > 1 && cand > sc) {
+          sc = cand;
+          flags = (uint8_t) GT_PDOM_PHMM_TB_FROM_M;
+        }
+        cand = prevI[k-1] + GT_PDOM_PHMM_TSC(phmm, k-1, GT_PDOM_PHMM_IM);
+        if (k > 1 && cand > sc) {
+          sc = cand;
+          flags = (uint8_t) GT_PDOM_PHMM_TB_FROM_I;
+        }
+        cand = prevD[k-1] + GT_PDOM_PHMM_TSC(phmm, k-1, GT_PDOM_PHMM_DM);
+        if (k > 1 && cand > sc) {
+          sc = cand;
+          flags = (uint8_t) GT_PDOM_PHMM_TB_FROM_D;
+        }
+        curM[k] = sc + msc[k * GT_PDOM_PHMM_KP + x];
+
+        if (k < M) {
+          sc = prevM[k] + GT_PDOM_PHMM_TSC(phmm, k, GT_PDOM_PHMM_MI);
+          cand = prevI[k] + GT_PDOM_PHMM_TSC(phmm, k, GT_PDOM_PHMM_II);
+          if (cand > sc) {
+            sc = cand;
+            flags |= (uint8_t) GT_PDOM_PHMM_TB_II;
+          }
+          curI[k] = MAX(sc, GT_PDOM_PHMM_NEGINF);
+        } else curI[k] = GT_PDOM_PHMM_NEGINF;
+      }
+
+      if (k > 1) {
+        sc = curM[k-1] + GT_PDOM_PHMM_TSC(phmm, k-1, GT_PDOM_PHMM_MD);
+        cand = curD[k-1] + GT_PDOM_PHMM_TSC(phmm, k-1, GT_PDOM_PHMM_DD);
+        if (cand > sc) {
+          sc = cand;
+          flags |= (uint8_t) GT_PDOM_PHMM_TB_DD;
+        }
+        curD[k] = MAX(sc, GT_PDOM_PHMM_NEGINF);
+      } else curD[k] = GT_PDOM_PHMM_NEGINF;
+      tb[k] = flags;
+
+      if (curM[k] + exitsc > best) {
+        best = curM[k] + exitsc;
+        *iend = i;
+        *kend = k;
+      }
+    }
+    tmp = prevM; prevM = curM; curM = tmp;
+    tmp = prevI; prevI = curI; curI = tmp;
+    tmp = prevD; prevD = curD; curD = tmp;
+  }
+  return best;
+}
+
+/* Traces back from (<i>, <k>) in the match state, storing the edit operations
+   in reverse order in <scratch>. Returns the number of operations. */
+static GtUword gt_pdom_phmm_traceback(const GtPdomPHMM *phmm, GtUword i,
+                                      GtUword k, GtUword *ibeg, GtUword *kbeg,
+                                      GtPdomPHMMScratch *scratch)
+{
+  const GtUword M = phmm->M;
+  GtPdomPHMMOp state = GT_PDOM_PHMM_OP_MATCH;
+  GtUword nof_ops = 0;
+  bool done = false;
+
+  while (!done) {
+    uint8_t flags = scratch->tb[i * (M + 1) + k];
+    gt_assert(i > 0 && k > 0);
+    if (nof_ops + 1 > scratch->ops_alloc) {
+      scratch->ops_alloc = 2 * scratch->ops_alloc + 64;
+      scratch->ops = gt_realloc(scratch->ops,
+                                sizeof (GtPdomPHMMOp) * scratch->ops_alloc);
+    }
+    scratch->ops[nof_ops++] = state;
+    switch (state) {
+      case GT_PDOM_PHMM_OP_MATCH:
+        switch (flags & GT_PDOM_PHMM_TB_MMASK) {
+          case GT_PDOM_PHMM_TB_FROM_B:
+            *ibeg = i;
+            *kbeg = k;
+            done = true;
+            break;
+          case GT_PDOM_PHMM_TB_FROM_M:
+            state = GT_PDOM_PHMM_OP_MATCH;
+            break;
+          case GT_PDOM_PHMM_TB_FROM_I:
+            state = GT_PDOM_PHMM_OP_INSERT;
+            break;
+          default:
+            state = GT_PDOM_PHMM_OP_DELETE;
+        }
+        i--; k--;
+        break;
+      case GT_PDOM_PHMM_OP_INSERT:
+        if (!(flags & GT_PDOM_PHMM_TB_II))
+          state = GT_PDOM_PHMM_OP_MATCH;
+        i--;
+        break;
+      case GT_PDOM_PHMM_OP_DELETE:
+        if (!(flags & GT_PDOM_PHMM_TB_DD))
+          state = GT_PDOM_PHMM_OP_MATCH;
+        k--;
+        break;
+    }
+  }
+  return nof_ops;
+}
+
+static void gt_pdom_phmm_format_alignment(const GtPdomPHMM *phmm,
+                                          const char *seq,
+                                          const char *seqname,
+                                          GtPdomPHMMDomain *dom,
+                                          GtUword nof_ops,
+                                          GtPdomPHMMScratch *scratch)
+{
+  GtUword i = dom->alifrom, k = dom->hmmfrom, col, width, namewidth,
+          blockstart_i, blockstart_k, pos;
+  char mline[GT_PDOM_PHMM_ALIWIDTH + 1],
+       aline[GT_PDOM_PHMM_ALIWIDTH + 1],
+       tline[GT_PDOM_PHMM_ALIWIDTH + 1],
+       buf[BUFSIZ];
+
+  namewidth = MAX(strlen(phmm->name), strlen(seqname));
+  col = 0;
+  pos = nof_ops;
+  while (pos > 0) {
+    blockstart_i = i;
+    blockstart_k = k;
+    for (width = 0; pos > 0 && width < (GtUword) GT_PDOM_PHMM_ALIWIDTH;
+         width++) {
+      GtPdomPHMMOp op = scratch->ops[--pos];
+      char res = (char) toupper((int) seq[i-1]),
+           cons = phmm->cons[k];
+      switch (op) {
+        case GT_PDOM_PHMM_OP_MATCH:
+          mline[width] = cons;
+          tline[width] = res;
+          if (res == cons)
+            aline[width] = res;
+          else if (phmm->msc[k * GT_PDOM_PHMM_KP + scratch->dsq[i]] > 0.0f)
+            aline[width] = '+';
+          else
+            aline[width] = ' ';
+          gt_str_append_char(dom->aastring, res == '*' ? 'X' : res);
+          i++; k++;
+          break;
+        case GT_PDOM_PHMM_OP_INSERT:
+          mline[width] = '.';
+          tline[width] = (char) tolower((int) res);
+          aline[width] = ' ';
+          gt_str_append_char(dom->aastring, res == '*' ? 'X' : res);
+          i++;
+          break;
+        case GT_PDOM_PHMM_OP_DELETE:
+          mline[width] = cons;
+          tline[width] = '-';
+          aline[width] = ' ';
+          k++;
+          break;
+      }
+    }
+    mline[width] = aline[width] = tline[width] = '\0';
+    if (col > 0)
+      gt_str_append_char(dom->alignment, '\n');
+    (void) snprintf(buf, BUFSIZ, "%*s %5"GT_WUS" %s "GT_WU"\n", (int) namewidth,
+                    phmm->name, blockstart_k, mline,
+                    k - 1);
+    gt_str_append_cstr(dom->alignment, buf);
+    (void) snprintf(buf, BUFSIZ, "%*s       %s\n", (int) namewidth, "",
+                    aline);
+    gt_str_append_cstr(dom->alignment, buf);
+    (void) snprintf(buf, BUFSIZ, "%*s %5"GT_WUS" %s "GT_WU"\n", (int) namewidth,
+                    seqname, blockstart_i, tline,
+                    i - 1);
+    gt_str_append_cstr(dom->alignment, buf);
+    col++;
+  }
+}
+
+GtUword gt_pdom_phmm_find_domains(const GtPdomPHMM *phmm,
+                                  const char *seq, GtUword len,
+                                  const char *seqname, GtUword dbsize,
+                                  double min_score, double max_evalue,
+                                  GtUword maxdomains, GtArray *domains,
+                                  GtPdomPHMMScratch *scratch)
+{
+  GtUword nof_domains = 0;
+  double nullsc;
+  gt_assert(phmm && seq && seqname && domains && scratch);
+
+  if (len == 0)
+    return 0;
+  gt_pdom_phmm_scratch_digitize(scratch, seq, len);
+  nullsc = gt_pdom_phmm_null_score(len);
+  while (nof_domains < maxdomains) {
+    GtPdomPHMMDomain dom;
+    GtUword iend = 0, kend = 0, ibeg = 0, kbeg = 0, nof_ops, i;
+    float sc;
+
+    sc = gt_pdom_phmm_viterbi(phmm, len, &iend, &kend, scratch);
+    if (sc <= GT_PDOM_PHMM_NEGINF / 2)
+      break;
+    dom.score = ((double) sc - nullsc) / log(2.0);
+    dom.evalue = (double) dbsize
+                   * gt_pdom_phmm_gumbel_surv(dom.score, phmm->vit_mu,
+                                              phmm->vit_lambda);
+    if (dom.score < min_score || dom.evalue > max_evalue)
+      break;
+    nof_ops = gt_pdom_phmm_traceback(phmm, iend, kend, &ibeg, &kbeg, scratch);
+    dom.alifrom = ibeg;
+    dom.alito = iend;
+    dom.hmmfrom = kbeg;
+    dom.hmmto = kend;
+    dom.alignment = gt_str_new();
+    dom.aastring = gt_str_new();
+    gt_pdom_phmm_format_alignment(phmm, seq, seqname, &dom, nof_ops, scratch);
+    gt_array_add(domains, dom);
+    nof_domains++;
+    /* exclude this domain from further searches */
+    for (i = ibeg; i <= iend; i++)
+      scratch->mask[i] = (uint8_t) 1;
+  }
+  return nof_domains;
+}
+
+void gt_pdom_phmm_domain_clean(GtPdomPHMMDomain *domain)
+{
+  if (!domain) return;
+  gt_str_delete(domain->alignment);
+  gt_str_delete(domain->aastring);
+  domain->alignment = domain->aastring = NULL;
+}
+
+/* -- unit test ------------------------------------------------------------ */
+
+/* writes a model of length <len> strongly preferring the residues in
+   <cons> */
+static void gt_pdom_phmm_write_test_model(FILE *fp, const char *name,
+                                          const char *cons)
+{
+  GtUword k, x, len = (GtUword) strlen(cons);
+  fprintf(fp, "HMMER3/f [3.1b1 | February 2013]\nNAME  %s\nLENG  "GT_WU"\n"
+              "ALPH  amino\nGA    20.00 20.00;\n"
+              "STATS LOCAL MSV      -9.0000  0.69315\n"
+              "STATS LOCAL VITERBI  -9.5000  0.69315\n"
+              "STATS LOCAL FORWARD  -4.0000  0.69315\n"
+              "HMM          A        C        D        E        F        G"
+              "        H        I        K        L        M        N        P"
+              "        Q        R        S        T        V        W        Y"
+              "\n            m->m     m->i     m->d     i->m     i->i     d->m"
+              "     d->d\n", name, len);
+  fprintf(fp, "  COMPO  ");
+  for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++)
+    fprintf(fp, " %.5f", -log(gt_pdom_phmm_bg[x]));
+  fprintf(fp, "\n         ");
+  for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++)
+    fprintf(fp, " %.5f", -log(gt_pdom_phmm_bg[x]));
+  fprintf(fp, "\n          0.01000  5.00000  5.00000  0.61958  0.77255  "
+              "0.00000        *\n");
+  for (k = 1; k <= len; k++) {
+    fprintf(fp, " %6"GT_WUS"  ", k);
+    for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++) {
+      fprintf(fp, " %.5f", GT_PDOM_PHMM_ALPHABET[x] == cons[k-1]
+                             ? -log(0.81) : -log(0.01));
+    }
+    fprintf(fp, "  "GT_WU" %c - -\n         ", k, cons[k-1]);
+    for (x = 0; x < (GtUword) GT_PDOM_PHMM_K; x++)
+      fprintf(fp, " %.5f", -log(gt_pdom_phmm_bg[x]));
+    if (k < len) {
+      fprintf(fp, "\n          0.01000  5.00000  5.00000  0.61958  0.77255  "
+                  "0.48576  0.95510\n");
+    } else {
+      fprintf(fp, "\n          0.00500  5.29832        *  0.61958  0.77255  "
+                  "0.00000        *\n");
+    }
+  }
+  fprintf(fp, "//\n");
+}
+
+int gt_pdom_phmm_unit_test(GtError *err)
+{
+  int had_err = 0;
+  const char *cons = "WHKWCMPYFWHKRCWMEPCQ",
+             *hit = "GSAGSAGSAGSAGSAWHKWCMPYFWHKRCWMEPCQGSAGSAGSAGSAGSA",
+             *ins = "GSAGSAGSAGSAGSAWHKWCMPYFWGGHKRCWMEPCQGSAGSAGSAGSAGSA",
+             *nohit = "GSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSAGSA";
+  GtArray *models, *doms;
+  GtPdomPHMMScratch *scratch;
+  GtPdomPHMM *phmm = NULL;
+  GtPdomPHMMDomain *dom;
+  GtStr *tmpfilename;
+  FILE *tmpfp;
+  GtUword i;
+  double cutoff = 0.0;
+  gt_error_check(err);
+
+  models = gt_array_new(sizeof (GtPdomPHMM*));
+  doms = gt_array_new(sizeof (GtPdomPHMMDomain));
+  scratch = gt_pdom_phmm_scratch_new();
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_pdom_phmm_write_test_model(tmpfp, "testmodel", cons);
+  gt_fa_xfclose(tmpfp);
+
+  had_err = gt_pdom_phmm_parse_file(models, gt_str_get(tmpfilename), err);
+  gt_ensure(gt_array_size(models) == 1);
+  if (!had_err) {
+    phmm = *(GtPdomPHMM**) gt_array_get(models, 0);
+    gt_ensure(strcmp(gt_pdom_phmm_get_name(phmm), "testmodel") == 0);
+    gt_ensure(gt_pdom_phmm_get_length(phmm) == strlen(cons));
+    gt_ensure(gt_pdom_phmm_get_ga(phmm, &cutoff) && cutoff == 20.0);
+    gt_ensure(!gt_pdom_phmm_get_tc(phmm, &cutoff));
+    gt_ensure(strcmp(phmm->cons + 1, cons) == 0);
+  }
+
+  /* striped and scalar MSV must agree */
+  if (!had_err) {
+    const char *seqs[3];
+    seqs[0] = hit; seqs[1] = ins; seqs[2] = nohit;
+    for (i = 0; !had_err && i < 3; i++) {
+      double p1, p2;
+      GtUword len = (GtUword) strlen(seqs[i]);
+      gt_pdom_phmm_scratch_digitize(scratch, seqs[i], len);
+      p1 = gt_pdom_phmm_msv_pvalue_digitized(phmm, scratch->dsq, len, true,
+                                             scratch);
+      p2 = gt_pdom_phmm_msv_pvalue_digitized(phmm, scratch->dsq, len, false,
+                                             scratch);
+      gt_ensure(p1 == p2);
+    }
+    gt_ensure(gt_pdom_phmm_msv_pvalue(phmm, hit, strlen(hit), scratch)
+                < gt_pdom_phmm_msv_pvalue(phmm, nohit, strlen(nohit),
+                                          scratch));
+  }
+
+  /* exact domain hit */
+  if (!had_err) {
+    gt_ensure(gt_pdom_phmm_find_domains(phmm, hit, strlen(hit), "seq", 1,
+                                        0.0, 1.0, 5, doms, scratch) == 1);
+    if (!had_err) {
+      dom = gt_array_get(doms, 0);
+      gt_ensure(dom->hmmfrom == 1 && dom->hmmto == strlen(cons));
+      gt_ensure(dom->alifrom == 16 && dom->alito == 15 + strlen(cons));
+      gt_ensure(strcmp(gt_str_get(dom->aastring), cons) == 0);
+      gt_ensure(dom->score > 20.0);
+    }
+    for (i = 0; i < gt_array_size(doms); i++)
+      gt_pdom_phmm_domain_clean(gt_array_get(doms, i));
+    gt_array_reset(doms);
+  }
+
+  /* domain hit with an insertion */
+  if (!had_err) {
+    gt_ensure(gt_pdom_phmm_find_domains(phmm, ins, strlen(ins), "seq", 1,
+                                        10.0, 1.0, 5, doms, scratch) == 1);
+    if (!had_err) {
+      dom = gt_array_get(doms, 0);
+      gt_ensure(dom->hmmfrom == 1 && dom->hmmto == strlen(cons));
+      gt_ensure(dom->alifrom == 16 && dom->alito == 17 + strlen(cons));
+      gt_ensure(gt_str_length(dom->aastring) == strlen(cons) + 2);
+    }
+    for (i = 0; i < gt_array_size(doms); i++)
+      gt_pdom_phmm_domain_clean(gt_array_get(doms, i));
+    gt_array_reset(doms);
+  }
+
+  /* no hit */
+  if (!had_err) {
+    gt_ensure(gt_pdom_phmm_find_domains(phmm, nohit, strlen(nohit), "seq", 1,
+                                        0.0, 1e-3, 5, doms, scratch) == 0);
+  }
+
+  for (i = 0; i < gt_array_size(models); i++)
+    gt_pdom_phmm_delete(*(GtPdomPHMM**) gt_array_get(models, i));
+  gt_array_delete(models);
+  gt_array_delete(doms);
+  gt_pdom_phmm_scratch_delete(scratch);
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
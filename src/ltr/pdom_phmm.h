@@ -0,0 +1,90 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PDOM_PHMM_H
+#define PDOM_PHMM_H
+
+#include <stdbool.h>
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/str_api.h"
+#include "core/types_api.h"
+
+/* The <GtPdomPHMM> class represents a protein profile HMM read from a
+   HMMER3 (ASCII) model file, configured for local alignment and ready to be
+   scored against amino acid sequences without calling external HMMER
+   binaries. Scoring consists of a striped MSV (multi-segment ungapped
+   Viterbi) byte filter, vectorized with SSE2 where available, followed by a
+   local Viterbi alignment with traceback for sequences passing the filter. */
+typedef struct GtPdomPHMM GtPdomPHMM;
+
+/* The <GtPdomPHMMScratch> class holds DP buffers which can be reused across
+   many calls to the scoring functions. Each thread needs its own. */
+typedef struct GtPdomPHMMScratch GtPdomPHMMScratch;
+
+/* A single local domain alignment between a model and a sequence. */
+typedef struct {
+  GtUword hmmfrom, hmmto, /* 1-based model coordinates */
+          alifrom, alito; /* 1-based sequence coordinates */
+  double score,           /* bit score */
+         evalue;
+  GtStr *alignment,       /* human readable alignment display */
+        *aastring;        /* aligned sequence residues, gaps removed */
+} GtPdomPHMMDomain;
+
+/* Reads all models from the HMMER3 ASCII file <filename> and appends them to
+   <models> (an array of <GtPdomPHMM*>). Returns 0 on success, -1 on error
+   (<err> is set accordingly). */
+int           gt_pdom_phmm_parse_file(GtArray *models, const char *filename,
+                                      GtError *err);
+
+const char*   gt_pdom_phmm_get_name(const GtPdomPHMM *phmm);
+GtUword       gt_pdom_phmm_get_length(const GtPdomPHMM *phmm);
+/* Returns true and stores the per-domain gathering cutoff in <cutoff> if the
+   model has a GA line, returns false otherwise. */
+bool          gt_pdom_phmm_get_ga(const GtPdomPHMM *phmm, double *cutoff);
+/* Like <gt_pdom_phmm_get_ga()>, for the trusted cutoff (TC line). */
+bool          gt_pdom_phmm_get_tc(const GtPdomPHMM *phmm, double *cutoff);
+
+/* Returns the MSV filter P-value of the amino acid sequence <seq> of length
+   <len>. */
+double        gt_pdom_phmm_msv_pvalue(const GtPdomPHMM *phmm, const char *seq,
+                                      GtUword len, GtPdomPHMMScratch *scratch);
+
+/* Searches for up to <maxdomains> non-overlapping local alignments of <phmm>
+   to <seq> in order of decreasing score, and appends them to <domains> (an
+   array of <GtPdomPHMMDomain>). Search stops at the first domain with a bit
+   score below <min_score> or an E-value above <max_evalue>. E-values are
+   computed for a database of <dbsize> models. <seqname> is used as a label
+   in the alignment display. Returns the number of domains added. */
+GtUword       gt_pdom_phmm_find_domains(const GtPdomPHMM *phmm,
+                                        const char *seq, GtUword len,
+                                        const char *seqname, GtUword dbsize,
+                                        double min_score, double max_evalue,
+                                        GtUword maxdomains, GtArray *domains,
+                                        GtPdomPHMMScratch *scratch);
+
+void          gt_pdom_phmm_delete(GtPdomPHMM *phmm);
+
+GtPdomPHMMScratch* gt_pdom_phmm_scratch_new(void);
+void               gt_pdom_phmm_scratch_delete(GtPdomPHMMScratch *scratch);
+
+/* Frees the strings held by <domain>. */
+void          gt_pdom_phmm_domain_clean(GtPdomPHMMDomain *domain);
+
+int           gt_pdom_phmm_unit_test(GtError *err);
+
+#endif
@@ -493,6 +493,7 @@ static GtUword gt_diagbandseed_process_seeds(const GtEncseq *aencseq,
   gt_assert(aencseq != NULL && bencseq != NULL);
 
   info_querymatch.querymatchspaceptr = gt_querymatch_new();
+  info_querymatch.querymatch_table = NULL;
   if (seed_display)
   {
     gt_querymatch_seed_display_set(info_querymatch.querymatchspaceptr);
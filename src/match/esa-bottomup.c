@@ -17,7 +17,11 @@
 */
 
 #include <limits.h>
+#include <string.h>
+#include "core/array.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
 #include "esa-bottomup.h"
 #include "esa-seqread.h"
 #include "esa_visitor.h"
@@ -430,3 +434,385 @@ int gt_esa_bottomup_RAM(const GtUword *suftab,
   stack->nextfreeGtBUItvinfo = 0; /* empty the stack */
   return haserr ? -1 : 0;
 }
+
+/* Number of partitions per thread. Threads fetch the partitions dynamically,
+   so more partitions than threads balance the varying subtree sizes. */
+#define GT_ESA_BOTTOMUP_PARTITIONS_PER_THREAD 16
+
+/* Maximum number of suffixes in a partition (unless no lcp-value below the
+   split depth occurs earlier). The partitions are traversed in rounds of
+   GT_ESA_BOTTOMUP_PARTITIONS_PER_THREAD partitions per thread, so this
+   bounds the part of the suffix array whose results wait for the reducer. */
+#define GT_ESA_BOTTOMUP_PARTITION_MAXWIDTH ((GtUword) 1 << 18)
+
+typedef struct
+{
+  GtUword lb, rb,
+          llvindex; /* first entry of llvtab for lcptab[lb+1..rb] */
+  GtESAVisitor *ev;
+  GtError *err;
+  bool done, haserr;
+} GtBUpartition;
+
+typedef struct
+{
+  const Suffixarray *suffixarray;
+  GtBUpartition *partitions;
+  GtUword numofpartitions,
+          nextpartition,
+          endofround,
+          nextreduce;
+  GtESAPartitionVisitorNewFunc visitor_new;
+  GtESAPartitionReduceFunc reduce;
+  void *data;
+  GtMutex *mutex;
+  GtError *err;
+  bool haserr;
+} GtBUparallelinfo;
+
+static GtUword gt_esa_bottomup_lcpvalue(const Suffixarray *suffixarray,
+                                        GtUword idx,
+                                        GtUword *llvindex)
+{
+  GtUchar smalllcpvalue = suffixarray->lcptab[idx];
+
+  if (smalllcpvalue < (GtUchar) LCPOVERFLOW)
+  {
+    return (GtUword) smalllcpvalue;
+  }
+  gt_assert(suffixarray->llvtab[*llvindex].position == idx);
+  return suffixarray->llvtab[(*llvindex)++].value;
+}
+
+/* Splits the suffixes 0..nonspecials-1 into partitions of about
+   <width> suffixes each. A new partition only starts at a suffix whose lcp
+   with the previous suffix is smaller than <mindepth>. */
+static GtArray *gt_esa_bottomup_partitions(const Suffixarray *suffixarray,
+                                           GtUword nonspecials,
+                                           GtUword mindepth,
+                                           GtUword width)
+{
+  GtArray *partitions = gt_array_new(sizeof (GtBUpartition));
+  GtBUpartition current;
+  GtUword idx, llvindex = 0;
+
+  gt_assert(nonspecials > 0 && mindepth > 0);
+  memset(&current, 0, sizeof current);
+  for (idx = 1UL; idx < nonspecials; idx++)
+  {
+    GtUword nextllvindex = llvindex,
+            lcpvalue = gt_esa_bottomup_lcpvalue(suffixarray, idx,
+                                                &nextllvindex);
+
+    if (lcpvalue < mindepth && idx - current.lb >= width)
+    {
+      current.rb = idx - 1;
+      gt_array_add(partitions, current);
+      current.lb = idx;
+      current.llvindex = nextllvindex;
+    }
+    llvindex = nextllvindex;
+  }
+  current.rb = nonspecials - 1;
+  gt_array_add(partitions, current);
+  return partitions;
+}
+
+/* The bottom-up traversal of the suffixes <lb>..<rb> of a mapped index.
+   The lcp-value of suffix <lb> and of the suffix following <rb> is taken
+   as 0, so all intervals on the stack are processed at the end. The first
+   edge of the fragment of the root is a first edge in every partition. */
+static int gt_esa_bottomup_partition(const Suffixarray *suffixarray,
+                                     GtUword lb,
+                                     GtUword rb,
+                                     GtUword llvindex,
+                                     GtESAVisitor *ev,
+                                     GtError *err)
+{
+  const GtUword incrementstacksize = 32UL;
+  GtUword lcpvalue,
+          previoussuffix = 0,
+          idx;
+  GtBUItvinfo *lastinterval = NULL;
+  bool haserr = false, firstedge, firstedgefromroot = true;
+  GtArrayGtBUItvinfo *stack;
+
+  stack = gt_GtArrayGtBUItvinfo_new();
+  PUSH_ESA_BOTTOMUP(0,lb);
+  for (idx = lb; idx <= rb; idx++)
+  {
+    lcpvalue = idx < rb ? gt_esa_bottomup_lcpvalue(suffixarray, idx + 1,
+                                                   &llvindex)
+                        : 0;
+    previoussuffix = ESASUFFIXPTRGET(suffixarray->suftab,idx);
+    if (lcpvalue <= TOP_ESA_BOTTOMUP.lcp)
+    {
+      if (TOP_ESA_BOTTOMUP.lcp > 0 || !firstedgefromroot)
+      {
+        firstedge = false;
+      } else
+      {
+        firstedge = true;
+        firstedgefromroot = false;
+      }
+      if (gt_esa_visitor_visit_leaf_edge(ev,
+                                         firstedge,
+                                         TOP_ESA_BOTTOMUP.lcp,
+                                         TOP_ESA_BOTTOMUP.lb,
+                                         TOP_ESA_BOTTOMUP.info,
+                                         previoussuffix,
+                                         err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+    }
+    gt_assert(lastinterval == NULL);
+    while (lcpvalue < TOP_ESA_BOTTOMUP.lcp)
+    {
+      lastinterval = POP_ESA_BOTTOMUP;
+      lastinterval->rb = idx;
+      if (gt_esa_visitor_visit_lcp_interval(ev,
+                                            lastinterval->lcp,
+                                            lastinterval->lb,
+                                            lastinterval->rb,
+                                            lastinterval->info,
+                                            err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+      if (lcpvalue <= TOP_ESA_BOTTOMUP.lcp)
+      {
+        if (TOP_ESA_BOTTOMUP.lcp > 0 || !firstedgefromroot)
+        {
+          firstedge = false;
+        } else
+        {
+          firstedge = true;
+          firstedgefromroot = false;
+        }
+        if (gt_esa_visitor_visit_branching_edge(ev,
+                                                firstedge,
+                                                TOP_ESA_BOTTOMUP.lcp,
+                                                TOP_ESA_BOTTOMUP.lb,
+                                                TOP_ESA_BOTTOMUP.info,
+                                                lastinterval->lcp,
+                                                lastinterval->lb,
+                                                lastinterval->rb,
+                                                lastinterval->info,
+                                                err) != 0)
+        {
+          haserr = true;
+          break;
+        }
+        lastinterval = NULL;
+      }
+    }
+    if (haserr)
+    {
+      break;
+    }
+    if (lcpvalue > TOP_ESA_BOTTOMUP.lcp)
+    {
+      if (lastinterval != NULL)
+      {
+        GtUword lastintervallcp = lastinterval->lcp,
+                lastintervallb = lastinterval->lb,
+                lastintervalrb = lastinterval->rb;
+        PUSH_ESA_BOTTOMUP(lcpvalue,lastintervallb);
+        if (gt_esa_visitor_visit_branching_edge(ev,
+                                                true,
+                                                TOP_ESA_BOTTOMUP.lcp,
+                                                TOP_ESA_BOTTOMUP.lb,
+                                                TOP_ESA_BOTTOMUP.info,
+                                                lastintervallcp,
+                                                lastintervallb,
+                                                lastintervalrb,
+                                                NULL,
+                                                err) != 0)
+        {
+          haserr = true;
+          break;
+        }
+        lastinterval = NULL;
+      } else
+      {
+        PUSH_ESA_BOTTOMUP(lcpvalue,idx);
+        if (gt_esa_visitor_visit_leaf_edge(ev,
+                                           true,
+                                           TOP_ESA_BOTTOMUP.lcp,
+                                           TOP_ESA_BOTTOMUP.lb,
+                                           TOP_ESA_BOTTOMUP.info,
+                                           previoussuffix,
+                                           err) != 0)
+        {
+          haserr = true;
+          break;
+        }
+      }
+    }
+  }
+  gt_assert(haserr || (stack->nextfreeGtBUItvinfo == 1UL &&
+                       TOP_ESA_BOTTOMUP.lcp == 0));
+  gt_GtArrayGtBUItvinfo_delete(stack, ev);
+  return haserr ? -1 : 0;
+}
+
+/* Hands all finished partitions to the reducer in the order of the suffix
+   array; must be called with the mutex locked. */
+static void gt_esa_bottomup_parallel_reduce(GtBUparallelinfo *pinfo)
+{
+  while (pinfo->nextreduce < pinfo->numofpartitions &&
+         pinfo->partitions[pinfo->nextreduce].done)
+  {
+    GtBUpartition *partition = pinfo->partitions + pinfo->nextreduce;
+
+    if (!pinfo->haserr)
+    {
+      if (partition->haserr)
+      {
+        gt_error_set(pinfo->err,"%s",gt_error_get(partition->err));
+        pinfo->haserr = true;
+      } else
+      {
+        if (pinfo->reduce(pinfo->data,partition->ev,partition->lb,
+                          partition->rb,pinfo->err) != 0)
+        {
+          pinfo->haserr = true;
+        }
+      }
+    }
+    gt_esa_visitor_delete(partition->ev);
+    partition->ev = NULL;
+    gt_error_delete(partition->err);
+    partition->err = NULL;
+    pinfo->nextreduce++;
+  }
+}
+
+static void *gt_esa_bottomup_parallel_thread(void *data)
+{
+  GtBUparallelinfo *pinfo = data;
+
+  for (;;)
+  {
+    GtBUpartition *partition;
+
+    gt_mutex_lock(pinfo->mutex);
+    if (pinfo->haserr || pinfo->nextpartition >= pinfo->endofround)
+    {
+      gt_mutex_unlock(pinfo->mutex);
+      break;
+    }
+    partition = pinfo->partitions + pinfo->nextpartition++;
+    gt_mutex_unlock(pinfo->mutex);
+    partition->err = gt_error_new();
+    partition->ev = pinfo->visitor_new(pinfo->data,partition->lb,
+                                       partition->rb,partition->err);
+    if (partition->ev == NULL ||
+        gt_esa_bottomup_partition(pinfo->suffixarray,
+                                  partition->lb,
+                                  partition->rb,
+                                  partition->llvindex,
+                                  partition->ev,
+                                  partition->err) != 0)
+    {
+      partition->haserr = true;
+    }
+    gt_mutex_lock(pinfo->mutex);
+    partition->done = true;
+    gt_esa_bottomup_parallel_reduce(pinfo);
+    gt_mutex_unlock(pinfo->mutex);
+  }
+  return NULL;
+}
+
+int gt_esa_bottomup_parallel(Sequentialsuffixarrayreader *ssar,
+                             GtUword mindepth,
+                             unsigned int threads,
+                             GtESAPartitionVisitorNewFunc visitor_new,
+                             GtESAPartitionReduceFunc reduce,
+                             void *data,
+                             GtError *err)
+{
+  GtUword nonspecials = gt_Sequentialsuffixarrayreader_nonspecials(ssar);
+  bool haserr = false;
+
+  gt_error_check(err);
+  gt_assert(mindepth > 0 && visitor_new != NULL && reduce != NULL);
+  if (threads <= 1U || ssar->scanfile || nonspecials == 0)
+  {
+    GtESAVisitor *ev = visitor_new(data,0,
+                                   nonspecials > 0 ? nonspecials - 1 : 0,
+                                   err);
+
+    if (ev == NULL || gt_esa_bottomup(ssar, ev, err) != 0 ||
+        reduce(data,ev,0,nonspecials > 0 ? nonspecials - 1 : 0,err) != 0)
+    {
+      haserr = true;
+    }
+    gt_esa_visitor_delete(ev);
+  } else
+  {
+    GtBUparallelinfo pinfo;
+    GtArray *partitions;
+    GtThread **threadtab;
+    const GtUword partitionsperround
+      = (GtUword) threads * GT_ESA_BOTTOMUP_PARTITIONS_PER_THREAD;
+    GtUword width = nonspecials / partitionsperround;
+    unsigned int t;
+
+    width = MIN(width, GT_ESA_BOTTOMUP_PARTITION_MAXWIDTH);
+    partitions = gt_esa_bottomup_partitions(ssar->suffixarray,
+                                            nonspecials,
+                                            mindepth,
+                                            MAX(width, 1UL));
+    pinfo.suffixarray = ssar->suffixarray;
+    pinfo.partitions = gt_array_get_space(partitions);
+    pinfo.numofpartitions = gt_array_size(partitions);
+    pinfo.nextpartition = pinfo.nextreduce = 0;
+    pinfo.visitor_new = visitor_new;
+    pinfo.reduce = reduce;
+    pinfo.data = data;
+    pinfo.mutex = gt_mutex_new();
+    pinfo.err = err;
+    pinfo.haserr = false;
+    threadtab = gt_calloc((size_t) threads, sizeof *threadtab);
+    /* the threads are joined after each round, so no thread runs more than
+       <partitionsperround> partitions ahead of the reducer */
+    while (!pinfo.haserr && pinfo.nextpartition < pinfo.numofpartitions)
+    {
+      pinfo.endofround = MIN(pinfo.nextpartition + partitionsperround,
+                             pinfo.numofpartitions);
+      /* the current thread processes partitions as well; if a thread
+         cannot be created, the remaining threads take over its share */
+      for (t = 1U; t < threads; t++)
+      {
+        GtError *threaderr = gt_error_new();
+
+        threadtab[t] = gt_thread_new(gt_esa_bottomup_parallel_thread,&pinfo,
+                                     threaderr);
+        gt_error_delete(threaderr);
+      }
+      (void) gt_esa_bottomup_parallel_thread(&pinfo);
+      for (t = 1U; t < threads; t++)
+      {
+        if (threadtab[t] != NULL)
+        {
+#ifdef GT_THREADS_ENABLED
+          gt_thread_join(threadtab[t]);
+#endif
+          gt_thread_delete(threadtab[t]);
+          threadtab[t] = NULL;
+        }
+      }
+      gt_assert(pinfo.nextreduce == pinfo.nextpartition);
+    }
+    haserr = pinfo.haserr;
+    gt_free(threadtab);
+    gt_mutex_delete(pinfo.mutex);
+    gt_array_delete(partitions);
+  }
+  return haserr ? -1 : 0;
+}
@@ -32,6 +32,44 @@ int gt_esa_bottomup(Sequentialsuffixarrayreader *ssar,
                     GtESAVisitor *ev,
                     GtError *err);
 
+/* Creates the visitor for the partition of the suffixes <lb>..<rb>. Returns
+   NULL and sets <err> on error. */
+typedef GtESAVisitor *(*GtESAPartitionVisitorNewFunc)(void *data,
+                                                      GtUword lb,
+                                                      GtUword rb,
+                                                      GtError *err);
+
+/* Merges the results of the visitor <ev> for the partition <lb>..<rb> into
+   <data>. Returns 0 on success and -1 on error (with <err> set). */
+typedef int (*GtESAPartitionReduceFunc)(void *data,
+                                        GtESAVisitor *ev,
+                                        GtUword lb,
+                                        GtUword rb,
+                                        GtError *err);
+
+/* Parallel version of <gt_esa_bottomup> using <threads> threads. The suffix
+   array is split into partitions which only start at suffixes whose lcp with
+   the previous suffix is smaller than <mindepth> (> 0). Each partition is
+   traversed with its own stack and its own visitor created by <visitor_new>,
+   as if it were a suffix array on its own, but with the indexes of the whole
+   suffix array. So all lcp-intervals with lcp at least <mindepth> and the
+   edges leaving them are visited exactly as by <gt_esa_bottomup>, while the
+   intervals with a smaller lcp are split into one fragment per partition.
+   The visitors are handed to <reduce> and deleted afterwards. The calls of
+   <reduce> are serialized and follow the order of the partitions in the
+   suffix array, so the result does not depend on the number of threads.
+   The partitions are traversed in rounds of a bounded size, so only the
+   visitors of one round wait for <reduce> at any time.
+   If <threads> is 1 or the index is not mapped, <gt_esa_bottomup> is called
+   with a single visitor for all suffixes. */
+int gt_esa_bottomup_parallel(Sequentialsuffixarrayreader *ssar,
+                             GtUword mindepth,
+                             unsigned int threads,
+                             GtESAPartitionVisitorNewFunc visitor_new,
+                             GtESAPartitionReduceFunc reduce,
+                             void *data,
+                             GtError *err);
+
 GtArrayGtBUItvinfo *gt_GtArrayGtBUItvinfo_new(void);
 
 void gt_GtArrayGtBUItvinfo_delete(GtArrayGtBUItvinfo *stack,
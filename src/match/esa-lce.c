@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/compact_ulong_store.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "extended/rmq_succinct.h"
+#include "esa-lce.h"
+
+struct GtLCE
+{
+  const Suffixarray *suffixarray;
+  GtCompactUlongStore *inverse_suftab;
+  GtRMQSuccinct *rmq;
+  GtUword totallength;
+  unsigned int bitsperentry;
+};
+
+static GtUword gt_lce_lcptable_get(const void *data, GtUword idx)
+{
+  return lcptable_get((const Suffixarray *) data, idx);
+}
+
+GtLCE* gt_lce_new(const Suffixarray *suffixarray, GtError *err)
+{
+  GtLCE *lce;
+  GtUword idx, totallength;
+
+  gt_error_check(err);
+  gt_assert(suffixarray != NULL && suffixarray->encseq != NULL);
+  totallength = gt_encseq_total_length(suffixarray->encseq);
+  if (suffixarray->suftab == NULL || suffixarray->lcptab == NULL)
+  {
+    gt_error_set(err,"longest common extension queries require the suffix "
+                     "table and the lcp-table");
+    return NULL;
+  }
+  if (suffixarray->numberofallsortedsuffixes != totallength + 1)
+  {
+    gt_error_set(err,"longest common extension queries require the suffix "
+                     "table for all "GT_WU" suffixes", totallength + 1);
+    return NULL;
+  }
+  lce = gt_malloc(sizeof *lce);
+  lce->suffixarray = suffixarray;
+  lce->totallength = totallength;
+  lce->bitsperentry = gt_determinebitspervalue(totallength);
+  lce->inverse_suftab = gt_compact_ulong_store_new(totallength + 1,
+                                                   lce->bitsperentry);
+  for (idx = 0; idx <= totallength; idx++)
+  {
+    gt_compact_ulong_store_update(lce->inverse_suftab,
+                                  ESASUFFIXPTRGET(suffixarray->suftab,idx),
+                                  idx);
+  }
+  lce->rmq = gt_rmq_succinct_new(gt_lce_lcptable_get, suffixarray,
+                                 totallength + 1);
+  return lce;
+}
+
+GtUword gt_lce_query(const GtLCE *lce, GtUword pos1, GtUword pos2)
+{
+  GtUword rank1, rank2;
+
+  gt_assert(lce != NULL && pos1 != pos2 && pos1 <= lce->totallength &&
+            pos2 <= lce->totallength);
+  rank1 = gt_compact_ulong_store_get(lce->inverse_suftab, pos1);
+  rank2 = gt_compact_ulong_store_get(lce->inverse_suftab, pos2);
+  if (rank1 > rank2)
+  {
+    GtUword tmp = rank1;
+    rank1 = rank2;
+    rank2 = tmp;
+  }
+  /* the lcp-value at index i refers to the suffixes at index i-1 and i */
+  return lcptable_get(lce->suffixarray,
+                      gt_rmq_succinct_find_min_index(lce->rmq, rank1 + 1,
+                                                     rank2));
+}
+
+size_t gt_lce_size(const GtLCE *lce)
+{
+  gt_assert(lce != NULL);
+  return sizeof (*lce) +
+         gt_compact_ulong_store_size(lce->totallength + 1, lce->bitsperentry) +
+         gt_rmq_succinct_size(lce->rmq);
+}
+
+void gt_lce_delete(GtLCE *lce)
+{
+  if (lce != NULL)
+  {
+    gt_compact_ulong_store_delete(lce->inverse_suftab);
+    gt_rmq_succinct_delete(lce->rmq);
+    gt_free(lce);
+  }
+}
@@ -0,0 +1,52 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ESA_LCE_H
+#define ESA_LCE_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "sarr-def.h"
+
+/* The <GtLCE> class answers longest common extension queries, that is, it
+   determines the length of the longest common prefix of two arbitrary suffixes
+   in constant time. It combines the inverse suffix table, stored with
+   the minimal number of bits per entry, with a <GtRMQSuccinct> over the
+   lcp-table. The lcp-values themselves are read from the mapped lcp-table,
+   so no additional integer array of the length of the sequence is needed. */
+typedef struct GtLCE GtLCE;
+
+/* Returns a new <GtLCE> object for <suffixarray>, which has to be mapped with
+   the suffix table and the lcp-table for all suffixes and has to stay mapped
+   as long as the <GtLCE> object is used. Returns NULL and sets <err> if one
+   of the tables is missing. */
+GtLCE*  gt_lce_new(const Suffixarray *suffixarray, GtError *err);
+
+/* Returns the length of the longest common prefix of the suffixes starting at
+   <pos1> and <pos2> (with respect to the readmode of the suffix array) as
+   stored in the lcp-table, i.e. special characters never match. <pos1> and
+   <pos2> have to be different and must not be larger than the total length
+   of the sequence. */
+GtUword gt_lce_query(const GtLCE *lce, GtUword pos1, GtUword pos2);
+
+/* Returns the size of <lce> in bytes, excluding the mapped tables. */
+size_t  gt_lce_size(const GtLCE *lce);
+
+/* Frees the memory of <lce>. */
+void    gt_lce_delete(GtLCE *lce);
+
+#endif
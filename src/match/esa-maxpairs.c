@@ -16,10 +16,13 @@
 */
 
 #include "core/arraydef.h"
+#include "core/class_alloc_lock.h"
 #include "core/unused_api.h"
 #include "core/minmax.h"
 #include "core/arraydef.h"
 #include "esa-seqread.h"
+#include "esa-bottomup.h"
+#include "esa_visitor_rep.h"
 #include "esa-lcpintervals.h"
 #include "esa-maxpairs.h"
 #include "sfx-sain.h"
@@ -474,19 +477,16 @@ static GtUword gt_ssar_ssli_nonspecials(const Sequentialsuffixarrayreader *ssar,
 
 #include "esa-bottomup-maxpairs.inc"
 
-int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
-                                 GtSainSufLcpIterator *suflcpiterator,
-                                 unsigned int searchlength,
-                                 GtProcessmaxpairs processmaxpairs,
-                                 void *processmaxpairsinfo,
-                                 GtError *err)
+static void gt_maxpairs_state_init(GtBUstate_maxpairs *state,
+                                   const Sequentialsuffixarrayreader *ssar,
+                                   GtSainSufLcpIterator *suflcpiterator,
+                                   unsigned int searchlength,
+                                   GtProcessmaxpairs processmaxpairs,
+                                   void *processmaxpairsinfo)
 {
   unsigned int base;
   GtArrayGtUword *ptr;
-  GtBUstate_maxpairs *state;
-  bool haserr = false;
 
-  state = gt_malloc(sizeof (*state));
   state->searchlength = searchlength;
   state->processmaxpairs = processmaxpairs;
   state->processmaxpairsinfo = processmaxpairsinfo;
@@ -522,10 +522,13 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
     ptr = &state->poslist[base];
     GT_INITARRAY(ptr,GtUword);
   }
-  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
-  {
-    haserr = true;
-  }
+}
+
+static void gt_maxpairs_state_free(GtBUstate_maxpairs *state)
+{
+  unsigned int base;
+  GtArrayGtUword *ptr;
+
   GT_FREEARRAY(&state->uniquechar,GtUword);
   for (base = 0; base < state->alphabetsize; base++)
   {
@@ -533,6 +536,26 @@ int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
     GT_FREEARRAY(ptr,GtUword);
   }
   gt_free(state->poslist);
+}
+
+int gt_enumeratemaxpairs_generic(Sequentialsuffixarrayreader *ssar,
+                                 GtSainSufLcpIterator *suflcpiterator,
+                                 unsigned int searchlength,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 void *processmaxpairsinfo,
+                                 GtError *err)
+{
+  GtBUstate_maxpairs *state;
+  bool haserr = false;
+
+  state = gt_malloc(sizeof (*state));
+  gt_maxpairs_state_init(state,ssar,suflcpiterator,searchlength,
+                         processmaxpairs,processmaxpairsinfo);
+  if (gt_esa_bottomup_maxpairs(ssar, suflcpiterator,  state, err) != 0)
+  {
+    haserr = true;
+  }
+  gt_maxpairs_state_free(state);
   gt_free(state);
   return haserr ? -1 : 0;
 }
@@ -567,6 +590,139 @@ int gt_enumeratemaxpairs_sain(GtSainSufLcpIterator *suflcpiterator,
                                       err);
 }
 
+/* The maxpairs computation as a GtESAVisitor, so that the partitions of
+   <gt_esa_bottomup_parallel> can be processed with their own state. */
+
+typedef struct
+{
+  const GtESAVisitor parent_instance;
+  GtBUstate_maxpairs state;
+  GtMaxpairsPartitionDeleteFunc partition_delete;
+} GtESAMaxpairsVisitor;
+
+typedef struct
+{
+  Sequentialsuffixarrayreader *ssar;
+  unsigned int searchlength;
+  GtProcessmaxpairs processmaxpairs;
+  GtMaxpairsPartitionNewFunc partition_new;
+  GtMaxpairsPartitionReduceFunc partition_reduce;
+  GtMaxpairsPartitionDeleteFunc partition_delete;
+  void *data;
+} GtMaxpairsPartitions;
+
+static const GtESAVisitorClass *gt_esa_maxpairs_visitor_class(void);
+
+#define gt_esa_maxpairs_visitor_cast(GV)\
+        gt_esa_visitor_cast(gt_esa_maxpairs_visitor_class(), GV)
+
+static int gt_esa_maxpairs_visitor_processleafedge(GtESAVisitor *ev,
+                                                   bool firstsucc,
+                                                   GtUword fd,
+                                                   GT_UNUSED GtUword flb,
+                                                   GtESAVisitorInfo *info,
+                                                   GtUword leafnumber,
+                                                   GtError *err)
+{
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+
+  return processleafedge_maxpairs(firstsucc,fd,(GtBUinfo_maxpairs *) info,
+                                  leafnumber,&emv->state,err);
+}
+
+static int gt_esa_maxpairs_visitor_processbranchingedge(GtESAVisitor *ev,
+                                                        bool firstsucc,
+                                                        GtUword fd,
+                                                        GtUword flb,
+                                                        GtESAVisitorInfo *finfo,
+                                                        GtUword sd,
+                                                        GtUword slb,
+                                                        GtUword srb,
+                                                        GtESAVisitorInfo *sinfo,
+                                                        GtError *err)
+{
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+
+  return processbranchingedge_maxpairs(firstsucc,fd,flb,
+                                       (GtBUinfo_maxpairs *) finfo,
+                                       sd,srb - slb + 1,
+                                       (GtBUinfo_maxpairs *) sinfo,
+                                       &emv->state,err);
+}
+
+static GtESAVisitorInfo *gt_esa_maxpairs_visitor_info_new(GtESAVisitor *ev)
+{
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+  GtBUinfo_maxpairs *buinfo = gt_malloc(sizeof (*buinfo));
+
+  initBUinfo_maxpairs(buinfo,&emv->state);
+  return (GtESAVisitorInfo *) buinfo;
+}
+
+static void gt_esa_maxpairs_visitor_info_delete(GtESAVisitorInfo *info,
+                                                GtESAVisitor *ev)
+{
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+  GtBUinfo_maxpairs *buinfo = (GtBUinfo_maxpairs *) info;
+
+  freeBUinfo_maxpairs(buinfo,&emv->state);
+  gt_free(buinfo);
+}
+
+static void gt_esa_maxpairs_visitor_delete(GtESAVisitor *ev)
+{
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+
+  emv->partition_delete(emv->state.processmaxpairsinfo);
+  gt_maxpairs_state_free(&emv->state);
+}
+
+static const GtESAVisitorClass *gt_esa_maxpairs_visitor_class(void)
+{
+  static const GtESAVisitorClass *esc = NULL;
+
+  gt_class_alloc_lock_enter();
+  if (!esc)
+  {
+    esc = gt_esa_visitor_class_new(sizeof (GtESAMaxpairsVisitor),
+                                   gt_esa_maxpairs_visitor_delete,
+                                   gt_esa_maxpairs_visitor_processleafedge,
+                                   gt_esa_maxpairs_visitor_processbranchingedge,
+                                   NULL,
+                                   gt_esa_maxpairs_visitor_info_new,
+                                   gt_esa_maxpairs_visitor_info_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return esc;
+}
+
+static GtESAVisitor *gt_maxpairs_partition_visitor_new(void *data,
+                                                       GT_UNUSED GtUword lb,
+                                                       GT_UNUSED GtUword rb,
+                                                       GT_UNUSED GtError *err)
+{
+  GtMaxpairsPartitions *mpp = (GtMaxpairsPartitions *) data;
+  GtESAVisitor *ev = gt_esa_visitor_create(gt_esa_maxpairs_visitor_class());
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+
+  gt_maxpairs_state_init(&emv->state,mpp->ssar,NULL,mpp->searchlength,
+                         mpp->processmaxpairs,mpp->partition_new(mpp->data));
+  emv->partition_delete = mpp->partition_delete;
+  return ev;
+}
+
+static int gt_maxpairs_partition_reduce(void *data,
+                                        GtESAVisitor *ev,
+                                        GT_UNUSED GtUword lb,
+                                        GT_UNUSED GtUword rb,
+                                        GtError *err)
+{
+  GtMaxpairsPartitions *mpp = (GtMaxpairsPartitions *) data;
+  GtESAMaxpairsVisitor *emv = gt_esa_maxpairs_visitor_cast(ev);
+
+  return mpp->partition_reduce(mpp->data,emv->state.processmaxpairsinfo,err);
+}
+
 static int collectmaxfreqintervals(void *data,const Lcpinterval *lcpitv)
 {
   GtMaxfreqcollect *maxfreqcollect = (GtMaxfreqcollect *) data;
@@ -628,14 +784,16 @@ void showcollectedintervals(const Lcpinterval *itvtab,GtUword num)
   }
 }
 
-int gt_callenummaxpairs(const char *indexname,
-                        unsigned int userdefinedleastlength,
-                        GtUword maxfreq,
-                        bool scanfile,
-                        GtProcessmaxpairs processmaxpairs,
-                        void *processmaxpairsinfo,
-                        GtLogger *logger,
-                        GtError *err)
+static int gt_callenummaxpairs_generic(const char *indexname,
+                                       unsigned int userdefinedleastlength,
+                                       GtUword maxfreq,
+                                       bool scanfile,
+                                       unsigned int threads,
+                                       GtProcessmaxpairs processmaxpairs,
+                                       void *processmaxpairsinfo,
+                                       GtMaxpairsPartitions *partitions,
+                                       GtLogger *logger,
+                                       GtError *err)
 {
   bool haserr = false;
   Sequentialsuffixarrayreader *ssar = NULL;
@@ -682,13 +840,31 @@ int gt_callenummaxpairs(const char *indexname,
       gt_assert(ssar != NULL);
       ssar->extrainfo = &maxfreqcollect;
     }
-    if (gt_enumeratemaxpairs(ssar,
-                             userdefinedleastlength,
-                             processmaxpairs,
-                             processmaxpairsinfo,
-                             err) != 0)
+    if (partitions == NULL)
     {
-      haserr = true;
+      if (gt_enumeratemaxpairs(ssar,
+                               userdefinedleastlength,
+                               processmaxpairs,
+                               processmaxpairsinfo,
+                               err) != 0)
+      {
+        haserr = true;
+      }
+    } else
+    {
+      /* all maximal pairs come from lcp-intervals with lcp at least
+         <userdefinedleastlength>, so these are never split */
+      partitions->ssar = ssar;
+      if (gt_esa_bottomup_parallel(ssar,
+                                   MAX((GtUword) userdefinedleastlength,1UL),
+                                   threads,
+                                   gt_maxpairs_partition_visitor_new,
+                                   gt_maxpairs_partition_reduce,
+                                   partitions,
+                                   err) != 0)
+      {
+        haserr = true;
+      }
     }
   }
   GT_FREEARRAY(&maxfreqcollect.arr,Lcpinterval);
@@ -698,3 +874,61 @@ int gt_callenummaxpairs(const char *indexname,
   }
   return haserr ? -1 : 0;
 }
+
+int gt_callenummaxpairs(const char *indexname,
+                        unsigned int userdefinedleastlength,
+                        GtUword maxfreq,
+                        bool scanfile,
+                        GtProcessmaxpairs processmaxpairs,
+                        void *processmaxpairsinfo,
+                        GtLogger *logger,
+                        GtError *err)
+{
+  return gt_callenummaxpairs_generic(indexname,
+                                     userdefinedleastlength,
+                                     maxfreq,
+                                     scanfile,
+                                     1U,
+                                     processmaxpairs,
+                                     processmaxpairsinfo,
+                                     NULL,
+                                     logger,
+                                     err);
+}
+
+int gt_callenummaxpairs_parallel(const char *indexname,
+                                 unsigned int userdefinedleastlength,
+                                 GtUword maxfreq,
+                                 unsigned int threads,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 GtMaxpairsPartitionNewFunc partition_new,
+                                 GtMaxpairsPartitionReduceFunc
+                                   partition_reduce,
+                                 GtMaxpairsPartitionDeleteFunc
+                                   partition_delete,
+                                 void *data,
+                                 GtLogger *logger,
+                                 GtError *err)
+{
+  GtMaxpairsPartitions partitions;
+
+  gt_assert(partition_new != NULL && partition_reduce != NULL &&
+            partition_delete != NULL);
+  partitions.ssar = NULL;
+  partitions.searchlength = userdefinedleastlength;
+  partitions.processmaxpairs = processmaxpairs;
+  partitions.partition_new = partition_new;
+  partitions.partition_reduce = partition_reduce;
+  partitions.partition_delete = partition_delete;
+  partitions.data = data;
+  return gt_callenummaxpairs_generic(indexname,
+                                     userdefinedleastlength,
+                                     maxfreq,
+                                     false,
+                                     threads,
+                                     processmaxpairs,
+                                     NULL,
+                                     &partitions,
+                                     logger,
+                                     err);
+}
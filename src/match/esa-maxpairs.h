@@ -54,6 +54,20 @@ int gt_enumeratemaxpairs_sain(GtSainSufLcpIterator *suflcpiterator,
                               void *processmaxpairsinfo,
                               GtError *err);
 
+/* Creates the <processmaxpairsinfo> used for one partition of the suffix
+   array in <gt_callenummaxpairs_parallel>. */
+typedef void *(*GtMaxpairsPartitionNewFunc)(void *data);
+
+/* Is called with the <processmaxpairsinfo> of each partition after all
+   its maximal pairs have been processed. The calls are serialized and
+   follow the order of the partitions in the suffix array. */
+typedef int (*GtMaxpairsPartitionReduceFunc)(void *data,
+                                             void *processmaxpairsinfo,
+                                             GtError *err);
+
+/* Deletes the <processmaxpairsinfo> of a partition. */
+typedef void (*GtMaxpairsPartitionDeleteFunc)(void *processmaxpairsinfo);
+
 int gt_callenummaxpairs(const char *indexname,
                         unsigned int userdefinedleastlength,
                         GtUword maxfreq,
@@ -63,4 +77,24 @@ int gt_callenummaxpairs(const char *indexname,
                         GtLogger *logger,
                         GtError *err);
 
+/* Like <gt_callenummaxpairs> for a mapped index, but the maximal pairs are
+   enumerated with <threads> threads, each working on partitions of the
+   suffix array. Each partition has its own <processmaxpairsinfo>, created
+   by <partition_new>, handed to <partition_reduce> and deleted by
+   <partition_delete>. Within a partition, <processmaxpairs> is called in
+   the same order as by <gt_callenummaxpairs>. */
+int gt_callenummaxpairs_parallel(const char *indexname,
+                                 unsigned int userdefinedleastlength,
+                                 GtUword maxfreq,
+                                 unsigned int threads,
+                                 GtProcessmaxpairs processmaxpairs,
+                                 GtMaxpairsPartitionNewFunc partition_new,
+                                 GtMaxpairsPartitionReduceFunc
+                                   partition_reduce,
+                                 GtMaxpairsPartitionDeleteFunc
+                                   partition_delete,
+                                 void *data,
+                                 GtLogger *logger,
+                                 GtError *err);
+
 #endif
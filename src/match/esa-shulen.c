@@ -18,14 +18,18 @@
 
 #include "core/unused_api.h"
 #include "core/array2dim_api.h"
+#include "core/class_alloc_lock.h"
 #include "core/logger.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/format64.h"
+#include "core/thread_api.h"
 #undef SHUDEBUG
 #ifdef SHUDEBUG
 #include "core/encseq.h"
 #endif
 #include "esa-seqread.h"
+#include "esa-bottomup.h"
+#include "esa_visitor_rep.h"
 #include "esa-splititv.h"
 #include "shu_unitfile.h"
 #include "esa-shulen.h"
@@ -372,6 +376,195 @@ static void shulengthdist_print(const GtStrArray *file_names,
 
 #include "esa-bottomup-shulen.inc"
 
+/* The shulen computation as a GtESAVisitor, so that the partitions of
+   <gt_esa_bottomup_parallel> can be processed with their own state. The
+   edges leaving the root use <root> instead of the info on the stack, so
+   that the fragment of the root is available when the partition is
+   reduced. */
+
+typedef struct
+{
+  const GtESAVisitor parent_instance;
+  GtBUstate_shulen state;
+  GtBUinfo_shulen root;
+} GtESAShulenVisitor;
+
+typedef struct
+{
+  GtBUstate_shulen *total;
+  GtBUinfo_shulen root;
+} GtShulenPartitions;
+
+static const GtESAVisitorClass *gt_esa_shulen_visitor_class(void);
+
+#define gt_esa_shulen_visitor_cast(GV)\
+        gt_esa_visitor_cast(gt_esa_shulen_visitor_class(), GV)
+
+static int gt_esa_shulen_visitor_processleafedge(GtESAVisitor *ev,
+                                                 bool firstsucc,
+                                                 GtUword fd,
+                                                 GT_UNUSED GtUword flb,
+                                                 GtESAVisitorInfo *info,
+                                                 GtUword leafnumber,
+                                                 GtError *err)
+{
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+
+  return processleafedge_shulen(firstsucc,fd,
+                                fd == 0 ? &esv->root
+                                        : (GtBUinfo_shulen *) info,
+                                leafnumber,&esv->state,err);
+}
+
+static int gt_esa_shulen_visitor_processbranchingedge(GtESAVisitor *ev,
+                                                      bool firstsucc,
+                                                      GtUword fd,
+                                                      GT_UNUSED GtUword flb,
+                                                      GtESAVisitorInfo *finfo,
+                                                      GtUword sd,
+                                                      GtUword slb,
+                                                      GtUword srb,
+                                                      GtESAVisitorInfo *sinfo,
+                                                      GtError *err)
+{
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+
+  return processbranchingedge_shulen(firstsucc,fd,
+                                     fd == 0 ? &esv->root
+                                             : (GtBUinfo_shulen *) finfo,
+                                     sd,srb - slb + 1,
+                                     (GtBUinfo_shulen *) sinfo,
+                                     &esv->state,err);
+}
+
+static GtESAVisitorInfo *gt_esa_shulen_visitor_info_new(GtESAVisitor *ev)
+{
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+  GtBUinfo_shulen *buinfo = gt_malloc(sizeof (*buinfo));
+
+  initBUinfo_shulen(buinfo,&esv->state);
+  return (GtESAVisitorInfo *) buinfo;
+}
+
+static void gt_esa_shulen_visitor_info_delete(GtESAVisitorInfo *info,
+                                              GtESAVisitor *ev)
+{
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+  GtBUinfo_shulen *buinfo = (GtBUinfo_shulen *) info;
+
+  freeBUinfo_shulen(buinfo,&esv->state);
+  gt_free(buinfo);
+}
+
+static void gt_esa_shulen_visitor_delete(GtESAVisitor *ev)
+{
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+
+  freeBUinfo_shulen(&esv->root,&esv->state);
+  gt_array2dim_delete(esv->state.shulengthdist);
+#ifdef GENOMEDIFF_PAPER_IMPL
+  gt_free(esv->state.leafdist);
+#endif
+}
+
+static const GtESAVisitorClass *gt_esa_shulen_visitor_class(void)
+{
+  static const GtESAVisitorClass *esc = NULL;
+
+  gt_class_alloc_lock_enter();
+  if (!esc)
+  {
+    esc = gt_esa_visitor_class_new(sizeof (GtESAShulenVisitor),
+                                   gt_esa_shulen_visitor_delete,
+                                   gt_esa_shulen_visitor_processleafedge,
+                                   gt_esa_shulen_visitor_processbranchingedge,
+                                   NULL,
+                                   gt_esa_shulen_visitor_info_new,
+                                   gt_esa_shulen_visitor_info_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return esc;
+}
+
+static GtESAVisitor *gt_shulen_partition_visitor_new(void *data,
+                                                     GT_UNUSED GtUword lb,
+                                                     GT_UNUSED GtUword rb,
+                                                     GT_UNUSED GtError *err)
+{
+  GtShulenPartitions *shp = (GtShulenPartitions *) data;
+  GtESAVisitor *ev = gt_esa_visitor_create(gt_esa_shulen_visitor_class());
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+
+  esv->state.numofdbfiles = shp->total->numofdbfiles;
+  esv->state.encseq = shp->total->encseq;
+  esv->state.file_to_genome_map = shp->total->file_to_genome_map;
+  esv->state.shulengthdist = shulengthdist_new(esv->state.numofdbfiles);
+#ifdef GENOMEDIFF_PAPER_IMPL
+  esv->state.leafdist
+    = gt_malloc(sizeof (*esv->state.leafdist) * esv->state.numofdbfiles);
+#endif
+#ifdef SHUDEBUG
+  esv->state.nextid = 0;
+#endif
+  initBUinfo_shulen(&esv->root,&esv->state);
+  return ev;
+}
+
+/* Adds the sums of the partition to the total and merges the fragment of
+   the root in the partition into the root, like a branching edge. */
+static int gt_shulen_partition_reduce(void *data,
+                                      GtESAVisitor *ev,
+                                      GT_UNUSED GtUword lb,
+                                      GT_UNUSED GtUword rb,
+                                      GtError *err)
+{
+  GtShulenPartitions *shp = (GtShulenPartitions *) data;
+  GtESAShulenVisitor *esv = gt_esa_shulen_visitor_cast(ev);
+  GtUword idx1, idx2;
+
+  for (idx1 = 0; idx1 < shp->total->numofdbfiles; idx1++)
+  {
+    for (idx2 = 0; idx2 < shp->total->numofdbfiles; idx2++)
+    {
+      shp->total->shulengthdist[idx1][idx2]
+        += esv->state.shulengthdist[idx1][idx2];
+    }
+  }
+  if (esv->root.gnumdist == NULL)
+  {
+    return 0;
+  }
+  return processbranchingedge_shulen(shp->root.gnumdist == NULL,0,&shp->root,
+                                     0,0,&esv->root,shp->total,err);
+}
+
+/* Runs the bottom-up traversal for <state>, with <gt_jobs> threads if this
+   is larger than 1. */
+static int gt_esa_shulen_bottomup(Sequentialsuffixarrayreader *ssar,
+                                  GtBUstate_shulen *state,
+                                  GtError *err)
+{
+  GtShulenPartitions shp;
+  int retval;
+
+  if (gt_jobs <= 1U)
+  {
+    return gt_esa_bottomup_shulen(ssar, state, err);
+  }
+  shp.total = state;
+  initBUinfo_shulen(&shp.root,state);
+  /* mindepth 1 only splits the root, which the reducer merges again */
+  retval = gt_esa_bottomup_parallel(ssar,
+                                    1UL,
+                                    gt_jobs,
+                                    gt_shulen_partition_visitor_new,
+                                    gt_shulen_partition_reduce,
+                                    &shp,
+                                    err);
+  freeBUinfo_shulen(&shp.root,state);
+  return retval;
+}
+
 int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
                                     const GtEncseq *encseq,
                                     GtError *err)
@@ -381,6 +574,7 @@ int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
 
   state = gt_malloc(sizeof (*state));
   state->numofdbfiles = gt_encseq_num_of_files(encseq);
+  state->file_to_genome_map = NULL;
   state->encseq = encseq;
 #ifdef GENOMEDIFF_PAPER_IMPL
   state->leafdist = gt_malloc(sizeof (*state->leafdist) * state->numofdbfiles);
@@ -389,7 +583,7 @@ int gt_multiesa2shulengthdist_print(Sequentialsuffixarrayreader *ssar,
   state->nextid = 0;
 #endif
   state->shulengthdist = shulengthdist_new(state->numofdbfiles);
-  if (gt_esa_bottomup_shulen(ssar, state, err) != 0)
+  if (gt_esa_shulen_bottomup(ssar, state, err) != 0)
   {
     haserr = true;
   }
@@ -549,7 +743,7 @@ int gt_multiesa2shulengthdist(Sequentialsuffixarrayreader *ssar,
   bustate->nextid = 0;
 #endif
   bustate->shulengthdist = shulen;
-  if (gt_esa_bottomup_shulen(ssar, bustate, err) != 0)
+  if (gt_esa_shulen_bottomup(ssar, bustate, err) != 0)
   {
     haserr = true;
   }
@@ -16,23 +16,60 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/mathsupport.h"
 #include "match/esa_spmitvs_visitor.h"
 #include "esa-spmitvs.h"
 #include "esa-bottomup.h"
 
+typedef struct
+{
+  const Sequentialsuffixarrayreader *ssar;
+  GtESAVisitor *total;
+} GtSpmitvsPartitions;
+
+static GtESAVisitor *gt_spmitv_visitor_new(void *data,
+                                           GtUword lb,
+                                           GT_UNUSED GtUword rb,
+                                           GtError *err)
+{
+  GtSpmitvsPartitions *spmitvs = data;
+
+  return gt_esa_spmitvs_visitor_new(
+                        gt_encseqSequentialsuffixarrayreader(spmitvs->ssar),
+                        gt_readmodeSequentialsuffixarrayreader(spmitvs->ssar),
+                        gt_Sequentialsuffixarrayreader_prefixlength(
+                                                              spmitvs->ssar),
+                        lb,
+                        err);
+}
+
+static int gt_spmitv_reduce(void *data,
+                            GtESAVisitor *ev,
+                            GT_UNUSED GtUword lb,
+                            GT_UNUSED GtUword rb,
+                            GT_UNUSED GtError *err)
+{
+  GtSpmitvsPartitions *spmitvs = data;
+
+  gt_esa_spmitvs_visitor_add_results((GtESASpmitvsVisitor*) spmitvs->total,
+                                     (const GtESASpmitvsVisitor*) ev);
+  return 0;
+}
+
 int gt_process_spmitv(const char *inputindex, GtLogger *logger, GtError *err)
 {
   bool haserr = false;
   Sequentialsuffixarrayreader *ssar;
 
   gt_error_check(err);
+  /* the parallel traversal needs random access to the mapped tables */
   ssar = gt_newSequentialsuffixarrayreaderfromfile(inputindex,
                                                    SARR_LCPTAB |
                                                    SARR_SUFTAB |
                                                    SARR_ESQTAB,
-                                                   true,
+                                                   gt_jobs <= 1U,
                                                    logger,
                                                    err);
   if (ssar == NULL)
@@ -41,25 +78,23 @@ int gt_process_spmitv(const char *inputindex, GtLogger *logger, GtError *err)
   }
   if (!haserr)
   {
-    GtESAVisitor *ev;
+    GtSpmitvsPartitions spmitvs;
     GtUword nonspecials;
 
     nonspecials = gt_Sequentialsuffixarrayreader_nonspecials(ssar);
-    ev = gt_esa_spmitvs_visitor_new(
-                              gt_encseqSequentialsuffixarrayreader(ssar),
-                              gt_readmodeSequentialsuffixarrayreader(ssar),
-                              gt_Sequentialsuffixarrayreader_prefixlength(ssar),
-                              err);
-
-    if (gt_esa_bottomup(ssar, ev, err) != 0)
+    spmitvs.ssar = ssar;
+    spmitvs.total = gt_spmitv_visitor_new(&spmitvs, 0, 0, err);
+    if (gt_esa_bottomup_parallel(ssar, 1UL, gt_jobs, gt_spmitv_visitor_new,
+                                 gt_spmitv_reduce, &spmitvs, err) != 0)
     {
       haserr = true;
     } else
     {
-      gt_esa_spmitvs_visitor_print_results((GtESASpmitvsVisitor*) ev,
-                                           nonspecials);
+      gt_esa_spmitvs_visitor_print_results(
+                                     (GtESASpmitvsVisitor*) spmitvs.total,
+                                     nonspecials);
     }
-    gt_esa_visitor_delete(ev);
+    gt_esa_visitor_delete(spmitvs.total);
   }
   if (ssar != NULL)
   {
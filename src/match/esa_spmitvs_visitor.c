@@ -179,6 +179,7 @@ const GtESAVisitorClass* gt_esa_spmitvs_visitor_class()
 GtESAVisitor* gt_esa_spmitvs_visitor_new(const GtEncseq *encseq,
                                          GtReadmode readmode,
                                          unsigned int prefixlength,
+                                         GtUword firstleaf,
                                          GT_UNUSED GtError *err)
 {
   GtESAVisitor *ev = gt_esa_visitor_create(gt_esa_spmitvs_visitor_class());
@@ -189,7 +190,7 @@ GtESAVisitor* gt_esa_spmitvs_visitor_new(const GtEncseq *encseq,
   esv->maxlen = gt_encseq_max_seq_length(encseq);
   esv->unnecessaryleaves = 0;
   esv->totallength = gt_encseq_total_length(encseq);
-  esv->currentleafindex = 0;
+  esv->currentleafindex = firstleaf;
   esv->lastwholeleaf = esv->totallength; /* undefined */
   esv->prefixlength = prefixlength;
   esv->wholeleafcount = gt_malloc(sizeof (*esv->wholeleafcount) *
@@ -200,6 +201,25 @@ GtESAVisitor* gt_esa_spmitvs_visitor_new(const GtEncseq *encseq,
   return ev;
 }
 
+void gt_esa_spmitvs_visitor_add_results(GtESASpmitvsVisitor *dest,
+                                        const GtESASpmitvsVisitor *src)
+{
+  GtUword idx;
+
+  gt_assert(dest->maxlen == src->maxlen);
+  dest->unnecessaryleaves += src->unnecessaryleaves;
+  for (idx = 0; idx <= dest->maxlen; idx++)
+  {
+    dest->wholeleafcount[idx].wholeleaf += src->wholeleafcount[idx].wholeleaf;
+    dest->wholeleafcount[idx].wholeleafwidth
+      += src->wholeleafcount[idx].wholeleafwidth;
+    dest->wholeleafcount[idx].nowholeleaf
+      += src->wholeleafcount[idx].nowholeleaf;
+    dest->wholeleafcount[idx].nowholeleafwidth
+      += src->wholeleafcount[idx].nowholeleafwidth;
+  }
+}
+
 void gt_esa_spmitvs_visitor_print_results(GtESASpmitvsVisitor *esv,
                                           GtUword nonspecials)
 {
@@ -30,7 +30,13 @@ const GtESAVisitorClass* gt_esa_spmitvs_visitor_class(void);
 GtESAVisitor*            gt_esa_spmitvs_visitor_new(const GtEncseq *encseq,
                                                     GtReadmode readmode,
                                                     unsigned int prefixlength,
+                                                    GtUword firstleaf,
                                                     GtError *err);
+/* Adds the counts of <src>, which visited another part of the suffix array,
+   to <dest>. */
+void                     gt_esa_spmitvs_visitor_add_results(
+                                               GtESASpmitvsVisitor *dest,
+                                               const GtESASpmitvsVisitor *src);
 void                     gt_esa_spmitvs_visitor_print_results(
                                                      GtESASpmitvsVisitor*,
                                                      GtUword nonspecials);
@@ -34,6 +34,7 @@
 
 /* string graph */
 #define GT_READJOINER_SUFFIX_SG                 ".sg"
+#define GT_READJOINER_SUFFIX_SG_CSR             ".sgc"
 #define GT_READJOINER_SUFFIX_SG_MONO_DOT        ".m.dot"
 #define GT_READJOINER_SUFFIX_SG_BI_DOT          ".b.dot"
 #define GT_READJOINER_SUFFIX_SG_SUB_DOT         ".sub.dot"
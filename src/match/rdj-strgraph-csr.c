@@ -0,0 +1,472 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdint.h>
+#include "core/arraydef.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/str.h"
+#include "core/xansi_api.h"
+#include "match/rdj-strgraph-csr.h"
+
+#define GT_STRGRAPH_CSR_MAGIC        UINT64_C(0x3152534347545347)
+#define GT_STRGRAPH_CSR_VERSION      UINT64_C(1)
+#define GT_STRGRAPH_CSR_SAMPLINGRATE UINT64_C(32)
+#define GT_STRGRAPH_CSR_LARGEDEG     UINT8_MAX
+
+typedef struct {
+  uint64_t magic, version, nofvertices, nofedges, fixlen, samplingrate;
+} GtStrgraphCSRHeader;
+
+struct GtStrgraphCSRWriter {
+  GtStrgraphCSRHeader header;
+  uint8_t             *degrees;
+  GtArrayuint64_t     offsets;
+  GtArrayGtUchar      data;
+  GtUword             nextvertex, edges_to_add, prevdest, prevlen;
+};
+
+struct GtStrgraphCSR {
+  void                *map;
+  size_t              mapsize;
+  GtStrgraphCSRHeader *header;
+  const uint64_t      *offsets;
+  const uint8_t       *degrees;
+  const unsigned char *data;
+};
+
+/* --- varint coding --- */
+
+static inline void gt_strgraph_csr_append_varint(GtArrayGtUchar *data,
+    uint64_t value)
+{
+  while (value >= UINT64_C(0x80))
+  {
+    GT_STOREINARRAY(data, GtUchar, 1024UL,
+        (GtUchar)((value & UINT64_C(0x7f)) | UINT64_C(0x80)));
+    value >>= 7;
+  }
+  GT_STOREINARRAY(data, GtUchar, 1024UL, (GtUchar)value);
+}
+
+static inline uint64_t gt_strgraph_csr_zigzag(GtUword value, GtUword prev)
+{
+  int64_t delta = (int64_t)value - (int64_t)prev;
+  return (delta < 0) ? ((((uint64_t)(-(delta + 1))) << 1) | UINT64_C(1))
+                     : (((uint64_t)delta) << 1);
+}
+
+static inline GtUword gt_strgraph_csr_unzigzag(uint64_t code, GtUword prev)
+{
+  return (code & UINT64_C(1))
+    ? (GtUword)(prev - (GtUword)(code >> 1) - 1)
+    : (GtUword)(prev + (GtUword)(code >> 1));
+}
+
+static inline uint64_t gt_strgraph_csr_read_varint(const unsigned char **ptr)
+{
+  uint64_t value = 0;
+  unsigned int shift = 0;
+
+  while (**ptr & 0x80U)
+  {
+    value |= ((uint64_t)(**ptr & 0x7fU)) << shift;
+    shift += 7U;
+    (*ptr)++;
+  }
+  value |= ((uint64_t)**ptr) << shift;
+  (*ptr)++;
+  return value;
+}
+
+static inline const unsigned char *gt_strgraph_csr_skip_varints(
+    const unsigned char *ptr, GtUword nofvarints)
+{
+  while (nofvarints > 0)
+  {
+    if (!(*ptr & 0x80U))
+      nofvarints--;
+    ptr++;
+  }
+  return ptr;
+}
+
+/* --- writer --- */
+
+GtStrgraphCSRWriter* gt_strgraph_csr_writer_new(GtUword nofvertices,
+    GtUword fixlen)
+{
+  GtStrgraphCSRWriter *writer = gt_malloc(sizeof (*writer));
+  writer->header.magic = GT_STRGRAPH_CSR_MAGIC;
+  writer->header.version = GT_STRGRAPH_CSR_VERSION;
+  writer->header.nofvertices = (uint64_t)nofvertices;
+  writer->header.nofedges = 0;
+  writer->header.fixlen = (uint64_t)fixlen;
+  writer->header.samplingrate = GT_STRGRAPH_CSR_SAMPLINGRATE;
+  writer->degrees = gt_malloc(sizeof (*writer->degrees) * (nofvertices + 1));
+  GT_INITARRAY(&writer->offsets, uint64_t);
+  GT_INITARRAY(&writer->data, GtUchar);
+  writer->nextvertex = 0;
+  writer->edges_to_add = 0;
+  writer->prevdest = 0;
+  writer->prevlen = 0;
+  return writer;
+}
+
+void gt_strgraph_csr_writer_add_vertex(GtStrgraphCSRWriter *writer,
+    GtUword outdeg)
+{
+  gt_assert(writer != NULL);
+  gt_assert(writer->edges_to_add == 0);
+  gt_assert((uint64_t)writer->nextvertex < writer->header.nofvertices);
+  if ((uint64_t)writer->nextvertex % writer->header.samplingrate == 0)
+    GT_STOREINARRAY(&writer->offsets, uint64_t, 128UL,
+        (uint64_t)writer->data.nextfreeGtUchar);
+  if (outdeg < (GtUword)GT_STRGRAPH_CSR_LARGEDEG)
+    writer->degrees[writer->nextvertex] = (uint8_t)outdeg;
+  else
+  {
+    writer->degrees[writer->nextvertex] = GT_STRGRAPH_CSR_LARGEDEG;
+    gt_strgraph_csr_append_varint(&writer->data, (uint64_t)outdeg);
+  }
+  writer->prevdest = writer->nextvertex;
+  writer->prevlen = 0;
+  writer->edges_to_add = outdeg;
+  writer->header.nofedges += (uint64_t)outdeg;
+  writer->nextvertex++;
+}
+
+void gt_strgraph_csr_writer_add_edge(GtStrgraphCSRWriter *writer,
+    GtUword dest, GtUword len)
+{
+  gt_assert(writer != NULL);
+  gt_assert(writer->edges_to_add > 0);
+  gt_assert((uint64_t)dest < writer->header.nofvertices);
+  gt_strgraph_csr_append_varint(&writer->data,
+      gt_strgraph_csr_zigzag(dest, writer->prevdest));
+  gt_strgraph_csr_append_varint(&writer->data,
+      gt_strgraph_csr_zigzag(len, writer->prevlen));
+  writer->prevdest = dest;
+  writer->prevlen = len;
+  writer->edges_to_add--;
+}
+
+void gt_strgraph_csr_writer_write(GtStrgraphCSRWriter *writer,
+    GtFile *outfp)
+{
+  gt_assert(writer != NULL);
+  gt_assert((uint64_t)writer->nextvertex == writer->header.nofvertices);
+  gt_assert(writer->edges_to_add == 0);
+  GT_STOREINARRAY(&writer->offsets, uint64_t, 128UL,
+      (uint64_t)writer->data.nextfreeGtUchar);
+  gt_file_xwrite(outfp, &writer->header, sizeof (writer->header));
+  gt_file_xwrite(outfp, writer->offsets.spaceuint64_t,
+      sizeof (uint64_t) * writer->offsets.nextfreeuint64_t);
+  if (writer->nextvertex > 0)
+    gt_file_xwrite(outfp, writer->degrees,
+        sizeof (*writer->degrees) * writer->nextvertex);
+  if (writer->data.nextfreeGtUchar > 0)
+    gt_file_xwrite(outfp, writer->data.spaceGtUchar,
+        sizeof (GtUchar) * writer->data.nextfreeGtUchar);
+}
+
+void gt_strgraph_csr_writer_delete(GtStrgraphCSRWriter *writer)
+{
+  if (writer != NULL)
+  {
+    gt_free(writer->degrees);
+    GT_FREEARRAY(&writer->offsets, uint64_t);
+    GT_FREEARRAY(&writer->data, GtUchar);
+    gt_free(writer);
+  }
+}
+
+/* --- reader --- */
+
+GtStrgraphCSR* gt_strgraph_csr_new_from_file(const char *indexname,
+    const char *suffix, GtError *err)
+{
+  GtStrgraphCSR *csr;
+  uint64_t nofoffsets, expected_size;
+  int had_err = 0;
+
+  gt_error_check(err);
+  csr = gt_calloc((size_t)1, sizeof (*csr));
+  csr->map = gt_fa_mmap_read_with_suffix(indexname, suffix, &csr->mapsize,
+      err);
+  if (csr->map == NULL)
+    had_err = -1;
+  if (!had_err && csr->mapsize < sizeof (GtStrgraphCSRHeader))
+  {
+    gt_error_set(err, "file %s%s is too short for a string graph",
+        indexname, suffix);
+    had_err = -1;
+  }
+  if (!had_err)
+  {
+    csr->header = csr->map;
+    if (csr->header->magic != GT_STRGRAPH_CSR_MAGIC ||
+        csr->header->version != GT_STRGRAPH_CSR_VERSION ||
+        csr->header->samplingrate == 0)
+    {
+      gt_error_set(err, "file %s%s is not a compressed string graph file "
+          "of version "GT_WU, indexname, suffix,
+          (GtUword)GT_STRGRAPH_CSR_VERSION);
+      had_err = -1;
+    }
+  }
+  if (!had_err)
+  {
+    /* every quantity taken from the header is checked against the space
+       left in the file before it is used, so that a corrupt header cannot
+       make a size computation overflow */
+    uint64_t space = (uint64_t)csr->mapsize - sizeof (GtStrgraphCSRHeader);
+
+    nofoffsets = csr->header->nofvertices / csr->header->samplingrate +
+      (csr->header->nofvertices % csr->header->samplingrate > 0 ? 1 : 0) + 1;
+    if (csr->header->nofvertices > space ||
+        nofoffsets > (space - csr->header->nofvertices) /
+                     (uint64_t)sizeof (uint64_t))
+    {
+      gt_error_set(err, "file %s%s is truncated", indexname, suffix);
+      had_err = -1;
+    }
+    else
+    {
+      uint64_t datasize, idx;
+
+      expected_size = (uint64_t)sizeof (GtStrgraphCSRHeader) +
+        nofoffsets * (uint64_t)sizeof (uint64_t) + csr->header->nofvertices;
+      datasize = (uint64_t)csr->mapsize - expected_size;
+      csr->offsets = (const uint64_t*)(csr->header + 1);
+      csr->degrees = (const uint8_t*)(csr->offsets + nofoffsets);
+      csr->data = (const unsigned char*)(csr->degrees +
+          csr->header->nofvertices);
+      /* each edge is stored with at least two bytes */
+      if (csr->offsets[nofoffsets - 1] != datasize ||
+          csr->header->nofedges > datasize / 2)
+      {
+        gt_error_set(err, "file %s%s has an unexpected size", indexname,
+            suffix);
+        had_err = -1;
+      }
+      for (idx = 1; !had_err && idx < nofoffsets; idx++)
+      {
+        if (csr->offsets[idx] < csr->offsets[idx - 1])
+        {
+          gt_error_set(err, "file %s%s is corrupt", indexname, suffix);
+          had_err = -1;
+        }
+      }
+    }
+  }
+  if (had_err)
+  {
+    gt_strgraph_csr_delete(csr);
+    return NULL;
+  }
+  return csr;
+}
+
+GtUword gt_strgraph_csr_nofvertices(const GtStrgraphCSR *csr)
+{
+  gt_assert(csr != NULL);
+  return (GtUword)csr->header->nofvertices;
+}
+
+GtUword gt_strgraph_csr_nofedges(const GtStrgraphCSR *csr)
+{
+  gt_assert(csr != NULL);
+  return (GtUword)csr->header->nofedges;
+}
+
+GtUword gt_strgraph_csr_fixlen(const GtStrgraphCSR *csr)
+{
+  gt_assert(csr != NULL);
+  return (GtUword)csr->header->fixlen;
+}
+
+/* returns a pointer to the edges data of vertex <v>, i.e. to the outdegree,
+   if it is large, or to the first edge otherwise */
+static const unsigned char *gt_strgraph_csr_vertex_data(
+    const GtStrgraphCSR *csr, GtUword v)
+{
+  const unsigned char *ptr;
+  GtUword u, deg;
+
+  u = v - (GtUword)((uint64_t)v % csr->header->samplingrate);
+  ptr = csr->data + csr->offsets[(uint64_t)v / csr->header->samplingrate];
+  for (/**/; u < v; u++)
+  {
+    deg = (GtUword)csr->degrees[u];
+    if (deg == (GtUword)GT_STRGRAPH_CSR_LARGEDEG)
+      deg = (GtUword)gt_strgraph_csr_read_varint(&ptr);
+    ptr = gt_strgraph_csr_skip_varints(ptr, deg << 1);
+  }
+  return ptr;
+}
+
+GtUword gt_strgraph_csr_outdeg(const GtStrgraphCSR *csr, GtUword v)
+{
+  const unsigned char *ptr;
+
+  gt_assert(csr != NULL);
+  gt_assert((uint64_t)v < csr->header->nofvertices);
+  if (csr->degrees[v] != GT_STRGRAPH_CSR_LARGEDEG)
+    return (GtUword)csr->degrees[v];
+  ptr = gt_strgraph_csr_vertex_data(csr, v);
+  return (GtUword)gt_strgraph_csr_read_varint(&ptr);
+}
+
+void gt_strgraph_csr_edges_init(const GtStrgraphCSR *csr, GtUword v,
+    GtStrgraphCSREdgeIterator *it)
+{
+  gt_assert(csr != NULL && it != NULL);
+  gt_assert((uint64_t)v < csr->header->nofvertices);
+  it->dest = v;
+  it->len = 0;
+  it->remaining = (GtUword)csr->degrees[v];
+  if (it->remaining == 0)
+  {
+    it->ptr = NULL;
+    return;
+  }
+  it->ptr = gt_strgraph_csr_vertex_data(csr, v);
+  if (it->remaining == (GtUword)GT_STRGRAPH_CSR_LARGEDEG)
+    it->remaining = (GtUword)gt_strgraph_csr_read_varint(&it->ptr);
+}
+
+bool gt_strgraph_csr_edges_next(GtStrgraphCSREdgeIterator *it,
+    GtUword *dest, GtUword *len)
+{
+  gt_assert(it != NULL);
+  if (it->remaining == 0)
+    return false;
+  it->dest = gt_strgraph_csr_unzigzag(gt_strgraph_csr_read_varint(&it->ptr),
+      it->dest);
+  it->len = gt_strgraph_csr_unzigzag(gt_strgraph_csr_read_varint(&it->ptr),
+      it->len);
+  it->remaining--;
+  *dest = it->dest;
+  *len = it->len;
+  return true;
+}
+
+void gt_strgraph_csr_delete(GtStrgraphCSR *csr)
+{
+  if (csr != NULL)
+  {
+    gt_fa_xmunmap(csr->map);
+    gt_free(csr);
+  }
+}
+
+/* --- unit test --- */
+
+#define GT_STRGRAPH_CSR_TEST_NOFVERTICES 100UL
+
+static GtUword gt_strgraph_csr_test_outdeg(GtUword v)
+{
+  /* include a vertex with a degree too large for the degrees table */
+  return (v == 37UL) ? 300UL : (v * 7UL) % 5UL;
+}
+
+static GtUword gt_strgraph_csr_test_dest(GtUword v, GtUword j)
+{
+  return (v * 13UL + j * 29UL) % GT_STRGRAPH_CSR_TEST_NOFVERTICES;
+}
+
+static GtUword gt_strgraph_csr_test_len(GtUword v, GtUword j)
+{
+  return (v + j * 3UL) % 17UL + 1UL;
+}
+
+int gt_strgraph_csr_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtStrgraphCSRWriter *writer;
+  GtStrgraphCSR *csr = NULL;
+  GtStrgraphCSREdgeIterator it;
+  GtStr *tmpfilename;
+  GtFile *outfp;
+  FILE *tmpfp;
+  GtUword v, j, dest, len;
+
+  gt_error_check(err);
+
+  writer = gt_strgraph_csr_writer_new(GT_STRGRAPH_CSR_TEST_NOFVERTICES, 50UL);
+  for (v = 0; v < GT_STRGRAPH_CSR_TEST_NOFVERTICES; v++)
+  {
+    gt_strgraph_csr_writer_add_vertex(writer, gt_strgraph_csr_test_outdeg(v));
+    for (j = 0; j < gt_strgraph_csr_test_outdeg(v); j++)
+      gt_strgraph_csr_writer_add_edge(writer, gt_strgraph_csr_test_dest(v, j),
+          gt_strgraph_csr_test_len(v, j));
+  }
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  outfp = gt_file_new_from_fileptr(tmpfp);
+  gt_strgraph_csr_writer_write(writer, outfp);
+  gt_file_delete_without_handle(outfp);
+  gt_fa_xfclose(tmpfp);
+  gt_strgraph_csr_writer_delete(writer);
+
+  csr = gt_strgraph_csr_new_from_file(gt_str_get(tmpfilename), "", err);
+  gt_ensure(csr != NULL);
+  if (!had_err)
+  {
+    gt_ensure(gt_strgraph_csr_nofvertices(csr) ==
+        GT_STRGRAPH_CSR_TEST_NOFVERTICES);
+    gt_ensure(gt_strgraph_csr_fixlen(csr) == 50UL);
+  }
+  /* backwards, to access vertices out of order */
+  for (v = GT_STRGRAPH_CSR_TEST_NOFVERTICES; !had_err && v > 0; v--)
+  {
+    gt_ensure(gt_strgraph_csr_outdeg(csr, v - 1) ==
+        gt_strgraph_csr_test_outdeg(v - 1));
+    gt_strgraph_csr_edges_init(csr, v - 1, &it);
+    for (j = 0; !had_err && gt_strgraph_csr_edges_next(&it, &dest, &len); j++)
+    {
+      gt_ensure(dest == gt_strgraph_csr_test_dest(v - 1, j));
+      gt_ensure(len == gt_strgraph_csr_test_len(v - 1, j));
+    }
+    gt_ensure(j == gt_strgraph_csr_test_outdeg(v - 1));
+  }
+  gt_strgraph_csr_delete(csr);
+  /* a header whose sizes sum up to a small value modulo 2^64: with a
+     sampling rate of 1, 9 * nofvertices = 1 (mod 2^64) */
+  if (!had_err)
+  {
+    GtStrgraphCSRHeader header;
+    GtError *loaderr = gt_error_new();
+
+    tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "r+b");
+    gt_xfread_one(&header, tmpfp);
+    header.nofvertices = UINT64_C(0x8E38E38E38E38E39);
+    header.samplingrate = UINT64_C(1);
+    gt_xfseek(tmpfp, 0, SEEK_SET);
+    gt_xfwrite_one(&header, tmpfp);
+    gt_fa_xfclose(tmpfp);
+    csr = gt_strgraph_csr_new_from_file(gt_str_get(tmpfilename), "",
+        loaderr);
+    gt_ensure(csr == NULL);
+    gt_ensure(gt_error_is_set(loaderr));
+    gt_error_delete(loaderr);
+  }
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
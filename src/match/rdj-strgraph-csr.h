@@ -0,0 +1,95 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef RDJ_STRGRAPH_CSR_H
+#define RDJ_STRGRAPH_CSR_H
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/file.h"
+#include "core/types_api.h"
+
+/*
+ * Read-only string graph in compressed sparse row format, memory mapped
+ * from file.
+ *
+ * File format (native byte order):
+ *
+ * header:  uint64_t magic, version, nofvertices, nofedges, fixlen,
+ *          samplingrate
+ * offsets: uint64_t[(nofvertices + samplingrate - 1) / samplingrate + 1],
+ *          offset of the edges of each samplingrate-th vertex in the edges
+ *          data; the last value is the size of the edges data
+ * degrees: uint8_t[nofvertices], outdegree of each vertex; 255 means that
+ *          the outdegree is stored as varint in front of the vertex edges
+ * edges:   for each edge in the order given by the writer:
+ *          varint(zigzag(dest - previous dest)), starting from the vertex,
+ *          varint(zigzag(len - previous len)), starting from 0
+ */
+
+typedef struct GtStrgraphCSR GtStrgraphCSR;
+
+typedef struct GtStrgraphCSRWriter GtStrgraphCSRWriter;
+
+/* Iterator over the edges of a vertex; the fields are private. */
+typedef struct {
+  const unsigned char *ptr;
+  GtUword remaining, dest, len;
+} GtStrgraphCSREdgeIterator;
+
+/* --- writer --- */
+
+GtStrgraphCSRWriter* gt_strgraph_csr_writer_new(GtUword nofvertices,
+    GtUword fixlen);
+
+/* vertices must be added in increasing order, each followed by its
+   <outdeg> edges */
+void gt_strgraph_csr_writer_add_vertex(GtStrgraphCSRWriter *writer,
+    GtUword outdeg);
+
+void gt_strgraph_csr_writer_add_edge(GtStrgraphCSRWriter *writer,
+    GtUword dest, GtUword len);
+
+void gt_strgraph_csr_writer_write(GtStrgraphCSRWriter *writer,
+    GtFile *outfp);
+
+void gt_strgraph_csr_writer_delete(GtStrgraphCSRWriter *writer);
+
+/* --- reader --- */
+
+GtStrgraphCSR* gt_strgraph_csr_new_from_file(const char *indexname,
+    const char *suffix, GtError *err);
+
+GtUword gt_strgraph_csr_nofvertices(const GtStrgraphCSR *csr);
+
+GtUword gt_strgraph_csr_nofedges(const GtStrgraphCSR *csr);
+
+GtUword gt_strgraph_csr_fixlen(const GtStrgraphCSR *csr);
+
+GtUword gt_strgraph_csr_outdeg(const GtStrgraphCSR *csr, GtUword v);
+
+void gt_strgraph_csr_edges_init(const GtStrgraphCSR *csr, GtUword v,
+    GtStrgraphCSREdgeIterator *it);
+
+/* return value: false if there are no further edges */
+bool gt_strgraph_csr_edges_next(GtStrgraphCSREdgeIterator *it,
+    GtUword *dest, GtUword *len);
+
+void gt_strgraph_csr_delete(GtStrgraphCSR *csr);
+
+int gt_strgraph_csr_unit_test(GtError *err);
+
+#endif
@@ -25,12 +25,14 @@
 #include "core/fileutils.h"
 #include "core/format64.h"
 #include "core/hashmap-generic.h"
+#include "core/intbits.h"
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/progressbar.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/spacecalc.h"
+#include "core/thread_api.h"
 #include "extended/assembly_stats_calculator.h"
 #include "match/asqg_writer.h"
 #include "match/reads_libraries_table.h"
@@ -41,6 +43,7 @@
 #include "match/rdj-filesuf-def.h"
 #include "match/rdj-spmlist.h"
 #include "match/rdj-strgraph.h"
+#include "match/rdj-strgraph-csr.h"
 
 /* default representation: */
 
@@ -248,6 +251,7 @@ typedef enum {
   GT_STRGRAPH_CONSTRUCTION,
   GT_STRGRAPH_SORTED_BY_L,
   GT_STRGRAPH_LOADED_FROM_FILE,
+  GT_STRGRAPH_MAPPED,
 } GtStrgraphState;
 
 struct GtStrgraph {
@@ -260,6 +264,7 @@ struct GtStrgraph {
   bool                  binary_spmlist;
   GtStrgraphLength      minmatchlen;
   GtReadsLibrariesTable *rlt;
+  GtStrgraphCSR         *csr;
   GT_STRGRAPH_DECLARE_COUNTS;
   GT_STRGRAPH_DECLARE_VERTICES;
   GT_STRGRAPH_DECLARE_EDGES;
@@ -453,6 +458,7 @@ void gt_strgraph_delete(GtStrgraph *strgraph)
     GT_STRGRAPH_FREE_VERTICES(strgraph);
     GT_STRGRAPH_FREE_EDGES(strgraph);
     GT_STRGRAPH_FREE_COUNTS(strgraph);
+    gt_strgraph_csr_delete(strgraph->csr);
     gt_reads_libraries_table_delete(strgraph->rlt);
     gt_free(strgraph);
   }
@@ -474,6 +480,32 @@ static void gt_strgraph_save(const GtStrgraph *strgraph, GtFile *outfp)
   GT_STRGRAPH_SERIALIZE_EDGES(strgraph, outfp);
 }
 
+/* only non-reduced edges are saved, in their current order */
+static void gt_strgraph_save_csr(const GtStrgraph *strgraph, GtFile *outfp)
+{
+  GtStrgraphCSRWriter *writer;
+  GtStrgraphVnum i;
+  GtStrgraphVEdgenum j;
+
+  gt_assert(strgraph != NULL);
+  writer = gt_strgraph_csr_writer_new(
+      (GtUword)GT_STRGRAPH_NOFVERTICES(strgraph), (GtUword)strgraph->fixlen);
+  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  {
+    gt_strgraph_csr_writer_add_vertex(writer,
+        (GtUword)GT_STRGRAPH_V_OUTDEG(strgraph, i));
+    for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+    {
+      if (!GT_STRGRAPH_EDGE_IS_REDUCED(strgraph, i, j))
+        gt_strgraph_csr_writer_add_edge(writer,
+            (GtUword)GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
+            (GtUword)GT_STRGRAPH_EDGE_LEN(strgraph, i, j));
+    }
+  }
+  gt_strgraph_csr_writer_write(writer, outfp);
+  gt_strgraph_csr_writer_delete(writer);
+}
+
 static void gt_strgraph_load(GtStrgraph *strgraph, GtFile *infp)
 {
   gt_assert(strgraph != NULL);
@@ -577,6 +609,37 @@ GtStrgraph* gt_strgraph_new_from_file(const GtEncseq *encseq,
   return strgraph;
 }
 
+GtStrgraph* gt_strgraph_new_from_csr_file(const GtEncseq *encseq,
+    GtUword fixlen, const char *indexname, const char *suffix, GtError *err)
+{
+  GtStrgraph *strgraph;
+  GtStrgraphCSR *csr;
+
+  gt_error_check(err);
+  gt_assert(encseq != NULL || fixlen > 0);
+  csr = gt_strgraph_csr_new_from_file(indexname, suffix, err);
+  if (csr == NULL)
+    return NULL;
+  if (gt_strgraph_csr_fixlen(csr) != fixlen)
+  {
+    gt_error_set(err, "string graph %s%s was saved for read length "GT_WU
+        " instead of "GT_WU" (0: variable)", indexname, suffix,
+        gt_strgraph_csr_fixlen(csr), fixlen);
+    gt_strgraph_csr_delete(csr);
+    return NULL;
+  }
+  strgraph = gt_calloc((size_t)1, sizeof (GtStrgraph));
+  strgraph->state = GT_STRGRAPH_MAPPED;
+  strgraph->load_self_spm = false;
+  strgraph->minmatchlen = GT_STRGRAPH_LENGTH_MAX;
+  strgraph->rlt = NULL;
+  strgraph->encseq = encseq;
+  strgraph->fixlen = (GtStrgraphLength)fixlen;
+  strgraph->csr = csr;
+  GT_STRGRAPH_INIT_COUNTS(strgraph);
+  return strgraph;
+}
+
 void gt_spmproc_strgraph_count(GtUword suffix_readnum,
     GtUword prefix_readnum, GtUword length,
     bool suffixseq_direct, bool prefixseq_direct, void *strgraph)
@@ -976,64 +1039,232 @@ GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
-/* return value: number of transitive edges */
-GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+typedef struct {
+  GtStrgraphVnum vnum;
+  GtStrgraphVEdgenum edgenum;
+} GtStrgraphEdgeID;
+
+/* marks the transitive edges of vertex <i>; the destinations of the edges
+   of <i> are marked as in play in <vmarks>, if not NULL, otherwise in the
+   vertex marks of <strgraph>; transitive edges are appended to <edgelog>,
+   if not NULL, otherwise they are marked directly */
+static void gt_strgraph_redtrans_vertex(GtStrgraph *strgraph, GtStrgraphVnum i,
+    GtBitsequence *vmarks, GtArray *edgelog)
 {
   GtStrgraphLength jlen, klen, longest;
   GtStrgraphVEdgenum j, k, l;
-  GtStrgraphVnum i, jdest, kdest;
-  GtUword counter;
-  GtUint64 progress = 0;
+  GtStrgraphVnum jdest, kdest;
+  bool inplay;
 
-  gt_assert(strgraph != NULL);
-  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
-
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
   {
-    if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
+    jdest = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
+    if (vmarks != NULL)
+      GT_SETIBIT(vmarks, jdest);
+    else
+      GT_STRGRAPH_V_SET_MARK(strgraph, jdest, GT_STRGRAPH_V_INPLAY);
+  }
+  GT_STRGRAPH_FIND_LONGEST_EDGE(strgraph, i, longest);
+  for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+  {
+    jdest = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
+    jlen = GT_STRGRAPH_EDGE_LEN(strgraph, i, j);
+    for (k = 0; k < GT_STRGRAPH_V_NOFEDGES(strgraph, jdest) &&
+        GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k) + jlen <= longest; k++)
     {
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
-      {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_INPLAY);
-      }
-      GT_STRGRAPH_FIND_LONGEST_EDGE(strgraph, i, longest);
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+      kdest = GT_STRGRAPH_EDGE_DEST(strgraph, jdest, k);
+      klen = GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k);
+      if (vmarks != NULL)
+        inplay = GT_ISIBITSET(vmarks, kdest) ? true : false;
+      else
+        inplay = (GT_STRGRAPH_V_MARK(strgraph, kdest) == GT_STRGRAPH_V_INPLAY);
+      if (inplay)
       {
-        jdest = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
-        jlen = GT_STRGRAPH_EDGE_LEN(strgraph, i, j);
-        for (k = 0; k < GT_STRGRAPH_V_NOFEDGES(strgraph, jdest) &&
-            GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k) + jlen <= longest; k++)
+        for (l = 0; l < GT_STRGRAPH_V_NOFEDGES(strgraph, i); l++)
         {
-          kdest = GT_STRGRAPH_EDGE_DEST(strgraph, jdest, k);
-          klen = GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k);
-          if (GT_STRGRAPH_V_MARK(strgraph, kdest) == GT_STRGRAPH_V_INPLAY)
+          if (GT_STRGRAPH_EDGE_DEST(strgraph, i, l) == kdest &&
+              GT_STRGRAPH_EDGE_LEN(strgraph, i, l) == jlen + klen)
           {
-            for (l = 0; l < GT_STRGRAPH_V_NOFEDGES(strgraph, i); l++)
+            if (edgelog != NULL)
             {
-              if (GT_STRGRAPH_EDGE_DEST(strgraph, i, l) == kdest &&
-                  GT_STRGRAPH_EDGE_LEN(strgraph, i, l) == jlen + klen)
-              {
-                GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
-              }
+              GtStrgraphEdgeID edge;
+              edge.vnum = i;
+              edge.edgenum = l;
+              gt_array_add(edgelog, edge);
             }
+            else
+              GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
           }
         }
       }
-      for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+    }
+  }
+  for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+  {
+    jdest = GT_STRGRAPH_EDGE_DEST(strgraph, i, j);
+    if (vmarks != NULL)
+      GT_UNSETIBIT(vmarks, jdest);
+    else
+      GT_STRGRAPH_V_SET_MARK(strgraph, jdest, GT_STRGRAPH_V_VACANT);
+  }
+}
+
+#ifdef GT_THREADS_ENABLED
+
+#define GT_STRGRAPH_REDTRANS_PROGRESS_STEP 4096UL
+
+typedef struct {
+  GtStrgraph     *strgraph;
+  GtStrgraphVnum firstvertex, lastvertex;
+  GtBitsequence  *vmarks;
+  GtArray        *edgelog;
+  GtUint64       *progress;
+  GtMutex        *progressmutex;
+  GtThread       *thread;
+} GtStrgraphRedtransThreadinfo;
+
+static void *gt_strgraph_redtrans_thread(void *data)
+{
+  GtStrgraphRedtransThreadinfo *ti = (GtStrgraphRedtransThreadinfo*) data;
+  GtStrgraphVnum i;
+  GtUword done = 0;
+
+  for (i = ti->firstvertex; i < ti->lastvertex; i++)
+  {
+    if (GT_STRGRAPH_V_OUTDEG(ti->strgraph, i) > 0)
+      gt_strgraph_redtrans_vertex(ti->strgraph, i, ti->vmarks, ti->edgelog);
+    if (ti->progress != NULL &&
+        ++done == GT_STRGRAPH_REDTRANS_PROGRESS_STEP)
+    {
+      gt_mutex_lock(ti->progressmutex);
+      *(ti->progress) += (GtUint64)done;
+      gt_mutex_unlock(ti->progressmutex);
+      done = 0;
+    }
+  }
+  if (ti->progress != NULL && done > 0)
+  {
+    gt_mutex_lock(ti->progressmutex);
+    *(ti->progress) += (GtUint64)done;
+    gt_mutex_unlock(ti->progressmutex);
+  }
+  return NULL;
+}
+
+/* The vertices are divided into <threads> ranges with about the same number
+   of edges. Each thread uses its own vertex marks and collects the transitive
+   edges in its own log, as concurrent updates of the bitpacked edges table
+   are not safe. The logs are applied after all threads are done; as edges
+   are only reduced after the marking phase, the result does not depend on
+   the number of threads. */
+static int gt_strgraph_redtrans_mark_threaded(GtStrgraph *strgraph,
+    unsigned int threads, GtUint64 *progress, GtError *err)
+{
+  GtStrgraphRedtransThreadinfo *threadinfo;
+  GtStrgraphVnum v, nofvertices = GT_STRGRAPH_NOFVERTICES(strgraph);
+  GtStrgraphEdgenum nofedges, partedges;
+  GtMutex *progressmutex;
+  GtUword e;
+  unsigned int t;
+  bool haserr = false;
+
+  gt_assert(threads >= 2U);
+  nofedges = GT_STRGRAPH_V_OFFSET(strgraph, nofvertices);
+  progressmutex = gt_mutex_new();
+  threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  v = 0;
+  for (t = 0; t < threads; t++)
+  {
+    threadinfo[t].strgraph = strgraph;
+    threadinfo[t].firstvertex = v;
+    if (t < threads - 1)
+    {
+      partedges = (GtStrgraphEdgenum)((nofedges / threads) * (t + 1));
+      while (v < nofvertices && GT_STRGRAPH_V_OFFSET(strgraph, v) < partedges)
+        v++;
+    }
+    else
+      v = nofvertices;
+    threadinfo[t].lastvertex = v;
+    GT_INITBITTAB(threadinfo[t].vmarks, nofvertices);
+    threadinfo[t].edgelog = gt_array_new(sizeof (GtStrgraphEdgeID));
+    threadinfo[t].progress = progress;
+    threadinfo[t].progressmutex = progressmutex;
+    threadinfo[t].thread = NULL;
+  }
+  for (t = 0; !haserr && t < threads; t++)
+  {
+    threadinfo[t].thread = gt_thread_new(gt_strgraph_redtrans_thread,
+        threadinfo + t, err);
+    if (threadinfo[t].thread == NULL)
+      haserr = true;
+  }
+  for (t = 0; t < threads; t++)
+  {
+    if (threadinfo[t].thread != NULL)
+    {
+      gt_thread_join(threadinfo[t].thread);
+      gt_thread_delete(threadinfo[t].thread);
+    }
+    if (!haserr)
+    {
+      for (e = 0; e < gt_array_size(threadinfo[t].edgelog); e++)
       {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_VACANT);
+        GtStrgraphEdgeID *edge = gt_array_get(threadinfo[t].edgelog, e);
+        GT_STRGRAPH_EDGE_SET_MARK(strgraph, edge->vnum, edge->edgenum);
       }
     }
-    if (show_progressbar)
-      progress++;
+    gt_array_delete(threadinfo[t].edgelog);
+    gt_free(threadinfo[t].vmarks);
+  }
+  gt_free(threadinfo);
+  gt_mutex_delete(progressmutex);
+  return haserr ? -1 : 0;
+}
+
+#endif
+
+static GtUword gt_strgraph_redtrans_with_threads(GtStrgraph *strgraph,
+    unsigned int threads, bool show_progressbar)
+{
+  GtStrgraphVnum i;
+  GtUword counter;
+  GtUint64 progress = 0;
+  bool done = false;
+
+  gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+#ifdef GT_THREADS_ENABLED
+  if (threads > 1U && GT_STRGRAPH_NOFVERTICES(strgraph) >= (GtStrgraphVnum)
+      threads)
+  {
+    GtError *err = gt_error_new();
+    if (gt_strgraph_redtrans_mark_threaded(strgraph, threads,
+          show_progressbar ? &progress : NULL, err) == 0)
+      done = true;
+    else
+      gt_log_log("transitive reduction falls back to a single thread: %s",
+          gt_error_get(err));
+    gt_error_delete(err);
+  }
+#else
+  gt_assert(threads > 0);
+#endif
+  if (!done)
+  {
+    for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+      GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
+    for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+    {
+      if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
+        gt_strgraph_redtrans_vertex(strgraph, i, NULL, NULL);
+      if (show_progressbar)
+        progress++;
+    }
   }
   if (show_progressbar)
     gt_progressbar_stop();
@@ -1048,6 +1279,13 @@ GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
+/* return value: number of transitive edges */
+GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+{
+  return gt_strgraph_redtrans_with_threads(strgraph, gt_jobs,
+      show_progressbar);
+}
+
 GtUword gt_strgraph_redsubmax(GtStrgraph *strgraph, bool show_progressbar)
 {
   GtStrgraphVnum i;
@@ -1116,11 +1354,6 @@ static inline GtStrgraphVEdgenum gt_strgraph_find_only_edge(
   return 0; /* to avoid warnings */
 }
 
-typedef struct {
-  GtStrgraphVnum vnum;
-  GtStrgraphVEdgenum edgenum;
-} GtStrgraphEdgeID;
-
 GtUword gt_strgraph_reddepaths(GtStrgraph *strgraph,
     GtUword maxdepth, bool show_progressbar)
 {
@@ -1755,6 +1988,7 @@ void gt_strgraph_show(const GtStrgraph *strgraph, GtStrgraphFormat format,
   GtFile *outfp = NULL;
 
   gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state != GT_STRGRAPH_MAPPED);
   outfp = gt_strgraph_get_file(indexname, suffix, true,
       format == GT_STRGRAPH_ASQG_GZ ? true : false);
   switch (format)
@@ -1778,6 +2012,9 @@ void gt_strgraph_show(const GtStrgraph *strgraph, GtStrgraphFormat format,
     case GT_STRGRAPH_BIN:
       gt_strgraph_save(strgraph, outfp);
       break;
+    case GT_STRGRAPH_CSR:
+      gt_strgraph_save_csr(strgraph, outfp);
+      break;
     default:
       gt_assert(false);
       break;
@@ -2092,6 +2329,107 @@ static void gt_strgraph_count_junctions(GtStrgraph *strgraph)
 }
 #endif
 
+/* --- Traversal of a memory mapped string graph --- */
+
+#define GT_STRGRAPH_CSR_OUTDEG(CSR, V) \
+  gt_strgraph_csr_outdeg(CSR, (GtUword)(V))
+
+#define GT_STRGRAPH_CSR_IS_INTERNAL(CSR, V) \
+  (GT_STRGRAPH_CSR_OUTDEG(CSR, V) == 1UL && \
+   GT_STRGRAPH_CSR_OUTDEG(CSR, GT_STRGRAPH_V_OTHER(V)) == 1UL)
+
+static inline void gt_strgraph_csr_traverse_simple_path(
+    const GtStrgraphCSR *csr, GtBitsequence *eliminated, GtStrgraphVnum i,
+    GtUword dest, GtUword len, void(*process_edge)
+    (GtStrgraphVnum, GtStrgraphLength, void*), void *data)
+{
+  GtStrgraphCSREdgeIterator it;
+  GtStrgraphVnum to = (GtStrgraphVnum)dest;
+  GT_UNUSED bool found;
+
+  while (GT_STRGRAPH_CSR_IS_INTERNAL(csr, to) && i != to &&
+      !GT_ISIBITSET(eliminated, to))
+  {
+    if (process_edge != NULL)
+      process_edge(to, (GtStrgraphLength)len, data);
+    GT_SETIBIT(eliminated, to);
+    GT_SETIBIT(eliminated, GT_STRGRAPH_V_OTHER(to));
+    gt_strgraph_csr_edges_init(csr, (GtUword)to, &it);
+    found = gt_strgraph_csr_edges_next(&it, &dest, &len);
+    gt_assert(found);
+    to = (GtStrgraphVnum)dest;
+  }
+  if (process_edge != NULL)
+    process_edge(to, (GtStrgraphLength)len, data);
+}
+
+static void gt_strgraph_csr_traverse(const GtStrgraphCSR *csr,
+    void(*process_start) (GtStrgraphVnum, void*),
+    void(*process_edge) (GtStrgraphVnum, GtStrgraphLength, void*),
+    void *data, bool show_progressbar)
+{
+  GtStrgraphCSREdgeIterator it;
+  GtBitsequence *eliminated;
+  GtStrgraphVnum i, nofvertices;
+  GtUword dest, len;
+  GtUint64 progress = 0;
+
+  nofvertices = (GtStrgraphVnum)gt_strgraph_csr_nofvertices(csr);
+  GT_INITBITTAB(eliminated, nofvertices);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress, (GtUint64)nofvertices);
+
+  for (i = 0; i < nofvertices; i++)
+  {
+    if (!GT_ISIBITSET(eliminated, i))
+    {
+      if (GT_STRGRAPH_CSR_OUTDEG(csr, i) == 0)
+      {
+        GT_SETIBIT(eliminated, i);
+      }
+      else if (!GT_STRGRAPH_CSR_IS_INTERNAL(csr, i))
+      {
+        gt_strgraph_csr_edges_init(csr, (GtUword)i, &it);
+        while (gt_strgraph_csr_edges_next(&it, &dest, &len))
+        {
+          if (GT_ISIBITSET(eliminated, dest))
+            continue;
+          if (process_start != NULL)
+            process_start(i, data);
+          gt_strgraph_csr_traverse_simple_path(csr, eliminated, i, dest, len,
+              process_edge, data);
+        }
+        GT_SETIBIT(eliminated, i);
+      }
+    }
+    if (show_progressbar)
+      progress++;
+  }
+
+  if (show_progressbar)
+    gt_progressbar_stop();
+
+  /* handle circles of internal vertices only */
+  for (i = 0; i < nofvertices; i++)
+  {
+    if (GT_STRGRAPH_CSR_IS_INTERNAL(csr, i) && !GT_ISIBITSET(eliminated, i))
+    {
+      gt_strgraph_csr_edges_init(csr, (GtUword)i, &it);
+      while (gt_strgraph_csr_edges_next(&it, &dest, &len))
+      {
+        if (GT_ISIBITSET(eliminated, dest))
+          continue;
+        if (process_start != NULL)
+          process_start(i, data);
+        gt_strgraph_csr_traverse_simple_path(csr, eliminated, i, dest, len,
+            process_edge, data);
+      }
+    }
+  }
+  gt_free(eliminated);
+}
+
 static void gt_strgraph_traverse(GtStrgraph *strgraph,
     void(*process_start) (GtStrgraphVnum, void*),
     void(*process_edge) (GtStrgraphVnum, GtStrgraphLength, void*),
@@ -2102,6 +2440,13 @@ static void gt_strgraph_traverse(GtStrgraph *strgraph,
 
   gt_assert(strgraph != NULL);
 
+  if (strgraph->state == GT_STRGRAPH_MAPPED)
+  {
+    gt_strgraph_csr_traverse(strgraph->csr, process_start, process_edge,
+        data, show_progressbar);
+    return;
+  }
+
 #ifdef GG_DEBUG
   gt_strgraph_count_junctions(strgraph);
 #endif
@@ -2155,6 +2500,32 @@ static void gt_strgraph_traverse(GtStrgraph *strgraph,
 
 /* --- Contig Paths Output --- */
 
+/* the following also work for memory mapped string graphs */
+
+static inline GtStrgraphVnum gt_strgraph_get_nofvertices(
+    const GtStrgraph *strgraph)
+{
+  if (strgraph->state == GT_STRGRAPH_MAPPED)
+    return (GtStrgraphVnum)gt_strgraph_csr_nofvertices(strgraph->csr);
+  return GT_STRGRAPH_NOFVERTICES(strgraph);
+}
+
+static inline GtUword gt_strgraph_get_outdeg(const GtStrgraph *strgraph,
+    GtStrgraphVnum v)
+{
+  if (strgraph->state == GT_STRGRAPH_MAPPED)
+    return gt_strgraph_csr_outdeg(strgraph->csr, (GtUword)v);
+  return (GtUword)GT_STRGRAPH_V_OUTDEG(strgraph, v);
+}
+
+static inline bool gt_strgraph_get_is_junction(const GtStrgraph *strgraph,
+    GtStrgraphVnum v)
+{
+  GtUword outdeg = gt_strgraph_get_outdeg(strgraph, v),
+          indeg = gt_strgraph_get_outdeg(strgraph, GT_STRGRAPH_V_OTHER(v));
+  return (outdeg > 1UL && indeg > 0) || (outdeg == 1UL && indeg > 1UL);
+}
+
 GT_DECLAREARRAYSTRUCT(GtContigpathElem);
 
 typedef struct {
@@ -2199,16 +2570,18 @@ static inline void gt_strgraph_show_contiginfo(GtStrgraphContigpathsData *pdata)
   GtContigEdgesLink cjl;
   GtContigJunctionInfo ji;
 
-  cjl.deg = (uint64_t)GT_STRGRAPH_V_INDEG(pdata->strgraph, pdata->firstnode);
+  cjl.deg = (uint64_t)gt_strgraph_get_outdeg(pdata->strgraph,
+      GT_STRGRAPH_V_OTHER(pdata->firstnode));
   cjl.ptr = (uint64_t)GT_STRGRAPH_V_OTHER(pdata->firstnode);
   (void)gt_xfwrite(&cjl, sizeof (cjl), (size_t)1, pdata->cjl_i_file);
 
-  cjl.deg = (uint64_t)GT_STRGRAPH_V_OUTDEG(pdata->strgraph, pdata->lastnode);
+  cjl.deg = (uint64_t)gt_strgraph_get_outdeg(pdata->strgraph,
+      pdata->lastnode);
   cjl.ptr = (uint64_t)pdata->lastnode;
   (void)gt_xfwrite(&cjl, sizeof (cjl), (size_t)1, pdata->cjl_o_file);
 
   ji.contig_num = (uint32_t)pdata->contignum;
-  if (GT_STRGRAPH_V_IS_JUNCTION(pdata->strgraph, pdata->firstnode))
+  if (gt_strgraph_get_is_junction(pdata->strgraph, pdata->firstnode))
   {
     ji.junction_num = (GtUword)pdata->firstnode;
     ji.firstnode = 1U;
@@ -2217,7 +2590,7 @@ static inline void gt_strgraph_show_contiginfo(GtStrgraphContigpathsData *pdata)
     (void)gt_xfwrite(&ji, sizeof (ji), (size_t)1, pdata->ji_file);
     pdata->jnum++;
   }
-  if (GT_STRGRAPH_V_IS_JUNCTION(pdata->strgraph, pdata->lastnode))
+  if (gt_strgraph_get_is_junction(pdata->strgraph, pdata->lastnode))
   {
     ji.junction_num = (GtUword)(GT_STRGRAPH_V_OTHER(pdata->lastnode));
     ji.firstnode = 0;
@@ -2295,7 +2668,7 @@ static void gt_strgraph_show_contigpaths(GtStrgraph *strgraph,
   pdata.cjl_o_file = cjl_o_file;
   pdata.ji_file = ji_file;
   pdata.min_depth = min_path_depth;
-  pdata.nof_v = GT_STRGRAPH_NOFVERTICES(strgraph);
+  pdata.nof_v = gt_strgraph_get_nofvertices(strgraph);
   pdata.strgraph = strgraph;
 
   /* leave space for header */
@@ -2347,7 +2720,7 @@ static void gt_strgraph_spell_edge(GtStrgraphVnum v, GtStrgraphLength len,
 
   GtStrgraphSpellData *sdata = data;
   gt_contigs_writer_append(sdata->cw, GT_STRGRAPH_V_MIRROR_SEQNUM(
-        GT_STRGRAPH_NOFVERTICES(sdata->strgraph), v), (GtUword)len);
+        gt_strgraph_get_nofvertices(sdata->strgraph), v), (GtUword)len);
   (sdata->current_depth)++;
   sdata->current_length += len;
 }
@@ -2367,8 +2740,8 @@ static void gt_strgraph_spell_vertex(GtStrgraphVnum firstvertex, void *data)
     gt_contigs_writer_abort(sdata->cw);
 
   gt_contigs_writer_start(sdata->cw,
-      GT_STRGRAPH_V_MIRROR_SEQNUM(GT_STRGRAPH_NOFVERTICES(sdata->strgraph),
-        firstvertex));
+      GT_STRGRAPH_V_MIRROR_SEQNUM(
+        gt_strgraph_get_nofvertices(sdata->strgraph), firstvertex));
   sdata->current_length = (GtUword)GT_STRGRAPH_SEQLEN(sdata->strgraph,
       firstvertex);
   sdata->current_depth = 1UL;
@@ -2563,14 +2936,10 @@ static int gt_strgraph_add_spm_unit_test(GtError *err)
   return had_err;
 }
 
-static int gt_strgraph_redtrans_unit_test(GtError *err)
+static GtStrgraph *gt_strgraph_redtrans_unit_test_graph(void)
 {
-  int had_err = 0;
   GtStrgraph *strgraph;
   GtUword nofreads = 5UL;
-  GT_ENSURE_OUTPUT_DECLARE(2000);
-
-  gt_error_check(err);
 
   /*
   test case:
@@ -2603,6 +2972,18 @@ static int gt_strgraph_redtrans_unit_test(GtError *err)
   gt_spmproc_strgraph_add(1UL, 0UL, 16UL, false, true, strgraph);
   gt_spmproc_strgraph_add(1UL, 2UL, 9UL, false, true, strgraph);
   gt_spmproc_strgraph_add(0UL, 2UL, 15UL, true, true, strgraph);
+  return strgraph;
+}
+
+static int gt_strgraph_redtrans_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtStrgraph *strgraph;
+  GT_ENSURE_OUTPUT_DECLARE(2000);
+
+  gt_error_check(err);
+
+  strgraph = gt_strgraph_redtrans_unit_test_graph();
   GT_ENSURE_OUTPUT(gt_strgraph_dot_show(strgraph, outfp, false),
       "digraph StringGraph {\n"
       " \"0B\" -> \"4E\" [label=12];\n"
@@ -2666,6 +3047,25 @@ static int gt_strgraph_redtrans_unit_test(GtError *err)
       "}\n"
     );
 
+  gt_strgraph_delete(strgraph);
+
+  /* the threaded reduction must give the same result */
+  strgraph = gt_strgraph_redtrans_unit_test_graph();
+  gt_strgraph_sort_edges_by_len(strgraph, false);
+  gt_ensure(gt_strgraph_redtrans_with_threads(strgraph, 3U, false) == 6UL);
+  GT_ENSURE_OUTPUT(gt_strgraph_dot_show(strgraph, outfp, false),
+      "digraph StringGraph {\n"
+      " \"0B\" -> \"1E\" [label=6];\n"
+      " \"0E\" -> \"2E\" [label=7];\n"
+      " \"1B\" -> \"0E\" [label=6];\n"
+      " \"1E\" -> \"3B\" [label=3];\n"
+      " \"2B\" -> \"0B\" [label=7];\n"
+      " \"3B\" -> \"4E\" [label=3];\n"
+      " \"3E\" -> \"1B\" [label=3];\n"
+      " \"4B\" -> \"3E\" [label=3];\n"
+      "}\n"
+    );
+
   gt_strgraph_delete(strgraph);
   return had_err;
 }
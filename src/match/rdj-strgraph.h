@@ -94,6 +94,8 @@ typedef enum {
   GT_STRGRAPH_BIN,     /* binary format, for gt_strgraph_new_from_file */
   GT_STRGRAPH_ASQG,    /* sga format, plain text */
   GT_STRGRAPH_ASQG_GZ, /* sga format, gzipped */
+  GT_STRGRAPH_CSR,     /* compressed read-only format, for
+                          gt_strgraph_new_from_csr_file */
 } GtStrgraphFormat;
 
 void gt_strgraph_show(const GtStrgraph *strgraph, GtStrgraphFormat format,
@@ -115,6 +117,12 @@ int gt_strgraph_load_reads_library_table(GtStrgraph *strgraph,
 GtStrgraph* gt_strgraph_new_from_file(const GtEncseq *encseq,
     GtUword fixlen, const char *indexname, const char *suffix);
 
+/* memory maps a string graph saved in GT_STRGRAPH_CSR format; the
+   returned string graph is read-only and can only be used for
+   gt_strgraph_spell; returns NULL and sets <err> on error */
+GtStrgraph* gt_strgraph_new_from_csr_file(const GtEncseq *encseq,
+    GtUword fixlen, const char *indexname, const char *suffix, GtError *err);
+
 /* --- simplify --- */
 
 void gt_strgraph_sort_edges_by_len(GtStrgraph *strgraph, bool show_progressbar);
@@ -1132,7 +1132,14 @@ static void gt_extend_prettyprint(bool forxdrop,const GtQuerymatch *querymatch,
   if (gt_querymatch_check_final(querymatch,errorpercentage,
                                 userdefinedleastlength))
   {
-    gt_querymatch_prettyprint(querymatch);
+    if (processinfo_and_querymatchspaceptr->querymatch_table != NULL)
+    {
+      gt_querymatch_table_add(processinfo_and_querymatchspaceptr->
+                                querymatch_table,querymatch);
+    } else
+    {
+      gt_querymatch_prettyprint(querymatch);
+    }
   }
 }
 
@@ -77,7 +77,11 @@ typedef struct
 {
   void *processinfo;
   GtQuerymatch *querymatchspaceptr;
-} GtProcessinfo_and_querymatchspaceptr;;
+  GtArrayGtQuerymatch *querymatch_table; /* if not NULL, the matches of the
+                                            <..._with_output> functions are
+                                            appended to this table rather
+                                            than shown */
+} GtProcessinfo_and_querymatchspaceptr;
 
 GtXdropmatchinfo *gt_xdrop_matchinfo_new(GtUword userdefinedleastlength,
                                          GtUword errorpercentage,
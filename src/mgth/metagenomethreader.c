@@ -424,11 +424,14 @@ int gt_metagenomethreader(int argc, const char **argv, GtError * err)
     parsestruct.giexp_flag = MGTH_UNSET;
     parsestruct.gi_flag = MGTH_UNSET;
 
-    /* Variablen (Zeilennummer, Fehlercode) zur Fehlerbehandlung waehrend
-       des Parsvorganges des XML-Files */
-    parsestruct.xml_linenumber = 0;
+    /* Fehlercode zur Fehlerbehandlung waehrend des Parsvorganges des
+       XML-Files */
     parsestruct.had_err = 0;
 
+    /* ohne parallele Berechnung werden die Ergebnisse direkt ausgegeben */
+    parsestruct.querybatch = NULL;
+    parsestruct.query_result = NULL;
+
     /* Zaehlvariablen fuer die Anzahl der Syn- und Nichtsynonymen
        DNA-Austausche */
     parsestruct.syn = 0.0;
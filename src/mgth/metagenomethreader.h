@@ -170,6 +170,17 @@ typedef struct
     codingcounter;
 } GenePrediction_static;
 
+/* Struktur zur Zwischenspeicherung der Ergebnisse einer Query bei
+   paralleler Berechnung; die Ausgabe erfolgt erst, wenn alle vorherigen
+   Queries ausgegeben wurden */
+typedef struct
+{
+  CombinedScoreMatrixEntry **combinedscore_matrix;
+  HitInformation hit_information;
+  GtUword contig_len;
+  GtArray *regionmatrices;             /* Elemente: RegionStruct ** */
+} QueryResult;
+
 /* Typdefinition der Struktur, die als Data an die Expat-Funktionen
    uebergeben werden kann Hauptstruktur, die auch an die wesentlichen
    anderen Funktionen uebergeben wird */
@@ -201,6 +212,12 @@ typedef struct
    *hithash,
    *resulthits;
   GtDlist *outlist;
+  /* bei paralleler Berechnung (-j > 1) die Queries, deren Ausgabe noch
+     aussteht, sonst NULL */
+  struct MgQueryBatch *querybatch;
+  /* ist query_result gesetzt, werden die Ergebnisse einer Query dort
+     abgelegt statt direkt ausgegeben */
+  QueryResult *query_result;
   GtError *err;
   int had_err;
   unsigned short def_flag,
@@ -209,8 +226,7 @@ typedef struct
     xml_tag_flag,
     giexp_flag,
     gi_flag;
-  GtUword xml_linenumber,
-    hits_memory;
+  GtUword hits_memory;
   double syn,
     non_syn;
   MatrixMemory matrix_info;
@@ -250,6 +266,19 @@ int mg_curl(ParseStruct *, GtUword, GtError *);
    Returnwert: void */
 int mg_combinedscore(ParseStruct *, GtUword, GtError *);
 
+/* Funktion zur Freigabe einer Combined-Score-Matrix und der zugehoerigen
+   HitInformation-Struktur
+   Parameter: CombinedScore-Matrix, Laenge der Query-Sequenz, Zeiger auf
+              die HitInformation-Struktur
+   Returnwert: void */
+void mg_combinedscore_matrix_delete(CombinedScoreMatrixEntry **, GtUword,
+                                    HitInformation *);
+
+/* Funktion zur Freigabe einer RegionStruct-Matrix (7 Zeilen, 1 Spalte)
+   Parameter: RegionStruct-Matrix
+   Returnwert: void */
+void mg_regionmatrix_delete(RegionStruct **);
+
 /* Funktion zur Ausgabe der berechneten Ergebnisse
    Parameter:  Zeiger auf ParseStruct-Struktur, CombinedScore-Matrix,
                die HitInformation-Struktur, die RegionStruct-Struktur,
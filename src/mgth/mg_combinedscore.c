@@ -78,6 +78,12 @@ int mg_combinedscore(ParseStruct *parsestruct_ptr,
   /* Check Umgebungsvariablen */
   gt_error_check(err);
 
+  /* die Zaehler der Syn- und Nichtsynonymen Austausche beginnen fuer jede
+     Query bei 0, damit das Ergebnis nicht von der Reihenfolge der
+     Berechnung abhaengt */
+  parsestruct_ptr->syn = 0.0;
+  parsestruct_ptr->non_syn = 0.0;
+
   /* Zeiger auf den vollstaendigen Query-DNA Eintrag */
   contig_seq_ptr = gt_str_get(MATRIXSTRUCT(query_dna));
 
@@ -310,6 +316,33 @@ int mg_combinedscore(ParseStruct *parsestruct_ptr,
                              7, contig_len, parsestruct_ptr, err);
   }
 
+  gt_trans_table_delete(transtable);
+
+  /* bei paralleler Berechnung werden Matrix und Hit-Informationen erst
+     nach der Ausgabe der Query freigegeben */
+  if (!had_err && PARSESTRUCT(query_result))
+  {
+    PARSESTRUCT(query_result)->combinedscore_matrix = combinedscore_matrix;
+    PARSESTRUCT(query_result)->hit_information = hit_information;
+    PARSESTRUCT(query_result)->contig_len = contig_len;
+  }
+  else
+  {
+    mg_combinedscore_matrix_delete(combinedscore_matrix, contig_len,
+                                   &hit_information);
+  }
+
+  return had_err;
+}
+
+void mg_combinedscore_matrix_delete(CombinedScoreMatrixEntry
+                                    **combinedscore_matrix,
+                                    GtUword contig_len,
+                                    HitInformation *hit_information)
+{
+  GtUword i,
+    j;
+
   for (i = 0; i < 7; i++)
   {
     for (j = 0; j < contig_len; j++)
@@ -320,15 +353,11 @@ int mg_combinedscore(ParseStruct *parsestruct_ptr,
 
   gt_array2dim_delete(combinedscore_matrix);
 
-  gt_trans_table_delete(transtable);
-
-  gt_str_array_delete(hit_information.hit_gi);
-  gt_str_array_delete(hit_information.hit_def);
-  gt_str_array_delete(hit_information.hit_hsp_nr);
-  gt_str_array_delete(hit_information.hit_from);
-  gt_str_array_delete(hit_information.hit_to);
-
-  return had_err;
+  gt_str_array_delete(hit_information->hit_gi);
+  gt_str_array_delete(hit_information->hit_def);
+  gt_str_array_delete(hit_information->hit_hsp_nr);
+  gt_str_array_delete(hit_information->hit_from);
+  gt_str_array_delete(hit_information->hit_to);
 }
 
 /* Funktion zur Bestimmung der dem Leserahmen entsprechenden Matrix-Zeile */
@@ -190,17 +190,26 @@ int mg_compute_gene_prediction(CombinedScoreMatrixEntry
            kodierender Bereiche geprueft wird */
         genemergeprocessing(parsestruct_ptr, regionmatrix, err);
 
-        /* Aufruf der Ausgabefunktion und Ausgabe der Ergebnisse */
-        mg_outputwriter(parsestruct_ptr, combinedscore_matrix,
-                        hit_information, regionmatrix, 'h', err);
-
-        for (row_idx = 0; row_idx < 7; row_idx++)
+        /* bei paralleler Berechnung wird die regionmatrix fuer die
+           spaetere Ausgabe zwischengespeichert */
+        if (PARSESTRUCT(query_result))
         {
-          gt_array_delete(regionmatrix[row_idx][0].from);
-          gt_array_delete(regionmatrix[row_idx][0].to);
+          gt_array_add(PARSESTRUCT(query_result)->regionmatrices,
+                       regionmatrix);
         }
+        else
+        {
+          /* Aufruf der Ausgabefunktion und Ausgabe der Ergebnisse */
+          mg_outputwriter(parsestruct_ptr, combinedscore_matrix,
+                          hit_information, regionmatrix, 'h', err);
+
+          mg_regionmatrix_delete(regionmatrix);
+        }
+      }
+      else
+      {
+        gt_array2dim_delete(regionmatrix);
       }
-      gt_array2dim_delete(regionmatrix);
       gt_free(frame_counter);
     }
   }
@@ -209,6 +218,18 @@ int mg_compute_gene_prediction(CombinedScoreMatrixEntry
   return had_err;
 }
 
+void mg_regionmatrix_delete(RegionStruct **regionmatrix)
+{
+  unsigned short row_idx;
+
+  for (row_idx = 0; row_idx < 7; row_idx++)
+  {
+    gt_array_delete(regionmatrix[row_idx][0].from);
+    gt_array_delete(regionmatrix[row_idx][0].to);
+  }
+  gt_array2dim_delete(regionmatrix);
+}
+
 static void gene_prediction(unsigned short row,
                             GtUword column,
                             double max_lastcolumn,
@@ -0,0 +1,302 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/thread_api.h"
+#include "mg_querybatch.h"
+
+/* Anzahl der Queries pro Thread, die gesammelt werden, bevor die
+   Berechnung startet */
+#define MG_QUERYBATCH_QUERIES_PER_THREAD  16
+
+/* Struktur einer gesammelten Query */
+typedef struct
+{
+  /* Kopie der ParseStruct mit eigenen Matrix-Informationen, eigenem
+     GtError und eigenen "Static"-Variablen der Genvorhersage */
+  ParseStruct parsestruct;
+  QueryResult result;
+  GtUword hit_counter;
+  GtError *err;
+  int had_err;
+} MgQuery;
+
+struct MgQueryBatch
+{
+  GtArray *queries;                    /* Elemente: MgQuery * */
+  unsigned int threads;
+};
+
+/* Struktur fuer die Verteilung der Queries auf die Threads */
+typedef struct
+{
+  GtArray *queries;
+  GtUword *nextquery;
+  GtMutex *mutex;
+} MgQueryBatchThreadInfo;
+
+MgQueryBatch* mg_querybatch_new(unsigned int threads)
+{
+  MgQueryBatch *querybatch;
+
+  gt_assert(threads > 1);
+  querybatch = gt_malloc(sizeof *querybatch);
+  querybatch->queries = gt_array_new(sizeof (MgQuery *));
+  querybatch->threads = threads;
+
+  return querybatch;
+}
+
+static void mg_query_delete(MgQuery *query)
+{
+  MatrixMemory *matrix_info = &query->parsestruct.matrix_info;
+  GtUword i;
+
+  for (i = 0; i < gt_array_size(query->result.regionmatrices); i++)
+  {
+    mg_regionmatrix_delete(*(RegionStruct ***)
+                           gt_array_get(query->result.regionmatrices, i));
+  }
+  gt_array_delete(query->result.regionmatrices);
+  if (query->result.combinedscore_matrix)
+  {
+    mg_combinedscore_matrix_delete(query->result.combinedscore_matrix,
+                                   query->result.contig_len,
+                                   &query->result.hit_information);
+  }
+
+  gt_array_delete(matrix_info->query_frame);
+  gt_array_delete(matrix_info->hit_frame);
+  gt_array_delete(matrix_info->query_from);
+  gt_array_delete(matrix_info->query_to);
+  gt_str_delete(matrix_info->query_dna);
+  gt_str_delete(matrix_info->query_def);
+  gt_str_array_delete(matrix_info->hit_gi_nr);
+  gt_str_array_delete(matrix_info->hit_num);
+  gt_str_array_delete(matrix_info->hit_gi_def);
+  gt_str_array_delete(matrix_info->hit_acc);
+  gt_str_array_delete(matrix_info->fasta_row);
+  gt_str_array_delete(matrix_info->hit_from);
+  gt_str_array_delete(matrix_info->hit_to);
+  gt_str_array_delete(matrix_info->hit_dna);
+  gt_str_array_delete(matrix_info->hsp_qseq);
+  gt_str_array_delete(matrix_info->hsp_hseq);
+
+  gt_error_delete(query->err);
+  gt_free(query);
+}
+
+int mg_querybatch_add(MgQueryBatch *querybatch,
+                      ParseStruct *parsestruct_ptr,
+                      GtUword hit_counter, GtError *err)
+{
+  MgQuery *query;
+  MatrixMemory *matrix_info;
+
+  gt_error_check(err);
+
+  query = gt_calloc(1, sizeof *query);
+  query->parsestruct = *parsestruct_ptr;
+  query->hit_counter = hit_counter;
+  query->err = gt_error_new();
+  query->parsestruct.err = query->err;
+  query->parsestruct.querybatch = NULL;
+  query->parsestruct.query_result = &query->result;
+  query->result.regionmatrices = gt_array_new(sizeof (RegionStruct **));
+
+  /* die pro Query angelegten StringArrays werden uebernommen und in der
+     ParseStruct auf NULL gesetzt, die fuer alle Queries verwendeten
+     GtArrays und Strings werden kopiert */
+  matrix_info = &query->parsestruct.matrix_info;
+  MATRIXSTRUCT(hit_gi_nr) = NULL;
+  MATRIXSTRUCT(hit_num) = NULL;
+  MATRIXSTRUCT(hit_gi_def) = NULL;
+  MATRIXSTRUCT(hit_acc) = NULL;
+  MATRIXSTRUCT(fasta_row) = NULL;
+  MATRIXSTRUCT(hit_from) = NULL;
+  MATRIXSTRUCT(hit_to) = NULL;
+  MATRIXSTRUCT(hit_dna) = NULL;
+  MATRIXSTRUCT(hsp_qseq) = NULL;
+  MATRIXSTRUCT(hsp_hseq) = NULL;
+  matrix_info->query_frame = gt_array_clone(MATRIXSTRUCT(query_frame));
+  matrix_info->hit_frame = gt_array_clone(MATRIXSTRUCT(hit_frame));
+  matrix_info->query_from = gt_array_clone(MATRIXSTRUCT(query_from));
+  matrix_info->query_to = gt_array_clone(MATRIXSTRUCT(query_to));
+  matrix_info->query_dna = gt_str_clone(MATRIXSTRUCT(query_dna));
+  matrix_info->query_def = gt_str_clone(MATRIXSTRUCT(query_def));
+
+  gt_array_add(querybatch->queries, query);
+
+  /* ist die Sammlung voll, werden die Queries berechnet und ausgegeben */
+  if (gt_array_size(querybatch->queries) >=
+      (GtUword) querybatch->threads * MG_QUERYBATCH_QUERIES_PER_THREAD)
+  {
+    return mg_querybatch_flush(querybatch, parsestruct_ptr, err);
+  }
+  return 0;
+}
+
+static void* querybatch_thread(void *data)
+{
+  MgQueryBatchThreadInfo *threadinfo = data;
+  MgQuery *query;
+  GtUword queryctr;
+
+  for (;;)
+  {
+    gt_mutex_lock(threadinfo->mutex);
+    queryctr = (*threadinfo->nextquery)++;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (queryctr >= gt_array_size(threadinfo->queries))
+      break;
+    query = *(MgQuery **) gt_array_get(threadinfo->queries, queryctr);
+    if (query->hit_counter > 0)
+    {
+      query->had_err = mg_combinedscore(&query->parsestruct,
+                                        query->hit_counter, query->err);
+    }
+  }
+  return NULL;
+}
+
+/* Berechnung der Combined-Scores und Genvorhersagen aller Queries; die
+   Queries sind unabhaengig voneinander und werden dynamisch auf die
+   Threads verteilt, da ihr Aufwand stark variiert */
+static void querybatch_compute(MgQueryBatch *querybatch)
+{
+  MgQueryBatchThreadInfo threadinfo;
+  GtUword nextquery = 0;
+  GtThread **threadtab;
+  GtError *err;
+  unsigned int t,
+    threads = querybatch->threads;
+
+  if (threads > gt_array_size(querybatch->queries))
+    threads = (unsigned int) gt_array_size(querybatch->queries);
+
+  threadinfo.queries = querybatch->queries;
+  threadinfo.nextquery = &nextquery;
+  threadinfo.mutex = gt_mutex_new();
+  threadtab = gt_calloc(threads, sizeof *threadtab);
+  err = gt_error_new();
+  /* der aktuelle Thread berechnet ebenfalls Queries; kann ein Thread
+     nicht erzeugt werden, uebernehmen die uebrigen Threads dessen Anteil */
+  for (t = 1; t < threads; t++)
+  {
+    threadtab[t] = gt_thread_new(querybatch_thread, &threadinfo, err);
+    if (!threadtab[t])
+      gt_error_unset(err);
+  }
+  querybatch_thread(&threadinfo);
+  for (t = 1; t < threads; t++)
+  {
+    if (threadtab[t])
+    {
+#ifdef GT_THREADS_ENABLED
+      gt_thread_join(threadtab[t]);
+#endif
+      gt_thread_delete(threadtab[t]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(threadtab);
+  gt_mutex_delete(threadinfo.mutex);
+}
+
+/* Ausgabe einer berechneten Query; die Ausgabe erfolgt ueber die
+   ParseStruct des Parsers, damit die Statistik in der Reihenfolge des
+   XML-Files fortgeschrieben wird */
+static int querybatch_output(ParseStruct *parsestruct_ptr, MgQuery *query,
+                             GtError *err)
+{
+  int had_err = 0;
+  GtStr *query_dna = MATRIXSTRUCT(query_dna),
+    *query_def = MATRIXSTRUCT(query_def);
+  GtUword i;
+
+  MATRIXSTRUCT(query_dna) = query->parsestruct.matrix_info.query_dna;
+  MATRIXSTRUCT(query_def) = query->parsestruct.matrix_info.query_def;
+
+  mg_outputwriter(parsestruct_ptr, NULL, NULL, NULL, 'q', err);
+
+  if (query->had_err)
+  {
+    gt_error_set(err, "%s", gt_error_get(query->err));
+    had_err = -1;
+  }
+  else
+  {
+    for (i = 0; i < gt_array_size(query->result.regionmatrices); i++)
+    {
+      mg_outputwriter(parsestruct_ptr,
+                      query->result.combinedscore_matrix,
+                      &query->result.hit_information,
+                      *(RegionStruct ***)
+                      gt_array_get(query->result.regionmatrices, i),
+                      'h', err);
+    }
+
+    /* Abschluss des Iteration-Bereichs im XML-File */
+    if (ARGUMENTSSTRUCT(outputfile_format) == 3)
+    {
+      mg_outputwriter(parsestruct_ptr, NULL, NULL, NULL, 'x', err);
+    }
+  }
+
+  MATRIXSTRUCT(query_dna) = query_dna;
+  MATRIXSTRUCT(query_def) = query_def;
+
+  return had_err;
+}
+
+int mg_querybatch_flush(MgQueryBatch *querybatch,
+                        ParseStruct *parsestruct_ptr, GtError *err)
+{
+  int had_err = 0;
+  GtUword i;
+
+  gt_error_check(err);
+
+  if (gt_array_size(querybatch->queries) > 0)
+  {
+    querybatch_compute(querybatch);
+
+    /* Ausgabe in der Reihenfolge des XML-Files bis zur ersten Query, bei
+       deren Berechnung ein Fehler aufgetreten ist */
+    for (i = 0; i < gt_array_size(querybatch->queries); i++)
+    {
+      MgQuery *query = *(MgQuery **) gt_array_get(querybatch->queries, i);
+
+      if (!had_err)
+        had_err = querybatch_output(parsestruct_ptr, query, err);
+      mg_query_delete(query);
+    }
+    gt_array_reset(querybatch->queries);
+  }
+
+  return had_err;
+}
+
+void mg_querybatch_delete(MgQueryBatch *querybatch)
+{
+  GtUword i;
+
+  if (!querybatch)
+    return;
+  for (i = 0; i < gt_array_size(querybatch->queries); i++)
+    mg_query_delete(*(MgQuery **) gt_array_get(querybatch->queries, i));
+  gt_array_delete(querybatch->queries);
+  gt_free(querybatch);
+}
@@ -0,0 +1,55 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MG_QUERYBATCH_H
+#define MG_QUERYBATCH_H
+
+#include "metagenomethreader.h"
+
+/* Sammlung von Queries, deren Combined-Scores und Genvorhersagen parallel
+   berechnet werden. Jede Query erhaelt eine eigene Kopie der
+   Matrix-Informationen; die Ergebnisse werden anschliessend vom
+   aufrufenden Thread in der Reihenfolge des XML-Files ausgegeben, so dass
+   die Ausgabe nicht von der Anzahl der Threads abhaengt. */
+typedef struct MgQueryBatch MgQueryBatch;
+
+/* Funktion zum Anlegen einer Query-Sammlung
+   Parameter: Anzahl der Threads (> 1)
+   Returnwert: Zeiger auf die Query-Sammlung */
+MgQueryBatch* mg_querybatch_new(unsigned int);
+
+/* Funktion zum Hinzufuegen der aktuellen Query; die pro Query angelegten
+   StringArrays werden aus der ParseStruct uebernommen, die uebrigen
+   Matrix-Informationen kopiert. Ist die Sammlung voll, werden die Queries
+   berechnet und ausgegeben.
+   Parameter: Query-Sammlung, Zeiger auf die ParseStruct-Struktur, Anzahl
+              der Hits der Query, GtError-Variable
+   Returnwert: had_err */
+int mg_querybatch_add(MgQueryBatch *, ParseStruct *, GtUword, GtError *);
+
+/* Funktion zur Berechnung und Ausgabe aller gesammelten Queries
+   Parameter: Query-Sammlung, Zeiger auf die ParseStruct-Struktur,
+              GtError-Variable
+   Returnwert: had_err */
+int mg_querybatch_flush(MgQueryBatch *, ParseStruct *, GtError *);
+
+/* Funktion zur Freigabe der Query-Sammlung inkl. nicht ausgegebener
+   Queries
+   Parameter: Query-Sammlung
+   Returnwert: void */
+void mg_querybatch_delete(MgQueryBatch *);
+
+#endif
@@ -18,8 +18,13 @@
 #include <ctype.h>
 #include <expat.h>
 #include "mg_xmlparser.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "metagenomethreader.h"
+#include "mg_querybatch.h"
+
+/* Groesse der Bloecke, in denen das XML-File eingelesen wird */
+#define MG_XMLPARSER_BUFSIZE  (64 * 1024)
 
 #ifdef CURLDEF
 #include <curl/curl.h>
@@ -275,22 +280,20 @@ static void check_counter(unsigned short *, char);
 int mg_xmlparser(ParseStruct *parsestruct_ptr, GtFile * fp_xmlfile,
                  GtError * err)
 {
-  int had_err = 0;
+  int had_err = 0,
+    len;
 
   /* Expat XML-Error setzen */
   enum XML_Error error;
 
-  /* Puffer zum zeilenweisen Einlesen des XML-Files, XML_Parser
+  /* Puffer zum blockweisen Einlesen des XML-Files, XML_Parser
      deklarieren */
-  GtStr *buf;
+  void *buf;
   XML_Parser parser;
 
   /* Check Umgebungsvariablen */
   gt_error_check(err);
 
-  /* Puffer-String anlegen */
-  buf = gt_str_new();
-
   /* XML-Parser wird initialisiert */
   parser = XML_ParserCreate(NULL);
   /* Die Struktur parsestruct wird als UserData gesetzt */
@@ -300,39 +303,52 @@ int mg_xmlparser(ParseStruct *parsestruct_ptr, GtFile * fp_xmlfile,
   /* Text-Handler setzen */
   XML_SetCharacterDataHandler(parser, textElement);
 
-  while ((gt_str_read_next_line_generic(buf, fp_xmlfile) != EOF) && !had_err)
+  /* bei mehreren Threads werden die Queries gesammelt und parallel
+     berechnet, sonst direkt nach dem Einlesen */
+  if (PARSESTRUCT(giexp_flag) && gt_jobs > 1)
+    PARSESTRUCT(querybatch) = mg_querybatch_new(gt_jobs);
+
+  /* das XML-File wird blockweise direkt in den Puffer des Parsers
+     eingelesen */
+  do
   {
-    PARSESTRUCT(xml_linenumber)++;
-    if (PARSESTRUCT(had_err))
+    buf = XML_GetBuffer(parser, MG_XMLPARSER_BUFSIZE);
+    if (!buf)
     {
+      gt_error_set(err, "out of memory while parsing file \"%s\"",
+                   gt_str_get(PARSESTRUCT(xmlfile)));
       had_err = -1;
+      break;
     }
+    len = gt_file_xread(fp_xmlfile, buf, MG_XMLPARSER_BUFSIZE);
 
-    if ((XML_Parse(parser, gt_str_get(buf), gt_str_length(buf), false) ==
-         XML_STATUS_ERROR) && !had_err)
+    /* beim letzten (leeren) Block wird das Parsen abgeschlossen */
+    if (XML_ParseBuffer(parser, len, len == 0) == XML_STATUS_ERROR)
     {
       error = XML_GetErrorCode(parser);
       gt_error_set(err,
                 "an error occurred parsing line "GT_WU" of file \"%s\": %s",
-                PARSESTRUCT(xml_linenumber), gt_str_get(PARSESTRUCT(xmlfile)),
-                XML_ErrorString(error));
+                (GtUword) XML_GetCurrentLineNumber(parser),
+                gt_str_get(PARSESTRUCT(xmlfile)), XML_ErrorString(error));
 
       had_err = -1;
     }
-    /* reset line buffer */
-    gt_str_reset(buf);
-  }
+    if (PARSESTRUCT(had_err))
+    {
+      had_err = -1;
+    }
+  } while (len > 0 && !had_err);
 
-  /* finish parsing */
-  if ((XML_Parse(parser, NULL, 0, true) == XML_STATUS_ERROR) && !had_err)
+  /* Berechnung und Ausgabe der noch gesammelten Queries */
+  if (PARSESTRUCT(querybatch))
   {
-    error = XML_GetErrorCode(parser);
-    gt_error_set(err,
-              "an error occurred while finishing the parsing of file\
-               \"%s\": %s",
-              gt_str_get(PARSESTRUCT(xmlfile)), XML_ErrorString(error));
-
-    had_err = -1;
+    if (!had_err)
+    {
+      had_err = mg_querybatch_flush(PARSESTRUCT(querybatch),
+                                    parsestruct_ptr, err);
+    }
+    mg_querybatch_delete(PARSESTRUCT(querybatch));
+    PARSESTRUCT(querybatch) = NULL;
   }
 
   if (PARSESTRUCT(xml_tag_flag) && !(!had_err) && PARSESTRUCT(giexp_flag))
@@ -351,9 +367,8 @@ int mg_xmlparser(ParseStruct *parsestruct_ptr, GtFile * fp_xmlfile,
     gt_str_array_delete(PARSESTRUCT(hit_frame_tmp));
   }
 
-  /* Freigeben des XML-Parser und loeschen des Puffer-Strings */
+  /* Freigeben des XML-Parser */
   XML_ParserFree(parser);
-  gt_str_delete(buf);
 
   return had_err;
 }
@@ -425,11 +440,23 @@ static void XMLCALL endElement(void *data, const char *name)
     if (strcmp(name, gt_str_get(PARSESTRUCT(xml_tag))) == 0
                              && PARSESTRUCT(giexp_flag))
     {
-      if (XMLPARSERSTRUCT(hit_counter) > 0)
+      /* bei mehreren Threads wird die Query nur gesammelt; Berechnung und
+         Ausgabe erfolgen in mg_querybatch_add bzw. mg_querybatch_flush */
+      if (PARSESTRUCT(querybatch))
       {
         PARSESTRUCT(had_err) =
-          mg_combinedscore(parsestruct_ptr, XMLPARSERSTRUCT(hit_counter),
-                           err);
+          mg_querybatch_add(PARSESTRUCT(querybatch), parsestruct_ptr,
+                            XMLPARSERSTRUCT(hit_counter), err);
+      }
+
+      if (XMLPARSERSTRUCT(hit_counter) > 0)
+      {
+        if (!PARSESTRUCT(querybatch))
+        {
+          PARSESTRUCT(had_err) =
+            mg_combinedscore(parsestruct_ptr, XMLPARSERSTRUCT(hit_counter),
+                             err);
+        }
 
         /* Zaehler der Hits pro Hit-GI-Nr */
         XMLPARSERSTRUCT(hit_counter) = 0;
@@ -442,7 +469,8 @@ static void XMLCALL endElement(void *data, const char *name)
       }
 
       /* Schreiben der schliessenden XML-Tags nach der Hit-Bearbeitung */
-      if (ARGUMENTSSTRUCT(outputfile_format) == 3)
+      if (ARGUMENTSSTRUCT(outputfile_format) == 3
+          && !PARSESTRUCT(querybatch))
       {
         /* Abschluss des Iteration-Bereichs im XML-File */
         mg_outputwriter(parsestruct_ptr, NULL, NULL, NULL, 'x', err);
@@ -514,7 +542,9 @@ static void XMLCALL endElement(void *data, const char *name)
                                                               (queryseq),
                                                               query_nr));
           gt_free(seq);
-          mg_outputwriter(parsestruct_ptr, NULL, NULL, NULL, 'q', err);
+          /* bei mehreren Threads erfolgt die Ausgabe mit den Ergebnissen */
+          if (!PARSESTRUCT(querybatch))
+            mg_outputwriter(parsestruct_ptr, NULL, NULL, NULL, 'q', err);
         }
         else
         {
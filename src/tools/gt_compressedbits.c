@@ -24,7 +24,7 @@
 #include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/str_api.h"
-#include "core/str_api.h"
+#include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "extended/compressed_bitsequence.h"
@@ -118,6 +118,48 @@ static GtOptionParser* gt_compressedbits_option_parser_new(void *tool_arguments)
   return op;
 }
 
+/* times <benches> random queries of each kind on <cbs> */
+static void gt_compressedbits_benchmark(GtCompressedBitsequence *cbs,
+                                        GtUword num_of_bits,
+                                        GtUword benches)
+{
+  GtUword idx, ones, zeros, *positions, *nums_1, *nums_0,
+          GT_UNUSED sum = 0;
+  GtTimer *timer;
+
+  ones = gt_compressed_bitsequence_rank_1(cbs, num_of_bits - 1);
+  zeros = num_of_bits - ones;
+  positions = gt_malloc(sizeof (*positions) * benches);
+  nums_1 = gt_malloc(sizeof (*nums_1) * benches);
+  nums_0 = gt_malloc(sizeof (*nums_0) * benches);
+  for (idx = 0; idx < benches; idx++) {
+    positions[idx] = gt_rand_max(num_of_bits - 1);
+    nums_1[idx] = ones > 0 ? gt_rand_max(ones - 1) + 1 : 0;
+    nums_0[idx] = zeros > 0 ? gt_rand_max(zeros - 1) + 1 : 0;
+  }
+  timer = gt_timer_new_with_progress_description("access");
+  gt_timer_start(timer);
+  for (idx = 0; idx < benches; idx++)
+    sum += (GtUword) gt_compressed_bitsequence_access(cbs, positions[idx]);
+  gt_timer_show_progress(timer, "rank_1", stdout);
+  for (idx = 0; idx < benches; idx++)
+    sum += gt_compressed_bitsequence_rank_1(cbs, positions[idx]);
+  gt_timer_show_progress(timer, "rank_0", stdout);
+  for (idx = 0; idx < benches; idx++)
+    sum += gt_compressed_bitsequence_rank_0(cbs, positions[idx]);
+  gt_timer_show_progress(timer, "select_1", stdout);
+  for (idx = 0; ones > 0 && idx < benches; idx++)
+    sum += gt_compressed_bitsequence_select_1(cbs, nums_1[idx]);
+  gt_timer_show_progress(timer, "select_0", stdout);
+  for (idx = 0; zeros > 0 && idx < benches; idx++)
+    sum += gt_compressed_bitsequence_select_0(cbs, nums_0[idx]);
+  gt_timer_show_progress_final(timer, stdout);
+  gt_timer_delete(timer);
+  gt_free(positions);
+  gt_free(nums_1);
+  gt_free(nums_0);
+}
+
 static int gt_compressedbits_runner(GT_UNUSED int argc,
                                     GT_UNUSED const char **argv,
                                     GT_UNUSED int parsed_args,
@@ -207,6 +249,9 @@ static int gt_compressedbits_runner(GT_UNUSED int argc,
       gt_assert(original == bit);
     }
   }
+  if (!had_err && arguments->benches > 0 && num_of_bits > 0)
+    gt_compressedbits_benchmark(read_cbs, (GtUword) num_of_bits,
+                                arguments->benches);
   gt_compressed_bitsequence_delete(cbs);
   gt_compressed_bitsequence_delete(read_cbs);
   gt_free(bits);
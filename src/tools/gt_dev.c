@@ -32,6 +32,7 @@
 #include "tools/gt_gdiffcalc.h"
 #include "tools/gt_guessprot.h"
 #include "tools/gt_idxlocali.h"
+#include "tools/gt_intervaltreebench.h"
 #include "tools/gt_kmer_database.h"
 #include "tools/gt_linspace_align.h"
 #include "tools/gt_magicmatch.h"
@@ -49,6 +50,7 @@
 #include "tools/gt_show_seedext.h"
 #include "tools/gt_skproto.h"
 #include "tools/gt_sortbench.h"
+#include "tools/gt_symbolbench.h"
 #include "tools/gt_trieins.h"
 
 #include "tools/gt_dev.h"
@@ -75,6 +77,8 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "gthbssmrmsd", gt_gthbssmrmsd());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmtrain", gt_gthbssmtrain());
   gt_toolbox_add_tool(dev_toolbox, "idxlocali", gt_idxlocali());
+  gt_toolbox_add_tool(dev_toolbox, "intervaltreebench",
+                      gt_intervaltreebench());
   gt_toolbox_add_tool(dev_toolbox, "kmer_database", gt_kmer_database());
   gt_toolbox_add_tool(dev_toolbox, "linspace_align", gt_linspace_align());
   gt_toolbox_add_tool(dev_toolbox, "magicmatch", gt_magicmatch());
@@ -88,6 +92,7 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "show_seedext", gt_show_seedext());
   gt_toolbox_add_tool(dev_toolbox, "skproto", gt_skproto());
   gt_toolbox_add_tool(dev_toolbox, "sortbench", gt_sortbench());
+  gt_toolbox_add_tool(dev_toolbox, "symbolbench", gt_symbolbench());
   return dev_toolbox;
 }
 
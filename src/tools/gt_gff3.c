@@ -271,6 +271,7 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
   if (!arguments->addids)
     gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
+  gt_gff3_in_stream_enable_node_arena((GtGFF3InStream*) gff3_in_stream);
 
   last_stream = gff3_in_stream;
 
@@ -0,0 +1,213 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array.h"
+#include "core/interval_tree.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_intervaltreebench.h"
+
+typedef struct {
+  GtUword num_intervals,
+          num_queries,
+          maxlen,
+          maxqlen,
+          seqlen;
+  bool verbose;
+} IntervalTreeBenchArguments;
+
+static void *gt_intervaltreebench_arguments_new(void)
+{
+  return gt_calloc((size_t) 1, sizeof (IntervalTreeBenchArguments));
+}
+
+static void gt_intervaltreebench_arguments_delete(void *tool_arguments)
+{
+  IntervalTreeBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_intervaltreebench_option_parser_new(void
+                                                              *tool_arguments)
+{
+  IntervalTreeBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]",
+                            "Benchmarks overlap queries on interval trees "
+                            "before and after freezing them.");
+
+  option = gt_option_new_uword_min("size", "number of random intervals",
+                                   &arguments->num_intervals, 2000000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("queries", "number of random overlap queries",
+                               &arguments->num_queries, 1000000UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("maxlen", "maximal interval length",
+                                   &arguments->maxlen, 10000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("qlen", "maximal query length",
+                                   &arguments->maxqlen, 1000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("seqlen", "length of the sequence the "
+                                   "intervals are placed on",
+                                   &arguments->seqlen, 100000000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+/* returns a random number in [0, n-1] */
+static GtUword gt_intervaltreebench_rand(GtUword n)
+{
+  return n > 1UL ? gt_rand_max(n - 1) : 0;
+}
+
+/* runs all <queries> on <it> and stores for each query the number of hits and
+   a fingerprint of the reported intervals, which depends on their order */
+static GtUword gt_intervaltreebench_run_queries(GtIntervalTree *it,
+                                                const GtRange *queries,
+                                                GtUword num_queries,
+                                                GtArray *hits,
+                                                GtUword *num_of_hits,
+                                                GtUword *fingerprints)
+{
+  GtUword i, j, num_hits = 0;
+
+  for (i = 0; i < num_queries; i++) {
+    GtUword fingerprint = 0;
+    gt_array_reset(hits);
+    gt_interval_tree_find_all_overlapping(it, queries[i].start,
+                                          queries[i].end, hits);
+    for (j = 0; j < gt_array_size(hits); j++) {
+      fingerprint = fingerprint * 31
+                    + (GtUword) *(void**) gt_array_get(hits, j) + 1;
+    }
+    num_of_hits[i] = gt_array_size(hits);
+    fingerprints[i] = fingerprint;
+    num_hits += gt_array_size(hits);
+  }
+  return num_hits;
+}
+
+static int gt_intervaltreebench_runner(GT_UNUSED int argc,
+                                       GT_UNUSED const char **argv,
+                                       GT_UNUSED int parsed_args,
+                                       void *tool_arguments, GtError *err)
+{
+  IntervalTreeBenchArguments *arguments = tool_arguments;
+  GtIntervalTree *it;
+  GtIntervalTreeNode *node;
+  GtTimer *timer = NULL;
+  GtRange *queries;
+  GtArray *hits;
+  GtUword i, start, end, tree_hits, frozen_hits, *tree_num_of_hits,
+          *tree_fingerprints, *frozen_num_of_hits, *frozen_fingerprints;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  timer = gt_timer_new_with_progress_description("inserting intervals");
+  gt_timer_start(timer);
+  it = gt_interval_tree_new(NULL);
+  for (i = 0; i < arguments->num_intervals; i++) {
+    start = gt_intervaltreebench_rand(arguments->seqlen);
+    end = start + gt_intervaltreebench_rand(arguments->maxlen);
+    node = gt_interval_tree_node_new((void*) i, start, end);
+    gt_interval_tree_insert(it, node);
+  }
+  queries = gt_malloc(sizeof (*queries) * (arguments->num_queries + 1));
+  for (i = 0; i < arguments->num_queries; i++) {
+    queries[i].start = gt_intervaltreebench_rand(arguments->seqlen);
+    queries[i].end = queries[i].start
+                     + gt_intervaltreebench_rand(arguments->maxqlen);
+  }
+  hits = gt_array_new(sizeof (void*));
+  tree_num_of_hits = gt_malloc(sizeof (GtUword) * (arguments->num_queries + 1));
+  tree_fingerprints = gt_malloc(sizeof (GtUword) *
+                                (arguments->num_queries + 1));
+  frozen_num_of_hits = gt_malloc(sizeof (GtUword) *
+                                 (arguments->num_queries + 1));
+  frozen_fingerprints = gt_malloc(sizeof (GtUword) *
+                                  (arguments->num_queries + 1));
+
+  gt_timer_show_progress(timer, "tree queries", stdout);
+  tree_hits = gt_intervaltreebench_run_queries(it, queries,
+                                               arguments->num_queries, hits,
+                                               tree_num_of_hits,
+                                               tree_fingerprints);
+  gt_timer_show_progress(timer, "freezing", stdout);
+  gt_interval_tree_freeze(it);
+  gt_timer_show_progress(timer, "frozen queries", stdout);
+  frozen_hits = gt_intervaltreebench_run_queries(it, queries,
+                                                 arguments->num_queries, hits,
+                                                 frozen_num_of_hits,
+                                                 frozen_fingerprints);
+  gt_timer_show_progress_final(timer, stdout);
+
+  printf("# " GT_WU " intervals, " GT_WU " queries, " GT_WU " hits\n",
+         arguments->num_intervals, arguments->num_queries, tree_hits);
+  if (arguments->verbose) {
+    printf("# frozen tree reported " GT_WU " hits\n", frozen_hits);
+  }
+  /* the frozen tree must report the same intervals in the same order */
+  for (i = 0; !had_err && i < arguments->num_queries; i++) {
+    if (tree_num_of_hits[i] != frozen_num_of_hits[i] ||
+        tree_fingerprints[i] != frozen_fingerprints[i]) {
+      gt_error_set(err, "query " GT_WU " (" GT_WU "-" GT_WU "): frozen "
+                   "tree reported other hits than the tree (" GT_WU
+                   " instead of " GT_WU " hits, or in a different order)",
+                   i + 1, queries[i].start, queries[i].end,
+                   frozen_num_of_hits[i], tree_num_of_hits[i]);
+      had_err = -1;
+    }
+  }
+  gt_assert(had_err || tree_hits == frozen_hits);
+
+  gt_timer_delete(timer);
+  gt_free(frozen_fingerprints);
+  gt_free(frozen_num_of_hits);
+  gt_free(tree_fingerprints);
+  gt_free(tree_num_of_hits);
+  gt_array_delete(hits);
+  gt_free(queries);
+  gt_interval_tree_delete(it);
+  return had_err;
+}
+
+GtTool* gt_intervaltreebench(void)
+{
+  return gt_tool_new(gt_intervaltreebench_arguments_new,
+                     gt_intervaltreebench_arguments_delete,
+                     gt_intervaltreebench_option_parser_new,
+                     NULL,
+                     gt_intervaltreebench_runner);
+}
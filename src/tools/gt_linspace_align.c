@@ -16,6 +16,7 @@
 */
 
 #include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
 #include "core/alphabet.h"
 #include "core/chardef.h"
@@ -69,7 +70,8 @@ typedef struct{
              showsequences,
              scoreonly, /* dev option generate alignment, but do not show it*/
              wildcardshow, /* show symbol wildcards in output*/
-             spacetime; /* write space peak and time overall on stdout*/
+             spacetime; /* write space peak, time overall and cells per
+                          second on stdout*/
   GtUword timesquarefactor; /*factor to specified termination of recursion
                               and call 2dim algorithm */
 } GtLinspaceArguments;
@@ -202,8 +204,9 @@ static GtOptionParser* gt_linspace_align_option_parser_new(void *tool_arguments)
                                        &arguments->scoreonly, false);
   gt_option_parser_add_option(op, optionscoreonly);
 
-  optionspacetime = gt_option_new_bool("spacetime", "write space peak and time"
-                                       " overall on stdout",
+  optionspacetime = gt_option_new_bool("spacetime", "write space peak, time "
+                                       "overall and DP cells per second on "
+                                       "stdout",
                                        &arguments->spacetime, false);
   gt_option_parser_add_option(op, optionspacetime);
 
@@ -506,6 +509,7 @@ static int gt_all_against_all_alignment_check(bool affine,
                                         GtWord left_dist,
                                         GtWord right_dist,
                                         GtTimer *linspacetimer,
+                                        GtUword *cells,
                                         GtError *err)
 {
   int had_err = 0;
@@ -547,6 +551,7 @@ static int gt_all_against_all_alignment_check(bool affine,
           }
           if (!had_err)
           {
+            *cells += MIN(ulen, (GtUword) (right_dist - left_dist + 1)) * vlen;
             (affine ? gt_diagonalbandalign_affinegapcost_compute_generic
                     : gt_diagonalbandalign_compute_generic)
                        (spacemanager, scorehandler, align,
@@ -555,6 +560,7 @@ static int gt_all_against_all_alignment_check(bool affine,
           }
         } else
         {
+          *cells += ulen * vlen;
           (affine ? gt_linearalign_affinegapcost_compute_generic
                   : gt_linearalign_compute_generic)
                              (spacemanager, scorehandler, align,
@@ -563,6 +569,7 @@ static int gt_all_against_all_alignment_check(bool affine,
       }
       else if (arguments->local)
       {
+        *cells += ulen * vlen;
         (affine ? gt_linearalign_affinegapcost_compute_local_generic
                 : gt_linearalign_compute_local_generic)
                     (spacemanager, scorehandler, align,
@@ -747,6 +754,7 @@ static int gt_linspace_align_runner(GT_UNUSED int argc,
   GtScoreHandler *scorehandler = NULL;
   GtTimer *linspacetimer = NULL;
   GtAlphabet *alphabet = NULL;
+  GtUword cells = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
@@ -844,15 +852,21 @@ static int gt_linspace_align_runner(GT_UNUSED int argc,
                             sequence_table2,
                             left_dist,
                             right_dist,
-                            linspacetimer,err);
+                            linspacetimer,
+                            &cells, err);
   }
   /*spacetime option*/
   if (!had_err && arguments->spacetime)
   {
+    double seconds;
+
     printf("# combined space peak in kilobytes: %f\n",
            GT_KILOBYTES(gt_linspace_management_get_spacepeak(spacemanager)));
     gt_timer_show_formatted(linspacetimer,"# TIME overall " GT_WD ".%02ld\n",
                             stdout);
+    seconds = gt_timer_get_elapsed_seconds(linspacetimer);
+    printf("# cells per second: %.0f\n",
+           seconds > 0.0 ? (double) cells / seconds : 0.0);
   }
   gt_timer_delete(linspacetimer);
   gt_linspace_management_delete(spacemanager);
@@ -24,9 +24,12 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/bed_in_stream.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
+#include "extended/feature_node_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gtf_in_stream.h"
+#include "extended/region_node_api.h"
 #include "extended/rdb_api.h"
 #ifdef HAVE_MYSQL
 #include "core/password_entry.h"
@@ -37,6 +40,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_MAPPED_BACKEND_STRING "mapped"
 
 typedef struct {
   GtStr *backend,
@@ -88,6 +92,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_MAPPED_BACKEND_STRING,
     NULL
   };
   static const char *inputs[] = {
@@ -116,6 +121,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
                                         "|" GT_MYSQL_BACKEND_STRING
 #endif
+                                        "|" GT_MAPPED_BACKEND_STRING
                                         "]",
                                         arguments->backend, backends[0],
                                         backends);
@@ -130,7 +136,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and mapped backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -190,11 +196,22 @@ static int gt_mkfeatureindex_runner(int argc,
   GtRDB *rdb = NULL;
   GtAnnoDBSchema *adb = NULL;
   GtFeatureIndex *fis = NULL;
+  GtFeatureIndexMappedWriter *writer = NULL;
+  bool mapped;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
+  mapped = (strcmp(gt_str_get(arguments->backend),
+                   GT_MAPPED_BACKEND_STRING) == 0);
+  if (mapped && gt_file_exists(gt_str_get(arguments->filename)) &&
+      !arguments->force) {
+    gt_error_set(err, "file \"%s\" exists already. use option -force to "
+                 "overwrite", gt_str_get(arguments->filename));
+    had_err = -1;
+  }
+
 #ifdef HAVE_SQLITE
   if (strcmp(gt_str_get(arguments->backend),
              GT_SQLITE_BACKEND_STRING) == 0) {
@@ -229,14 +246,22 @@ static int gt_mkfeatureindex_runner(int argc,
   }
 #endif
 
-  adb = gt_anno_db_gfflike_new();
-  if (!had_err && !adb)
-    had_err = -1;
-
-  if (!had_err) {
-    fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
-    if (!fis)
+  if (mapped) {
+    if (!had_err &&
+        !(writer = gt_feature_index_mapped_writer_new(
+                                     gt_str_get(arguments->filename), err)))
+      had_err = -1;
+  }
+  else {
+    adb = gt_anno_db_gfflike_new();
+    if (!had_err && !adb)
       had_err = -1;
+
+    if (!had_err) {
+      fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
+      if (!fis)
+        had_err = -1;
+    }
   }
 
   if (!had_err) {
@@ -261,9 +286,38 @@ static int gt_mkfeatureindex_runner(int argc,
     }
     gt_assert(in_stream);
 
-    feature_stream = gt_feature_stream_new(in_stream, fis);
-    had_err = gt_node_stream_pull(feature_stream, err);
+    if (mapped) {
+      GtGenomeNode *gn;
+      /* the feature trees are written as they come in */
+      while (!(had_err = gt_node_stream_next(in_stream, &gn, err)) && gn) {
+        if (gt_region_node_try_cast(gn)) {
+          had_err = gt_feature_index_mapped_writer_add_region_node(writer,
+                                                      (GtRegionNode*) gn, err);
+        }
+        else if (gt_feature_node_try_cast(gn)) {
+          had_err = gt_feature_index_mapped_writer_add_feature_node(writer,
+                                                     (GtFeatureNode*) gn, err);
+        }
+        gt_genome_node_delete(gn);
+        if (had_err)
+          break;
+      }
+      if (!had_err)
+        had_err = gt_feature_index_mapped_writer_finish(writer, err);
+    }
+    else {
+      had_err = gt_feature_index_gfflike_bulk_load_begin(fis, err);
+      if (!had_err) {
+        feature_stream = gt_feature_stream_new(in_stream, fis);
+        had_err = gt_node_stream_pull(feature_stream, err);
+        if (!had_err)
+          had_err = gt_feature_index_gfflike_bulk_load_end(fis, err);
+        else
+          gt_feature_index_gfflike_bulk_load_abort(fis);
+      }
+    }
   }
+  gt_feature_index_mapped_writer_delete(writer);
   gt_node_stream_delete(feature_stream);
   gt_node_stream_delete(in_stream);
   gt_feature_index_delete(fis);
@@ -36,8 +36,8 @@ typedef struct {
   unsigned int minmatchlength;
   unsigned int lengthcutoff, depthcutoff;
   GtStr  *readset, *buffersizearg;
-  bool errors, paths2seq, redtrans, save, load, vd, astat, copynum,
-       show_contigs_info;
+  bool errors, paths2seq, redtrans, save, load, savecsr, loadcsr, vd, astat,
+       copynum, show_contigs_info;
   unsigned int deadend, bubble, deadend_depth;
   GtOption *refoptionbuffersize;
   GtUword buffersize;
@@ -72,7 +72,8 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   GtReadjoinerAssemblyArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *option, *errors_option, *deadend_option, *v_option,
-           *q_option, *bubble_option, *deadend_depth_option;
+           *q_option, *bubble_option, *deadend_depth_option, *load_option,
+           *save_option, *redtrans_option, *savecsr_option;
   gt_assert(arguments);
 
   /* init */
@@ -113,10 +114,10 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   gt_option_parser_add_option(op, option);
 
   /* -redtrans */
-  option = gt_option_new_bool("redtrans", "reduce transitive edges",
+  redtrans_option = gt_option_new_bool("redtrans", "reduce transitive edges",
       &arguments->redtrans, false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(redtrans_option);
+  gt_option_parser_add_option(op, redtrans_option);
 
   /* -errors */
   errors_option = gt_option_new_bool("errors", "search graph features which "
@@ -201,16 +202,35 @@ static GtOptionParser* gt_readjoiner_assembly_option_parser_new(
   gt_option_exclude(q_option, v_option);
 
   /* -load */
-  option = gt_option_new_bool("load", "save the string graph from file",
+  load_option = gt_option_new_bool("load", "save the string graph from file",
       &arguments->load, false);
-  gt_option_is_development_option(option);
-  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(load_option);
+  gt_option_parser_add_option(op, load_option);
 
   /* -save */
-  option = gt_option_new_bool("save", "save the string graph to file",
+  save_option = gt_option_new_bool("save", "save the string graph to file",
       &arguments->save, false);
+  gt_option_is_development_option(save_option);
+  gt_option_parser_add_option(op, save_option);
+
+  /* -savecsr */
+  savecsr_option = gt_option_new_bool("savecsr", "save the simplified string "
+      "graph to file in compressed read-only format (see -loadcsr)",
+      &arguments->savecsr, false);
+  gt_option_is_development_option(savecsr_option);
+  gt_option_parser_add_option(op, savecsr_option);
+
+  /* -loadcsr */
+  option = gt_option_new_bool("loadcsr", "memory map the string graph saved "
+      "using -savecsr and only output contigs, e.g. for trying different "
+      "-depthcutoff/-lengthcutoff values", &arguments->loadcsr, false);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
+  gt_option_exclude(option, load_option);
+  gt_option_exclude(option, save_option);
+  gt_option_exclude(option, savecsr_option);
+  gt_option_exclude(option, redtrans_option);
+  gt_option_exclude(option, errors_option);
 
   /* -show_contigs_info */
   option = gt_option_new_bool("cinfo", "output additional files required "
@@ -256,6 +276,8 @@ static int gt_readjoiner_assembly_arguments_check(GT_UNUSED int rest_argc,
   "load string graph from file"
 #define GT_READJOINER_ASSEMBLY_MSG_SAVESG \
   "save string graph to file"
+#define GT_READJOINER_ASSEMBLY_MSG_MAPSG \
+  "map string graph from file"
 
 static int gt_readjoiner_assembly_count_spm(const char *readset, bool eqlen,
     unsigned int minmatchlength, unsigned int nspmfiles, GtStrgraph *strgraph,
@@ -447,6 +469,23 @@ static void gt_readjoiner_assembly_load_graph(GtStrgraph **strgraph,
   gt_readjoiner_assembly_show_current_space("(graph loaded)");
 }
 
+static int gt_readjoiner_assembly_map_graph(GtStrgraph **strgraph,
+    GtEncseq *reads, const char *readset, GtUword rlen,
+    GtLogger *default_logger, GtTimer *timer, GtError *err)
+{
+  if (gt_showtime_enabled())
+    gt_timer_show_progress(timer, GT_READJOINER_ASSEMBLY_MSG_MAPSG, stdout);
+  gt_logger_log(default_logger, GT_READJOINER_ASSEMBLY_MSG_MAPSG);
+
+  *strgraph = gt_strgraph_new_from_csr_file(reads, rlen, readset,
+      GT_READJOINER_SUFFIX_SG_CSR, err);
+  if (*strgraph == NULL)
+    return -1;
+
+  gt_readjoiner_assembly_show_current_space("(graph mapped)");
+  return 0;
+}
+
 static int gt_readjoiner_assembly_build_contained_reads_list(
     GtReadjoinerAssemblyArguments *arguments, GtBitsequence **contained,
     GtError *err)
@@ -548,7 +587,12 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
 
     if (had_err == 0)
     {
-      if (!arguments->load)
+      if (arguments->loadcsr)
+      {
+        had_err = gt_readjoiner_assembly_map_graph(&strgraph, reads, readset,
+            rlen, default_logger, timer, err);
+      }
+      else if (!arguments->load)
       {
         had_err = gt_readjoiner_assembly_build_graph(arguments, &strgraph,
             reads, readset, eqlen, rlen, nreads, contained, default_logger,
@@ -602,6 +646,16 @@ static int gt_readjoiner_assembly_runner(GT_UNUSED int argc,
           gt_str_get(arguments->readset), GT_READJOINER_SUFFIX_SG, false);
     }
 
+    if (had_err == 0 && arguments->savecsr)
+    {
+      if (gt_showtime_enabled())
+        gt_timer_show_progress(timer, GT_READJOINER_ASSEMBLY_MSG_SAVESG,
+            stdout);
+      gt_logger_log(default_logger, GT_READJOINER_ASSEMBLY_MSG_SAVESG);
+      gt_strgraph_show(strgraph, GT_STRGRAPH_CSR,
+          gt_str_get(arguments->readset), GT_READJOINER_SUFFIX_SG_CSR, false);
+    }
+
     if (!eqlen && reads != NULL)
     {
       gt_encseq_delete(reads);
@@ -22,6 +22,7 @@
 #include "core/ma_api.h"
 #include "core/option_api.h"
 #include "core/str_api.h"
+#include "core/thread_api.h"
 #include "core/tool_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc.h"
@@ -122,8 +123,17 @@ static int gt_exact_selfmatch_with_output(void *info,
                              len,
                              false))
   {
-    gt_querymatch_prettyprint(processinfo_and_querymatchspaceptr->
-                                         querymatchspaceptr);
+    if (processinfo_and_querymatchspaceptr->querymatch_table != NULL)
+    {
+      gt_querymatch_table_add(processinfo_and_querymatchspaceptr->
+                                querymatch_table,
+                              processinfo_and_querymatchspaceptr->
+                                querymatchspaceptr);
+    } else
+    {
+      gt_querymatch_prettyprint(processinfo_and_querymatchspaceptr->
+                                           querymatchspaceptr);
+    }
   }
   return 0;
 }
@@ -719,6 +729,212 @@ static int gt_callenumquerymatches(bool selfmatch,
   return haserr ? -1 : 0;
 }
 
+static GtXdropmatchinfo *gt_repfind_xdropmatchinfo_new(
+                                         const GtMaxpairsoptions *arguments)
+{
+  GtXdropmatchinfo *xdropmatchinfo
+    = gt_xdrop_matchinfo_new(arguments->userdefinedleastlength,
+                             gt_minidentity2errorpercentage(
+                                          arguments->minidentity),
+                             arguments->xdropbelowscore,
+                             arguments->extendxdrop);
+  gt_assert(xdropmatchinfo != NULL);
+  if (arguments->silent)
+  {
+    gt_xdrop_matchinfo_silent_set(xdropmatchinfo);
+  }
+  return xdropmatchinfo;
+}
+
+static GtGreedyextendmatchinfo *gt_repfind_greedyextendmatchinfo_new(
+                                      const GtMaxpairsoptions *arguments,
+                                      GtExtendCharAccess extend_char_access,
+                                      Polishing_info *pol_info)
+{
+  GtGreedyextendmatchinfo *greedyextendmatchinfo
+    = gt_greedy_extend_matchinfo_new(gt_minidentity2errorpercentage(
+                                           arguments->minidentity),
+                                     arguments->maxalignedlendifference,
+                                     arguments->history,
+                                     arguments->perc_mat_history,
+                                     arguments->userdefinedleastlength,
+                                     extend_char_access,
+                                     arguments->extendgreedy,
+                                     pol_info);
+  if (arguments->check_extend_symmetry)
+  {
+    gt_greedy_extend_matchinfo_check_extend_symmetry_set(
+                                              greedyextendmatchinfo);
+  }
+  if (arguments->silent)
+  {
+    gt_greedy_extend_matchinfo_silent_set(greedyextendmatchinfo);
+  }
+  if (arguments->trimstat)
+  {
+    gt_greedy_extend_matchinfo_trimstat_set(greedyextendmatchinfo);
+  }
+  return greedyextendmatchinfo;
+}
+
+/* returns NULL if neither alignments are shown nor matches are polished */
+static GtQuerymatchoutoptions *gt_repfind_querymatchoutoptions_new(
+                                      const GtMaxpairsoptions *arguments,
+                                      GtExtendCharAccess extend_char_access)
+{
+  GtQuerymatchoutoptions *querymatchoutoptions;
+
+  if (arguments->alignmentwidth == 0 &&
+      (!gt_option_is_set(arguments->refextendxdropoption) ||
+       arguments->noxpolish))
+  {
+    return NULL;
+  }
+  querymatchoutoptions
+    = gt_querymatchoutoptions_new(true, false,arguments->alignmentwidth);
+  if (gt_option_is_set(arguments->refextendxdropoption) ||
+      gt_option_is_set(arguments->refextendgreedyoption))
+  {
+    const GtUword sensitivity
+      = gt_option_is_set(arguments->refextendgreedyoption)
+          ? arguments->extendgreedy
+          : 100;
+
+    gt_querymatchoutoptions_extend(querymatchoutoptions,
+                                   gt_minidentity2errorpercentage(
+                                           arguments->minidentity),
+                                  arguments->maxalignedlendifference,
+                                  arguments->history,
+                                  arguments->perc_mat_history,
+                                  extend_char_access,
+                                  false,
+                                  sensitivity,
+                                  GT_DEFAULT_MATCHSCORE_BIAS,
+                                  true,
+                                  arguments->seed_display);
+  }
+  return querymatchoutoptions;
+}
+
+static GtQuerymatch *gt_repfind_querymatch_new(
+                                const GtMaxpairsoptions *arguments,
+                                GtQuerymatchoutoptions *querymatchoutoptions)
+{
+  GtQuerymatch *querymatch = gt_querymatch_new();
+
+  if (arguments->seed_display)
+  {
+    gt_querymatch_seed_display_set(querymatch);
+  }
+  if (querymatchoutoptions != NULL)
+  {
+    gt_querymatch_outoptions_set(querymatch,querymatchoutoptions);
+  }
+  if (arguments->verify_alignment)
+  {
+    gt_querymatch_verify_alignment_set(querymatch);
+  }
+  return querymatch;
+}
+
+/* For the parallel enumeration of the maximal pairs, every partition of the
+   suffix array extends its seeds with its own resources and collects the
+   resulting matches. The matches are shown partition by partition in the
+   order of the suffix array, so the output is the same as for one thread.
+   Only the partitions of one round of <gt_esa_bottomup_parallel> keep their
+   matches until they are shown. */
+
+typedef struct
+{
+  const GtMaxpairsoptions *arguments;
+  GtExtendCharAccess extend_char_access;
+  Polishing_info *pol_info;
+} GtRepfindPartitionfactory;
+
+typedef struct
+{
+  /* first member, as the partition is passed to the functions processing
+     the maximal pairs */
+  GtProcessinfo_and_querymatchspaceptr processinfo_and_querymatchspaceptr;
+  const GtMaxpairsoptions *arguments;
+  GtQuerymatchoutoptions *querymatchoutoptions;
+  GtArrayGtQuerymatch querymatch_table;
+} GtRepfindPartition;
+
+static void *gt_repfind_partition_new(void *data)
+{
+  const GtRepfindPartitionfactory *factory = data;
+  const GtMaxpairsoptions *arguments = factory->arguments;
+  GtRepfindPartition *partition = gt_malloc(sizeof *partition);
+
+  partition->arguments = arguments;
+  if (gt_option_is_set(arguments->refextendxdropoption))
+  {
+    partition->processinfo_and_querymatchspaceptr.processinfo
+      = gt_repfind_xdropmatchinfo_new(arguments);
+  } else
+  {
+    if (gt_option_is_set(arguments->refextendgreedyoption))
+    {
+      partition->processinfo_and_querymatchspaceptr.processinfo
+        = gt_repfind_greedyextendmatchinfo_new(arguments,
+                                               factory->extend_char_access,
+                                               factory->pol_info);
+    } else
+    {
+      partition->processinfo_and_querymatchspaceptr.processinfo = NULL;
+    }
+  }
+  partition->querymatchoutoptions
+    = gt_repfind_querymatchoutoptions_new(arguments,
+                                          factory->extend_char_access);
+  partition->processinfo_and_querymatchspaceptr.querymatchspaceptr
+    = gt_repfind_querymatch_new(arguments,partition->querymatchoutoptions);
+  GT_INITARRAY(&partition->querymatch_table,GtQuerymatch);
+  partition->processinfo_and_querymatchspaceptr.querymatch_table
+    = &partition->querymatch_table;
+  return partition;
+}
+
+static int gt_repfind_partition_reduce(GT_UNUSED void *data,
+                                       void *processmaxpairsinfo,
+                                       GT_UNUSED GtError *err)
+{
+  GtRepfindPartition *partition = processmaxpairsinfo;
+  GtUword idx;
+
+  for (idx = 0; idx < partition->querymatch_table.nextfreeGtQuerymatch; idx++)
+  {
+    gt_querymatch_prettyprint(gt_querymatch_table_get(
+                                          &partition->querymatch_table,idx));
+  }
+  return 0;
+}
+
+static void gt_repfind_partition_delete(void *processmaxpairsinfo)
+{
+  GtRepfindPartition *partition = processmaxpairsinfo;
+
+  if (gt_option_is_set(partition->arguments->refextendxdropoption))
+  {
+    gt_xdrop_matchinfo_delete(partition->processinfo_and_querymatchspaceptr.
+                                processinfo);
+  } else
+  {
+    if (gt_option_is_set(partition->arguments->refextendgreedyoption))
+    {
+      gt_greedy_extend_matchinfo_delete(partition->
+                                          processinfo_and_querymatchspaceptr.
+                                          processinfo);
+    }
+  }
+  gt_querymatchoutoptions_delete(partition->querymatchoutoptions);
+  gt_querymatch_delete(partition->processinfo_and_querymatchspaceptr.
+                         querymatchspaceptr);
+  GT_FREEARRAY(&partition->querymatch_table,GtQuerymatch);
+  gt_free(partition);
+}
+
 static int gt_repfind_runner(int argc,
                              GT_UNUSED const char **argv,
                              int parsed_args,
@@ -751,17 +967,7 @@ static int gt_repfind_runner(int argc,
   }
   if (!haserr && gt_option_is_set(arguments->refextendxdropoption))
   {
-    xdropmatchinfo
-      = gt_xdrop_matchinfo_new(arguments->userdefinedleastlength,
-                               gt_minidentity2errorpercentage(
-                                            arguments->minidentity),
-                               arguments->xdropbelowscore,
-                               arguments->extendxdrop);
-    gt_assert(xdropmatchinfo != NULL);
-    if (arguments->silent)
-    {
-      gt_xdrop_matchinfo_silent_set(xdropmatchinfo);
-    }
+    xdropmatchinfo = gt_repfind_xdropmatchinfo_new(arguments);
   }
   if (!haserr)
   {
@@ -786,27 +992,8 @@ static int gt_repfind_runner(int argc,
                                             GT_DEFAULT_MATCHSCORE_BIAS,
                                             arguments->history);
     greedyextendmatchinfo
-      = gt_greedy_extend_matchinfo_new(errorpercentage,
-                                       arguments->maxalignedlendifference,
-                                       arguments->history,
-                                       arguments->perc_mat_history,
-                                       arguments->userdefinedleastlength,
-                                       extend_char_access,
-                                       arguments->extendgreedy,
-                                       pol_info);
-    if (arguments->check_extend_symmetry)
-    {
-      gt_greedy_extend_matchinfo_check_extend_symmetry_set(
-                                                greedyextendmatchinfo);
-    }
-    if (arguments->silent)
-    {
-      gt_greedy_extend_matchinfo_silent_set(greedyextendmatchinfo);
-    }
-    if (arguments->trimstat)
-    {
-      gt_greedy_extend_matchinfo_trimstat_set(greedyextendmatchinfo);
-    }
+      = gt_repfind_greedyextendmatchinfo_new(arguments,extend_char_access,
+                                             pol_info);
   }
   if (!haserr)
   {
@@ -823,55 +1010,11 @@ static int gt_repfind_runner(int argc,
                           arguments->reverse_complement};
 
     processinfo_and_querymatchspaceptr.processinfo = NULL;
-    if (arguments->alignmentwidth > 0 ||
-        (gt_option_is_set(arguments->refextendxdropoption) &&
-         !arguments->noxpolish))
-    {
-      querymatchoutoptions
-        = gt_querymatchoutoptions_new(true, false,arguments->alignmentwidth);
-
-      if (gt_option_is_set(arguments->refextendxdropoption) ||
-          gt_option_is_set(arguments->refextendgreedyoption))
-      {
-        const GtUword sensitivity
-          = gt_option_is_set(arguments->refextendgreedyoption)
-              ? arguments->extendgreedy
-              : 100;
-
-        gt_querymatchoutoptions_extend(querymatchoutoptions,
-                                       gt_minidentity2errorpercentage(
-                                               arguments->minidentity),
-                                      arguments->maxalignedlendifference,
-                                      arguments->history,
-                                      arguments->perc_mat_history,
-                                      extend_char_access,
-                                      false,
-                                      sensitivity,
-                                      GT_DEFAULT_MATCHSCORE_BIAS,
-                                      true,
-                                      arguments->seed_display);
-      }
-    } else
-    {
-      querymatchoutoptions = NULL;
-    }
-    processinfo_and_querymatchspaceptr.querymatchspaceptr = gt_querymatch_new();
-    if (arguments->seed_display)
-    {
-      gt_querymatch_seed_display_set(
-              processinfo_and_querymatchspaceptr.querymatchspaceptr);
-    }
-    if (querymatchoutoptions != NULL)
-    {
-      gt_querymatch_outoptions_set(
-              processinfo_and_querymatchspaceptr.querymatchspaceptr,
-              querymatchoutoptions);
-    }
-    if (arguments->verify_alignment)
-    {
-      gt_querymatch_verify_alignment_set(
-        processinfo_and_querymatchspaceptr.querymatchspaceptr);
-    }
+    querymatchoutoptions
+      = gt_repfind_querymatchoutoptions_new(arguments,extend_char_access);
+    processinfo_and_querymatchspaceptr.querymatchspaceptr
+      = gt_repfind_querymatch_new(arguments,querymatchoutoptions);
+    processinfo_and_querymatchspaceptr.querymatch_table = NULL;
     if (gt_option_is_set(arguments->refextendxdropoption))
     {
       eqmf = gt_xdrop_extend_querymatch_with_output;
@@ -934,16 +1077,44 @@ static int gt_repfind_runner(int argc,
             }
             processmaxpairsdata = (void *) &processinfo_and_querymatchspaceptr;
           }
-          if (gt_callenummaxpairs(gt_str_get(arguments->indexname),
-                                  arguments->seedlength,
-                                  arguments->maxfreq,
-                                  arguments->scanfile,
-                                  processmaxpairs,
-                                  processmaxpairsdata,
-                                  logger,
-                                  err) != 0)
+          /* the partitions of the parallel enumeration need random
+             access to the index and collect the matches before showing
+             them, which is not possible for alignments */
+          if (gt_jobs > 1U && !arguments->scanfile && !arguments->searchspm &&
+              arguments->alignmentwidth == 0 && !arguments->trimstat)
           {
-            haserr = true;
+            GtRepfindPartitionfactory factory;
+
+            factory.arguments = arguments;
+            factory.extend_char_access = extend_char_access;
+            factory.pol_info = pol_info;
+            if (gt_callenummaxpairs_parallel(gt_str_get(arguments->indexname),
+                                             arguments->seedlength,
+                                             arguments->maxfreq,
+                                             gt_jobs,
+                                             processmaxpairs,
+                                             gt_repfind_partition_new,
+                                             gt_repfind_partition_reduce,
+                                             gt_repfind_partition_delete,
+                                             &factory,
+                                             logger,
+                                             err) != 0)
+            {
+              haserr = true;
+            }
+          } else
+          {
+            if (gt_callenummaxpairs(gt_str_get(arguments->indexname),
+                                    arguments->seedlength,
+                                    arguments->maxfreq,
+                                    arguments->scanfile,
+                                    processmaxpairs,
+                                    processmaxpairsdata,
+                                    logger,
+                                    err) != 0)
+            {
+              haserr = true;
+            }
           }
         }
         if (!haserr)
@@ -24,8 +24,10 @@
 #include "core/format64.h"
 #include "core/fa.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "match/echoseq.h"
 #include "match/eis-voiditf.h"
+#include "match/esa-lce.h"
 #include "match/esa-lcpintervals.h"
 #include "match/esa-map.h"
 #include "match/esa-seqread.h"
@@ -64,6 +66,7 @@ typedef struct
        enumlcpitvtreeBU,
        diffcovercheck,
        wholeleafcheck,
+       lcecheck,
        compressedesa,
        compresslcp,
        spmitv,
@@ -159,7 +162,7 @@ static GtOptionParser* gt_sfxmap_option_parser_new(void *tool_arguments)
          *optiondelspranges, *optionpckindex, *optionesaindex,
          *optioncmpsuf, *optioncmplcp, *optionstreamesq,
          *optionsortmaxdepth, *optionalgbounds, *optiondiffcov,
-         *optionwholeleafcheck,
+         *optionwholeleafcheck, *optionlcecheck,
          *optionenumlcpitvs, *optionenumlcpitvtree, *optionenumlcpitvtreeBU,
          *optionscanesa, *optionspmitv, *optionownencseq2file,
          *optionbfcheck, *optioncompressedesa,
@@ -282,6 +285,13 @@ static GtOptionParser* gt_sfxmap_option_parser_new(void *tool_arguments)
                                             &arguments->wholeleafcheck,false);
   gt_option_parser_add_option(op, optionwholeleafcheck);
 
+  optionlcecheck = gt_option_new_bool("lcecheck",
+                                      "check longest common extension queries "
+                                      "against a direct comparison",
+                                      &arguments->lcecheck,false);
+  gt_option_parser_add_option(op, optionlcecheck);
+  gt_option_imply(optionlcecheck, optionesaindex);
+
   optionenumlcpitvs = gt_option_new_bool("enumlcpitvs",
                                          "enumerate the lcp-intervals",
                                          &arguments->enumlcpitvs,false);
@@ -661,6 +671,63 @@ GtUword sfx_charcount_encseq(const void *encseq,GtUchar idx)
   return gt_encseq_charcount((const GtEncseq *) encseq, idx);
 }
 
+#define GT_SFXMAP_LCECHECKS 100000UL
+
+/* compares longest common extensions of random pairs of suffixes, half of
+   them neighbours in the suffix table to get long extensions */
+static int gt_sfxmap_lcecheck(const Suffixarray *suffixarray,
+                              GtLogger *logger,
+                              GtError *err)
+{
+  bool haserr = false;
+  GtLCE *lce;
+  GtUword idx, pos1, pos2, rank, maxlcp, lcevalue, totallength;
+
+  gt_error_check(err);
+  lce = gt_lce_new(suffixarray,err);
+  if (lce == NULL)
+  {
+    return -1;
+  }
+  totallength = gt_encseq_total_length(suffixarray->encseq);
+  gt_logger_log(logger,"lce size "GT_WU" bytes",(GtUword) gt_lce_size(lce));
+  for (idx = 0; !haserr && totallength > 1UL && idx < GT_SFXMAP_LCECHECKS;
+       idx++)
+  {
+    if (idx % 2 == 0)
+    {
+      pos1 = gt_rand_max(totallength);
+      pos2 = gt_rand_max(totallength);
+    } else
+    {
+      rank = gt_rand_max(totallength - 1);
+      pos1 = ESASUFFIXPTRGET(suffixarray->suftab,rank);
+      rank = MIN(rank + 1 + gt_rand_max(7UL),totallength);
+      pos2 = ESASUFFIXPTRGET(suffixarray->suftab,rank);
+    }
+    if (pos1 == pos2)
+    {
+      continue;
+    }
+    (void) gt_sfxmap_comparefullsuffixes(suffixarray->encseq,
+                                         suffixarray->readmode,
+                                         &maxlcp,pos1,pos2,NULL,NULL);
+    lcevalue = gt_lce_query(lce,pos1,pos2);
+    if (lcevalue != maxlcp)
+    {
+      gt_error_set(err,"lce("GT_WU","GT_WU")="GT_WU" != "GT_WU,
+                   pos1,pos2,lcevalue,maxlcp);
+      haserr = true;
+    }
+  }
+  if (!haserr)
+  {
+    gt_logger_log(logger,"lce queries okay");
+  }
+  gt_lce_delete(lce);
+  return haserr ? -1 : 0;
+}
+
 static int gt_sfxmap_esa(const Sfxmapoptions *arguments, GtLogger *logger,
                          GtError *err)
 {
@@ -669,7 +736,8 @@ static int gt_sfxmap_esa(const Sfxmapoptions *arguments, GtLogger *logger,
   unsigned int demand = 0;
 
   gt_error_check(err);
-  if (arguments->inputtis || arguments->delspranges > 0 || arguments->inputsuf)
+  if (arguments->inputtis || arguments->delspranges > 0 ||
+      arguments->inputsuf || arguments->lcecheck)
   {
     demand |= SARR_ESQTAB;
   }
@@ -681,11 +749,11 @@ static int gt_sfxmap_esa(const Sfxmapoptions *arguments, GtLogger *logger,
   {
     demand |= SARR_SDSTAB;
   }
-  if (arguments->inputsuf)
+  if (arguments->inputsuf || arguments->lcecheck)
   {
     demand |= SARR_SUFTAB;
   }
-  if (arguments->inputlcp)
+  if (arguments->inputlcp || arguments->lcecheck)
   {
     demand |= SARR_LCPTAB;
   }
@@ -840,6 +908,20 @@ static int gt_sfxmap_esa(const Sfxmapoptions *arguments, GtLogger *logger,
       }
     }
   }
+  if (!haserr && arguments->lcecheck)
+  {
+    if (arguments->usestream)
+    {
+      gt_error_set(err,"option -lcecheck requires a mapped index");
+      haserr = true;
+    } else
+    {
+      if (gt_sfxmap_lcecheck(&suffixarray,logger,err) != 0)
+      {
+        haserr = true;
+      }
+    }
+  }
   if (!haserr && arguments->inputdes && arguments->inputsds)
   {
     gt_logger_log(logger, "checkallsequencedescriptions");
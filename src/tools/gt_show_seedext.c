@@ -340,6 +340,7 @@ static int gt_show_seedext_runner(GT_UNUSED int argc,
       gt_alignment_polished_ends(alignment,pol_info,false);
     }
     processinfo_and_querymatchspaceptr.processinfo = greedyextendmatchinfo;
+    processinfo_and_querymatchspaceptr.querymatch_table = NULL;
     if (arguments->sortmatches)
     {
       (void) gt_seedextend_match_iterator_all_sorted(semi,true);
@@ -136,6 +136,7 @@ static int gt_stat_runner(int argc, const char **argv, int parsed_args,
                                                   argv + parsed_args);
   if (arguments->verbose)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+  gt_gff3_in_stream_enable_node_arena((GtGFF3InStream*) gff3_in_stream);
 
   /* create add introns stream if -addintrons was used */
   if (arguments->addintrons) {
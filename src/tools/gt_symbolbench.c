@@ -0,0 +1,190 @@
+/*
+  Copyright (c) 2016 Genome Research Ltd.
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/cstr_table_api.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str_array_api.h"
+#include "core/symbol_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_symbolbench.h"
+
+typedef struct {
+  GtUword num_of_names,
+          num_of_lookups;
+  bool verbose;
+} SymbolBenchArguments;
+
+/* the names interned by each thread, as they occur in GFF3 files */
+static const char *symbolbench_types[] = {
+  "gene", "mRNA", "exon", "CDS", "five_prime_UTR", "three_prime_UTR",
+  "intron", "start_codon", "stop_codon", "transcript", "ncRNA", "tRNA",
+  "rRNA", "pseudogene", "repeat_region", "LTR_retrotransposon",
+  "long_terminal_repeat", "target_site_duplication", "region", "match",
+  "match_part", "polypeptide", "protein_match", "expressed_sequence_match"
+};
+
+typedef struct {
+  const GtStrArray *names;
+  GtUword num_of_lookups;
+  GtCstrTable *table;
+  GtMutex *mutex;
+} SymbolBenchThreadInfo;
+
+static void *gt_symbolbench_arguments_new(void)
+{
+  return gt_calloc((size_t) 1, sizeof (SymbolBenchArguments));
+}
+
+static void gt_symbolbench_arguments_delete(void *tool_arguments)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_symbolbench_option_parser_new(void *tool_arguments)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]",
+                            "Benchmarks interning feature type names with "
+                            "gt_symbol() in the threads given by -j, compared "
+                            "to a table behind a single lock.");
+
+  option = gt_option_new_uword_min("names", "number of distinct names",
+                                   &arguments->num_of_names, 100UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("lookups", "number of names interned by each "
+                               "thread", &arguments->num_of_lookups,
+                               1000000UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+  return op;
+}
+
+static void* gt_symbolbench_intern(void *data)
+{
+  SymbolBenchThreadInfo *info = data;
+  GtUword i, num_of_names = gt_str_array_size(info->names);
+
+  for (i = 0; i < info->num_of_lookups; i++) {
+    GT_UNUSED const char *symbol;
+    symbol = gt_symbol(gt_str_array_get(info->names, i % num_of_names));
+    gt_assert(symbol);
+  }
+  return NULL;
+}
+
+/* the way gt_symbol() was implemented before: one table, one lock */
+static void* gt_symbolbench_intern_locked(void *data)
+{
+  SymbolBenchThreadInfo *info = data;
+  GtUword i, num_of_names = gt_str_array_size(info->names);
+
+  for (i = 0; i < info->num_of_lookups; i++) {
+    const char *name = gt_str_array_get(info->names, i % num_of_names),
+               *symbol;
+    gt_mutex_lock(info->mutex);
+    if (!(symbol = gt_cstr_table_get(info->table, name))) {
+      gt_cstr_table_add(info->table, name);
+      symbol = gt_cstr_table_get(info->table, name);
+    }
+    gt_mutex_unlock(info->mutex);
+    gt_assert(symbol);
+  }
+  return NULL;
+}
+
+static int gt_symbolbench_runner(GT_UNUSED int argc,
+                                 GT_UNUSED const char **argv,
+                                 GT_UNUSED int parsed_args,
+                                 void *tool_arguments, GtError *err)
+{
+  SymbolBenchArguments *arguments = tool_arguments;
+  SymbolBenchThreadInfo info;
+  GtStrArray *names;
+  GtTimer *timer;
+  GtStr *name;
+  GtUword i, num_of_types = sizeof symbolbench_types /
+                            sizeof symbolbench_types[0];
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  names = gt_str_array_new();
+  name = gt_str_new();
+  for (i = 0; i < arguments->num_of_names; i++) {
+    gt_str_set(name, symbolbench_types[i % num_of_types]);
+    if (i >= num_of_types) {
+      gt_str_append_char(name, '_');
+      gt_str_append_uword(name, i / num_of_types);
+    }
+    gt_str_array_add(names, name);
+  }
+  gt_str_delete(name);
+  info.names = names;
+  info.num_of_lookups = arguments->num_of_lookups;
+  info.table = gt_cstr_table_new();
+  info.mutex = gt_mutex_new();
+
+  timer = gt_timer_new_with_progress_description("gt_symbol()");
+  gt_timer_start(timer);
+  had_err = gt_multithread(gt_symbolbench_intern, &info, err);
+  if (!had_err) {
+    gt_timer_show_progress(timer, "single lock", stdout);
+    had_err = gt_multithread(gt_symbolbench_intern_locked, &info, err);
+  }
+  gt_timer_show_progress_final(timer, stdout);
+
+  if (!had_err) {
+    printf("# %u threads, " GT_WU " names, " GT_WU " lookups per thread\n",
+           gt_jobs, arguments->num_of_names, arguments->num_of_lookups);
+    if (arguments->verbose) {
+      GtStrArray *all = gt_cstr_table_get_all(info.table);
+      printf("# " GT_WU " names in the single lock table\n",
+             gt_str_array_size(all));
+      gt_str_array_delete(all);
+    }
+  }
+
+  gt_timer_delete(timer);
+  gt_mutex_delete(info.mutex);
+  gt_cstr_table_delete(info.table);
+  gt_str_array_delete(names);
+  return had_err;
+}
+
+GtTool* gt_symbolbench(void)
+{
+  return gt_tool_new(gt_symbolbench_arguments_new,
+                     gt_symbolbench_arguments_delete,
+                     gt_symbolbench_option_parser_new,
+                     NULL,
+                     gt_symbolbench_runner);
+}
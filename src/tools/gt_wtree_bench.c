@@ -16,6 +16,7 @@
 */
 
 #include <ctype.h>
+#include <string.h>
 
 #include "core/chardef.h"
 #include "core/encseq_api.h"
@@ -24,17 +25,23 @@
 #include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "extended/wtree_encseq.h"
+#include "extended/wtree_matrix_encseq.h"
 #include "tools/gt_wtree_bench.h"
 
 #define WAVELET_BENCH_SIZE 1000000UL
 typedef struct {
-  GtStr  *safe;
+  GtStr  *safe,
+         *type;
+  bool    quiet;
 } GtWaveletBenchArguments;
 
+typedef char (*GtWtreeBenchUnmapFunc)(GtWtree*, GtWtreeSymbol);
+
 static void* gt_wtree_bench_arguments_new(void)
 {
   GtWaveletBenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
   arguments->safe = gt_str_new();
+  arguments->type = gt_str_new();
   return arguments;
 }
 
@@ -43,6 +50,7 @@ static void gt_wtree_bench_arguments_delete(void *tool_arguments)
   GtWaveletBenchArguments *arguments = tool_arguments;
   if (arguments != NULL) {
     gt_str_delete(arguments->safe);
+    gt_str_delete(arguments->type);
     gt_free(arguments);
   }
 }
@@ -52,6 +60,7 @@ static GtOptionParser* gt_wtree_bench_option_parser_new(void *tool_arguments)
   GtWaveletBenchArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *option;
+  static const char *types[] = {"tree", "matrix", NULL};
   gt_assert(arguments);
 
   /* init */
@@ -64,6 +73,19 @@ static GtOptionParser* gt_wtree_bench_option_parser_new(void *tool_arguments)
                                 arguments->safe, NULL);
   gt_option_parser_add_option(op, option);
 
+  /* -type */
+  option = gt_option_new_choice("type", "implementation to benchmark\n"
+                                "choose from tree|matrix: wavelet tree on a "
+                                "compressed bitsequence or wavelet matrix on "
+                                "rank9 bitsequences",
+                                arguments->type, types[0], types);
+  gt_option_parser_add_option(op, option);
+
+  /* -quiet */
+  option = gt_option_new_bool("quiet", "do not print the query results, only "
+                              "the timings", &arguments->quiet, false);
+  gt_option_parser_add_option(op, option);
+
   return op;
 }
 
@@ -90,30 +112,36 @@ static int gt_wtree_bench_arguments_check(int rest_argc,
   return had_err;
 }
 
-static int gt_wtree_bench_bench_encseq(GtEncseq *es, GtTimer *t,
+static int gt_wtree_bench_bench_encseq(GtEncseq *es, GtTimer *t, bool quiet,
                                        GT_UNUSED GtError *err)
 {
   int had_err = 0;
   GtUword idx, length, pos;
+  char c;
   gt_error_check(err);
   length = gt_encseq_total_length(es);
   gt_timer_start(t);
   for (idx = 0; idx < WAVELET_BENCH_SIZE; idx++) {
     pos = gt_rand_max(length - 1);
     if (gt_encseq_position_is_separator(es, pos, GT_READMODE_FORWARD)) {
-      printf("$");
+      c = '$';
     }
     else {
-      printf("%c", gt_encseq_get_decoded_char(es, pos, GT_READMODE_FORWARD));
+      c = gt_encseq_get_decoded_char(es, pos, GT_READMODE_FORWARD);
     }
+    if (!quiet)
+      printf("%c", c);
   }
-  printf("\n");
+  if (!quiet)
+    printf("\n");
   gt_timer_show_progress_final(t, stderr);
   gt_timer_stop(t);
   return had_err;
 }
 
 static int gt_wtree_bench_bench_wtree(GtWtree *wt,
+                                      GtWtreeBenchUnmapFunc unmap,
+                                      bool quiet,
                                       GtError *err,
                                       GtTimer *timer)
 {
@@ -121,46 +149,78 @@ static int gt_wtree_bench_bench_wtree(GtWtree *wt,
   GtUword idx,
                 length = gt_wtree_length(wt),
                 syms = gt_wtree_num_of_symbols(wt),
-                tmp, pos, *max_ranks;
+                tmp, pos, *max_ranks, *positions, *ranks, *batch_ranks;
   char c;
-  GtWtreeSymbol symbol;
+  GtWtreeSymbol symbol, *symbols;
   gt_error_check(err);
   gt_timer_show_progress(timer, "1M random access", stderr);
-  printf("\n");
+  if (!quiet)
+    printf("\n");
   for (idx = 0; !had_err && idx < WAVELET_BENCH_SIZE; idx++) {
     symbol = gt_wtree_access(wt, gt_rand_max(length-1));
-    c = gt_wtree_encseq_unmap_decoded(wt, symbol);
+    c = unmap(wt, symbol);
     switch (c) {
       case (char) SEPARATOR:
-        printf("$");
+        if (!quiet)
+          printf("$");
         break;
       case (char) UNDEFCHAR:
         gt_error_set(err, "undefined char in sequence, can't print");
         had_err = 1;
         break;
       default:
-        printf("%c",c);
+        if (!quiet)
+          printf("%c",c);
     }
   }
+  positions = gt_malloc(sizeof (*positions) * WAVELET_BENCH_SIZE);
+  symbols = gt_malloc(sizeof (*symbols) * WAVELET_BENCH_SIZE);
+  ranks = gt_malloc(sizeof (*ranks) * WAVELET_BENCH_SIZE);
+  batch_ranks = gt_malloc(sizeof (*batch_ranks) * WAVELET_BENCH_SIZE);
+  for (idx = 0; idx < WAVELET_BENCH_SIZE; idx++) {
+    symbols[idx] = gt_rand_max(syms-1);
+    positions[idx] = gt_rand_max(length-1);
+  }
   gt_timer_show_progress(timer, "1M random rank", stderr);
-  printf("\n");
+  if (!quiet)
+    printf("\n");
   for (idx = 0; !had_err && idx < WAVELET_BENCH_SIZE; idx++) {
-    symbol = gt_rand_max(syms-1);
-    pos = gt_rand_max(length-1);
-    tmp = gt_wtree_rank(wt, pos, symbol);
-    c = gt_wtree_encseq_unmap_decoded(wt, symbol);
-    if (isprint(c))
-      printf("rank of %c at "GT_WU": "GT_WU"\n", c, pos, tmp);
-    else
-      printf("rank of %d at "GT_WU": "GT_WU"\n", c, pos, tmp);
+    symbol = symbols[idx];
+    pos = positions[idx];
+    tmp = ranks[idx] = gt_wtree_rank(wt, pos, symbol);
+    if (!quiet) {
+      c = unmap(wt, symbol);
+      if (isprint(c))
+        printf("rank of %c at "GT_WU": "GT_WU"\n", c, pos, tmp);
+      else
+        printf("rank of %d at "GT_WU": "GT_WU"\n", c, pos, tmp);
+    }
   }
-  printf("\n");
+  if (!quiet)
+    printf("\n");
+  gt_timer_show_progress(timer, "1M random rank (batched)", stderr);
+  if (!had_err)
+    gt_wtree_rank_batch(wt, positions, symbols, batch_ranks,
+                        WAVELET_BENCH_SIZE);
+  for (idx = 0; !had_err && idx < WAVELET_BENCH_SIZE; idx++) {
+    if (batch_ranks[idx] != ranks[idx]) {
+      gt_error_set(err, "batched rank of symbol "GT_WU" at "GT_WU" differs: "
+                   GT_WU" != "GT_WU, symbols[idx], positions[idx],
+                   batch_ranks[idx], ranks[idx]);
+      had_err = 1;
+    }
+  }
+  gt_free(positions);
+  gt_free(symbols);
+  gt_free(ranks);
+  gt_free(batch_ranks);
   gt_timer_show_progress(timer, "1M random select", stderr);
   max_ranks = gt_malloc((size_t) syms * sizeof (*max_ranks));
   for (idx = 0; !had_err && idx < syms; idx++) {
     max_ranks[idx] = gt_wtree_rank(wt, length - 1, idx);
   }
-  printf("\n");
+  if (!quiet)
+    printf("\n");
   for (idx = 0; !had_err && idx < WAVELET_BENCH_SIZE; idx++) {
     do {
     symbol = gt_rand_max(syms-1);
@@ -169,13 +229,16 @@ static int gt_wtree_bench_bench_wtree(GtWtree *wt,
     pos = gt_rand_max(max_ranks[symbol]);
     } while (pos == 0);
     tmp = gt_wtree_select(wt, pos, symbol);
-    c = gt_wtree_encseq_unmap_decoded(wt, symbol);
-    if (isprint(c))
-      printf("select "GT_WU"th %c: at "GT_WU"\n", pos, c, tmp);
-    else
-      printf("select "GT_WU"th %d: at "GT_WU"\n", pos, c, tmp);
+    if (!quiet) {
+      c = unmap(wt, symbol);
+      if (isprint(c))
+        printf("select "GT_WU"th %c: at "GT_WU"\n", pos, c, tmp);
+      else
+        printf("select "GT_WU"th %d: at "GT_WU"\n", pos, c, tmp);
+    }
   }
-  printf("\n");
+  if (!quiet)
+    printf("\n");
   gt_free(max_ranks);
   return had_err;
 }
@@ -185,7 +248,7 @@ static int gt_wtree_bench_runner(GT_UNUSED int argc, const char **argv,
                                  GT_UNUSED void *tool_arguments,
                                  GT_UNUSED GtError *err)
 {
-  GT_UNUSED GtWaveletBenchArguments *arguments = tool_arguments;
+  GtWaveletBenchArguments *arguments = tool_arguments;
   int had_err = 0;
   GtEncseq *encseq;
   GtEncseqLoader *el = gt_encseq_loader_new();
@@ -198,14 +261,28 @@ static int gt_wtree_bench_runner(GT_UNUSED int argc, const char **argv,
   gt_assert(arguments);
 
   encseq = gt_encseq_loader_load(el, es_basename, err);
-  had_err = gt_wtree_bench_bench_encseq(encseq, timer, err);
+  if (encseq == NULL)
+    had_err = -1;
+  if (!had_err)
+    had_err = gt_wtree_bench_bench_encseq(encseq, timer, arguments->quiet,
+                                          err);
   gt_timer_delete(timer);
+  timer = NULL;
 
   if (!had_err) {
     timer = gt_timer_new_with_progress_description("creating wt");
     gt_timer_start(timer);
-    wt = gt_wtree_encseq_new(encseq);
-    had_err = gt_wtree_bench_bench_wtree(wt, err, timer);
+    if (strcmp(gt_str_get(arguments->type), "matrix") == 0) {
+      wt = gt_wtree_matrix_encseq_new(encseq);
+      had_err = gt_wtree_bench_bench_wtree(wt,
+                                          gt_wtree_matrix_encseq_unmap_decoded,
+                                          arguments->quiet, err, timer);
+    }
+    else {
+      wt = gt_wtree_encseq_new(encseq);
+      had_err = gt_wtree_bench_bench_wtree(wt, gt_wtree_encseq_unmap_decoded,
+                                           arguments->quiet, err, timer);
+    }
     gt_timer_show_progress_final(timer, stderr);
   }
   gt_timer_delete(timer);
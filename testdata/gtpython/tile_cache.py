@@ -0,0 +1,93 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2016 Genome Research Ltd.
+#
+# Permission to use, copy, modify, and distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+from gt.core import *
+from gt.extended import *
+from gt.annotationsketch import *
+import os
+import sys
+
+TILE_LENGTH = 1000
+TILE_WIDTH = 400
+
+
+def sketch_uncached(feature_index, seqid, rng, style):
+    diagram = Diagram.from_index(feature_index, seqid, rng, style)
+    layout = Layout(diagram, TILE_WIDTH, style)
+    canvas = CanvasCairoFile(style, TILE_WIDTH, layout.get_height())
+    layout.sketch(canvas)
+    return canvas.to_stream()
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.stderr.write("Usage: " + (sys.argv)[0] +
+                         " PNG_file GFF3_file\n")
+        sys.stderr.write("Compare cached tiles with directly rendered ones.")
+        sys.exit(1)
+
+    pngfile = (sys.argv)[1]
+    in_stream = GFF3InStream((sys.argv)[2])
+    feature_index = FeatureIndexMemory()
+    feature_stream = FeatureStream(in_stream, feature_index)
+    gn = feature_stream.next_tree()
+
+  # fill feature index
+
+    while gn:
+        gn = feature_stream.next_tree()
+
+    seqid = feature_index.get_first_seqid()
+    seqrange = feature_index.get_range_for_seqid(seqid)
+    style = Style()
+
+  # keep fewer tiles than requested to have tiles dropped and rendered again
+
+    tile_cache = TileCache(feature_index, style, TILE_LENGTH, TILE_WIDTH, 4)
+    for zoom in range(0, 4):
+        last = seqrange.end // (TILE_LENGTH << zoom)
+        tile_cache.render(seqid, zoom, 0, last)
+        for tile in range(0, last + 1):
+            rng = tile_cache.get_tile_range(zoom, tile)
+            if rng.start != tile * (TILE_LENGTH << zoom) + 1:
+                sys.stderr.write("wrong range for tile %d\n" % tile)
+                sys.exit(1)
+            png = tile_cache.to_stream(seqid, zoom, tile)
+            if png != tile_cache.to_stream(seqid, zoom, tile):
+                sys.stderr.write("cached tile %d at zoom level %d differs\n"
+                                 % (tile, zoom))
+                sys.exit(1)
+            if png != sketch_uncached(feature_index, seqid, rng, style):
+                sys.stderr.write("tile %d at zoom level %d differs from "
+                                 "uncached sketch\n" % (tile, zoom))
+                sys.exit(1)
+
+    tile_cache.to_file(seqid, 0, 1, pngfile)
+    pngfh = open(pngfile, "rb")
+    png = pngfh.read()
+    pngfh.close()
+    if png != tile_cache.to_stream(seqid, 0, 1):
+        sys.stderr.write("tile file differs from stream\n")
+        sys.exit(1)
+
+    try:
+        tile_cache.render("foo", 0, 0, 1)
+    except GTError:
+        pass
+    else:
+        sys.stderr.write("missing error for unknown sequence region\n")
+        sys.exit(1)
@@ -86,6 +86,67 @@ Test do
   end
 end
 
+Name "gt hcr multithreaded"
+Keywords "gt_csr hcr threads"
+Test do
+  files = hcr_testfiles.collect{|file| "#$testdata/" + file}
+  hcr_testcases.each do |testcase|
+    run_test "#$bin/gt compreads compress -descs #{testcase} " \
+             "-files #{files.join(' ')} -name test"
+    run_test "#$bin/gt -j 3 compreads compress -descs #{testcase} " \
+             "-files #{files.join(' ')} -name test_threads"
+    run_test "cmp test.hcr test_threads.hcr"
+    run_test "#$bin/gt compreads decompress -descs -file test_threads"
+    `cat #{files.join(' ')} > original`
+    run_test "diff test_threads.fastq original"
+  end
+end
+
+# the encoder hands out jobs of 1024 reads, <threads> * 4 jobs per batch, so
+# with 3 threads more than 2 * 12 * 1024 reads are needed to get several full
+# batches and a partial one
+Name "gt hcr multithreaded (several batches)"
+Keywords "gt_csr hcr threads"
+Test do
+  rnd = Random.new(42)
+  File.open("many_reads.fastq", "w") do |f|
+    30000.times do |i|
+      f.puts "@read_#{i} lane=#{1 + rnd.rand(8)}"
+      f.puts Array.new(36) { "ACGT"[rnd.rand(4)] }.join
+      f.puts "+"
+      f.puts Array.new(36) { (33 + rnd.rand(41)).chr }.join
+    end
+  end
+  hcr_testcases.each do |testcase|
+    run_test "#$bin/gt -j 1 compreads compress -descs #{testcase} " \
+             "-files many_reads.fastq -name test"
+    run_test "#$bin/gt -j 3 compreads compress -descs #{testcase} " \
+             "-files many_reads.fastq -name test_threads"
+    run_test "cmp test.hcr test_threads.hcr"
+    run_test "#$bin/gt compreads decompress -descs -file test_threads"
+    run_test "cmp test_threads.fastq many_reads.fastq"
+    run_test "#$bin/gt -j 3 compreads decompress -descs -file test_threads"
+    run_test "cmp test_threads.fastq many_reads.fastq"
+  end
+end
+
+Name "gt hcr multithreaded decompress"
+Keywords "gt_csr hcr threads"
+Test do
+  files = hcr_testfiles.collect{|file| "#$testdata/" + file}
+  `cat #{files.join(' ')} > original`
+  `sed -n 21,420p original > original_range`
+  hcr_testcases.each do |testcase|
+    run_test "#$bin/gt compreads compress -descs #{testcase} " \
+             "-files #{files.join(' ')} -name test"
+    run_test "#$bin/gt -j 3 compreads decompress -descs -file test"
+    run_test "diff test.fastq original"
+    run_test "#$bin/gt -j 3 compreads decompress -descs -range 5 104 " \
+             "-file test -name test_range"
+    run_test "diff test_range.fastq original_range"
+  end
+end
+
 
 rcr_testfiles = {
   "rcr_testreads_on_seq.bam" => "rcr_testseq.fa",
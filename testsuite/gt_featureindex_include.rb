@@ -66,3 +66,69 @@ if not $arguments["nordb"] then
   end
 
 end
+
+Name "gt featureindex mapped (empty file)"
+Keywords "gt_featureindex mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.idx " + \
+      "#{$testdata}/gt_view_prob_1.gff3"
+  run "#{$bin}gt featureindex -backend mapped -filename tmp.idx", :retval => 1
+  grep(last_stderr, /no sequence regions in index/)
+end
+
+Name "gt featureindex mapped (existing file)"
+Keywords "gt_featureindex mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.idx " + \
+      "#{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.idx " + \
+      "#{$testdata}/standard_gene_simple.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+end
+
+Name "gt featureindex mapped (invalid sequence ID)"
+Keywords "gt_featureindex mapped"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.idx " + \
+      "#{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt featureindex -backend mapped -seqid foo -filename tmp.idx",
+      :retval => 1
+  grep(last_stderr, /does not contain/)
+end
+
+Name "gt featureindex mapped (corrupt file)"
+Keywords "gt_featureindex mapped"
+Test do
+  File.open("corrupt.idx", "w") do |file|
+    file.write("sdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnlsdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend mapped -filename corrupt.idx",
+      :retval => 1
+  grep(last_stderr, /not a feature index file|corrupt/)
+end
+
+MAPPED_FEATUREINDEX_TEST_FILES = ["#{$testdata}/eden.gff3",
+                                  "#{$testdata}/gt_view_prob_2.gff3",
+                                  "#{$testdata}/standard_gene_simple.gff3",
+                                  "#{$testdata}/standard_gene_as_tree.gff3",
+                                  "#{$testdata}/standard_gene_with_introns_as_tree.gff3",
+                                  "#{$testdata}/encode_known_genes_Mar07.gff3"
+                                  ]
+
+MAPPED_FEATUREINDEX_TEST_FILES.each do |file|
+  Name "gt featureindex mapped vs. parser (#{File.basename(file)})"
+  Keywords "gt_featureindex mapped"
+  Test do
+    run "#{$bin}gt seqids #{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.idx #{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -backend mapped -seqid #{seqid} " + \
+          "-retain no -filename tmp.idx > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{file} | " + \
+          "#{$bin}gt select -seqid #{seqid}"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
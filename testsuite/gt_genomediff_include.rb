@@ -144,6 +144,23 @@ Test do
   end
 end
 
+Name "gt genomediff esa multithreaded"
+Keywords "gt_genomediff esa shulengthdist"
+Test do
+  realfiles = ""
+  (allfiles + bigfiles).each do |file|
+    realfiles += "#{$testdata}#{file} "
+  end
+  run_test "#{$bin}gt suffixerator -db #{realfiles} -indexname esa " +
+           "-dna -suf -tis -lcp -ssp"
+  ["genomediff -indextype esa esa", "shulengthdist -ii esa"].each do |args|
+    run_test "#{$bin}gt #{args}"
+    temp = last_stdout
+    run_test "#{$bin}gt -j 4 #{args}"
+    run "diff #{last_stdout} #{temp}"
+  end
+end
+
 Name "gt genomediff esq testset"
 Keywords "gt_genomediff esq"
 Test do
@@ -0,0 +1,16 @@
+Name "gt intervaltreebench"
+Keywords "gt_intervaltreebench"
+Test do
+  [[1, 10], [1000, 1000], [100000, 10000]].each do |size, queries|
+    run "#{$bin}gt dev intervaltreebench -size #{size} -queries #{queries}"
+    run "#{$bin}gt dev intervaltreebench -size #{size} -queries #{queries} " +
+        "-maxlen 1 -qlen 1 -seqlen 1000"
+  end
+end
+
+Name "gt intervaltreebench overlapping intervals"
+Keywords "gt_intervaltreebench"
+Test do
+  run "#{$bin}gt dev intervaltreebench -size 10000 -queries 1000 " +
+      "-maxlen 100000 -qlen 100000 -seqlen 10000"
+end
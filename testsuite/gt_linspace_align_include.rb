@@ -122,6 +122,41 @@ Test do
   run "diff -i #{last_stdout} #{$testdata}gt_linspace_align_global_affine_test_1.out"
 end
 
+Name "gt linspace_align multithreaded"
+Keywords "gt_linspace_align"
+Test do
+  ["-l 0 1 1", "-a 0 2 3 1"].each do |costs|
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -wildcard"
+    temp = last_stdout
+    run_test "#{$bin}gt -j 4 dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -wildcard"
+    run "diff #{last_stdout} #{temp}"
+  end
+end
+
+Name "gt linspace_align diagonalband multithreaded"
+Keywords "gt_linspace_align"
+Test do
+  ["-l 0 1 1", "-a 0 2 3 1"].each do |costs|
+    run_test "#{$bin}gt dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -d -wildcard"
+    temp = last_stdout
+    run_test "#{$bin}gt -j 4 dev linspace_align -ff "\
+             "#{$testdata}Ecoli-section1.fna #{$testdata}Ecoli-section2.fna "\
+             "-dna -global #{costs} -d -wildcard"
+    run "diff #{last_stdout} #{temp}"
+  end
+  run_test "#{$bin}gt -j 2 dev linspace_align -ff "\
+           "#{$testdata}gt_linspace_align_affine_test_1.fas "\
+           "#{$testdata}gt_linspace_align_affine_test_2.fas "\
+           "-dna -global -a 0 2 3 1 -d -spacetime"
+  grep last_stdout, "cells per second"
+end
+
 Name "gt linspace_align special cases"
 Keywords "gt_linspace_align"
 Test do
@@ -196,6 +196,52 @@ Test do
   run_test "#{$bin}gt ltrdigest -matchdescstart -outfileprefix foo -encseq in.fasta < out.gff3"
 end
 
+Name "gt ltrdigest builtin pHMM search"
+Keywords "gt_ltrdigest pdom builtin"
+Test do
+  run_test "#{$bin}gt encseq encode -des -ssp -sds -md5 " + \
+           "-indexname in.fas #{$testdata}ltrdigest_builtin.fas"
+  run_test "#{$bin}gt ltrdigest -pdomengine builtin -aliout -aaout " + \
+           "-outfileprefix foo " + \
+           "-hmms #{$testdata}ltrdigest_builtin.hmm -- " + \
+           "#{$testdata}ltrdigest_builtin.gff3 in.fas"
+  run "diff #{last_stdout} #{$testdata}ltrdigest_builtin.out"
+  grep "foo_pdom_testdom_aa.fas", /^MKWLVHDRYCEPNQTWFGHIKMRDEPWCYLAH$/
+end
+
+Name "gt ltrdigest builtin pHMM search (threaded)"
+Keywords "gt_ltrdigest pdom builtin"
+Test do
+  run_test "#{$bin}gt encseq encode -des -ssp -sds -md5 " + \
+           "-indexname in.fas #{$testdata}ltrdigest_builtin.fas"
+  run_test "#{$bin}gt -j 3 ltrdigest -pdomengine builtin " + \
+           "-hmms #{$testdata}ltrdigest_builtin.hmm -- " + \
+           "#{$testdata}ltrdigest_builtin.gff3 in.fas"
+  run "diff #{last_stdout} #{$testdata}ltrdigest_builtin.out"
+end
+
+Name "gt ltrdigest builtin pHMM search (missing cutoff)"
+Keywords "gt_ltrdigest pdom builtin"
+Test do
+  run_test "#{$bin}gt encseq encode -des -ssp -sds -md5 " + \
+           "-indexname in.fas #{$testdata}ltrdigest_builtin.fas"
+  run_test "#{$bin}gt ltrdigest -pdomengine builtin -pdomcutoff TC " + \
+           "-hmms #{$testdata}ltrdigest_builtin.hmm -- " + \
+           "#{$testdata}ltrdigest_builtin.gff3 in.fas", :retval => 1
+  grep last_stderr, /has no TC cutoff/
+end
+
+Name "gt ltrdigest builtin pHMM search (HMMER2 model)"
+Keywords "gt_ltrdigest pdom builtin"
+Test do
+  run_test "#{$bin}gt encseq encode -des -ssp -sds -md5 " + \
+           "-indexname in.fas #{$testdata}ltrdigest_builtin.fas"
+  run_test "#{$bin}gt ltrdigest -pdomengine builtin " + \
+           "-hmms #{$testdata}broken_hmmer.hmm -- " + \
+           "#{$testdata}ltrdigest_builtin.gff3 in.fas", :retval => 1
+  grep last_stderr, /not in HMMER3 format/
+end
+
 if $gttestdata then
   Name "gt ltrdigest missing input GFF"
   Keywords "gt_ltrdigest"
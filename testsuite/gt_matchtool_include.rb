@@ -117,3 +117,23 @@ Test do
   run_test "#{$bin}gt matchtool -type BLASTOUT -matchfile #{$testdata}matchtool_blast.match.bz2"
   run "diff #{last_stdout} #{$testdata}matchtool_blast.out"
 end
+
+Name "gt matchtool test (Smith-Waterman)"
+Keywords "gt_matchtool"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname cds #{$testdata}U89959_cds.fas"
+  run_test "#{$bin}gt matchtool -type SW -db cds -query cds -swminlen 20 " +
+           "-swmaxedist 4"
+  run "diff #{last_stdout} #{$testdata}matchtool_sw.out"
+end
+
+Name "gt matchtool test (Smith-Waterman, distinct db and query)"
+Keywords "gt_matchtool"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname cds #{$testdata}U89959_cds.fas"
+  run_test "#{$bin}gt encseq encode -indexname query " +
+           "#{$testdata}matchtool_sw_query.fas"
+  run_test "#{$bin}gt matchtool -type SW -db cds -query query -swminlen 20 " +
+           "-swmaxedist 4"
+  run "diff #{last_stdout} #{$testdata}matchtool_sw_query.out"
+end
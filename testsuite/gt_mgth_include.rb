@@ -35,6 +35,18 @@ if $gttestdata then
     run "diff Pyrococcus_horikoshii.txt #{$gttestdata}mgth/Pyrococcus_horikoshii_ori_4.txt"
   end
 
+  Name "gt mgth testdata multiple threads"
+  Keywords "gt_mgth"
+  Test do
+    FileUtils.copy "#{$gttestdata}mgth/Pyrococcus_horikoshii.txt.gz", "."
+    FileUtils.copy "#{$gttestdata}mgth/Hits_Pyrococcus_horikoshii.txt.gz", "."
+    [1, 4].each do |threads|
+      run_test "#{$bin}gt -j #{threads} mgth -o Pyrococcus_horikoshii_j#{threads} -s 3.17 -n 2.32 -b -13.64 -q -3.45 -h -4.77 -l -1.5 -p 325.50 -f 225.25 -t yes -g yes -m no -x yes -r 1 -e 1 -d 0.21  #{$gttestdata}mgth/Pyrococcus_horikoshii.xml.gz Pyrococcus_horikoshii.txt.gz Hits_Pyrococcus_horikoshii.txt.gz", :maxtime => 200
+    end
+    run "diff Pyrococcus_horikoshii_j1.txt Pyrococcus_horikoshii_j4.txt"
+    run "diff Pyrococcus_horikoshii_j4.txt #{$gttestdata}mgth/Pyrococcus_horikoshii_ori_4.txt"
+  end
+
   Name "gt mgth testdata mixed options 5"
   Keywords "gt_mgth"
   Test do
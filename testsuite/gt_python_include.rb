@@ -61,6 +61,13 @@ if not $arguments["nocairo"] then
                "#{$testdata}gff3_file_1_short.txt"
   end
 
+  Name "gtpython: AnnotationSketch bindings (tile cache)"
+  Keywords "gt_python"
+  Test do
+    run_python "#{$testdata}gtpython/tile_cache.py test.png " +
+               "#{$testdata}gff3_file_1_short.txt"
+  end
+
   Name "gtpython: AnnotationSketch bindings (TrackSelectorFunc)"
   Keywords "gt_python"
   Test do
@@ -976,6 +976,25 @@ Test do
   run "diff reads.contigs.fas contigs"
 end
 
+Name "gt readjoiner: compressed string graph file"
+Keywords "gt_readjoiner gt_readjoiner_assembly savecsr"
+Test do
+  run_prefilter("#{$testdata}/readjoiner/test_1.fas")
+  run_overlap(20)
+  run_assembly("-savecsr -cinfo -lengthcutoff 1 -depthcutoff 1")
+  run "mv reads.contigs.fas contigs"
+  run "mv reads.jnc jnc"
+  run_assembly("-loadcsr -cinfo -lengthcutoff 1 -depthcutoff 1")
+  run "diff reads.contigs.fas contigs"
+  run "cmp reads.jnc jnc"
+  run_assembly("-lengthcutoff 100 -depthcutoff 2")
+  run "mv reads.contigs.fas contigs"
+  run_assembly("-loadcsr -lengthcutoff 100 -depthcutoff 2")
+  run "diff reads.contigs.fas contigs"
+  run "#{$bin}gt readjoiner assembly -readset reads -loadcsr -redtrans",
+      :retval => 1
+end
+
 Name "gt readjoiner: transitive spm determination test - 6"
 Keywords "gt_readjoiner"
 Test do
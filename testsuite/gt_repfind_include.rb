@@ -238,6 +238,30 @@ Test do
   run "#{$bin}gt repfind -samples 1000 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind parallel"
+Keywords "gt_repfind threads"
+Test do
+  rdir = "#{$testdata}repfind-result"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp -pl"
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+           "-indexname at1MB -dna -tis -suf -lcp"
+  [2, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} repfind -l 8 -ii sfx"
+    run "grep -v '^#' #{last_stdout}"
+    run "diff -w #{last_stdout} #{rdir}/Atinsert-8-8"
+    run_test "#{$bin}gt -j #{jobs} repfind -minidentity 90 -l 20 " +
+             "-extendxdrop -xdropbelow 5 -ii at1MB"
+    run "cmp -s #{last_stdout} #{rdir}/at1MB-xdrop-20-20-80-6"
+  end
+  ["-l 14 -maxfreq 20", "-minidentity 80 -l 20 -extendgreedy"].each do |opts|
+    run_test "#{$bin}gt repfind #{opts} -ii at1MB"
+    run "mv #{last_stdout} sequential.matches"
+    run_test "#{$bin}gt -j 4 repfind #{opts} -ii at1MB"
+    run "cmp -s #{last_stdout} sequential.matches"
+  end
+end
+
 if $gttestdata then
   extendexception = ["hs5hcmvcg.fna","Wildcards.fna","at1MB"]
   repfindtestfiles.each do |reffile|
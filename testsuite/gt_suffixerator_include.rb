@@ -183,6 +183,18 @@ Test do
   end
 end
 
+Name "gt suffixerator + sfxmap lcecheck"
+Keywords "gt_suffixerator lce"
+Test do
+  all_fastafiles.each do |filename|
+    alldir.each do |dir|
+      run_test "#{$bin}gt suffixerator -suf -lcp -dir #{dir} " +
+               "-indexname sfx -db #{$testdata}#{filename}"
+      run_test "#{$bin}gt dev sfxmap -lcecheck -esa sfx"
+    end
+  end
+end
+
 Name "gt suffixerator all accesstypes"
 Keywords "gt_suffixerator tis"
 Test do
@@ -592,6 +604,16 @@ Test do
   run "diff #{last_stdout} #{$testdata}/Reads2-spmitv.txt"
 end
 
+Name "gt sfxmap spmitv parallel"
+Keywords "gt_suffixerator spmitv threads"
+Test do
+  run "#{$bin}/gt suffixerator -db #{$testdata}/Reads2.fna -suf -lcp"
+  [2, 4].each do |jobs|
+    run "#{$bin}/gt -j #{jobs} dev sfxmap -spmitv -esa Reads2.fna"
+    run "diff #{last_stdout} #{$testdata}/Reads2-spmitv.txt"
+  end
+end
+
 Name "gt sfxmap lcp-interval trees bottomup"
 Keywords "gt_suffixerator lcpitv"
 Test do
@@ -0,0 +1,10 @@
+Name "gt symbolbench"
+Keywords "gt_symbolbench"
+Test do
+  [[1, 10], [100, 10000], [10000, 100000]].each do |names, lookups|
+    run "#{$bin}gt dev symbolbench -names #{names} -lookups #{lookups}"
+    run "#{$bin}gt -j 4 dev symbolbench -names #{names} -lookups #{lookups} " +
+        "-v"
+    grep last_stdout, /# #{names} names in the single lock table/
+  end
+end
@@ -0,0 +1,16 @@
+Name "gt wtree benchmark (tree)"
+Keywords "gt_wtree"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname Random #{$testdata}Random.fna"
+  run_test "#{$bin}gt wtree benchmark -quiet Random"
+end
+
+Name "gt wtree benchmark (matrix equals tree)"
+Keywords "gt_wtree"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname Random #{$testdata}Random.fna"
+  run_test "#{$bin}gt -seed 42 wtree benchmark -type tree Random"
+  run "mv #{last_stdout} tree.out"
+  run_test "#{$bin}gt -seed 42 wtree benchmark -type matrix Random"
+  run "diff #{last_stdout} tree.out"
+end
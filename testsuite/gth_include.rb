@@ -0,0 +1,117 @@
+def gth_copy_U89959
+  FileUtils.copy "#{$testdata}U89959_genomic.fas", "."
+  FileUtils.copy "#{$testdata}U89959_ests.fas", "."
+end
+
+Name "gth threaded chain DP"
+Keywords "gth threads"
+Test do
+  gth_copy_U89959
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -gff3out -o seq.gff3"
+  [2, 4].each do |j|
+    run_test "#{$gthbin}gth -j #{j} -genomic U89959_genomic.fas " +
+             "-cdna U89959_ests.fas -gff3out -o par#{j}.gff3"
+    run "cmp seq.gff3 par#{j}.gff3"
+  end
+end
+
+Name "gth threaded chain DP (both strands, intermediate)"
+Keywords "gth threads"
+Test do
+  gth_copy_U89959
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -gff3out -o seq.gff3"
+  run_test "#{$gthbin}gth -j 4 -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -gff3out -o par.gff3"
+  run "cmp seq.gff3 par.gff3"
+end
+
+Name "gth DP checkpoints vs. complete backtrace matrix"
+Keywords "gth dpcheckpoints"
+Test do
+  gth_copy_U89959
+  # without a matrix size limit the complete backtrace matrices are used
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -autointroncutout 0 -gff3out -o full.gff3"
+  # with a limit of 1 MB the larger matrices are only stored as checkpoints
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -autointroncutout 1 -gff3out " +
+           "-o checkpoints.gff3"
+  run "cmp full.gff3 checkpoints.gff3"
+end
+
+Name "gth binary vs. XML intermediate output"
+Keywords "gth gthconsensus binaryout"
+Test do
+  gth_copy_U89959
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -gff3out -o direct.gff3"
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -xmlout -o inter.xml"
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -binaryout -o inter.bin"
+  # the binary format keeps the exact scores, the consensus equals the one
+  # of the direct run
+  run_test "#{$gthbin}gthconsensus -gff3out -o bin.gff3 inter.bin"
+  run "cmp direct.gff3 bin.gff3"
+  # both formats contain the same spliced alignments
+  run_test "#{$gthbin}gthconsensus -xmlout -intermediate -o xml.xml inter.xml"
+  run_test "#{$gthbin}gthconsensus -xmlout -intermediate -o bin.xml inter.bin"
+  run "diff xml.xml bin.xml"
+end
+
+# splits U89959_ests.fas into two halves
+def gth_split_U89959_ests
+  entries = File.read("U89959_ests.fas").split(/^(?=>)/)
+  half = entries.length / 2
+  File.open("ests1.fas", "w") { |f| f.write(entries[0...half].join) }
+  File.open("ests2.fas", "w") { |f| f.write(entries[half..-1].join) }
+end
+
+Name "gthconsensus threaded PGL assembly"
+Keywords "gth gthconsensus threads"
+Test do
+  gth_copy_U89959
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -xmlout -o inter.xml"
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -intermediate -binaryout -o inter.bin"
+  ["inter.xml", "inter.bin"].each do |inter|
+    run_test "#{$gthbin}gthconsensus -gff3out -o seq.gff3 #{inter}"
+    [2, 4].each do |j|
+      run_test "#{$gthbin}gthconsensus -j #{j} -gff3out -o par.gff3 #{inter}"
+      run "cmp seq.gff3 par.gff3"
+    end
+  end
+  # the threaded gth run assembles the same PGLs as well
+  run_test "#{$gthbin}gth -j 4 -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -gff3out -o direct.gff3"
+  run "cmp seq.gff3 direct.gff3"
+end
+
+Name "gthconsensus incremental (-sacollection)"
+Keywords "gth gthconsensus sacollection"
+Test do
+  gth_copy_U89959
+  gth_split_U89959_ests
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna ests1.fas -intermediate -binaryout -o inter1.bin"
+  run_test "#{$gthbin}gth -genomic U89959_genomic.fas " +
+           "-cdna ests2.fas -intermediate -xmlout -o inter2.xml"
+  # one-shot consensus of both intermediate files
+  run_test "#{$gthbin}gthconsensus -gff3out -o oneshot.gff3 " +
+           "inter1.bin inter2.xml"
+  # incremental consensus, the collection is created by the first call and
+  # updated by the second one
+  run_test "#{$gthbin}gthconsensus -sacollection coll.bin -gff3out " +
+           "-o inc1.gff3 inter1.bin"
+  run_test "#{$gthbin}gthconsensus -gff3out -o first.gff3 inter1.bin"
+  run "cmp inc1.gff3 first.gff3"
+  run_test "#{$gthbin}gthconsensus -sacollection coll.bin -gff3out " +
+           "-o inc2.gff3 inter2.xml"
+  run "cmp inc2.gff3 oneshot.gff3"
+  # the stored collection is itself a valid intermediate file
+  run_test "#{$gthbin}gthconsensus -j 4 -gff3out -o coll.gff3 coll.bin"
+  run "cmp coll.gff3 oneshot.gff3"
+end
@@ -70,6 +70,13 @@ if $arguments["gttestdata"] then
   $gttestdata=File.join($arguments["gttestdata"], "")
 end
 
+# GenomeThreader is distributed separately (it adds the matcher and the
+# sequence index plugins to this library), its binaries are only tested if
+# their directory is given
+if $arguments["gthbin"] then
+  $gthbin=File.join($arguments["gthbin"], "")
+end
+
 $systemname=`uname -s`
 $systemname.chomp!
 
@@ -180,6 +187,7 @@ require 'gt_id_to_md5_include'
 require 'gt_include'
 require 'gt_inlineseq_include'
 require 'gt_interfeat_include'
+require 'gt_intervaltreebench_include'
 require 'gt_kmer_database_include'
 require 'gt_linspace_align_include'
 require 'gt_loccheck_include'
@@ -192,6 +200,9 @@ require 'gt_md5_to_id_include'
 require 'gt_merge_include'
 require 'gt_mergefeat_include'
 require 'gt_mgth_include'
+if $gthbin then
+  require 'gth_include'
+end
 require 'gt_mmapandread_include'
 require 'gt_orffinder_include'
 if python_tests_runnable? then
@@ -225,6 +236,7 @@ require 'gt_splitfasta_include'
 require 'gt_stat_include'
 require 'gt_tirvish_include'
 require 'gt_uniq_include'
+require 'gt_wtree_include'
 if not $arguments["nocairo"] then
   require 'gt_sketch_include'
 end
@@ -241,6 +253,7 @@ require 'gt_mergeesa_include'
 require 'gt_packedindex_include'
 require 'gt_sortbench_include'
 require 'gt_suffixerator_include'
+require 'gt_symbolbench_include'
 require 'gt_encseq2spm_include'
 require 'gt_tallymer_include'
 require 'gt_trieins_include'